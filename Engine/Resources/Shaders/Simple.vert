@@ -11,10 +11,26 @@ uniform mat4 view;
 uniform mat4 model;
 uniform mat4 projection;
 
+/* Compact vertices (VertexFormats.h) store the position relative to the mesh bounds and octahedral normals */
+uniform bool compactVertex;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+vec3 OctahedralDecode(vec2 encoded)
+{
+  vec3 direction = vec3(encoded.xy, 1.0 - abs(encoded.x) - abs(encoded.y));
+  float fold = max(-direction.z, 0.0);
+  direction.x += direction.x >= 0.0 ? -fold : fold;
+  direction.y += direction.y >= 0.0 ? -fold : fold;
+  return normalize(direction);
+}
+
 void main()
 {
-  gl_Position = projection * view * model * vec4(aPos, 1.0f);
+  vec3 position = compactVertex ? aPos * positionScale + positionOffset : aPos;
+  vec3 normal = compactVertex ? OctahedralDecode(aNormal.xy) : aNormal;
+  gl_Position = projection * view * model * vec4(position, 1.0f);
   texCoords = vec2(aTexCoords.x, aTexCoords.y);
-  NormalVec = aNormal;
-  FragPos = vec3(model * vec4(aPos, 1.0));
+  NormalVec = normal;
+  FragPos = vec3(model * vec4(position, 1.0));
 }
\ No newline at end of file
@@ -8,9 +8,19 @@ layout(location = 4) in vec3 bitangent;
 layout(location = 5) in ivec4 boneID;
 layout(location = 6) in vec4 weight;
 
-const int MAX_BONES = 100;
 const int MAX_BONE_INFLUENCE = 4;
-uniform mat4 finalBonesMatrices[MAX_BONES];
+
+/* Final bone matrices of every animated object packed in a texture buffer (BonePalette.h), four texels per matrix */
+uniform samplerBuffer bonePalette;
+uniform int bonePaletteOffset;
+uniform int bonePaletteCount;
+
+mat4 FetchBoneMatrix(int bone)
+{
+  int texel = (bonePaletteOffset + bone) * 4;
+  return mat4(texelFetch(bonePalette, texel), texelFetch(bonePalette, texel + 1), texelFetch(bonePalette, texel + 2),
+              texelFetch(bonePalette, texel + 3));
+}
 
 out vec2 texCoords;
 out vec3 NormalVec;
@@ -19,8 +29,24 @@ uniform mat4 view;
 uniform mat4 model;
 uniform mat4 projection;
 
+/* Compact vertices (VertexFormats.h) store the position relative to the mesh bounds and octahedral normals */
+uniform bool compactVertex;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+vec3 OctahedralDecode(vec2 encoded)
+{
+  vec3 direction = vec3(encoded.xy, 1.0 - abs(encoded.x) - abs(encoded.y));
+  float fold = max(-direction.z, 0.0);
+  direction.x += direction.x >= 0.0 ? -fold : fold;
+  direction.y += direction.y >= 0.0 ? -fold : fold;
+  return normalize(direction);
+}
+
 void main()
 {
+  vec3 position = compactVertex ? aPos * positionScale + positionOffset : aPos;
+  vec3 normal = compactVertex ? OctahedralDecode(aNormal.xy) : aNormal;
   vec4 totalPosition = vec4(0.0f);
   for (int x = 0; x < MAX_BONE_INFLUENCE; x++) {
 
@@ -28,17 +54,17 @@ void main()
       continue;
     }
 
-    if (boneID[x] >= MAX_BONES) {
-      totalPosition = vec4(aPos, 1.0f);
+    if (boneID[x] < 0 || boneID[x] >= bonePaletteCount) {
+      totalPosition = vec4(position, 1.0f);
       break;
     }
 
-    vec4 localPosition = finalBonesMatrices[boneID[x]] * vec4(aPos, 1.0f);
+    vec4 localPosition = FetchBoneMatrix(boneID[x]) * vec4(position, 1.0f);
     totalPosition += localPosition * weight[x];
   }
   mat4 viewModel = view * model;
   gl_Position = projection * viewModel * totalPosition;
   texCoords = vec2(aTexCoords.x, aTexCoords.y);
-  NormalVec = aNormal;
+  NormalVec = normal;
   FragPos = vec3(model * vec4(totalPosition.xyz, 1.0));
 }
\ No newline at end of file
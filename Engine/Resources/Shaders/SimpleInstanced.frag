@@ -49,11 +49,14 @@ struct SpotLight {
   bool Active;
 };
 
-uniform SpotLight spotLight;
-uniform DirectionalLight directionalLight;
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
+// Lighting state shared by every program, uploaded once per frame (see Components/Lighting/LightingBlock.h)
+layout(std140, binding = 0) uniform LightingBlock {
+  SpotLight spotLight;
+  DirectionalLight directionalLight;
+  PointLight pointLights[MAX_POINT_LIGHTS];
+  Viewer viewer;
+};
 uniform Material material;
-uniform Viewer viewer;
 
 vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir);
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
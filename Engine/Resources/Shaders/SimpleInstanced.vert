@@ -10,12 +10,44 @@ out vec3 FragPos;
 uniform mat4 view;
 uniform mat4 projection;
 
-uniform mat4 matrices[10];
+/* Transforms of the instances packed in a texture buffer (InstanceStream in OpenGLRender.h), instanceTexels per
+instance, three rows of an affine matrix or the four columns of a mat4 */
+uniform samplerBuffer instanceTransforms;
+uniform int instanceOffset;
+uniform int instanceTexels;
+
+mat4 FetchInstanceMatrix(int instance)
+{
+  int texel = (instanceOffset + instance) * instanceTexels;
+  if (instanceTexels == 3) {
+    return transpose(mat4(texelFetch(instanceTransforms, texel), texelFetch(instanceTransforms, texel + 1),
+                          texelFetch(instanceTransforms, texel + 2), vec4(0.0, 0.0, 0.0, 1.0)));
+  }
+  return mat4(texelFetch(instanceTransforms, texel), texelFetch(instanceTransforms, texel + 1),
+              texelFetch(instanceTransforms, texel + 2), texelFetch(instanceTransforms, texel + 3));
+}
+
+/* Compact vertices (VertexFormats.h) store the position relative to the mesh bounds and octahedral normals */
+uniform bool compactVertex;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+vec3 OctahedralDecode(vec2 encoded)
+{
+  vec3 direction = vec3(encoded.xy, 1.0 - abs(encoded.x) - abs(encoded.y));
+  float fold = max(-direction.z, 0.0);
+  direction.x += direction.x >= 0.0 ? -fold : fold;
+  direction.y += direction.y >= 0.0 ? -fold : fold;
+  return normalize(direction);
+}
 
 void main()
 {
-  gl_Position = projection * view * matrices[gl_InstanceID] * vec4(aPos, 1.0f);
+  vec3 position = compactVertex ? aPos * positionScale + positionOffset : aPos;
+  vec3 normal = compactVertex ? OctahedralDecode(aNormal.xy) : aNormal;
+  mat4 model = FetchInstanceMatrix(gl_InstanceID);
+  gl_Position = projection * view * model * vec4(position, 1.0f);
   texCoords = vec2(aTexCoords.x, aTexCoords.y);
-  NormalVec = aNormal;
-  FragPos = vec3(matrices[gl_InstanceID] * vec4(aPos, 1.0));
+  NormalVec = normal;
+  FragPos = vec3(model * vec4(position, 1.0));
 }
\ No newline at end of file
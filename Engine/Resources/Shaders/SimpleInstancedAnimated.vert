@@ -8,19 +8,60 @@ layout(location = 4) in vec3 bitangent;
 layout(location = 5) in ivec4 boneID;
 layout(location = 6) in vec4 weight;
 
-const int MAX_BONES = 100;
 const int MAX_BONE_INFLUENCE = 4;
-uniform mat4 finalBonesMatrices[MAX_BONES];
+
+/* Final bone matrices of every animated object packed in a texture buffer (BonePalette.h), four texels per matrix */
+uniform samplerBuffer bonePalette;
+uniform int bonePaletteOffset;
+uniform int bonePaletteCount;
+
+mat4 FetchBoneMatrix(int bone)
+{
+  int texel = (bonePaletteOffset + bone) * 4;
+  return mat4(texelFetch(bonePalette, texel), texelFetch(bonePalette, texel + 1), texelFetch(bonePalette, texel + 2),
+              texelFetch(bonePalette, texel + 3));
+}
 
 out vec2 texCoords;
 out vec3 NormalVec;
 out vec3 FragPos;
 uniform mat4 view;
 uniform mat4 projection;
-uniform mat4 matrices[100];
+/* Transforms of the instances packed in a texture buffer (InstanceStream in OpenGLRender.h), instanceTexels per
+instance, three rows of an affine matrix or the four columns of a mat4 */
+uniform samplerBuffer instanceTransforms;
+uniform int instanceOffset;
+uniform int instanceTexels;
+
+mat4 FetchInstanceMatrix(int instance)
+{
+  int texel = (instanceOffset + instance) * instanceTexels;
+  if (instanceTexels == 3) {
+    return transpose(mat4(texelFetch(instanceTransforms, texel), texelFetch(instanceTransforms, texel + 1),
+                          texelFetch(instanceTransforms, texel + 2), vec4(0.0, 0.0, 0.0, 1.0)));
+  }
+  return mat4(texelFetch(instanceTransforms, texel), texelFetch(instanceTransforms, texel + 1),
+              texelFetch(instanceTransforms, texel + 2), texelFetch(instanceTransforms, texel + 3));
+}
+
+/* Compact vertices (VertexFormats.h) store the position relative to the mesh bounds and octahedral normals */
+uniform bool compactVertex;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+vec3 OctahedralDecode(vec2 encoded)
+{
+  vec3 direction = vec3(encoded.xy, 1.0 - abs(encoded.x) - abs(encoded.y));
+  float fold = max(-direction.z, 0.0);
+  direction.x += direction.x >= 0.0 ? -fold : fold;
+  direction.y += direction.y >= 0.0 ? -fold : fold;
+  return normalize(direction);
+}
 
 void main()
 {
+  vec3 position = compactVertex ? aPos * positionScale + positionOffset : aPos;
+  vec3 normal = compactVertex ? OctahedralDecode(aNormal.xy) : aNormal;
   vec4 totalPosition = vec4(0.0f);
   for (int x = 0; x < MAX_BONE_INFLUENCE; x++) {
 
@@ -28,17 +69,18 @@ void main()
       continue;
     }
 
-    if (boneID[x] >= MAX_BONES) {
-      totalPosition = vec4(aPos, 1.0f);
+    if (boneID[x] < 0 || boneID[x] >= bonePaletteCount) {
+      totalPosition = vec4(position, 1.0f);
       break;
     }
 
-    vec4 localPosition = finalBonesMatrices[boneID[x]] * vec4(aPos, 1.0f);
+    vec4 localPosition = FetchBoneMatrix(boneID[x]) * vec4(position, 1.0f);
     totalPosition += localPosition * weight[x];
   }
-  mat4 viewModel = view * matrices[gl_InstanceID];
+  mat4 model = FetchInstanceMatrix(gl_InstanceID);
+  mat4 viewModel = view * model;
   gl_Position = projection * viewModel * totalPosition;
   texCoords = vec2(aTexCoords.x, aTexCoords.y);
-  NormalVec = aNormal;
-  FragPos = vec3(matrices[gl_InstanceID] * vec4(totalPosition.xyz, 1.0));
+  NormalVec = normal;
+  FragPos = vec3(model * vec4(totalPosition.xyz, 1.0));
 }
\ No newline at end of file
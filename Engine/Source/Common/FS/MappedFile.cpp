@@ -0,0 +1,114 @@
+#include "MappedFile.h"
+using namespace Yeager;
+
+#if defined(YEAGER_SYSTEM_WINDOWS_x64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+#if defined(YEAGER_SYSTEM_WINDOWS_x64)
+bool MappedFile::Open(const String& path)
+{
+  Close();
+
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    Yeager::LogDebug(ERROR, "Cannot open {} for mapping!", path);
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    Yeager::LogDebug(ERROR, "Cannot map empty or unreadable file {}!", path);
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL) {
+    Yeager::LogDebug(ERROR, "Cannot create file mapping for {}!", path);
+    CloseHandle(file);
+    return false;
+  }
+
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == NULL) {
+    Yeager::LogDebug(ERROR, "Cannot map view of file {}!", path);
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  mFileHandle = file;
+  mMappingHandle = mapping;
+  mData = static_cast<const unsigned char*>(view);
+  mSize = static_cast<std::size_t>(size.QuadPart);
+  mPath = path;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (mData)
+    UnmapViewOfFile(mData);
+  if (mMappingHandle)
+    CloseHandle(mMappingHandle);
+  if (mFileHandle)
+    CloseHandle(mFileHandle);
+  mData = YEAGER_NULLPTR;
+  mMappingHandle = YEAGER_NULLPTR;
+  mFileHandle = YEAGER_NULLPTR;
+  mSize = 0;
+  mPath = YEAGER_NULL_LITERAL;
+}
+#else
+bool MappedFile::Open(const String& path)
+{
+  Close();
+
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    Yeager::LogDebug(ERROR, "Cannot open {} for mapping!", path);
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    Yeager::LogDebug(ERROR, "Cannot map empty or unreadable file {}!", path);
+    close(fd);
+    return false;
+  }
+
+  void* view = mmap(YEAGER_NULLPTR, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  /* The mapping keeps its own reference to the file, the descriptor is not needed anymore */
+  close(fd);
+  if (view == MAP_FAILED) {
+    Yeager::LogDebug(ERROR, "Cannot map file {}!", path);
+    return false;
+  }
+
+  mData = static_cast<const unsigned char*>(view);
+  mSize = static_cast<std::size_t>(info.st_size);
+  mPath = path;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (mData)
+    munmap(const_cast<unsigned char*>(mData), mSize);
+  mData = YEAGER_NULLPTR;
+  mSize = 0;
+  mPath = YEAGER_NULL_LITERAL;
+}
+#endif
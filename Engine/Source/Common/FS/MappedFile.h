@@ -0,0 +1,56 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+
+namespace Yeager {
+
+/**
+ * @brief Read only memory mapping of a whole file, the contents are paged in by the operating system on access instead of
+ * being copied into a buffer. The mapping is released when the object is destroyed
+ */
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool Open(const String& path);
+  void Close();
+
+  YEAGER_NODISCARD const unsigned char* GetData() const { return mData; }
+  YEAGER_NODISCARD std::size_t GetSize() const { return mSize; }
+  YEAGER_NODISCARD bool IsOpen() const { return mData != YEAGER_NULLPTR; }
+  YEAGER_NODISCARD const String& GetPath() const { return mPath; }
+
+ private:
+  const unsigned char* mData = YEAGER_NULLPTR;
+  std::size_t mSize = 0;
+  String mPath = YEAGER_NULL_LITERAL;
+#if defined(YEAGER_SYSTEM_WINDOWS_x64)
+  void* mFileHandle = YEAGER_NULLPTR;
+  void* mMappingHandle = YEAGER_NULLPTR;
+#endif
+};
+
+}  // namespace Yeager
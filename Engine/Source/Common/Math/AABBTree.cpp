@@ -0,0 +1,242 @@
+#include "AABBTree.h"
+using namespace Yeager;
+
+AABBTree::AABBTree(float margin) : mMargin(margin)
+{
+  mNodes.reserve(64);
+}
+
+int AABBTree::AllocateNode()
+{
+  if (mFreeList == YEAGER_AABB_TREE_NULL_NODE) {
+    mNodes.emplace_back();
+    mNodes.back().Height = 0;
+    return static_cast<int>(mNodes.size() - 1);
+  }
+
+  const int node = mFreeList;
+  mFreeList = mNodes[node].Parent;
+  mNodes[node] = AABBTreeNode();
+  mNodes[node].Height = 0;
+  return node;
+}
+
+void AABBTree::FreeNode(int node)
+{
+  mNodes[node].Parent = mFreeList;
+  mNodes[node].Height = -1;
+  mNodes[node].UserData = YEAGER_NULLPTR;
+  mFreeList = node;
+}
+
+void AABBTree::Clear()
+{
+  mNodes.clear();
+  mRoot = YEAGER_AABB_TREE_NULL_NODE;
+  mFreeList = YEAGER_AABB_TREE_NULL_NODE;
+  mProxyCount = 0;
+}
+
+int AABBTree::CreateProxy(const AABB& box, void* userData)
+{
+  const int proxy = AllocateNode();
+  const Vector3 margin(mMargin);
+  mNodes[proxy].Box = AABB(box.Min - margin, box.Max + margin);
+  mNodes[proxy].UserData = userData;
+  InsertLeaf(proxy);
+  mProxyCount++;
+  return proxy;
+}
+
+void AABBTree::DestroyProxy(int proxy)
+{
+  if (proxy < 0 || proxy >= static_cast<int>(mNodes.size()) || !mNodes[proxy].IsLeaf() || mNodes[proxy].Height != 0) {
+    Yeager::LogDebug(WARNING, "Trying to destroy a invalid proxy {} from the AABB tree!", proxy);
+    return;
+  }
+  RemoveLeaf(proxy);
+  FreeNode(proxy);
+  mProxyCount--;
+}
+
+bool AABBTree::MoveProxy(int proxy, const AABB& box)
+{
+  if (mNodes[proxy].Box.Contains(box))
+    return false;
+
+  RemoveLeaf(proxy);
+  const Vector3 margin(mMargin);
+  mNodes[proxy].Box = AABB(box.Min - margin, box.Max + margin);
+  InsertLeaf(proxy);
+  return true;
+}
+
+void AABBTree::InsertLeaf(int leaf)
+{
+  if (mRoot == YEAGER_AABB_TREE_NULL_NODE) {
+    mRoot = leaf;
+    mNodes[mRoot].Parent = YEAGER_AABB_TREE_NULL_NODE;
+    return;
+  }
+
+  /* Finds the best sibling, going down where the cost of the increased area is the smallest */
+  const AABB leafBox = mNodes[leaf].Box;
+  int index = mRoot;
+  while (!mNodes[index].IsLeaf()) {
+    const int child1 = mNodes[index].Child1;
+    const int child2 = mNodes[index].Child2;
+
+    const float area = mNodes[index].Box.GetPerimeter();
+    const float combinedArea = AABB::Merge(mNodes[index].Box, leafBox).GetPerimeter();
+
+    /* Cost of creating a new parent for this node and the new leaf */
+    const float cost = 2.0f * combinedArea;
+    /* Minimum cost of pushing the leaf further down the tree */
+    const float inheritanceCost = 2.0f * (combinedArea - area);
+
+    auto descendCost = [&](int child) {
+      const AABB merged = AABB::Merge(leafBox, mNodes[child].Box);
+      if (mNodes[child].IsLeaf())
+        return merged.GetPerimeter() + inheritanceCost;
+      return (merged.GetPerimeter() - mNodes[child].Box.GetPerimeter()) + inheritanceCost;
+    };
+
+    const float cost1 = descendCost(child1);
+    const float cost2 = descendCost(child2);
+
+    if (cost < cost1 && cost < cost2)
+      break;
+
+    index = cost1 < cost2 ? child1 : child2;
+  }
+
+  const int sibling = index;
+  const int oldParent = mNodes[sibling].Parent;
+  const int newParent = AllocateNode();
+  mNodes[newParent].Parent = oldParent;
+  mNodes[newParent].Box = AABB::Merge(leafBox, mNodes[sibling].Box);
+  mNodes[newParent].Height = mNodes[sibling].Height + 1;
+  mNodes[newParent].Child1 = sibling;
+  mNodes[newParent].Child2 = leaf;
+  mNodes[sibling].Parent = newParent;
+  mNodes[leaf].Parent = newParent;
+
+  if (oldParent != YEAGER_AABB_TREE_NULL_NODE) {
+    if (mNodes[oldParent].Child1 == sibling) {
+      mNodes[oldParent].Child1 = newParent;
+    } else {
+      mNodes[oldParent].Child2 = newParent;
+    }
+  } else {
+    mRoot = newParent;
+  }
+
+  RefitAncestors(mNodes[leaf].Parent);
+}
+
+void AABBTree::RemoveLeaf(int leaf)
+{
+  if (leaf == mRoot) {
+    mRoot = YEAGER_AABB_TREE_NULL_NODE;
+    return;
+  }
+
+  const int parent = mNodes[leaf].Parent;
+  const int grandParent = mNodes[parent].Parent;
+  const int sibling = mNodes[parent].Child1 == leaf ? mNodes[parent].Child2 : mNodes[parent].Child1;
+
+  if (grandParent != YEAGER_AABB_TREE_NULL_NODE) {
+    if (mNodes[grandParent].Child1 == parent) {
+      mNodes[grandParent].Child1 = sibling;
+    } else {
+      mNodes[grandParent].Child2 = sibling;
+    }
+    mNodes[sibling].Parent = grandParent;
+    FreeNode(parent);
+    RefitAncestors(grandParent);
+  } else {
+    mRoot = sibling;
+    mNodes[sibling].Parent = YEAGER_AABB_TREE_NULL_NODE;
+    FreeNode(parent);
+  }
+}
+
+void AABBTree::RefitAncestors(int node)
+{
+  while (node != YEAGER_AABB_TREE_NULL_NODE) {
+    node = Balance(node);
+
+    const int child1 = mNodes[node].Child1;
+    const int child2 = mNodes[node].Child2;
+    mNodes[node].Height = 1 + std::max(mNodes[child1].Height, mNodes[child2].Height);
+    mNodes[node].Box = AABB::Merge(mNodes[child1].Box, mNodes[child2].Box);
+
+    node = mNodes[node].Parent;
+  }
+}
+
+int AABBTree::Balance(int iA)
+{
+  AABBTreeNode* A = &mNodes[iA];
+  if (A->IsLeaf() || A->Height < 2)
+    return iA;
+
+  const int iB = A->Child1;
+  const int iC = A->Child2;
+  AABBTreeNode* B = &mNodes[iB];
+  AABBTreeNode* C = &mNodes[iC];
+  const int balance = C->Height - B->Height;
+
+  /* Rotates the taller child up, the lower of its children takes the place of it */
+  auto rotate = [&](int iUp, AABBTreeNode* up, int iOther, AABBTreeNode* other, bool upIsChild2) {
+    const int iF = up->Child1;
+    const int iG = up->Child2;
+    AABBTreeNode* F = &mNodes[iF];
+    AABBTreeNode* G = &mNodes[iG];
+
+    up->Child1 = iA;
+    up->Parent = A->Parent;
+    A->Parent = iUp;
+
+    if (up->Parent != YEAGER_AABB_TREE_NULL_NODE) {
+      if (mNodes[up->Parent].Child1 == iA) {
+        mNodes[up->Parent].Child1 = iUp;
+      } else {
+        mNodes[up->Parent].Child2 = iUp;
+      }
+    } else {
+      mRoot = iUp;
+    }
+
+    int iKeep = iF, iMove = iG;
+    if (F->Height <= G->Height) {
+      iKeep = iG;
+      iMove = iF;
+    }
+
+    up->Child2 = iKeep;
+    if (upIsChild2) {
+      A->Child2 = iMove;
+    } else {
+      A->Child1 = iMove;
+    }
+    mNodes[iMove].Parent = iA;
+
+    A->Box = AABB::Merge(other->Box, mNodes[iMove].Box);
+    up->Box = AABB::Merge(A->Box, mNodes[iKeep].Box);
+    A->Height = 1 + std::max(other->Height, mNodes[iMove].Height);
+    up->Height = 1 + std::max(A->Height, mNodes[iKeep].Height);
+  };
+
+  if (balance > 1) {
+    rotate(iC, C, iB, B, true);
+    return iC;
+  }
+
+  if (balance < -1) {
+    rotate(iB, B, iC, C, false);
+    return iB;
+  }
+
+  return iA;
+}
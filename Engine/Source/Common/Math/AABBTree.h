@@ -0,0 +1,169 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Math/BoundingVolumes.h"
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#define YEAGER_AABB_TREE_NULL_NODE -1
+
+namespace Yeager {
+
+struct AABBTreeNode {
+  YEAGER_FORCE_INLINE bool IsLeaf() const { return Child1 == YEAGER_AABB_TREE_NULL_NODE; }
+
+  /* Leaves store the fat box (enlarged by the margin), so small movements dont need to touch the tree */
+  AABB Box;
+  void* UserData = YEAGER_NULLPTR;
+  /* Parent while in the tree, next free node while in the free list */
+  int Parent = YEAGER_AABB_TREE_NULL_NODE;
+  int Child1 = YEAGER_AABB_TREE_NULL_NODE;
+  int Child2 = YEAGER_AABB_TREE_NULL_NODE;
+  /* Leaf = 0, free node = -1 */
+  int Height = -1;
+};
+
+/**
+ * @brief Dynamic bounding volume hierarchy of axis aligned boxes. Leaves are inserted where the increase of the surface
+ * area is the smallest and the tree is balanced with rotations on the way up, like the dynamic tree of Box2D. Proxies
+ * are the index of the leaf node and stay valid until destroyed. GL free, only stores user pointers
+ */
+class AABBTree {
+ public:
+  AABBTree(float margin = 0.1f);
+
+  /** @brief Creates a leaf for the box, returns the proxy id */
+  int CreateProxy(const AABB& box, void* userData);
+  void DestroyProxy(int proxy);
+
+  /** @brief Updates the box of the proxy, returns true if the leaf had to be reinserted (the box left the fat box) */
+  bool MoveProxy(int proxy, const AABB& box);
+
+  YEAGER_NODISCARD void* GetUserData(int proxy) const { return mNodes[proxy].UserData; }
+  YEAGER_NODISCARD const AABB& GetFatAABB(int proxy) const { return mNodes[proxy].Box; }
+  YEAGER_NODISCARD Uint GetProxyCount() const { return mProxyCount; }
+  YEAGER_NODISCARD int GetHeight() const { return mRoot == YEAGER_AABB_TREE_NULL_NODE ? 0 : mNodes[mRoot].Height; }
+
+  /** @brief Removes every proxy from the tree, the memory is kept */
+  void Clear();
+
+  /**
+   * @brief Calls callback(void* userData) for every proxy that intersects the frustum. Subtrees fully inside are
+   * reported without testing their boxes, and the planes a parent is fully inside are not tested again on the children
+   */
+  template <typename Callback>
+  void QueryFrustum(const Frustum& frustum, Callback&& callback) const;
+
+  /** @brief Calls callback(void* userData) for every proxy whose fat box overlaps the box */
+  template <typename Callback>
+  void Query(const AABB& box, Callback&& callback) const;
+
+ private:
+  int AllocateNode();
+  void FreeNode(int node);
+  void InsertLeaf(int leaf);
+  void RemoveLeaf(int leaf);
+  int Balance(int node);
+  void RefitAncestors(int node);
+
+  template <typename Callback>
+  void ReportSubtree(int node, Callback& callback) const;
+
+  std::vector<AABBTreeNode> mNodes;
+  int mRoot = YEAGER_AABB_TREE_NULL_NODE;
+  int mFreeList = YEAGER_AABB_TREE_NULL_NODE;
+  Uint mProxyCount = 0;
+  float mMargin = 0.1f;
+  mutable std::vector<std::pair<int, Uint>> mStack;
+};
+
+template <typename Callback>
+void AABBTree::ReportSubtree(int node, Callback& callback) const
+{
+  const std::size_t base = mStack.size();
+  mStack.push_back(std::pair<int, Uint>(node, 0));
+  while (mStack.size() > base) {
+    const int id = mStack.back().first;
+    mStack.pop_back();
+    const AABBTreeNode& n = mNodes[id];
+    if (n.IsLeaf()) {
+      callback(n.UserData);
+    } else {
+      mStack.push_back(std::pair<int, Uint>(n.Child1, 0));
+      mStack.push_back(std::pair<int, Uint>(n.Child2, 0));
+    }
+  }
+}
+
+template <typename Callback>
+void AABBTree::QueryFrustum(const Frustum& frustum, Callback&& callback) const
+{
+  if (mRoot == YEAGER_AABB_TREE_NULL_NODE)
+    return;
+
+  mStack.clear();
+  mStack.push_back(std::pair<int, Uint>(mRoot, Frustum::sAllPlanesMask));
+  while (!mStack.empty()) {
+    auto [id, mask] = mStack.back();
+    mStack.pop_back();
+
+    const AABBTreeNode& node = mNodes[id];
+    const FrustumIntersection::Enum result = frustum.Classify(node.Box, &mask);
+    if (result == FrustumIntersection::eOUTSIDE)
+      continue;
+
+    if (node.IsLeaf()) {
+      callback(node.UserData);
+    } else if (result == FrustumIntersection::eINSIDE) {
+      ReportSubtree(id, callback);
+    } else {
+      mStack.push_back(std::pair<int, Uint>(node.Child1, mask));
+      mStack.push_back(std::pair<int, Uint>(node.Child2, mask));
+    }
+  }
+}
+
+template <typename Callback>
+void AABBTree::Query(const AABB& box, Callback&& callback) const
+{
+  if (mRoot == YEAGER_AABB_TREE_NULL_NODE)
+    return;
+
+  mStack.clear();
+  mStack.push_back(std::pair<int, Uint>(mRoot, 0));
+  while (!mStack.empty()) {
+    const int id = mStack.back().first;
+    mStack.pop_back();
+
+    const AABBTreeNode& node = mNodes[id];
+    if (!node.Box.Overlaps(box))
+      continue;
+
+    if (node.IsLeaf()) {
+      callback(node.UserData);
+    } else {
+      mStack.push_back(std::pair<int, Uint>(node.Child1, 0));
+      mStack.push_back(std::pair<int, Uint>(node.Child2, 0));
+    }
+  }
+}
+
+}  // namespace Yeager
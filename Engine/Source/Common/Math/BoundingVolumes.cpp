@@ -0,0 +1,95 @@
+#include "BoundingVolumes.h"
+using namespace Yeager;
+
+AABB AABB::Transform(const Matrix4& matrix) const
+{
+  if (!IsValid())
+    return *this;
+
+  /* Starts from the translation and adds the minimum and maximum contributions of each axis */
+  const Vector3 translation = Vector3(matrix[3]);
+  AABB result(translation, translation);
+  for (int col = 0; col < 3; col++) {
+    for (int row = 0; row < 3; row++) {
+      const float a = matrix[col][row] * Min[col];
+      const float b = matrix[col][row] * Max[col];
+      result.Min[row] += std::min(a, b);
+      result.Max[row] += std::max(a, b);
+    }
+  }
+  return result;
+}
+
+AABB Yeager::ComputeAABB(const float* positions, std::size_t count, std::size_t stride)
+{
+  AABB box;
+  for (std::size_t x = 0; x < count; x++) {
+    const float* p = positions + x * stride;
+    box.Expand(Vector3(p[0], p[1], p[2]));
+  }
+  return box;
+}
+
+Frustum Frustum::FromMatrix(const Matrix4& m)
+{
+  Frustum frustum;
+  /* glm matrices are column major, m[col][row] */
+  const Vector4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+  const Vector4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+  const Vector4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+  const Vector4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+  const Vector4 planes[ePLANES_COUNT] = {row3 + row0, row3 - row0, row3 + row1,
+                                         row3 - row1, row3 + row2, row3 - row2};
+
+  for (Uint x = 0; x < ePLANES_COUNT; x++) {
+    const Vector3 normal(planes[x]);
+    const float length = glm::length(normal);
+    const float inv = length > 0.0f ? 1.0f / length : 0.0f;
+    frustum.Planes[x].Normal = normal * inv;
+    frustum.Planes[x].Distance = planes[x].w * inv;
+  }
+  return frustum;
+}
+
+FrustumIntersection::Enum Frustum::Classify(const AABB& box, Uint* planeMask) const
+{
+  const Vector3 center = box.GetCenter();
+  const Vector3 extents = box.GetExtents();
+  FrustumIntersection::Enum result = FrustumIntersection::eINSIDE;
+
+  for (Uint x = 0; x < ePLANES_COUNT; x++) {
+    const Uint bit = 1u << x;
+    if (!(*planeMask & bit))
+      continue;
+
+    const Plane& plane = Planes[x];
+    const float distance = plane.SignedDistance(center);
+    const float radius = glm::dot(extents, glm::abs(plane.Normal));
+
+    if (distance < -radius)
+      return FrustumIntersection::eOUTSIDE;
+
+    if (distance >= radius) {
+      *planeMask &= ~bit;  // Fully inside this plane, the children dont need to test it
+    } else {
+      result = FrustumIntersection::eINTERSECT;
+    }
+  }
+  return result;
+}
+
+bool Frustum::Intersects(const AABB& box) const
+{
+  Uint mask = sAllPlanesMask;
+  return Classify(box, &mask) != FrustumIntersection::eOUTSIDE;
+}
+
+bool Frustum::Intersects(const Vector3& center, float radius) const
+{
+  for (const auto& plane : Planes) {
+    if (plane.SignedDistance(center) < -radius)
+      return false;
+  }
+  return true;
+}
@@ -0,0 +1,114 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cfloat>
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+/** @brief Axis aligned bounding box, a box created with the default constructor is invalid (min > max) until a point is added */
+struct AABB {
+  Vector3 Min = Vector3(FLT_MAX);
+  Vector3 Max = Vector3(-FLT_MAX);
+
+  AABB() = default;
+  AABB(const Vector3& min, const Vector3& max) : Min(min), Max(max) {}
+
+  YEAGER_FORCE_INLINE bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+  YEAGER_FORCE_INLINE Vector3 GetCenter() const { return (Min + Max) * 0.5f; }
+  YEAGER_FORCE_INLINE Vector3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+  YEAGER_FORCE_INLINE void Expand(const Vector3& point)
+  {
+    Min = glm::min(Min, point);
+    Max = glm::max(Max, point);
+  }
+
+  YEAGER_FORCE_INLINE void Expand(const AABB& box)
+  {
+    Min = glm::min(Min, box.Min);
+    Max = glm::max(Max, box.Max);
+  }
+
+  /** @brief Half of the surface area, used as the cost on the tree insertion */
+  YEAGER_FORCE_INLINE float GetPerimeter() const
+  {
+    const Vector3 d = Max - Min;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+  }
+
+  YEAGER_FORCE_INLINE bool Contains(const AABB& box) const
+  {
+    return Min.x <= box.Min.x && Min.y <= box.Min.y && Min.z <= box.Min.z && box.Max.x <= Max.x &&
+           box.Max.y <= Max.y && box.Max.z <= Max.z;
+  }
+
+  YEAGER_FORCE_INLINE bool Overlaps(const AABB& box) const
+  {
+    return Min.x <= box.Max.x && Max.x >= box.Min.x && Min.y <= box.Max.y && Max.y >= box.Min.y &&
+           Min.z <= box.Max.z && Max.z >= box.Min.z;
+  }
+
+  YEAGER_FORCE_INLINE static AABB Merge(const AABB& a, const AABB& b)
+  {
+    return AABB(glm::min(a.Min, b.Min), glm::max(a.Max, b.Max));
+  }
+
+  /** @brief Returns the box that encloses this box after being transformed by the matrix (Arvo's method) */
+  YEAGER_NODISCARD AABB Transform(const Matrix4& matrix) const;
+};
+
+/** @brief Computes the bounding box of a array of positions, the stride is given in floats (8 for the geometry vertices) */
+YEAGER_NODISCARD extern AABB ComputeAABB(const float* positions, std::size_t count, std::size_t stride);
+
+/** @brief Plane in the form dot(Normal, p) + Distance = 0, the normal points to the inside of the frustum */
+struct Plane {
+  Vector3 Normal = Vector3(0.0f, 1.0f, 0.0f);
+  float Distance = 0.0f;
+
+  YEAGER_FORCE_INLINE float SignedDistance(const Vector3& point) const { return glm::dot(Normal, point) + Distance; }
+};
+
+struct FrustumIntersection {
+  enum Enum { eOUTSIDE, eINTERSECT, eINSIDE };
+};
+
+/**
+ * @brief The six planes of the camera view volume, extracted from the projection * view matrix (Gribb & Hartmann)
+ */
+struct Frustum {
+  enum PlaneIndex { eLEFT, eRIGHT, eBOTTOM, eTOP, eNEAR, eFAR, ePLANES_COUNT };
+  /* Mask with every plane set, the tree traversal clears the planes the parent box is fully inside of */
+  static YEAGER_CONSTEXPR Uint sAllPlanesMask = (1u << ePLANES_COUNT) - 1;
+
+  Plane Planes[ePLANES_COUNT];
+
+  YEAGER_NODISCARD static Frustum FromMatrix(const Matrix4& projectionView);
+
+  /** @brief Only tests the planes set on the mask, and clears from the mask the planes the box is fully inside */
+  YEAGER_NODISCARD FrustumIntersection::Enum Classify(const AABB& box, Uint* planeMask) const;
+  YEAGER_NODISCARD bool Intersects(const AABB& box) const;
+  YEAGER_NODISCARD bool Intersects(const Vector3& center, float radius) const;
+};
+
+}  // namespace Yeager
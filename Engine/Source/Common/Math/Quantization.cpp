@@ -0,0 +1,276 @@
+#include "Quantization.h"
+using namespace Yeager;
+
+uint16_t Yeager::FloatToHalf(float value)
+{
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const uint32_t sign = (bits >> 16) & 0x8000u;
+  const uint32_t exponent = (bits >> 23) & 0xFFu;
+  uint32_t mantissa = bits & 0x7FFFFFu;
+
+  if (exponent == 0xFFu) {
+    /* Infinity stays infinity, NaN keeps a mantissa bit set so it does not turn into infinity */
+    return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u | (mantissa >> 13) : 0u));
+  }
+
+  const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+  if (halfExponent >= 0x1F) {
+    return static_cast<uint16_t>(sign | 0x7C00u);
+  }
+
+  if (halfExponent <= 0) {
+    /* Subnormal half, the implicit bit becomes explicit and the mantissa is shifted with rounding */
+    if (halfExponent < -10)
+      return static_cast<uint16_t>(sign);
+    mantissa |= 0x800000u;
+    const uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+    uint32_t half = mantissa >> shift;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+    const uint32_t halfway = 1u << (shift - 1u);
+    if (remainder > halfway || (remainder == halfway && (half & 1u)))
+      half++;
+    return static_cast<uint16_t>(sign | half);
+  }
+
+  uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+  const uint32_t remainder = mantissa & 0x1FFFu;
+  /* A carry out of the mantissa moves into the exponent, which is the correct rounding up to infinity */
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+    half++;
+  return static_cast<uint16_t>(sign | half);
+}
+
+float Yeager::HalfToFloat(uint16_t half)
+{
+  const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+  uint32_t exponent = (half >> 10) & 0x1Fu;
+  uint32_t mantissa = half & 0x3FFu;
+  uint32_t bits = 0;
+
+  if (exponent == 0x1Fu) {
+    bits = sign | 0x7F800000u | (mantissa << 13);
+  } else if (exponent == 0) {
+    if (mantissa == 0) {
+      bits = sign;
+    } else {
+      /* Subnormal half, normalize it since every half subnormal is a normal float */
+      exponent = 127 - 15 + 1;
+      while ((mantissa & 0x400u) == 0) {
+        mantissa <<= 1;
+        exponent--;
+      }
+      bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+  } else {
+    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  }
+
+  float value = 0.0f;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+int16_t Yeager::QuantizeSnorm16(float value)
+{
+  const float clamped = std::clamp(value, -1.0f, 1.0f);
+  return static_cast<int16_t>(std::lround(clamped * 32767.0f));
+}
+
+float Yeager::DequantizeSnorm16(int16_t value)
+{
+  /* OpenGL 4.2 rule, -32768 and -32767 both map to -1 */
+  return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+}
+
+uint8_t Yeager::QuantizeUnorm8(float value)
+{
+  const float clamped = std::clamp(value, 0.0f, 1.0f);
+  return static_cast<uint8_t>(std::lround(clamped * 255.0f));
+}
+
+float Yeager::DequantizeUnorm8(uint8_t value)
+{
+  return static_cast<float>(value) / 255.0f;
+}
+
+uint16_t Yeager::QuantizeUnorm16(float value)
+{
+  const float clamped = std::clamp(value, 0.0f, 1.0f);
+  return static_cast<uint16_t>(std::lround(clamped * 65535.0f));
+}
+
+float Yeager::DequantizeUnorm16(uint16_t value)
+{
+  return static_cast<float>(value) / 65535.0f;
+}
+
+Vector2 Yeager::OctahedralEncode(const Vector3& direction)
+{
+  const float sum = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+  if (sum <= 0.0f)
+    return Vector2(0.0f, 0.0f);
+
+  Vector2 encoded = Vector2(direction.x, direction.y) / sum;
+  if (direction.z < 0.0f) {
+    /* Lower hemisphere is folded over the diagonals of the square */
+    const Vector2 folded = Vector2(1.0f - std::abs(encoded.y), 1.0f - std::abs(encoded.x));
+    encoded.x = encoded.x >= 0.0f ? folded.x : -folded.x;
+    encoded.y = encoded.y >= 0.0f ? folded.y : -folded.y;
+  }
+  return encoded;
+}
+
+Vector3 Yeager::OctahedralDecode(const Vector2& encoded)
+{
+  Vector3 direction = Vector3(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+  const float fold = std::max(-direction.z, 0.0f);
+  direction.x += direction.x >= 0.0f ? -fold : fold;
+  direction.y += direction.y >= 0.0f ? -fold : fold;
+  return glm::normalize(direction);
+}
+
+void Yeager::OctahedralEncodeSnorm16(const Vector3& direction, int16_t output[2])
+{
+  const float length = glm::length(direction);
+  if (length <= 0.0f) {
+    output[0] = output[1] = 0;
+    return;
+  }
+
+  const Vector3 unit = direction / length;
+  const Vector2 encoded = OctahedralEncode(unit);
+
+  /* Rounding each axis on its own is not always the closest point on the sphere, try the floor/ceil combinations */
+  const float baseX = std::floor(std::clamp(encoded.x, -1.0f, 1.0f) * 32767.0f);
+  const float baseY = std::floor(std::clamp(encoded.y, -1.0f, 1.0f) * 32767.0f);
+  float bestError = -FLT_MAX;
+  for (int x = 0; x < 2; x++) {
+    for (int y = 0; y < 2; y++) {
+      const int16_t candidate[2] = {static_cast<int16_t>(std::clamp(baseX + x, -32767.0f, 32767.0f)),
+                                    static_cast<int16_t>(std::clamp(baseY + y, -32767.0f, 32767.0f))};
+      const float error = glm::dot(OctahedralDecodeSnorm16(candidate), unit);
+      if (error > bestError) {
+        bestError = error;
+        output[0] = candidate[0];
+        output[1] = candidate[1];
+      }
+    }
+  }
+}
+
+Vector3 Yeager::OctahedralDecodeSnorm16(const int16_t encoded[2])
+{
+  return OctahedralDecode(Vector2(DequantizeSnorm16(encoded[0]), DequantizeSnorm16(encoded[1])));
+}
+
+void Yeager::QuantizeWeightsUnorm8(const float* weights, Uint count, uint8_t* output)
+{
+  float sum = 0.0f;
+  for (Uint x = 0; x < count; x++)
+    sum += std::max(weights[x], 0.0f);
+
+  if (sum <= 0.0f) {
+    std::fill(output, output + count, static_cast<uint8_t>(0));
+    return;
+  }
+
+  int total = 0;
+  Uint largest = 0;
+  for (Uint x = 0; x < count; x++) {
+    output[x] = QuantizeUnorm8(std::max(weights[x], 0.0f) / sum);
+    total += output[x];
+    if (output[x] > output[largest])
+      largest = x;
+  }
+  output[largest] = static_cast<uint8_t>(std::clamp(output[largest] + (255 - total), 0, 255));
+}
+
+PositionQuantization PositionQuantization::FromBounds(const AABB& bounds)
+{
+  PositionQuantization quantization;
+  if (!bounds.IsValid())
+    return quantization;
+
+  quantization.Offset = bounds.GetCenter();
+  const Vector3 extents = bounds.GetExtents();
+  for (int axis = 0; axis < 3; axis++)
+    quantization.Scale[axis] = extents[axis] > 0.0f ? extents[axis] : 1.0f;
+  return quantization;
+}
+
+void PositionQuantization::Encode(const Vector3& position, int16_t output[4]) const
+{
+  const Vector3 normalized = (position - Offset) / Scale;
+  output[0] = QuantizeSnorm16(normalized.x);
+  output[1] = QuantizeSnorm16(normalized.y);
+  output[2] = QuantizeSnorm16(normalized.z);
+  /* Padding so each position is 8 bytes aligned, the shader only reads the xyz */
+  output[3] = 0;
+}
+
+Vector3 PositionQuantization::Decode(const int16_t encoded[4]) const
+{
+  const Vector3 normalized =
+      Vector3(DequantizeSnorm16(encoded[0]), DequantizeSnorm16(encoded[1]), DequantizeSnorm16(encoded[2]));
+  return normalized * Scale + Offset;
+}
+
+/* Smallest three components of a unit quaternion, the largest is at least 1/2 so the others are at most 1/sqrt(2) */
+static YEAGER_CONSTEXPR float sQuat48Range = 0.70710678f;
+static YEAGER_CONSTEXPR uint32_t sQuat48Max = 0x7FFFu;
+
+PackedQuat48 Yeager::PackQuat48(const glm::quat& rotation)
+{
+  PackedQuat48 packed;
+  const float length = glm::length(rotation);
+  const glm::quat unit = length > 0.0f ? rotation / length : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+  const float components[4] = {unit.x, unit.y, unit.z, unit.w};
+
+  Uint largest = 0;
+  for (Uint x = 1; x < 4; x++) {
+    if (std::abs(components[x]) > std::abs(components[largest]))
+      largest = x;
+  }
+  /* q and -q are the same rotation, the largest component is made positive so its sign does not need to be stored */
+  const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+  uint64_t bits = largest;
+  Uint shift = 2;
+  for (Uint x = 0; x < 4; x++) {
+    if (x == largest)
+      continue;
+    const float normalized = std::clamp(components[x] * sign / sQuat48Range * 0.5f + 0.5f, 0.0f, 1.0f);
+    bits |= static_cast<uint64_t>(std::lround(normalized * static_cast<float>(sQuat48Max))) << shift;
+    shift += 15;
+  }
+
+  packed.Data[0] = static_cast<uint16_t>(bits);
+  packed.Data[1] = static_cast<uint16_t>(bits >> 16);
+  packed.Data[2] = static_cast<uint16_t>(bits >> 32);
+  return packed;
+}
+
+glm::quat Yeager::UnpackQuat48(const PackedQuat48& packed)
+{
+  const uint64_t bits = static_cast<uint64_t>(packed.Data[0]) | (static_cast<uint64_t>(packed.Data[1]) << 16) |
+                        (static_cast<uint64_t>(packed.Data[2]) << 32);
+  const Uint largest = static_cast<Uint>(bits & 0x3u);
+
+  float components[4] = {0.0f};
+  float sum = 0.0f;
+  Uint shift = 2;
+  for (Uint x = 0; x < 4; x++) {
+    if (x == largest)
+      continue;
+    const float normalized = static_cast<float>((bits >> shift) & sQuat48Max) / static_cast<float>(sQuat48Max);
+    components[x] = (normalized * 2.0f - 1.0f) * sQuat48Range;
+    sum += components[x] * components[x];
+    shift += 15;
+  }
+  components[largest] = std::sqrt(std::max(1.0f - sum, 0.0f));
+  return glm::quat(components[3], components[0], components[1], components[2]);
+}
+
+/* Same factor the bones sample with, so a removed key is checked against what the playback will actually show */
@@ -0,0 +1,101 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+
+#include "Common/Math/BoundingVolumes.h"
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include <glm/gtc/quaternion.hpp>
+
+namespace Yeager {
+
+/**
+ * Encoders and decoders used by the compact vertex formats and the compressed animations. The vertex decoders return
+ * what the GPU reads when the same bits are bound with the matching attribute type (GL_HALF_FLOAT, normalized GL_SHORT,
+ * normalized GL_UNSIGNED_BYTE)
+ */
+
+/** @brief IEEE 754 binary16, rounds to nearest even, overflows to infinity and keeps NaN */
+YEAGER_NODISCARD extern uint16_t FloatToHalf(float value);
+YEAGER_NODISCARD extern float HalfToFloat(uint16_t half);
+
+/** @brief Signed normalized 16 bits, the value is clamped to [-1, 1] */
+YEAGER_NODISCARD extern int16_t QuantizeSnorm16(float value);
+YEAGER_NODISCARD extern float DequantizeSnorm16(int16_t value);
+
+/** @brief Unsigned normalized 8 bits, the value is clamped to [0, 1] */
+YEAGER_NODISCARD extern uint8_t QuantizeUnorm8(float value);
+YEAGER_NODISCARD extern float DequantizeUnorm8(uint8_t value);
+
+/** @brief Unsigned normalized 16 bits, the value is clamped to [0, 1] */
+YEAGER_NODISCARD extern uint16_t QuantizeUnorm16(float value);
+YEAGER_NODISCARD extern float DequantizeUnorm16(uint16_t value);
+
+/** @brief Maps a unit vector to the [-1, 1] square by folding the octahedron (Meyer et al.), the input is normalized here */
+YEAGER_NODISCARD extern Vector2 OctahedralEncode(const Vector3& direction);
+YEAGER_NODISCARD extern Vector3 OctahedralDecode(const Vector2& encoded);
+
+/**
+ * @brief Octahedral encoding stored as two snorm16, the four neighbours of the quantized point are tested and the one that
+ * decodes closest to the direction is kept, so the error stays under 0.01 degrees
+ */
+extern void OctahedralEncodeSnorm16(const Vector3& direction, int16_t output[2]);
+YEAGER_NODISCARD extern Vector3 OctahedralDecodeSnorm16(const int16_t encoded[2]);
+
+/**
+ * @brief Quantizes the skinning weights so they still sum to exactly 255, the rounding error goes to the largest weight.
+ * Weights of zero or below (unused influences) stay zero
+ */
+extern void QuantizeWeightsUnorm8(const float* weights, Uint count, uint8_t* output);
+
+/**
+ * @brief Maps the positions of a mesh from its bounding box to [-1, 1], the shader rebuilds them with
+ * position * Scale + Offset. Flat axes keep a scale of 1 so nothing is divided by zero
+ */
+struct PositionQuantization {
+  Vector3 Offset = Vector3(0.0f);
+  Vector3 Scale = Vector3(1.0f);
+
+  YEAGER_NODISCARD static PositionQuantization FromBounds(const AABB& bounds);
+
+  void Encode(const Vector3& position, int16_t output[4]) const;
+  YEAGER_NODISCARD Vector3 Decode(const int16_t encoded[4]) const;
+  /** @brief Worst error of a decoded position on each axis, half of a quantization step */
+  YEAGER_NODISCARD Vector3 GetMaxError() const { return Scale / 32767.0f * 0.5f; }
+};
+
+/**
+ * @brief Unit quaternion in 48 bits with the smallest three encoding. The 2 low bits hold the index of the largest
+ * component, which is made positive and dropped, the other three are stored with 15 bits each over [-1/sqrt(2), 1/sqrt(2)]
+ * and the largest is rebuilt from the unit length. The error stays under 0.01 degrees
+ */
+struct PackedQuat48 {
+  uint16_t Data[3] = {0, 0, 0};
+};
+
+YEAGER_NODISCARD extern PackedQuat48 PackQuat48(const glm::quat& rotation);
+YEAGER_NODISCARD extern glm::quat UnpackQuat48(const PackedQuat48& packed);
+
+}  // namespace Yeager
@@ -0,0 +1,227 @@
+#include "AnimationCache.h"
+#include "Common/FS/MappedFile.h"
+using namespace Yeager;
+
+std::optional<uint64_t> AnimationCache::ComputeKey(const String& sourcePath, const AnimationCompressionSettings& settings)
+{
+  MappedFile source;
+  if (!source.Open(sourcePath))
+    return std::nullopt;
+
+  const uint64_t size = source.GetSize();
+  uint64_t key = HashCacheBytes(source.GetData(), source.GetSize());
+  key = HashCacheBytes(reinterpret_cast<const unsigned char*>(&size), sizeof(size), key);
+  key = HashCacheBytes(reinterpret_cast<const unsigned char*>(&settings), sizeof(AnimationCompressionSettings), key);
+  return key;
+}
+
+String AnimationCache::BuildCachePath(const String& folder, uint64_t key)
+{
+  return folder + YG_PS + fmt::format("{:016x}", key) + YEAGER_ANIMATION_CACHE_EXT_STR;
+}
+
+template <typename T>
+static void WriteCacheValue(std::vector<unsigned char>& buffer, const T& value)
+{
+  const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+static void WriteCacheString(std::vector<unsigned char>& buffer, const String& str)
+{
+  WriteCacheValue(buffer, static_cast<uint32_t>(str.size()));
+  buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+template <typename T>
+static void WriteCacheArray(std::vector<unsigned char>& buffer, const std::vector<T>& values)
+{
+  WriteCacheValue(buffer, static_cast<uint32_t>(values.size()));
+  const auto* bytes = reinterpret_cast<const unsigned char*>(values.data());
+  buffer.insert(buffer.end(), bytes, bytes + values.size() * sizeof(T));
+}
+
+static void WriteCacheNode(std::vector<unsigned char>& buffer, const AssimpNodeData& node, uint32_t& count)
+{
+  count++;
+  WriteCacheString(buffer, node.Name);
+  WriteCacheValue(buffer, node.Transformation);
+  WriteCacheValue(buffer, static_cast<uint32_t>(node.Children.size()));
+  for (const auto& child : node.Children) {
+    WriteCacheNode(buffer, child, count);
+  }
+}
+
+static void WriteCacheVectorTrack(std::vector<unsigned char>& buffer, const QuantizedVectorTrack& track)
+{
+  WriteCacheValue(buffer, track.Min);
+  WriteCacheValue(buffer, track.Extent);
+  WriteCacheArray(buffer, track.Times);
+  WriteCacheArray(buffer, track.Values);
+}
+
+bool AnimationCache::Write(const AnimationCacheEntry& entry, const AnimationCacheData& data)
+{
+  AnimationCacheHeader header;
+  std::memcpy(header.MagicConst, YEAGER_ANIMATION_CACHE_MAGIC_CONST, sizeof(header.MagicConst));
+  header.Version = YEAGER_ANIMATION_CACHE_VERSION;
+  header.Key = entry.Key;
+  header.ClipCount = static_cast<uint32_t>(data.Clips.size());
+
+  std::vector<unsigned char> buffer(sizeof(AnimationCacheHeader), 0);
+  WriteCacheNode(buffer, data.RootNode, header.NodeCount);
+  for (const auto& clip : data.Clips) {
+    WriteCacheString(buffer, clip.Name);
+    WriteCacheValue(buffer, clip.Duration);
+    WriteCacheValue(buffer, static_cast<int32_t>(clip.TicksPerSecond));
+    WriteCacheValue(buffer, clip.TimeMin);
+    WriteCacheValue(buffer, clip.TimeStep);
+    WriteCacheValue(buffer, static_cast<uint32_t>(clip.Tracks.size()));
+    for (const auto& track : clip.Tracks) {
+      WriteCacheString(buffer, track.Name);
+      WriteCacheVectorTrack(buffer, track.Positions);
+      WriteCacheArray(buffer, track.Rotations.Times);
+      WriteCacheArray(buffer, track.Rotations.Values);
+      WriteCacheVectorTrack(buffer, track.Scales);
+    }
+  }
+  header.FileSize = buffer.size();
+  std::memcpy(buffer.data(), &header, sizeof(AnimationCacheHeader));
+
+  if (!WriteCacheFile(entry.Path, buffer.data(), buffer.size()))
+    return false;
+
+  Yeager::LogDebug(INFO, "Wrote animation cache {} ({} clips, {} bytes)", entry.Path, header.ClipCount, header.FileSize);
+  return true;
+}
+
+/* Reads the values back in the order they were written, every read is checked against the end of the file */
+struct AnimationCacheReader {
+  const unsigned char* Data = YEAGER_NULLPTR;
+  std::size_t Size = 0;
+  std::size_t Offset = 0;
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (Size - Offset < sizeof(T))
+      return false;
+    std::memcpy(&value, Data + Offset, sizeof(T));
+    Offset += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(String& str)
+  {
+    uint32_t length = 0;
+    if (!Read(length) || Size - Offset < length)
+      return false;
+    str.assign(reinterpret_cast<const char*>(Data + Offset), length);
+    Offset += length;
+    return true;
+  }
+
+  template <typename T>
+  bool ReadArray(std::vector<T>& values)
+  {
+    uint32_t count = 0;
+    if (!Read(count) || (Size - Offset) / sizeof(T) < count)
+      return false;
+    values.resize(count);
+    std::memcpy(values.data(), Data + Offset, count * sizeof(T));
+    Offset += count * sizeof(T);
+    return true;
+  }
+};
+
+/* The remaining node count bounds the children of every node, a corrupted count cannot make it allocate past the file */
+static bool ReadCacheNode(AnimationCacheReader& reader, AssimpNodeData& node, uint32_t& remaining)
+{
+  if (remaining == 0)
+    return false;
+  remaining--;
+
+  uint32_t childrenCount = 0;
+  if (!reader.ReadString(node.Name) || !reader.Read(node.Transformation) || !reader.Read(childrenCount) ||
+      childrenCount > remaining)
+    return false;
+
+  node.ChildrenCount = static_cast<int>(childrenCount);
+  node.Children.resize(childrenCount);
+  for (auto& child : node.Children) {
+    if (!ReadCacheNode(reader, child, remaining))
+      return false;
+  }
+  return true;
+}
+
+static bool ReadCacheVectorTrack(AnimationCacheReader& reader, QuantizedVectorTrack& track)
+{
+  return reader.Read(track.Min) && reader.Read(track.Extent) && reader.ReadArray(track.Times) &&
+         reader.ReadArray(track.Values) && track.Values.size() == track.Times.size() * 3;
+}
+
+bool AnimationCache::Load(const AnimationCacheEntry& entry, AnimationCacheData* data)
+{
+  std::error_code error;
+  if (!std::filesystem::exists(entry.Path, error))
+    return false;
+
+  MappedFile mapping;
+  if (!mapping.Open(entry.Path))
+    return false;
+
+  AnimationCacheHeader header;
+  if (mapping.GetSize() < sizeof(AnimationCacheHeader)) {
+    Yeager::Log(WARNING, "Given file {} is not a valid animation cache file!", entry.Path);
+    return false;
+  }
+  std::memcpy(&header, mapping.GetData(), sizeof(AnimationCacheHeader));
+  if (std::memcmp(header.MagicConst, YEAGER_ANIMATION_CACHE_MAGIC_CONST, sizeof(header.MagicConst)) != 0) {
+    Yeager::Log(WARNING, "Given file {} is not a valid animation cache file!", entry.Path);
+    return false;
+  }
+
+  if (header.Version != YEAGER_ANIMATION_CACHE_VERSION || header.Key != entry.Key ||
+      header.FileSize != mapping.GetSize()) {
+    Yeager::LogDebug(INFO, "Animation cache {} is outdated, it will be rewritten", entry.Path);
+    return false;
+  }
+
+  /* Read into a local copy, a corrupted file leaves the data untouched for the assimp fallback */
+  AnimationCacheReader reader;
+  reader.Data = mapping.GetData();
+  reader.Size = mapping.GetSize();
+  reader.Offset = sizeof(AnimationCacheHeader);
+
+  AnimationCacheData cached;
+  uint32_t remaining = header.NodeCount;
+  bool valid = ReadCacheNode(reader, cached.RootNode, remaining) && remaining == 0;
+
+  for (uint32_t x = 0; x < header.ClipCount && valid; x++) {
+    CompressedAnimationClip clip;
+    int32_t ticks = 0;
+    uint32_t trackCount = 0;
+    valid = reader.ReadString(clip.Name) && reader.Read(clip.Duration) && reader.Read(ticks) &&
+            reader.Read(clip.TimeMin) && reader.Read(clip.TimeStep) && reader.Read(trackCount);
+    clip.TicksPerSecond = ticks;
+
+    for (uint32_t y = 0; y < trackCount && valid; y++) {
+      CompressedBoneTrack track;
+      valid = reader.ReadString(track.Name) && ReadCacheVectorTrack(reader, track.Positions) &&
+              reader.ReadArray(track.Rotations.Times) && reader.ReadArray(track.Rotations.Values) &&
+              track.Rotations.Values.size() == track.Rotations.Times.size() &&
+              ReadCacheVectorTrack(reader, track.Scales);
+      clip.Tracks.push_back(std::move(track));
+    }
+    cached.Clips.push_back(std::move(clip));
+  }
+
+  if (!valid || reader.Offset != reader.Size) {
+    Yeager::Log(WARNING, "Animation cache {} is corrupted!", entry.Path);
+    return false;
+  }
+
+  *data = std::move(cached);
+  return true;
+}
@@ -0,0 +1,77 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+#include "Components/Kernel/Caching/CacheFile.h"
+#include "Components/Renderer/AnimationEngine/Animation.h"
+
+namespace Yeager {
+
+#define YEAGER_ANIMATION_CACHE_EXT_STR ".yanim_ch"
+#define YEAGER_ANIMATION_CACHE_MAGIC_CONST "YANM"
+/* Bump when the layout below or the compression change, old files are ignored and rewritten */
+#define YEAGER_ANIMATION_CACHE_VERSION 1
+
+/**
+ * Animation cache file (key).yanim_ch, stored with the mesh caches. Every value is written in order, strings are a
+ * uint32_t length followed by the characters and arrays are a uint32_t count followed by the elements
+ * AnimationCacheHeader
+ * Nodes[NodeCount] - Depth first: name, transformation, children count
+ * Clips[ClipCount] - Name, duration, ticks per second, first key time, time step, track count, then each track: name, positions (min,
+ * extent, times, values), rotations (times, values), scales (min, extent, times, values)
+ */
+struct AnimationCacheHeader {
+  char MagicConst[4] = {0};
+  uint32_t Version = 0;
+  uint64_t Key = 0;
+  uint32_t NodeCount = 0;
+  uint32_t ClipCount = 0;
+  uint64_t FileSize = 0;
+};
+
+struct AnimationCacheEntry {
+  String Path = YEAGER_NULL_LITERAL;
+  uint64_t Key = 0;
+};
+
+/* Everything the animations of a file are built from, the node hierarchy is shared by all the clips */
+struct AnimationCacheData {
+  AssimpNodeData RootNode;
+  std::vector<CompressedAnimationClip> Clips;
+};
+
+/**
+ * @brief Binary cache of the compressed animation clips of a file, the animations are built from it without opening the
+ * source file with assimp again
+ */
+class AnimationCache {
+ public:
+  /** @brief Hashes the contents of the source file together with the compression settings */
+  static std::optional<uint64_t> ComputeKey(const String& sourcePath, const AnimationCompressionSettings& settings);
+  static String BuildCachePath(const String& folder, uint64_t key);
+
+  static bool Write(const AnimationCacheEntry& entry, const AnimationCacheData& data);
+  static bool Load(const AnimationCacheEntry& entry, AnimationCacheData* data);
+};
+
+}  // namespace Yeager
@@ -0,0 +1,51 @@
+#include "CacheFile.h"
+using namespace Yeager;
+
+static YEAGER_CONSTEXPR uint64_t sFNVPrime = 1099511628211ull;
+
+uint64_t Yeager::HashCacheBytes(const unsigned char* data, std::size_t size, uint64_t hash)
+{
+  std::size_t x = 0;
+  for (; x + sizeof(uint64_t) <= size; x += sizeof(uint64_t)) {
+    uint64_t word = 0;
+    std::memcpy(&word, data + x, sizeof(uint64_t));
+    hash ^= word;
+    hash *= sFNVPrime;
+  }
+  for (; x < size; x++) {
+    hash ^= data[x];
+    hash *= sFNVPrime;
+  }
+  return hash;
+}
+
+bool Yeager::WriteCacheFile(const String& path, const unsigned char* data, std::size_t size)
+{
+  std::error_code error;
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+  /* Written to a temporary file and renamed, a crash or another import of the same model never leaves a half file behind */
+  const String temporary = path + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+  {
+    std::ofstream output(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+      Yeager::Log(WARNING, "Cannot open {} to write the cache!", temporary);
+      return false;
+    }
+    output.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!output.good()) {
+      Yeager::Log(WARNING, "Cannot write cache {}!", temporary);
+      output.close();
+      std::filesystem::remove(temporary, error);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    Yeager::Log(WARNING, "Cannot move cache into {}, {}", path, error.message());
+    std::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
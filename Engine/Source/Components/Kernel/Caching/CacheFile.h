@@ -0,0 +1,39 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+#define YEAGER_CACHE_HASH_SEED 14695981039346656037ull
+
+/**
+ * @brief FNV-1a over 8 bytes words, the tail is hashed byte per byte. Used by the caches to key their files from the source
+ * contents and the import options, it only tells files apart and is not a secure hash
+ */
+YEAGER_NODISCARD extern uint64_t HashCacheBytes(const unsigned char* data, std::size_t size,
+                                                uint64_t hash = YEAGER_CACHE_HASH_SEED);
+
+/** @brief Writes the file through a temporary one and a rename, readers never see a partial cache */
+extern bool WriteCacheFile(const String& path, const unsigned char* data, std::size_t size);
+
+}  // namespace Yeager
@@ -0,0 +1,155 @@
+#include "MeshCache.h"
+#include "Common/FS/MappedFile.h"
+using namespace Yeager;
+
+template <typename T>
+static uint64_t HashValue64(const T& value, uint64_t hash)
+{
+  return HashCacheBytes(reinterpret_cast<const unsigned char*>(&value), sizeof(T), hash);
+}
+
+static uint32_t VertexStrideOfKind(MeshCacheKind::Enum kind)
+{
+  return kind == MeshCacheKind::eANIMATED ? sizeof(AnimatedVertexData) : sizeof(ObjectVertexData);
+}
+
+std::optional<uint64_t> MeshCache::ComputeKey(const String& sourcePath, Uint assimpFlags, MeshCacheKind::Enum kind,
+                                              const String& textureFolder)
+{
+  MappedFile source;
+  if (!source.Open(sourcePath))
+    return std::nullopt;
+
+  uint64_t key = HashCacheBytes(source.GetData(), source.GetSize());
+  key = HashValue64(static_cast<uint64_t>(source.GetSize()), key);
+  key = HashValue64(static_cast<uint32_t>(assimpFlags), key);
+  key = HashValue64(static_cast<uint32_t>(kind), key);
+  key = HashValue64(VertexStrideOfKind(kind), key);
+  key = HashCacheBytes(reinterpret_cast<const unsigned char*>(textureFolder.data()), textureFolder.size(), key);
+  return key;
+}
+
+String MeshCache::BuildCachePath(const String& folder, uint64_t key)
+{
+  return folder + YG_PS + fmt::format("{:016x}", key) + YEAGER_MESH_CACHE_EXT_STR;
+}
+
+template <typename ModelData>
+static bool WriteModelCache(const MeshCacheEntry& entry, ModelData& data, MeshCacheKind::Enum kind,
+                            const std::map<String, BoneInfo>* bones, int boneCounter)
+{
+  using VertexType = typename std::decay_t<decltype(data.Meshes[0].Vertices)>::value_type;
+
+  MeshCacheContents contents;
+  contents.Key = entry.Key;
+  contents.Kind = kind;
+  contents.VertexStride = sizeof(VertexType);
+  contents.BoneCounter = boneCounter;
+
+  std::unordered_map<const MaterialTexture2D*, uint32_t> textureIndices;
+  for (auto& loaded : data.TexturesLoaded) {
+    textureIndices[loaded.get()] = static_cast<uint32_t>(contents.Textures.size());
+    contents.Textures.push_back(MeshCacheTextureSource{loaded->GetTextureDataHandle()->Path, loaded->GetName()});
+  }
+
+  for (const auto& mesh : data.Meshes) {
+    MeshCacheMeshSource source;
+    source.Vertices = mesh.GetVertices().data();
+    source.VertexCount = static_cast<uint32_t>(mesh.GetVertices().size());
+    source.Indices = mesh.GetIndices();
+    source.Bounds = mesh.Bounds;
+    for (const auto* texture : mesh.Textures) {
+      const auto it = textureIndices.find(texture);
+      if (it == textureIndices.end()) {
+        Yeager::Log(WARNING, "Mesh texture is not owned by the model, cannot write mesh cache {}", entry.Path);
+        return false;
+      }
+      source.TextureRefs.push_back(it->second);
+    }
+    contents.Meshes.push_back(std::move(source));
+  }
+
+  if (bones) {
+    for (const auto& [name, info] : *bones) {
+      MeshCacheBoneSource bone;
+      bone.Name = name;
+      bone.ID = info.ID;
+      std::memcpy(bone.OffSet, glm::value_ptr(info.OffSet), sizeof(bone.OffSet));
+      contents.Bones.push_back(std::move(bone));
+    }
+  }
+
+  return WriteMeshCacheFile(entry.Path, contents);
+}
+
+bool MeshCache::Write(const MeshCacheEntry& entry, ObjectModelData& data)
+{
+  return WriteModelCache(entry, data, MeshCacheKind::eSTATIC, YEAGER_NULLPTR, 0);
+}
+
+bool MeshCache::Write(const MeshCacheEntry& entry, AnimatedObjectModelData& data)
+{
+  return WriteModelCache(entry, data, MeshCacheKind::eANIMATED, &data.m_BoneInfoMap, data.m_BoneCounter);
+}
+
+template <typename ModelData>
+static bool LoadModelCache(const MeshCacheEntry& entry, ModelData* data, const MeshCacheTextureLoader& loader,
+                           MeshCacheKind::Enum kind)
+{
+  using MeshType = typename decltype(data->Meshes)::value_type;
+  using VertexType = typename std::decay_t<decltype(data->Meshes[0].Vertices)>::value_type;
+
+  /* The file is validated when opened, a bad one leaves the model empty for the assimp fallback */
+  MeshCacheFile file;
+  if (!file.Open(entry.Path, entry.Key, kind, sizeof(VertexType)))
+    return false;
+  const MeshCacheHeader& header = file.GetHeader();
+
+  std::vector<MaterialTexture2D*> textures(header.TextureCount, YEAGER_NULLPTR);
+  for (uint32_t x = 0; x < header.TextureCount; x++) {
+    textures[x] = loader(file.GetTexturePath(x), file.GetTextureType(x));
+  }
+
+  data->Meshes.reserve(header.MeshCount);
+  for (uint32_t x = 0; x < header.MeshCount; x++) {
+    const MeshCacheMeshEntry& cached = file.GetMesh(x);
+    std::vector<MaterialTexture2D*> meshTextures;
+    for (uint32_t y = 0; y < cached.TextureRefCount; y++) {
+      if (MaterialTexture2D* texture = textures[file.GetTextureRef(cached, y)])
+        meshTextures.push_back(texture);
+    }
+
+    MeshType mesh({}, {}, meshTextures);
+    mesh.CacheMapping = file.GetMapping();
+    mesh.CachedVertices = reinterpret_cast<const VertexType*>(file.GetVertices(cached));
+    mesh.CachedVertexCount = cached.VertexCount;
+    mesh.CachedIndices = file.GetIndices(cached);
+    mesh.CachedIndexCount = cached.IndexCount;
+    mesh.Bounds = AABB(Vector3(cached.BoundsMin[0], cached.BoundsMin[1], cached.BoundsMin[2]),
+                       Vector3(cached.BoundsMax[0], cached.BoundsMax[1], cached.BoundsMax[2]));
+    data->Meshes.push_back(std::move(mesh));
+  }
+
+  if constexpr (std::is_same_v<ModelData, AnimatedObjectModelData>) {
+    for (uint32_t x = 0; x < header.BoneCount; x++) {
+      const MeshCacheBoneEntry& bone = file.GetBone(x);
+      BoneInfo info;
+      info.ID = bone.ID;
+      std::memcpy(glm::value_ptr(info.OffSet), bone.OffSet, sizeof(bone.OffSet));
+      data->m_BoneInfoMap[file.GetBoneName(x)] = info;
+    }
+    data->m_BoneCounter = header.BoneCounter;
+  }
+
+  return true;
+}
+
+bool MeshCache::Load(const MeshCacheEntry& entry, ObjectModelData* data, const MeshCacheTextureLoader& loader)
+{
+  return LoadModelCache(entry, data, loader, MeshCacheKind::eSTATIC);
+}
+
+bool MeshCache::Load(const MeshCacheEntry& entry, AnimatedObjectModelData* data, const MeshCacheTextureLoader& loader)
+{
+  return LoadModelCache(entry, data, loader, MeshCacheKind::eANIMATED);
+}
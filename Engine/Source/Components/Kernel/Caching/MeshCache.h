@@ -0,0 +1,60 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+#include "Components/Kernel/Caching/MeshCacheFile.h"
+#include "Components/Renderer/Objects/Object.h"
+
+namespace Yeager {
+
+/* Where a model is cached and the key that must match the file header */
+struct MeshCacheEntry {
+  String Path = YEAGER_NULL_LITERAL;
+  uint64_t Key = 0;
+};
+
+/* Loads a texture referenced by the cache (path, type name) into the model being built, the importer provides it */
+using MeshCacheTextureLoader = std::function<MaterialTexture2D*(const String&, const String&)>;
+
+/**
+ * @brief Binary cache of imported models, skips the assimp parsing when the source file did not change. Loading maps the
+ * file and the meshes point into the mapping, the vertices and indices are uploaded to the GPU straight from it
+ */
+class MeshCache {
+ public:
+  /**
+   * @brief Hashes the contents of the source file together with the import options (assimp flags, model kind, texture folder),
+   * any change in one of them gives a different key and so a different cache file
+   */
+  static std::optional<uint64_t> ComputeKey(const String& sourcePath, Uint assimpFlags, MeshCacheKind::Enum kind,
+                                            const String& textureFolder);
+  static String BuildCachePath(const String& folder, uint64_t key);
+
+  static bool Write(const MeshCacheEntry& entry, ObjectModelData& data);
+  static bool Write(const MeshCacheEntry& entry, AnimatedObjectModelData& data);
+
+  static bool Load(const MeshCacheEntry& entry, ObjectModelData* data, const MeshCacheTextureLoader& loader);
+  static bool Load(const MeshCacheEntry& entry, AnimatedObjectModelData* data, const MeshCacheTextureLoader& loader);
+};
+
+}  // namespace Yeager
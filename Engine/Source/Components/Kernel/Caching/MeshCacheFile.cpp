@@ -0,0 +1,237 @@
+#include "MeshCacheFile.h"
+#include "Components/Kernel/Memory/Allocator.h"
+using namespace Yeager;
+
+static YEAGER_CONSTEXPR uint64_t AlignCacheOffset(uint64_t offset)
+{
+  return (offset + YEAGER_MESH_CACHE_ALIGNMENT - 1) & ~uint64_t(YEAGER_MESH_CACHE_ALIGNMENT - 1);
+}
+
+/* Appends the string to the blob and returns its offset inside of it */
+static uint32_t PushCacheString(String& strings, const String& str)
+{
+  const uint32_t offset = static_cast<uint32_t>(strings.size());
+  strings += str;
+  return offset;
+}
+
+bool Yeager::WriteMeshCacheFile(const String& path, const MeshCacheContents& contents)
+{
+  String strings;
+  std::vector<MeshCacheTextureEntry> textureTable;
+  for (const MeshCacheTextureSource& source : contents.Textures) {
+    MeshCacheTextureEntry texture;
+    texture.PathOffset = PushCacheString(strings, source.Path);
+    texture.PathLength = static_cast<uint32_t>(source.Path.size());
+    texture.TypeOffset = PushCacheString(strings, source.Type);
+    texture.TypeLength = static_cast<uint32_t>(source.Type.size());
+    textureTable.push_back(texture);
+  }
+
+  std::vector<uint32_t> textureRefs;
+  std::vector<MeshCacheMeshEntry> meshTable;
+  for (const MeshCacheMeshSource& source : contents.Meshes) {
+    MeshCacheMeshEntry mesh;
+    mesh.VertexCount = source.VertexCount;
+    mesh.IndexCount = static_cast<uint32_t>(source.Indices.size());
+    mesh.FirstTextureRef = static_cast<uint32_t>(textureRefs.size());
+    mesh.TextureRefCount = static_cast<uint32_t>(source.TextureRefs.size());
+    for (Uint x = 0; x < 3; x++) {
+      mesh.BoundsMin[x] = source.Bounds.Min[x];
+      mesh.BoundsMax[x] = source.Bounds.Max[x];
+    }
+    for (uint32_t ref : source.TextureRefs) {
+      if (ref >= textureTable.size()) {
+        Yeager::Log(WARNING, "Mesh references a texture outside of the model, cannot write mesh cache {}", path);
+        return false;
+      }
+      textureRefs.push_back(ref);
+    }
+    meshTable.push_back(mesh);
+  }
+
+  std::vector<MeshCacheBoneEntry> boneTable;
+  for (const MeshCacheBoneSource& source : contents.Bones) {
+    MeshCacheBoneEntry bone;
+    bone.NameOffset = PushCacheString(strings, source.Name);
+    bone.NameLength = static_cast<uint32_t>(source.Name.size());
+    bone.ID = source.ID;
+    std::memcpy(bone.OffSet, source.OffSet, sizeof(bone.OffSet));
+    boneTable.push_back(bone);
+  }
+
+  MeshCacheHeader header;
+  std::memcpy(header.MagicConst, YEAGER_MESH_CACHE_MAGIC_CONST, sizeof(header.MagicConst));
+  header.Version = YEAGER_MESH_CACHE_VERSION;
+  header.Key = contents.Key;
+  header.Kind = static_cast<uint32_t>(contents.Kind);
+  header.VertexStride = contents.VertexStride;
+  header.MeshCount = static_cast<uint32_t>(meshTable.size());
+  header.TextureCount = static_cast<uint32_t>(textureTable.size());
+  header.TextureRefCount = static_cast<uint32_t>(textureRefs.size());
+  header.BoneCount = static_cast<uint32_t>(boneTable.size());
+  header.BoneCounter = contents.BoneCounter;
+
+  uint64_t offset = AlignCacheOffset(sizeof(MeshCacheHeader));
+  header.MeshTableOffset = offset;
+  offset = AlignCacheOffset(offset + meshTable.size() * sizeof(MeshCacheMeshEntry));
+  header.TextureTableOffset = offset;
+  offset = AlignCacheOffset(offset + textureTable.size() * sizeof(MeshCacheTextureEntry));
+  header.TextureRefOffset = offset;
+  offset = AlignCacheOffset(offset + textureRefs.size() * sizeof(uint32_t));
+  header.BoneTableOffset = offset;
+  offset = AlignCacheOffset(offset + boneTable.size() * sizeof(MeshCacheBoneEntry));
+  header.StringsOffset = offset;
+  offset = AlignCacheOffset(offset + strings.size());
+  for (auto& mesh : meshTable) {
+    mesh.VertexOffset = offset;
+    offset = AlignCacheOffset(offset + uint64_t(mesh.VertexCount) * contents.VertexStride);
+    mesh.IndexOffset = offset;
+    offset = AlignCacheOffset(offset + uint64_t(mesh.IndexCount) * sizeof(GLuint));
+  }
+  header.FileSize = offset;
+
+  std::vector<unsigned char> buffer(header.FileSize, 0);
+  auto copy = [&buffer](uint64_t at, const void* src, std::size_t size) {
+    if (size > 0)
+      std::memcpy(buffer.data() + at, src, size);
+  };
+  copy(0, &header, sizeof(MeshCacheHeader));
+  copy(header.MeshTableOffset, meshTable.data(), meshTable.size() * sizeof(MeshCacheMeshEntry));
+  copy(header.TextureTableOffset, textureTable.data(), textureTable.size() * sizeof(MeshCacheTextureEntry));
+  copy(header.TextureRefOffset, textureRefs.data(), textureRefs.size() * sizeof(uint32_t));
+  copy(header.BoneTableOffset, boneTable.data(), boneTable.size() * sizeof(MeshCacheBoneEntry));
+  copy(header.StringsOffset, strings.data(), strings.size());
+  for (Uint x = 0; x < meshTable.size(); x++) {
+    const MeshCacheMeshSource& source = contents.Meshes[x];
+    copy(meshTable[x].VertexOffset, source.Vertices, std::size_t(source.VertexCount) * contents.VertexStride);
+    copy(meshTable[x].IndexOffset, source.Indices.data(), source.Indices.size_bytes());
+  }
+
+  if (!WriteCacheFile(path, buffer.data(), buffer.size()))
+    return false;
+
+  Yeager::LogDebug(INFO, "Wrote mesh cache {} ({} meshes, {} bytes)", path, header.MeshCount, header.FileSize);
+  return true;
+}
+
+/* True when [offset, offset + size) lies inside the file */
+static bool CacheRangeIsValid(const MeshCacheHeader* header, uint64_t offset, uint64_t size)
+{
+  return offset <= header->FileSize && size <= header->FileSize - offset;
+}
+
+bool MeshCacheFile::Open(const String& path, uint64_t key, MeshCacheKind::Enum kind, uint32_t vertexStride)
+{
+  mMapping = YEAGER_NULLPTR;
+  mHeader = YEAGER_NULLPTR;
+
+  std::error_code error;
+  if (!std::filesystem::exists(path, error))
+    return false;
+
+  mMapping = BaseAllocator::MakeSharedPtr<MappedFile>();
+  if (!mMapping->Open(path) || !Validate(key, kind, vertexStride)) {
+    mMapping = YEAGER_NULLPTR;
+    mHeader = YEAGER_NULLPTR;
+    return false;
+  }
+  return true;
+}
+
+bool MeshCacheFile::Validate(uint64_t key, MeshCacheKind::Enum kind, uint32_t vertexStride)
+{
+  const String& path = mMapping->GetPath();
+  const unsigned char* file = mMapping->GetData();
+  mHeader = reinterpret_cast<const MeshCacheHeader*>(file);
+  if (mMapping->GetSize() < sizeof(MeshCacheHeader) ||
+      std::memcmp(mHeader->MagicConst, YEAGER_MESH_CACHE_MAGIC_CONST, sizeof(mHeader->MagicConst)) != 0) {
+    Yeager::Log(WARNING, "Given file {} is not a valid mesh cache file!", path);
+    return false;
+  }
+
+  if (mHeader->Version != YEAGER_MESH_CACHE_VERSION || mHeader->Key != key ||
+      mHeader->Kind != static_cast<uint32_t>(kind) || mHeader->VertexStride != vertexStride ||
+      mHeader->FileSize != mMapping->GetSize()) {
+    Yeager::LogDebug(INFO, "Mesh cache {} is outdated, it will be rewritten", path);
+    return false;
+  }
+
+  if (!CacheRangeIsValid(mHeader, mHeader->MeshTableOffset,
+                         uint64_t(mHeader->MeshCount) * sizeof(MeshCacheMeshEntry)) ||
+      !CacheRangeIsValid(mHeader, mHeader->TextureTableOffset,
+                         uint64_t(mHeader->TextureCount) * sizeof(MeshCacheTextureEntry)) ||
+      !CacheRangeIsValid(mHeader, mHeader->TextureRefOffset, uint64_t(mHeader->TextureRefCount) * sizeof(uint32_t)) ||
+      !CacheRangeIsValid(mHeader, mHeader->BoneTableOffset,
+                         uint64_t(mHeader->BoneCount) * sizeof(MeshCacheBoneEntry)) ||
+      mHeader->StringsOffset > mHeader->FileSize) {
+    Yeager::Log(WARNING, "Mesh cache {} have tables outside of the file!", path);
+    return false;
+  }
+
+  mMeshTable = reinterpret_cast<const MeshCacheMeshEntry*>(file + mHeader->MeshTableOffset);
+  mTextureTable = reinterpret_cast<const MeshCacheTextureEntry*>(file + mHeader->TextureTableOffset);
+  mTextureRefs = reinterpret_cast<const uint32_t*>(file + mHeader->TextureRefOffset);
+  mBoneTable = reinterpret_cast<const MeshCacheBoneEntry*>(file + mHeader->BoneTableOffset);
+  mStrings = reinterpret_cast<const char*>(file + mHeader->StringsOffset);
+  const uint64_t stringsSize = mHeader->FileSize - mHeader->StringsOffset;
+
+  auto stringIsValid = [stringsSize](uint32_t offset, uint32_t length) {
+    return uint64_t(offset) + length <= stringsSize;
+  };
+
+  for (uint32_t x = 0; x < mHeader->MeshCount; x++) {
+    const MeshCacheMeshEntry& mesh = mMeshTable[x];
+    if (!CacheRangeIsValid(mHeader, mesh.VertexOffset, uint64_t(mesh.VertexCount) * vertexStride) ||
+        !CacheRangeIsValid(mHeader, mesh.IndexOffset, uint64_t(mesh.IndexCount) * sizeof(GLuint)) ||
+        mesh.VertexOffset % YEAGER_MESH_CACHE_ALIGNMENT != 0 || mesh.IndexOffset % YEAGER_MESH_CACHE_ALIGNMENT != 0 ||
+        uint64_t(mesh.FirstTextureRef) + mesh.TextureRefCount > mHeader->TextureRefCount) {
+      Yeager::Log(WARNING, "Mesh cache {} have a corrupted mesh entry {}", path, x);
+      return false;
+    }
+    /* The indices are drawn straight from the mapping, one past the vertices would read outside of the mesh */
+    const GLuint* indices = reinterpret_cast<const GLuint*>(file + mesh.IndexOffset);
+    for (uint32_t y = 0; y < mesh.IndexCount; y++) {
+      if (indices[y] >= mesh.VertexCount) {
+        Yeager::Log(WARNING, "Mesh cache {} mesh {} have index {} outside of its {} vertices", path, x, indices[y],
+                    mesh.VertexCount);
+        return false;
+      }
+    }
+  }
+  for (uint32_t x = 0; x < mHeader->TextureRefCount; x++) {
+    if (mTextureRefs[x] >= mHeader->TextureCount) {
+      Yeager::Log(WARNING, "Mesh cache {} references a texture outside of the table", path);
+      return false;
+    }
+  }
+  for (uint32_t x = 0; x < mHeader->TextureCount; x++) {
+    if (!stringIsValid(mTextureTable[x].PathOffset, mTextureTable[x].PathLength) ||
+        !stringIsValid(mTextureTable[x].TypeOffset, mTextureTable[x].TypeLength)) {
+      Yeager::Log(WARNING, "Mesh cache {} have a corrupted texture entry", path);
+      return false;
+    }
+  }
+  for (uint32_t x = 0; x < mHeader->BoneCount; x++) {
+    if (!stringIsValid(mBoneTable[x].NameOffset, mBoneTable[x].NameLength)) {
+      Yeager::Log(WARNING, "Mesh cache {} have a corrupted bone entry", path);
+      return false;
+    }
+  }
+  return true;
+}
+
+String MeshCacheFile::GetTexturePath(uint32_t texture) const
+{
+  return String(mStrings + mTextureTable[texture].PathOffset, mTextureTable[texture].PathLength);
+}
+
+String MeshCacheFile::GetTextureType(uint32_t texture) const
+{
+  return String(mStrings + mTextureTable[texture].TypeOffset, mTextureTable[texture].TypeLength);
+}
+
+String MeshCacheFile::GetBoneName(uint32_t index) const
+{
+  return String(mStrings + mBoneTable[index].NameOffset, mBoneTable[index].NameLength);
+}
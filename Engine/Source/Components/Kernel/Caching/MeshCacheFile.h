@@ -0,0 +1,178 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "Common/FS/MappedFile.h"
+#include "Common/Math/BoundingVolumes.h"
+#include "Components/Kernel/Caching/CacheFile.h"
+
+#include <span>
+
+namespace Yeager {
+
+#define YEAGER_MESH_CACHE_EXT_STR ".yobj_ch"
+#define YEAGER_MESH_CACHE_MAGIC_CONST "YMSH"
+/* Bump when the layout below, the vertex structs or the import processing change, old files are ignored and rewritten */
+#define YEAGER_MESH_CACHE_VERSION 2
+#define YEAGER_MESH_CACHE_ALIGNMENT 16
+
+struct MeshCacheKind {
+  enum Enum { eSTATIC, eANIMATED };
+};
+
+/**
+ * Mesh cache file (key).yobj_ch, every table and blob starts at a 16 bytes aligned offset
+ * MeshCacheHeader
+ * MeshCacheMeshEntry[MeshCount]
+ * MeshCacheTextureEntry[TextureCount] - Every texture loaded by the model
+ * uint32_t[TextureRefCount] - Index into the texture table of each mesh texture, in the order of the meshes
+ * MeshCacheBoneEntry[BoneCount] - Only for animated models
+ * Strings - Texture paths, texture types and bone names, not null terminated
+ * Blobs - Vertices (ObjectVertexData or AnimatedVertexData) followed by the indices (GLuint) of each mesh
+ */
+struct MeshCacheHeader {
+  char MagicConst[4] = {0};
+  uint32_t Version = 0;
+  uint64_t Key = 0;
+  uint32_t Kind = 0;
+  uint32_t VertexStride = 0;
+  uint32_t MeshCount = 0;
+  uint32_t TextureCount = 0;
+  uint32_t TextureRefCount = 0;
+  uint32_t BoneCount = 0;
+  int32_t BoneCounter = 0;
+  uint32_t Reserved = 0;
+  uint64_t MeshTableOffset = 0;
+  uint64_t TextureTableOffset = 0;
+  uint64_t TextureRefOffset = 0;
+  uint64_t BoneTableOffset = 0;
+  uint64_t StringsOffset = 0;
+  uint64_t FileSize = 0;
+};
+
+struct MeshCacheMeshEntry {
+  uint64_t VertexOffset = 0;
+  uint64_t IndexOffset = 0;
+  uint32_t VertexCount = 0;
+  uint32_t IndexCount = 0;
+  uint32_t FirstTextureRef = 0;
+  uint32_t TextureRefCount = 0;
+  float BoundsMin[3] = {0.0f};
+  float BoundsMax[3] = {0.0f};
+};
+
+struct MeshCacheTextureEntry {
+  uint32_t PathOffset = 0;
+  uint32_t PathLength = 0;
+  uint32_t TypeOffset = 0;
+  uint32_t TypeLength = 0;
+};
+
+struct MeshCacheBoneEntry {
+  uint32_t NameOffset = 0;
+  uint32_t NameLength = 0;
+  int32_t ID = -1;
+  uint32_t Reserved = 0;
+  float OffSet[16] = {0.0f};
+};
+
+/* A mesh to write, Vertices holds VertexCount vertices of MeshCacheContents::VertexStride bytes */
+struct MeshCacheMeshSource {
+  const void* Vertices = YEAGER_NULLPTR;
+  uint32_t VertexCount = 0;
+  std::span<const GLuint> Indices;
+  /* Index into MeshCacheContents::Textures of each texture of the mesh */
+  std::vector<uint32_t> TextureRefs;
+  AABB Bounds;
+};
+
+struct MeshCacheTextureSource {
+  String Path = YEAGER_NULL_LITERAL;
+  String Type = YEAGER_NULL_LITERAL;
+};
+
+struct MeshCacheBoneSource {
+  String Name = YEAGER_NULL_LITERAL;
+  int32_t ID = -1;
+  float OffSet[16] = {0.0f};
+};
+
+/* Everything written to a mesh cache file, filled from the model data by the MeshCache */
+struct MeshCacheContents {
+  uint64_t Key = 0;
+  MeshCacheKind::Enum Kind = MeshCacheKind::eSTATIC;
+  uint32_t VertexStride = 0;
+  int32_t BoneCounter = 0;
+  std::vector<MeshCacheMeshSource> Meshes;
+  std::vector<MeshCacheTextureSource> Textures;
+  std::vector<MeshCacheBoneSource> Bones;
+};
+
+/** @brief Lays out the contents as described above and writes them with WriteCacheFile */
+extern bool WriteMeshCacheFile(const String& path, const MeshCacheContents& contents);
+
+/**
+ * @brief Mapped mesh cache file, every table, string and blob is checked against the file size when it is opened so the
+ * getters never read outside of the mapping. The mapping is shared with the meshes that keep pointing into it
+ */
+class MeshCacheFile {
+ public:
+  /**
+   * @brief Maps and validates the file, false when it is missing, corrupted, truncated or was written for another key,
+   * kind, vertex stride or version of the format
+   */
+  bool Open(const String& path, uint64_t key, MeshCacheKind::Enum kind, uint32_t vertexStride);
+
+  YEAGER_NODISCARD const MeshCacheHeader& GetHeader() const { return *mHeader; }
+  YEAGER_NODISCARD const MeshCacheMeshEntry& GetMesh(uint32_t index) const { return mMeshTable[index]; }
+  YEAGER_NODISCARD const unsigned char* GetVertices(const MeshCacheMeshEntry& mesh) const
+  {
+    return mMapping->GetData() + mesh.VertexOffset;
+  }
+  YEAGER_NODISCARD const GLuint* GetIndices(const MeshCacheMeshEntry& mesh) const
+  {
+    return reinterpret_cast<const GLuint*>(mMapping->GetData() + mesh.IndexOffset);
+  }
+  YEAGER_NODISCARD uint32_t GetTextureRef(const MeshCacheMeshEntry& mesh, uint32_t index) const
+  {
+    return mTextureRefs[mesh.FirstTextureRef + index];
+  }
+  YEAGER_NODISCARD String GetTexturePath(uint32_t texture) const;
+  YEAGER_NODISCARD String GetTextureType(uint32_t texture) const;
+  YEAGER_NODISCARD const MeshCacheBoneEntry& GetBone(uint32_t index) const { return mBoneTable[index]; }
+  YEAGER_NODISCARD String GetBoneName(uint32_t index) const;
+  YEAGER_NODISCARD const std::shared_ptr<MappedFile>& GetMapping() const { return mMapping; }
+
+ private:
+  bool Validate(uint64_t key, MeshCacheKind::Enum kind, uint32_t vertexStride);
+
+  std::shared_ptr<MappedFile> mMapping = YEAGER_NULLPTR;
+  const MeshCacheHeader* mHeader = YEAGER_NULLPTR;
+  const MeshCacheMeshEntry* mMeshTable = YEAGER_NULLPTR;
+  const MeshCacheTextureEntry* mTextureTable = YEAGER_NULLPTR;
+  const uint32_t* mTextureRefs = YEAGER_NULLPTR;
+  const MeshCacheBoneEntry* mBoneTable = YEAGER_NULLPTR;
+  const char* mStrings = YEAGER_NULLPTR;
+};
+
+}  // namespace Yeager
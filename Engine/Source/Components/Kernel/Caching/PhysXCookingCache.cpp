@@ -0,0 +1,112 @@
+#include "PhysXCookingCache.h"
+using namespace Yeager;
+using namespace physx;
+
+template <typename T>
+static uint64_t HashValue64(const T& value, uint64_t hash)
+{
+  return HashCacheBytes(reinterpret_cast<const unsigned char*>(&value), sizeof(T), hash);
+}
+
+/**
+ * Only the first elementSize bytes of each element are hashed, the stride may step over other vertex attributes.
+ * Strided elements are packed in chunks of a multiple of 8 bytes, so the key is the same as the one of the packed array
+ */
+static uint64_t HashBoundedData(const PxBoundedData& data, std::size_t elementSize, uint64_t hash)
+{
+  static YEAGER_CONSTEXPR std::size_t sChunkElements = 256;
+  hash = HashValue64(static_cast<uint32_t>(data.count), hash);
+  const auto* bytes = static_cast<const unsigned char*>(data.data);
+  if (bytes == YEAGER_NULLPTR)
+    return hash;
+  if (data.stride == elementSize)
+    return HashCacheBytes(bytes, std::size_t(data.count) * elementSize, hash);
+
+  std::vector<unsigned char> chunk(sChunkElements * elementSize);
+  for (std::size_t first = 0; first < data.count; first += sChunkElements) {
+    const std::size_t count = std::min<std::size_t>(sChunkElements, data.count - first);
+    for (std::size_t x = 0; x < count; x++) {
+      std::memcpy(chunk.data() + x * elementSize, bytes + (first + x) * data.stride, elementSize);
+    }
+    hash = HashCacheBytes(chunk.data(), count * elementSize, hash);
+  }
+  return hash;
+}
+
+/* Every param that changes the cooked output, the struct itself is not hashed since its padding is undefined */
+static uint64_t HashCookingParams(const PxCookingParams& params, PhysXCookedKind::Enum kind)
+{
+  uint64_t hash = HashValue64(static_cast<uint32_t>(kind), YEAGER_CACHE_HASH_SEED);
+  hash = HashValue64(static_cast<uint32_t>(PX_PHYSICS_VERSION), hash);
+  hash = HashValue64(params.scale.length, hash);
+  hash = HashValue64(params.scale.speed, hash);
+  hash = HashValue64(static_cast<uint32_t>(params.meshPreprocessParams), hash);
+  hash = HashValue64(params.meshWeldTolerance, hash);
+  hash = HashValue64(params.meshAreaMinLimit, hash);
+  hash = HashValue64(params.areaTestEpsilon, hash);
+  hash = HashValue64(params.planeTolerance, hash);
+  hash = HashValue64(static_cast<uint32_t>(params.convexMeshCookingType), hash);
+  hash = HashValue64(static_cast<uint32_t>(params.midphaseDesc.getType()), hash);
+  hash = HashValue64(params.gaussMapLimit, hash);
+  const unsigned char options = (params.suppressTriangleMeshRemapTable ? 1 : 0) |
+                                (params.buildTriangleAdjacencies ? 2 : 0) | (params.buildGPUData ? 4 : 0);
+  return HashValue64(options, hash);
+}
+
+uint64_t PhysXCookingCache::ComputeKey(const PxTriangleMeshDesc& desc, const PxCookingParams& params)
+{
+  uint64_t key = HashCookingParams(params, PhysXCookedKind::eTRIANGLE_MESH);
+  key = HashValue64(static_cast<uint32_t>(desc.flags), key);
+  key = HashBoundedData(desc.points, sizeof(PxVec3), key);
+  const std::size_t indexSize = (desc.flags & PxMeshFlag::e16_BIT_INDICES) ? sizeof(PxU16) : sizeof(PxU32);
+  return HashBoundedData(desc.triangles, 3 * indexSize, key);
+}
+
+uint64_t PhysXCookingCache::ComputeKey(const PxConvexMeshDesc& desc, const PxCookingParams& params)
+{
+  uint64_t key = HashCookingParams(params, PhysXCookedKind::eCONVEX_MESH);
+  key = HashValue64(static_cast<uint32_t>(desc.flags), key);
+  key = HashValue64(desc.vertexLimit, key);
+  key = HashValue64(desc.polygonLimit, key);
+  key = HashValue64(desc.quantizedCount, key);
+  return HashBoundedData(desc.points, sizeof(PxVec3), key);
+}
+
+String PhysXCookingCache::BuildCachePath(const String& folder, uint64_t key)
+{
+  return folder + YG_PS + fmt::format("{:016x}", key) + YEAGER_PHYSX_CACHE_EXT_STR;
+}
+
+bool PhysXCookingCache::Write(const String& cachePath, uint64_t key, PhysXCookedKind::Enum kind,
+                              const PxDefaultMemoryOutputStream& cooked)
+{
+  return WritePhysXCookingCacheFile(cachePath, key, kind, PX_PHYSICS_VERSION, cooked.getData(), cooked.getSize());
+}
+
+/* Maps the cache file and hands the cooked data to the creation function, the mesh copies it and the file is closed */
+template <typename Mesh, typename CreateFun>
+static Mesh* LoadCookedMesh(const String& cachePath, uint64_t key, PhysXCookedKind::Enum kind, CreateFun&& create)
+{
+  PhysXCookingCacheFile file;
+  if (!file.Open(cachePath, key, kind, PX_PHYSICS_VERSION))
+    return YEAGER_NULLPTR;
+
+  /* The input stream only reads, the mapping is never written through it */
+  PxDefaultMemoryInputData input(const_cast<PxU8*>(file.GetData()), static_cast<PxU32>(file.GetDataSize()));
+  Mesh* mesh = create(input);
+  if (mesh == YEAGER_NULLPTR)
+    Yeager::Log(WARNING, "PhysX cannot create the mesh from the cooking cache {}!", cachePath);
+  return mesh;
+}
+
+PxTriangleMesh* PhysXCookingCache::LoadTriangleMesh(const String& cachePath, uint64_t key, PxPhysics& physics)
+{
+  return LoadCookedMesh<PxTriangleMesh>(cachePath, key, PhysXCookedKind::eTRIANGLE_MESH,
+                                        [&physics](PxInputStream& input) { return physics.createTriangleMesh(input); });
+}
+
+PxConvexMesh* PhysXCookingCache::LoadConvexMesh(const String& cachePath, uint64_t key, PxPhysics& physics)
+{
+  return LoadCookedMesh<PxConvexMesh>(cachePath, key, PhysXCookedKind::eCONVEX_MESH,
+                                      [&physics](PxInputStream& input) { return physics.createConvexMesh(input); });
+}
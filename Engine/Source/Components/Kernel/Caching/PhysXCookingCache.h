@@ -0,0 +1,47 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+#include "Components/Kernel/Caching/PhysXCookingCacheFile.h"
+#include "Components/Physics/PhysxAllocator.h"
+
+namespace Yeager {
+
+/**
+ * @brief Content addressed cache of cooked PhysX meshes. The key hashes the points, the triangles and the cooking
+ * params, so the same geometry imported from another file or model reuses the cooked data and skips the cooking
+ */
+class PhysXCookingCache {
+ public:
+  static uint64_t ComputeKey(const physx::PxTriangleMeshDesc& desc, const physx::PxCookingParams& params);
+  static uint64_t ComputeKey(const physx::PxConvexMeshDesc& desc, const physx::PxCookingParams& params);
+  static String BuildCachePath(const String& folder, uint64_t key);
+
+  static bool Write(const String& cachePath, uint64_t key, PhysXCookedKind::Enum kind,
+                    const physx::PxDefaultMemoryOutputStream& cooked);
+  /** @brief Creates the mesh from the cached cooked data, returns null when there is no valid cache for the key */
+  static physx::PxTriangleMesh* LoadTriangleMesh(const String& cachePath, uint64_t key, physx::PxPhysics& physics);
+  static physx::PxConvexMesh* LoadConvexMesh(const String& cachePath, uint64_t key, physx::PxPhysics& physics);
+};
+
+}  // namespace Yeager
@@ -0,0 +1,72 @@
+#include "PhysXCookingCacheFile.h"
+using namespace Yeager;
+
+bool Yeager::WritePhysXCookingCacheFile(const String& path, uint64_t key, PhysXCookedKind::Enum kind,
+                                        uint32_t physicsVersion, const unsigned char* data, std::size_t size)
+{
+  PhysXCookingCacheHeader header;
+  std::memcpy(header.MagicConst, YEAGER_PHYSX_CACHE_MAGIC_CONST, sizeof(header.MagicConst));
+  header.Version = YEAGER_PHYSX_CACHE_VERSION;
+  header.Key = key;
+  header.Kind = static_cast<uint32_t>(kind);
+  header.PhysicsVersion = physicsVersion;
+  header.DataSize = size;
+  header.FileSize = sizeof(PhysXCookingCacheHeader) + header.DataSize;
+
+  std::vector<unsigned char> buffer(header.FileSize);
+  std::memcpy(buffer.data(), &header, sizeof(PhysXCookingCacheHeader));
+  if (size > 0)
+    std::memcpy(buffer.data() + sizeof(PhysXCookingCacheHeader), data, size);
+  if (!WriteCacheFile(path, buffer.data(), buffer.size()))
+    return false;
+
+  Yeager::LogDebug(INFO, "Wrote PhysX cooking cache {} ({} bytes)", path, header.FileSize);
+  return true;
+}
+
+bool PhysXCookingCacheFile::Open(const String& path, uint64_t key, PhysXCookedKind::Enum kind, uint32_t physicsVersion)
+{
+  mMapping.Close();
+  mDataSize = 0;
+
+  std::error_code error;
+  if (!std::filesystem::exists(path, error))
+    return false;
+
+  if (!mMapping.Open(path) || !Validate(key, kind, physicsVersion)) {
+    mMapping.Close();
+    mDataSize = 0;
+    return false;
+  }
+  return true;
+}
+
+bool PhysXCookingCacheFile::Validate(uint64_t key, PhysXCookedKind::Enum kind, uint32_t physicsVersion)
+{
+  const String& path = mMapping.GetPath();
+  PhysXCookingCacheHeader header;
+  if (mMapping.GetSize() < sizeof(PhysXCookingCacheHeader)) {
+    Yeager::Log(WARNING, "Given file {} is not a valid PhysX cooking cache file!", path);
+    return false;
+  }
+  std::memcpy(&header, mMapping.GetData(), sizeof(PhysXCookingCacheHeader));
+  if (std::memcmp(header.MagicConst, YEAGER_PHYSX_CACHE_MAGIC_CONST, sizeof(header.MagicConst)) != 0) {
+    Yeager::Log(WARNING, "Given file {} is not a valid PhysX cooking cache file!", path);
+    return false;
+  }
+
+  if (header.Version != YEAGER_PHYSX_CACHE_VERSION || header.PhysicsVersion != physicsVersion || header.Key != key ||
+      header.Kind != static_cast<uint32_t>(kind)) {
+    Yeager::LogDebug(INFO, "PhysX cooking cache {} is outdated, it will be rewritten", path);
+    return false;
+  }
+
+  if (header.FileSize != mMapping.GetSize() || header.DataSize != header.FileSize - sizeof(PhysXCookingCacheHeader) ||
+      header.DataSize == 0 || header.DataSize > std::numeric_limits<uint32_t>::max()) {
+    Yeager::Log(WARNING, "PhysX cooking cache {} has a corrupted header!", path);
+    return false;
+  }
+
+  mDataSize = static_cast<std::size_t>(header.DataSize);
+  return true;
+}
@@ -0,0 +1,82 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "Common/FS/MappedFile.h"
+#include "Components/Kernel/Caching/CacheFile.h"
+
+namespace Yeager {
+
+#define YEAGER_PHYSX_CACHE_EXT_STR ".ypx_ch"
+#define YEAGER_PHYSX_CACHE_MAGIC_CONST "YGPX"
+/* Bump when the layout below changes, the cooked data itself is keyed by the PhysX version */
+#define YEAGER_PHYSX_CACHE_VERSION 1
+
+struct PhysXCookedKind {
+  enum Enum { eTRIANGLE_MESH = 0, eCONVEX_MESH = 1 };
+};
+
+/**
+ * PhysX cooking cache file (key).ypx_ch, stored with the mesh caches
+ * PhysXCookingCacheHeader
+ * Cooked data[DataSize] - The stream written by PxCookTriangleMesh or PxCookConvexMesh
+ */
+struct PhysXCookingCacheHeader {
+  char MagicConst[4] = {0};
+  uint32_t Version = 0;
+  uint64_t Key = 0;
+  uint32_t Kind = 0;
+  /* PX_PHYSICS_VERSION of the SDK that cooked the data, its format is not kept between releases */
+  uint32_t PhysicsVersion = 0;
+  uint64_t DataSize = 0;
+  uint64_t FileSize = 0;
+};
+
+/** @brief Writes the cooked data behind its header with WriteCacheFile, physicsVersion is the PX_PHYSICS_VERSION */
+extern bool WritePhysXCookingCacheFile(const String& path, uint64_t key, PhysXCookedKind::Enum kind,
+                                       uint32_t physicsVersion, const unsigned char* data, std::size_t size);
+
+/**
+ * @brief Mapped cooking cache file, the header is checked when it is opened. Nothing here needs PhysX, the cooked data
+ * is handed to it by the PhysXCookingCache
+ */
+class PhysXCookingCacheFile {
+ public:
+  /**
+   * @brief Maps and validates the file, false when it is missing, corrupted, truncated or was written for another key,
+   * kind, PhysX version or version of the format
+   */
+  bool Open(const String& path, uint64_t key, PhysXCookedKind::Enum kind, uint32_t physicsVersion);
+
+  YEAGER_NODISCARD const unsigned char* GetData() const { return mMapping.GetData() + sizeof(PhysXCookingCacheHeader); }
+  /** @brief Never above 32 bits, PhysX reads the cooked data through a stream of 32 bits size */
+  YEAGER_NODISCARD std::size_t GetDataSize() const { return mDataSize; }
+
+ private:
+  bool Validate(uint64_t key, PhysXCookedKind::Enum kind, uint32_t physicsVersion);
+
+  MappedFile mMapping;
+  std::size_t mDataSize = 0;
+};
+
+}  // namespace Yeager
@@ -1,152 +1,226 @@
 #include "TextureCache.h"
-#include "Common/FS/FileUtils.h"
-#include "Main/Core/Application.h"
+#include "Common/FS/MappedFile.h"
+#include "Components/Kernel/Caching/CacheFile.h"
 using namespace Yeager;
 
-size_t Yeager::CreateFileHash(const String& name)
+static YEAGER_CONSTEXPR uint64_t AlignTextureCacheOffset(uint64_t offset)
 {
-  std::hash<String> hasher;
-  return hasher(name);
+  return (offset + YEAGER_TEXTURE_CACHE_ALIGNMENT - 1) & ~uint64_t(YEAGER_TEXTURE_CACHE_ALIGNMENT - 1);
 }
-TextureCache::TextureCache(Yeager::ApplicationCore* application) : m_Application(application) {}
 
-std::optional<TextureCacheHeader*> TextureCache::GetDataHeader()
+/* Same mapping the material textures use, images with two channels (grey and alpha) keep their alpha */
+static uint32_t SourceFormatOfChannels(Uint channels)
 {
-  if (!m_Allocated) {
-    Yeager::LogDebug(WARNING, "Trying to get texture header with unallocated data!");
-    return std::nullopt;
+  switch (channels) {
+    case 1:
+      return GL_RED;
+    case 3:
+      return GL_RGB;
+    default:
+      return GL_RGBA;
   }
-  return reinterpret_cast<TextureCacheHeader*>(m_CurrentData);
 }
 
-void TextureCache::Free()
+struct TextureSourceStamp {
+  int64_t ModifiedTime = 0;
+  uint64_t Size = 0;
+};
+
+static std::optional<TextureSourceStamp> ReadSourceStamp(const String& sourcePath)
 {
-  if (m_Allocated) {
-    BaseAllocator::Deallocate(m_CurrentData);
-    m_Allocated = false;
-  }
+  std::error_code error;
+  TextureSourceStamp stamp;
+  stamp.Size = std::filesystem::file_size(sourcePath, error);
+  if (error)
+    return std::nullopt;
+  const auto modified = std::filesystem::last_write_time(sourcePath, error);
+  if (error)
+    return std::nullopt;
+  stamp.ModifiedTime = static_cast<int64_t>(modified.time_since_epoch().count());
+  return stamp;
 }
 
-bool TextureCache::Load(const String& path, MaterialTexture2D* texture)
+static std::optional<uint64_t> HashSourceContents(const String& sourcePath)
 {
-  if (!Yeager::ValidatesPath(path)) {
-    Yeager::LogDebug(ERROR, "Given path {} is not valid!", path);
-    return false;
-  }
+  MappedFile source;
+  if (!source.Open(sourcePath))
+    return std::nullopt;
+  return HashCacheBytes(source.GetData(), source.GetSize());
+}
 
-  BaseAllocator::AddIntervalOfMemChecking("Cache");
+uint32_t TextureCache::GetCacheFlags(const TextureCacheSettings& settings)
+{
+  return (settings.bSRGB ? TextureCacheFlags::eSRGB : 0) | (settings.bFlipped ? TextureCacheFlags::eFLIPPED : 0) |
+         (settings.bCompress ? TextureCacheFlags::eCOMPRESSED : 0);
+}
 
-  FileHandle fp = Yeager::OpenFileR(path, std::ios::out | std::ios::binary);
+String TextureCache::BuildCachePath(const String& folder, const String& sourcePath,
+                                    const TextureCacheSettings& settings)
+{
+  const uint32_t flags = GetCacheFlags(settings);
+  const uint64_t path = HashCacheBytes(reinterpret_cast<const unsigned char*>(sourcePath.data()), sourcePath.size());
+  const uint64_t name = HashCacheBytes(reinterpret_cast<const unsigned char*>(&flags), sizeof(flags), path);
+  return folder + YG_PS + fmt::format("{:016x}", name) + YEAGER_TEXTURE_CACHE_EXT_STR;
+}
 
-  if (!fp.bValid) {
-    Yeager::LogDebug(ERROR, "Cannot open file {} for texture caching!", path);
-    return false;
+std::optional<TextureCacheData> TextureCache::Build(const String& sourcePath, const unsigned char* pixels, Uint width,
+                                                   Uint height, Uint channels, const TextureCacheSettings& settings)
+{
+  if (pixels == YEAGER_NULLPTR || width == 0 || height == 0 || channels == 0 || channels > 4) {
+    Yeager::Log(WARNING, "Cannot build the texture cache of {}, invalid image ({}x{}, {} channels)", sourcePath, width,
+                height, channels);
+    return std::nullopt;
   }
 
-  unsigned char* data = BaseAllocator::Allocate<unsigned char>(fp.mSize);
-
-  fp.mFile.read(reinterpret_cast<char*>(data), fp.mSize);
+  const std::optional<TextureSourceStamp> stamp = ReadSourceStamp(sourcePath);
+  const std::optional<uint64_t> contentHash = HashSourceContents(sourcePath);
+  if (!stamp.has_value() || !contentHash.has_value()) {
+    Yeager::Log(WARNING, "Cannot read the source {} of the texture cache!", sourcePath);
+    return std::nullopt;
+  }
 
-  TextureCacheHeader* header = (TextureCacheHeader*)data;
+  TextureCacheData data;
+  data.Path = sourcePath;
+  data.Levels = GenerateMipChain(ExpandToRGBA8(pixels, width, height, channels), width, height, settings.bSRGB);
 
-  if (BaseAllocator::Memcmp(header->MagicConst, YEAGER_CACHE_MAGIC_CONST, sizeof(char) * 4) == 0) {
-    Yeager::LogDebug(INFO, "Is a cache file! {}", path);
-  } else {
-    Yeager::LogDebug(ERROR, "Given file {}, is not a valid texture cache file!", path);
-    Yeager::CloseFile(fp);
-    BaseAllocator::Deallocate(data);
+  TexturePayloadFormat::Enum payload = TexturePayloadFormat::eRGBA8;
+  if (settings.bCompress)
+    payload = IsImageOpaque(data.Levels.front()) ? TexturePayloadFormat::eBC1 : TexturePayloadFormat::eBC3;
+  for (auto& level : data.Levels) {
+    level = CompressTextureLevel(level, payload);
   }
 
-  GLuint* image = BaseAllocator::Allocate<GLuint>(header->FileSize);
-
-  BaseAllocator::Memcpy(image, data + sizeof(TextureCacheHeader), header->FileSize);
+  TextureCacheHeader& header = data.Header;
+  std::memcpy(header.MagicConst, YEAGER_CACHE_MAGIC_CONST, sizeof(header.MagicConst));
+  header.Version = YEAGER_TEXTURE_CACHE_VERSION;
+  header.ContentHash = contentHash.value();
+  header.SourceModifiedTime = stamp->ModifiedTime;
+  header.SourceSize = stamp->Size;
+  header.Width = width;
+  header.Height = height;
+  header.Format = SourceFormatOfChannels(channels);
+  header.Payload = static_cast<uint32_t>(payload);
+  header.LevelCount = static_cast<uint32_t>(data.Levels.size());
+  header.Flags = GetCacheFlags(settings);
+  return data;
+}
 
-  TextureCacheData cdata = {.mHeader = header, .mData = (unsigned char*)image, .mPath = path};
+bool TextureCache::Write(const String& cachePath, const TextureCacheData& data)
+{
+  const std::vector<TextureMipLevel>& levels = data.Levels;
+  if (levels.empty() || levels.size() != data.Header.LevelCount) {
+    Yeager::Log(WARNING, "Cannot write the texture cache {}, the level chain is incomplete", cachePath);
+    return false;
+  }
 
-  texture->GenerateFromCacheData(&cdata);
+  TextureCacheHeader header = data.Header;
+  std::vector<TextureCacheLevel> table(levels.size());
+  uint64_t offset = AlignTextureCacheOffset(sizeof(TextureCacheHeader) + table.size() * sizeof(TextureCacheLevel));
+  for (Uint x = 0; x < levels.size(); x++) {
+    table[x].Offset = offset;
+    table[x].Size = levels[x].Data.size();
+    table[x].Width = levels[x].Width;
+    table[x].Height = levels[x].Height;
+    offset = AlignTextureCacheOffset(offset + table[x].Size);
+  }
+  header.FileSize = offset;
 
-  Yeager::CloseFile(fp);
-  BaseAllocator::Deallocate(data);
-  BaseAllocator::Deallocate(image);
+  std::vector<unsigned char> buffer(header.FileSize, 0);
+  std::memcpy(buffer.data(), &header, sizeof(TextureCacheHeader));
+  std::memcpy(buffer.data() + sizeof(TextureCacheHeader), table.data(), table.size() * sizeof(TextureCacheLevel));
+  for (Uint x = 0; x < levels.size(); x++) {
+    std::memcpy(buffer.data() + table[x].Offset, levels[x].Data.data(), levels[x].Data.size());
+  }
 
-  BaseAllocator::EndIntervalOfMemChecking("Cache");
+  if (!WriteCacheFile(cachePath, buffer.data(), buffer.size()))
+    return false;
 
+  Yeager::LogDebug(INFO, "Wrote texture cache {} of {} ({} levels, {} bytes)", cachePath, data.Path, header.LevelCount,
+                   header.FileSize);
   return true;
 }
 
-bool TextureCache::Create(const String& folder, Yeager::MaterialTexture2D& texture)
+bool TextureCache::Load(const String& cachePath, const String& sourcePath, const TextureCacheSettings& settings,
+                        TextureCacheData* data)
 {
-  if (!ValidatesPath(folder)) {
-    Yeager::LogDebug(ERROR, "Path to folder given is invalid for texture caching! Path: {}", folder);
+  std::error_code error;
+  if (!std::filesystem::exists(cachePath, error))
     return false;
-  }
 
-  if (!texture.IsGenerated()) {
-    Yeager::LogDebug(ERROR, "Cannot generate cache from ungenerated texture! {}", texture.GetName());
+  MappedFile mapping;
+  if (!mapping.Open(cachePath))
     return false;
-  }
 
-  if (!FormatToChannels(texture.GetFormat()).has_value()) {
-    Yeager::LogDebug(ERROR, "Invalid format from texture {}, cannot create cache!", texture.GetName());
+  TextureCacheHeader header;
+  if (mapping.GetSize() < sizeof(TextureCacheHeader)) {
+    Yeager::Log(WARNING, "Given file {} is not a valid texture cache file!", cachePath);
     return false;
   }
-
-  const String filename =
-      std::to_string(CreateFileHash(String(texture.GetPath()))) + String(YEAGER_TEXTURE_CACHE_EXT_STR);
-
-  const String path = folder + YG_PS + filename;
-
-  Yeager::LogDebug(INFO, "Writing texture cache {} to path {}", texture.GetName(), path);
-
-  size_t alloc_size =
-      sizeof(TextureCacheHeader) +
-      ((texture.GetWidth() * texture.GetHeight() * FormatToChannels(texture.GetFormat()).value()) * sizeof(GLuint));
-
-  m_CurrentData = BaseAllocator::Allocate<unsigned char>(alloc_size);
-
-  m_Allocated = true;
-
-  TextureCacheHeader* header = (TextureCacheHeader*)(m_CurrentData);
-
-  header->Width = static_cast<uint16_t>(texture.GetWidth());
-  header->Height = static_cast<uint16_t>(texture.GetHeight());
-  header->Format = static_cast<uint16_t>(texture.GetFormat());
-  header->FileSize = static_cast<uint64_t>(alloc_size - sizeof(TextureCacheHeader));
-
-  BaseAllocator::Memcpy(header->MagicConst, YEAGER_CACHE_MAGIC_CONST, sizeof(char) * 4);
-
-  std::time_t epoch = static_cast<uint64_t>(std::time(nullptr));
-  BaseAllocator::Memcpy(&header->Timestamp, &epoch, sizeof(uint64_t));
-
-  unsigned char* data_p = (m_CurrentData) + sizeof(TextureCacheHeader);
-
-  const size_t data_size = alloc_size - sizeof(TextureCacheHeader);
-
-  GLuint* bytes = BaseAllocator::Allocate<GLuint>(data_size);
-
-  glBindTexture(texture.GetTextureDataHandle()->BindTarget, texture.GetTextureID());
-
-  glGetTexImage(texture.GetTextureDataHandle()->BindTarget, NULL, texture.GetTextureDataHandle()->Format,
-                GL_UNSIGNED_INT, bytes);
-
-  glBindTexture(texture.GetTextureDataHandle()->BindTarget, NULL);
-
-  if (!bytes) {
-    Yeager::LogDebug(ERROR, "Bytes pointer retrieved from glGetTexImage is empty!");
+  std::memcpy(&header, mapping.GetData(), sizeof(TextureCacheHeader));
+  if (std::memcmp(header.MagicConst, YEAGER_CACHE_MAGIC_CONST, sizeof(header.MagicConst)) != 0) {
+    Yeager::Log(WARNING, "Given file {} is not a valid texture cache file!", cachePath);
+    return false;
   }
 
-  BaseAllocator::Memcpy(data_p, bytes, data_size);
-
-  FileHandle output = Yeager::OpenFileW(path, std::ios::out | std::ios::binary);
+  if (header.Version != YEAGER_TEXTURE_CACHE_VERSION || header.FileSize != mapping.GetSize() ||
+      header.Flags != GetCacheFlags(settings)) {
+    Yeager::LogDebug(INFO, "Texture cache {} is outdated, it will be rewritten", cachePath);
+    return false;
+  }
 
-  output.mFile.write((char*)m_CurrentData, alloc_size);
+  /* The modification time and size are enough most of the time, the contents are only hashed when one of them changed */
+  const std::optional<TextureSourceStamp> stamp = ReadSourceStamp(sourcePath);
+  if (!stamp.has_value())
+    return false;
+  if (stamp->ModifiedTime != header.SourceModifiedTime || stamp->Size != header.SourceSize) {
+    const std::optional<uint64_t> contentHash = HashSourceContents(sourcePath);
+    if (stamp->Size != header.SourceSize || !contentHash.has_value() || contentHash.value() != header.ContentHash) {
+      Yeager::LogDebug(INFO, "Source {} of the texture cache {} changed, it will be rewritten", sourcePath, cachePath);
+      return false;
+    }
+  }
 
-  Yeager::CloseFile(output);
+  const uint64_t tableEnd = sizeof(TextureCacheHeader) + uint64_t(header.LevelCount) * sizeof(TextureCacheLevel);
+  if (header.Payload > TexturePayloadFormat::eBC3 || header.Width == 0 || header.Height == 0 ||
+      header.LevelCount == 0 || header.LevelCount > 32 || tableEnd > header.FileSize) {
+    Yeager::Log(WARNING, "Texture cache {} has a corrupted header!", cachePath);
+    return false;
+  }
 
-  Free();
-  delete bytes;
+  const auto payload = static_cast<TexturePayloadFormat::Enum>(header.Payload);
+  std::vector<TextureCacheLevel> table(header.LevelCount);
+  std::memcpy(table.data(), mapping.GetData() + sizeof(TextureCacheHeader), table.size() * sizeof(TextureCacheLevel));
+
+  /* Every level must be half of the one above, rounded down and never under 1, and hold exactly its texels */
+  Uint width = header.Width;
+  Uint height = header.Height;
+  for (Uint x = 0; x < table.size(); x++) {
+    const TextureCacheLevel& level = table[x];
+    if (level.Width != width || level.Height != height ||
+        level.Size != GetTextureLevelSize(level.Width, level.Height, payload) || level.Offset < tableEnd ||
+        level.Offset > header.FileSize || level.Size > header.FileSize - level.Offset) {
+      Yeager::Log(WARNING, "Texture cache {} has a corrupted level {}!", cachePath, x);
+      return false;
+    }
+    width = std::max(width / 2, 1u);
+    height = std::max(height / 2, 1u);
+  }
+  /* The chain goes down to 1x1, the texture is created with that many levels */
+  if (table.back().Width != 1 || table.back().Height != 1) {
+    Yeager::Log(WARNING, "Texture cache {} has an incomplete level chain!", cachePath);
+    return false;
+  }
 
-  Yeager::LogDebug(INFO, "Done caching texture {}", texture.GetName());
+  TextureCacheData cached;
+  cached.Header = header;
+  cached.Path = sourcePath;
+  cached.Levels.resize(table.size());
+  for (Uint x = 0; x < table.size(); x++) {
+    cached.Levels[x].Width = table[x].Width;
+    cached.Levels[x].Height = table[x].Height;
+    cached.Levels[x].Data.assign(mapping.GetData() + table[x].Offset, mapping.GetData() + table[x].Offset + table[x].Size);
+  }
 
+  *data = std::move(cached);
   return true;
-}
\ No newline at end of file
+}
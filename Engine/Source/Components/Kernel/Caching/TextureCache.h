@@ -16,60 +16,94 @@
 //    You should have received a copy of the GNU General Public License
 //    along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
+
 #pragma once
 
 #include "Common/Utils/Common.h"
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
-#include "Components/Renderer/Texture/TextureHandle.h"
+#include "Components/Renderer/Texture/TextureCompression.h"
 
 namespace Yeager {
 
-class ApplicationCore;
-class MaterialTexture2D;
-
 #define YEAGER_TEXTURE_CACHE_EXT_STR ".ytex_ch"
 #define YEAGER_CACHE_MAGIC_CONST "YGEN"
+/* Bump when the layout below, the mip filter or the encoders change, old files are ignored and rewritten */
+#define YEAGER_TEXTURE_CACHE_VERSION 3
+#define YEAGER_TEXTURE_CACHE_ALIGNMENT 16
+
+struct TextureCacheFlags {
+  enum Enum { eSRGB = 1 << 0, eFLIPPED = 1 << 1, eCOMPRESSED = 1 << 2 };
+};
+
 /**
- * Texture cache header file (name_hash).ygen_tex_cache  
- * 4 Bytes - Magic const YGEN 
- * 8 Bytes - Timestamp 
- * 2 Bytes = Format 
- * 2 Bytes - Width
- * 2 Bytes - Height
- * 8 Byte - File size
- * Total size : 26 bytes 
+ * Texture cache file (path hash).ytex_ch, every level starts at a 16 bytes aligned offset
+ * TextureCacheHeader
+ * TextureCacheLevel[LevelCount] - The full mip chain, from the source size down to 1x1
+ * Levels - RGBA8 texels or BC1/BC3 blocks, as given by Payload
  */
-
 struct TextureCacheHeader {
   char MagicConst[4] = {0};
-  uint64_t Timestamp = 0;
-  uint16_t Format = 0;
-  uint16_t Width = 0;
-  uint16_t Height = 0;
+  uint32_t Version = 0;
+  /* Hash of the source image contents, checked when the modification time or size of the source changed */
+  uint64_t ContentHash = 0;
+  int64_t SourceModifiedTime = 0;
+  uint64_t SourceSize = 0;
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+  /* OpenGL format of the source image, GL_RED, GL_RGB or GL_RGBA */
+  uint32_t Format = 0;
+  uint32_t Payload = 0;
+  uint32_t LevelCount = 0;
+  /* TextureCacheFlags of the settings the levels were built with */
+  uint32_t Flags = 0;
   uint64_t FileSize = 0;
 };
 
-extern size_t CreateFileHash(const String& name);
-
-class TextureCache {
- public:
-  TextureCache(Yeager::ApplicationCore* application);
-  ~TextureCache() {}
+struct TextureCacheLevel {
+  uint64_t Offset = 0;
+  uint64_t Size = 0;
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+};
 
-  virtual bool Create(const String& folder, Yeager::MaterialTexture2D& texture);
-  bool Load(const String& path, MaterialTexture2D* texture);
+struct TextureCacheSettings {
+  /* Block compress the levels, BC1 when the image is opaque and BC3 otherwise, or keep them as RGBA8 */
+  bool bCompress = true;
+  /* Color images are filtered in linear space, data such as normal maps are not */
+  bool bSRGB = true;
+  bool bFlipped = false;
+};
 
-  std::optional<TextureCacheHeader*> GetDataHeader();
+/* Everything needed to create the texture, read without touching OpenGL */
+struct TextureCacheData {
+  TextureCacheHeader Header;
+  std::vector<TextureMipLevel> Levels;
+  String Path = YEAGER_NULL_LITERAL;
+};
 
-  void Free();
+/**
+ * @brief Cache of decoded images with their mip chain, skips the image decoding and the mipmap generation when the source
+ * did not change. Writing and loading are plain file work and can run on any thread, the material texture uploads the
+ * levels afterwards
+ */
+class TextureCache {
+ public:
+  /** @brief The settings are part of the name, a normal map and a color image of the same source get their own files */
+  static String BuildCachePath(const String& folder, const String& sourcePath, const TextureCacheSettings& settings);
+  YEAGER_NODISCARD static uint32_t GetCacheFlags(const TextureCacheSettings& settings);
 
- protected:
-  bool m_Allocated = true;
-  YEAGER_USING_SHARED_PTR
-  SharedPtr<TextureCacheHeader> m_Header = YEAGER_NULLPTR;
-  unsigned char* m_CurrentData = YEAGER_NULLPTR;
-  Yeager::ApplicationCore* m_Application = YEAGER_NULLPTR;
+  /** @brief Builds the mip chain of the decoded source image and compresses it, the result can be uploaded or written */
+  static std::optional<TextureCacheData> Build(const String& sourcePath, const unsigned char* pixels, Uint width,
+                                               Uint height, Uint channels, const TextureCacheSettings& settings);
+  static bool Write(const String& cachePath, const TextureCacheData& data);
+  /**
+   * @brief Reads the cache file of the source. The file is outdated when the source modification time or size differ from
+   * the header and its contents hash too, a source that was only touched or copied keeps its cache. A file built with
+   * other settings is outdated as well
+   */
+  static bool Load(const String& cachePath, const String& sourcePath, const TextureCacheSettings& settings,
+                   TextureCacheData* data);
 };
 
-}  // namespace Yeager
\ No newline at end of file
+}  // namespace Yeager
@@ -0,0 +1,377 @@
+#include "JobSystem.h"
+#include "Components/Kernel/Hardware/HardwareInfo.h"
+using namespace Yeager;
+
+/**
+ * @brief A unit of work, the unfinished count starts at one for the job itself and grows with every child attached to it.
+ * Jobs are deleted by the thread that brings the count to zero
+ */
+struct Yeager::Job {
+  std::function<void()> Task;
+  Job* Parent = YEAGER_NULLPTR;
+  JobCounter* Counter = YEAGER_NULLPTR;
+  JobPriority::Enum Priority = JobPriority::eFRAME;
+  std::atomic<Uint> UnfinishedJobs = 1;
+};
+
+std::vector<std::unique_ptr<JobDeque>> JobSystem::sDeques;
+std::vector<std::thread> JobSystem::sWorkers;
+std::mutex JobSystem::sHighMutex;
+std::deque<Job*> JobSystem::sHighQueue;
+std::atomic<Uint> JobSystem::sHighSize = 0;
+std::mutex JobSystem::sInjectionMutex;
+std::deque<Job*> JobSystem::sInjectionQueue;
+std::atomic<Uint> JobSystem::sInjectionSize = 0;
+std::vector<std::thread> JobSystem::sBackgroundThreads;
+std::mutex JobSystem::sBackgroundMutex;
+std::condition_variable JobSystem::sBackgroundCondition;
+std::deque<Job*> JobSystem::sBackgroundQueue;
+bool JobSystem::bBackgroundShutdown = false;
+std::mutex JobSystem::sSleepMutex;
+std::condition_variable JobSystem::sWakeCondition;
+std::atomic<int64_t> JobSystem::sQueuedJobs = 0;
+std::atomic<Uint> JobSystem::sSleepingWorkers = 0;
+std::atomic<bool> JobSystem::bShutdown = false;
+bool JobSystem::sInitialized = false;
+
+static thread_local int sWorkerIndex = -1;
+static thread_local Job* sCurrentJob = YEAGER_NULLPTR;
+static thread_local bool sBackgroundThread = false;
+static thread_local uint32_t sStealSeed = 0;
+
+/* Xorshift, picks the first victim of a steal so the workers dont all hammer the same deque */
+static uint32_t NextStealVictim()
+{
+  if (sStealSeed == 0)
+    sStealSeed = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1;
+  sStealSeed ^= sStealSeed << 13;
+  sStealSeed ^= sStealSeed >> 17;
+  sStealSeed ^= sStealSeed << 5;
+  return sStealSeed;
+}
+
+bool JobDeque::Push(Job* job)
+{
+  const int64_t bottom = mBottom.load(std::memory_order_relaxed);
+  const int64_t top = mTop.load(std::memory_order_acquire);
+  if (bottom - top > sMask)
+    return false;
+
+  mBuffer[bottom & sMask].store(job, std::memory_order_relaxed);
+  mBottom.store(bottom + 1, std::memory_order_release);
+  return true;
+}
+
+Job* JobDeque::Pop()
+{
+  const int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+  mBottom.store(bottom, std::memory_order_seq_cst);
+  int64_t top = mTop.load(std::memory_order_seq_cst);
+
+  if (top > bottom) {
+    /* Empty, restore the bottom */
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+    return YEAGER_NULLPTR;
+  }
+
+  Job* job = mBuffer[bottom & sMask].load(std::memory_order_relaxed);
+  if (top == bottom) {
+    /* Last job in the deque, race against the thieves for it */
+    if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      job = YEAGER_NULLPTR;
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return job;
+}
+
+Job* JobDeque::Steal()
+{
+  int64_t top = mTop.load(std::memory_order_seq_cst);
+  const int64_t bottom = mBottom.load(std::memory_order_seq_cst);
+  if (top >= bottom)
+    return YEAGER_NULLPTR;
+
+  Job* job = mBuffer[top & sMask].load(std::memory_order_relaxed);
+  if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    return YEAGER_NULLPTR;
+  return job;
+}
+
+void JobSystem::Initialize(Uint threadCount)
+{
+  if (sInitialized) {
+    Yeager::Log(WARNING, "Job system is already initialized!");
+    return;
+  }
+
+  if (threadCount == 0)
+    threadCount = GetHardwareThreadCount();
+  threadCount = std::max<Uint>(threadCount, YEAGER_JOB_MINIMUM_THREAD_COUNT);
+
+  bShutdown = false;
+  sDeques.clear();
+  for (Uint x = 0; x < threadCount; x++)
+    sDeques.push_back(std::make_unique<JobDeque>());
+
+  sWorkerIndex = 0;
+  sInitialized = true;
+
+  sWorkers.reserve(threadCount - 1);
+  for (Uint x = 1; x < threadCount; x++)
+    sWorkers.emplace_back(WorkerLoop, x);
+
+  bBackgroundShutdown = false;
+  const Uint backgroundCount = std::max<Uint>(YEAGER_JOB_MINIMUM_BACKGROUND_THREAD_COUNT, threadCount / 4);
+  for (Uint x = 0; x < backgroundCount; x++)
+    sBackgroundThreads.emplace_back(BackgroundLoop);
+
+  Yeager::Log(INFO, "Job system initialized with {} workers and {} background threads", threadCount, backgroundCount);
+}
+
+void JobSystem::Terminate()
+{
+  if (!sInitialized)
+    return;
+
+  /* The background threads go first, their jobs may still submit frame jobs to the workers */
+  {
+    std::lock_guard<std::mutex> lock(sBackgroundMutex);
+    bBackgroundShutdown = true;
+  }
+  sBackgroundCondition.notify_all();
+  for (auto& thread : sBackgroundThreads) {
+    if (thread.joinable())
+      thread.join();
+  }
+  sBackgroundThreads.clear();
+
+  /* The calling thread helps draining what is left before the workers are told to stop */
+  while (TryExecuteOneJob()) {}
+
+  {
+    std::lock_guard<std::mutex> lock(sSleepMutex);
+    bShutdown = true;
+  }
+  sWakeCondition.notify_all();
+
+  for (auto& worker : sWorkers) {
+    if (worker.joinable())
+      worker.join();
+  }
+  sWorkers.clear();
+  sDeques.clear();
+  sInitialized = false;
+  sWorkerIndex = -1;
+  Yeager::Log(INFO, "Job system terminated");
+}
+
+int JobSystem::GetCurrentWorkerIndex()
+{
+  return sWorkerIndex;
+}
+
+void JobSystem::Run(std::function<void()> task, JobCounter* counter, JobPriority::Enum priority)
+{
+  Job* job = new Job();
+  job->Task = std::move(task);
+  job->Counter = counter;
+  job->Priority = priority;
+  if (counter)
+    counter->mPending.fetch_add(1, std::memory_order_relaxed);
+  Submit(job);
+}
+
+void JobSystem::RunChild(std::function<void()> task)
+{
+  Job* parent = sCurrentJob;
+  Job* job = new Job();
+  job->Task = std::move(task);
+  job->Parent = parent;
+  if (parent) {
+    job->Priority = parent->Priority;
+    parent->UnfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+  }
+  Submit(job);
+}
+
+void JobSystem::Wait(const JobCounter* counter)
+{
+  while (!counter->IsDone()) {
+    if (TryExecuteOneJob())
+      continue;
+    /* A background job waiting on another one must not wait on a queue only its own kind of thread drains */
+    if (sBackgroundThread && TryExecuteBackgroundJob())
+      continue;
+    std::this_thread::yield();
+  }
+}
+
+void JobSystem::Submit(Job* job)
+{
+  if (!sInitialized) {
+    Execute(job);
+    return;
+  }
+
+  if (job->Priority == JobPriority::eBACKGROUND) {
+    {
+      std::lock_guard<std::mutex> lock(sBackgroundMutex);
+      sBackgroundQueue.push_back(job);
+    }
+    sBackgroundCondition.notify_one();
+    return;
+  }
+
+  if (job->Priority == JobPriority::eHIGH) {
+    std::lock_guard<std::mutex> lock(sHighMutex);
+    sHighQueue.push_back(job);
+    sHighSize.fetch_add(1, std::memory_order_relaxed);
+  } else if (sWorkerIndex >= 0) {
+    if (!sDeques[sWorkerIndex]->Push(job)) {
+      /* Deque is full, running the job now is cheaper than waiting for room */
+      Execute(job);
+      return;
+    }
+  } else {
+    std::lock_guard<std::mutex> lock(sInjectionMutex);
+    sInjectionQueue.push_back(job);
+    sInjectionSize.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  sQueuedJobs.fetch_add(1, std::memory_order_seq_cst);
+  WakeWorker();
+}
+
+void JobSystem::WakeWorker()
+{
+  /* The sleeping count is raised under the mutex before the worker checks for queued jobs, so taking the mutex here
+     guarantees the worker is either already waiting or will see the new job */
+  if (sSleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+    std::lock_guard<std::mutex> lock(sSleepMutex);
+    sWakeCondition.notify_one();
+  }
+}
+
+Job* JobSystem::FindJob()
+{
+  Job* job = YEAGER_NULLPTR;
+  if (sHighSize.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(sHighMutex);
+    if (!sHighQueue.empty()) {
+      job = sHighQueue.front();
+      sHighQueue.pop_front();
+      sHighSize.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  if (!job && sWorkerIndex >= 0)
+    job = sDeques[sWorkerIndex]->Pop();
+
+  if (!job && sInjectionSize.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(sInjectionMutex);
+    if (!sInjectionQueue.empty()) {
+      job = sInjectionQueue.front();
+      sInjectionQueue.pop_front();
+      sInjectionSize.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  if (!job) {
+    const Uint count = static_cast<Uint>(sDeques.size());
+    const Uint start = NextStealVictim() % count;
+    for (Uint x = 0; x < count && !job; x++) {
+      const Uint victim = (start + x) % count;
+      if (static_cast<int>(victim) != sWorkerIndex)
+        job = sDeques[victim]->Steal();
+    }
+  }
+
+  if (job)
+    sQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+  return job;
+}
+
+bool JobSystem::TryExecuteOneJob()
+{
+  Job* job = FindJob();
+  if (!job)
+    return false;
+  Execute(job);
+  return true;
+}
+
+bool JobSystem::TryExecuteBackgroundJob()
+{
+  Job* job = YEAGER_NULLPTR;
+  {
+    std::lock_guard<std::mutex> lock(sBackgroundMutex);
+    if (sBackgroundQueue.empty())
+      return false;
+    job = sBackgroundQueue.front();
+    sBackgroundQueue.pop_front();
+  }
+  Execute(job);
+  return true;
+}
+
+void JobSystem::Execute(Job* job)
+{
+  Job* previous = sCurrentJob;
+  sCurrentJob = job;
+  job->Task();
+  sCurrentJob = previous;
+  Finish(job);
+}
+
+void JobSystem::Finish(Job* job)
+{
+  while (job && job->UnfinishedJobs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Job* parent = job->Parent;
+    /* Once the counter is released the waiting thread may destroy it, it must not be touched afterwards */
+    if (job->Counter)
+      job->Counter->mPending.fetch_sub(1, std::memory_order_acq_rel);
+    delete job;
+    job = parent;
+  }
+}
+
+void JobSystem::WorkerLoop(Uint index)
+{
+  sWorkerIndex = static_cast<int>(index);
+
+  while (true) {
+    if (TryExecuteOneJob())
+      continue;
+
+    std::unique_lock<std::mutex> lock(sSleepMutex);
+    sSleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+    sWakeCondition.wait(lock,
+                        [] { return sQueuedJobs.load(std::memory_order_seq_cst) > 0 || bShutdown.load(); });
+    sSleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+    if (bShutdown && sQueuedJobs.load(std::memory_order_seq_cst) <= 0)
+      break;
+  }
+
+  sWorkerIndex = -1;
+}
+
+void JobSystem::BackgroundLoop()
+{
+  sBackgroundThread = true;
+
+  while (true) {
+    Job* job = YEAGER_NULLPTR;
+    {
+      std::unique_lock<std::mutex> lock(sBackgroundMutex);
+      sBackgroundCondition.wait(lock, [] { return !sBackgroundQueue.empty() || bBackgroundShutdown; });
+      /* Shutting down only once the queue is drained, the jobs left still signal their counters */
+      if (sBackgroundQueue.empty())
+        break;
+      job = sBackgroundQueue.front();
+      sBackgroundQueue.pop_front();
+    }
+    Execute(job);
+  }
+
+  sBackgroundThread = false;
+}
@@ -0,0 +1,200 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace Yeager {
+
+/* Capacity of each worker deque, must be a power of two. When a deque is full the job is executed inline */
+#define YEAGER_JOB_DEQUE_CAPACITY 4096
+#define YEAGER_JOB_MINIMUM_THREAD_COUNT 2
+/* Threads running the background jobs, at least this many and a quarter of the workers beyond that */
+#define YEAGER_JOB_MINIMUM_BACKGROUND_THREAD_COUNT 2
+
+struct Job;
+
+struct JobPriority {
+  enum Enum {
+    /* Jobs a thread is blocked on right now (the physics step tasks), picked before any frame job by every worker */
+    eHIGH,
+    /* Short jobs the frame waits on (ParallelFor ranges), executed by the workers and by the threads waiting */
+    eFRAME,
+    /* Long jobs (model importing, texture decoding, terrain generation) executed by their own threads, the workers
+       and the threads waiting on a counter never pick them, so the frame does not stall behind them */
+    eBACKGROUND
+  };
+};
+
+/**
+ * @brief Counts how many jobs linked to it are still pending. A counter is incremented when a job is submitted with it,
+ * and decremented once the job and all of its children are finished. Used as a fence with JobSystem::Wait
+ * @attention The counter must outlive every job linked to it, always wait on it before going out of scope!
+ */
+class JobCounter {
+ public:
+  JobCounter() = default;
+  JobCounter(const JobCounter&) = delete;
+  JobCounter& operator=(const JobCounter&) = delete;
+
+  YEAGER_NODISCARD bool IsDone() const { return mPending.load(std::memory_order_acquire) == 0; }
+  YEAGER_NODISCARD Uint GetPending() const { return mPending.load(std::memory_order_acquire); }
+
+ private:
+  friend class JobSystem;
+  std::atomic<Uint> mPending = 0;
+};
+
+/**
+ * @brief Chase-Lev work stealing deque with a fixed capacity. Only the worker that owns the deque can push and pop from
+ * the bottom, every other thread steals from the top
+ */
+class JobDeque {
+ public:
+  JobDeque() = default;
+  JobDeque(const JobDeque&) = delete;
+  JobDeque& operator=(const JobDeque&) = delete;
+
+  /** @brief Owner only, returns false when the deque is full */
+  bool Push(Job* job);
+  /** @brief Owner only, takes the last pushed job (LIFO) */
+  Job* Pop();
+  /** @brief Any thread, takes the oldest job (FIFO) */
+  Job* Steal();
+
+ private:
+  static YEAGER_CONSTEXPR int64_t sMask = YEAGER_JOB_DEQUE_CAPACITY - 1;
+  alignas(64) std::atomic<int64_t> mTop = 0;
+  alignas(64) std::atomic<int64_t> mBottom = 0;
+  std::array<std::atomic<Job*>, YEAGER_JOB_DEQUE_CAPACITY> mBuffer = {};
+};
+
+/**
+ * @brief Fixed size pool of worker threads sized from the hardware thread count. Each worker owns a deque of jobs, and
+ * steal from the others when it runs out of work. The thread that calls Initialize (the main thread) is registered as worker 0,
+ * it does not loop for jobs but executes them while waiting on a counter. Threads outside the pool submit through a shared queue
+ * @attention Long tasks (model importing, terrain generation) must be submitted as JobPriority::eBACKGROUND, they run
+ * on a separate set of threads so they never keep a worker busy nor get picked by a thread waiting on a frame counter
+ */
+class JobSystem {
+ public:
+  /** @brief Starts the workers, a thread count of 0 means one worker per hardware thread */
+  static void Initialize(Uint threadCount = 0);
+  /** @brief Executes every remaining job and joins the workers */
+  static void Terminate();
+
+  /**
+   * @brief Submits the task to the pool, if a counter is given, it is incremented now and decremented when the task and
+   * its children are finished. Without a initialized pool the task is executed inline
+   */
+  static void Run(std::function<void()> task, JobCounter* counter = YEAGER_NULLPTR,
+                  JobPriority::Enum priority = JobPriority::eFRAME);
+
+  /**
+   * @brief Submits the task as a child of the job currently running in this thread, the parent job only counts as finished
+   * (and only signals its counter) after all of its children are finished. The child keeps the priority of its parent.
+   * Outside a job it behaves like Run without a counter
+   */
+  static void RunChild(std::function<void()> task);
+
+  /**
+   * @brief Blocks until the counter reaches zero, executing pending high priority and frame jobs in the meantime
+   * instead of sleeping. Only the background threads also execute background jobs while waiting
+   */
+  static void Wait(const JobCounter* counter);
+
+  /**
+   * @brief Splits [0, count) into ranges of grain elements and calls fun(begin, end) for each of them in parallel, the
+   * caller executes the first range and returns after every range is done. A grain of 0 picks one based on the worker count
+   */
+  template <typename Fun>
+  static void ParallelFor(Uint count, Uint grain, Fun&& fun)
+  {
+    if (count == 0)
+      return;
+    if (grain == 0)
+      grain = std::max<Uint>(1, count / (GetWorkerCount() * 4));
+    if (count <= grain || !sInitialized) {
+      fun(Uint(0), count);
+      return;
+    }
+
+    JobCounter counter;
+    for (Uint begin = grain; begin < count; begin += grain) {
+      const Uint end = std::min(begin + grain, count);
+      Run([&fun, begin, end]() { fun(begin, end); }, &counter);
+    }
+    fun(Uint(0), grain);
+    Wait(&counter);
+  }
+
+  YEAGER_NODISCARD static Uint GetWorkerCount() { return sInitialized ? static_cast<Uint>(sDeques.size()) : 1; }
+  YEAGER_NODISCARD static bool IsInitialized() { return sInitialized; }
+  /** @brief Returns the index of the worker running in this thread, -1 when the thread is outside the pool */
+  YEAGER_NODISCARD static int GetCurrentWorkerIndex();
+
+ private:
+  static void WorkerLoop(Uint index);
+  static void BackgroundLoop();
+  static void Submit(Job* job);
+  static Job* FindJob();
+  static bool TryExecuteOneJob();
+  static bool TryExecuteBackgroundJob();
+  static void Execute(Job* job);
+  static void Finish(Job* job);
+  static void WakeWorker();
+
+  static std::vector<std::unique_ptr<JobDeque>> sDeques;
+  static std::vector<std::thread> sWorkers;
+
+  /* High priority jobs, every worker looks here before its own deque */
+  static std::mutex sHighMutex;
+  static std::deque<Job*> sHighQueue;
+  static std::atomic<Uint> sHighSize;
+
+  /* Jobs submitted from threads outside the pool */
+  static std::mutex sInjectionMutex;
+  static std::deque<Job*> sInjectionQueue;
+  static std::atomic<Uint> sInjectionSize;
+
+  /* Background jobs, executed in submission order by their own threads */
+  static std::vector<std::thread> sBackgroundThreads;
+  static std::mutex sBackgroundMutex;
+  static std::condition_variable sBackgroundCondition;
+  static std::deque<Job*> sBackgroundQueue;
+  static bool bBackgroundShutdown;
+
+  static std::mutex sSleepMutex;
+  static std::condition_variable sWakeCondition;
+  static std::atomic<int64_t> sQueuedJobs;
+  static std::atomic<Uint> sSleepingWorkers;
+  static std::atomic<bool> bShutdown;
+  static bool sInitialized;
+};
+
+}  // namespace Yeager
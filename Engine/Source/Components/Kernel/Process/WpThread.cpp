@@ -1,4 +1,4 @@
 #include "WpThread.h"
 using namespace Yeager;
 
-std::size_t ThreadManagement::sNumOfThreadsCreated = 0;
\ No newline at end of file
+std::atomic<std::size_t> ThreadManagement::sNumOfTasksCreated = 0;
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
 #include "Components/Kernel/Memory/Allocator.h"
+#include "Components/Kernel/Process/JobSystem.h"
 
 namespace Yeager {
 
@@ -29,23 +30,23 @@ namespace Yeager {
 #define YEAGER_THREAD_DEFAULT_NAME "DNThread"
 
 /**
- * @brief Wrapper around std::thread, contains the process name, the thread handle, and std::atomic<bool> to know when is finished.
- *  This kind of thread, when created using the ThreadManagemenet, is stored in a vector for futher debugging 
- * @attention This struct is only useful when the thread must not return a value! Only void functions can be used, here the result is compute inside the function
+ * @brief Handle to a task running in the job system, contains the process name, the counter of the job, and std::atomic<bool> to know when is finished.
+ *  Destroying the handle waits for the task to finish, so the task never outlives the data it points to
+ * @attention This struct is only useful when the task must not return a value! Only void functions can be used, here the result is compute inside the function
  */
 struct WpThread {
-  ~WpThread()
-  {
-    if (mThread.joinable())
-      mThread.join();
-  }
+  ~WpThread() { Join(); }
+
+  /** @brief Blocks until the task is finished, the calling thread executes pending frame jobs meanwhile */
+  void Join() { JobSystem::Wait(&mCounter); }
+
   String mProcessName = YEAGER_THREAD_DEFAULT_NAME;
-  std::thread mThread;
+  JobCounter mCounter;
   std::atomic<bool> bIsFinished = false;
 };
 
 /**
- * @brief A better wrapper on std::thread, its the same as WpThread but holds a std::promise, std::future and works around a value T data
+ * @brief The same as WpThread but holds a std::promise and std::future with the value T returned by the task
  * @attention The component that make uses of this thread must take care of the asnyc value being generate, like checks to know when the thread is finished
  */
 template <typename T>
@@ -53,15 +54,13 @@ struct WpThreadFuture : public WpThread {
   std::promise<T> mPromise;
   std::future<T> mFuture;
 
-  T Get() { mFuture.get(); }
-  std::atomic<bool> IsFinished() { mFuture.valid() ? bIsFinished : false; }
-
-  T mData;
+  T Get() { return mFuture.get(); }
+  bool IsFinished() const { return mFuture.valid() && bIsFinished; }
 };
 
 /**
- * @brief Thread Management managers mostly of the threads and provide function to create them.
- * All threads created using this function are returned as shared_ptr, so them dont go out of scope and terminate
+ * @brief Thread Management creates background tasks in the job system and returns handles to them.
+ * All tasks created using this function are returned as shared_ptr, the handle waits for the task when it goes out of scope
  */
 class ThreadManagement {
  public:
@@ -71,21 +70,24 @@ class ThreadManagement {
   using shared_tf = std::shared_ptr<WpThreadFuture<T>>;
 
   /**
-   * @brief Creates a new thread with the process name and a given Callable function, like a lambda function. 
-   * During the thread, the function is executed and marked as finished once done. 
-   * @return Returns a shared_ptr to the created thread, but dont worry, the thread is stored in a std::vector during execution
+   * @brief Runs the given Callable function, like a lambda function, in the job system with the process name. 
+   * During the task, the function is executed and marked as finished once done. 
+   * @return Returns a shared_ptr to the handle of the task
    */
   template <typename Callable>
   static shared_t NewThread(const String& process, Callable&& fun)
   {
     auto wt = BaseAllocator::MakeSharedPtr<WpThread>();
     wt->mProcessName = process;
-    wt->mThread = std::thread([&, wt] {
-      fun();
-      wt->bIsFinished = true;
-      ThreadDebugLog(INFO, "Thread {} was finished doing the task!", wt->mProcessName);
-    });
-    sNumOfThreadsCreated += 1;
+    /* The handle waits for the job in its destructor, a raw pointer avoids the job owning its own handle */
+    JobSystem::Run(
+        [handle = wt.get(), fun = std::forward<Callable>(fun)]() mutable {
+          fun();
+          handle->bIsFinished = true;
+          ThreadDebugLog(INFO, "Thread {} was finished doing the task!", handle->mProcessName);
+        },
+        &wt->mCounter, JobPriority::eBACKGROUND);
+    sNumOfTasksCreated += 1;
 
     ThreadDebugLog(INFO, "Created new thread ({})!", process);
 
@@ -93,21 +95,23 @@ class ThreadManagement {
   }
 
   /**
-   * @brief Creates a new thread with the process name and a given Fun function with the given Agrs arguments. 
-   * During the thread, the function is executed and marked as finished once done. 
-   * @return Returns a shared_ptr to the created thread, but dont worry, the thread is stored in a std::vector during execution
+   * @brief Runs the given Fun function with the given Args arguments in the job system with the process name. 
+   * During the task, the function is executed and marked as finished once done. 
+   * @return Returns a shared_ptr to the handle of the task
    */
   template <typename Fun, typename... Args>
   static shared_t NewThread(const String& process, Fun&& fun, Args&&... args)
   {
     auto wt = BaseAllocator::MakeSharedPtr<WpThread>();
     wt->mProcessName = process;
-    wt->mThread = std::thread([&, wt] {
-      fun(std::forward<Args>(args)...);
-      wt->bIsFinished = true;
-      ThreadDebugLog(INFO, "Thread {} was finished doing the task!", wt->mProcessName);
-    });
-    sNumOfThreadsCreated += 1;
+    JobSystem::Run(
+        [handle = wt.get(), fun = std::forward<Fun>(fun), ... args = std::forward<Args>(args)]() mutable {
+          fun(std::move(args)...);
+          handle->bIsFinished = true;
+          ThreadDebugLog(INFO, "Thread {} was finished doing the task!", handle->mProcessName);
+        },
+        &wt->mCounter, JobPriority::eBACKGROUND);
+    sNumOfTasksCreated += 1;
 
     ThreadDebugLog(INFO, "Created new thread ({})!", process);
 
@@ -115,9 +119,9 @@ class ThreadManagement {
   }
 
   /**
-   * @brief Creates a new thread future with the process name and a given Callable function, like a lambda function. 
-   * During the thread, the function is executed and marked as finished once done. You can get the value once the thread is finished.
-   * @return Returns a shared_ptr to the created thread marked as [[nodiscard]], you must take care of the thread during execution!
+   * @brief Runs the given Callable function, like a lambda function, in the job system with the process name. 
+   * During the task, the function is executed and marked as finished once done. You can get the value once the task is finished.
+   * @return Returns a shared_ptr to the handle marked as [[nodiscard]], you must take care of the task during execution!
    */
   template <typename T, typename Callable>
   YEAGER_NODISCARD static shared_tf<T> NewThreadFuture(const String& process, Callable&& fun)
@@ -126,20 +130,22 @@ class ThreadManagement {
     wt->mProcessName = process;
     wt->mFuture = wt->mPromise.get_future();
 
-    wt->mThread = std::thread([&, wt] {
-      wt->mData = fun();
-      wt->mPromise.set_value(wt->mData);
-      wt->bIsFinished = true;
-      ThreadDebugLog(INFO, "Thread {} was finished doing the task!", wt->mProcessName);
-    });
+    JobSystem::Run(
+        [handle = wt.get(), fun = std::forward<Callable>(fun)]() mutable {
+          handle->mPromise.set_value(fun());
+          handle->bIsFinished = true;
+          ThreadDebugLog(INFO, "Thread {} was finished doing the task!", handle->mProcessName);
+        },
+        &wt->mCounter, JobPriority::eBACKGROUND);
+    sNumOfTasksCreated += 1;
 
     return wt;
   }
 
   /**
-   * @brief Creates a new thread future with the process name and a given Fun function and Args arguments. 
-   * During the thread, the function is executed and marked as finished once done. You can get the value once the thread is finished.
-   * @return Returns a shared_ptr to the created thread marked as [[nodiscard]], you must take care of the thread during execution!
+   * @brief Runs the given Fun function with the Args arguments in the job system with the process name. 
+   * During the task, the function is executed and marked as finished once done. You can get the value once the task is finished.
+   * @return Returns a shared_ptr to the handle marked as [[nodiscard]], you must take care of the task during execution!
    */
   template <typename T, typename Fun, typename... Args>
   YEAGER_NODISCARD static shared_tf<T> NewThreadFuture(const String& process, Fun&& fun, Args&&... args)
@@ -148,12 +154,14 @@ class ThreadManagement {
     wt->mProcessName = process;
     wt->mFuture = wt->mPromise.get_future();
 
-    wt->mThread = std::thread([&, wt] {
-      wt->mData = fun(std::forward<Args>(args)...);
-      wt->mPromise.set_value(wt->mData);
-      wt->bIsFinished = true;
-      ThreadDebugLog(INFO, "Thread {} was finished doing the task!", wt->mProcessName);
-    });
+    JobSystem::Run(
+        [handle = wt.get(), fun = std::forward<Fun>(fun), ... args = std::forward<Args>(args)]() mutable {
+          handle->mPromise.set_value(fun(std::move(args)...));
+          handle->bIsFinished = true;
+          ThreadDebugLog(INFO, "Thread {} was finished doing the task!", handle->mProcessName);
+        },
+        &wt->mCounter, JobPriority::eBACKGROUND);
+    sNumOfTasksCreated += 1;
 
     return wt;
   }
@@ -167,6 +175,6 @@ class ThreadManagement {
   }
 
  private:
-  static std::size_t sNumOfThreadsCreated;
+  static std::atomic<std::size_t> sNumOfTasksCreated;
 };
 }  // namespace Yeager
\ No newline at end of file
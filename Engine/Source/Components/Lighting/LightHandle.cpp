@@ -1,4 +1,5 @@
 #include "LightHandle.h"
+#include "Main/Core/Application.h"
 using namespace Yeager;
 
 LightBaseHandle::LightBaseHandle(const EntityBuilder& builder, std::vector<Shader*> link_shaders)
@@ -6,54 +7,48 @@ LightBaseHandle::LightBaseHandle(const EntityBuilder& builder, std::vector<Shade
       m_LinkedShader(link_shaders)
 {
   m_PointLights.reserve(MAX_POINT_LIGHTS);
-  for (int x = 0; x < MAX_POINT_LIGHTS; x++) {
-    for (auto& shader : link_shaders) {
-      shader->UseShader();
-      shader->SetBool("pointLights[" + std::to_string(x) + "].Active", false);
-    }
+  for (auto& shader : link_shaders) {
+    m_LightingBlock.LinkShader(shader);
   }
 }
 
-void LightBaseHandle::BuildShaderProps(Vector3 viewPos, Vector3 front, float shininess)
+void LightBaseHandle::UploadShininess(float shininess)
 {
+  if (shininess == m_LastShininess)
+    return;
+
+  static const UniformHandle shininessHandle("material.Shininess");
   for (auto& shader : m_LinkedShader) {
     shader->UseShader();
-    for (int x = 0; x < m_PointLights.size(); x++) {
-      if (x > MAX_POINT_LIGHTS) {
-        break;
-      }
-      String point_name = "pointLights[" + std::to_string(x) + "].";
-      shader->SetVec3(point_name + "Position", m_PointLights.at(x).Position);
-      shader->SetFloat(point_name + "Constant", m_PointLights.at(x).Constant);
-      shader->SetFloat(point_name + "Linear", m_PointLights.at(x).Linear);
-      shader->SetFloat(point_name + "Quadratic", m_PointLights.at(x).Quadratic);
-      shader->SetVec3(point_name + "Ambient", m_PointLights.at(x).Ambient);
-      shader->SetVec3(point_name + "Diffuse", m_PointLights.at(x).Diffuse);
-      shader->SetVec3(point_name + "Specular", m_PointLights.at(x).Specular);
-      shader->SetBool(point_name + "Active", m_PointLights.at(x).Active);
-    }
+    shader->SetFloat(shininessHandle, shininess);
+  }
+  m_LastShininess = shininess;
+}
 
-    shader->SetVec3("viewer.Position", viewPos);
-    shader->SetFloat("material.Shininess", shininess);
-
-    shader->SetVec3("directionalLighNamet.Ambient", m_DirectionalLight.Ambient);
-    shader->SetVec3("directionalLight.Diffuse", m_DirectionalLight.Diffuse);
-    shader->SetVec3("directionalLight.Specular", m_DirectionalLight.Specular);
-    shader->SetVec3("directionalLight.Color", m_DirectionalLight.Color);
-
-    shader->SetVec3("spotLight.Position", viewPos);
-    shader->SetVec3("spotLight.Direction", front);
-    shader->SetVec3("spotLight.Ambient", spotLight.Ambient);
-    shader->SetVec3("spotLight.Diffuse", spotLight.Diffuse);
-    shader->SetVec3("spotLight.Specular", spotLight.Specular);
-    shader->SetFloat("spotLight.Constant", spotLight.Constant);
-    shader->SetFloat("spotLight.Linear", spotLight.Linear);
-    shader->SetFloat("spotLight.Quadratic", spotLight.Quadratic);
-    shader->SetFloat("spotLight.CutOff", spotLight.CutOff);
-    shader->SetFloat("spotLight.OuterCutOff", spotLight.OuterCutOff);
-    shader->SetBool("spotLight.Active", spotLight.Active);
+void LightBaseHandle::BuildShaderProps(Vector3 viewPos, Vector3 front, float shininess)
+{
+  Uint count = std::min<Uint>(m_PointLights.size(), MAX_POINT_LIGHTS);
+  for (Uint x = 0; x < count; x++) {
+    Std140PointLight point;
+    PackStd140PointLight(m_PointLights.at(x), &point);
+    m_LightingBlock.SetPointLight(x, point);
   }
+  m_LightingBlock.DisablePointLightsFrom(count);
+
+  Std140DirectionalLight directional;
+  PackStd140DirectionalLight(m_DirectionalLight, &directional);
+  m_LightingBlock.SetDirectionalLight(directional);
+
+  Std140SpotLight spot;
+  PackStd140SpotLight(spotLight, viewPos, front, &spot);
+  m_LightingBlock.SetSpotLight(spot);
+
+  m_LightingBlock.SetViewerPosition(viewPos);
+  m_LightingBlock.Upload(mApplication->GetUploadRing());
+
+  UploadShininess(shininess);
 }
+
 PhysicalLightHandle::PhysicalLightHandle(const EntityBuilder& builder, std::vector<Shader*> link_shader,
                                          Shader* draw_shader)
     : LightBaseHandle(builder, link_shader), m_DrawableShader(draw_shader)
@@ -69,58 +64,48 @@ PhysicalLightHandle::~PhysicalLightHandle()
   m_ObjectPointLights.clear();
 }
 
-void PhysicalLightHandle::DrawLightSources(float delta)
+void PhysicalLightHandle::DrawLightSources(float delta, const Frustum* frustum)
 {
   m_DrawableShader->UseShader();
   for (auto& obj : m_ObjectPointLights) {
+    obj.Position = obj.ObjSource->GetTransformation().position;
+    if (frustum) {
+      const AABB bounds = obj.ObjSource->GetWorldBounds();
+      if (bounds.IsValid() && !frustum->Intersects(bounds))
+        continue;
+    }
     m_DrawableShader->SetVec3("aColor", obj.Color);
-    obj.Position = obj.ObjSource->GetTransformationPtr()->position;
     obj.ObjSource->Draw(m_DrawableShader, delta);
   }
 }
 
 void PhysicalLightHandle::BuildShaderProps(Vector3 viewPos, Vector3 front, float shininess)
 {
-  for (auto& shader : m_LinkedShader) {
-    shader->UseShader();
+  Uint count = std::min<Uint>(m_ObjectPointLights.size(), MAX_POINT_LIGHTS);
+  for (Uint x = 0; x < count; x++) {
+    const ObjectPointLight& light = m_ObjectPointLights.at(x);
+    Std140PointLight point;
+    PackStd140PointLight(light, &point);
+    /* Light sources objects are tinted by their color */
+    point.Ambient = light.Color * light.Ambient;
+    point.Diffuse = light.Color;
+    point.Specular = light.Color;
+    m_LightingBlock.SetPointLight(x, point);
+  }
+  m_LightingBlock.DisablePointLightsFrom(count);
 
-    for (int x = 0; x < m_ObjectPointLights.size(); x++) {
-      String point_name = "pointLights[" + std::to_string(x) + "].";
-
-      shader->SetVec3(point_name + "Position", m_ObjectPointLights.at(x).Position);
-      shader->SetFloat(point_name + "Constant", m_ObjectPointLights.at(x).Constant);
-      shader->SetFloat(point_name + "Linear", m_ObjectPointLights.at(x).Linear);
-      shader->SetFloat(point_name + "Quadratic", m_ObjectPointLights.at(x).Quadratic);
-      shader->SetVec3(point_name + "Ambient",
-                      Vector3(m_ObjectPointLights.at(x).Color.x * m_ObjectPointLights.at(x).Ambient.x,
-                              m_ObjectPointLights.at(x).Color.y * m_ObjectPointLights.at(x).Ambient.y,
-                              m_ObjectPointLights.at(x).Color.z * m_ObjectPointLights.at(x).Ambient.z));
-      shader->SetVec3(point_name + "Diffuse", m_ObjectPointLights.at(x).Color);
-      shader->SetVec3(point_name + "Specular", m_ObjectPointLights.at(x).Color);
-      shader->SetBool(point_name + "Active", m_ObjectPointLights.at(x).Active);
-    }
+  Std140DirectionalLight directional;
+  PackStd140DirectionalLight(m_DirectionalLight, &directional);
+  m_LightingBlock.SetDirectionalLight(directional);
 
-    shader->SetVec3("viewer.Position", viewPos);
-    shader->SetFloat("material.Shininess", shininess);
-
-    shader->SetVec3("directionalLight.Direction", m_DirectionalLight.Direction);
-    shader->SetVec3("directionalLight.Ambient", m_DirectionalLight.Ambient);
-    shader->SetVec3("directionalLight.Diffuse", m_DirectionalLight.Diffuse);
-    shader->SetVec3("directionalLight.Specular", m_DirectionalLight.Specular);
-    shader->SetVec3("directionalLight.Color", m_DirectionalLight.Color);
-
-    shader->SetVec3("spotLight.Position", viewPos);
-    shader->SetVec3("spotLight.Direction", front);
-    shader->SetVec3("spotLight.Ambient", spotLight.Ambient);
-    shader->SetVec3("spotLight.Diffuse", spotLight.Diffuse);
-    shader->SetVec3("spotLight.Specular", spotLight.Specular);
-    shader->SetFloat("spotLight.Constant", spotLight.Constant);
-    shader->SetFloat("spotLight.Linear", spotLight.Linear);
-    shader->SetFloat("spotLight.Quadratic", spotLight.Quadratic);
-    shader->SetFloat("spotLight.CutOff", spotLight.CutOff);
-    shader->SetFloat("spotLight.OuterCutOff", spotLight.OuterCutOff);
-    shader->SetBool("spotLight.Active", spotLight.Active);
-  }
+  Std140SpotLight spot;
+  PackStd140SpotLight(spotLight, viewPos, front, &spot);
+  m_LightingBlock.SetSpotLight(spot);
+
+  m_LightingBlock.SetViewerPosition(viewPos);
+  m_LightingBlock.Upload(mApplication->GetUploadRing());
+
+  UploadShininess(shininess);
 }
 
 void PhysicalLightHandle::AddObjectPointLight(const ObjectPointLight& obj, Transformation3D& trans)
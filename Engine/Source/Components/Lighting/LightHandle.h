@@ -23,57 +23,18 @@
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
 #include "Components/Kernel/Memory/Allocator.h"
+#include "Components/Lighting/LightTypes.h"
+#include "Components/Lighting/LightingBlock.h"
 #include "Components/Renderer/Objects/Object.h"
 #include "Components/Renderer/Shader/ShaderHandle.h"
 #include "Components/Renderer/Texture/TextureHandle.h"
 
-#define MAX_POINT_LIGHTS 10
+#define MAX_POINT_LIGHTS YEAGER_LIGHTING_BLOCK_POINT_LIGHTS
 
 namespace Yeager {
 
 class ApplicationCore;
 
-struct PointLight {
-  Vector3 Position = Vector3(0.0f);
-  float Constant = 1.0f;
-  float Linear = 0.09f;
-  float Quadratic = 0.032f;
-  Vector3 Ambient = Vector3(0.05f);
-  Vector3 Diffuse = Vector3(0.8f);
-  Vector3 Specular = Vector3(1.0f);
-  Vector3 Color = Vector3(1.0f);
-  bool Active = false;
-};
-
-struct DirectionalLight {
-  Vector3 Direction = Vector3(-0.2f, -1.0f, -0.3f);
-  Vector3 Ambient = Vector3(0.03f);
-  Vector3 Diffuse = Vector3(0.4f);
-  Vector3 Specular = Vector3(0.5f);
-  Vector3 Color = Vector3(1.0f);
-};
-
-struct Material {
-  float Shininess = 32.0f;
-};
-
-struct Viewer {
-  Vector3 Position = Vector3(0.0f);
-};
-
-struct SpotLight {
-  Vector3 Position = Vector3(0.0f);
-  Vector3 Direction = Vector3(0.0f);
-  float CutOff = glm::cos(glm::radians(12.5f));
-  float OuterCutOff = glm::cos(glm::radians(15.0f));
-  float Constant = 1;
-  float Linear = 0.09f;
-  float Quadratic = 0.032f;
-  Vector3 Ambient = Vector3(0.0f);
-  Vector3 Diffuse = Vector3(1.0f);
-  Vector3 Specular = Vector3(1.0f);
-  bool Active = true;
-};
 /**
  * TODO: Make this raw pointer into a smart pointer!
  */
@@ -100,7 +61,16 @@ class LightBaseHandle : public EditorEntity {
   /* Returns linked shaders, that are the shaders affected by the class lighting management */
   std::vector<Shader*>* GetLinkedShaders() { return &m_LinkedShader; }
 
+  /* Returns the uniform buffer block shared by the linked shaders */
+  LightingBlock* GetLightingBlock() { return &m_LightingBlock; }
+
  protected:
+  /** @brief Sets the material shininess to the linked shaders, only when the value changes, it cannot live in the block
+   * because the material struct holds the samplers */
+  void UploadShininess(float shininess);
+
+  LightingBlock m_LightingBlock;
+  float m_LastShininess = -1.0f;
   std::vector<PointLight> m_PointLights;
   std::vector<Shader*> m_LinkedShader;
   DirectionalLight m_DirectionalLight;
@@ -133,7 +103,8 @@ class PhysicalLightHandle : public LightBaseHandle {
   void AddObjectPointLight(const ObjectPointLight& obj);
   void AddObjectPointLight(ObjectPointLight* light, ObjectGeometryType::Enum type);
   void BuildShaderProps(Vector3 viewPos, Vector3 front, float shininess);
-  void DrawLightSources(float delta);
+  /** @brief Draws the objects of the point lights, the ones outside the frustum (when given) are skipped */
+  void DrawLightSources(float delta, const Frustum* frustum = YEAGER_NULLPTR);
 
   /* Returns the pointer to shader which is used to draw the light sources in the scene */
   Shader* GetDrawableShader() const { return m_DrawableShader; }
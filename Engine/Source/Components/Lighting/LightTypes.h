@@ -0,0 +1,71 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+/* The lights as the editor and the scene files see them, LightingBlock.h packs them into the std140 layout */
+
+struct PointLight {
+  Vector3 Position = Vector3(0.0f);
+  float Constant = 1.0f;
+  float Linear = 0.09f;
+  float Quadratic = 0.032f;
+  Vector3 Ambient = Vector3(0.05f);
+  Vector3 Diffuse = Vector3(0.8f);
+  Vector3 Specular = Vector3(1.0f);
+  Vector3 Color = Vector3(1.0f);
+  bool Active = false;
+};
+
+struct DirectionalLight {
+  Vector3 Direction = Vector3(-0.2f, -1.0f, -0.3f);
+  Vector3 Ambient = Vector3(0.03f);
+  Vector3 Diffuse = Vector3(0.4f);
+  Vector3 Specular = Vector3(0.5f);
+  Vector3 Color = Vector3(1.0f);
+};
+
+struct Material {
+  float Shininess = 32.0f;
+};
+
+struct Viewer {
+  Vector3 Position = Vector3(0.0f);
+};
+
+struct SpotLight {
+  Vector3 Position = Vector3(0.0f);
+  Vector3 Direction = Vector3(0.0f);
+  float CutOff = glm::cos(glm::radians(12.5f));
+  float OuterCutOff = glm::cos(glm::radians(15.0f));
+  float Constant = 1;
+  float Linear = 0.09f;
+  float Quadratic = 0.032f;
+  Vector3 Ambient = Vector3(0.0f);
+  Vector3 Diffuse = Vector3(1.0f);
+  Vector3 Specular = Vector3(1.0f);
+  bool Active = true;
+};
+
+}  // namespace Yeager
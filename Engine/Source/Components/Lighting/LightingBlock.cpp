@@ -0,0 +1,106 @@
+#include "LightingBlock.h"
+#include "Components/Lighting/LightTypes.h"
+#include "Components/Renderer/Shader/ShaderHandle.h"
+using namespace Yeager;
+
+void Yeager::PackStd140PointLight(const PointLight& light, Std140PointLight* out)
+{
+  out->Position = light.Position;
+  out->Constant = light.Constant;
+  out->Linear = light.Linear;
+  out->Quadratic = light.Quadratic;
+  out->Ambient = light.Ambient;
+  out->Diffuse = light.Diffuse;
+  out->Specular = light.Specular;
+  out->Active = light.Active ? 1 : 0;
+}
+
+void Yeager::PackStd140DirectionalLight(const DirectionalLight& light, Std140DirectionalLight* out)
+{
+  out->Direction = light.Direction;
+  out->Ambient = light.Ambient;
+  out->Diffuse = light.Diffuse;
+  out->Specular = light.Specular;
+  out->Color = light.Color;
+}
+
+void Yeager::PackStd140SpotLight(const SpotLight& light, const Vector3& position, const Vector3& direction,
+                                 Std140SpotLight* out)
+{
+  out->Position = position;
+  out->Direction = direction;
+  out->CutOff = light.CutOff;
+  out->OuterCutOff = light.OuterCutOff;
+  out->Constant = light.Constant;
+  out->Linear = light.Linear;
+  out->Quadratic = light.Quadratic;
+  out->Ambient = light.Ambient;
+  out->Diffuse = light.Diffuse;
+  out->Specular = light.Specular;
+  out->Active = light.Active ? 1 : 0;
+}
+
+void LightingBlock::LinkShader(Shader* shader)
+{
+  GLuint index = glGetUniformBlockIndex(shader->GetId(), YEAGER_LIGHTING_BLOCK_NAME);
+  if (index == GL_INVALID_INDEX)
+    return;
+
+  GLint size = 0;
+  GL_CALL(glGetActiveUniformBlockiv(shader->GetId(), index, GL_UNIFORM_BLOCK_DATA_SIZE, &size));
+  if (size != sizeof(Std140LightingBlock)) {
+    Yeager::Log(ERROR, "Shader {} lighting block have {} bytes, the engine expects {} bytes!", shader->GetName(), size,
+                sizeof(Std140LightingBlock));
+  }
+
+  GL_CALL(glUniformBlockBinding(shader->GetId(), index, YEAGER_LIGHTING_BLOCK_BINDING));
+}
+
+void LightingBlock::SetSpotLight(const Std140SpotLight& light)
+{
+  Assign(&mData.SpotLight, light);
+}
+
+void LightingBlock::SetDirectionalLight(const Std140DirectionalLight& light)
+{
+  Assign(&mData.DirectionalLight, light);
+}
+
+void LightingBlock::SetPointLight(Uint index, const Std140PointLight& light)
+{
+  if (index >= YEAGER_LIGHTING_BLOCK_POINT_LIGHTS) {
+    Yeager::LogDebug(WARNING, "Point light index {} is out of the lighting block bounds!", index);
+    return;
+  }
+  Assign(&mData.PointLights[index], light);
+}
+
+void LightingBlock::DisablePointLightsFrom(Uint index)
+{
+  for (Uint x = index; x < YEAGER_LIGHTING_BLOCK_POINT_LIGHTS; x++) {
+    if (mData.PointLights[x].Active != 0) {
+      mData.PointLights[x].Active = 0;
+      bDirty = true;
+    }
+  }
+}
+
+void LightingBlock::SetViewerPosition(const Vector3& position)
+{
+  Std140Viewer viewer;
+  viewer.Position = position;
+  Assign(&mData.Viewer, viewer);
+}
+
+void LightingBlock::Upload(UploadRing* ring)
+{
+  if (bDirty || !mRange.IsValid() || mRangeFrame != ring->GetFrameIndex()) {
+    mRange = ring->Upload(&mData, sizeof(Std140LightingBlock), ring->GetOffsetAlignment(GL_UNIFORM_BUFFER));
+    mRangeFrame = ring->GetFrameIndex();
+    bDirty = false;
+  }
+
+  /* Other light handles may share the binding point, so the range is always rebound */
+  GL_CALL(glBindBufferRange(GL_UNIFORM_BUFFER, YEAGER_LIGHTING_BLOCK_BINDING, mRange.Buffer, mRange.Offset,
+                            mRange.Size));
+}
@@ -0,0 +1,191 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "Components/Renderer/GL/UploadRing.h"
+
+/* Must match the binding and MAX_POINT_LIGHTS declared in the LightingBlock of the lighting shaders */
+#define YEAGER_LIGHTING_BLOCK_BINDING 0
+#define YEAGER_LIGHTING_BLOCK_NAME "LightingBlock"
+#define YEAGER_LIGHTING_BLOCK_POINT_LIGHTS 10
+
+namespace Yeager {
+
+class Shader;
+struct PointLight;
+struct DirectionalLight;
+struct SpotLight;
+
+/**
+ * The structs below mirror the std140 layout of the LightingBlock declared in the shaders. In std140 a vec3 is aligned
+ * to 16 bytes but only takes 12, so a scalar can be packed right after it, structs and arrays elements are rounded up
+ * to 16 bytes and bools take 4 bytes. The paddings are explicit so the static_asserts catch any mistake
+ */
+
+struct Std140PointLight {
+  Vector3 Position = YEAGER_ZERO_VECTOR3;
+  float Constant = 1.0f;
+  float Linear = 0.0f;
+  float Quadratic = 0.0f;
+  float Pad0[2] = {0.0f, 0.0f};
+  Vector3 Ambient = YEAGER_ZERO_VECTOR3;
+  float Pad1 = 0.0f;
+  Vector3 Diffuse = YEAGER_ZERO_VECTOR3;
+  float Pad2 = 0.0f;
+  Vector3 Specular = YEAGER_ZERO_VECTOR3;
+  int32_t Active = 0;
+};
+
+struct Std140DirectionalLight {
+  Vector3 Direction = YEAGER_ZERO_VECTOR3;
+  float Pad0 = 0.0f;
+  Vector3 Ambient = YEAGER_ZERO_VECTOR3;
+  float Pad1 = 0.0f;
+  Vector3 Diffuse = YEAGER_ZERO_VECTOR3;
+  float Pad2 = 0.0f;
+  Vector3 Specular = YEAGER_ZERO_VECTOR3;
+  float Pad3 = 0.0f;
+  Vector3 Color = YEAGER_ZERO_VECTOR3;
+  float Pad4 = 0.0f;
+};
+
+struct Std140SpotLight {
+  Vector3 Position = YEAGER_ZERO_VECTOR3;
+  float Pad0 = 0.0f;
+  Vector3 Direction = YEAGER_ZERO_VECTOR3;
+  float CutOff = 0.0f;
+  float OuterCutOff = 0.0f;
+  float Constant = 1.0f;
+  float Linear = 0.0f;
+  float Quadratic = 0.0f;
+  Vector3 Ambient = YEAGER_ZERO_VECTOR3;
+  float Pad1 = 0.0f;
+  Vector3 Diffuse = YEAGER_ZERO_VECTOR3;
+  float Pad2 = 0.0f;
+  Vector3 Specular = YEAGER_ZERO_VECTOR3;
+  int32_t Active = 0;
+};
+
+struct Std140Viewer {
+  Vector3 Position = YEAGER_ZERO_VECTOR3;
+  float Pad0 = 0.0f;
+};
+
+struct Std140LightingBlock {
+  Std140SpotLight SpotLight;
+  Std140DirectionalLight DirectionalLight;
+  Std140PointLight PointLights[YEAGER_LIGHTING_BLOCK_POINT_LIGHTS];
+  Std140Viewer Viewer;
+};
+
+static_assert(sizeof(Vector3) == 12, "The std140 packing expects a tightly packed vec3!");
+
+static_assert(offsetof(Std140PointLight, Position) == 0);
+static_assert(offsetof(Std140PointLight, Constant) == 12);
+static_assert(offsetof(Std140PointLight, Linear) == 16);
+static_assert(offsetof(Std140PointLight, Quadratic) == 20);
+static_assert(offsetof(Std140PointLight, Ambient) == 32);
+static_assert(offsetof(Std140PointLight, Diffuse) == 48);
+static_assert(offsetof(Std140PointLight, Specular) == 64);
+static_assert(offsetof(Std140PointLight, Active) == 76);
+static_assert(sizeof(Std140PointLight) == 80);
+
+static_assert(offsetof(Std140DirectionalLight, Direction) == 0);
+static_assert(offsetof(Std140DirectionalLight, Ambient) == 16);
+static_assert(offsetof(Std140DirectionalLight, Diffuse) == 32);
+static_assert(offsetof(Std140DirectionalLight, Specular) == 48);
+static_assert(offsetof(Std140DirectionalLight, Color) == 64);
+static_assert(sizeof(Std140DirectionalLight) == 80);
+
+static_assert(offsetof(Std140SpotLight, Position) == 0);
+static_assert(offsetof(Std140SpotLight, Direction) == 16);
+static_assert(offsetof(Std140SpotLight, CutOff) == 28);
+static_assert(offsetof(Std140SpotLight, OuterCutOff) == 32);
+static_assert(offsetof(Std140SpotLight, Constant) == 36);
+static_assert(offsetof(Std140SpotLight, Linear) == 40);
+static_assert(offsetof(Std140SpotLight, Quadratic) == 44);
+static_assert(offsetof(Std140SpotLight, Ambient) == 48);
+static_assert(offsetof(Std140SpotLight, Diffuse) == 64);
+static_assert(offsetof(Std140SpotLight, Specular) == 80);
+static_assert(offsetof(Std140SpotLight, Active) == 92);
+static_assert(sizeof(Std140SpotLight) == 96);
+
+static_assert(sizeof(Std140Viewer) == 16);
+
+static_assert(offsetof(Std140LightingBlock, SpotLight) == 0);
+static_assert(offsetof(Std140LightingBlock, DirectionalLight) == 96);
+static_assert(offsetof(Std140LightingBlock, PointLights) == 176);
+static_assert(offsetof(Std140LightingBlock, Viewer) == 976);
+static_assert(sizeof(Std140LightingBlock) == 992);
+
+/** @brief Functions that convert the engine lights structs into the std140 layout, pure CPU */
+extern void PackStd140PointLight(const PointLight& light, Std140PointLight* out);
+extern void PackStd140DirectionalLight(const DirectionalLight& light, Std140DirectionalLight* out);
+extern void PackStd140SpotLight(const SpotLight& light, const Vector3& position, const Vector3& direction,
+                                Std140SpotLight* out);
+
+/**
+ * @brief Keeps the lighting state shared by all the lighting shaders and places it in the upload ring. The CPU copy is
+ * compared against the new state every frame, and it is only copied again when something changed or when the range of
+ * the last frame was released back to the ring
+ */
+class LightingBlock {
+ public:
+  LightingBlock() = default;
+  LightingBlock(const LightingBlock&) = delete;
+  LightingBlock& operator=(const LightingBlock&) = delete;
+
+  /** @brief Binds the LightingBlock of the shader program to YEAGER_LIGHTING_BLOCK_BINDING, shaders without the block are ignored */
+  void LinkShader(Shader* shader);
+
+  void SetSpotLight(const Std140SpotLight& light);
+  void SetDirectionalLight(const Std140DirectionalLight& light);
+  void SetPointLight(Uint index, const Std140PointLight& light);
+  /** @brief Disables the point lights from the index given to the end of the array */
+  void DisablePointLightsFrom(Uint index);
+  void SetViewerPosition(const Vector3& position);
+
+  /** @brief Copies the block to the ring when dirty or from another frame, and binds its range to the binding point */
+  void Upload(UploadRing* ring);
+
+  YEAGER_NODISCARD bool IsDirty() const { return bDirty; }
+  YEAGER_NODISCARD const Std140LightingBlock& GetData() const { return mData; }
+
+ private:
+  template <typename T>
+  void Assign(T* dst, const T& src)
+  {
+    if (memcmp(dst, &src, sizeof(T)) != 0) {
+      *dst = src;
+      bDirty = true;
+    }
+  }
+
+  Std140LightingBlock mData;
+  RingAllocation mRange;
+  /* Frame of the ring the range was allocated in */
+  uint64_t mRangeFrame = 0;
+  bool bDirty = true;
+};
+
+}  // namespace Yeager
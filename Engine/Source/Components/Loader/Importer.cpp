@@ -2,8 +2,6 @@
 #include "Editor/UI/Explorer.h"
 #include "Main/Core/Application.h"
 
-#include "stb_image.h"
-
 using namespace Yeager;
 using namespace physx;
 
@@ -27,6 +25,7 @@ Vector3 Yeager::CalculateTriangleNormalFromPoints(Vector3 p1, Vector3 p2, Vector
 std::vector<physx::PxVec3> Yeager::ConvertYgVectors3ToPhysXVec3(const std::vector<Vector3>& vectors)
 {
   std::vector<physx::PxVec3> v;
+  v.reserve(vectors.size());
   for (const auto& vec : vectors) {
     v.push_back(physx::PxVec3(vec.x, vec.y, vec.z));
   }
@@ -55,16 +54,77 @@ ObjectModelData Importer::Import(Cchar path, const ObjectCreationConfiguration c
   m_CreationConfiguration = configuration;
   m_ImageFlip = flip_image;
   ObjectModelData data;
+  data.SuccessfulLoaded = ReadModel(path, assimp_flags, &data);
+  return data;
+}
+
+std::optional<MeshCacheEntry> Importer::RequestMeshCache(Cchar path, Uint assimp_flags, MeshCacheKind::Enum kind)
+{
+  if (m_Application == YEAGER_NULLPTR || m_Application->GetScene() == YEAGER_NULLPTR ||
+      m_Application->GetScene()->GetContext()->ProjectFolderPath == YEAGER_NULL_LITERAL)
+    return std::nullopt;
+
+  const String textureFolder =
+      m_CreationConfiguration.TextureFolder.Valid ? m_CreationConfiguration.TextureFolder.path : YEAGER_NULL_LITERAL;
+  std::optional<uint64_t> key = MeshCache::ComputeKey(path, assimp_flags, kind, textureFolder);
+  if (!key.has_value())
+    return std::nullopt;
+
+  MeshCacheEntry entry;
+  entry.Key = key.value();
+  entry.Path = MeshCache::BuildCachePath(m_Application->GetScene()->GetObjectCacheFolderPath(), entry.Key);
+  return entry;
+}
+
+/* Shared by the static and animated models, the cache and the assimp node processing are the only differences */
+template <typename ModelData, typename ProcessFun>
+static bool ReadModelWithCache(Cchar path, Uint assimp_flags, ModelData* data, const std::optional<MeshCacheEntry>& cache,
+                               const MeshCacheTextureLoader& loader, ProcessFun&& process)
+{
+  const auto start = std::chrono::steady_clock::now();
+  auto elapsed = [&start]() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  if (cache.has_value() && MeshCache::Load(cache.value(), data, loader)) {
+    Yeager::Log(INFO, "Model {} loaded from the mesh cache in {:.2f} ms", path, elapsed());
+    return true;
+  }
+
   Assimp::Importer imp;
   const aiScene* scene = imp.ReadFile(path, assimp_flags);
   if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
     Yeager::Log(ERROR, "Cannot load imported model! Path {}, Error {}", path, imp.GetErrorString());
-    return data;
+    return false;
   }
+  process(scene->mRootNode, scene, data);
+  Yeager::Log(INFO, "Model {} imported with assimp in {:.2f} ms", path, elapsed());
+
+  if (cache.has_value())
+    MeshCache::Write(cache.value(), *data);
+  return true;
+}
+
+bool Importer::ReadModel(Cchar path, Uint assimp_flags, ObjectModelData* data)
+{
   m_FullPath = path;
-  ProcessNode(scene->mRootNode, scene, &data);
-  data.SuccessfulLoaded = true;
-  return data;
+  data->CompactVertices = m_CreationConfiguration.CompactVertices;
+  return ReadModelWithCache(
+      path, assimp_flags, data, RequestMeshCache(path, assimp_flags, MeshCacheKind::eSTATIC),
+      [this, data](const String& texture, const String& type) { return LoadTextureFromPath(texture, type, data); },
+      [this](aiNode* node, const aiScene* scene, ObjectModelData* model) { ProcessNode(node, scene, model); });
+}
+
+bool Importer::ReadAnimatedModel(Cchar path, Uint assimp_flags, AnimatedObjectModelData* data)
+{
+  m_FullPath = path;
+  data->CompactVertices = m_CreationConfiguration.CompactVertices;
+  return ReadModelWithCache(
+      path, assimp_flags, data, RequestMeshCache(path, assimp_flags, MeshCacheKind::eANIMATED),
+      [this, data](const String& texture, const String& type) { return LoadTextureFromPath(texture, type, data); },
+      [this](aiNode* node, const aiScene* scene, AnimatedObjectModelData* model) {
+        ProcessAnimatedNode(node, scene, model);
+      });
 }
 
 ObjectModelData Importer::ImportToPhysX(Cchar path, physx::PxRigidActor* actor, bool flip_image, Uint assimp_flags)
@@ -98,9 +158,9 @@ ObjectMeshData Importer::ProcessPhysXMesh(physx::PxRigidActor* actor, aiMesh* me
                                           ObjectModelData* data)
 {
   std::vector<ObjectVertexData> vertices;
-  std::vector<physx::PxVec3> PhysxVertices;
   std::vector<GLuint> indices;
   std::vector<MaterialTexture2D*> textures;
+  AABB bounds;
 
   for (Uint x = 0; x < mesh->mNumVertices; x++) {
     ObjectVertexData vertex;
@@ -128,7 +188,7 @@ ObjectMeshData Importer::ProcessPhysXMesh(physx::PxRigidActor* actor, aiMesh* me
       vertex.TextureCoords = Vector2(0.0f, 0.0f);
     }
     vertices.push_back(vertex);
-    PhysxVertices.push_back(Vector3ToPxVec3(vertex.Position));
+    bounds.Expand(vertex.Position);
   }
 
   for (Uint x = 0; x < mesh->mNumFaces; x++) {
@@ -154,16 +214,20 @@ ObjectMeshData Importer::ProcessPhysXMesh(physx::PxRigidActor* actor, aiMesh* me
         LoadMaterialTexture(material, aiTextureType_DIFFUSE_ROUGHNESS, "texture_roughness", data);
     textures.insert(textures.end(), roughnessMaps.begin(), roughnessMaps.end());
   }
+  /* PhysX reads the positions straight from the vertices, the stride steps over the other attributes */
+  static_assert(sizeof(Vector3) == sizeof(PxVec3), "Vector3 must have the layout of PxVec3");
   PxMaterial* material = m_Application->GetPhysXHandle()->GetPxPhysics()->createMaterial(1.0f, 1.0f, 1.0f);
   PxShape* shape = m_Application->GetPhysXHandle()->GetPxPhysics()->createShape(
       PxTriangleMeshGeometry(m_Application->GetPhysXHandle()->GetGeometryHandle()->CreateTriangleMesh(
-          mesh->mNumVertices, mesh->mNumFaces, sizeof(PxVec3), sizeof(GLuint) * 3, &PhysxVertices[0],
-          (PxU32*)&indices[0])),
+          mesh->mNumVertices, indices.size() / 3, sizeof(ObjectVertexData), sizeof(GLuint) * 3,
+          reinterpret_cast<const PxVec3*>(&vertices[0].Position), reinterpret_cast<const PxU32*>(indices.data()))),
       *material);
   actor->attachShape(*shape);
   shape->release();
 
-  return ObjectMeshData(indices, vertices, textures);
+  ObjectMeshData meshData(indices, vertices, textures);
+  meshData.Bounds = bounds;
+  return meshData;
 }
 
 void Importer::ProcessNode(aiNode* node, const aiScene* scene, ObjectModelData* data)
@@ -183,6 +247,9 @@ ObjectMeshData Importer::ProcessMesh(aiMesh* mesh, const aiScene* scene, ObjectM
   std::vector<ObjectVertexData> vertices;
   std::vector<GLuint> indices;
   std::vector<MaterialTexture2D*> textures;
+  AABB bounds;
+  vertices.reserve(mesh->mNumVertices);
+  indices.reserve(static_cast<std::size_t>(mesh->mNumFaces) * 3);
 
   for (Uint x = 0; x < mesh->mNumVertices; x++) {
     ObjectVertexData vertex;
@@ -210,6 +277,7 @@ ObjectMeshData Importer::ProcessMesh(aiMesh* mesh, const aiScene* scene, ObjectM
       vertex.TextureCoords = Vector2(0.0f, 0.0f);
     }
     vertices.push_back(vertex);
+    bounds.Expand(vertex.Position);
   }
 
   for (Uint x = 0; x < mesh->mNumFaces; x++) {
@@ -236,7 +304,18 @@ ObjectMeshData Importer::ProcessMesh(aiMesh* mesh, const aiScene* scene, ObjectM
     textures.insert(textures.end(), roughnessMaps.begin(), roughnessMaps.end());
   }
 
-  return ObjectMeshData(indices, vertices, textures);
+  LogMeshOptimization(mesh, OptimizeMesh(vertices, indices));
+
+  ObjectMeshData meshData(indices, vertices, textures);
+  meshData.Bounds = bounds;
+  return meshData;
+}
+
+void Importer::LogMeshOptimization(const aiMesh* mesh, const MeshOptimizationStatistics& stats)
+{
+  Yeager::LogDebug(INFO, "Optimized mesh {} vertices {} -> {}, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+                   mesh->mName.C_Str(), stats.VerticesBefore, stats.VerticesAfter, stats.CacheBefore.ACMR,
+                   stats.CacheAfter.ACMR, stats.CacheBefore.ATVR, stats.CacheAfter.ATVR);
 }
 
 std::vector<MaterialTexture2D*> Importer::LoadMaterialTexture(aiMaterial* material, aiTextureType type, String typeName,
@@ -245,7 +324,6 @@ std::vector<MaterialTexture2D*> Importer::LoadMaterialTexture(aiMaterial* materi
   std::vector<MaterialTexture2D*> textures;
 
   for (Uint x = 0; x < material->GetTextureCount(type); x++) {
-    bool skip = false;
     aiString str;
     material->GetTexture(type, x, &str);
     String textureString = String(str.C_Str());
@@ -268,55 +346,61 @@ std::vector<MaterialTexture2D*> Importer::LoadMaterialTexture(aiMaterial* materi
 
       // Texture path in the mtl file is a complete path, we just assign the complete path to the compare_path without adding to it
       Yeager::ValidatesPath(comparePath + textureString) ? comparePath += textureString : comparePath = textureString;
-
-      // Checks if the texture is already loaded to the model, if so, it skips the loading, saving a lot of time
-    }
-    for (Uint y = 0; y < data->TexturesLoaded.size(); y++) {
-      if (std::strcmp(data->TexturesLoaded[y]->first.GetTextureDataHandle()->Path.data(), comparePath.data()) == 0) {
-        MaterialTexture2D* rt = &data->TexturesLoaded[y]->first;
-        textures.push_back(rt);
-        skip = true;
-        break;
-      }
-    }
-
-    if (!skip) {
-
-      auto tex = BaseAllocator::MakeSharedPtr<std::pair<MaterialTexture2D, STBIDataOutput*>>();
-
-      /* If the texture loading have been called in a thread without the openGL context loaded intro to it, the texture id will ALWAYS be 0, meaning it wont load, 
-        we check if the current thread is with the openGL context, if not, the boolean incompleteID is set to true, and the texture loading is done after the thread is finished! */
-      if (!m_Application->GetWindow()->CheckIfOpenGLContext()) {
-        tex->first.GetTextureDataHandle()->ImcompletedID = true;
-        tex->second = LoadStbiDataOutput(comparePath, m_ImageFlip);
-      } else {
-        tex->first.GenerateFromFile(comparePath, m_ImageFlip);
-      }
-
-      tex->first.SetName(typeName.c_str());
-      MaterialTexture2D* rt = &tex->first;
-      textures.push_back(rt);
-      data->TexturesLoaded.push_back(tex);
     }
+    textures.push_back(LoadTextureFromPath(comparePath, typeName, data));
   }
   return textures;
 }
 
-STBIDataOutput* Importer::LoadStbiDataOutput(String path, bool flip)
+MaterialTexture2D* Importer::LoadTextureFromPath(const String& path, const String& typeName, CommonModelData* data)
 {
-  STBIDataOutput* output = BaseAllocator::Construct<STBIDataOutput>();
-
-  stbi_set_flip_vertically_on_load(flip);
-  ValidatesPath(path);
-  output->Data = stbi_load(path.c_str(), &output->Width, &output->Height, &output->NrComponents, 0);
-  output->OriginalPath = path;
-  output->Flip = flip;
-
-  if (output->Data == YEAGER_NULLPTR) {
-    Yeager::Log(ERROR, "Cannot load data to STBIDataOutput! Path: {}, Reason {}", path, stbi_failure_reason());
+  const auto loaded = data->TexturesByPath.find(path);
+  if (loaded != data->TexturesByPath.end())
+    return loaded->second;
+
+  /* The image is decoded on the job system and uploaded over the next frames, so neither the import nor the frame
+  that finishes it waits for the textures. Until then the texture shows a placeholder, and its path is already set so
+  the mesh cache can record it. Images already loaded by another model are shared instead */
+  const TextureCacheSettings settings = TextureSettingsOfType(typeName, m_ImageFlip);
+  std::shared_ptr<MaterialTexture2D> texture;
+  if (m_Application == YEAGER_NULLPTR) {
+    /* Imported without an application (the mesh cache check), only the path and the type are recorded */
+    texture = std::make_shared<MaterialTexture2D>();
+    texture->SetName(typeName.c_str());
+    texture->GetTextureDataHandle()->Path = path;
+    data->TexturesByPath[path] = texture.get();
+    data->TexturesLoaded.push_back(texture);
+    return texture.get();
   }
 
-  return output;
+  texture = m_Application->GetTextureRegistry()->Acquire(
+      path, settings, [this, &path, &typeName, &settings](const std::shared_ptr<MaterialTexture2D>& created) {
+        created->SetName(typeName.c_str());
+        TextureStreamRequest request;
+        request.Target = created;
+        request.Path = path;
+        request.Settings = settings;
+        if (m_Application->GetScene()->GetContext()->ProjectFolderPath != YEAGER_NULL_LITERAL)
+          request.CacheFolder = m_Application->GetScene()->GetTextureCacheFolderPath();
+        m_Application->GetTextureStreamer()->Request(request);
+      });
+
+  data->TexturesByPath[path] = texture.get();
+  // Two paths of the model can still lead to the same image, only checked once per path
+  if (std::find(data->TexturesLoaded.begin(), data->TexturesLoaded.end(), texture) == data->TexturesLoaded.end())
+    data->TexturesLoaded.push_back(texture);
+  return texture.get();
+}
+
+TextureCacheSettings Importer::TextureSettingsOfType(const String& typeName, bool flip)
+{
+  TextureCacheSettings settings;
+  /* Only colors are stored in sRGB, and normal or height maps are directions and distances that BC1 would bend */
+  const bool data = typeName == "texture_normal" || typeName == "texture_height";
+  settings.bSRGB = !data && typeName != "texture_metallic" && typeName != "texture_roughness";
+  settings.bCompress = !data;
+  settings.bFlipped = flip;
+  return settings;
 }
 
 AnimatedObjectModelData Importer::ImportAnimated(Cchar path, const ObjectCreationConfiguration configuration,
@@ -325,15 +409,7 @@ AnimatedObjectModelData Importer::ImportAnimated(Cchar path, const ObjectCreatio
   m_CreationConfiguration = configuration;
   m_ImageFlip = flip_image;
   AnimatedObjectModelData data;
-  Assimp::Importer imp;
-  const aiScene* scene = imp.ReadFile(path, assimp_flags);
-  if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-    Yeager::Log(ERROR, "Cannot load imported model! Path {}, Error {}", path, imp.GetErrorString());
-    return data;
-  }
-  m_FullPath = path;
-  ProcessAnimatedNode(scene->mRootNode, scene, &data);
-  data.SuccessfulLoaded = true;
+  data.SuccessfulLoaded = ReadAnimatedModel(path, assimp_flags, &data);
   return data;
 }
 
@@ -354,6 +430,9 @@ AnimatedObjectMeshData Importer::ProcessAnimatedMesh(aiMesh* mesh, const aiScene
   std::vector<AnimatedVertexData> vertices;
   std::vector<GLuint> indices;
   std::vector<MaterialTexture2D*> textures;
+  AABB bounds;
+  vertices.reserve(mesh->mNumVertices);
+  indices.reserve(static_cast<std::size_t>(mesh->mNumFaces) * 3);
 
   for (Uint x = 0; x < mesh->mNumVertices; x++) {
     AnimatedVertexData vertex;
@@ -379,6 +458,7 @@ AnimatedObjectMeshData Importer::ProcessAnimatedMesh(aiMesh* mesh, const aiScene
       vertex.TextureCoords = Vector2(0.0f, 0.0f);
     }
     vertices.push_back(vertex);
+    bounds.Expand(vertex.Position);
   }
 
   for (Uint x = 0; x < mesh->mNumFaces; x++) {
@@ -404,8 +484,12 @@ AnimatedObjectMeshData Importer::ProcessAnimatedMesh(aiMesh* mesh, const aiScene
     textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
   }
   ExtractBoneWeightForVertices(vertices, mesh, scene, data);
+  /* After the bone weights, they are looked up by the original vertex ids */
+  LogMeshOptimization(mesh, OptimizeMesh(vertices, indices));
 
-  return AnimatedObjectMeshData(indices, vertices, textures);
+  AnimatedObjectMeshData meshData(indices, vertices, textures);
+  meshData.Bounds = bounds;
+  return meshData;
 }
 
 void Importer::SetVertexBoneDataToDefault(AnimatedVertexData& vertex)
@@ -466,7 +550,11 @@ ImporterThreaded::ImporterThreaded(String source, ApplicationCore* app) : Import
   Yeager::Log(INFO, "Intialize Thread Importer from {}", source.c_str());
 }
 
-ImporterThreaded::~ImporterThreaded() {}
+ImporterThreaded::~ImporterThreaded()
+{
+  /* The import job writes into this importer, it cannot be destroyed while the job is running */
+  WaitThread();
+}
 
 void ImporterThreaded::ThreadImport(Cchar path, const ObjectCreationConfiguration configuration, bool flip_image,
                                     Uint assimp_flags)
@@ -476,22 +564,17 @@ void ImporterThreaded::ThreadImport(Cchar path, const ObjectCreationConfiguratio
   m_ImageFlip = flip_image;
 
   m_FullPath = path;
-  m_Thread = std::thread([this, path, assimp_flags] {
-    IntervalElapsedTimeManager::StaticStartTimeInterval("Importer_Thread", m_Thread.get_id());
-    Assimp::Importer imp;
-    m_Scene = const_cast<aiScene*>(imp.ReadFile(m_FullPath.c_str(), assimp_flags));
-
-    if (!m_Scene || m_Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !m_Scene->mRootNode) {
-      Yeager::Log(ERROR, "Cannot load imported model! m_FullPath {}, Error {}", m_FullPath, imp.GetErrorString());
-      return;
-    }
-    ProcessNode(m_Scene->mRootNode, m_Scene, &m_Data);
-    Yeager::Log(INFO, "Thread import has finished");
-    m_Data.SuccessfulLoaded = true;
-    m_ThreadFinished = true;
-    m_PromiseObject.set_value(m_Data);
-    IntervalElapsedTimeManager::StaticEndTimeInterval("Importer_Thread", m_Thread.get_id());
-  });
+  JobSystem::Run(
+      [this, assimp_flags] {
+        IntervalElapsedTimeManager::StaticStartTimeInterval("Importer_Thread", std::this_thread::get_id());
+        /* The promise is fulfilled even on failure, the object checks SuccessfulLoaded instead of waiting forever */
+        m_Data.SuccessfulLoaded = ReadModel(m_FullPath.c_str(), assimp_flags, &m_Data);
+        Yeager::Log(INFO, "Thread import has finished");
+        m_PromiseObject.set_value(m_Data);
+        m_ThreadFinished = true;
+        IntervalElapsedTimeManager::StaticEndTimeInterval("Importer_Thread", std::this_thread::get_id());
+      },
+      &m_Job, JobPriority::eBACKGROUND);
 }
 
 ImporterThreadedAnimated::ImporterThreadedAnimated(String source, ApplicationCore* app) : ImporterThreaded(source, app)
@@ -499,7 +582,11 @@ ImporterThreadedAnimated::ImporterThreadedAnimated(String source, ApplicationCor
   m_FutureObject = m_PromiseObject.get_future();
   Yeager::Log(INFO, "Intialize Thread Importer from {}", source.c_str());
 }
-ImporterThreadedAnimated::~ImporterThreadedAnimated() {}
+ImporterThreadedAnimated::~ImporterThreadedAnimated()
+{
+  /* Members of this class are destroyed before the base destructor waits, wait here as well */
+  WaitThread();
+}
 
 void ImporterThreadedAnimated::ThreadImport(Cchar path, const ObjectCreationConfiguration configuration,
                                             bool flip_image, Uint assimp_flags)
@@ -507,22 +594,17 @@ void ImporterThreadedAnimated::ThreadImport(Cchar path, const ObjectCreationConf
   m_CreationConfiguration = configuration;
   m_ImageFlip = flip_image;
   m_FullPath = path;
-  m_Thread = std::thread([this, path, assimp_flags] {
-    IntervalElapsedTimeManager::StaticStartTimeInterval("Importer_Thread", m_Thread.get_id());
-    Assimp::Importer imp;
-    m_Scene = const_cast<aiScene*>(imp.ReadFile(m_FullPath.c_str(), assimp_flags));
-
-    if (!m_Scene || m_Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !m_Scene->mRootNode) {
-      Yeager::Log(ERROR, "Cannot load imported model! m_FullPath {}, Error {}", m_FullPath, imp.GetErrorString());
-      return;
-    }
-    ProcessAnimatedNode(m_Scene->mRootNode, m_Scene, &m_Data);
-    Yeager::Log(INFO, "Thread import has finished");
-    m_Data.SuccessfulLoaded = true;
-    m_ThreadFinished = true;
-    m_PromiseObject.set_value(m_Data);
-    IntervalElapsedTimeManager::StaticEndTimeInterval("Importer_Thread", m_Thread.get_id());
-  });
+  JobSystem::Run(
+      [this, assimp_flags] {
+        IntervalElapsedTimeManager::StaticStartTimeInterval("Importer_Thread", std::this_thread::get_id());
+        /* The promise is fulfilled even on failure, the object checks SuccessfulLoaded instead of waiting forever */
+        m_Data.SuccessfulLoaded = ReadAnimatedModel(m_FullPath.c_str(), assimp_flags, &m_Data);
+        Yeager::Log(INFO, "Thread import has finished");
+        m_PromiseObject.set_value(m_Data);
+        m_ThreadFinished = true;
+        IntervalElapsedTimeManager::StaticEndTimeInterval("Importer_Thread", std::this_thread::get_id());
+      },
+      &m_Job, JobPriority::eBACKGROUND);
 }
 
 bool ImporterThreaded::IsThreadFinish()
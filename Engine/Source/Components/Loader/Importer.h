@@ -21,6 +21,9 @@
 #include "Common/Utils/Common.h"
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
+#include "Components/Kernel/Caching/MeshCache.h"
+#include "Components/Kernel/Process/JobSystem.h"
+#include "Components/Loader/MeshOptimizer.h"
 #include "Components/Physics/PhysXHandle.h"
 #include "Components/Renderer/Objects/Object.h"
 #include "Components/Renderer/Texture/TextureHandle.h"
@@ -77,11 +80,24 @@ class Importer {
   static Uint GetModelsCount() { return m_ImportedModelsCount; };
 
  protected:
+  /**
+   * @brief Fills the data from the mesh cache when the source file did not change since the last import, otherwise parses
+   * the file with assimp and writes the cache for the next time. Returns false if the model cannot be loaded
+   */
+  bool ReadModel(Cchar path, Uint assimp_flags, ObjectModelData* data);
+  bool ReadAnimatedModel(Cchar path, Uint assimp_flags, AnimatedObjectModelData* data);
+  /** @brief Cache file of the model inside the project cache folder, nullopt when there is no project to cache into */
+  std::optional<MeshCacheEntry> RequestMeshCache(Cchar path, Uint assimp_flags, MeshCacheKind::Enum kind);
+
   void ProcessNode(aiNode* node, const aiScene* scene, ObjectModelData* data);
   ObjectMeshData ProcessMesh(aiMesh* mesh, const aiScene* scene, ObjectModelData* data);
+  void LogMeshOptimization(const aiMesh* mesh, const MeshOptimizationStatistics& stats);
   std::vector<MaterialTexture2D*> LoadMaterialTexture(aiMaterial* material, aiTextureType type, String typeName,
                                                       CommonModelData* data);
-  STBIDataOutput* LoadStbiDataOutput(String path, bool flip = false);
+  /** @brief Returns the texture of the path, taken from the texture registry the first time the model uses it */
+  MaterialTexture2D* LoadTextureFromPath(const String& path, const String& typeName, CommonModelData* data);
+  /** @brief Streaming settings of the texture from its material slot, data textures are not filtered as colors */
+  static TextureCacheSettings TextureSettingsOfType(const String& typeName, bool flip);
 
   void ProcessAnimatedNode(aiNode* node, const aiScene* scene, AnimatedObjectModelData* data);
   AnimatedObjectMeshData ProcessAnimatedMesh(aiMesh* mesh, const aiScene* scene, AnimatedObjectModelData* data);
@@ -109,15 +125,15 @@ class ImporterThreaded : public Importer {
   virtual void ThreadImport(Cchar path, const ObjectCreationConfiguration configuration = ObjectCreationConfiguration(),
                             bool flip_image = false, Uint assimp_flags = YEAGER_ASSIMP_DEFAULT_FLAGS);
   bool IsThreadFinish();
-  std::thread* GetThreadPtr() { return &m_Thread; }
+  /** @brief Blocks until the import job is finished, the calling thread executes other pending jobs meanwhile */
+  void WaitThread() { JobSystem::Wait(&m_Job); }
   ObjectModelData GetValue() { return m_FutureObject.get(); }
 
  protected:
   std::promise<ObjectModelData> m_PromiseObject;
   std::future<ObjectModelData> m_FutureObject;
   std::atomic<bool> m_ThreadFinished = false;
-  std::thread m_Thread;
-  aiScene* m_Scene = YEAGER_NULLPTR;
+  JobCounter m_Job;
   ObjectModelData m_Data;
 };
 
@@ -0,0 +1,323 @@
+#include "MeshOptimizer.h"
+
+#include <cfloat>
+#include <cmath>
+using namespace Yeager;
+
+/* FIFO post transform cache simulated with timestamps, a vertex is cached while less than cacheSize misses happened since it was loaded */
+struct FIFOCacheSimulation {
+  FIFOCacheSimulation(std::size_t vertexCount, Uint cacheSize) : Timestamps(vertexCount, 0), CacheSize(cacheSize) {}
+
+  /* Returns 1 when the vertex had to be transformed */
+  Uint Fetch(GLuint vertex)
+  {
+    if (Timestamp - Timestamps[vertex] > CacheSize) {
+      Timestamps[vertex] = Timestamp++;
+      return 1;
+    }
+    return 0;
+  }
+
+  void Flush() { Timestamp += CacheSize + 1; }
+
+  std::vector<Uint> Timestamps;
+  Uint Timestamp = 0;
+  Uint CacheSize = 0;
+};
+
+VertexCacheStatistics Yeager::AnalyzeVertexCache(const std::vector<GLuint>& indices, std::size_t vertexCount,
+                                                 Uint cacheSize)
+{
+  VertexCacheStatistics stats;
+  if (indices.empty() || vertexCount == 0)
+    return stats;
+
+  FIFOCacheSimulation cache(vertexCount, cacheSize);
+  /* Starts far enough so no vertex is seen as cached */
+  cache.Flush();
+  std::vector<bool> used(vertexCount, false);
+  Uint unique = 0;
+  for (GLuint index : indices) {
+    stats.VerticesTransformed += cache.Fetch(index);
+    if (!used[index]) {
+      used[index] = true;
+      unique++;
+    }
+  }
+
+  stats.ACMR = static_cast<float>(stats.VerticesTransformed) / static_cast<float>(indices.size() / 3);
+  stats.ATVR = static_cast<float>(stats.VerticesTransformed) / static_cast<float>(unique);
+  return stats;
+}
+
+/* Scoring constants from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation" */
+static YEAGER_CONSTEXPR float sForsythCacheDecayPower = 1.5f;
+static YEAGER_CONSTEXPR float sForsythLastTriangleScore = 0.75f;
+static YEAGER_CONSTEXPR float sForsythValenceBoostScale = 2.0f;
+static YEAGER_CONSTEXPR float sForsythValenceBoostPower = 0.5f;
+
+static float ForsythVertexScore(int cachePosition, Uint remainingTriangles, Uint cacheSize)
+{
+  /* No triangle left to use this vertex */
+  if (remainingTriangles == 0)
+    return -1.0f;
+
+  float score = 0.0f;
+  if (cachePosition >= 0) {
+    if (cachePosition < 3) {
+      /* Used by the last triangle, gets a fixed score so the next one does not simply reuse the same edge */
+      score = sForsythLastTriangleScore;
+    } else {
+      const float scaler = 1.0f / static_cast<float>(cacheSize - 3);
+      score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, sForsythCacheDecayPower);
+    }
+  }
+
+  /* Vertices with few triangles left are boosted, finishing them avoids coming back to them later */
+  score += sForsythValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -sForsythValenceBoostPower);
+  return score;
+}
+
+void Yeager::OptimizeVertexCache(std::vector<GLuint>& indices, std::size_t vertexCount, Uint cacheSize)
+{
+  const std::size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0 || vertexCount == 0)
+    return;
+  cacheSize = std::max<Uint>(cacheSize, 4);
+
+  /* Adjacency, the triangles of each vertex in a flat array, the active ones are kept at the front of each slice */
+  std::vector<Uint> remaining(vertexCount, 0);
+  for (GLuint index : indices)
+    remaining[index]++;
+
+  std::vector<Uint> adjacencyOffsets(vertexCount + 1, 0);
+  for (std::size_t x = 0; x < vertexCount; x++)
+    adjacencyOffsets[x + 1] = adjacencyOffsets[x] + remaining[x];
+
+  std::vector<Uint> adjacency(indices.size());
+  {
+    std::vector<Uint> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (std::size_t x = 0; x < indices.size(); x++)
+      adjacency[fill[indices[x]]++] = static_cast<Uint>(x / 3);
+  }
+
+  std::vector<int> cachePositions(vertexCount, -1);
+  std::vector<float> vertexScores(vertexCount);
+  for (std::size_t x = 0; x < vertexCount; x++)
+    vertexScores[x] = ForsythVertexScore(-1, remaining[x], cacheSize);
+
+  std::vector<float> triangleScores(triangleCount);
+  std::vector<bool> triangleEmitted(triangleCount, false);
+  for (std::size_t x = 0; x < triangleCount; x++)
+    triangleScores[x] = vertexScores[indices[x * 3]] + vertexScores[indices[x * 3 + 1]] +
+                        vertexScores[indices[x * 3 + 2]];
+
+  std::vector<GLuint> output;
+  output.reserve(indices.size());
+
+  /* LRU cache, three more slots so the vertices pushed out by the last triangle get their score updated */
+  std::vector<GLuint> cache;
+  std::vector<GLuint> nextCache;
+  cache.reserve(cacheSize + 3);
+  nextCache.reserve(cacheSize + 3);
+
+  Uint bestTriangle = static_cast<Uint>(
+      std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+  /* Dead ends (nothing in the cache has triangles left) restart next to the vertices emitted most recently, like the
+     dead-end stack of Tipsy, and only when none of them has triangles left from the first triangle not emitted yet. The
+     stack is popped and the cursor only moves forward, so the restarts cost linear time over the whole mesh */
+  std::vector<GLuint> deadEndStack;
+  deadEndStack.reserve(indices.size());
+  std::size_t deadEndCursor = 0;
+
+  for (std::size_t emitted = 0; emitted < triangleCount; emitted++) {
+    while (bestTriangle == UINT32_MAX && !deadEndStack.empty()) {
+      const GLuint vertex = deadEndStack.back();
+      deadEndStack.pop_back();
+      float bestScore = -FLT_MAX;
+      for (Uint x = 0; x < remaining[vertex]; x++) {
+        const Uint triangle = adjacency[adjacencyOffsets[vertex] + x];
+        if (triangleScores[triangle] > bestScore) {
+          bestScore = triangleScores[triangle];
+          bestTriangle = triangle;
+        }
+      }
+    }
+    if (bestTriangle == UINT32_MAX) {
+      while (triangleEmitted[deadEndCursor])
+        deadEndCursor++;
+      bestTriangle = static_cast<Uint>(deadEndCursor);
+    }
+
+    triangleEmitted[bestTriangle] = true;
+    nextCache.clear();
+    for (Uint corner = 0; corner < 3; corner++) {
+      const GLuint vertex = indices[bestTriangle * 3 + corner];
+      output.push_back(vertex);
+      nextCache.push_back(vertex);
+      deadEndStack.push_back(vertex);
+
+      /* Moves the emitted triangle past the active part of the vertex slice */
+      Uint* begin = &adjacency[adjacencyOffsets[vertex]];
+      Uint* last = begin + remaining[vertex] - 1;
+      std::swap(*std::find(begin, last + 1, bestTriangle), *last);
+      remaining[vertex]--;
+    }
+
+    for (GLuint vertex : cache) {
+      if (vertex != nextCache[0] && vertex != nextCache[1] && vertex != nextCache[2])
+        nextCache.push_back(vertex);
+    }
+    std::swap(cache, nextCache);
+
+    /* Rescores every vertex that moved inside or fell out of the cache, and the triangles that use them */
+    for (std::size_t position = 0; position < cache.size(); position++) {
+      const GLuint vertex = cache[position];
+      cachePositions[vertex] = position < cacheSize ? static_cast<int>(position) : -1;
+      const float score = ForsythVertexScore(cachePositions[vertex], remaining[vertex], cacheSize);
+      const float delta = score - vertexScores[vertex];
+      vertexScores[vertex] = score;
+      for (Uint x = 0; x < remaining[vertex]; x++)
+        triangleScores[adjacency[adjacencyOffsets[vertex] + x]] += delta;
+    }
+    if (cache.size() > cacheSize)
+      cache.resize(cacheSize);
+
+    /* The next triangle is the best one touching the cache */
+    bestTriangle = UINT32_MAX;
+    float bestScore = -FLT_MAX;
+    for (GLuint vertex : cache) {
+      for (Uint x = 0; x < remaining[vertex]; x++) {
+        const Uint triangle = adjacency[adjacencyOffsets[vertex] + x];
+        if (triangleScores[triangle] > bestScore) {
+          bestScore = triangleScores[triangle];
+          bestTriangle = triangle;
+        }
+      }
+    }
+  }
+
+  indices = std::move(output);
+}
+
+void Yeager::OptimizeOverdraw(std::vector<GLuint>& indices, const unsigned char* positions, std::size_t vertexCount,
+                              std::size_t stride, float threshold)
+{
+  const std::size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0 || vertexCount == 0)
+    return;
+
+  /* Hard boundaries, the triangles where every vertex missed the cache, the cache order already restarted there */
+  std::vector<std::size_t> hardBoundaries;
+  {
+    FIFOCacheSimulation cache(vertexCount, YEAGER_MESH_ANALYZE_CACHE_SIZE);
+    cache.Flush();
+    for (std::size_t x = 0; x < triangleCount; x++) {
+      const Uint misses = cache.Fetch(indices[x * 3]) + cache.Fetch(indices[x * 3 + 1]) + cache.Fetch(indices[x * 3 + 2]);
+      if (misses == 3)
+        hardBoundaries.push_back(x);
+    }
+    hardBoundaries.push_back(triangleCount);
+  }
+
+  /* Soft boundaries, each hard cluster is split again as soon as the running ACMR reaches the ACMR of the whole cluster
+     (times the threshold), every cluster starts with a cold cache since it can be drawn in any order */
+  std::vector<std::size_t> clusters;
+  {
+    FIFOCacheSimulation cache(vertexCount, YEAGER_MESH_ANALYZE_CACHE_SIZE);
+    for (std::size_t x = 0; x + 1 < hardBoundaries.size(); x++) {
+      const std::size_t start = hardBoundaries[x];
+      const std::size_t end = hardBoundaries[x + 1];
+
+      cache.Flush();
+      Uint clusterMisses = 0;
+      for (std::size_t y = start; y < end; y++)
+        clusterMisses += cache.Fetch(indices[y * 3]) + cache.Fetch(indices[y * 3 + 1]) + cache.Fetch(indices[y * 3 + 2]);
+      const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+      cache.Flush();
+      clusters.push_back(start);
+      Uint runningMisses = 0;
+      Uint runningTriangles = 0;
+      for (std::size_t y = start; y < end; y++) {
+        runningMisses +=
+            cache.Fetch(indices[y * 3]) + cache.Fetch(indices[y * 3 + 1]) + cache.Fetch(indices[y * 3 + 2]);
+        runningTriangles++;
+        if (y + 1 < end && static_cast<float>(runningMisses) / static_cast<float>(runningTriangles) <= clusterThreshold) {
+          clusters.push_back(y + 1);
+          cache.Flush();
+          runningMisses = 0;
+          runningTriangles = 0;
+        }
+      }
+    }
+    clusters.push_back(triangleCount);
+  }
+
+  const std::size_t clusterCount = clusters.size() - 1;
+  if (clusterCount <= 1)
+    return;
+
+  auto position = [positions, stride](GLuint vertex) {
+    Vector3 result;
+    std::memcpy(&result, positions + vertex * stride, sizeof(Vector3));
+    return result;
+  };
+
+  /* Centroid of the mesh, weighted by the triangle areas */
+  Vector3 meshCentroid(0.0f);
+  float meshArea = 0.0f;
+  for (std::size_t x = 0; x < triangleCount; x++) {
+    const Vector3 a = position(indices[x * 3]), b = position(indices[x * 3 + 1]), c = position(indices[x * 3 + 2]);
+    const float area = glm::length(glm::cross(b - a, c - a));
+    meshCentroid += (a + b + c) * (area / 3.0f);
+    meshArea += area;
+  }
+  if (meshArea > 0.0f)
+    meshCentroid /= meshArea;
+
+  /* Clusters facing away from the center are more likely to cover the others, they are drawn first */
+  std::vector<float> sortKeys(clusterCount);
+  for (std::size_t x = 0; x < clusterCount; x++) {
+    Vector3 centroid(0.0f);
+    Vector3 normal(0.0f);
+    float area = 0.0f;
+    for (std::size_t y = clusters[x]; y < clusters[x + 1]; y++) {
+      const Vector3 a = position(indices[y * 3]), b = position(indices[y * 3 + 1]), c = position(indices[y * 3 + 2]);
+      const Vector3 weightedNormal = glm::cross(b - a, c - a);
+      const float triangleArea = glm::length(weightedNormal);
+      centroid += (a + b + c) * (triangleArea / 3.0f);
+      normal += weightedNormal;
+      area += triangleArea;
+    }
+    if (area > 0.0f)
+      centroid /= area;
+    const float normalLength = glm::length(normal);
+    sortKeys[x] = normalLength > 0.0f ? glm::dot(centroid - meshCentroid, normal / normalLength) : 0.0f;
+  }
+
+  std::vector<std::size_t> order(clusterCount);
+  for (std::size_t x = 0; x < clusterCount; x++)
+    order[x] = x;
+  std::stable_sort(order.begin(), order.end(),
+                   [&sortKeys](std::size_t a, std::size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+  std::vector<GLuint> output;
+  output.reserve(indices.size());
+  for (std::size_t cluster : order)
+    output.insert(output.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + clusters[cluster + 1] * 3);
+  indices = std::move(output);
+}
+
+std::size_t Yeager::BuildVertexFetchRemap(std::vector<GLuint>& indices, std::size_t vertexCount,
+                                          std::vector<GLuint>& remap)
+{
+  remap.assign(vertexCount, UINT32_MAX);
+  GLuint next = 0;
+  for (auto& index : indices) {
+    if (remap[index] == UINT32_MAX)
+      remap[index] = next++;
+    index = remap[index];
+  }
+  return next;
+}
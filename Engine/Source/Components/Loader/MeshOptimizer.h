@@ -0,0 +1,182 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+/* FIFO size used to measure the post transform cache, close to what the hardware of the last years behaves like */
+#define YEAGER_MESH_ANALYZE_CACHE_SIZE 16
+/* Cache size the Forsyth ordering optimizes for, bigger than the measured one so it degrades well on every hardware */
+#define YEAGER_MESH_OPTIMIZE_CACHE_SIZE 32
+
+/**
+ * @brief Post transform vertex cache statistics of an index buffer
+ * ACMR - Average cache miss ratio, vertices transformed per triangle, 0.5 is the best a regular grid can do and 3.0 the worst
+ * ATVR - Average transformed vertex ratio, vertices transformed per unique vertex, 1.0 is the best possible
+ */
+struct VertexCacheStatistics {
+  Uint VerticesTransformed = 0;
+  float ACMR = 0.0f;
+  float ATVR = 0.0f;
+};
+
+struct MeshOptimizationSettings {
+  bool bWeldVertices = true;
+  bool bOptimizeVertexCache = true;
+  /* Reorders clusters of triangles so the ones facing outwards are drawn first, trades a bit of the cache efficiency */
+  bool bOptimizeOverdraw = true;
+  /* How much the ACMR can grow while splitting the clusters for the overdraw ordering, 1.05 means 5% */
+  float OverdrawThreshold = 1.05f;
+  bool bOptimizeVertexFetch = true;
+};
+
+struct MeshOptimizationStatistics {
+  Uint VerticesBefore = 0;
+  Uint VerticesAfter = 0;
+  VertexCacheStatistics CacheBefore;
+  VertexCacheStatistics CacheAfter;
+};
+
+/**
+ * @brief Simulates a FIFO post transform cache of cacheSize entries over the triangle list and returns the ACMR and ATVR
+ */
+extern VertexCacheStatistics AnalyzeVertexCache(const std::vector<GLuint>& indices, std::size_t vertexCount,
+                                                Uint cacheSize = YEAGER_MESH_ANALYZE_CACHE_SIZE);
+
+/**
+ * @brief Reorders the triangles so consecutive triangles share vertices in the post transform cache, Tom Forsyth's linear-speed
+ * vertex cache optimisation, every vertex is scored by its position in a simulated LRU cache and how many triangles still use it
+ */
+extern void OptimizeVertexCache(std::vector<GLuint>& indices, std::size_t vertexCount,
+                                Uint cacheSize = YEAGER_MESH_OPTIMIZE_CACHE_SIZE);
+
+/**
+ * @brief Splits an index buffer already ordered for the vertex cache into clusters, and sorts the clusters so the ones
+ * facing away from the center of the mesh (more likely to occlude the rest) are drawn first. Positions are read with the given
+ * stride in bytes. The ACMR is allowed to grow up to threshold times while creating the clusters (Sander et al, Tipsy)
+ */
+extern void OptimizeOverdraw(std::vector<GLuint>& indices, const unsigned char* positions, std::size_t vertexCount,
+                             std::size_t stride, float threshold);
+
+/**
+ * @brief Builds the remap table that orders the vertices by their first use in the index buffer, so the vertex fetch
+ * reads memory linearly. Unused vertices are dropped, returns the new vertex count
+ */
+extern std::size_t BuildVertexFetchRemap(std::vector<GLuint>& indices, std::size_t vertexCount,
+                                         std::vector<GLuint>& remap);
+
+/**
+ * @brief Merges vertices that are bitwise equal, and rewrites the index buffer to point to the remaining ones.
+ * The vertex type must not have padding bytes, or equal vertices could be seen as different
+ */
+template <typename VertexType>
+void WeldVertices(std::vector<VertexType>& vertices, std::vector<GLuint>& indices)
+{
+  static_assert(std::is_trivially_copyable_v<VertexType>, "Welding compares the bytes of the vertices");
+  if (vertices.empty())
+    return;
+
+  /* Open addressing table of vertex indices, sized to a power of two at least twice the vertex count */
+  std::size_t tableSize = 1;
+  while (tableSize < vertices.size() * 2)
+    tableSize <<= 1;
+  std::vector<GLuint> table(tableSize, UINT32_MAX);
+  std::vector<GLuint> remap(vertices.size());
+
+  auto hashVertex = [](const VertexType& vertex) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&vertex);
+    uint64_t hash = 14695981039346656037ull;
+    for (std::size_t x = 0; x < sizeof(VertexType); x++) {
+      hash ^= bytes[x];
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  };
+
+  std::vector<VertexType> welded;
+  welded.reserve(vertices.size());
+  for (std::size_t x = 0; x < vertices.size(); x++) {
+    std::size_t slot = static_cast<std::size_t>(hashVertex(vertices[x])) & (tableSize - 1);
+    while (table[slot] != UINT32_MAX &&
+           std::memcmp(&welded[table[slot]], &vertices[x], sizeof(VertexType)) != 0)
+      slot = (slot + 1) & (tableSize - 1);
+
+    if (table[slot] == UINT32_MAX) {
+      table[slot] = static_cast<GLuint>(welded.size());
+      welded.push_back(vertices[x]);
+    }
+    remap[x] = table[slot];
+  }
+
+  for (auto& index : indices)
+    index = remap[index];
+  vertices = std::move(welded);
+}
+
+/**
+ * @brief Runs the optimization passes enabled in the settings over the mesh, the vertex type must start with a Vector3
+ * position (ObjectVertexData and AnimatedVertexData do)
+ */
+template <typename VertexType>
+MeshOptimizationStatistics OptimizeMesh(std::vector<VertexType>& vertices, std::vector<GLuint>& indices,
+                                        const MeshOptimizationSettings& settings = MeshOptimizationSettings())
+{
+  MeshOptimizationStatistics stats;
+  stats.VerticesBefore = static_cast<Uint>(vertices.size());
+  stats.CacheBefore = AnalyzeVertexCache(indices, vertices.size());
+
+  /* Only triangle lists are reordered, anything else is left as it came */
+  if (indices.empty() || indices.size() % 3 != 0) {
+    stats.VerticesAfter = stats.VerticesBefore;
+    stats.CacheAfter = stats.CacheBefore;
+    return stats;
+  }
+
+  if (settings.bWeldVertices)
+    WeldVertices(vertices, indices);
+
+  if (settings.bOptimizeVertexCache) {
+    OptimizeVertexCache(indices, vertices.size());
+    if (settings.bOptimizeOverdraw)
+      OptimizeOverdraw(indices, reinterpret_cast<const unsigned char*>(vertices.data()), vertices.size(),
+                       sizeof(VertexType), settings.OverdrawThreshold);
+  }
+
+  if (settings.bOptimizeVertexFetch) {
+    std::vector<GLuint> remap;
+    const std::size_t used = BuildVertexFetchRemap(indices, vertices.size(), remap);
+    std::vector<VertexType> ordered(used);
+    for (std::size_t x = 0; x < vertices.size(); x++) {
+      if (remap[x] != UINT32_MAX)
+        ordered[remap[x]] = vertices[x];
+    }
+    vertices = std::move(ordered);
+  }
+
+  stats.VerticesAfter = static_cast<Uint>(vertices.size());
+  stats.CacheAfter = AnalyzeVertexCache(indices, vertices.size());
+  return stats;
+}
+
+}  // namespace Yeager
@@ -13,6 +13,16 @@ PhysXActor::PhysXActor(Yeager::ApplicationCore* application, Yeager::Object* obj
 
 PhysXActor::~PhysXActor()
 {
+  /* The physics engine is terminated before the scene objects are destroyed, it already released every actor */
+  PhysXHandle* handle = m_Application->GetPhysXHandle();
+  if (handle != YEAGER_NULLPTR && handle->IsInitialized()) {
+    if (m_Actor != YEAGER_NULLPTR) {
+      handle->RemoveFromScene(m_Actor);
+      m_Actor->release();
+    }
+    if (m_Material != YEAGER_NULLPTR)
+      m_Material->release();
+  }
   Yeager::LogDebug(INFO, "Destroryed physx actor for object {} UUID {}", m_Object->GetName(),
                    uuids::to_string(m_Object->GetEntityUUID()));
 }
@@ -49,18 +59,24 @@ void PhysXActor::BuildActor(const ObjectPhysXCreationBase& creation)
 
     const ObjectPhysXCreationDynamic& dynamic = static_cast<const ObjectPhysXCreationDynamic&>(creation);
     actor->setMass(dynamic.Mass);
+    m_Application->GetPhysXHandle()->RegisterInterpolatedActor(m_Actor);
   }
 }
 
+void PhysXActor::RemoveFromScene()
+{
+  if (m_Actor != YEAGER_NULLPTR && m_Application->GetPhysXHandle() != YEAGER_NULLPTR)
+    m_Application->GetPhysXHandle()->RemoveFromScene(m_Actor);
+}
+
 void PhysXActor::ProcessTransformation(float delta)
 {
   const Yeager::ObjectPhysicsType::Enum type = m_Object->GetObjectPhysicsType();
 
-  if (type == Yeager::ObjectPhysicsType::eDYNAMIC_BODY) {
-    physx::PxRigidBody* actor = static_cast<physx::PxRigidBody*>(m_Actor);
-    const Vector3 pos = PxVec3ToVector3(actor->getGlobalPose().p);
-    const Vector3 rotv = PxVec3ToVector3(actor->getAngularVelocity());
-    m_Object->GetTransformationPtr()->rotation += rotv;
-    m_Object->GetTransformationPtr()->position = pos;
+  if (type == Yeager::ObjectPhysicsType::eDYNAMIC_BODY && m_Actor != YEAGER_NULLPTR) {
+    /* The pose comes from the fixed steps of the simulation, the frame time only picks the point between two of them */
+    const physx::PxTransform pose = m_Application->GetPhysXHandle()->GetInterpolatedPose(m_Actor);
+    m_Object->GetTransformationPtr()->position = PxVec3ToVector3(pose.p);
+    m_Object->GetTransformationPtr()->rotation = PxQuatToEulerDegrees(pose.q);
   }
 }
@@ -143,6 +143,8 @@ class PhysXActor {
 
   void BuildActor(const ObjectPhysXCreationBase& creation);
   void ProcessTransformation(float delta);
+  /** @brief Takes the actor out of the PhysX scene, the actor itself is released with this handle */
+  void RemoveFromScene();
 
  private:
   Yeager::ApplicationCore* m_Application = YEAGER_NULLPTR;
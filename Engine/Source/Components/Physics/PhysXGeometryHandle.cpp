@@ -1,4 +1,5 @@
 #include "PhysXGeometryHandle.h"
+#include "Components/Kernel/Caching/PhysXCookingCache.h"
 #include "Components/Loader/Importer.h"
 #include "Main/Core/Application.h"
 
@@ -106,20 +107,17 @@ physx::PxRigidActor* PhysXGeometryHandle::CreatePrimitivePlane(physx::PxMaterial
   return plane;
 }
 
-PxTriangleMesh* PhysXGeometryHandle::CreateTriangleMesh(physx::PxU32 pointCount, physx::PxU32 trianglesCount,
-                                                        physx::PxU32 pointStride, physx::PxU32 triangleStride,
-                                                        physx::PxVec3* vertices, physx::PxU32* indices,
-                                                        physx::PxU32 yeagerPhysxFlags)
+String PhysXGeometryHandle::GetCookingCacheFolder() const
 {
-  PxTriangleMeshDesc meshDesc;
-  meshDesc.points.count = pointCount;
-  meshDesc.points.stride = pointStride;
-  meshDesc.points.data = vertices;
-
-  meshDesc.triangles.count = trianglesCount;
-  meshDesc.triangles.stride = triangleStride;
-  meshDesc.triangles.data = indices;
+  if (m_Application == YEAGER_NULLPTR || m_Application->GetScene() == YEAGER_NULLPTR ||
+      m_Application->GetScene()->GetContext()->ProjectFolderPath == YEAGER_NULL_LITERAL)
+    return YEAGER_NULL_LITERAL;
+  return m_Application->GetScene()->GetObjectCacheFolderPath();
+}
 
+PxTriangleMesh* PhysXGeometryHandle::CookTriangleMesh(const physx::PxTriangleMeshDesc& meshDesc,
+                                                      physx::PxU32 yeagerPhysxFlags)
+{
   PxTolerancesScale scale;
   PxCookingParams params(scale);
 
@@ -128,22 +126,56 @@ PxTriangleMesh* PhysXGeometryHandle::CreateTriangleMesh(physx::PxU32 pointCount,
     params.meshPreprocessParams |= PxMeshPreprocessingFlag::eDISABLE_ACTIVE_EDGES_PRECOMPUTE;
   }
 
+  if (!meshDesc.isValid()) {
+    Yeager::Log(ERROR, "PhysX cannot create a triangle mesh, the MeshDesc is not valid!");
+    return YEAGER_NULLPTR;
+  }
+
+  if (yeagerPhysxFlags != YEAGER_PHYSX_COOKING_STREAM_SERIALIZATION_ENABLED)
+    return PxCreateTriangleMesh(params, meshDesc, m_PhysXHandle->GetPxPhysics()->getPhysicsInsertionCallback());
+
+  const String cacheFolder = GetCookingCacheFolder();
+  const bool cached = cacheFolder != YEAGER_NULL_LITERAL;
+  const uint64_t key = cached ? PhysXCookingCache::ComputeKey(meshDesc, params) : 0;
+  const String cachePath = cached ? PhysXCookingCache::BuildCachePath(cacheFolder, key) : String();
+  if (cached) {
+    if (PxTriangleMesh* mesh = PhysXCookingCache::LoadTriangleMesh(cachePath, key, *m_PhysXHandle->GetPxPhysics()))
+      return mesh;
+  }
+
 #ifdef YEAGER_DEBUG
   bool res = PxValidateTriangleMesh(params, meshDesc);
   PX_ASSERT(res);
 #endif
 
-  if (yeagerPhysxFlags == YEAGER_PHYSX_COOKING_STREAM_SERIALIZATION_ENABLED) {
-    PxDefaultMemoryOutputStream buffer;
-    PxTriangleMeshCookingResult::Enum result;
-    if (!PxCookTriangleMesh(params, meshDesc, buffer, &result)) {
-      Yeager::Log(ERROR, "Cannot PxCookConvexMesh failed!");
-    }
-    PxDefaultMemoryInputData input(buffer.getData(), buffer.getSize());
-    return m_PhysXHandle->GetPxPhysics()->createTriangleMesh(input);
-  } else {
-    return PxCreateTriangleMesh(params, meshDesc, m_PhysXHandle->GetPxPhysics()->getPhysicsInsertionCallback());
+  PxDefaultMemoryOutputStream buffer;
+  PxTriangleMeshCookingResult::Enum result;
+  if (!PxCookTriangleMesh(params, meshDesc, buffer, &result)) {
+    Yeager::Log(ERROR, "Cannot PxCookTriangleMesh failed!");
+    return YEAGER_NULLPTR;
   }
+  if (cached)
+    PhysXCookingCache::Write(cachePath, key, PhysXCookedKind::eTRIANGLE_MESH, buffer);
+
+  PxDefaultMemoryInputData input(buffer.getData(), buffer.getSize());
+  return m_PhysXHandle->GetPxPhysics()->createTriangleMesh(input);
+}
+
+PxTriangleMesh* PhysXGeometryHandle::CreateTriangleMesh(physx::PxU32 pointCount, physx::PxU32 trianglesCount,
+                                                        physx::PxU32 pointStride, physx::PxU32 triangleStride,
+                                                        const physx::PxVec3* vertices, const physx::PxU32* indices,
+                                                        physx::PxU32 yeagerPhysxFlags)
+{
+  PxTriangleMeshDesc meshDesc;
+  meshDesc.points.count = pointCount;
+  meshDesc.points.stride = pointStride;
+  meshDesc.points.data = vertices;
+
+  meshDesc.triangles.count = trianglesCount;
+  meshDesc.triangles.stride = triangleStride;
+  meshDesc.triangles.data = indices;
+
+  return CookTriangleMesh(meshDesc, yeagerPhysxFlags);
 }
 
 PxTriangleMesh* PhysXGeometryHandle::CreateTriangleMesh(const Yeager::PhysXTriangleMeshInput& mesh,
@@ -152,35 +184,47 @@ PxTriangleMesh* PhysXGeometryHandle::CreateTriangleMesh(const Yeager::PhysXTrian
   PxTriangleMeshDesc meshDesc;
   meshDesc.points.count = mesh.Vertices.size();
   meshDesc.points.stride = sizeof(PxVec3);
-  meshDesc.points.data = &mesh.Vertices[0];
+  meshDesc.points.data = mesh.Vertices.data();
 
-  meshDesc.triangles.count = mesh.Vertices.size() / 3;
+  meshDesc.triangles.count = mesh.Indices.size() / 3;
   meshDesc.triangles.stride = 3 * sizeof(PxU32);
-  meshDesc.triangles.data = &mesh.Indices[0];
+  meshDesc.triangles.data = mesh.Indices.data();
+
+  return CookTriangleMesh(meshDesc, yeagerPhysxFlags);
+}
+
+PxConvexMesh* PhysXGeometryHandle::CreateConvexMesh(physx::PxU32 pointCount, physx::PxU32 pointStride,
+                                                    const physx::PxVec3* points)
+{
+  PxConvexMeshDesc convexDesc;
+  convexDesc.points.count = pointCount;
+  convexDesc.points.stride = pointStride;
+  convexDesc.points.data = points;
+  convexDesc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
 
   PxTolerancesScale scale;
   PxCookingParams params(scale);
 
-#ifdef YEAGER_DEBUG
-  bool res = PxValidateTriangleMesh(params, meshDesc);
-  PX_ASSERT(res);
-#endif
-
-  if (!meshDesc.isValid()) {
-    Yeager::Log(ERROR, "PhysX cannot create a triangle mesh, the MeshDesc is not valid!");
+  const String cacheFolder = GetCookingCacheFolder();
+  const bool cached = cacheFolder != YEAGER_NULL_LITERAL;
+  const uint64_t key = cached ? PhysXCookingCache::ComputeKey(convexDesc, params) : 0;
+  const String cachePath = cached ? PhysXCookingCache::BuildCachePath(cacheFolder, key) : String();
+  if (cached) {
+    if (PxConvexMesh* mesh = PhysXCookingCache::LoadConvexMesh(cachePath, key, *m_PhysXHandle->GetPxPhysics()))
+      return mesh;
   }
 
-  if (yeagerPhysxFlags == YEAGER_PHYSX_COOKING_STREAM_SERIALIZATION_ENABLED) {
-    PxDefaultMemoryOutputStream buffer;
-    PxTriangleMeshCookingResult::Enum result;
-    if (!PxCookTriangleMesh(params, meshDesc, buffer, &result)) {
-      Yeager::Log(ERROR, "Cannot PxCookConvexMesh failed!");
-    }
-    PxDefaultMemoryInputData input(buffer.getData(), buffer.getSize());
-    return m_PhysXHandle->GetPxPhysics()->createTriangleMesh(input);
-  } else {
-    return PxCreateTriangleMesh(params, meshDesc, m_PhysXHandle->GetPxPhysics()->getPhysicsInsertionCallback());
+  PxDefaultMemoryOutputStream buffer;
+  PxConvexMeshCookingResult::Enum result;
+  if (!PxCookConvexMesh(params, convexDesc, buffer, &result)) {
+    Yeager::Log(ERROR, "Cannot PxCookConvexMesh failed!");
+    return YEAGER_NULLPTR;
   }
+  if (cached)
+    PhysXCookingCache::Write(cachePath, key, PhysXCookedKind::eCONVEX_MESH, buffer);
+
+  PxDefaultMemoryInputData input(buffer.getData(), buffer.getSize());
+  return m_PhysXHandle->GetPxPhysics()->createConvexMesh(input);
 }
 
 void PhysXGeometryHandle::RenderShapeInformation(physx::PxRigidActor* actor)
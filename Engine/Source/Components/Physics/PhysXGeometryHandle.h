@@ -67,13 +67,16 @@ class PhysXGeometryHandle {
 
   YEAGER_NODISCARD physx::PxTriangleMesh* CreateTriangleMesh(
       physx::PxU32 pointCount, physx::PxU32 trianglesCount, physx::PxU32 pointStride, physx::PxU32 triangleStride,
-      physx::PxVec3* vertices, physx::PxU32* indices,
+      const physx::PxVec3* vertices, const physx::PxU32* indices,
       physx::PxU32 yeagerPhysxFlags = YEAGER_PHYSX_COOKING_STREAM_SERIALIZATION_ENABLED);
 
   YEAGER_NODISCARD physx::PxTriangleMesh* CreateTriangleMesh(
       const Yeager::PhysXTriangleMeshInput& mesh,
       physx::PxU32 yeagerPhysxFlags = YEAGER_PHYSX_COOKING_STREAM_SERIALIZATION_ENABLED);
 
+  YEAGER_NODISCARD physx::PxConvexMesh* CreateConvexMesh(physx::PxU32 pointCount, physx::PxU32 pointStride,
+                                                         const physx::PxVec3* points);
+
   /**
    * Primitives PhysX geometries types
    * Functions below create spheres, boxes, capsules and planes automatically and adds them to the scene
@@ -108,6 +111,14 @@ class PhysXGeometryHandle {
   void RenderGeometryInformation(physx::PxRigidActor* actor, physx::PxShape* shape);
 
  private:
+  /**
+   * With the stream serialization enabled, the cooked stream is kept in the object cache folder of the project and the
+   * same geometry is created from it on the next loads without being cooked again
+   */
+  physx::PxTriangleMesh* CookTriangleMesh(const physx::PxTriangleMeshDesc& meshDesc, physx::PxU32 yeagerPhysxFlags);
+  /* Returns YEAGER_NULL_LITERAL when no project is loaded, the meshes are cooked every time then */
+  String GetCookingCacheFolder() const;
+
   Yeager::PhysXHandle* m_PhysXHandle = YEAGER_NULLPTR;
   Yeager::ApplicationCore* m_Application = YEAGER_NULLPTR;
 };
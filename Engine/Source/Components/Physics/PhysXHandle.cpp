@@ -54,12 +54,35 @@ Vector3 Yeager::PxVec3ToVector3(const PxVec3& vec)
   return rt;
 }
 
+Vector3 Yeager::PxQuatToEulerDegrees(const PxQuat& quat)
+{
+  /* Transformation3D rotates by X, then Y, then Z, the angles are read back from the matrix Rx * Ry * Rz */
+  const glm::mat3 m = glm::mat3_cast(glm::quat(quat.w, quat.x, quat.y, quat.z));
+  const float cosY = std::sqrt(m[0][0] * m[0][0] + m[1][0] * m[1][0]);
+  Vector3 euler(0.0f);
+  euler.y = std::atan2(m[2][0], cosY);
+  if (cosY > 1e-6f) {
+    euler.x = std::atan2(-m[2][1], m[2][2]);
+    euler.z = std::atan2(-m[1][0], m[0][0]);
+  } else {
+    /* Gimbal lock, X and Z turn around the same axis and Z is left at zero */
+    euler.x = std::atan2(m[1][2], m[1][1]);
+  }
+  return glm::degrees(euler);
+}
+
 void PhysXHandle::PushToScene(physx::PxRigidActor* actor)
 {
-  m_PxScene->addActor(*actor);
+  m_Stepper.AddActor(actor);
   m_PxActors.push_back(actor);
 }
 
+void PhysXHandle::RemoveFromScene(physx::PxRigidActor* actor)
+{
+  m_Stepper.RemoveActor(actor);
+  m_PxActors.erase(std::remove(m_PxActors.begin(), m_PxActors.end(), actor), m_PxActors.end());
+}
+
 PhysXHandle::PhysXHandle(Yeager::ApplicationCore* app) : m_Application(app) {}
 
 bool PhysXHandle::InitPxEngine()
@@ -103,22 +126,21 @@ bool PhysXHandle::InitPxEngine()
     Yeager::Log(WARNING, "PxPhysx tolerance scale is not valid!");
   }
 
-  m_PxCpuDispatcher = PxDefaultCpuDispatcherCreate(Yeager::GetHardwareThreadCount() / 2);
-  if (!m_PxCpuDispatcher) {
-    Yeager::Log(ERROR, "PxDefaultCpuDispacterCreate failed!");
-    return false;
-  }
+  m_PxCpuDispatcher = BaseAllocator::Construct<PhysXJobDispatcher>();
 
   m_PxSceneDesc = BaseAllocator::Construct<PxSceneDesc>(m_PxPhysics->getTolerancesScale());
   m_PxSceneDesc->gravity = PxVec3(0.0f, -90.81f, 0.0f);
   m_PxSceneDesc->cpuDispatcher = m_PxCpuDispatcher;
   m_PxSceneDesc->filterShader = PxDefaultSimulationFilterShader;
+  /* Only the actors moved by the last step are visited when their poses are captured */
+  m_PxSceneDesc->flags |= PxSceneFlag::eENABLE_ACTIVE_ACTORS;
 
   if (!m_PxSceneDesc->isValid()) {
     Yeager::Log(WARNING, "PxSceneDesc is not valid!");
   }
 
   m_PxScene = m_PxPhysics->createScene(*m_PxSceneDesc);
+  m_Stepper.SetScene(m_PxScene);
 
   m_PxPvdClient = m_PxScene->getScenePvdClient();
   if (m_PxPvdClient) {
@@ -146,9 +168,15 @@ void PhysXHandle::TerminateEngine()
   }
   m_Capsules.clear();
 
+  EndSimulation();
+  m_Stepper.Reset();
   m_CharacterController->PhysXCharacterController::~PhysXCharacterController();
 
   PX_RELEASE(m_PxScene);
+  if (m_PxCpuDispatcher) {
+    m_PxCpuDispatcher->PhysXJobDispatcher::~PhysXJobDispatcher();
+    BaseAllocator::Deallocate(m_PxCpuDispatcher);
+  }
   PX_RELEASE(m_PxPhysics);
   if (m_PxExtensionsEnabled) {
     PxCloseExtensions();
@@ -165,17 +193,8 @@ void PhysXHandle::TerminateEngine()
   PX_RELEASE(m_PxFoundation);
 
   BaseAllocator::Deallocate(m_PhysXGeometryHandle);
+  m_Initialized = false;
   // TODO: Check this
   //YEAGER_DELETE(m_CharacterController);
   Yeager::Log(INFO, "PhysX Engine terminated!");
 }
-
-void PhysXHandle::StartSimulation(float deltaTime)
-{
-  m_PxScene->simulate(deltaTime);
-}
-
-void PhysXHandle::EndSimulation()
-{
-  m_PxScene->fetchResults(true);
-}
@@ -26,6 +26,8 @@
 
 #include "PhysXCharacterController.h"
 #include "PhysXGeometryHandle.h"
+#include "PhysXJobDispatcher.h"
+#include "PhysXSceneStepper.h"
 #include "PhysxAllocator.h"
 
 #define PVD_HOST "127.0.0.1"
@@ -39,6 +41,9 @@ extern Vector3 PxVec3ToVector3(const physx::PxVec3& vec);
 extern physx::PxMat44 Matrix4ToPxMat44(const Matrix4& mat);
 extern Matrix4 PxMat4ToMatrix4(const physx::PxMat44& mat);
 
+/* Euler angles in degrees, in the X, Y then Z order Transformation3D applies them */
+extern Vector3 PxQuatToEulerDegrees(const physx::PxQuat& quat);
+
 class YgPxErrorCallback : public physx::PxErrorCallback {
  public:
   virtual void reportError(physx::PxErrorCode::Enum code, const char* message, const char* file, int line)
@@ -59,9 +64,15 @@ class PhysXHandle {
   bool IsPxPvdEnabled() const { return m_PxPvdEnabled; }
 
   /**
-   @brief Push the actor the PxScene and to the application
+   @brief Push the actor the PxScene and to the application. During a step the actor is only added to the scene by
+   EndSimulation, once the step is fetched
    */
   void PushToScene(physx::PxRigidActor* actor);
+  /**
+   * @brief Takes the actor out of the scene and out of the interpolation, it stops colliding right away while its
+   * memory is released later by its owner. Called by the batched deletion of the scene, after the step is fetched
+   */
+  void RemoveFromScene(physx::PxRigidActor* actor);
 
   YEAGER_NODISCARD physx::PxScene* GetPxScene()
   {
@@ -79,8 +90,27 @@ class PhysXHandle {
     return m_PxPhysics;
   }
 
-  void StartSimulation(float deltaTime);
-  void EndSimulation();
+  /** @brief Steps the scene at the fixed rate of the settings, see PhysXSceneStepper::Start */
+  void StartSimulation(float deltaTime) { m_Stepper.Start(deltaTime); }
+  /** @brief Waits for the step started by StartSimulation, does nothing without a step */
+  void EndSimulation() { m_Stepper.End(); }
+
+  /** @brief The dynamic actors registered here are drawn at a pose interpolated between their last two steps */
+  void RegisterInterpolatedActor(physx::PxRigidActor* actor) { m_Stepper.RegisterInterpolatedActor(actor); }
+  void UnregisterInterpolatedActor(physx::PxRigidActor* actor) { m_Stepper.UnregisterInterpolatedActor(actor); }
+  YEAGER_NODISCARD physx::PxTransform GetInterpolatedPose(physx::PxRigidActor* actor) const
+  {
+    return m_Stepper.GetInterpolatedPose(actor);
+  }
+
+  void SetStepSettings(const PhysXStepSettings& settings) { m_Stepper.SetSettings(settings); }
+  const PhysXStepSettings& GetStepSettings() const { return m_Stepper.GetSettings(); }
+  float GetInterpolationAlpha() const { return m_Stepper.GetInterpolationAlpha(); }
+  uint64_t GetCompletedSteps() const { return m_Stepper.GetCompletedSteps(); }
+
+  bool IsSimulating() const { return m_Stepper.IsSimulating(); }
+  /** @brief Time the main thread was blocked in the last EndSimulation, waiting for the step to finish */
+  float GetLastFetchWaitMilliseconds() const { return m_Stepper.GetLastFetchWaitMilliseconds(); }
 
   std::vector<Yeager::PhysXCapsule*>* GetCapsules() { return &m_Capsules; }
   std::vector<PhysXTriangleMesh*>* GetTrianglesMeshes() { return &m_TriangleMeshes; }
@@ -100,7 +130,7 @@ class PhysXHandle {
   physx::PxPhysics* m_PxPhysics = YEAGER_NULLPTR;
   physx::PxScene* m_PxScene = YEAGER_NULLPTR;
   physx::PxSceneDesc* m_PxSceneDesc = YEAGER_NULLPTR;
-  physx::PxCpuDispatcher* m_PxCpuDispatcher = YEAGER_NULLPTR;
+  Yeager::PhysXJobDispatcher* m_PxCpuDispatcher = YEAGER_NULLPTR;
   physx::PxPvd* m_PxPvd = YEAGER_NULLPTR;
   physx::PxPvdTransport* m_PxPvdTransport = YEAGER_NULLPTR;
   physx::PxPvdSceneClient* m_PxPvdClient = YEAGER_NULLPTR;
@@ -109,6 +139,7 @@ class PhysXHandle {
   YgPxErrorCallback m_PxErrorCallback;
   YgPxAllocatorCallback m_PxAllocatorCallback;
   std::vector<physx::PxActor*> m_PxActors;
+  PhysXSceneStepper m_Stepper;
   bool m_Initialized = false;
   bool m_PxExtensionsEnabled = true;
   bool m_PxPvdEnabled = true;
@@ -0,0 +1,29 @@
+#include "PhysXJobDispatcher.h"
+using namespace Yeager;
+
+PhysXJobDispatcher::~PhysXJobDispatcher()
+{
+  WaitTasks();
+}
+
+void PhysXJobDispatcher::submitTask(physx::PxBaseTask& task)
+{
+  /* The release hands the task back to the task manager, which may submit the tasks depending on it. High priority,
+     so the workers pick the step before the frame jobs queued in front of it and the fetch does not wait behind them */
+  JobSystem::Run(
+      [&task]() {
+        task.run();
+        task.release();
+      },
+      &mTasks, JobPriority::eHIGH);
+}
+
+uint32_t PhysXJobDispatcher::getWorkerCount() const
+{
+  return std::max<Uint>(JobSystem::GetWorkerCount(), 2) - 1;
+}
+
+void PhysXJobDispatcher::WaitTasks()
+{
+  JobSystem::Wait(&mTasks);
+}
@@ -0,0 +1,51 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+#include "Components/Kernel/Process/JobSystem.h"
+#include "PhysxAllocator.h"
+
+namespace Yeager {
+
+/**
+ * @brief Runs the PhysX simulation tasks in the engine job system, instead of a second pool of threads fighting the
+ * workers for the same cores. Tasks are submitted from the thread calling simulate and from the tasks themselves, as
+ * high priority jobs so they never queue behind the frame jobs
+ */
+class PhysXJobDispatcher : public physx::PxCpuDispatcher {
+ public:
+  PhysXJobDispatcher() = default;
+  ~PhysXJobDispatcher();
+
+  virtual void submitTask(physx::PxBaseTask& task) override;
+  /** @brief The main thread does not loop for jobs, only the background workers are reported */
+  virtual uint32_t getWorkerCount() const override;
+
+  /** @brief Blocks until every submitted task ran and was released */
+  void WaitTasks();
+
+ private:
+  JobCounter mTasks;
+};
+
+}  // namespace Yeager
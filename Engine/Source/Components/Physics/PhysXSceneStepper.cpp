@@ -0,0 +1,116 @@
+#include "PhysXSceneStepper.h"
+using namespace Yeager;
+using namespace physx;
+
+PxTransform Yeager::InterpolatePose(const PxTransform& from, const PxTransform& to, float alpha)
+{
+  const glm::quat rotation =
+      glm::slerp(glm::quat(from.q.w, from.q.x, from.q.y, from.q.z), glm::quat(to.q.w, to.q.x, to.q.y, to.q.z), alpha);
+  return PxTransform(from.p + (to.p - from.p) * alpha, PxQuat(rotation.x, rotation.y, rotation.z, rotation.w));
+}
+
+void PhysXSceneStepper::Reset()
+{
+  mScene = YEAGER_NULLPTR;
+  mAccumulator = 0.0f;
+  mCompletedSteps = 0;
+  mPendingActors.clear();
+  mInterpolatedPoses.clear();
+}
+
+void PhysXSceneStepper::Start(float deltaTime)
+{
+  if (mSimulating) {
+    Yeager::Log(WARNING, "PhysX simulation started while the last step was not fetched yet!");
+    End();
+  }
+
+  const float step = 1.0f / mSettings.Frequency;
+  mAccumulator += deltaTime;
+  const Uint steps = std::min(static_cast<Uint>(mAccumulator / step), mSettings.MaxSteps);
+  mAccumulator -= steps * step;
+  if (mAccumulator >= step)
+    mAccumulator = std::fmod(mAccumulator, step);
+
+  for (Uint x = 0; x < steps; x++) {
+    End();
+    mScene->simulate(step);
+    mSimulating = true;
+  }
+}
+
+void PhysXSceneStepper::End()
+{
+  if (!mSimulating)
+    return;
+
+  const auto start = std::chrono::steady_clock::now();
+  mScene->fetchResults(true);
+  mLastFetchWaitMilliseconds =
+      std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  mSimulating = false;
+  mCompletedSteps++;
+
+  for (PxRigidActor* actor : mPendingActors) {
+    mScene->addActor(*actor);
+  }
+  mPendingActors.clear();
+
+  PxU32 count = 0;
+  PxActor** active = mScene->getActiveActors(count);
+  for (PxU32 x = 0; x < count; x++) {
+    const auto it = mInterpolatedPoses.find(static_cast<PxRigidActor*>(active[x]));
+    if (it == mInterpolatedPoses.end())
+      continue;
+    /* An actor that slept through the last steps did not move since its last pose, it is the pose of those steps too */
+    PhysXInterpolatedPose& pose = it->second;
+    const PxTransform older = mCompletedSteps - pose.Step == 1 ? pose.Poses[1] : pose.Poses[2];
+    pose.Poses = {older, pose.Poses[2], it->first->getGlobalPose()};
+    pose.Step = mCompletedSteps;
+  }
+}
+
+void PhysXSceneStepper::AddActor(PxRigidActor* actor)
+{
+  if (mSimulating)
+    mPendingActors.push_back(actor);
+  else
+    mScene->addActor(*actor);
+}
+
+void PhysXSceneStepper::RemoveActor(PxRigidActor* actor)
+{
+  if (mSimulating) {
+    Yeager::Log(WARNING, "PhysX actor removed while the step was not fetched yet!");
+    End();
+  }
+
+  UnregisterInterpolatedActor(actor);
+  mPendingActors.erase(std::remove(mPendingActors.begin(), mPendingActors.end(), actor), mPendingActors.end());
+  if (actor->getScene() == mScene)
+    mScene->removeActor(*actor);
+}
+
+void PhysXSceneStepper::RegisterInterpolatedActor(PxRigidActor* actor)
+{
+  PhysXInterpolatedPose pose;
+  pose.Poses.fill(actor->getGlobalPose());
+  pose.Step = mCompletedSteps;
+  mInterpolatedPoses[actor] = pose;
+}
+
+void PhysXSceneStepper::UnregisterInterpolatedActor(PxRigidActor* actor)
+{
+  mInterpolatedPoses.erase(actor);
+}
+
+PxTransform PhysXSceneStepper::GetInterpolatedPose(PxRigidActor* actor) const
+{
+  const auto it = mInterpolatedPoses.find(actor);
+  if (it == mInterpolatedPoses.end())
+    return actor->getGlobalPose();
+  const uint64_t started = mCompletedSteps + (mSimulating ? 1 : 0);
+  if (started < 2)
+    return it->second.AtStep(0);
+  return InterpolatePose(it->second.AtStep(started - 2), it->second.AtStep(started - 1), GetInterpolationAlpha());
+}
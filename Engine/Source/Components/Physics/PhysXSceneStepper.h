@@ -0,0 +1,115 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "PhysxAllocator.h"
+
+namespace Yeager {
+
+struct PhysXStepSettings {
+  /* Steps per second, the scene always advances by 1 / Frequency whatever the frame rate is */
+  float Frequency = 60.0f;
+  /* Steps taken in a single frame at most, the time left over is dropped so a slow frame does not slow down the next */
+  Uint MaxSteps = 4;
+};
+
+/**
+ * The last poses the simulation gave to a dynamic actor, the drawn pose is interpolated between two of them. Poses[2]
+ * is the pose after Step, the last step that moved the actor, and every pose before it is one step older. At the steps
+ * after Step the actor was at rest in Poses[2]
+ */
+struct PhysXInterpolatedPose {
+  std::array<physx::PxTransform, 3> Poses = {physx::PxTransform(physx::PxIdentity),
+                                             physx::PxTransform(physx::PxIdentity),
+                                             physx::PxTransform(physx::PxIdentity)};
+  uint64_t Step = 0;
+
+  const physx::PxTransform& AtStep(uint64_t step) const
+  {
+    if (step >= Step)
+      return Poses[2];
+    return Poses[2 - std::min<uint64_t>(Step - step, 2)];
+  }
+};
+
+/** @brief Linear between the positions and spherical between the rotations, alpha from 0 to 1 */
+extern physx::PxTransform InterpolatePose(const physx::PxTransform& from, const physx::PxTransform& to, float alpha);
+
+/**
+ * @brief Steps a PhysX scene at a fixed rate, with the last step of the frame running while the frame is drawn, and
+ * keeps the poses the drawn actors are interpolated from. Needs nothing but the scene, PhysXHandle owns one for the
+ * engine scene and the tests drive their own scenes with it
+ */
+class PhysXSceneStepper {
+ public:
+  void SetScene(physx::PxScene* scene) { mScene = scene; }
+  /** @brief Forgets the scene, its actors and the time stepped, the step in flight must be fetched before */
+  void Reset();
+
+  /**
+   * @brief Adds the frame time to the accumulator and takes as many fixed steps as it holds, up to the max steps of the
+   * settings. Every step but the last is waited for here, the last runs in the job system while the scene is drawn.
+   * Until End the actors report the poses of the previous step, and nothing may write to the scene or to its actors,
+   * PhysX rejects those writes during simulate. Actors added meanwhile wait for End to be added
+   */
+  void Start(float deltaTime);
+  /** @brief Waits for the step started by Start, applies its results and adds the actors waiting for it */
+  void End();
+
+  /** @brief Adds the actor to the scene, or once the step in flight is fetched */
+  void AddActor(physx::PxRigidActor* actor);
+  /** @brief Takes the actor out of the scene and out of the interpolation, the step in flight is fetched first */
+  void RemoveActor(physx::PxRigidActor* actor);
+
+  void RegisterInterpolatedActor(physx::PxRigidActor* actor);
+  void UnregisterInterpolatedActor(physx::PxRigidActor* actor);
+  /**
+   * @brief Pose of the actor at the render time, two steps behind the steps started plus the time left in the
+   * accumulator. The step in flight is not fetched yet while the frame is drawn, so the render time always stays a step
+   * behind the last fetched one, and it moves forward by the frame time whether a step was started or not
+   */
+  YEAGER_NODISCARD physx::PxTransform GetInterpolatedPose(physx::PxRigidActor* actor) const;
+
+  void SetSettings(const PhysXStepSettings& settings) { mSettings = settings; }
+  const PhysXStepSettings& GetSettings() const { return mSettings; }
+  /** @brief How far the render time is between the last two steps, from 0 to 1 */
+  float GetInterpolationAlpha() const { return mAccumulator * mSettings.Frequency; }
+  uint64_t GetCompletedSteps() const { return mCompletedSteps; }
+
+  bool IsSimulating() const { return mSimulating; }
+  /** @brief Time the calling thread was blocked in the last End, waiting for the step to finish */
+  float GetLastFetchWaitMilliseconds() const { return mLastFetchWaitMilliseconds; }
+
+ private:
+  physx::PxScene* mScene = YEAGER_NULLPTR;
+  PhysXStepSettings mSettings;
+  float mAccumulator = 0.0f;
+  uint64_t mCompletedSteps = 0;
+  bool mSimulating = false;
+  float mLastFetchWaitMilliseconds = 0.0f;
+  /* Added while a step was running, added to the scene after it is fetched */
+  std::vector<physx::PxRigidActor*> mPendingActors;
+  std::unordered_map<physx::PxRigidActor*, PhysXInterpolatedPose> mInterpolatedPoses;
+};
+
+}  // namespace Yeager
@@ -64,6 +64,7 @@ void PlayableObject::ProcessPlayableSetOfRules()
 
   if (m_SetOfRules.FollowPlayerPosition) {
     mEntityTransformation.position = camera->GetPosition() + m_SetOfRules.PositionOffset;
+    MarkTransformationDirty();
   }
 }
 
@@ -73,5 +74,6 @@ void PlayableAnimatedObject::ProcessPlayableSetOfRules()
 
   if (m_SetOfRules.FollowPlayerPosition) {
     mEntityTransformation.position = camera->GetPosition() + m_SetOfRules.PositionOffset;
+    MarkTransformationDirty();
   }
 }
\ No newline at end of file
@@ -1,15 +1,11 @@
 #include "Animation.h"
 using namespace Yeager;
 
-Animation::Animation(const String& name, const aiScene* scene, Uint index, AnimatedObject* model) : m_Name(name)
+Animation::Animation(const CompressedAnimationClip& clip, const AssimpNodeData& root, AnimatedObject* model)
+    : m_Duration(clip.Duration), m_TicksPerSecond(clip.TicksPerSecond), m_RootNode(root), m_Name(clip.Name)
 {
-  auto animation = scene->mAnimations[index];
-  m_Duration = animation->mDuration;
-  m_TicksPerSecond = animation->mTicksPerSecond;
-  aiMatrix4x4 globalTransformation = scene->mRootNode->mTransformation;
-  globalTransformation = globalTransformation.Inverse();
-  ReadHeirarchyData(m_RootNode, scene->mRootNode);
-  ReadMissingBones(animation, *model);
+  ReadMissingBones(clip, *model);
+  CompileSkeleton();
 }
 
 Bone* Animation::FindBone(const String& name)
@@ -22,22 +18,24 @@ Bone* Animation::FindBone(const String& name)
   }
 }
 
-void Animation::ReadMissingBones(const aiAnimation* animation, AnimatedObject& model)
+void Animation::ReadMissingBones(const CompressedAnimationClip& clip, AnimatedObject& model)
 {
-  int size = animation->mNumChannels;
   auto& BoneInfoMap = model.GetModelData()->GetBoneInfoMap();
   int& BoneCount = model.GetModelData()->GetBoneCount();
 
-  for (int x = 0; x < size; x++) {
-    auto channel = animation->mChannels[x];
-    String boneName = channel->mNodeName.data;
-
-    if (BoneInfoMap.find(boneName) == BoneInfoMap.end()) {
-      BoneInfoMap[boneName].ID = BoneCount;
+  m_Bones.reserve(clip.Tracks.size());
+  for (const auto& track : clip.Tracks) {
+    if (BoneInfoMap.find(track.Name) == BoneInfoMap.end()) {
+      BoneInfoMap[track.Name].ID = BoneCount;
       BoneCount++;
     }
 
-    m_Bones.push_back(Bone(channel->mNodeName.data, BoneInfoMap[channel->mNodeName.data].ID, channel));
+    std::vector<KeyPosition> positions;
+    std::vector<KeyRotation> rotations;
+    std::vector<KeyScale> scales;
+    DecompressBoneTrack(clip, track, positions, rotations, scales);
+    m_Bones.push_back(Bone(track.Name, BoneInfoMap[track.Name].ID, std::move(positions), std::move(rotations),
+                           std::move(scales)));
   }
 
   m_BoneInfoMap = BoneInfoMap;
@@ -56,4 +54,46 @@ void Animation::ReadHeirarchyData(AssimpNodeData& dest, const aiNode* src)
     ReadHeirarchyData(newData, src->mChildren[x]);
     dest.Children.push_back(newData);
   }
-}
\ No newline at end of file
+}
+void Animation::CompileSkeleton()
+{
+  m_Skeleton = CompiledSkeleton();
+
+  /* FindBone returns the first bone with the name, keep the same one when names repeat */
+  std::unordered_map<String, int> channels;
+  for (std::size_t x = 0; x < m_Bones.size(); x++) {
+    channels.emplace(m_Bones[x].GetBoneName(), static_cast<int>(x));
+  }
+
+  CompileSkeletonNode(m_RootNode, -1, channels);
+}
+
+void Animation::CompileSkeletonNode(const AssimpNodeData& node, int parent,
+                                    const std::unordered_map<String, int>& channels)
+{
+  const int index = static_cast<int>(m_Skeleton.GetNodeCount());
+
+  const auto channel = channels.find(node.Name);
+  int boneIndex = -1;
+  Matrix4 offset = Matrix4(1.0f);
+  const auto info = m_BoneInfoMap.find(node.Name);
+  if (info != m_BoneInfoMap.end()) {
+    if (info->second.ID >= 0 && info->second.ID < MAX_BONES) {
+      boneIndex = info->second.ID;
+      offset = info->second.OffSet;
+    } else {
+      Yeager::Log(WARNING, "Bone {} of animation {} has the id {}, out of the final matrices range!", node.Name, m_Name,
+                  info->second.ID);
+    }
+  }
+
+  m_Skeleton.ParentIndices.push_back(parent);
+  m_Skeleton.ChannelIndices.push_back(channel != channels.end() ? channel->second : -1);
+  m_Skeleton.BoneIndices.push_back(boneIndex);
+  m_Skeleton.BindTransforms.push_back(node.Transformation);
+  m_Skeleton.BoneOffsets.push_back(offset);
+
+  for (const auto& child : node.Children) {
+    CompileSkeletonNode(child, index, channels);
+  }
+}
@@ -22,7 +22,9 @@
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
 
+#include "AnimationCompression.h"
 #include "Bone.h"
+#include "Skeleton.h"
 #include "Components/Renderer/Objects/Object.h"
 
 #include <assimp/anim.h>
@@ -35,6 +37,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#define MAX_BONES 100
+
 namespace Yeager {
 
 struct AssimpNodeData {
@@ -47,7 +51,8 @@ struct AssimpNodeData {
 class Animation {
  public:
   Animation() = default;
-  Animation(const String& name, const aiScene* scene, Uint index, AnimatedObject* model);
+  /** @brief Decodes the clip into bones, the channels missing from the model bone map are added to it */
+  Animation(const CompressedAnimationClip& clip, const AssimpNodeData& root, AnimatedObject* model);
   ~Animation() {}
 
   Bone* FindBone(const String& name);
@@ -56,20 +61,26 @@ class Animation {
   inline float GetDuration() { return m_Duration; }
   inline const AssimpNodeData& GetRootNode() { return m_RootNode; }
   inline const std::map<String, BoneInfo>& GetBoneIDMap() { return m_BoneInfoMap; }
+  inline const CompiledSkeleton& GetSkeleton() const { return m_Skeleton; }
+  inline std::vector<Bone>& GetBones() { return m_Bones; }
 
   String GetName() const { return m_Name; }
   Uint GetIndex() { return m_Index; }
   void SetIndex(Uint index) { m_Index = index; }
 
+  static void ReadHeirarchyData(AssimpNodeData& dest, const aiNode* src);
+
  private:
-  void ReadMissingBones(const aiAnimation* animation, AnimatedObject& model);
-  void ReadHeirarchyData(AssimpNodeData& dest, const aiNode* src);
+  void ReadMissingBones(const CompressedAnimationClip& clip, AnimatedObject& model);
+  void CompileSkeleton();
+  void CompileSkeletonNode(const AssimpNodeData& node, int parent, const std::unordered_map<String, int>& channels);
   float m_Duration;
   int m_TicksPerSecond;
   std::vector<Bone> m_Bones;
   AssimpNodeData m_RootNode;
   String m_Name = YEAGER_NULL_LITERAL;
   std::map<String, BoneInfo> m_BoneInfoMap;
+  CompiledSkeleton m_Skeleton;
   Uint m_Index = 0;
 };
 
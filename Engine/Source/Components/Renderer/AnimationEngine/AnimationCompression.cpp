@@ -0,0 +1,275 @@
+#include "AnimationCompression.h"
+using namespace Yeager;
+
+static float KeyFactor(float lastTimeStamp, float nextTimeStamp, float time)
+{
+  const float frameDiff = nextTimeStamp - lastTimeStamp;
+  if (frameDiff <= 0.0f)
+    return 0.0f;
+  return std::clamp((time - lastTimeStamp) / frameDiff, 0.0f, 1.0f);
+}
+
+/* Angle between two rotations, atan2 keeps its precision on the tiny angles the tolerance is about */
+static float RotationAngle(const glm::quat& first, const glm::quat& second)
+{
+  const glm::quat delta = glm::conjugate(glm::normalize(first)) * glm::normalize(second);
+  return 2.0f * std::atan2(glm::length(Vector3(delta.x, delta.y, delta.z)), std::abs(delta.w));
+}
+
+/* Keys a segment may skip at most. Every candidate end checks the whole segment again, so without the cap a track the
+interpolation reproduces end to end costs the square of its keys, with it one key is kept every that many */
+static YEAGER_CONSTEXPR std::size_t sReduceMaxSegmentKeys = 128;
+
+template <typename KeyType, typename InterpolateFun, typename ErrorFun>
+static std::vector<KeyType> ReduceKeys(const std::vector<KeyType>& keys, float tolerance, InterpolateFun&& interpolate,
+                                       ErrorFun&& error)
+{
+  if (keys.size() <= 1)
+    return keys;
+
+  const bool constant = std::all_of(keys.begin() + 1, keys.end(),
+                                    [&](const KeyType& key) { return error(keys.front(), key) <= tolerance; });
+  if (constant)
+    return std::vector<KeyType>{keys.front()};
+
+  /* Greedy, the segment from the last kept key grows until one of the keys it skips moves out of the tolerance */
+  std::vector<KeyType> reduced;
+  reduced.push_back(keys.front());
+  std::size_t anchor = 0;
+  for (std::size_t candidate = 2; candidate < keys.size(); candidate++) {
+    bool fits = candidate - anchor - 1 <= sReduceMaxSegmentKeys;
+    for (std::size_t x = anchor + 1; x < candidate && fits; x++) {
+      fits = error(interpolate(keys[anchor], keys[candidate], keys[x].TimeStamp), keys[x]) <= tolerance;
+    }
+    if (!fits) {
+      reduced.push_back(keys[candidate - 1]);
+      anchor = candidate - 1;
+    }
+  }
+  reduced.push_back(keys.back());
+  return reduced;
+}
+
+std::vector<KeyPosition> Yeager::ReducePositionKeys(const std::vector<KeyPosition>& keys, float tolerance)
+{
+  return ReduceKeys(
+      keys, tolerance,
+      [](const KeyPosition& last, const KeyPosition& next, float time) {
+        const float factor = KeyFactor(last.TimeStamp, next.TimeStamp, time);
+        return KeyPosition{glm::mix(last.Position, next.Position, factor), time};
+      },
+      [](const KeyPosition& first, const KeyPosition& second) {
+        return glm::length(first.Position - second.Position);
+      });
+}
+
+std::vector<KeyRotation> Yeager::ReduceRotationKeys(const std::vector<KeyRotation>& keys, float tolerance)
+{
+  return ReduceKeys(
+      keys, tolerance,
+      [](const KeyRotation& last, const KeyRotation& next, float time) {
+        const float factor = KeyFactor(last.TimeStamp, next.TimeStamp, time);
+        return KeyRotation{glm::normalize(glm::slerp(last.Orientation, next.Orientation, factor)), time};
+      },
+      [](const KeyRotation& first, const KeyRotation& second) {
+        return RotationAngle(first.Orientation, second.Orientation);
+      });
+}
+
+std::vector<KeyScale> Yeager::ReduceScaleKeys(const std::vector<KeyScale>& keys, float tolerance)
+{
+  return ReduceKeys(
+      keys, tolerance,
+      [](const KeyScale& last, const KeyScale& next, float time) {
+        const float factor = KeyFactor(last.TimeStamp, next.TimeStamp, time);
+        return KeyScale{glm::mix(last.Scale, next.Scale, factor), time};
+      },
+      [](const KeyScale& first, const KeyScale& second) { return glm::length(first.Scale - second.Scale); });
+}
+
+static uint16_t QuantizeKeyTime(const CompressedAnimationClip& clip, float time)
+{
+  if (clip.TimeStep <= 0.0f)
+    return 0;
+  const float step = std::round((time - clip.TimeMin) / clip.TimeStep);
+  return static_cast<uint16_t>(std::clamp(step, 0.0f, 65535.0f));
+}
+
+static float DequantizeKeyTime(const CompressedAnimationClip& clip, uint16_t time)
+{
+  return clip.TimeMin + static_cast<float>(time) * clip.TimeStep;
+}
+
+/**
+ * Exporters sample the clips on a fixed frame rate, so the smallest gap between two key times is usually a frame and every
+ * time is a whole number of them. Those times are stored exactly, a key moved in time by even a fraction of a frame shows as
+ * a jump on fast tracks. Clips out of the grid fall back to the range of times split in 65535 steps
+ */
+static float FindKeyTimeStep(std::vector<float>& times)
+{
+  std::sort(times.begin(), times.end());
+  times.erase(std::unique(times.begin(), times.end()), times.end());
+  if (times.size() < 2)
+    return 0.0f;
+
+  const float extent = times.back() - times.front();
+  float frame = extent;
+  for (std::size_t x = 1; x < times.size(); x++) {
+    frame = std::min(frame, times[x] - times[x - 1]);
+  }
+
+  const bool onGrid = frame > 0.0f && extent / frame <= 65535.0f && std::all_of(times.begin(), times.end(), [&](float time) {
+                        const float steps = (time - times.front()) / frame;
+                        return std::abs(steps - std::round(steps)) <= 0.001f;
+                      });
+  return onGrid ? frame : extent / 65535.0f;
+}
+
+template <typename KeyType, typename ValueFun>
+static QuantizedVectorTrack QuantizeVectorTrack(const CompressedAnimationClip& clip, const std::vector<KeyType>& keys,
+                                                ValueFun&& value)
+{
+  QuantizedVectorTrack track;
+  if (keys.empty())
+    return track;
+
+  Vector3 min = value(keys.front());
+  Vector3 max = min;
+  for (const auto& key : keys) {
+    min = glm::min(min, value(key));
+    max = glm::max(max, value(key));
+  }
+  track.Min = min;
+  track.Extent = max - min;
+
+  track.Times.reserve(keys.size());
+  track.Values.reserve(keys.size() * 3);
+  for (const auto& key : keys) {
+    track.Times.push_back(QuantizeKeyTime(clip, key.TimeStamp));
+    const Vector3 vector = value(key);
+    for (Uint x = 0; x < 3; x++) {
+      /* Flat axes store zero and decode to the minimum */
+      track.Values.push_back(track.Extent[x] > 0.0f ? QuantizeUnorm16((vector[x] - min[x]) / track.Extent[x]) : 0);
+    }
+  }
+  return track;
+}
+
+static Vector3 DequantizeTrackValue(const QuantizedVectorTrack& track, std::size_t key)
+{
+  Vector3 value;
+  for (Uint x = 0; x < 3; x++) {
+    value[x] = track.Min[x] + DequantizeUnorm16(track.Values[key * 3 + x]) * track.Extent[x];
+  }
+  return value;
+}
+
+std::size_t CompressedAnimationClip::GetKeyCount() const
+{
+  std::size_t count = 0;
+  for (const auto& track : Tracks) {
+    count += track.Positions.Times.size() + track.Rotations.Times.size() + track.Scales.Times.size();
+  }
+  return count;
+}
+
+std::size_t CompressedAnimationClip::GetKeyBytes() const
+{
+  std::size_t bytes = 0;
+  for (const auto& track : Tracks) {
+    bytes += (track.Positions.Times.size() + track.Positions.Values.size()) * sizeof(uint16_t);
+    bytes += track.Rotations.Times.size() * sizeof(uint16_t) + track.Rotations.Values.size() * sizeof(PackedQuat48);
+    bytes += (track.Scales.Times.size() + track.Scales.Values.size()) * sizeof(uint16_t);
+  }
+  return bytes;
+}
+
+CompressedAnimationClip Yeager::CompressAnimationClip(const aiAnimation* animation,
+                                                      const AnimationCompressionSettings& settings)
+{
+  std::vector<Bone> channels;
+  channels.reserve(animation->mNumChannels);
+  for (Uint x = 0; x < animation->mNumChannels; x++) {
+    channels.push_back(Bone(animation->mChannels[x]->mNodeName.data, -1, animation->mChannels[x]));
+  }
+  return CompressAnimationClip(animation->mName.C_Str(), animation->mDuration, animation->mTicksPerSecond, channels,
+                               settings);
+}
+
+CompressedAnimationClip Yeager::CompressAnimationClip(const String& name, float duration, int ticksPerSecond,
+                                                      const std::vector<Bone>& channels,
+                                                      const AnimationCompressionSettings& settings)
+{
+  CompressedAnimationClip clip;
+  clip.Name = name;
+  clip.Duration = duration;
+  clip.TicksPerSecond = ticksPerSecond;
+
+  std::vector<float> times;
+  std::size_t sourceBytes = 0;
+  auto measure = [&](const auto& keys) {
+    for (const auto& key : keys) {
+      times.push_back(key.TimeStamp);
+    }
+    sourceBytes += keys.size() * sizeof(typename std::decay_t<decltype(keys)>::value_type);
+  };
+  for (const auto& channel : channels) {
+    measure(channel.GetPositionKeys());
+    measure(channel.GetRotationKeys());
+    measure(channel.GetScaleKeys());
+  }
+  const std::size_t sourceKeys = times.size();
+  if (!times.empty()) {
+    clip.TimeMin = *std::min_element(times.begin(), times.end());
+    clip.TimeStep = FindKeyTimeStep(times);
+  }
+
+  clip.Tracks.reserve(channels.size());
+  for (const auto& channel : channels) {
+    CompressedBoneTrack track;
+    track.Name = channel.GetBoneName();
+
+    const std::vector<KeyPosition> positions = ReducePositionKeys(channel.GetPositionKeys(), settings.PositionTolerance);
+    track.Positions = QuantizeVectorTrack(clip, positions, [](const KeyPosition& key) { return key.Position; });
+
+    const std::vector<KeyRotation> rotations = ReduceRotationKeys(channel.GetRotationKeys(), settings.RotationTolerance);
+    track.Rotations.Times.reserve(rotations.size());
+    track.Rotations.Values.reserve(rotations.size());
+    for (const auto& key : rotations) {
+      track.Rotations.Times.push_back(QuantizeKeyTime(clip, key.TimeStamp));
+      track.Rotations.Values.push_back(PackQuat48(key.Orientation));
+    }
+
+    const std::vector<KeyScale> scales = ReduceScaleKeys(channel.GetScaleKeys(), settings.ScaleTolerance);
+    track.Scales = QuantizeVectorTrack(clip, scales, [](const KeyScale& key) { return key.Scale; });
+
+    clip.Tracks.push_back(std::move(track));
+  }
+
+  Yeager::LogDebug(INFO, "Compressed animation {}, {} keys ({} bytes) into {} keys ({} bytes)", clip.Name, sourceKeys,
+                   sourceBytes, clip.GetKeyCount(), clip.GetKeyBytes());
+  return clip;
+}
+
+void Yeager::DecompressBoneTrack(const CompressedAnimationClip& clip, const CompressedBoneTrack& track,
+                                 std::vector<KeyPosition>& positions, std::vector<KeyRotation>& rotations,
+                                 std::vector<KeyScale>& scales)
+{
+  positions.resize(track.Positions.Times.size());
+  for (std::size_t x = 0; x < positions.size(); x++) {
+    positions[x].Position = DequantizeTrackValue(track.Positions, x);
+    positions[x].TimeStamp = DequantizeKeyTime(clip, track.Positions.Times[x]);
+  }
+
+  rotations.resize(track.Rotations.Times.size());
+  for (std::size_t x = 0; x < rotations.size(); x++) {
+    rotations[x].Orientation = UnpackQuat48(track.Rotations.Values[x]);
+    rotations[x].TimeStamp = DequantizeKeyTime(clip, track.Rotations.Times[x]);
+  }
+
+  scales.resize(track.Scales.Times.size());
+  for (std::size_t x = 0; x < scales.size(); x++) {
+    scales[x].Scale = DequantizeTrackValue(track.Scales, x);
+    scales[x].TimeStamp = DequantizeKeyTime(clip, track.Scales.Times[x]);
+  }
+}
@@ -0,0 +1,99 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "Bone.h"
+#include "Common/Math/Quantization.h"
+
+namespace Yeager {
+
+/* How far the reduced track may drift from the source keys, in model units for positions and scales, radians for rotations */
+struct AnimationCompressionSettings {
+  float PositionTolerance = 0.0005f;
+  float RotationTolerance = 0.0005f;
+  float ScaleTolerance = 0.0005f;
+};
+
+/**
+ * @brief Removes every key that the interpolation between the kept keys reproduces within the tolerance. The first and last
+ * keys are always kept so the clamping before and after the track does not change, constant tracks end with a single key
+ */
+YEAGER_NODISCARD extern std::vector<KeyPosition> ReducePositionKeys(const std::vector<KeyPosition>& keys, float tolerance);
+YEAGER_NODISCARD extern std::vector<KeyRotation> ReduceRotationKeys(const std::vector<KeyRotation>& keys, float tolerance);
+YEAGER_NODISCARD extern std::vector<KeyScale> ReduceScaleKeys(const std::vector<KeyScale>& keys, float tolerance);
+
+/* Positions or scales of a track as unorm16 relative to the range the track covers, three values per key */
+struct QuantizedVectorTrack {
+  Vector3 Min = Vector3(0.0f);
+  Vector3 Extent = Vector3(0.0f);
+  std::vector<uint16_t> Times;
+  std::vector<uint16_t> Values;
+};
+
+struct QuantizedRotationTrack {
+  std::vector<uint16_t> Times;
+  std::vector<PackedQuat48> Values;
+};
+
+struct CompressedBoneTrack {
+  String Name = YEAGER_NULL_LITERAL;
+  QuantizedVectorTrack Positions;
+  QuantizedRotationTrack Rotations;
+  QuantizedVectorTrack Scales;
+};
+
+/**
+ * @brief A animation after the key reduction and the quantization. Key times are stored as TimeMin + time * TimeStep, when
+ * the keys of the clip are sampled on a fixed frame rate the step is that frame and the times are exact, otherwise the range
+ * of times is split in 65535 steps
+ */
+struct CompressedAnimationClip {
+  String Name = YEAGER_NULL_LITERAL;
+  float Duration = 0.0f;
+  int TicksPerSecond = 0;
+  float TimeMin = 0.0f;
+  float TimeStep = 0.0f;
+  std::vector<CompressedBoneTrack> Tracks;
+
+  YEAGER_NODISCARD std::size_t GetKeyCount() const;
+  /** @brief Bytes taken by the keys, the names and ranges are not counted */
+  YEAGER_NODISCARD std::size_t GetKeyBytes() const;
+};
+
+/**
+ * @brief Reads the channels of the animation into the same keys the bones sample, reduces and quantizes them. The source
+ * key count and size are logged against the compressed ones
+ */
+YEAGER_NODISCARD extern CompressedAnimationClip CompressAnimationClip(const aiAnimation* animation,
+                                                                      const AnimationCompressionSettings& settings);
+/** @brief Same as above with the channels already read into bones, named after the nodes they drive */
+YEAGER_NODISCARD extern CompressedAnimationClip CompressAnimationClip(const String& name, float duration,
+                                                                      int ticksPerSecond,
+                                                                      const std::vector<Bone>& channels,
+                                                                      const AnimationCompressionSettings& settings);
+extern void DecompressBoneTrack(const CompressedAnimationClip& clip, const CompressedBoneTrack& track,
+                                std::vector<KeyPosition>& positions, std::vector<KeyRotation>& rotations,
+                                std::vector<KeyScale>& scales);
+
+}  // namespace Yeager
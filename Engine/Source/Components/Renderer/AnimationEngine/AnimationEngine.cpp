@@ -9,24 +9,34 @@ AnimationEngine::AnimationEngine()
 void AnimationEngine::Initialize()
 {
   m_CurrentTime = 0.0f;
-  m_FinalBoneMatrices.reserve(MAX_BONES);
-  for (int x = 0; x < MAX_BONES; x++) {
-    m_FinalBoneMatrices.push_back(Matrix4(1.0f));
-  }
+  /* Initialize runs again when the animations are built, assign keeps the buffer at MAX_BONES */
+  m_FinalBoneMatrices.assign(MAX_BONES, Matrix4(1.0f));
 }
 
-void AnimationEngine::LoadAnimationsFromFile(const String& path, AnimatedObject* model)
+void AnimationEngine::LoadAnimationsFromFile(const String& path, AnimatedObject* model,
+                                             const std::optional<AnimationCacheEntry>& cache)
 {
-  Assimp::Importer imp;
-  const aiScene* scene = imp.ReadFile(path, aiProcess_Triangulate);
-
-  if (!scene || !scene->mRootNode) {
-    Yeager::Log(ERROR, "Assimp cannot load animation file! Path {}", path);
+  AnimationCacheData data;
+  if (!cache.has_value() || !AnimationCache::Load(cache.value(), &data)) {
+    Assimp::Importer imp;
+    const aiScene* scene = imp.ReadFile(path, aiProcess_Triangulate);
+
+    if (!scene || !scene->mRootNode) {
+      Yeager::Log(ERROR, "Assimp cannot load animation file! Path {}", path);
+      return;
+    }
+
+    Animation::ReadHeirarchyData(data.RootNode, scene->mRootNode);
+    for (Uint animations = 0; animations < scene->mNumAnimations; animations++) {
+      data.Clips.push_back(CompressAnimationClip(scene->mAnimations[animations], AnimationCompressionSettings()));
+    }
+
+    if (cache.has_value())
+      AnimationCache::Write(cache.value(), data);
   }
 
-  for (Uint animations = 0; animations < scene->mNumAnimations; animations++) {
-    aiString name = scene->mAnimations[animations]->mName;
-    Animation anim(String(name.C_Str()), scene, animations, model);
+  for (Uint animations = 0; animations < data.Clips.size(); animations++) {
+    Animation anim(data.Clips[animations], data.RootNode, model);
     anim.SetIndex(animations);
     m_Animations.push_back(anim);
   }
@@ -52,7 +62,7 @@ void AnimationEngine::UpdateAnimation(float dt)
   if (m_CurrentAnimation) {
     m_CurrentTime += m_CurrentAnimation->GetTicksPerSecond() * dt;
     m_CurrentTime = fmod(m_CurrentTime, m_CurrentAnimation->GetDuration());
-    CalculateBoneTransform(&m_CurrentAnimation->GetRootNode(), Matrix4(1.0f));
+    CalculateBoneTransform();
   }
 }
 void AnimationEngine::PlayAnimation(Animation* animation)
@@ -62,35 +72,11 @@ void AnimationEngine::PlayAnimation(Animation* animation)
   m_PlayingAnimation = true;
 }
 
-void AnimationEngine::CalculateBoneTransform(const AssimpNodeData* node, Matrix4 parentTrans)
+void AnimationEngine::CalculateBoneTransform()
 {
-  if (!m_AnimationsLoaded)
+  if (!m_AnimationsLoaded || !m_CurrentAnimation)
     return;
 
-  assert(node);
-
-  String nodeName = node->Name;
-
-  Matrix4 nodeTransform = node->Transformation;
-
-  Bone* Bone = m_CurrentAnimation->FindBone(nodeName);
-
-  if (Bone) {
-    Bone->Update(m_CurrentTime);
-    nodeTransform = Bone->GetLocalTransform();
-  }
-
-  Matrix4 globalTransformation = parentTrans * nodeTransform;
-
-  auto boneInfoMap = m_CurrentAnimation->GetBoneIDMap();
-
-  if (boneInfoMap.find(nodeName) != boneInfoMap.end()) {
-    int index = boneInfoMap[nodeName].ID;
-    Matrix4 offset = boneInfoMap[nodeName].OffSet;
-    m_FinalBoneMatrices[index] = globalTransformation * offset;
-  }
-
-  for (int x = 0; x < node->ChildrenCount; x++) {
-    CalculateBoneTransform(&node->Children[x], globalTransformation);
-  }
-}
\ No newline at end of file
+  EvaluateSkeleton(m_CurrentAnimation->GetSkeleton(), m_CurrentAnimation->GetBones(), m_CurrentTime, m_GlobalTransforms,
+                   m_FinalBoneMatrices);
+}
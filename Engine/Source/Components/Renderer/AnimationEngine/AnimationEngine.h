@@ -23,8 +23,7 @@
 #include "Common/Utils/Utilities.h"
 
 #include "Animation.h"
-
-#define MAX_BONES 100
+#include "Components/Kernel/Caching/AnimationCache.h"
 
 namespace Yeager {
 class AnimationEngine {
@@ -32,13 +31,20 @@ class AnimationEngine {
   AnimationEngine();
 
   void Initialize();
-  void LoadAnimationsFromFile(const String& path, AnimatedObject* model);
+  /**
+   * @brief Builds the animations of the file from the animation cache, on a miss the file is read with assimp, its clips
+   * compressed and the cache written for the next load
+   */
+  void LoadAnimationsFromFile(const String& path, AnimatedObject* model,
+                              const std::optional<AnimationCacheEntry>& cache = std::nullopt);
 
   void UpdateAnimation(float dt);
   void PlayAnimation(Animation* animation);
   void PlayAnimation(Uint index);
-  void CalculateBoneTransform(const AssimpNodeData* node, Matrix4 parentTrans);
-  std::vector<Matrix4> GetFinalBoneMatrices() const { return m_FinalBoneMatrices; }
+  /** @brief Evaluates the compiled skeleton of the current animation at the current time into the final bone matrices */
+  void CalculateBoneTransform();
+  /** @brief View on the matrices, valid until the next Initialize */
+  std::span<const Matrix4> GetFinalBoneMatrices() const { return m_FinalBoneMatrices; }
   std::vector<Animation>* GetAnimations() { return &m_Animations; }
 
   bool IsAnimationsLoaded() const { return m_AnimationsLoaded; }
@@ -47,6 +53,8 @@ class AnimationEngine {
  protected:
   std::vector<Animation> m_Animations;
   std::vector<Matrix4> m_FinalBoneMatrices;
+  /* Model space transform of each node of the skeleton, only grows so the evaluation does not allocate */
+  std::vector<Matrix4> m_GlobalTransforms;
   Animation* m_CurrentAnimation = YEAGER_NULLPTR;
   float m_CurrentTime;
   float m_DeltaTime;
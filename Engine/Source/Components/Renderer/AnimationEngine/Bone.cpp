@@ -34,92 +34,96 @@ Bone::Bone(const String& Name, int ID, const aiNodeAnim* Channel) : m_Name(Name)
   }
 }
 
+Bone::Bone(const String& Name, int ID, std::vector<KeyPosition> Positions, std::vector<KeyRotation> Rotations,
+           std::vector<KeyScale> Scales)
+    : m_Positions(std::move(Positions)),
+      m_Rotations(std::move(Rotations)),
+      m_Scales(std::move(Scales)),
+      m_LocalTransform(1.0f),
+      m_Name(Name),
+      m_ID(ID)
+{
+  m_NumPositions = static_cast<int>(m_Positions.size());
+  m_NumRotations = static_cast<int>(m_Rotations.size());
+  m_NumScalings = static_cast<int>(m_Scales.size());
+}
+
 void Bone::Update(float AnimationTime)
 {
-  Matrix4 trans = InterpolatePosition(AnimationTime);
-  Matrix4 rotation = InterpolateRotation(AnimationTime);
-  Matrix4 scale = InterpolateScaling(AnimationTime);
-  m_LocalTransform = trans * rotation * scale;
+  const Vector3 position = InterpolatePosition(AnimationTime);
+  const glm::quat rotation = InterpolateRotation(AnimationTime);
+  const Vector3 scale = InterpolateScaling(AnimationTime);
+
+  /* Same as translate * rotate * scale, built straight from the columns instead of multiplying three matrices */
+  m_LocalTransform = glm::toMat4(rotation);
+  m_LocalTransform[0] = m_LocalTransform[0] * scale.x;
+  m_LocalTransform[1] = m_LocalTransform[1] * scale.y;
+  m_LocalTransform[2] = m_LocalTransform[2] * scale.z;
+  m_LocalTransform[3] = Vector4(position, 1.0f);
 }
 
 int Bone::GetPositionIndex(float AnimationTime)
 {
-  for (int index = 0; index < m_NumPositions - 1; ++index) {
-    if (AnimationTime < m_Positions[index + 1].TimeStamp) {
-      return index;
-    }
-  }
-  Yeager::Log(WARNING, "Warning! Bone cannot find positions index associated!");
-  assert(0);
+  return FindKeyIndex(m_Positions, AnimationTime, m_PositionCursor);
 }
 
 int Bone::GetRotationIndex(float AnimationTime)
 {
-  for (int index = 0; index < m_NumRotations - 1; ++index) {
-    if (AnimationTime < m_Rotations[index + 1].TimeStamp) {
-      return index;
-    }
-  }
-  Yeager::Log(WARNING, "Warning! Bone cannot find rotation index associated!");
-  assert(0);
+  return FindKeyIndex(m_Rotations, AnimationTime, m_RotationCursor);
 }
 
 int Bone::GetScaleIndex(float AnimationTime)
 {
-  for (int index = 0; index < m_NumScalings - 1; ++index) {
-    if (AnimationTime < m_Scales[index + 1].TimeStamp) {
-      return index;
-    }
-  }
-  Yeager::Log(WARNING, "Warning! Bone cannot find scaling index associated!");
-  assert(0);
+  return FindKeyIndex(m_Scales, AnimationTime, m_ScaleCursor);
 }
 
 float Bone::GetScaleFactor(float LastTimeStamp, float NextTimeStamp, float AnimationTime)
 {
-  float scaleFator = 0.0f;
-  float midWay = AnimationTime - LastTimeStamp;
-  float frameDiff = NextTimeStamp - LastTimeStamp;
-  scaleFator = midWay / frameDiff;
-  return scaleFator;
+  const float frameDiff = NextTimeStamp - LastTimeStamp;
+  if (frameDiff <= 0.0f)
+    return 0.0f;
+  /* Clamped so times outside the keys hold the first or last key instead of extrapolating */
+  return std::clamp((AnimationTime - LastTimeStamp) / frameDiff, 0.0f, 1.0f);
 }
 
-Matrix4 Bone::InterpolatePosition(float AnimationTime)
+Vector3 Bone::InterpolatePosition(float AnimationTime)
 {
-  if (m_NumPositions == 1) {
-    return glm::translate(Matrix4(1.0f), m_Positions[0].Position);
+  if (m_NumPositions == 0) {
+    return Vector3(0.0f);
+  } else if (m_NumPositions == 1) {
+    return m_Positions[0].Position;
   }
 
   int p0Index = GetPositionIndex(AnimationTime);
   int p1Index = p0Index + 1;
   float scaleFactor = GetScaleFactor(m_Positions[p0Index].TimeStamp, m_Positions[p1Index].TimeStamp, AnimationTime);
-  Vector3 finalPos = glm::mix(m_Positions[p0Index].Position, m_Positions[p1Index].Position, scaleFactor);
-  return glm::translate(Matrix4(1.0f), finalPos);
+  return glm::mix(m_Positions[p0Index].Position, m_Positions[p1Index].Position, scaleFactor);
 }
 
-Matrix4 Bone::InterpolateRotation(float AnimationTime)
+glm::quat Bone::InterpolateRotation(float AnimationTime)
 {
-  if (m_NumRotations == 1) {
-    auto rotation = glm::normalize(m_Rotations[0].Orientation);
-    return glm::toMat4(rotation);
+  if (m_NumRotations == 0) {
+    return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+  } else if (m_NumRotations == 1) {
+    return glm::normalize(m_Rotations[0].Orientation);
   }
 
   int p0Index = GetRotationIndex(AnimationTime);
   int p1Index = p0Index + 1;
   float scaleFactor = GetScaleFactor(m_Rotations[p0Index].TimeStamp, m_Rotations[p1Index].TimeStamp, AnimationTime);
   glm::quat finalRot = glm::slerp(m_Rotations[p0Index].Orientation, m_Rotations[p1Index].Orientation, scaleFactor);
-  finalRot = glm::normalize(finalRot);
-  return glm::toMat4(finalRot);
+  return glm::normalize(finalRot);
 }
 
-Matrix4 Bone::InterpolateScaling(float AnimationTime)
+Vector3 Bone::InterpolateScaling(float AnimationTime)
 {
-  if (m_NumScalings == 1) {
-    return glm::scale(Matrix4(1.0f), m_Scales[0].Scale);
+  if (m_NumScalings == 0) {
+    return Vector3(1.0f);
+  } else if (m_NumScalings == 1) {
+    return m_Scales[0].Scale;
   }
   int p0Index = GetScaleIndex(AnimationTime);
   int p1Index = p0Index + 1;
   float scaleFactor = GetScaleFactor(m_Scales[p0Index].TimeStamp, m_Scales[p1Index].TimeStamp, AnimationTime);
-  Vector3 finalScale = glm::mix(m_Scales[p0Index].Scale, m_Scales[p1Index].Scale, scaleFactor);
-  return glm::scale(Matrix4(1.0f), finalScale);
+  return glm::mix(m_Scales[p0Index].Scale, m_Scales[p1Index].Scale, scaleFactor);
 }
@@ -33,6 +33,36 @@
 #include <glm/gtx/quaternion.hpp>
 
 namespace Yeager {
+
+/**
+ * @brief Finds the key at or before the time, starting from the cursor. Times before the first key return 0 and times
+ * at or after the last key return the one before the last, so there is always a next key to interpolate towards
+ */
+template <typename KeyType>
+YEAGER_NODISCARD int FindKeyIndex(const std::vector<KeyType>& keys, float time, int& cursor)
+{
+  const int count = static_cast<int>(keys.size());
+  if (count < 2)
+    return 0;
+
+  const auto contains = [&](int index) {
+    return index >= 0 && index < count - 1 && (index == 0 || keys[index].TimeStamp <= time) &&
+           (index == count - 2 || time < keys[index + 1].TimeStamp);
+  };
+
+  if (contains(cursor))
+    return cursor;
+  if (contains(cursor + 1))
+    return ++cursor;
+  if (contains(cursor - 1))
+    return --cursor;
+
+  const auto next = std::upper_bound(keys.begin() + 1, keys.end() - 1, time,
+                                     [](float value, const KeyType& key) { return value < key.TimeStamp; });
+  cursor = static_cast<int>(next - keys.begin()) - 1;
+  return cursor;
+}
+
 struct KeyPosition {
   Vector3 Position;
   float TimeStamp;
@@ -51,22 +81,29 @@ struct KeyScale {
 class Bone {
  public:
   Bone(const String& Name, int ID, const aiNodeAnim* Channel);
+  /** @brief Builds the bone from keys already read, used by the decompressed animation clips */
+  Bone(const String& Name, int ID, std::vector<KeyPosition> Positions, std::vector<KeyRotation> Rotations,
+       std::vector<KeyScale> Scales);
 
   void Update(float AnimationTime);
 
   constexpr Matrix4 GetLocalTransform() { return m_LocalTransform; }
-  String GetBoneName() { return m_Name; }
+  String GetBoneName() const { return m_Name; }
   constexpr int GetBoneID() { return m_ID; }
+  const std::vector<KeyPosition>& GetPositionKeys() const { return m_Positions; }
+  const std::vector<KeyRotation>& GetRotationKeys() const { return m_Rotations; }
+  const std::vector<KeyScale>& GetScaleKeys() const { return m_Scales; }
 
+  /** @brief Index of the key at or before the time, the following key is the one interpolated towards */
   int GetPositionIndex(float AnimationTime);
   int GetRotationIndex(float AnimationTime);
   int GetScaleIndex(float AnimationTime);
 
  private:
   float GetScaleFactor(float LastTimeStamp, float NextTimeStamp, float AnimationTime);
-  Matrix4 InterpolatePosition(float AnimationTime);
-  Matrix4 InterpolateRotation(float AnimationTime);
-  Matrix4 InterpolateScaling(float AnimationTime);
+  Vector3 InterpolatePosition(float AnimationTime);
+  glm::quat InterpolateRotation(float AnimationTime);
+  Vector3 InterpolateScaling(float AnimationTime);
 
   std::vector<KeyPosition> m_Positions;
   std::vector<KeyRotation> m_Rotations;
@@ -75,6 +112,12 @@ class Bone {
   int m_NumRotations;
   int m_NumScalings;
 
+  /* Last key used by each track. Playback moves forward (or backward) one key at a time, so the cursor or one of its
+  neighbours is almost always the answer, seeks fall back to a binary search */
+  int m_PositionCursor = 0;
+  int m_RotationCursor = 0;
+  int m_ScaleCursor = 0;
+
   Matrix4 m_LocalTransform;
   String m_Name;
   int m_ID;
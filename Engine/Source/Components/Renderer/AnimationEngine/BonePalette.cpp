@@ -0,0 +1,78 @@
+#include "BonePalette.h"
+#include "Components/Renderer/GL/UploadRing.h"
+using namespace Yeager;
+
+BonePaletteBuffer::~BonePaletteBuffer()
+{
+  Destroy();
+}
+
+void BonePaletteBuffer::Clear()
+{
+  mUsed = 0;
+}
+
+Uint BonePaletteBuffer::Allocate(Uint boneCount)
+{
+  const Uint offset = mUsed;
+  mUsed += boneCount;
+  if (mStaging.size() < mUsed)
+    mStaging.resize(std::max<std::size_t>(mUsed, mStaging.size() * 2), Matrix4(1.0f));
+  return offset;
+}
+
+std::span<Matrix4> BonePaletteBuffer::GetPalette(Uint offset, Uint boneCount)
+{
+  return std::span<Matrix4>(mStaging.data() + offset, boneCount);
+}
+
+void BonePaletteBuffer::Upload(UploadRing* ring)
+{
+  if (mUsed == 0)
+    return;
+
+  if (mTexture == 0)
+    GL_CALL(glGenTextures(1, &mTexture));
+
+  /* A fresh range every frame, the draws of the last frames keep reading theirs until the ring wraps over them */
+  const RingAllocation range =
+      ring->Upload(mStaging.data(), mUsed * sizeof(Matrix4), ring->GetOffsetAlignment(GL_TEXTURE_BUFFER));
+
+  GL_CALL(glActiveTexture(GL_TEXTURE0 + YEAGER_BONE_PALETTE_TEXTURE_UNIT));
+  GL_CALL(glBindTexture(GL_TEXTURE_BUFFER, mTexture));
+  GL_CALL(glTexBufferRange(GL_TEXTURE_BUFFER, GL_RGBA32F, range.Buffer, range.Offset, range.Size));
+  GL_CALL(glActiveTexture(GL_TEXTURE0));
+}
+
+void BonePaletteBuffer::Destroy()
+{
+  if (mTexture != 0) {
+    GL_CALL(glDeleteTextures(1, &mTexture));
+    mTexture = 0;
+  }
+}
+
+void Yeager::SkinVerticesReference(std::span<const AnimatedVertexData> vertices, std::span<const Matrix4> palette,
+                                   std::span<Vector3> output)
+{
+  const std::size_t count = std::min(vertices.size(), output.size());
+  for (std::size_t v = 0; v < count; v++) {
+    const AnimatedVertexData& vertex = vertices[v];
+    const Vector4 position = Vector4(vertex.Position, 1.0f);
+    Vector4 total = Vector4(0.0f);
+
+    for (Uint x = 0; x < MAX_BONE_INFLUENCE; x++) {
+      const int bone = vertex.BonesIDs[x];
+      if (bone == -1)
+        continue;
+
+      if (bone < 0 || static_cast<std::size_t>(bone) >= palette.size()) {
+        total = position;
+        break;
+      }
+
+      total += palette[bone] * position * vertex.Weights[x];
+    }
+    output[v] = Vector3(total);
+  }
+}
@@ -0,0 +1,74 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "Components/Renderer/Objects/VertexData.h"
+
+#include <span>
+
+/* Texture unit the palette stays bound to, the mesh textures are bound from the unit 0 upwards */
+#define YEAGER_BONE_PALETTE_TEXTURE_UNIT 15
+
+namespace Yeager {
+
+class UploadRing;
+
+/**
+ * @brief The final bone matrices of every animated object packed in a single array. It is uploaded once per frame to a
+ * range of the upload ring read through a texture buffer, and the animated shaders fetch their matrices from it
+ * starting at the offset of the object, instead of receiving a hundred mat4 uniforms on every draw
+ */
+class BonePaletteBuffer {
+ public:
+  BonePaletteBuffer() = default;
+  ~BonePaletteBuffer();
+
+  /** @brief Drops the palettes of the last frame, the memory is kept */
+  void Clear();
+  /**
+   * @brief Reserves the palette of a object and returns its offset in matrices. Every allocation must happen before the
+   * palettes are written, the staging array can move while growing
+   */
+  Uint Allocate(Uint boneCount);
+  YEAGER_NODISCARD std::span<Matrix4> GetPalette(Uint offset, Uint boneCount);
+  YEAGER_NODISCARD std::span<const Matrix4> GetStaging() const { return std::span<const Matrix4>(mStaging.data(), mUsed); }
+
+  /** @brief Copies the used part of the staging array to the ring and binds its range to the texture unit */
+  void Upload(UploadRing* ring);
+  void Destroy();
+
+ private:
+  std::vector<Matrix4> mStaging;
+  Uint mUsed = 0;
+  GLuint mTexture = 0;
+};
+
+/**
+ * @brief Skins the positions on the CPU the same way the animated shaders do, so the GPU path can be validated headless
+ * against the palette of each object. Influences with the id -1 are skipped, ids outside the palette keep the bind pose
+ */
+extern void SkinVerticesReference(std::span<const AnimatedVertexData> vertices, std::span<const Matrix4> palette,
+                                  std::span<Vector3> output);
+
+}  // namespace Yeager
@@ -0,0 +1,27 @@
+#include "Skeleton.h"
+using namespace Yeager;
+
+void Yeager::EvaluateSkeleton(const CompiledSkeleton& skeleton, std::vector<Bone>& bones, float time,
+                              std::vector<Matrix4>& globalTransforms, std::span<Matrix4> finalMatrices)
+{
+  const std::size_t nodeCount = skeleton.GetNodeCount();
+  if (globalTransforms.size() < nodeCount)
+    globalTransforms.resize(nodeCount);
+
+  for (std::size_t x = 0; x < nodeCount; x++) {
+    const int channel = skeleton.ChannelIndices[x];
+    Matrix4 nodeTransform = skeleton.BindTransforms[x];
+    if (channel >= 0) {
+      bones[channel].Update(time);
+      nodeTransform = bones[channel].GetLocalTransform();
+    }
+
+    /* Parents come before their children, so the parent global transform is already computed */
+    const int parent = skeleton.ParentIndices[x];
+    globalTransforms[x] = parent >= 0 ? globalTransforms[parent] * nodeTransform : nodeTransform;
+
+    const int bone = skeleton.BoneIndices[x];
+    if (bone >= 0 && static_cast<std::size_t>(bone) < finalMatrices.size())
+      finalMatrices[bone] = globalTransforms[x] * skeleton.BoneOffsets[x];
+  }
+}
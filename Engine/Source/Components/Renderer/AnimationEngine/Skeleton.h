@@ -0,0 +1,56 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "Bone.h"
+
+#include <span>
+
+namespace Yeager {
+
+/**
+ * @brief The node hierarchy of the animation flattened into arrays, every parent comes before its children so the pose is
+ * evaluated with a single loop, without recursion, string compares or map lookups
+ */
+struct CompiledSkeleton {
+  /* Index of the parent node, -1 on the root */
+  std::vector<int> ParentIndices;
+  /* Index of the bone (animation channel) that drives the node, -1 when the node keeps its bind transform */
+  std::vector<int> ChannelIndices;
+  /* Slot of the node in the final bone matrices, -1 when no vertex is skinned to it */
+  std::vector<int> BoneIndices;
+  std::vector<Matrix4> BindTransforms;
+  std::vector<Matrix4> BoneOffsets;
+
+  YEAGER_NODISCARD std::size_t GetNodeCount() const { return ParentIndices.size(); }
+};
+
+/**
+ * @brief Samples the bones at the time and composes the hierarchy into the final matrices. The global transforms only
+ * grow, so a buffer kept between calls makes the evaluation free of allocations. Final slots no node writes are left as
+ * they are
+ */
+extern void EvaluateSkeleton(const CompiledSkeleton& skeleton, std::vector<Bone>& bones, float time,
+                             std::vector<Matrix4>& globalTransforms, std::span<Matrix4> finalMatrices);
+
+}  // namespace Yeager
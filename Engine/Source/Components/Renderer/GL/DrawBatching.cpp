@@ -0,0 +1,159 @@
+#include "DrawBatching.h"
+using namespace Yeager;
+
+RangeAllocator::RangeAllocator(Uint capacity)
+{
+  Grow(capacity);
+}
+
+Uint RangeAllocator::Allocate(Uint count)
+{
+  if (count == 0)
+    return sInvalidOffset;
+
+  /* The smallest free range that fits, the lowest offset between the ones of the same size */
+  const auto best = mFreeBySize.lower_bound(std::make_pair(count, 0u));
+  if (best == mFreeBySize.end())
+    return sInvalidOffset;
+
+  const Uint offset = best->second;
+  const Uint size = best->first;
+  EraseFreeRange(mFreeByOffset.find(offset));
+  if (size > count)
+    InsertFreeRange(offset + count, size - count);
+
+  mAllocated.emplace(offset, count);
+  mUsed += count;
+  return offset;
+}
+
+bool RangeAllocator::Free(Uint offset)
+{
+  const auto allocation = mAllocated.find(offset);
+  if (allocation == mAllocated.end())
+    return false;
+
+  const Uint count = allocation->second;
+  mAllocated.erase(allocation);
+  mUsed -= count;
+  InsertFreeRange(offset, count);
+  return true;
+}
+
+void RangeAllocator::Grow(Uint capacity)
+{
+  if (capacity <= mCapacity)
+    return;
+  const Uint end = mCapacity;
+  mCapacity = capacity;
+  InsertFreeRange(end, capacity - end);
+}
+
+Uint RangeAllocator::GetLargestFreeRange() const
+{
+  return mFreeBySize.empty() ? 0 : mFreeBySize.rbegin()->first;
+}
+
+std::map<Uint, Uint>::iterator RangeAllocator::EraseFreeRange(std::map<Uint, Uint>::iterator range)
+{
+  mFreeBySize.erase(std::make_pair(range->second, range->first));
+  return mFreeByOffset.erase(range);
+}
+
+void RangeAllocator::InsertFreeRange(Uint offset, Uint count)
+{
+  auto next = mFreeByOffset.lower_bound(offset);
+  if (next != mFreeByOffset.end() && offset + count == next->first) {
+    count += next->second;
+    next = EraseFreeRange(next);
+  }
+  if (next != mFreeByOffset.begin()) {
+    const auto previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      offset = previous->first;
+      count += previous->second;
+      EraseFreeRange(previous);
+    }
+  }
+  mFreeByOffset.emplace(offset, count);
+  mFreeBySize.emplace(count, offset);
+}
+
+void IndirectBatchBuilder::Clear()
+{
+  mBatches.clear();
+  mCommands.clear();
+}
+
+void IndirectBatchBuilder::Add(uint64_t key, GeometryPool* pool, const DrawElementsIndirectCommand& command)
+{
+  if (command.Count == 0 || command.InstanceCount == 0)
+    return;
+
+  if (mBatches.empty() || mBatches.back().Key != key || mBatches.back().Pool != pool) {
+    IndirectDrawBatch batch;
+    batch.Key = key;
+    batch.Pool = pool;
+    batch.FirstCommand = static_cast<Uint>(mCommands.size());
+    mBatches.push_back(batch);
+  }
+  mCommands.push_back(command);
+  mBatches.back().CommandCount++;
+}
+
+void IndirectBatchBuilder::Compact()
+{
+  /* The groups are found by a linear search, a draw rarely has more than a few materials */
+  mScratchBatches.clear();
+  mGroupOfBatch.resize(mBatches.size());
+  for (Uint x = 0; x < mBatches.size(); x++) {
+    const IndirectDrawBatch& batch = mBatches[x];
+    Uint group = 0;
+    while (group < mScratchBatches.size() &&
+           (mScratchBatches[group].Key != batch.Key || mScratchBatches[group].Pool != batch.Pool))
+      group++;
+    if (group == mScratchBatches.size()) {
+      IndirectDrawBatch head;
+      head.Key = batch.Key;
+      head.Pool = batch.Pool;
+      mScratchBatches.push_back(head);
+    }
+    mGroupOfBatch[x] = group;
+    mScratchBatches[group].CommandCount += batch.CommandCount;
+  }
+
+  /* Each group gets a contiguous range, the commands keep the order they were added in */
+  Uint first = 0;
+  for (auto& group : mScratchBatches) {
+    group.FirstCommand = first;
+    first += group.CommandCount;
+    group.CommandCount = 0;
+  }
+  mScratchCommands.resize(mCommands.size());
+  for (Uint x = 0; x < mBatches.size(); x++) {
+    IndirectDrawBatch& group = mScratchBatches[mGroupOfBatch[x]];
+    const auto commands = GetCommands(mBatches[x]);
+    std::copy(commands.begin(), commands.end(), mScratchCommands.begin() + group.FirstCommand + group.CommandCount);
+    group.CommandCount += static_cast<Uint>(commands.size());
+  }
+
+  mCommands.clear();
+  for (auto& group : mScratchBatches) {
+    const Uint begin = static_cast<Uint>(mCommands.size());
+    for (Uint x = group.FirstCommand; x < group.FirstCommand + group.CommandCount; x++) {
+      const DrawElementsIndirectCommand& command = mScratchCommands[x];
+      if (mCommands.size() > begin) {
+        DrawElementsIndirectCommand& last = mCommands.back();
+        if (last.BaseVertex == command.BaseVertex && last.InstanceCount == command.InstanceCount &&
+            last.BaseInstance == command.BaseInstance && last.FirstIndex + last.Count == command.FirstIndex) {
+          last.Count += command.Count;
+          continue;
+        }
+      }
+      mCommands.push_back(command);
+    }
+    group.FirstCommand = begin;
+    group.CommandCount = static_cast<Uint>(mCommands.size()) - begin;
+  }
+  mBatches.swap(mScratchBatches);
+}
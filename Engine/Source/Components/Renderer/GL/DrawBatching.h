@@ -0,0 +1,118 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <set>
+#include <span>
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+class GeometryPool;
+
+/** @brief Layout read by glMultiDrawElementsIndirect, the fields must stay in this order */
+struct DrawElementsIndirectCommand {
+  Uint Count = 0;
+  Uint InstanceCount = 0;
+  Uint FirstIndex = 0;
+  int BaseVertex = 0;
+  Uint BaseInstance = 0;
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "The indirect command must match the OpenGL layout!");
+
+/**
+ * @brief Free list over a range of elements, best fit. Freed ranges are merged with their free neighbours, so the
+ * amount of free ranges only grows with the fragmentation, not with the allocations. Only does the bookkeeping, the
+ * owner places the data at the returned offsets
+ */
+class RangeAllocator {
+ public:
+  static YEAGER_CONSTEXPR Uint sInvalidOffset = std::numeric_limits<Uint>::max();
+
+  RangeAllocator(Uint capacity = 0);
+
+  /** @brief Returns the offset of the first element of the range, or sInvalidOffset when no free range is big enough */
+  Uint Allocate(Uint count);
+  /** @brief Returns false when no range was allocated at the offset */
+  bool Free(Uint offset);
+  /** @brief Adds the elements between the old capacity and the new one as free, the capacity never shrinks */
+  void Grow(Uint capacity);
+
+  YEAGER_NODISCARD Uint GetCapacity() const { return mCapacity; }
+  YEAGER_NODISCARD Uint GetUsed() const { return mUsed; }
+  YEAGER_NODISCARD Uint GetAllocationCount() const { return mAllocated.size(); }
+  YEAGER_NODISCARD Uint GetFreeRangeCount() const { return mFreeByOffset.size(); }
+  YEAGER_NODISCARD Uint GetLargestFreeRange() const;
+
+ private:
+  void InsertFreeRange(Uint offset, Uint count);
+  std::map<Uint, Uint>::iterator EraseFreeRange(std::map<Uint, Uint>::iterator range);
+
+  /* The free ranges by offset, to find the neighbours, and by size then offset, to find the best fit */
+  std::map<Uint, Uint> mFreeByOffset;
+  std::set<std::pair<Uint, Uint>> mFreeBySize;
+  std::unordered_map<Uint, Uint> mAllocated;
+  Uint mCapacity = 0;
+  Uint mUsed = 0;
+};
+
+/** @brief Commands drawn by a single call, they share the pool and the key (shader, material) given to the builder */
+struct IndirectDrawBatch {
+  uint64_t Key = 0;
+  GeometryPool* Pool = YEAGER_NULLPTR;
+  Uint FirstCommand = 0;
+  Uint CommandCount = 0;
+};
+
+/**
+ * @brief Gathers the indirect commands of the draws, consecutive commands with the same key and pool go to the same
+ * batch. Only works on the CPU side, the geometry arena uploads and draws the batches
+ */
+class IndirectBatchBuilder {
+ public:
+  /** @brief Removes the commands and batches, the memory is kept */
+  void Clear();
+  /** @brief Commands without indices or instances are dropped, they would draw nothing */
+  void Add(uint64_t key, GeometryPool* pool, const DrawElementsIndirectCommand& command);
+  /**
+   * @brief Groups the commands by pool and key, keeping the order in which each group first appeared, so every group
+   * becomes a single batch. Inside a batch, commands reading consecutive indices with the same base vertex and
+   * instances are merged. The draw order changes, only for draws where it does not matter (depth tested)
+   */
+  void Compact();
+
+  YEAGER_NODISCARD const std::vector<IndirectDrawBatch>& GetBatches() const { return mBatches; }
+  YEAGER_NODISCARD const std::vector<DrawElementsIndirectCommand>& GetCommands() const { return mCommands; }
+  YEAGER_NODISCARD std::span<const DrawElementsIndirectCommand> GetCommands(const IndirectDrawBatch& batch) const
+  {
+    return std::span<const DrawElementsIndirectCommand>(mCommands).subspan(batch.FirstCommand, batch.CommandCount);
+  }
+
+ private:
+  std::vector<IndirectDrawBatch> mBatches;
+  std::vector<DrawElementsIndirectCommand> mCommands;
+  std::vector<IndirectDrawBatch> mScratchBatches;
+  std::vector<DrawElementsIndirectCommand> mScratchCommands;
+  std::vector<Uint> mGroupOfBatch;
+};
+
+}  // namespace Yeager
@@ -0,0 +1,151 @@
+#include "GeometryArena.h"
+using namespace Yeager;
+
+GeometryPool::GeometryPool(const VertexFormatDescriptor* format) : ElementBufferRenderer(), mFormat(format)
+{
+  GenBuffers();
+  BindBuffers();
+  ApplyVertexFormat(*mFormat);
+  UnbindBuffers();
+}
+
+GeometryPool::~GeometryPool()
+{
+  if (mVertexRanges.GetAllocationCount() > 0)
+    Yeager::LogDebug(WARNING, "Geometry pool destroyed with {} meshes still in it!",
+                     mVertexRanges.GetAllocationCount());
+}
+
+void GeometryPool::GrowBuffer(GLuint* buffer, std::size_t size, std::size_t newSize)
+{
+  /* The copy targets are used so the element buffer binding of the vertex arrays is never touched */
+  GLuint grown = 0;
+  GL_CALL(glGenBuffers(1, &grown));
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, grown));
+  GL_CALL(glBufferData(GL_COPY_WRITE_BUFFER, newSize, YEAGER_NULLPTR, GL_STATIC_DRAW));
+  if (size > 0) {
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, *buffer));
+    GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size));
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+  }
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+  GL_CALL(glDeleteBuffers(1, buffer));
+  *buffer = grown;
+
+  /* The vertex array still points to the old buffers, both are attached again */
+  BindBuffers();
+  ApplyVertexFormat(*mFormat);
+  UnbindBuffers();
+}
+
+Uint GeometryPool::AllocateRange(RangeAllocator* ranges, Uint count, GLuint* buffer, std::size_t elementSize,
+                                 Uint minCapacity)
+{
+  const Uint offset = ranges->Allocate(count);
+  if (offset != RangeAllocator::sInvalidOffset)
+    return offset;
+
+  /* Doubles, so a series of uploads only copies the buffer a logarithmic amount of times */
+  const Uint capacity = std::max({ranges->GetCapacity() * 2, ranges->GetCapacity() + count, minCapacity});
+  GrowBuffer(buffer, std::size_t(ranges->GetCapacity()) * elementSize, std::size_t(capacity) * elementSize);
+  ranges->Grow(capacity);
+  return ranges->Allocate(count);
+}
+
+GeometryAllocation GeometryPool::Allocate(const void* vertices, Uint vertexCount, std::span<const GLuint> indices)
+{
+  GeometryAllocation allocation;
+  if (vertexCount == 0 || indices.empty())
+    return allocation;
+
+  const std::size_t stride = mFormat->Stride;
+  allocation.Pool = this;
+  allocation.VertexCount = vertexCount;
+  allocation.IndexCount = static_cast<Uint>(indices.size());
+  allocation.BaseVertex = AllocateRange(&mVertexRanges, vertexCount, &mVbo, stride, YEAGER_GEOMETRY_POOL_MIN_VERTICES);
+  allocation.FirstIndex =
+      AllocateRange(&mIndexRanges, allocation.IndexCount, &mEbo, sizeof(GLuint), YEAGER_GEOMETRY_POOL_MIN_INDICES);
+
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, mVbo));
+  GL_CALL(glBufferSubData(GL_COPY_WRITE_BUFFER, std::size_t(allocation.BaseVertex) * stride,
+                          std::size_t(vertexCount) * stride, vertices));
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, mEbo));
+  GL_CALL(glBufferSubData(GL_COPY_WRITE_BUFFER, std::size_t(allocation.FirstIndex) * sizeof(GLuint),
+                          indices.size_bytes(), indices.data()));
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+  return allocation;
+}
+
+void GeometryPool::Free(const GeometryAllocation& allocation)
+{
+  /* The data stays in the buffers until another mesh is uploaded over it, the draws still in flight can read it */
+  if (!mVertexRanges.Free(allocation.BaseVertex) || !mIndexRanges.Free(allocation.FirstIndex))
+    Yeager::Log(WARNING, "Freeing geometry that was not allocated in the pool! Vertex {} index {}",
+                allocation.BaseVertex, allocation.FirstIndex);
+}
+
+GeometryArena::~GeometryArena()
+{
+  Destroy();
+}
+
+GeometryAllocation GeometryArena::Allocate(const VertexFormatDescriptor& format, const void* vertices,
+                                           Uint vertexCount, std::span<const GLuint> indices)
+{
+  std::unique_ptr<GeometryPool>& pool = mPools[&format];
+  if (!pool)
+    pool = std::make_unique<GeometryPool>(&format);
+  return pool->Allocate(vertices, vertexCount, indices);
+}
+
+void GeometryArena::Free(GeometryAllocation* allocation)
+{
+  if (allocation->IsValid())
+    allocation->Pool->Free(*allocation);
+  *allocation = GeometryAllocation();
+}
+
+void GeometryArena::BeginFrame(bool multiDrawIndirect, UploadRing* ring)
+{
+  bMultiDrawIndirect = multiDrawIndirect && GLAD_GL_VERSION_4_3;
+  mRing = ring;
+  mDrawCalls = 0;
+}
+
+std::size_t GeometryArena::UploadCommands(std::span<const DrawElementsIndirectCommand> commands)
+{
+  const RingAllocation range =
+      mRing->Upload(commands.data(), commands.size_bytes(), mRing->GetOffsetAlignment(GL_DRAW_INDIRECT_BUFFER));
+  GL_CALL(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, range.Buffer));
+  return range.Offset;
+}
+
+void GeometryArena::Draw(const IndirectBatchBuilder& builder, const IndirectDrawBatch& batch)
+{
+  const auto commands = builder.GetCommands(batch);
+  if (commands.empty() || batch.Pool == YEAGER_NULLPTR)
+    return;
+
+  batch.Pool->BindVertexArray();
+  if (bMultiDrawIndirect) {
+    const std::size_t offset = UploadCommands(commands);
+    GL_CALL(glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(offset),
+                                        static_cast<GLsizei>(commands.size()), 0));
+    mDrawCalls++;
+    return;
+  }
+
+  /* OpenGL 3.3, the base instance is ignored, the instanced shaders read their transforms from an offset uniform */
+  for (const auto& command : commands) {
+    const void* indices = reinterpret_cast<const void*>(std::size_t(command.FirstIndex) * sizeof(GLuint));
+    GL_CALL(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(command.Count), GL_UNSIGNED_INT,
+                                              indices, static_cast<GLsizei>(command.InstanceCount),
+                                              command.BaseVertex));
+    mDrawCalls++;
+  }
+}
+
+void GeometryArena::Destroy()
+{
+  mPools.clear();
+}
@@ -0,0 +1,123 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <span>
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "Components/Renderer/GL/DrawBatching.h"
+#include "Components/Renderer/GL/OpenGLRender.h"
+
+/* Size of the buffers of a geometry pool when it is created, they double when an upload does not fit */
+#define YEAGER_GEOMETRY_POOL_MIN_VERTICES (1 << 16)
+#define YEAGER_GEOMETRY_POOL_MIN_INDICES (1 << 18)
+
+namespace Yeager {
+
+class GeometryPool;
+
+/** @brief Where the vertices and indices of a mesh were placed inside a geometry pool */
+struct GeometryAllocation {
+  GeometryPool* Pool = YEAGER_NULLPTR;
+  Uint BaseVertex = 0;
+  Uint VertexCount = 0;
+  Uint FirstIndex = 0;
+  Uint IndexCount = 0;
+
+  YEAGER_NODISCARD bool IsValid() const { return Pool != YEAGER_NULLPTR; }
+  YEAGER_NODISCARD DrawElementsIndirectCommand BuildCommand(Uint instances) const
+  {
+    return DrawElementsIndirectCommand{IndexCount, instances, FirstIndex, static_cast<int>(BaseVertex), 0};
+  }
+};
+
+/**
+ * @brief One vertex array, vertex buffer and element buffer shared by every mesh of the same vertex format. The indices
+ * of each mesh stay relative to its own vertices, the draws add the base vertex of the allocation
+ */
+class GeometryPool : public ElementBufferRenderer {
+ public:
+  GeometryPool(const VertexFormatDescriptor* format);
+  ~GeometryPool();
+
+  /** @brief Copies the mesh into the pool, growing the buffers when needed. Empty meshes are not placed */
+  GeometryAllocation Allocate(const void* vertices, Uint vertexCount, std::span<const GLuint> indices);
+  void Free(const GeometryAllocation& allocation);
+
+  YEAGER_NODISCARD const VertexFormatDescriptor* GetFormat() const { return mFormat; }
+  YEAGER_NODISCARD const RangeAllocator& GetVertexRanges() const { return mVertexRanges; }
+  YEAGER_NODISCARD const RangeAllocator& GetIndexRanges() const { return mIndexRanges; }
+
+ private:
+  /** @brief Replaces the buffer by a bigger one holding the same data, the vertex array is pointed to the new one */
+  void GrowBuffer(GLuint* buffer, std::size_t size, std::size_t newSize);
+  Uint AllocateRange(RangeAllocator* ranges, Uint count, GLuint* buffer, std::size_t elementSize, Uint minCapacity);
+
+  const VertexFormatDescriptor* mFormat = YEAGER_NULLPTR;
+  RangeAllocator mVertexRanges;
+  RangeAllocator mIndexRanges;
+};
+
+/**
+ * @brief Geometry pools keyed by vertex format, and the submission of the batches. With the OpenGL 4 renderer a batch
+ * is drawn by one glMultiDrawElementsIndirect, otherwise (OpenGL 3.3) by a loop of glDrawElementsInstancedBaseVertex,
+ * still without binding anything between the commands
+ */
+class GeometryArena {
+ public:
+  GeometryArena() = default;
+  ~GeometryArena();
+
+  /**
+   * @brief Places the mesh in the pool of its format. The format must outlive the arena, the pools are keyed by its
+   * address (the descriptors of VertexFormats.h). Returns an invalid allocation for empty meshes
+   */
+  GeometryAllocation Allocate(const VertexFormatDescriptor& format, const void* vertices, Uint vertexCount,
+                              std::span<const GLuint> indices);
+  /** @brief Gives the ranges back to the pool of the allocation and resets it, nothing happens when it is invalid */
+  static void Free(GeometryAllocation* allocation);
+
+  /**
+   * @brief Chooses how the batches of the frame are drawn, the indirect draws are only used when requested and the
+   * context supports them (OpenGL 4.3). Their commands are written to the ring given
+   */
+  void BeginFrame(bool multiDrawIndirect, UploadRing* ring);
+  /** @brief Draws the commands of the batch with the vertex array of its pool, the shader and textures must be set */
+  void Draw(const IndirectBatchBuilder& builder, const IndirectDrawBatch& batch);
+  void Destroy();
+
+  YEAGER_NODISCARD bool IsMultiDrawIndirect() const { return bMultiDrawIndirect; }
+  YEAGER_NODISCARD Uint GetPoolCount() const { return mPools.size(); }
+  /** @brief Draw calls issued since the start of the frame */
+  YEAGER_NODISCARD Uint GetDrawCallCount() const { return mDrawCalls; }
+
+ private:
+  /** @brief Copies the commands to the ring and binds it as the indirect buffer, returns the byte offset they are at */
+  std::size_t UploadCommands(std::span<const DrawElementsIndirectCommand> commands);
+
+  std::unordered_map<const VertexFormatDescriptor*, std::unique_ptr<GeometryPool>> mPools;
+  UploadRing* mRing = YEAGER_NULLPTR;
+  Uint mDrawCalls = 0;
+  bool bMultiDrawIndirect = false;
+};
+
+}  // namespace Yeager
@@ -1,6 +1,61 @@
 #include "OpenGLRender.h"
 using namespace Yeager;
 
+GLuint GLStateCache::sProgram = 0;
+GLuint GLStateCache::sVertexArray = 0;
+GLenum GLStateCache::sPolygonMode = 0;
+int GLStateCache::sCullFace = -1;
+
+void GLStateCache::Invalidate()
+{
+  sProgram = 0;
+  sVertexArray = 0;
+  sPolygonMode = 0;
+  sCullFace = -1;
+}
+
+void GLStateCache::UseProgram(GLuint program)
+{
+  if (program != sProgram || program == 0) {
+    GL_CALL(glUseProgram(program));
+    sProgram = program;
+  }
+}
+
+void GLStateCache::SetPolygonMode(GLenum mode)
+{
+  if (mode != sPolygonMode) {
+    GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, mode));
+    sPolygonMode = mode;
+  }
+}
+
+void GLStateCache::SetCullFace(bool enabled)
+{
+  if (sCullFace != static_cast<int>(enabled)) {
+    if (enabled) {
+      GL_CALL(glEnable(GL_CULL_FACE));
+    } else {
+      GL_CALL(glDisable(GL_CULL_FACE));
+    }
+    sCullFace = static_cast<int>(enabled);
+  }
+}
+
+void GLStateCache::BindVertexArray(GLuint vao)
+{
+  if (vao != sVertexArray || vao == 0) {
+    GL_CALL(glBindVertexArray(vao));
+    sVertexArray = vao;
+  }
+}
+
+void GLStateCache::ForgetVertexArray(GLuint vao)
+{
+  if (vao == sVertexArray)
+    sVertexArray = 0;
+}
+
 SimpleRenderer::~SimpleRenderer()
 {
   if (bIsGenerated)
@@ -19,20 +74,20 @@ void SimpleRenderer::GenBuffers()
 void SimpleRenderer::BindBuffers()
 {
   if (bIsGenerated) {
-    GL_CALL(glBindVertexArray(mVao));
+    GLStateCache::BindVertexArray(mVao);
     GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, mVbo));
   }
 }
 
 void SimpleRenderer::UnbindVertexArray()
 {
-  GL_CALL(glBindVertexArray(NULL));
+  GLStateCache::BindVertexArray(0);
 }
 
 void SimpleRenderer::UnbindBuffers()
 {
   GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, NULL));
-  GL_CALL(glBindVertexArray(NULL));
+  UnbindVertexArray();
 }
 
 void SimpleRenderer::VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
@@ -44,6 +99,27 @@ void SimpleRenderer::VertexAttribPointer(GLuint index, GLint size, GLenum type,
   }
 }
 
+void SimpleRenderer::VertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer)
+{
+  if (bIsGenerated) {
+    GL_CALL(glEnableVertexAttribArray(index));
+    GL_CALL(glVertexAttribIPointer(index, size, type, stride, pointer));
+  }
+}
+
+void SimpleRenderer::ApplyVertexFormat(const VertexFormatDescriptor& format)
+{
+  for (const auto& attribute : format.Attributes) {
+    const void* pointer = reinterpret_cast<const void*>(attribute.Offset);
+    if (attribute.bInteger) {
+      VertexAttribIPointer(attribute.Index, attribute.Components, attribute.Type, format.Stride, pointer);
+    } else {
+      VertexAttribPointer(attribute.Index, attribute.Components, attribute.Type,
+                          attribute.bNormalized ? GL_TRUE : GL_FALSE, format.Stride, pointer);
+    }
+  }
+}
+
 void SimpleRenderer::BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
 {
   if (bIsGenerated) {
@@ -71,6 +147,7 @@ void SimpleRenderer::DeleteBuffers()
 {
   if (bIsGenerated) {
     GL_CALL(glDeleteBuffers(1, &mVbo));
+    GLStateCache::ForgetVertexArray(mVao);
     GL_CALL(glDeleteVertexArrays(1, &mVao));
     bIsGenerated = false;
   }
@@ -100,7 +177,7 @@ void ElementBufferRenderer::Draw(GLenum mode, GLsizei count, GLenum type, const
 void SimpleRenderer::BindVertexArray()
 {
   if (bIsGenerated)
-    GL_CALL(glBindVertexArray(mVao));
+    GLStateCache::BindVertexArray(mVao);
 }
 
 void ElementBufferRenderer::GenBuffers()
@@ -116,7 +193,7 @@ void ElementBufferRenderer::GenBuffers()
 void ElementBufferRenderer::BindBuffers()
 {
   if (bIsGenerated) {
-    GL_CALL(glBindVertexArray(mVao));
+    GLStateCache::BindVertexArray(mVao);
     GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, mVbo));
     GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEbo));
   }
@@ -133,7 +210,94 @@ void ElementBufferRenderer::DeleteBuffers()
   if (bIsGenerated) {
     GL_CALL(glDeleteBuffers(1, &mVbo));
     GL_CALL(glDeleteBuffers(1, &mEbo));
+    GLStateCache::ForgetVertexArray(mVao);
     GL_CALL(glDeleteVertexArrays(1, &mVao));
     bIsGenerated = false;
   }
 }
+
+InstanceStream::~InstanceStream()
+{
+  Destroy();
+}
+
+void InstanceStream::PackTransform(const Matrix4& transform, InstanceTransformLayout::Enum layout, float* output)
+{
+  if (layout == InstanceTransformLayout::eMATRIX4x4) {
+    std::memcpy(output, glm::value_ptr(transform), sizeof(Matrix4));
+    return;
+  }
+  /* glm is column major, the rows are gathered from the columns */
+  for (Uint row = 0; row < 3; row++) {
+    for (Uint column = 0; column < 4; column++) {
+      output[row * 4 + column] = transform[column][row];
+    }
+  }
+}
+
+Matrix4 InstanceStream::UnpackTransform(const float* input, InstanceTransformLayout::Enum layout)
+{
+  Matrix4 transform(1.0f);
+  if (layout == InstanceTransformLayout::eMATRIX4x4) {
+    std::memcpy(glm::value_ptr(transform), input, sizeof(Matrix4));
+    return transform;
+  }
+  for (Uint row = 0; row < 3; row++) {
+    for (Uint column = 0; column < 4; column++) {
+      transform[column][row] = input[row * 4 + column];
+    }
+  }
+  return transform;
+}
+
+void InstanceStream::BeginFrame(UploadRing* ring, Uint reserve)
+{
+  mRing = ring;
+  mRange = ring->Allocate(std::size_t(reserve) * GetInstanceSize(), ring->GetOffsetAlignment(GL_TEXTURE_BUFFER));
+  mCapacity = mRange.IsValid() ? reserve : 0;
+  mUsed = 0;
+}
+
+Uint InstanceStream::Push(std::span<const Matrix4> transforms)
+{
+  const Uint count = static_cast<Uint>(transforms.size());
+  if (mUsed + count > mCapacity) {
+    Yeager::LogDebug(WARNING, "Instance stream has no room for {} instances this frame!", count);
+    return sInvalidOffset;
+  }
+
+  const Uint offset = mUsed;
+  const Uint floats = GetTexelsPerInstance() * 4;
+  float* output = reinterpret_cast<float*>(mRange.Data + offset * GetInstanceSize());
+  for (Uint x = 0; x < count; x++) {
+    PackTransform(transforms[x], mLayout, output + x * floats);
+  }
+  mUsed += count;
+  return offset;
+}
+
+void InstanceStream::Bind()
+{
+  if (mUsed == 0)
+    return;
+
+  const std::size_t size = mUsed * GetInstanceSize();
+  mRing->Commit(mRange, size);
+
+  if (mTexture == 0)
+    GL_CALL(glGenTextures(1, &mTexture));
+  GL_CALL(glActiveTexture(GL_TEXTURE0 + YEAGER_INSTANCE_STREAM_TEXTURE_UNIT));
+  GL_CALL(glBindTexture(GL_TEXTURE_BUFFER, mTexture));
+  GL_CALL(glTexBufferRange(GL_TEXTURE_BUFFER, GL_RGBA32F, mRange.Buffer, mRange.Offset, size));
+  GL_CALL(glActiveTexture(GL_TEXTURE0));
+}
+
+void InstanceStream::Destroy()
+{
+  if (mTexture != 0) {
+    GL_CALL(glDeleteTextures(1, &mTexture));
+    mTexture = 0;
+  }
+  mRange = RingAllocation();
+  mCapacity = mUsed = 0;
+}
@@ -18,12 +18,57 @@
 
 #pragma once
 
+#include <span>
 #include "Common/Utils/Common.h"
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
 
+#include "Components/Renderer/GL/UploadRing.h"
+
+/* Texture unit the instance transforms stay bound to, the bone palette uses the one above */
+#define YEAGER_INSTANCE_STREAM_TEXTURE_UNIT 14
+
 namespace Yeager {
 
+/**
+ * @brief Keeps track of the last OpenGL state set through it, so redundant calls to the driver are skipped. Anyone changing
+ * the state behind its back (ImGui, raw gl calls) must call Invalidate before relying on it again
+ */
+class GLStateCache {
+ public:
+  static void Invalidate();
+  static void UseProgram(GLuint program);
+  static void SetPolygonMode(GLenum mode);
+  static void SetCullFace(bool enabled);
+  /** @brief The renderers bind their vertex arrays through it, meshes sharing a geometry pool skip the bind */
+  static void BindVertexArray(GLuint vao);
+  /** @brief Deleting the bound vertex array sets the binding back to zero */
+  static void ForgetVertexArray(GLuint vao);
+
+ private:
+  static GLuint sProgram;
+  static GLuint sVertexArray;
+  static GLenum sPolygonMode;
+  static int sCullFace;  // -1 unknown, 0 disabled, 1 enabled
+};
+
+/** @brief One vertex attribute, where it is inside the vertex and how the GPU must read it */
+struct VertexAttributeFormat {
+  GLuint Index = 0;
+  GLint Components = 0;
+  GLenum Type = GL_FLOAT;
+  bool bNormalized = false;
+  /* Read by the shader as ivec or uvec, set with glVertexAttribIPointer so the values are not converted to float */
+  bool bInteger = false;
+  std::size_t Offset = 0;
+};
+
+/** @brief Layout of a interleaved vertex buffer, applied to the vertex array by SimpleRenderer::ApplyVertexFormat */
+struct VertexFormatDescriptor {
+  GLsizei Stride = 0;
+  std::vector<VertexAttributeFormat> Attributes;
+};
+
 /**
  * @brief The simple renderer of OpenGL is a class that holds rendering information. It uses the glDrawArrays and dont have must optimizantion  
  */
@@ -41,12 +86,17 @@ class SimpleRenderer {
   virtual void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
   virtual void VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
                                    const void* pointer);
+  virtual void VertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer);
+  /** @brief Enables and sets every attribute of the format, the vertex buffer must be bound */
+  virtual void ApplyVertexFormat(const VertexFormatDescriptor& format);
 
   virtual void DeleteBuffers();
 
   virtual void SubBufferData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
   virtual void Draw(GLenum mode, GLint first, GLsizei count);
 
+  YEAGER_FORCE_INLINE GLuint GetVertexArray() const { return mVao; }
+
  protected:
   GLuint mVao = NULL, mVbo = NULL;
   GLenum mBufferUsage = GL_STATIC_DRAW;
@@ -73,4 +123,60 @@ class ElementBufferRenderer : public SimpleRenderer {
   GLuint mEbo = NULL;
 };
 
-}  // namespace Yeager
\ No newline at end of file
+struct InstanceTransformLayout {
+  enum Enum {
+    /* The whole matrix, four texels per instance */
+    eMATRIX4x4,
+    /* The three first rows of an affine matrix, three texels per instance, the last row is always 0, 0, 0, 1 */
+    eMATRIX3x4
+  };
+};
+
+/**
+ * @brief Per instance transforms of the instanced objects, packed every frame into a range of the upload ring. The ring
+ * keeps the ranges of the frames in flight away from the writes, and the shaders fetch the transforms of a object
+ * starting at its offset, so every instance is drawn by a single instanced call whatever their amount
+ */
+class InstanceStream {
+ public:
+  static YEAGER_CONSTEXPR Uint sInvalidOffset = std::numeric_limits<Uint>::max();
+
+  InstanceStream(InstanceTransformLayout::Enum layout = InstanceTransformLayout::eMATRIX3x4) : mLayout(layout) {}
+  ~InstanceStream();
+
+  /** @brief Allocates the range of the frame in the ring, pushes beyond the reserved amount of instances are skipped */
+  void BeginFrame(UploadRing* ring, Uint reserve);
+  /**
+   * @brief Packs the transforms at the end of the range, returns the offset of the first one in instances, or
+   * sInvalidOffset when the range is full
+   */
+  Uint Push(std::span<const Matrix4> transforms);
+  /** @brief Commits the pushed transforms and binds the range to the texture unit, after the last Push */
+  void Bind();
+  void Destroy();
+
+  static void PackTransform(const Matrix4& transform, InstanceTransformLayout::Enum layout, float* output);
+  YEAGER_NODISCARD static Matrix4 UnpackTransform(const float* input, InstanceTransformLayout::Enum layout);
+  YEAGER_NODISCARD static Uint GetTexelsPerInstance(InstanceTransformLayout::Enum layout)
+  {
+    return layout == InstanceTransformLayout::eMATRIX3x4 ? 3 : 4;
+  }
+
+  YEAGER_NODISCARD InstanceTransformLayout::Enum GetLayout() const { return mLayout; }
+  YEAGER_NODISCARD Uint GetTexelsPerInstance() const { return GetTexelsPerInstance(mLayout); }
+  /** @brief Instances the range of the frame holds */
+  YEAGER_NODISCARD Uint GetCapacity() const { return mCapacity; }
+  YEAGER_NODISCARD Uint GetUsed() const { return mUsed; }
+
+ private:
+  YEAGER_NODISCARD std::size_t GetInstanceSize() const { return GetTexelsPerInstance() * 4 * sizeof(float); }
+
+  InstanceTransformLayout::Enum mLayout;
+  UploadRing* mRing = YEAGER_NULLPTR;
+  RingAllocation mRange;
+  GLuint mTexture = 0;
+  Uint mCapacity = 0;
+  Uint mUsed = 0;
+};
+
+}  // namespace Yeager
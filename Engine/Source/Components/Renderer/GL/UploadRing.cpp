@@ -0,0 +1,281 @@
+#include "UploadRing.h"
+using namespace Yeager;
+
+OpenGLUploadRingBackend::~OpenGLUploadRingBackend()
+{
+  DestroyBuffer();
+}
+
+unsigned char* OpenGLUploadRingBackend::CreateBuffer(std::size_t size)
+{
+  DestroyBuffer();
+  GL_CALL(glGenBuffers(1, &mBuffer));
+  /* The ring is bound to every kind of target, it is created through a neutral one */
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer));
+
+  unsigned char* mapped = YEAGER_NULLPTR;
+  if (GLAD_GL_VERSION_4_4) {
+    /* Coherent, so the writes reach the GPU without flushing, the fences of the ring keep them away from the reads */
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GL_CALL(glBufferStorage(GL_COPY_WRITE_BUFFER, size, YEAGER_NULLPTR, flags));
+    GL_CALL(mapped = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags)));
+  } else {
+    GL_CALL(glBufferData(GL_COPY_WRITE_BUFFER, size, YEAGER_NULLPTR, GL_STREAM_DRAW));
+  }
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+  return mapped;
+}
+
+void OpenGLUploadRingBackend::DestroyBuffer()
+{
+  /* Deleting the buffer also unmaps it, draws still reading it keep its storage alive until they finish */
+  if (mBuffer != 0) {
+    GL_CALL(glDeleteBuffers(1, &mBuffer));
+    mBuffer = 0;
+  }
+}
+
+GLuint OpenGLUploadRingBackend::CreateSpillBuffer(std::size_t size)
+{
+  GLuint buffer = 0;
+  GL_CALL(glGenBuffers(1, &buffer));
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, buffer));
+  GL_CALL(glBufferData(GL_COPY_WRITE_BUFFER, size, YEAGER_NULLPTR, GL_STREAM_DRAW));
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+  return buffer;
+}
+
+void OpenGLUploadRingBackend::DeleteSpillBuffer(GLuint buffer)
+{
+  GL_CALL(glDeleteBuffers(1, &buffer));
+}
+
+void OpenGLUploadRingBackend::Upload(GLuint buffer, std::size_t offset, std::size_t size, const void* data)
+{
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, buffer));
+  GL_CALL(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data));
+  GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+}
+
+std::size_t OpenGLUploadRingBackend::GetOffsetAlignment(GLenum target)
+{
+  if (target == GL_TEXTURE_BUFFER) {
+    if (mTextureBufferAlignment == 0) {
+      GLint alignment = 0;
+      GL_CALL(glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &alignment));
+      mTextureBufferAlignment = std::max<std::size_t>(alignment, 16);
+    }
+    return mTextureBufferAlignment;
+  }
+
+  if (target == GL_UNIFORM_BUFFER) {
+    if (mUniformBufferAlignment == 0) {
+      GLint alignment = 0;
+      GL_CALL(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+      mUniformBufferAlignment = std::max<std::size_t>(alignment, 16);
+    }
+    return mUniformBufferAlignment;
+  }
+
+  /* Vertex attributes and indirect commands only need their offsets aligned to their 4 bytes components */
+  return 4;
+}
+
+GLsync OpenGLUploadRingBackend::InsertFence()
+{
+  return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool OpenGLUploadRingBackend::WaitFence(GLsync fence, uint64_t timeout)
+{
+  const GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+  return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+void OpenGLUploadRingBackend::DeleteFence(GLsync fence)
+{
+  GL_CALL(glDeleteSync(fence));
+}
+
+UploadRing::UploadRing(std::size_t capacity, std::unique_ptr<UploadRingBackend> backend)
+    : mBackend(std::move(backend)), mRequestedCapacity(std::max<std::size_t>(capacity, 256))
+{
+  if (!mBackend)
+    mBackend = std::make_unique<OpenGLUploadRingBackend>();
+}
+
+UploadRing::~UploadRing()
+{
+  Destroy();
+}
+
+void UploadRing::DeleteFences()
+{
+  for (FrameFence& frame : mFrames) {
+    if (frame.Fence != YEAGER_NULLPTR)
+      mBackend->DeleteFence(frame.Fence);
+  }
+  mFrames.clear();
+}
+
+void UploadRing::Grow(std::size_t capacity)
+{
+  /* The draws still reading the old buffer keep reading it, nothing reads the new one yet so all of it is free */
+  DeleteFences();
+  mCapacity = (capacity + 255) / 256 * 256;
+  mHead = mTail = 0;
+
+  mMapped = mBackend->CreateBuffer(mCapacity);
+  if (mMapped == YEAGER_NULLPTR) {
+    mStaging.resize(mCapacity);
+  } else {
+    mStaging.clear();
+    mStaging.shrink_to_fit();
+  }
+  Yeager::LogDebug(INFO, "Upload ring grown to {} bytes, {}", mCapacity,
+                   mMapped != YEAGER_NULLPTR ? "persistently mapped" : "uploaded from a staging array");
+}
+
+bool UploadRing::ReleaseOldestFrame(bool wait)
+{
+  FrameFence& frame = mFrames.front();
+  if (frame.Fence != YEAGER_NULLPTR) {
+    if (!mBackend->WaitFence(frame.Fence, 0)) {
+      if (!wait)
+        return false;
+      mStallCount++;
+      if (!mBackend->WaitFence(frame.Fence, YEAGER_UPLOAD_RING_WAIT_TIMEOUT))
+        Yeager::Log(WARNING, "Upload ring frame is still read by the GPU, writing over it!");
+    }
+    mBackend->DeleteFence(frame.Fence);
+  }
+  mTail = frame.End;
+  mFrames.pop_front();
+  return true;
+}
+
+void UploadRing::BeginFrame()
+{
+  /* Frames a few frames behind are usually signaled already, releasing them here does not block */
+  while (!mFrames.empty() && ReleaseOldestFrame(false)) {}
+
+  if (bFrameSpilled) {
+    /* Sized for the whole last frame, times the frames kept in flight */
+    const std::size_t demand = mFrameDemand * YEAGER_UPLOAD_RING_FRAMES;
+    mRequestedCapacity = std::max(mCapacity * 2, demand);
+    Grow(mRequestedCapacity);
+  } else if (mCapacity == 0) {
+    Grow(mRequestedCapacity);
+  }
+
+  mFrameDemand = 0;
+  bFrameSpilled = false;
+  mFrameIndex++;
+}
+
+RingAllocation UploadRing::Spill(std::size_t size)
+{
+  mSpillCount++;
+  bFrameSpilled = true;
+  Yeager::LogDebug(WARNING, "Upload ring has no room for {} bytes this frame, spilling to a buffer of its own!", size);
+
+  RingAllocation allocation;
+  allocation.Buffer = mBackend->CreateSpillBuffer(size);
+  allocation.Size = size;
+  allocation.Data = mSpillStaging.emplace_back(size).data();
+  allocation.bSpilled = true;
+  mSpillBuffers.push_back(allocation.Buffer);
+  return allocation;
+}
+
+RingAllocation UploadRing::Allocate(std::size_t size, std::size_t alignment)
+{
+  if (size == 0)
+    return RingAllocation();
+  if (mCapacity == 0)
+    Grow(mRequestedCapacity);
+
+  alignment = std::max<std::size_t>(alignment, 1);
+  mFrameDemand += size + alignment - 1;
+  if (size > mCapacity)
+    return Spill(size);
+
+  while (true) {
+    const std::size_t offset = mHead % mCapacity;
+    std::size_t aligned = (offset + alignment - 1) / alignment * alignment;
+    /* Nothing straddles the end of the buffer, the rest of the lap is skipped and the allocation starts over at 0 */
+    if (aligned + size > mCapacity)
+      aligned = mCapacity;
+    const uint64_t end = mHead - offset + aligned + size;
+
+    if (end - mTail <= mCapacity) {
+      RingAllocation allocation;
+      allocation.Buffer = mBackend->GetBuffer();
+      allocation.Offset = aligned % mCapacity;
+      allocation.Size = size;
+      allocation.Data = (mMapped != YEAGER_NULLPTR ? mMapped : mStaging.data()) + allocation.Offset;
+      mHead = end;
+      return allocation;
+    }
+
+    if (!mFrames.empty()) {
+      ReleaseOldestFrame(true);
+    } else if (mHead == mTail) {
+      /* Nothing is in flight, the skipped lap was the only thing in the way */
+      mHead = mTail = mHead - offset + mCapacity;
+    } else {
+      /* The current frame holds the rest of the ring, it cannot wait for itself */
+      return Spill(size);
+    }
+  }
+}
+
+void UploadRing::Commit(const RingAllocation& allocation, std::size_t size)
+{
+  size = std::min(size, allocation.Size);
+  if (!allocation.IsValid() || size == 0)
+    return;
+  if (allocation.bSpilled || mMapped == YEAGER_NULLPTR)
+    mBackend->Upload(allocation.Buffer, allocation.Offset, size, allocation.Data);
+}
+
+RingAllocation UploadRing::Upload(const void* data, std::size_t size, std::size_t alignment)
+{
+  const RingAllocation allocation = Allocate(size, alignment);
+  if (allocation.IsValid()) {
+    std::memcpy(allocation.Data, data, size);
+    Commit(allocation);
+  }
+  return allocation;
+}
+
+void UploadRing::EndFrame()
+{
+  const uint64_t lastEnd = mFrames.empty() ? mTail : mFrames.back().End;
+  if (mCapacity > 0 && mHead != lastEnd)
+    mFrames.push_back(FrameFence{mBackend->InsertFence(), mHead});
+
+  /* Deleted right after the draws reading them were submitted, the driver keeps their storage until they finish */
+  for (GLuint buffer : mSpillBuffers) {
+    mBackend->DeleteSpillBuffer(buffer);
+  }
+  mSpillBuffers.clear();
+  mSpillStaging.clear();
+}
+
+void UploadRing::Destroy()
+{
+  DeleteFences();
+  for (GLuint buffer : mSpillBuffers) {
+    mBackend->DeleteSpillBuffer(buffer);
+  }
+  mSpillBuffers.clear();
+  mSpillStaging.clear();
+  if (mCapacity > 0) {
+    mBackend->DestroyBuffer();
+    mMapped = YEAGER_NULLPTR;
+    mStaging.clear();
+    mCapacity = 0;
+    mHead = mTail = 0;
+  }
+}
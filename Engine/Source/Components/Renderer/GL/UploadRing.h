@@ -0,0 +1,183 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <deque>
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+/* Size of the ring when it is created, it grows when a frame did not fit in it */
+#define YEAGER_UPLOAD_RING_MIN_SIZE (1 << 22)
+/* Frames the ring is sized to keep in flight when it grows */
+#define YEAGER_UPLOAD_RING_FRAMES 3
+/* How long the ring waits for the GPU to release a frame before writing over it anyway, in nanoseconds */
+#define YEAGER_UPLOAD_RING_WAIT_TIMEOUT 1000000000ull
+
+namespace Yeager {
+
+/**
+ * @brief Buffer, fences and uploads behind the upload ring. The engine uses the OpenGL one, it can be replaced by a
+ * fake one to validate the allocations, the wraparound and the fencing of the ring without a context
+ */
+class UploadRingBackend {
+ public:
+  virtual ~UploadRingBackend() = default;
+
+  /**
+   * @brief Creates the ring buffer, replacing the last one. Returns the pointer to the persistent mapping of the
+   * buffer, or null when it cannot be mapped, then the ring writes to a staging array and uploads it with Upload
+   */
+  virtual unsigned char* CreateBuffer(std::size_t size) = 0;
+  virtual void DestroyBuffer() = 0;
+  YEAGER_NODISCARD virtual GLuint GetBuffer() const = 0;
+  /** @brief Buffer holding a single allocation that did not fit in the ring, deleted once the frame is submitted */
+  virtual GLuint CreateSpillBuffer(std::size_t size) = 0;
+  virtual void DeleteSpillBuffer(GLuint buffer) = 0;
+  virtual void Upload(GLuint buffer, std::size_t offset, std::size_t size, const void* data) = 0;
+  /** @brief Offset alignment the target requires from the ranges bound to it */
+  YEAGER_NODISCARD virtual std::size_t GetOffsetAlignment(GLenum target) = 0;
+
+  /** @brief Fence signaled once the GPU has executed every command submitted before it */
+  virtual GLsync InsertFence() = 0;
+  /** @brief Returns false when the fence is not signaled within the timeout, in nanoseconds */
+  virtual bool WaitFence(GLsync fence, uint64_t timeout) = 0;
+  virtual void DeleteFence(GLsync fence) = 0;
+};
+
+/** @brief Buffer mapped once with glBufferStorage (OpenGL 4.4), glBufferSubData without it */
+class OpenGLUploadRingBackend : public UploadRingBackend {
+ public:
+  ~OpenGLUploadRingBackend();
+
+  unsigned char* CreateBuffer(std::size_t size) override;
+  void DestroyBuffer() override;
+  YEAGER_NODISCARD GLuint GetBuffer() const override { return mBuffer; }
+  GLuint CreateSpillBuffer(std::size_t size) override;
+  void DeleteSpillBuffer(GLuint buffer) override;
+  void Upload(GLuint buffer, std::size_t offset, std::size_t size, const void* data) override;
+  YEAGER_NODISCARD std::size_t GetOffsetAlignment(GLenum target) override;
+
+  GLsync InsertFence() override;
+  bool WaitFence(GLsync fence, uint64_t timeout) override;
+  void DeleteFence(GLsync fence) override;
+
+ private:
+  GLuint mBuffer = 0;
+  std::size_t mTextureBufferAlignment = 0;
+  std::size_t mUniformBufferAlignment = 0;
+};
+
+/**
+ * @brief Range of the ring written by the CPU this frame. Data is where the bytes go, and Buffer and Offset where the
+ * GPU reads them from once committed. Spilled allocations have a buffer of their own, at the offset 0
+ */
+struct RingAllocation {
+  GLuint Buffer = 0;
+  std::size_t Offset = 0;
+  std::size_t Size = 0;
+  unsigned char* Data = YEAGER_NULLPTR;
+  bool bSpilled = false;
+
+  YEAGER_NODISCARD bool IsValid() const { return Data != YEAGER_NULLPTR; }
+};
+
+/**
+ * @brief Single buffer every dynamic upload of a frame is carved from, instead of a glBufferData or glBufferSubData on
+ * a buffer the GPU may still be reading. The allocations of a frame are fenced together at its end, and the ring only
+ * wraps over a frame once its fence is signaled, so the CPU writes straight into the persistent mapping without the
+ * driver synchronizing behind it. An allocation that does not fit while the current frame holds the rest of the ring
+ * spills to a buffer of its own, and the ring grows at the start of the next frame
+ */
+class UploadRing {
+ public:
+  /** @brief Without a backend the OpenGL one is used, no OpenGL call happens before the first frame */
+  UploadRing(std::size_t capacity = YEAGER_UPLOAD_RING_MIN_SIZE,
+             std::unique_ptr<UploadRingBackend> backend = YEAGER_NULLPTR);
+  ~UploadRing();
+
+  /** @brief Releases the frames the GPU is done with, without waiting, and grows the ring if the last frame spilled */
+  void BeginFrame();
+  /**
+   * @brief Reserves the bytes at an offset multiple of the alignment (a power of two), waiting for the oldest frames
+   * when the ring is full. Returns an invalid allocation when the size is zero
+   */
+  RingAllocation Allocate(std::size_t size, std::size_t alignment);
+  /** @brief Makes the first bytes of the allocation visible to the GPU, only uploads when they were not mapped */
+  void Commit(const RingAllocation& allocation, std::size_t size);
+  void Commit(const RingAllocation& allocation) { Commit(allocation, allocation.Size); }
+  /** @brief Allocates, copies and commits the data in one call */
+  RingAllocation Upload(const void* data, std::size_t size, std::size_t alignment);
+  /** @brief Fences the allocations of the frame once the draws reading them were submitted, and drops the spills */
+  void EndFrame();
+  void Destroy();
+
+  YEAGER_NODISCARD std::size_t GetOffsetAlignment(GLenum target) { return mBackend->GetOffsetAlignment(target); }
+  YEAGER_NODISCARD std::size_t GetCapacity() const { return mCapacity; }
+  /** @brief Bytes from the oldest frame the GPU may be reading to the end of the last allocation, paddings included */
+  YEAGER_NODISCARD std::size_t GetUsed() const { return static_cast<std::size_t>(mHead - mTail); }
+  YEAGER_NODISCARD std::size_t GetFramesInFlight() const { return mFrames.size(); }
+  /** @brief Frames started so far, the allocations of one are only valid until the next starts */
+  YEAGER_NODISCARD uint64_t GetFrameIndex() const { return mFrameIndex; }
+  YEAGER_NODISCARD bool IsMapped() const { return mMapped != YEAGER_NULLPTR; }
+  /** @brief Allocations that had to wait for the GPU to release the frame they overwrite */
+  YEAGER_NODISCARD Uint GetStallCount() const { return mStallCount; }
+  /** @brief Allocations that did not fit in the ring and got a buffer of their own */
+  YEAGER_NODISCARD Uint GetSpillCount() const { return mSpillCount; }
+
+ private:
+  struct FrameFence {
+    GLsync Fence = YEAGER_NULLPTR;
+    /* Position of the head when the frame ended, everything before it is free once the fence is signaled */
+    uint64_t End = 0;
+  };
+
+  void Grow(std::size_t capacity);
+  /**
+   * @brief Moves the tail to the end of the oldest frame in flight once its fence is signaled. Without waiting it
+   * returns false when the GPU is not done with the frame yet
+   */
+  bool ReleaseOldestFrame(bool wait);
+  RingAllocation Spill(std::size_t size);
+  void DeleteFences();
+
+  std::unique_ptr<UploadRingBackend> mBackend;
+  std::deque<FrameFence> mFrames;
+  /* Null when the buffer is not mapped, the allocations are then written to mStaging */
+  unsigned char* mMapped = YEAGER_NULLPTR;
+  std::vector<unsigned char> mStaging;
+  /* Spilled allocations of the frame, the staging arrays keep their memory when the vector of them grows */
+  std::vector<std::vector<unsigned char>> mSpillStaging;
+  std::vector<GLuint> mSpillBuffers;
+  std::size_t mCapacity = 0;
+  /* Capacity the buffer is created with, raised when a frame spills */
+  std::size_t mRequestedCapacity = 0;
+  /* Monotonic positions, the offset in the buffer is the position modulo the capacity. The bytes from the tail to the
+     head may be read by the GPU or written by the current frame, the ones from the head around to the tail are free */
+  uint64_t mHead = 0;
+  uint64_t mTail = 0;
+  /* Bytes the current frame asked for, spills and paddings included */
+  std::size_t mFrameDemand = 0;
+  uint64_t mFrameIndex = 0;
+  Uint mStallCount = 0;
+  Uint mSpillCount = 0;
+  bool bFrameSpilled = false;
+};
+
+}  // namespace Yeager
@@ -5,6 +5,7 @@
 using namespace Yeager;
 
 Uint Entity::mEntityCount = 0;
+static const UniformHandle sModelUniformHandle("model");
 
 String EntityObjectType::ToString(EntityObjectType::Enum type)
 {
@@ -41,6 +42,7 @@ void EditorEntity::BuildNode(std::shared_ptr<NodeComponent> parent)
     mNode = BaseAllocator::MakeSharedPtr<NodeComponent>(mApplication, this, parent);
     Yeager::LogDebug(INFO, "Node build for {}, UUID {}, parent {}", mName, uuids::to_string(mEntityUUID),
                      parent->IsRoot() ? "Root" : parent->GetEntity()->GetName());
+    OnNodeParentChanged(parent.get());
   }
 }
 
@@ -48,10 +50,31 @@ EditorEntity::EditorEntity(const EntityBuilder& builder) : Entity(builder)
 {
   if (mApplication) {
     mToolbox = BaseAllocator::MakeSharedPtr<ToolboxHandle>(this);
-    mApplication->GetScene()->GetToolboxs()->push_back(mToolbox);
+    Scene* scene = mApplication->GetScene();
+    mSceneEntity = scene->GetRegistry()->Create();
+    scene->GetToolboxs()->Insert(mSceneEntity, mToolbox);
+    const EntityHandle indexed = scene->GetRegistry()->GetIndex()->Insert(mSceneEntity, mEntityUUID, mName);
+    if (indexed.IsValid())
+      Yeager::Log(WARNING, "Entity {} has the same UUID {} of another entity in the scene!", mName,
+                  uuids::to_string(mEntityUUID));
   }
 }
 
+void EditorEntity::SetName(const String& name)
+{
+  mName = name;
+  if (mApplication && mApplication->GetScene())
+    mApplication->GetScene()->GetRegistry()->GetIndex()->Rename(mSceneEntity, name);
+}
+
+void EditorEntity::SetScheduleDeletion(bool deletion)
+{
+  /* Recorded once, the scene removes every component of the entity at the end of the frame */
+  if (deletion && !bScheduleDeletion && mApplication && mApplication->GetScene())
+    mApplication->GetScene()->ScheduleDestroy(mSceneEntity);
+  bScheduleDeletion = deletion;
+}
+
 EditorEntity::~EditorEntity()
 {
   if (mToolbox) {
@@ -77,7 +100,7 @@ void Transformation2D::Apply(Transformation2D* transformation, Yeager::Shader* s
   t->model = glm::rotate(t->model, glm::radians(t->rotation.x), Vector3(1.0f, 0.0f, 0.0f));
   t->model = glm::rotate(t->model, glm::radians(t->rotation.y), Vector3(0.0f, 1.0f, 0.0f));
   t->model = glm::scale(t->model, Vector3(t->scale.x, t->scale.y, 0.0f));
-  shader->SetMat4("model", t->model);
+  shader->SetMat4(sModelUniformHandle, t->model);
   t->model = YEAGER_IDENTITY_MATRIX4x4;
 }
 
@@ -114,7 +137,7 @@ void Transformation3D::Apply(Transformation3D* transformation, Yeager::Shader* s
   t->model = glm::rotate(t->model, glm::radians(t->rotation.y), Vector3(0.0f, 1.0f, 0.0f));
   t->model = glm::rotate(t->model, glm::radians(t->rotation.z), Vector3(0.0f, 0.0f, 1.0f));
   t->model = glm::scale(t->model, t->scale);
-  shader->SetMat4("model", t->model);
+  shader->SetMat4(sModelUniformHandle, t->model);
   t->model = YEAGER_IDENTITY_MATRIX4x4;
 }
 
@@ -157,24 +180,76 @@ uuids::uuid Entity::GetEntityUUID()
 GameEntity::GameEntity(const EntityBuilder& builder)
     : EditorEntity(builder), mEntityTransformation(Transformation3D::GetDefault())
 {
+  if (TransformStorage* storage = GetTransformStorage())
+    mTransformHandle = storage->Create(&mEntityTransformation);
   Yeager::LogDebug(INFO, "Creating GameEntity name {} UUID {}", mName, uuids::to_string(mEntityUUID));
 }
 
 GameEntity::~GameEntity()
 {
+  if (TransformStorage* storage = GetTransformStorage())
+    storage->Destroy(mTransformHandle);
   Yeager::LogDebug(INFO, "Destroying GameEntity name {} UUID {}", mName, uuids::to_string(mEntityUUID));
 }
-Transformation3D GameEntity::GetTransformation()
+
+TransformStorage* GameEntity::GetTransformStorage() const
+{
+  return mApplication != YEAGER_NULLPTR ? mApplication->GetTransformStorage() : YEAGER_NULLPTR;
+}
+
+const Transformation3D& GameEntity::GetTransformation() const
 {
   return mEntityTransformation;
 }
 
 Transformation3D* GameEntity::GetTransformationPtr()
 {
+  MarkTransformationDirty();
   return &mEntityTransformation;
 }
 
+void GameEntity::SetTransformation(const Transformation3D& trans)
+{
+  mEntityTransformation = trans;
+  MarkTransformationDirty();
+}
+
+void GameEntity::MarkTransformationDirty()
+{
+  if (TransformStorage* storage = GetTransformStorage())
+    storage->MarkDirty(mTransformHandle);
+}
+
+Matrix4 GameEntity::GetWorldMatrix() const
+{
+  TransformStorage* storage = GetTransformStorage();
+  if (storage == YEAGER_NULLPTR || !storage->IsValid(mTransformHandle))
+    return Transformation3D::Apply(mEntityTransformation);
+  return storage->GetWorldMatrix(mTransformHandle);
+}
+
+bool GameEntity::IsWorldMatrixUpdated() const
+{
+  TransformStorage* storage = GetTransformStorage();
+  return storage != YEAGER_NULLPTR && storage->WasUpdated(mTransformHandle);
+}
+
+void GameEntity::OnNodeParentChanged(NodeComponent* parent)
+{
+  TransformStorage* storage = GetTransformStorage();
+  if (storage == YEAGER_NULLPTR)
+    return;
+
+  /* Only game entities have a transformation, a node under the root or under a editor entity is a root transform */
+  TransformHandle handle = TransformStorage::sInvalidHandle;
+  if (parent != YEAGER_NULLPTR && !parent->IsRoot()) {
+    if (auto* entity = dynamic_cast<GameEntity*>(parent->GetEntity()))
+      handle = entity->mTransformHandle;
+  }
+  storage->SetParent(mTransformHandle, handle);
+}
+
 void GameEntity::ApplyTransformation(Yeager::Shader* shader)
 {
-  Transformation3D::Apply(&mEntityTransformation, shader);
+  shader->SetMat4(sModelUniformHandle, GetWorldMatrix());
 }
@@ -24,6 +24,9 @@
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
 
+#include "Components/Renderer/Objects/TransformStorage.h"
+#include "Main/Scene/EntityRegistry.h"
+
 namespace Yeager {
 
 class ApplicationCore;
@@ -114,7 +117,7 @@ class Entity {
   ~Entity();
 
   String GetName();
-  void SetName(const String& name) { mName = name; }
+  virtual void SetName(const String& name) { mName = name; }
   uuid_t GetEntityUUID();
 
   void SetEntityType(EntityObjectType::Enum type) { mType = type; }
@@ -151,11 +154,14 @@ class EditorEntity : public Entity {
 
   std::shared_ptr<ToolboxHandle> GetToolbox() { return mToolbox; }
 
+  /** @brief Also renames the entity in the index of the scene */
+  void SetName(const String& name) override;
+
   /**
    * @brief Sets to true, when the scene calls for search for schedule deletions, it will remove this entity from the 
    * application, basically, delete it 
   */
-  YEAGER_CONSTEXPR void SetScheduleDeletion(bool deletion) { bScheduleDeletion = deletion; }
+  void SetScheduleDeletion(bool deletion);
 
   /**
    * @brief returns true if the entity must have been requested for deletion
@@ -165,12 +171,19 @@ class EditorEntity : public Entity {
   void BuildNode(std::shared_ptr<NodeComponent> parent);
   std::shared_ptr<NodeComponent> GetNodeComponent() { return mNode; }
 
+  /** @brief Entity of the scene registry, shared by every component of this entity in the scene (toolbox, object...) */
+  EntityHandle GetSceneEntity() const { return mSceneEntity; }
+
+  /** @brief Called every time the node of the entity is linked to a parent node */
+  virtual void OnNodeParentChanged(NodeComponent* parent) {}
+
  protected:
   /* Toolbox object handles the information about the entity, name, id, and custom propieties*/
   std::shared_ptr<ToolboxHandle> mToolbox = YEAGER_NULLPTR;
   /* Node component handles the relation of the entity with other entities, like if the are parent, children. 
     This build a hierarchy of information about parent nodes and their children */
   std::shared_ptr<NodeComponent> mNode = YEAGER_NULLPTR;
+  EntityHandle mSceneEntity;
 
   bool bScheduleDeletion = false;
 };
@@ -183,19 +196,32 @@ class GameEntity : public EditorEntity {
  public:
   GameEntity(const EntityBuilder& builder);
   ~GameEntity();
-  Transformation3D GetTransformation();
+  const Transformation3D& GetTransformation() const;
+  /** @brief Mutable access, the transformation is marked as dirty and its world matrix is rebuilt on the next update */
   Transformation3D* GetTransformationPtr();
 
   virtual void ApplyTransformation(Shader* Shader);
-  YEAGER_FORCE_INLINE void SetTransformation(const Transformation3D& trans) { mEntityTransformation = trans; }
+  void SetTransformation(const Transformation3D& trans);
+  /** @brief Must be called after writing to the transformation without going through the functions above */
+  void MarkTransformationDirty();
+
+  /** @brief Local transformation composed with the ones of the parent nodes that are game entities */
+  YEAGER_NODISCARD Matrix4 GetWorldMatrix() const;
+  /** @brief Returns true if the world matrix was rebuilt by the last transform update, by this entity or its parents */
+  YEAGER_NODISCARD bool IsWorldMatrixUpdated() const;
+
+  void OnNodeParentChanged(NodeComponent* parent) override;
   YEAGER_CONSTEXPR YEAGER_FORCE_INLINE std::vector<MaterialBase*>* GetLoadedTextures()
   {
     return &mEntityLoadedTextures;
   };
 
  protected:
+  TransformStorage* GetTransformStorage() const;
+
   std::vector<MaterialBase*> mEntityLoadedTextures;
   Transformation3D mEntityTransformation;
+  TransformHandle mTransformHandle = TransformStorage::sInvalidHandle;
 };
 
 }  // namespace Yeager
\ No newline at end of file
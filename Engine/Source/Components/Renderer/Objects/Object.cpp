@@ -2,11 +2,203 @@
 #include "Components/Loader/Importer.h"
 #include "Components/Physics/PhysXActor.h"
 #include "Components/Renderer/AnimationEngine/AnimationEngine.h"
+#include "Components/Renderer/AnimationEngine/BonePalette.h"
+#include "Components/Renderer/Objects/VertexFormats.h"
 #include "Main/Core/Application.h"
 
 using namespace Yeager;
 using namespace physx;
 
+static const UniformHandle sInstanceTransformsHandle("instanceTransforms");
+static const UniformHandle sInstanceOffsetHandle("instanceOffset");
+static const UniformHandle sInstanceTexelsHandle("instanceTexels");
+static const UniformHandle sGeometryDiffuseHandle("material.texture_diffuse1");
+static const UniformHandle sBonePaletteHandle("bonePalette");
+static const UniformHandle sBonePaletteOffsetHandle("bonePaletteOffset");
+static const UniformHandle sBonePaletteCountHandle("bonePaletteCount");
+static const UniformHandle sCompactVertexHandle("compactVertex");
+static const UniformHandle sPositionOffsetHandle("positionOffset");
+static const UniformHandle sPositionScaleHandle("positionScale");
+
+/* Commands of the object being drawn, the draws only happen on the main thread */
+static IndirectBatchBuilder sMeshBatches;
+
+static_assert(sizeof(ObjectVertexData) == 8 * sizeof(GLfloat), "The geometry vertices must match ObjectVertexData!");
+
+static GeometryArena* GetGeometryArena(ApplicationCore* application)
+{
+  return application != YEAGER_NULLPTR ? application->GetGeometryArena() : YEAGER_NULLPTR;
+}
+
+/**
+ * @brief Uploads the vertices and indices of the mesh and sets its attributes, in the compact format the vertices are
+ * quantized to a temporary buffer and the mesh keeps the quantization for the draws. With a geometry arena the mesh is
+ * placed in the pool of its format, the renderer of the mesh is only used without one
+ */
+template <typename MeshType>
+static void SetupMeshBuffers(MeshType& mesh, GeometryArena* arena, bool compact, const VertexFormatDescriptor& format,
+                             const VertexFormatDescriptor& compactFormat)
+{
+  mesh.bCompactVertices = compact;
+  const void* vertices = mesh.GetVertices().data();
+  const VertexFormatDescriptor* vertexFormat = &format;
+  std::vector<CompactVertexOf<typename decltype(mesh.Vertices)::value_type>> compactVertices;
+  if (compact) {
+    mesh.Quantization = PositionQuantization::FromBounds(mesh.Bounds);
+    compactVertices = EncodeCompactVertices(mesh.GetVertices(), mesh.Quantization);
+    vertices = compactVertices.data();
+    vertexFormat = &compactFormat;
+  }
+  const Uint vertexCount = static_cast<Uint>(mesh.GetVertices().size());
+
+  if (arena != YEAGER_NULLPTR) {
+    mesh.Geometry = arena->Allocate(*vertexFormat, vertices, vertexCount, mesh.GetIndices());
+    if (mesh.Geometry.IsValid())
+      return;
+  }
+
+  mesh.Renderer.GenBuffers();
+  mesh.Renderer.BindBuffers();
+  mesh.Renderer.BufferData(GL_ARRAY_BUFFER, std::size_t(vertexCount) * vertexFormat->Stride, vertices, GL_STATIC_DRAW);
+  mesh.Renderer.ApplyVertexFormat(*vertexFormat);
+  mesh.Renderer.BufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.GetIndices().size_bytes(), mesh.GetIndices().data(),
+                           GL_STATIC_DRAW);
+  mesh.Renderer.UnbindBuffers();
+}
+
+static bool HaveSameMaterial(const CommonMeshData& first, const CommonMeshData& second)
+{
+  if (first.Textures != second.Textures || first.bCompactVertices != second.bCompactVertices)
+    return false;
+  return !first.bCompactVertices || (first.Quantization.Offset == second.Quantization.Offset &&
+                                     first.Quantization.Scale == second.Quantization.Scale);
+}
+
+/* Quadratic in the amount of meshes, only done once after the upload */
+template <typename MeshType>
+static void AssignMaterialBatches(std::vector<MeshType>& meshes)
+{
+  for (Uint x = 0; x < meshes.size(); x++) {
+    meshes[x].MaterialBatch = x;
+    for (Uint y = 0; y < x; y++) {
+      if (meshes[y].MaterialBatch == y && HaveSameMaterial(meshes[x], meshes[y])) {
+        meshes[x].MaterialBatch = y;
+        break;
+      }
+    }
+  }
+}
+
+/** @brief The uniform persists in the program, so it is set on every mesh, compact or not */
+static void SetMeshVertexUniforms(const CommonMeshData* mesh, Yeager::Shader* shader)
+{
+  shader->SetBool(sCompactVertexHandle, mesh->bCompactVertices);
+  if (mesh->bCompactVertices) {
+    shader->SetVec3(sPositionOffsetHandle, mesh->Quantization.Offset);
+    shader->SetVec3(sPositionScaleHandle, mesh->Quantization.Scale);
+  }
+}
+
+/**
+ * @brief Builds the sampler uniform handle of each texture of the mesh, the textures are numbered by type in the
+ * order they appear (texture_diffuse1, texture_diffuse2 ...). Only rebuilds when the textures have changed, a texture
+ * replaced in the same slot may be of another type and shift the numbering of the ones after it
+ */
+static void BuildMeshTextureUniforms(CommonMeshData* mesh, const String& prefix, bool numberAllTypes)
+{
+  if (mesh->TextureUniformSources == mesh->Textures)
+    return;
+  mesh->TextureUniformSources = mesh->Textures;
+
+  Uint diffuseNum = 1;
+  Uint specularNum = 1;
+  Uint normalNum = 1;
+  Uint heightNum = 1;
+
+  mesh->TextureUniforms.clear();
+  mesh->TextureUniforms.reserve(mesh->Textures.size());
+  for (const auto& texture : mesh->Textures) {
+    String number;
+    String name = texture->GetName();
+    if (name == "texture_diffuse") {
+      number = std::to_string(diffuseNum++);
+    } else if (name == "texture_specular") {
+      number = std::to_string(specularNum++);
+    } else if (numberAllTypes && name == "texture_normal") {
+      number = std::to_string(normalNum++);
+    } else if (numberAllTypes && name == "texture_height") {
+      number = std::to_string(heightNum++);
+    }
+    mesh->TextureUniforms.emplace_back(prefix + name + number);
+  }
+}
+
+/* Meshes in the same pool share the vertex array, the render queue groups them by it */
+static GLuint GetMeshVertexArray(const CommonMeshData& mesh)
+{
+  return mesh.Geometry.IsValid() ? mesh.Geometry.Pool->GetVertexArray() : mesh.Renderer.GetVertexArray();
+}
+
+static void BindMeshMaterial(CommonMeshData* mesh, Yeager::Shader* shader, const String& prefix, bool numberAllTypes)
+{
+  BuildMeshTextureUniforms(mesh, prefix, numberAllTypes);
+  SetMeshVertexUniforms(mesh, shader);
+
+  for (Uint x = 0; x < mesh->Textures.size(); x++) {
+    glActiveTexture(GL_TEXTURE0 + x);
+    shader->SetInt(mesh->TextureUniforms[x], x);
+    mesh->Textures[x]->BindTexture();
+  }
+}
+
+/**
+ * @brief The meshes placed in the geometry arena are drawn in one batch per material, without any bind between them.
+ * The ones owning their buffers are drawn one by one, like before the arena
+ */
+template <typename MeshType>
+static void DrawMeshBatches(std::vector<MeshType>& meshes, Yeager::Shader* shader, GeometryArena* arena, bool instanced,
+                            Uint instances, const String& prefix, bool numberAllTypes)
+{
+  sMeshBatches.Clear();
+  for (auto& mesh : meshes) {
+    if (mesh.Geometry.IsValid()) {
+      sMeshBatches.Add(mesh.MaterialBatch, mesh.Geometry.Pool, mesh.Geometry.BuildCommand(instanced ? instances : 1));
+      continue;
+    }
+
+    BindMeshMaterial(&mesh, shader, prefix, numberAllTypes);
+    mesh.Renderer.BindVertexArray();
+    const GLsizei count = static_cast<GLsizei>(mesh.GetIndices().size());
+    if (instanced) {
+      mesh.Renderer.DrawInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, YEAGER_NULLPTR, instances);
+    } else {
+      mesh.Renderer.Draw(GL_TRIANGLES, count, GL_UNSIGNED_INT, YEAGER_NULLPTR);
+    }
+    mesh.Renderer.UnbindVertexArray();
+    MaterialTexture2D::Unbind2DTextures();
+  }
+
+  if (arena == YEAGER_NULLPTR || sMeshBatches.GetCommands().empty())
+    return;
+
+  sMeshBatches.Compact();
+  for (const auto& batch : sMeshBatches.GetBatches()) {
+    BindMeshMaterial(&meshes[batch.Key], shader, prefix, numberAllTypes);
+    arena->Draw(sMeshBatches, batch);
+    MaterialTexture2D::Unbind2DTextures();
+  }
+}
+
+static void DrawGeometryAllocation(GeometryArena* arena, const GeometryAllocation& geometry, Uint instances)
+{
+  if (arena == YEAGER_NULLPTR)
+    return;
+  sMeshBatches.Clear();
+  sMeshBatches.Add(0, geometry.Pool, geometry.BuildCommand(instances));
+  for (const auto& batch : sMeshBatches.GetBatches())
+    arena->Draw(sMeshBatches, batch);
+}
+
 void Yeager::SpawnCubeObject(Yeager::ApplicationCore* application, const String& name, const Vector3& position,
                              const Vector3& rotation, const Vector3& scale, const ObjectPhysicsType::Enum physics)
 {
@@ -115,25 +307,51 @@ AnimatedObject::AnimatedObject(const EntityBuilder& builder, GLuint amount)
   SetEntityType(EntityObjectType::OBJECT_INSTANCED_ANIMATED);
 }
 
-void Object::BuildProps(const std::vector<std::shared_ptr<Transformation3D>>& transformations, Shader* shader)
+void Object::BuildProps(const std::vector<std::shared_ptr<Transformation3D>>& transformations)
 {
   if (transformations.size() > m_InstancedObjs)
     Yeager::Log(WARNING,
                 "Trying to build instanced props with a std::vector bigger that the amount that was declared! {} ",
                 mName);
   m_Props = transformations;
-  shader->UseShader();
-  /* The number of instances can differ from the actual number of props that exists*/
-  if (m_Props.size() == m_InstancedObjs) {
-    for (Uint x = 0; x < m_InstancedObjs; x++) {
-      Matrix4 model = Transformation3D::Apply(*(m_Props.at(x).get()));
-      shader->SetMat4("matrices[" + std::to_string(x) + "]", model);
-    }
+}
+
+Uint Object::GetInstancePropsCount() const
+{
+  if (m_InstancedType != ObjectInstancedType::eINSTANCED)
+    return 0;
+  return std::min<Uint>(static_cast<Uint>(m_Props.size()), m_InstancedObjs);
+}
+
+void Object::WriteInstances(InstanceStream* stream)
+{
+  /* The props can be edited anywhere, so their matrices are composed again every frame */
+  const Uint count = GetInstancePropsCount();
+  m_InstanceMatrices.resize(count);
+  for (Uint x = 0; x < count; x++) {
+    const Transformation3D& prop = *m_Props[x];
+    m_InstanceMatrices[x] = TransformStorage::ComposeLocal(prop.position, prop.rotation, prop.scale);
   }
+
+  const Uint offset = stream->Push(m_InstanceMatrices);
+  m_InstanceOffset = offset != InstanceStream::sInvalidOffset ? offset : 0;
+  m_InstanceCount = offset != InstanceStream::sInvalidOffset ? count : 0;
+  m_InstanceTexels = stream->GetTexelsPerInstance();
+}
+
+void Object::BuildInstanceUniforms(Shader* shader)
+{
+  shader->SetInt(sInstanceTransformsHandle, YEAGER_INSTANCE_STREAM_TEXTURE_UNIT);
+  shader->SetInt(sInstanceOffsetHandle, static_cast<int>(m_InstanceOffset));
+  shader->SetInt(sInstanceTexelsHandle, static_cast<int>(m_InstanceTexels));
 }
 
 Object::~Object()
 {
+  /* Copies of the object share the proxy id, only the owner of the leaf removes it */
+  if (auto tree = m_CullingTree.lock(); tree && HasCullingProxy() && tree->GetUserData(m_CullingProxy) == this)
+    tree->DestroyProxy(m_CullingProxy);
+
   if (m_InstancedType == ObjectInstancedType::eINSTANCED) {
     for (auto& trans : m_Props)
       trans.reset();
@@ -141,18 +359,17 @@ Object::~Object()
 
   if (!m_ThreadImporter->IsThreadFinish()) {
     Yeager::Log(INFO, "Awaiting Object {} thread to finish", GetName());
-    if (m_ThreadImporter->GetThreadPtr()->joinable()) {
-      m_ThreadImporter->GetThreadPtr()->join();
-    }
+    m_ThreadImporter->WaitThread();
   }
   m_ThreadImporter.reset();
   if (m_ObjectDataLoaded) {
     if (m_GeometryType == ObjectGeometryType::eCUSTOM) {
-      m_GeometryData.Renderer.DeleteBuffers();
-    } else {
       for (auto& mesh : m_ModelData.Meshes) {
         DeleteMeshGLBuffers(&mesh);
       }
+    } else {
+      GeometryArena::Free(&m_GeometryData.Geometry);
+      m_GeometryData.Renderer.DeleteBuffers();
     }
     m_Actor.reset();
     Yeager::Log(INFO, "Destroying object {}", mName);
@@ -161,12 +378,16 @@ Object::~Object()
 
 AnimatedObject::~AnimatedObject()
 {
+  for (auto& mesh : m_ModelData.Meshes) {
+    GeometryArena::Free(&mesh.Geometry);
+  }
   m_AnimationEngine.reset();
   m_ThreadImporter.reset();
 }
 
 void Yeager::DeleteMeshGLBuffers(ObjectMeshData* mesh)
 {
+  GeometryArena::Free(&mesh->Geometry);
   mesh->Renderer.DeleteBuffers();
 }
 
@@ -175,7 +396,7 @@ std::vector<GLfloat> Yeager::ExtractVerticesFromEveryMesh(ObjectModelData* model
   std::vector<GLfloat> vertices;
   for (auto& mesh : model->Meshes) {
 
-    for (auto& vertex : mesh.Vertices) {
+    for (const auto& vertex : mesh.GetVertices()) {
       vertices.push_back(vertex.Position.x);
       vertices.push_back(vertex.Position.y);
       vertices.push_back(vertex.Position.z);
@@ -193,7 +414,7 @@ std::vector<Vector3> Yeager::ExtractVerticesPositionToVector(ObjectModelData* mo
 {
   std::vector<Vector3> Positions;
   for (const auto& mesh : model->Meshes) {
-    for (const auto& vertex : mesh.Vertices) {
+    for (const auto& vertex : mesh.GetVertices()) {
       Vector3 vec(vertex.Position.x, vertex.Position.y, vertex.Position.z);
       Positions.push_back(vec);
     }
@@ -201,46 +422,135 @@ std::vector<Vector3> Yeager::ExtractVerticesPositionToVector(ObjectModelData* mo
   return Positions;
 }
 
+AABB Object::ComputeLocalBounds()
+{
+  AABB bounds;
+  if (m_GeometryType == ObjectGeometryType::eCUSTOM) {
+    for (const auto& mesh : m_ModelData.Meshes)
+      bounds.Expand(mesh.Bounds);
+  } else if (!m_GeometryData.Vertices.empty()) {
+    /* Geometry vertices are interleaved, position, normal and texture coords */
+    bounds = ComputeAABB(m_GeometryData.Vertices.data(), m_GeometryData.Vertices.size() / 8, 8);
+  }
+  return bounds;
+}
+
+AABB AnimatedObject::ComputeLocalBounds()
+{
+  AABB bounds;
+  for (const auto& mesh : m_ModelData.Meshes)
+    bounds.Expand(mesh.Bounds);
+
+  /* The bounds come from the bind pose, the animation can move the vertices outside of it, so some room is given */
+  if (bounds.IsValid()) {
+    const Vector3 room = bounds.GetExtents() * 0.25f;
+    bounds = AABB(bounds.Min - room, bounds.Max + room);
+  }
+  return bounds;
+}
+
+AABB Object::GetLocalBounds()
+{
+  if (!m_LocalBounds.IsValid() && m_ObjectDataLoaded)
+    m_LocalBounds = ComputeLocalBounds();
+  return m_LocalBounds;
+}
+
+AABB Object::GetWorldBounds()
+{
+  const AABB local = GetLocalBounds();
+  if (!local.IsValid())
+    return local;
+
+  if (m_InstancedType == ObjectInstancedType::eINSTANCED && !m_Props.empty()) {
+    AABB bounds;
+    for (const auto& prop : m_Props)
+      bounds.Expand(local.Transform(Transformation3D::Apply(*prop)));
+    return bounds;
+  }
+  return local.Transform(GetWorldMatrix());
+}
+
+static bool TransformationChanged(const Transformation3D& a, const Transformation3D& b)
+{
+  return a.position != b.position || a.rotation != b.rotation || a.scale != b.scale;
+}
+
+void Object::UpdateCullingProxy(const std::shared_ptr<AABBTree>& tree)
+{
+  if (!m_ObjectDataLoaded)
+    return;
+
+  const bool owned = HasCullingProxy() && m_CullingTree.lock() == tree && tree->GetUserData(m_CullingProxy) == this;
+  if (!owned) {
+    const AABB bounds = GetWorldBounds();
+    if (!bounds.IsValid())
+      return;
+    m_CullingProxy = tree->CreateProxy(bounds, this);
+    m_CullingTree = tree;
+    m_CulledTransformation = mEntityTransformation;
+    return;
+  }
+
+  /* The props of the instanced objects can change without the entity transformation, so they are always refitted. A
+   * parent that moved changes the world matrix while the local transformation stays the same */
+  if (m_InstancedType == ObjectInstancedType::eINSTANCED || IsWorldMatrixUpdated() ||
+      TransformationChanged(m_CulledTransformation, mEntityTransformation)) {
+    tree->MoveProxy(m_CullingProxy, GetWorldBounds());
+    m_CulledTransformation = mEntityTransformation;
+  }
+}
+
 void AnimatedObject::UpdateAnimation(float delta)
 {
-  if (m_ObjectDataLoaded && bRender) {
+  if (m_ObjectDataLoaded && bRender && m_AnimationEngine) {
     m_AnimationEngine->UpdateAnimation(delta);
   }
 }
 
+Uint AnimatedObject::GetPaletteBoneCount() const
+{
+  return static_cast<Uint>(std::clamp(m_ModelData.m_BoneCounter, 0, MAX_BONES));
+}
+
+void AnimatedObject::WritePalette(std::span<Matrix4> palette) const
+{
+  if (!m_AnimationEngine) {
+    std::fill(palette.begin(), palette.end(), Matrix4(1.0f));
+    return;
+  }
+
+  /* A view on the matrices of the engine, the copy into the palette slice is the only one they go through */
+  const std::span<const Matrix4> bones = m_AnimationEngine->GetFinalBoneMatrices();
+  const std::size_t count = std::min(palette.size(), bones.size());
+  std::copy_n(bones.begin(), count, palette.begin());
+  std::fill(palette.begin() + count, palette.end(), Matrix4(1.0f));
+}
+
 void AnimatedObject::BuildAnimationMatrices(Shader* shader)
 {
   if (m_ObjectDataLoaded && bRender) {
     shader->UseShader();
-    auto transform = m_AnimationEngine->GetFinalBoneMatrices();
-    for (int x = 0; x < transform.size(); x++) {
-      shader->SetMat4("finalBonesMatrices[" + std::to_string(x) + "]", transform.at(x));
-    }
+    shader->SetInt(sBonePaletteHandle, YEAGER_BONE_PALETTE_TEXTURE_UNIT);
+    shader->SetInt(sBonePaletteOffsetHandle, static_cast<int>(m_PaletteOffset));
+    shader->SetInt(sBonePaletteCountHandle, static_cast<int>(GetPaletteBoneCount()));
   }
 }
 
 void Yeager::DrawSeparateMesh(ObjectMeshData* mesh, Yeager::Shader* shader)
 {
   shader->UseShader();
-  Uint diffuseNum = 1;
-  Uint specularNum = 1;
+  BuildMeshTextureUniforms(mesh, "material.", false);
+  SetMeshVertexUniforms(mesh, shader);
 
   for (Uint x = 0; x < mesh->Textures.size(); x++) {
     glActiveTexture(GL_TEXTURE0 + x);
-    String number;
-    String name = mesh->Textures[x]->GetName();
-    if (name == "texture_diffuse") {
-      number = std::to_string(diffuseNum++);
-    } else if (name == "texture_specular") {
-      number = std::to_string(specularNum++);
-    }
-    String mat = ("material." + name + number).c_str();
-    shader->SetInt(mat, x);
+    shader->SetInt(mesh->TextureUniforms[x], x);
     mesh->Textures[x]->BindTexture();
   }
 
   mesh->Renderer.BindVertexArray();
-  glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh->Indices.size()), GL_UNSIGNED_INT, YEAGER_NULLPTR);
+  glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh->GetIndices().size()), GL_UNSIGNED_INT, YEAGER_NULLPTR);
   mesh->Renderer.UnbindVertexArray();
 
   MaterialTexture2D::Unbind2DTextures();
@@ -248,24 +558,17 @@ void Yeager::DrawSeparateMesh(ObjectMeshData* mesh, Yeager::Shader* shader)
 
 void Yeager::DrawSeparateInstancedMesh(ObjectMeshData* mesh, Yeager::Shader* shader, int amount)
 {
-  Uint diffuseNum = 1;
-  Uint specularNum = 1;
+  BuildMeshTextureUniforms(mesh, YEAGER_EMPTY_LITERAL, false);
+  SetMeshVertexUniforms(mesh, shader);
 
   for (Uint x = 0; x < mesh->Textures.size(); x++) {
     glActiveTexture(GL_TEXTURE0 + x);
-    String number;
-    String name = mesh->Textures[x]->GetName();
-    if (name == "texture_diffuse") {
-      number = std::to_string(diffuseNum++);
-    } else if (name == "texture_specular") {
-      number = std::to_string(specularNum++);
-    }
-    shader->SetInt((name + number).c_str(), x);
+    shader->SetInt(mesh->TextureUniforms[x], x);
     mesh->Textures[x]->BindTexture();
   }
 
   mesh->Renderer.BindVertexArray();
-  mesh->Renderer.DrawInstanced(GL_TRIANGLES, static_cast<GLsizei>(mesh->Indices.size()), GL_UNSIGNED_INT,
+  mesh->Renderer.DrawInstanced(GL_TRIANGLES, static_cast<GLsizei>(mesh->GetIndices().size()), GL_UNSIGNED_INT,
                                YEAGER_NULLPTR, amount);
   mesh->Renderer.UnbindVertexArray();
 
@@ -292,6 +595,7 @@ bool Object::GenerateObjectGeometry(ObjectGeometryType::Enum geometry, const Obj
     }
     m_PhysicsType = physics.Type;
     physics.ApplyToObjectTransformation(&mEntityTransformation);
+    MarkTransformationDirty();
     m_Actor->BuildActor(physics);
     Setup();
     m_ObjectDataLoaded = true;
@@ -327,7 +631,7 @@ bool Object::ImportObjectFromFile(Cchar path, const ObjectCreationConfiguration
     Setup();
 
     for (auto& tex : m_ModelData.TexturesLoaded) {
-      mEntityLoadedTextures.push_back(&tex->first);
+      mEntityLoadedTextures.push_back(tex.get());
     }
 
     Yeager::LogDebug(INFO, "Success in loading mode {} path {}", mName, path);
@@ -357,24 +661,11 @@ bool Object::ThreadImportObjectFromFile(Cchar path, const ObjectCreationConfigur
   }
 }
 
-void Object::ThreadLoadIncompleteTextures()
-{
-  for (auto& tex : m_ModelData.TexturesLoaded) {
-    if (tex->first.GetTextureDataHandle()->ImcompletedID) {
-      tex->first.GenerateFromData(tex->second);
-      tex->first.GetTextureDataHandle()->ImcompletedID = false;
-      if (tex->second != YEAGER_NULLPTR) {
-        delete tex->second;
-      }
-    }
-  }
-}
-
 void Object::ThreadSetup()
 {
 
   m_ModelData = m_ThreadImporter->GetValue();
-  m_ThreadImporter->GetThreadPtr()->join();
+  m_ThreadImporter->WaitThread();
 
   if (!m_ModelData.SuccessfulLoaded) {
     Yeager::Log(ERROR, "Cannot load imported model data, model {}", mName);
@@ -382,14 +673,12 @@ void Object::ThreadSetup()
     return;
   }
 
-  ThreadLoadIncompleteTextures();
-
   m_GeometryType = ObjectGeometryType::eCUSTOM;
   m_ObjectDataLoaded = true;
   Setup();
 
   for (auto& tex : m_ModelData.TexturesLoaded) {
-    mEntityLoadedTextures.push_back(&tex->first);
+    mEntityLoadedTextures.push_back(tex.get());
   }
 
   Yeager::LogDebug(INFO, "Success in loading mode {}", mName);
@@ -414,22 +703,10 @@ bool AnimatedObject::ThreadImportObjectFromFile(Cchar path, const ObjectCreation
   }
 }
 
-void AnimatedObject::ThreadLoadIncompleteTextures()
-{
-  for (auto& tex : m_ModelData.TexturesLoaded) {
-    if (tex->first.GetTextureDataHandle()->ImcompletedID) {
-      tex->first.GenerateFromData(tex->second);
-      if (tex->second != YEAGER_NULLPTR) {
-        delete tex->second;
-      }
-    }
-  }
-}
-
 void AnimatedObject::ThreadSetup()
 {
   m_ModelData = m_ThreadImporter->GetValue();
-  m_ThreadImporter->GetThreadPtr()->join();
+  m_ThreadImporter->WaitThread();
 
   if (!m_ModelData.SuccessfulLoaded) {
     Yeager::Log(ERROR, "Cannot load imported model data, model {}", mName);
@@ -437,15 +714,13 @@ void AnimatedObject::ThreadSetup()
     return;
   }
 
-  ThreadLoadIncompleteTextures();
-
   m_GeometryType = ObjectGeometryType::eCUSTOM;
   m_ObjectDataLoaded = true;
 
   Setup();
 
   for (auto& tex : m_ModelData.TexturesLoaded) {
-    mEntityLoadedTextures.push_back(&tex->first);
+    mEntityLoadedTextures.push_back(tex.get());
   }
 
   BuildAnimation(Path);
@@ -457,12 +732,14 @@ void AnimatedObject::ThreadSetup()
 
 void Object::DrawInstancedGeometry(Yeager::Shader* shader)
 {
-  m_GeometryData.Renderer.BindVertexArray();
-
-  m_GeometryData.Renderer.DrawInstanced(GL_TRIANGLES, static_cast<unsigned int>(m_GeometryData.Indices.size()),
-                                        GL_UNSIGNED_INT, 0, m_InstancedObjs);
-
-  m_GeometryData.Renderer.UnbindVertexArray();
+  if (m_GeometryData.Geometry.IsValid()) {
+    DrawGeometryAllocation(GetGeometryArena(mApplication), m_GeometryData.Geometry, m_InstanceCount);
+  } else {
+    m_GeometryData.Renderer.BindVertexArray();
+    m_GeometryData.Renderer.DrawInstanced(GL_TRIANGLES, static_cast<unsigned int>(m_GeometryData.Indices.size()),
+                                          GL_UNSIGNED_INT, 0, m_InstanceCount);
+    m_GeometryData.Renderer.UnbindVertexArray();
+  }
   glActiveTexture(GL_TEXTURE0);
 }
 
@@ -470,52 +747,52 @@ void Object::DrawGeometry(Yeager::Shader* shader)
 {
   if (m_GeometryData.Texture) {
     glActiveTexture(GL_TEXTURE0);
-    shader->SetInt("material.texture_diffuse1", 0);
+    shader->SetInt(sGeometryDiffuseHandle, 0);
     glBindTexture(GL_TEXTURE_2D, m_GeometryData.Texture->GetTextureID());
   }
 
-  m_GeometryData.Renderer.BindVertexArray();
-
-  m_GeometryData.Renderer.Draw(GL_TRIANGLES, static_cast<unsigned int>(m_GeometryData.Indices.size()), GL_UNSIGNED_INT,
-                               0);
-  m_GeometryData.Renderer.UnbindVertexArray();
+  if (m_GeometryData.Geometry.IsValid()) {
+    DrawGeometryAllocation(GetGeometryArena(mApplication), m_GeometryData.Geometry, 1);
+  } else {
+    m_GeometryData.Renderer.BindVertexArray();
+    m_GeometryData.Renderer.Draw(GL_TRIANGLES, static_cast<unsigned int>(m_GeometryData.Indices.size()),
+                                 GL_UNSIGNED_INT, 0);
+    m_GeometryData.Renderer.UnbindVertexArray();
+  }
   MaterialTexture2D::Unbind2DTextures();
 }
 
 void Object::DrawModel(Yeager::Shader* shader)
 {
-  for (auto& mesh : m_ModelData.Meshes) {
-    if (m_InstancedType == ObjectInstancedType::eNON_INSTACED) {
-      DrawSeparateMesh(&mesh, shader);
-    } else {
-      DrawSeparateInstancedMesh(&mesh, shader, m_InstancedObjs);
-    }
+  if (m_InstancedType == ObjectInstancedType::eNON_INSTACED) {
+    DrawMeshBatches(m_ModelData.Meshes, shader, GetGeometryArena(mApplication), false, 1, "material.", false);
+  } else {
+    DrawMeshBatches(m_ModelData.Meshes, shader, GetGeometryArena(mApplication), true, m_InstanceCount,
+                    YEAGER_EMPTY_LITERAL, false);
   }
 }
 
+/* Through the state cache, so the render queue submission after this draw does not trust a stale state */
 void Object::ProcessOnScreenProprieties()
 {
-  if (!m_OnScreenProprieties.m_CullingEnabled)
-    glDisable(GL_CULL_FACE);
+  GLStateCache::SetCullFace(m_OnScreenProprieties.m_CullingEnabled);
 
   switch (m_OnScreenProprieties.m_PolygonMode) {
     case RenderingGLPolygonMode::eLINES:
-      glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+      GLStateCache::SetPolygonMode(GL_LINE);
       break;
     case RenderingGLPolygonMode::ePOINTS:
-      glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+      GLStateCache::SetPolygonMode(GL_POINT);
       break;
     case RenderingGLPolygonMode::eFILL:
     default:
-      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+      GLStateCache::SetPolygonMode(GL_FILL);
   }
 }
 void Object::PosProcessOnScreenProprieties()
 {
-  if (!m_OnScreenProprieties.m_CullingEnabled)
-    glEnable(GL_CULL_FACE);
-
-  glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+  GLStateCache::SetCullFace(true);
+  GLStateCache::SetPolygonMode(GL_FILL);
 }
 
 void Object::Draw(Yeager::Shader* shader, float delta)
@@ -524,13 +801,23 @@ void Object::Draw(Yeager::Shader* shader, float delta)
   IntervalElapsedTimeManager::StartTimeInterval(this->mName);
 
   ProcessOnScreenProprieties();
+  DrawWithoutStateChanges(shader, delta);
+  PosProcessOnScreenProprieties();
+  /* The pooled meshes leave the vertex array of their pool bound */
+  SimpleRenderer::UnbindVertexArray();
+
+  IntervalElapsedTimeManager::EndTimeInterval(this->mName);
+}
 
+void Object::DrawWithoutStateChanges(Yeager::Shader* shader, float delta)
+{
   if (m_ObjectDataLoaded && bRender) {
 
     shader->UseShader();
-    if (m_PhysicsType == ObjectPhysicsType::eDYNAMIC_BODY)
-      m_Actor->ProcessTransformation(delta);
+    /* The pose of a dynamic body was already written by the transform update of the frame */
     ApplyTransformation(shader);
+    if (m_InstancedType == ObjectInstancedType::eINSTANCED)
+      BuildInstanceUniforms(shader);
 
     if (m_GeometryType == ObjectGeometryType::eCUSTOM) {
       DrawModel(shader);
@@ -542,10 +829,25 @@ void Object::Draw(Yeager::Shader* shader, float delta)
       }
     }
   }
+}
 
-  PosProcessOnScreenProprieties();
+GLuint Object::GetFirstVertexArray()
+{
+  if (m_GeometryType == ObjectGeometryType::eCUSTOM)
+    return m_ModelData.Meshes.empty() ? 0 : GetMeshVertexArray(m_ModelData.Meshes.front());
+  if (m_GeometryData.Geometry.IsValid())
+    return m_GeometryData.Geometry.Pool->GetVertexArray();
+  return m_GeometryData.Renderer.GetVertexArray();
+}
 
-  IntervalElapsedTimeManager::EndTimeInterval(this->mName);
+GLuint Object::GetFirstTextureID()
+{
+  if (m_GeometryType == ObjectGeometryType::eCUSTOM) {
+    if (m_ModelData.Meshes.empty() || m_ModelData.Meshes.front().Textures.empty())
+      return 0;
+    return m_ModelData.Meshes.front().Textures.front()->GetTextureID();
+  }
+  return m_GeometryData.Texture ? m_GeometryData.Texture->GetTextureID() : 0;
 }
 
 void Object::Setup()
@@ -554,26 +856,20 @@ void Object::Setup()
   if (m_GeometryType == ObjectGeometryType::eCUSTOM) {
 
     for (auto& mesh : m_ModelData.Meshes) {
-      mesh.Renderer.GenBuffers();
-      mesh.Renderer.BindBuffers();
-
-      mesh.Renderer.BufferData(GL_ARRAY_BUFFER, mesh.Vertices.size() * sizeof(ObjectVertexData), &mesh.Vertices[0],
-                               GL_STATIC_DRAW);
-      mesh.Renderer.BufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.Indices.size() * sizeof(unsigned int), &mesh.Indices[0],
-                               GL_STATIC_DRAW);
-
-      mesh.Renderer.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ObjectVertexData), (void*)0);
-
-      mesh.Renderer.VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ObjectVertexData),
-                                        (void*)offsetof(ObjectVertexData, Normals));
-
-      mesh.Renderer.VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(ObjectVertexData),
-                                        (void*)offsetof(ObjectVertexData, TextureCoords));
-
-      mesh.Renderer.UnbindBuffers();
+      SetupMeshBuffers(mesh, GetGeometryArena(mApplication), m_ModelData.CompactVertices, GetObjectVertexFormat(),
+                       GetCompactObjectVertexFormat());
     }
+    AssignMaterialBatches(m_ModelData.Meshes);
   } else {
 
+    if (GeometryArena* arena = GetGeometryArena(mApplication)) {
+      m_GeometryData.Geometry =
+          arena->Allocate(GetObjectVertexFormat(), m_GeometryData.Vertices.data(),
+                          static_cast<Uint>(m_GeometryData.Vertices.size() / 8), m_GeometryData.Indices);
+      if (m_GeometryData.Geometry.IsValid())
+        return;
+    }
+
     m_GeometryData.Renderer.GenBuffers();
     m_GeometryData.Renderer.BindBuffers();
 
@@ -599,11 +895,28 @@ void Object::GenerateGeometryTexture(MaterialTexture2D* texture)
   m_GeometryData.Texture = texture;
 }
 
+/* The compressed clips are cached next to the mesh caches of the project, nothing is cached without a project folder */
+static std::optional<AnimationCacheEntry> RequestAnimationCache(ApplicationCore* application, const String& path)
+{
+  if (application == YEAGER_NULLPTR || application->GetScene() == YEAGER_NULLPTR ||
+      application->GetScene()->GetContext()->ProjectFolderPath == YEAGER_NULL_LITERAL)
+    return std::nullopt;
+
+  std::optional<uint64_t> key = AnimationCache::ComputeKey(path, AnimationCompressionSettings());
+  if (!key.has_value())
+    return std::nullopt;
+
+  AnimationCacheEntry entry;
+  entry.Key = key.value();
+  entry.Path = AnimationCache::BuildCachePath(application->GetScene()->GetObjectCacheFolderPath(), entry.Key);
+  return entry;
+}
+
 void AnimatedObject::BuildAnimation(String path)
 {
   m_AnimationEngine = BaseAllocator::MakeSharedPtr<AnimationEngine>();
   m_AnimationEngine->Initialize();
-  m_AnimationEngine->LoadAnimationsFromFile(path, this);
+  m_AnimationEngine->LoadAnimationsFromFile(path, this, RequestAnimationCache(mApplication, path));
 }
 
 bool AnimatedObject::ImportObjectFromFile(Cchar path, const ObjectCreationConfiguration configuration, bool flip_image)
@@ -625,7 +938,7 @@ bool AnimatedObject::ImportObjectFromFile(Cchar path, const ObjectCreationConfig
     Setup();
 
     for (auto& tex : m_ModelData.TexturesLoaded) {
-      mEntityLoadedTextures.push_back(&tex->first);
+      mEntityLoadedTextures.push_back(tex.get());
     }
 
     Yeager::Log(INFO, "Success in loading mode {} path {}", mName, path);
@@ -638,38 +951,11 @@ bool AnimatedObject::ImportObjectFromFile(Cchar path, const ObjectCreationConfig
 
 void AnimatedObject::Setup()
 {
-
   for (auto& mesh : m_ModelData.Meshes) {
-    mesh.Renderer.GenBuffers();
-    mesh.Renderer.BindBuffers();
-
-    mesh.Renderer.BufferData(GL_ARRAY_BUFFER, mesh.Vertices.size() * sizeof(AnimatedVertexData), &mesh.Vertices[0],
-                             GL_STATIC_DRAW);
-    mesh.Renderer.BufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.Indices.size() * sizeof(unsigned int), &mesh.Indices[0],
-                             GL_STATIC_DRAW);
-
-    mesh.Renderer.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(AnimatedVertexData), (void*)0);
-
-    mesh.Renderer.VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(AnimatedVertexData),
-                                      (void*)offsetof(AnimatedVertexData, Normals));
-
-    mesh.Renderer.VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(AnimatedVertexData),
-                                      (void*)offsetof(AnimatedVertexData, TextureCoords));
-
-    mesh.Renderer.VertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(AnimatedVertexData),
-                                      (void*)offsetof(AnimatedVertexData, Tangent));
-
-    mesh.Renderer.VertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(AnimatedVertexData),
-                                      (void*)offsetof(AnimatedVertexData, BiTangent));
-
-    mesh.Renderer.VertexAttribPointer(5, 4, GL_INT, GL_FALSE, sizeof(AnimatedVertexData),
-                                      (void*)offsetof(AnimatedVertexData, BonesIDs));
-
-    mesh.Renderer.VertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(AnimatedVertexData),
-                                      (void*)offsetof(AnimatedVertexData, Weights));
-
-    mesh.Renderer.UnbindBuffers();
+    SetupMeshBuffers(mesh, GetGeometryArena(mApplication), m_ModelData.CompactVertices, GetAnimatedVertexFormat(),
+                     GetCompactAnimatedVertexFormat());
   }
+  AssignMaterialBatches(m_ModelData.Meshes);
 }
 
 void AnimatedObject::Draw(Shader* shader)
@@ -677,55 +963,42 @@ void AnimatedObject::Draw(Shader* shader)
   IntervalElapsedTimeManager::StartTimeInterval(this->mName);
 
   ProcessOnScreenProprieties();
+  DrawWithoutStateChanges(shader, 0.0f);
+  PosProcessOnScreenProprieties();
+  SimpleRenderer::UnbindVertexArray();
 
+  IntervalElapsedTimeManager::EndTimeInterval(this->mName);
+}
+
+void AnimatedObject::DrawWithoutStateChanges(Shader* shader, float delta)
+{
   if (m_ObjectDataLoaded && bRender) {
     shader->UseShader();
-    if (m_InstancedType == ObjectInstancedType::eNON_INSTACED)
+    if (m_InstancedType == ObjectInstancedType::eNON_INSTACED) {
       ApplyTransformation(shader);
+    } else {
+      BuildInstanceUniforms(shader);
+    }
     DrawMeshes(shader);
   }
+}
 
-  PosProcessOnScreenProprieties();
+GLuint AnimatedObject::GetFirstVertexArray()
+{
+  return m_ModelData.Meshes.empty() ? 0 : GetMeshVertexArray(m_ModelData.Meshes.front());
+}
 
-  IntervalElapsedTimeManager::EndTimeInterval(this->mName);
+GLuint AnimatedObject::GetFirstTextureID()
+{
+  if (m_ModelData.Meshes.empty() || m_ModelData.Meshes.front().Textures.empty())
+    return 0;
+  return m_ModelData.Meshes.front().Textures.front()->GetTextureID();
 }
 
 void AnimatedObject::DrawMeshes(Shader* shader)
 {
-  for (auto& mesh : m_ModelData.Meshes) {
-    Uint diffuseNum = 1;
-    Uint specularNum = 1;
-    Uint normalNum = 1;
-    Uint heightNum = 1;
-
-    for (Uint x = 0; x < mesh.Textures.size(); x++) {
-      glActiveTexture(GL_TEXTURE0 + x);
-      String number;
-      String name = mesh.Textures[x]->GetName();
-      if (name == "texture_diffuse") {
-        number = std::to_string(diffuseNum++);
-      } else if (name == "texture_specular") {
-        number = std::to_string(specularNum++);
-      } else if (name == "texture_normal") {
-        number = std::to_string(normalNum++);
-      } else if (name == "texture_height") {
-        number = std::to_string(heightNum++);
-      }
-      shader->SetInt(("material." + name + number).c_str(), x);
-      glBindTexture(GL_TEXTURE_2D, mesh.Textures[x]->GetTextureID());
-    }
-
-    mesh.Renderer.BindVertexArray();
-    if (m_InstancedType == ObjectInstancedType::eNON_INSTACED) {
-      mesh.Renderer.Draw(GL_TRIANGLES, static_cast<GLsizei>(mesh.Indices.size()), GL_UNSIGNED_INT, YEAGER_NULLPTR);
-    } else {
-      mesh.Renderer.DrawInstanced(GL_TRIANGLES, static_cast<GLsizei>(mesh.Indices.size()), GL_UNSIGNED_INT,
-                                  YEAGER_NULLPTR, m_InstancedObjs);
-    }
-
-    mesh.Renderer.UnbindVertexArray();
-    MaterialTexture2D::Unbind2DTextures();
-  }
+  DrawMeshBatches(m_ModelData.Meshes, shader, GetGeometryArena(mApplication), IsInstanced(), m_InstanceCount,
+                  "material.", true);
 }
 
 // clang-format off
@@ -22,13 +22,22 @@
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
 
+#include "Common/Math/AABBTree.h"
+#include "Common/FS/MappedFile.h"
+#include "Common/Math/BoundingVolumes.h"
+#include "Common/Math/Quantization.h"
 #include "Components/Physics/PhysXActor.h"
 #include "Components/Physics/PhysXHandle.h"
 #include "Components/Renderer/AnimationEngine/Bone.h"
+#include "Components/Renderer/GL/GeometryArena.h"
 #include "Components/Renderer/GL/OpenGLRender.h"
 #include "Components/Renderer/Objects/Entity.h"
+#include "Components/Renderer/Objects/VertexData.h"
+#include "Components/Renderer/Shader/UniformTable.h"
 #include "Editor/UI/ToolboxObj.h"
 
+#include <span>
+
 namespace Yeager {
 class ApplicationCore;
 class Animation;
@@ -49,8 +58,11 @@ struct ObjectCreationConfiguration {
   {
     TextureFolder.path = YEAGER_NULL_LITERAL;
     TextureFolder.Valid = false;
+    CompactVertices = false;
   }
   CustomTextureFolder TextureFolder;
+  /* Uploads the meshes in the compact vertex format (VertexFormats.h), the shaders must be the Simple ones or decode it */
+  bool CompactVertices = false;
 };
 
 struct BoneInfo {
@@ -58,34 +70,56 @@ struct BoneInfo {
   Matrix4 OffSet = Matrix4(1.0f);
 };
 
-struct ObjectVertexData {
-  Vector3 Position = Vector3(0.0f);
-  Vector3 Normals = Vector3(0.0f);
-  Vector2 TextureCoords = Vector2(0.0f);
-};
-
-#define MAX_BONE_INFLUENCE 4
-
-struct AnimatedVertexData : public ObjectVertexData {
-  Vector3 Tangent = Vector3(0.0f);
-  Vector3 BiTangent = Vector3(0.0f);
-  int BonesIDs[MAX_BONE_INFLUENCE];
-  float Weights[MAX_BONE_INFLUENCE];
-};
-
 struct CommonMeshData {
   std::vector<MaterialTexture2D*> Textures;
   std::vector<GLuint> Indices;
+  /* Sampler uniform of each texture ("material.texture_diffuse1" ...), built on the first draw */
+  std::vector<UniformHandle> TextureUniforms;
+  /* Textures the sampler uniforms were built for, a texture replaced in the same slot rebuilds them */
+  std::vector<MaterialTexture2D*> TextureUniformSources;
+  /* Bounds of the vertices in the model space, computed during the import */
+  AABB Bounds;
+  /* Meshes loaded from the mesh cache read their vertices and indices straight from the mapped file, the vectors stay
+     empty and the mapping is kept alive by every mesh pointing into it */
+  std::shared_ptr<MappedFile> CacheMapping = YEAGER_NULLPTR;
+  const GLuint* CachedIndices = YEAGER_NULLPTR;
+  std::size_t CachedIndexCount = 0;
+  /* Set by the setup when the vertex buffer holds the compact format, the shader rebuilds the positions with the quantization */
+  bool bCompactVertices = false;
+  PositionQuantization Quantization;
   CommonMeshData(const std::vector<MaterialTexture2D*>& textures, const std::vector<GLuint>& indices)
   {
     Textures = textures;
     Indices = indices;
   }
+  YEAGER_NODISCARD std::span<const GLuint> GetIndices() const
+  {
+    return CachedIndices ? std::span<const GLuint>(CachedIndices, CachedIndexCount) : std::span<const GLuint>(Indices);
+  }
+  /* Range of the mesh in the shared pool of its vertex format, the renderer only owns buffers when it is invalid */
+  GeometryAllocation Geometry;
+  /* Index of the first mesh of the model with the same textures and quantization, they are drawn in one batch */
+  Uint MaterialBatch = 0;
   ElementBufferRenderer Renderer;
 };
 
-struct ObjectMeshData : public CommonMeshData {
-  std::vector<ObjectVertexData> Vertices;
+/**
+ * @brief The vertices of a mesh, either owned by the vector or pointing into the mapped cache file
+ */
+template <typename VertexType>
+struct MeshVertexStorage {
+  std::vector<VertexType> Vertices;
+  const VertexType* CachedVertices = YEAGER_NULLPTR;
+  std::size_t CachedVertexCount = 0;
+
+  YEAGER_NODISCARD std::span<const VertexType> GetVertices() const
+  {
+    return CachedVertices ? std::span<const VertexType>(CachedVertices, CachedVertexCount)
+                          : std::span<const VertexType>(Vertices);
+  }
+};
+
+struct ObjectMeshData : public CommonMeshData, public MeshVertexStorage<ObjectVertexData> {
   ObjectMeshData(std::vector<GLuint> indices, std::vector<ObjectVertexData> vertices,
                  std::vector<MaterialTexture2D*> textures)
       : CommonMeshData(textures, indices)
@@ -94,8 +128,7 @@ struct ObjectMeshData : public CommonMeshData {
   }
 };
 
-struct AnimatedObjectMeshData : public CommonMeshData {
-  std::vector<AnimatedVertexData> Vertices;
+struct AnimatedObjectMeshData : public CommonMeshData, public MeshVertexStorage<AnimatedVertexData> {
   AnimatedObjectMeshData(std::vector<GLuint> indices, std::vector<AnimatedVertexData> vertices,
                          std::vector<MaterialTexture2D*> textures)
       : CommonMeshData(textures, indices)
@@ -105,12 +138,14 @@ struct AnimatedObjectMeshData : public CommonMeshData {
 };
 
 struct CommonModelData {
-  /* TODO remake this */
-  /* A vector of shared pointers of pairs
-  First: MaterialTexture2D the texture loaded to the entity 
-  Second: STBIDataOutput pointer linking data read during thread importer to be process in the main thread */
-  std::vector<std::shared_ptr<std::pair<MaterialTexture2D, STBIDataOutput*>>> TexturesLoaded;
+  /* Textures used by the model, each one once. They come from the texture registry, and other models loading the
+  same images share them */
+  std::vector<std::shared_ptr<MaterialTexture2D>> TexturesLoaded;
+  /* TexturesLoaded indexed by the path the importer resolved, the meshes of a model mostly repeat the same textures */
+  std::unordered_map<String, MaterialTexture2D*> TexturesByPath;
   bool SuccessfulLoaded = false;
+  /* Copied from the creation configuration, the vertices in memory stay in full precision either way */
+  bool CompactVertices = false;
 };
 
 struct ObjectModelData : public CommonModelData {
@@ -130,6 +165,8 @@ struct ObjectGeometryData {
   std::vector<GLuint> Indices;
   std::vector<GLfloat> Vertices;
   MaterialTexture2D* Texture = YEAGER_NULLPTR;
+  /* The vertices have the layout of ObjectVertexData, they share its pool in the geometry arena */
+  GeometryAllocation Geometry;
   ElementBufferRenderer Renderer;
 };
 
@@ -149,6 +186,8 @@ struct ObjectInstancedType {
 struct ObjectOnScreenProprieties {
   bool m_CullingEnabled = true;
   RenderingGLPolygonMode::Enum m_PolygonMode = RenderingGLPolygonMode::eFILL;
+  /* Blended with what is behind it, drawn after the opaque objects from back to front */
+  bool m_Transparent = false;
 };
 
 extern String ObjectGeometryTypeToString(ObjectGeometryType::Enum type);
@@ -187,6 +226,27 @@ class Object : public GameEntity {
   virtual void ThreadSetup();
   bool GenerateObjectGeometry(ObjectGeometryType::Enum geometry, const ObjectPhysXCreationBase& physics);
   virtual void Draw(Yeager::Shader* shader, float delta);
+  /** @brief Issues the draw calls of the object without touching the polygon mode and culling, the caller (like the
+   * render queue) is responsible for those states */
+  virtual void DrawWithoutStateChanges(Yeager::Shader* shader, float delta);
+
+  /** @brief Identifiers used to build the sort keys of the render queue, the first vertex array and texture of the object */
+  YEAGER_NODISCARD virtual GLuint GetFirstVertexArray();
+  YEAGER_NODISCARD virtual GLuint GetFirstTextureID();
+
+  /** @brief Bounds of the object in model space, merged from every mesh (or from the geometry vertices) */
+  YEAGER_NODISCARD AABB GetLocalBounds();
+  /** @brief Bounds of the object in world space, instanced objects enclose every prop */
+  YEAGER_NODISCARD AABB GetWorldBounds();
+
+  /**
+   * @brief Inserts the object in the culling tree, or refits its proxy if the transformation have changed since the last
+   * call. Objects without data loaded are not inserted and never culled
+   */
+  void UpdateCullingProxy(const std::shared_ptr<AABBTree>& tree);
+  YEAGER_FORCE_INLINE bool HasCullingProxy() const { return m_CullingProxy != YEAGER_AABB_TREE_NULL_NODE; }
+  YEAGER_FORCE_INLINE bool IsCulled() const { return bCulled; }
+  YEAGER_FORCE_INLINE void SetCulled(bool culled) { bCulled = culled; }
 
   constexpr YEAGER_FORCE_INLINE ObjectGeometryType::Enum GetGeometry() { return m_GeometryType; }
   constexpr YEAGER_FORCE_INLINE void SetGeometry(ObjectGeometryType::Enum type) { m_GeometryType = type; }
@@ -195,7 +255,14 @@ class Object : public GameEntity {
   YEAGER_FORCE_INLINE String GetPath() { return Path; }
   constexpr inline bool IsLoaded() const { return m_ObjectDataLoaded; }
 
-  virtual void BuildProps(const std::vector<std::shared_ptr<Transformation3D>>& transformations, Shader* shader);
+  /** @brief Sets the transforms of the instances, they are packed into the instance stream every frame */
+  virtual void BuildProps(const std::vector<std::shared_ptr<Transformation3D>>& transformations);
+  /** @brief Instances drawn, the props given up to the amount declared on creation */
+  YEAGER_NODISCARD Uint GetInstancePropsCount() const;
+  /** @brief Packs the model matrix of every prop into the stream section of this frame */
+  void WriteInstances(InstanceStream* stream);
+  /** @brief Points the instanced shader to the transforms of this object in the stream, it must already be bound */
+  void BuildInstanceUniforms(Shader* shader);
 
   void GenerateGeometryTexture(MaterialTexture2D* texture);
 
@@ -233,8 +300,6 @@ class Object : public GameEntity {
   virtual void DrawInstancedGeometry(Yeager::Shader* shader);
   virtual void DrawModel(Yeager::Shader* shader);
 
-  virtual void ThreadLoadIncompleteTextures();
-
   String Path;
   bool m_ObjectDataLoaded = false;
 
@@ -252,6 +317,20 @@ class Object : public GameEntity {
   std::shared_ptr<ImporterThreaded> m_ThreadImporter = YEAGER_NULLPTR;
   GLuint m_InstancedObjs = 1;
   std::vector<std::shared_ptr<Transformation3D>> m_Props;
+  /* Where WriteInstances placed the transforms of this frame, nothing is drawn when they did not fit in the stream */
+  std::vector<Matrix4> m_InstanceMatrices;
+  Uint m_InstanceOffset = 0;
+  Uint m_InstanceCount = 0;
+  Uint m_InstanceTexels = 4;
+
+  /** @brief Computes the model space bounds, animated objects override to account for the animation movement */
+  virtual AABB ComputeLocalBounds();
+
+  AABB m_LocalBounds;
+  std::weak_ptr<AABBTree> m_CullingTree;
+  int m_CullingProxy = YEAGER_AABB_TREE_NULL_NODE;
+  Transformation3D m_CulledTransformation;
+  bool bCulled = false;
 };
 
 class AnimatedObject : public Object {
@@ -262,6 +341,9 @@ class AnimatedObject : public Object {
   bool ImportObjectFromFile(Cchar path, const ObjectCreationConfiguration configuration = ObjectCreationConfiguration(),
                             bool flip_image = false);
   virtual void Draw(Shader* shader);
+  virtual void DrawWithoutStateChanges(Shader* shader, float delta);
+  YEAGER_NODISCARD virtual GLuint GetFirstVertexArray();
+  YEAGER_NODISCARD virtual GLuint GetFirstTextureID();
   bool ThreadImportObjectFromFile(Cchar path,
                                   const ObjectCreationConfiguration configuration = ObjectCreationConfiguration(),
                                   bool flip_image = false);
@@ -270,17 +352,25 @@ class AnimatedObject : public Object {
 
   std::shared_ptr<AnimationEngine> GetAnimationEngine() { return m_AnimationEngine; }
 
+  /** @brief Samples the pose of the current animation, touches only this object so it runs in parallel with the others */
   void UpdateAnimation(float delta);
+  /** @brief Copies the final bone matrices into the palette slice of this object in the packed bone palette */
+  void WritePalette(std::span<Matrix4> palette) const;
+  /** @brief Points the shader to the palette slice of this object, the palette must already be uploaded and bound */
   void BuildAnimationMatrices(Shader* shader);
+  YEAGER_NODISCARD Uint GetPaletteBoneCount() const;
+  YEAGER_NODISCARD Uint GetPaletteOffset() const { return m_PaletteOffset; }
+  void SetPaletteOffset(Uint offset) { m_PaletteOffset = offset; }
   void BuildAnimation(String path);
-  void ThreadLoadIncompleteTextures();
 
  protected:
   void Setup();
   void DrawMeshes(Shader* shader);
+  AABB ComputeLocalBounds();
   AnimatedObjectModelData m_ModelData;
   std::shared_ptr<AnimationEngine> m_AnimationEngine = YEAGER_NULLPTR;
   std::shared_ptr<ImporterThreadedAnimated> m_ThreadImporter = YEAGER_NULLPTR;
+  Uint m_PaletteOffset = 0;
 };
 
 }  // namespace Yeager
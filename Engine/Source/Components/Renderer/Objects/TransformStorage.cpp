@@ -0,0 +1,302 @@
+#include "TransformStorage.h"
+#include "Components/Kernel/Process/JobSystem.h"
+#include "Components/Renderer/Objects/Entity.h"
+using namespace Yeager;
+
+/* Moves every live slot to its new index, the destroyed ones (sInvalidSlot in the map) are dropped */
+template <typename T>
+static void PermuteSlots(std::vector<T>* values, const std::vector<Uint>& newSlots, Uint alive)
+{
+  std::vector<T> permuted(alive);
+  for (Uint slot = 0; slot < newSlots.size(); slot++) {
+    if (newSlots[slot] != TransformStorage::sInvalidSlot)
+      permuted[newSlots[slot]] = std::move((*values)[slot]);
+  }
+  values->swap(permuted);
+}
+
+Matrix4 TransformStorage::ComposeLocal(const Vector3& position, const Vector3& rotation, const Vector3& scale)
+{
+  /* The three rotations multiplied by hand, instead of three glm::rotate around arbitrary axes */
+  const float sx = std::sin(glm::radians(rotation.x)), cx = std::cos(glm::radians(rotation.x));
+  const float sy = std::sin(glm::radians(rotation.y)), cy = std::cos(glm::radians(rotation.y));
+  const float sz = std::sin(glm::radians(rotation.z)), cz = std::cos(glm::radians(rotation.z));
+
+  Matrix4 model;
+  model[0] = Vector4(cy * cz, sx * sy * cz + cx * sz, sx * sz - cx * sy * cz, 0.0f) * scale.x;
+  model[1] = Vector4(-cy * sz, cx * cz - sx * sy * sz, cx * sy * sz + sx * cz, 0.0f) * scale.y;
+  model[2] = Vector4(sy, -sx * cy, cx * cy, 0.0f) * scale.z;
+  model[3] = Vector4(position, 1.0f);
+  return model;
+}
+
+TransformHandle TransformStorage::Create(const Transformation3D* source)
+{
+  TransformHandle handle;
+  if (!mFreeIndices.empty()) {
+    handle.Index = mFreeIndices.back();
+    mFreeIndices.pop_back();
+  } else {
+    handle.Index = static_cast<Uint>(mSlotOfHandle.size());
+    mSlotOfHandle.push_back(sInvalidSlot);
+    mGenerations.push_back(0);
+  }
+  handle.Generation = mGenerations[handle.Index];
+
+  /* Appended as a root, the order is fixed by the next update */
+  mSlotOfHandle[handle.Index] = static_cast<Uint>(mHandleOfSlot.size());
+  mHandleOfSlot.push_back(handle.Index);
+  mSource.push_back(source);
+  mLocalPosition.push_back(YEAGER_ZERO_VECTOR3);
+  mLocalRotation.push_back(YEAGER_ZERO_VECTOR3);
+  mLocalScale.push_back(Vector3(1.0f));
+  mWorld.push_back(YEAGER_IDENTITY_MATRIX4x4);
+  mParent.push_back(sInvalidSlot);
+  mDirty.push_back(0);
+  mUpdated.push_back(0);
+  bOrderDirty = true;
+
+  MarkDirty(handle);
+  return handle;
+}
+
+void TransformStorage::Destroy(TransformHandle handle)
+{
+  if (!IsValid(handle))
+    return;
+
+  const Uint slot = mSlotOfHandle[handle.Index];
+  mHandleOfSlot[slot] = sInvalidSlot;
+  mSource[slot] = YEAGER_NULLPTR;
+  mSlotOfHandle[handle.Index] = sInvalidSlot;
+  mGenerations[handle.Index]++;
+  mFreeIndices.push_back(handle.Index);
+  bOrderDirty = true;
+}
+
+bool TransformStorage::IsValid(TransformHandle handle) const
+{
+  return handle.Index < mSlotOfHandle.size() && mGenerations[handle.Index] == handle.Generation &&
+         mSlotOfHandle[handle.Index] != sInvalidSlot;
+}
+
+bool TransformStorage::SetParent(TransformHandle handle, TransformHandle parent)
+{
+  if (!IsValid(handle))
+    return false;
+
+  const Uint slot = mSlotOfHandle[handle.Index];
+  Uint parentSlot = sInvalidSlot;
+  if (parent != sInvalidHandle) {
+    if (!IsValid(parent))
+      return false;
+    parentSlot = mSlotOfHandle[parent.Index];
+    for (Uint ancestor = parentSlot; ancestor != sInvalidSlot; ancestor = mParent[ancestor]) {
+      if (ancestor == slot) {
+        Yeager::Log(WARNING, "Transform {} cannot be parented to one of its children!", handle.Index);
+        return false;
+      }
+    }
+  }
+
+  if (mParent[slot] != parentSlot) {
+    mParent[slot] = parentSlot;
+    bOrderDirty = true;
+    MarkDirty(handle);
+  }
+  return true;
+}
+
+TransformHandle TransformStorage::GetParent(TransformHandle handle) const
+{
+  if (!IsValid(handle))
+    return sInvalidHandle;
+  const Uint parent = mParent[mSlotOfHandle[handle.Index]];
+  if (parent == sInvalidSlot)
+    return sInvalidHandle;
+  const Uint index = mHandleOfSlot[parent];
+  return TransformHandle{index, mGenerations[index]};
+}
+
+void TransformStorage::SetLocal(TransformHandle handle, const Vector3& position, const Vector3& rotation,
+                                const Vector3& scale)
+{
+  if (!IsValid(handle))
+    return;
+  const Uint slot = mSlotOfHandle[handle.Index];
+  mLocalPosition[slot] = position;
+  mLocalRotation[slot] = rotation;
+  mLocalScale[slot] = scale;
+  MarkDirty(handle);
+}
+
+void TransformStorage::MarkDirty(TransformHandle handle)
+{
+  if (IsValid(handle))
+    MarkSlotDirty(mSlotOfHandle[handle.Index]);
+}
+
+void TransformStorage::MarkSlotDirty(Uint slot)
+{
+  if (mDirty[slot] == 0) {
+    mDirty[slot] = 1;
+    mDirtyCount++;
+  }
+}
+
+void TransformStorage::CopySource(Uint slot)
+{
+  const Transformation3D* source = mSource[slot];
+  mLocalPosition[slot] = source->position;
+  mLocalRotation[slot] = source->rotation;
+  mLocalScale[slot] = source->scale;
+}
+
+void TransformStorage::RebuildOrder()
+{
+  const Uint count = static_cast<Uint>(mHandleOfSlot.size());
+  std::vector<Uint> depths(count, sInvalidSlot);
+  std::vector<Uint> chain;
+  Uint alive = 0;
+  Uint levels = 0;
+
+  for (Uint slot = 0; slot < count; slot++) {
+    if (mHandleOfSlot[slot] == sInvalidSlot)
+      continue;
+    alive++;
+
+    /* Climbs until a slot with a known depth, then walks back down giving each one the depth of its parent plus one */
+    Uint current = slot;
+    while (depths[current] == sInvalidSlot) {
+      const Uint parent = mParent[current];
+      if (parent != sInvalidSlot && mHandleOfSlot[parent] == sInvalidSlot) {
+        /* The parent was destroyed, the world matrix is now the local one */
+        mParent[current] = sInvalidSlot;
+        MarkSlotDirty(current);
+      }
+      if (mParent[current] == sInvalidSlot) {
+        depths[current] = 0;
+        break;
+      }
+      chain.push_back(current);
+      current = mParent[current];
+    }
+    while (!chain.empty()) {
+      depths[chain.back()] = depths[mParent[chain.back()]] + 1;
+      chain.pop_back();
+    }
+    levels = std::max(levels, depths[slot] + 1);
+  }
+
+  /* Counting sort by depth, stable so the slots of the same level keep their relative order */
+  std::vector<Uint> levelBegins(levels + 1, 0);
+  for (Uint slot = 0; slot < count; slot++) {
+    if (mHandleOfSlot[slot] != sInvalidSlot)
+      levelBegins[depths[slot] + 1]++;
+  }
+  for (Uint level = 0; level < levels; level++) {
+    levelBegins[level + 1] += levelBegins[level];
+  }
+  mLevelEnds.assign(levelBegins.begin() + 1, levelBegins.end());
+
+  std::vector<Uint> newSlots(count, sInvalidSlot);
+  for (Uint slot = 0; slot < count; slot++) {
+    if (mHandleOfSlot[slot] != sInvalidSlot)
+      newSlots[slot] = levelBegins[depths[slot]]++;
+  }
+  for (Uint slot = 0; slot < count; slot++) {
+    if (mHandleOfSlot[slot] != sInvalidSlot && mParent[slot] != sInvalidSlot)
+      mParent[slot] = newSlots[mParent[slot]];
+  }
+
+  PermuteSlots(&mHandleOfSlot, newSlots, alive);
+  PermuteSlots(&mSource, newSlots, alive);
+  PermuteSlots(&mLocalPosition, newSlots, alive);
+  PermuteSlots(&mLocalRotation, newSlots, alive);
+  PermuteSlots(&mLocalScale, newSlots, alive);
+  PermuteSlots(&mWorld, newSlots, alive);
+  PermuteSlots(&mParent, newSlots, alive);
+  PermuteSlots(&mDirty, newSlots, alive);
+  PermuteSlots(&mUpdated, newSlots, alive);
+
+  for (Uint slot = 0; slot < alive; slot++) {
+    mSlotOfHandle[mHandleOfSlot[slot]] = slot;
+  }
+  bOrderDirty = false;
+}
+
+void TransformStorage::UpdateRange(Uint begin, Uint end)
+{
+  /* The flags are chars, a store through them could alias the vectors themselves, so the arrays are read only once */
+  const Uint* parents = mParent.data();
+  unsigned char* dirty = mDirty.data();
+  unsigned char* updatedFlags = mUpdated.data();
+  Matrix4* world = mWorld.data();
+
+  Uint updated = 0;
+  for (Uint slot = begin; slot < end; slot++) {
+    /* The parent belongs to a level before this one, its flag is already the one of this update */
+    const Uint parent = parents[slot];
+    const bool parentUpdated = parent != sInvalidSlot && updatedFlags[parent] != 0;
+    const bool changed = dirty[slot] != 0 || parentUpdated;
+    updatedFlags[slot] = changed ? 1 : 0;
+    if (!changed)
+      continue;
+
+    if (dirty[slot] != 0 && mSource[slot] != YEAGER_NULLPTR)
+      CopySource(slot);
+    dirty[slot] = 0;
+
+    const Matrix4 local = ComposeLocal(mLocalPosition[slot], mLocalRotation[slot], mLocalScale[slot]);
+    world[slot] = parent != sInvalidSlot ? world[parent] * local : local;
+    updated++;
+  }
+  if (updated > 0)
+    mLastUpdated.fetch_add(updated, std::memory_order_relaxed);
+}
+
+void TransformStorage::Update()
+{
+  if (bOrderDirty)
+    RebuildOrder();
+
+  /* Nothing changed, and the flags of the last update are already clear */
+  if (mDirtyCount == 0 && mLastUpdated.load(std::memory_order_relaxed) == 0)
+    return;
+
+  mLastUpdated.store(0, std::memory_order_relaxed);
+  Uint begin = 0;
+  for (const Uint end : mLevelEnds) {
+    const Uint count = end - begin;
+    if (count >= YEAGER_TRANSFORM_PARALLEL_MIN_COUNT && JobSystem::GetWorkerCount() > 1) {
+      JobSystem::ParallelFor(count, YEAGER_TRANSFORM_PARALLEL_GRAIN,
+                             [this, begin](Uint first, Uint last) { UpdateRange(begin + first, begin + last); });
+    } else {
+      UpdateRange(begin, end);
+    }
+    begin = end;
+  }
+  mDirtyCount = 0;
+}
+
+Matrix4 TransformStorage::GetWorldMatrix(TransformHandle handle) const
+{
+  if (!IsValid(handle))
+    return YEAGER_IDENTITY_MATRIX4x4;
+
+  const Uint slot = mSlotOfHandle[handle.Index];
+  if (mDirty[slot] == 0)
+    return mWorld[slot];
+
+  const Transformation3D* source = mSource[slot];
+  const Matrix4 local = source != YEAGER_NULLPTR
+                            ? ComposeLocal(source->position, source->rotation, source->scale)
+                            : ComposeLocal(mLocalPosition[slot], mLocalRotation[slot], mLocalScale[slot]);
+  const Uint parent = mParent[slot];
+  return parent != sInvalidSlot ? mWorld[parent] * local : local;
+}
+
+bool TransformStorage::WasUpdated(TransformHandle handle) const
+{
+  return IsValid(handle) && mUpdated[mSlotOfHandle[handle.Index]] != 0;
+}
@@ -0,0 +1,137 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+/* Levels with less transforms than this are updated in the calling thread, the jobs cost more than the matrices */
+#define YEAGER_TRANSFORM_PARALLEL_MIN_COUNT 4096
+#define YEAGER_TRANSFORM_PARALLEL_GRAIN 1024
+
+namespace Yeager {
+
+struct Transformation3D;
+
+/**
+ * @brief Stable reference to a transform, the slot behind it moves every time the storage is reordered. The generation
+ * is incremented when the transform is destroyed, a handle kept after that no longer matches the index reused by
+ * another transform and every lookup with it fails
+ */
+struct TransformHandle {
+  static YEAGER_CONSTEXPR Uint sInvalidIndex = std::numeric_limits<Uint>::max();
+
+  Uint Index = sInvalidIndex;
+  Uint Generation = 0;
+
+  bool operator==(const TransformHandle& other) const
+  {
+    return Index == other.Index && Generation == other.Generation;
+  }
+  bool operator!=(const TransformHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Local transforms and world matrices of the game entities stored as parallel arrays, the slots are sorted by
+ * their depth in the hierarchy so every parent comes before its children. Changes only mark the transform as dirty,
+ * the world matrices of the dirty transforms and of everything below them are rebuilt once per frame in a single pass
+ * over the arrays. Transforms of the same depth do not depend on each other, big levels are split across the workers
+ * @attention Not thread safe, everything except the inside of Update must run in the main thread
+ */
+class TransformStorage {
+ public:
+  static YEAGER_CONSTEXPR TransformHandle sInvalidHandle = TransformHandle();
+  /* Marks the roots in the parent slots, and the destroyed transforms in the maps between handles and slots */
+  static YEAGER_CONSTEXPR Uint sInvalidSlot = std::numeric_limits<Uint>::max();
+
+  TransformStorage() = default;
+
+  /**
+   * @brief Creates a root transform. With a source, the local values are copied from it when the transform is marked
+   * dirty, the source must outlive the transform
+   */
+  TransformHandle Create(const Transformation3D* source = YEAGER_NULLPTR);
+  /** @brief The children of a destroyed transform become roots */
+  void Destroy(TransformHandle handle);
+
+  /** @brief An invalid parent makes the transform a root, returns false if the parent is the transform or below it */
+  bool SetParent(TransformHandle handle, TransformHandle parent);
+  YEAGER_NODISCARD TransformHandle GetParent(TransformHandle handle) const;
+
+  /** @brief For transforms without a source */
+  void SetLocal(TransformHandle handle, const Vector3& position, const Vector3& rotation, const Vector3& scale);
+  void MarkDirty(TransformHandle handle);
+
+  /** @brief Rebuilds the world matrices of the dirty transforms and their children, returns right away if none */
+  void Update();
+
+  /**
+   * @brief World matrix of the last update. A transform marked dirty since then is composed on the spot from its
+   * local values and the last world matrix of its parent
+   */
+  YEAGER_NODISCARD Matrix4 GetWorldMatrix(TransformHandle handle) const;
+  /** @brief Returns true if the world matrix was rebuilt by the last update, directly or by one of its parents */
+  YEAGER_NODISCARD bool WasUpdated(TransformHandle handle) const;
+  YEAGER_NODISCARD bool IsValid(TransformHandle handle) const;
+
+  YEAGER_NODISCARD Uint GetTransformCount() const
+  {
+    return static_cast<Uint>(mSlotOfHandle.size() - mFreeIndices.size());
+  }
+  YEAGER_NODISCARD Uint GetLevelCount() const { return static_cast<Uint>(mLevelEnds.size()); }
+  YEAGER_NODISCARD Uint GetLastUpdatedCount() const { return mLastUpdated.load(std::memory_order_relaxed); }
+
+  /** @brief Same matrix as Transformation3D::Apply, translation * rotation x * rotation y * rotation z * scale */
+  YEAGER_NODISCARD static Matrix4 ComposeLocal(const Vector3& position, const Vector3& rotation, const Vector3& scale);
+
+ private:
+  /** @brief Removes the destroyed slots and sorts the others by depth, keeping their relative order */
+  void RebuildOrder();
+  void UpdateRange(Uint begin, Uint end);
+  void CopySource(Uint slot);
+  void MarkSlotDirty(Uint slot);
+
+  /* Indexed by the handle index */
+  std::vector<Uint> mSlotOfHandle;
+  std::vector<Uint> mGenerations;
+  std::vector<Uint> mFreeIndices;
+
+  /* One entry per slot, the index of the handle of the slot */
+  std::vector<Uint> mHandleOfSlot;
+  std::vector<const Transformation3D*> mSource;
+  std::vector<Vector3> mLocalPosition;
+  std::vector<Vector3> mLocalRotation;
+  std::vector<Vector3> mLocalScale;
+  std::vector<Matrix4> mWorld;
+  /* Slot of the parent, sInvalidSlot for the roots */
+  std::vector<Uint> mParent;
+  std::vector<unsigned char> mDirty;
+  /* Rebuilt by the last update, read by the children of the next level */
+  std::vector<unsigned char> mUpdated;
+
+  /* End slot of each depth level */
+  std::vector<Uint> mLevelEnds;
+  Uint mDirtyCount = 0;
+  bool bOrderDirty = false;
+  std::atomic<Uint> mLastUpdated = 0;
+};
+
+}  // namespace Yeager
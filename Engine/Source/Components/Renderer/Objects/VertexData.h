@@ -0,0 +1,42 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+struct ObjectVertexData {
+  Vector3 Position = Vector3(0.0f);
+  Vector3 Normals = Vector3(0.0f);
+  Vector2 TextureCoords = Vector2(0.0f);
+};
+
+#define MAX_BONE_INFLUENCE 4
+
+struct AnimatedVertexData : public ObjectVertexData {
+  Vector3 Tangent = Vector3(0.0f);
+  Vector3 BiTangent = Vector3(0.0f);
+  int BonesIDs[MAX_BONE_INFLUENCE];
+  float Weights[MAX_BONE_INFLUENCE];
+};
+
+}  // namespace Yeager
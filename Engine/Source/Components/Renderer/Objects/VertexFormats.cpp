@@ -0,0 +1,110 @@
+#include "VertexFormats.h"
+using namespace Yeager;
+
+const VertexFormatDescriptor& Yeager::GetObjectVertexFormat()
+{
+  static const VertexFormatDescriptor format = {
+      sizeof(ObjectVertexData),
+      {{0, 3, GL_FLOAT, false, false, offsetof(ObjectVertexData, Position)},
+       {1, 3, GL_FLOAT, false, false, offsetof(ObjectVertexData, Normals)},
+       {2, 2, GL_FLOAT, false, false, offsetof(ObjectVertexData, TextureCoords)}}};
+  return format;
+}
+
+const VertexFormatDescriptor& Yeager::GetAnimatedVertexFormat()
+{
+  static const VertexFormatDescriptor format = {
+      sizeof(AnimatedVertexData),
+      {{0, 3, GL_FLOAT, false, false, offsetof(AnimatedVertexData, Position)},
+       {1, 3, GL_FLOAT, false, false, offsetof(AnimatedVertexData, Normals)},
+       {2, 2, GL_FLOAT, false, false, offsetof(AnimatedVertexData, TextureCoords)},
+       {3, 3, GL_FLOAT, false, false, offsetof(AnimatedVertexData, Tangent)},
+       {4, 3, GL_FLOAT, false, false, offsetof(AnimatedVertexData, BiTangent)},
+       /* The shader declares the bones as ivec4, a float attribute would be read as garbage */
+       {5, 4, GL_INT, false, true, offsetof(AnimatedVertexData, BonesIDs)},
+       {6, 4, GL_FLOAT, false, false, offsetof(AnimatedVertexData, Weights)}}};
+  return format;
+}
+
+const VertexFormatDescriptor& Yeager::GetCompactObjectVertexFormat()
+{
+  static const VertexFormatDescriptor format = {
+      sizeof(CompactObjectVertexData),
+      {{0, 3, GL_SHORT, true, false, offsetof(CompactObjectVertexData, Position)},
+       {1, 2, GL_SHORT, true, false, offsetof(CompactObjectVertexData, Normals)},
+       {2, 2, GL_HALF_FLOAT, false, false, offsetof(CompactObjectVertexData, TextureCoords)}}};
+  return format;
+}
+
+const VertexFormatDescriptor& Yeager::GetCompactAnimatedVertexFormat()
+{
+  static const VertexFormatDescriptor format = {
+      sizeof(CompactAnimatedVertexData),
+      {{0, 3, GL_SHORT, true, false, offsetof(CompactAnimatedVertexData, Position)},
+       {1, 2, GL_SHORT, true, false, offsetof(CompactAnimatedVertexData, Normals)},
+       {2, 2, GL_HALF_FLOAT, false, false, offsetof(CompactAnimatedVertexData, TextureCoords)},
+       {3, 2, GL_SHORT, true, false, offsetof(CompactAnimatedVertexData, Tangent)},
+       {4, 2, GL_SHORT, true, false, offsetof(CompactAnimatedVertexData, BiTangent)},
+       {5, 4, GL_UNSIGNED_BYTE, false, true, offsetof(CompactAnimatedVertexData, BonesIDs)},
+       {6, 4, GL_UNSIGNED_BYTE, true, false, offsetof(CompactAnimatedVertexData, Weights)}}};
+  return format;
+}
+
+CompactObjectVertexData Yeager::EncodeCompactVertex(const ObjectVertexData& vertex,
+                                                    const PositionQuantization& quantization)
+{
+  CompactObjectVertexData compact;
+  quantization.Encode(vertex.Position, compact.Position);
+  OctahedralEncodeSnorm16(vertex.Normals, compact.Normals);
+  compact.TextureCoords[0] = FloatToHalf(vertex.TextureCoords.x);
+  compact.TextureCoords[1] = FloatToHalf(vertex.TextureCoords.y);
+  return compact;
+}
+
+CompactAnimatedVertexData Yeager::EncodeCompactVertex(const AnimatedVertexData& vertex,
+                                                      const PositionQuantization& quantization)
+{
+  CompactAnimatedVertexData compact;
+  quantization.Encode(vertex.Position, compact.Position);
+  OctahedralEncodeSnorm16(vertex.Normals, compact.Normals);
+  compact.TextureCoords[0] = FloatToHalf(vertex.TextureCoords.x);
+  compact.TextureCoords[1] = FloatToHalf(vertex.TextureCoords.y);
+  OctahedralEncodeSnorm16(vertex.Tangent, compact.Tangent);
+  OctahedralEncodeSnorm16(vertex.BiTangent, compact.BiTangent);
+
+  float weights[MAX_BONE_INFLUENCE];
+  for (Uint x = 0; x < MAX_BONE_INFLUENCE; x++) {
+    const int bone = vertex.BonesIDs[x];
+    /* Ids past 255 keep the 255, which the shader treats like any id outside the palette and renders the bind pose */
+    compact.BonesIDs[x] = static_cast<uint8_t>(std::clamp(bone, 0, 255));
+    weights[x] = bone < 0 ? 0.0f : vertex.Weights[x];
+  }
+  QuantizeWeightsUnorm8(weights, MAX_BONE_INFLUENCE, compact.Weights);
+  return compact;
+}
+
+ObjectVertexData Yeager::DecodeCompactVertex(const CompactObjectVertexData& vertex,
+                                             const PositionQuantization& quantization)
+{
+  ObjectVertexData decoded;
+  decoded.Position = quantization.Decode(vertex.Position);
+  decoded.Normals = OctahedralDecodeSnorm16(vertex.Normals);
+  decoded.TextureCoords = Vector2(HalfToFloat(vertex.TextureCoords[0]), HalfToFloat(vertex.TextureCoords[1]));
+  return decoded;
+}
+
+AnimatedVertexData Yeager::DecodeCompactVertex(const CompactAnimatedVertexData& vertex,
+                                               const PositionQuantization& quantization)
+{
+  AnimatedVertexData decoded;
+  decoded.Position = quantization.Decode(vertex.Position);
+  decoded.Normals = OctahedralDecodeSnorm16(vertex.Normals);
+  decoded.TextureCoords = Vector2(HalfToFloat(vertex.TextureCoords[0]), HalfToFloat(vertex.TextureCoords[1]));
+  decoded.Tangent = OctahedralDecodeSnorm16(vertex.Tangent);
+  decoded.BiTangent = OctahedralDecodeSnorm16(vertex.BiTangent);
+  for (Uint x = 0; x < MAX_BONE_INFLUENCE; x++) {
+    decoded.BonesIDs[x] = vertex.Weights[x] == 0 ? -1 : static_cast<int>(vertex.BonesIDs[x]);
+    decoded.Weights[x] = DequantizeUnorm8(vertex.Weights[x]);
+  }
+  return decoded;
+}
@@ -0,0 +1,87 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Math/Quantization.h"
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+#include "Components/Renderer/GL/OpenGLRender.h"
+#include "Components/Renderer/Objects/Object.h"
+
+namespace Yeager {
+
+/**
+ * @brief Compact version of ObjectVertexData, 16 bytes instead of 32. Positions are snorm16 relative to the mesh bounds
+ * (see PositionQuantization), normals are octahedral snorm16 and the texture coordinates are half floats
+ */
+struct CompactObjectVertexData {
+  int16_t Position[4] = {0, 0, 0, 0};
+  int16_t Normals[2] = {0, 0};
+  uint16_t TextureCoords[2] = {0, 0};
+};
+
+/**
+ * @brief Compact version of AnimatedVertexData, 32 bytes instead of 88. Tangents are octahedral like the normals, the bones
+ * indices are uint8 and the weights unorm8. Unused influences are stored as bone 0 with weight 0
+ */
+struct CompactAnimatedVertexData {
+  int16_t Position[4] = {0, 0, 0, 0};
+  int16_t Normals[2] = {0, 0};
+  uint16_t TextureCoords[2] = {0, 0};
+  int16_t Tangent[2] = {0, 0};
+  int16_t BiTangent[2] = {0, 0};
+  uint8_t BonesIDs[MAX_BONE_INFLUENCE] = {0, 0, 0, 0};
+  uint8_t Weights[MAX_BONE_INFLUENCE] = {0, 0, 0, 0};
+};
+
+static_assert(sizeof(CompactObjectVertexData) == 16, "Compact vertex must stay 16 bytes");
+static_assert(sizeof(CompactAnimatedVertexData) == 32, "Compact animated vertex must stay 32 bytes");
+
+/** @brief Attribute layouts of each vertex type, the locations match the ones declared in the Simple shaders */
+YEAGER_NODISCARD extern const VertexFormatDescriptor& GetObjectVertexFormat();
+YEAGER_NODISCARD extern const VertexFormatDescriptor& GetAnimatedVertexFormat();
+YEAGER_NODISCARD extern const VertexFormatDescriptor& GetCompactObjectVertexFormat();
+YEAGER_NODISCARD extern const VertexFormatDescriptor& GetCompactAnimatedVertexFormat();
+
+YEAGER_NODISCARD extern CompactObjectVertexData EncodeCompactVertex(const ObjectVertexData& vertex,
+                                                                    const PositionQuantization& quantization);
+YEAGER_NODISCARD extern CompactAnimatedVertexData EncodeCompactVertex(const AnimatedVertexData& vertex,
+                                                                      const PositionQuantization& quantization);
+YEAGER_NODISCARD extern ObjectVertexData DecodeCompactVertex(const CompactObjectVertexData& vertex,
+                                                             const PositionQuantization& quantization);
+YEAGER_NODISCARD extern AnimatedVertexData DecodeCompactVertex(const CompactAnimatedVertexData& vertex,
+                                                               const PositionQuantization& quantization);
+
+template <typename VertexType>
+using CompactVertexOf = decltype(EncodeCompactVertex(std::declval<VertexType>(), PositionQuantization()));
+
+template <typename VertexType>
+YEAGER_NODISCARD std::vector<CompactVertexOf<VertexType>> EncodeCompactVertices(
+    std::span<const VertexType> vertices, const PositionQuantization& quantization)
+{
+  std::vector<CompactVertexOf<VertexType>> compact;
+  compact.reserve(vertices.size());
+  for (const auto& vertex : vertices)
+    compact.push_back(EncodeCompactVertex(vertex, quantization));
+  return compact;
+}
+
+}  // namespace Yeager
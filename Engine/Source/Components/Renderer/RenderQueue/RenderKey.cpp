@@ -0,0 +1,75 @@
+#include "RenderQueue.h"
+using namespace Yeager;
+
+uint64_t Yeager::BuildRenderKey(Uint pass, Uint shader, Uint material, Uint mesh, float depth)
+{
+  const uint64_t depthMax = (1ull << YEAGER_RENDER_KEY_DEPTH_BITS) - 1;
+  const uint64_t quantized = static_cast<uint64_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(depthMax));
+  const bool transparent = pass == RenderQueuePass::eTRANSPARENT;
+
+  uint64_t key = 0;
+  key |= (static_cast<uint64_t>(pass) & ((1ull << YEAGER_RENDER_KEY_PASS_BITS) - 1));
+  if (transparent) {
+    key <<= YEAGER_RENDER_KEY_DEPTH_BITS;
+    key |= depthMax - (quantized & depthMax);
+  }
+  key <<= YEAGER_RENDER_KEY_SHADER_BITS;
+  key |= (static_cast<uint64_t>(shader) & ((1ull << YEAGER_RENDER_KEY_SHADER_BITS) - 1));
+  key <<= YEAGER_RENDER_KEY_MATERIAL_BITS;
+  key |= (static_cast<uint64_t>(material) & ((1ull << YEAGER_RENDER_KEY_MATERIAL_BITS) - 1));
+  key <<= YEAGER_RENDER_KEY_MESH_BITS;
+  key |= (static_cast<uint64_t>(mesh) & ((1ull << YEAGER_RENDER_KEY_MESH_BITS) - 1));
+  if (!transparent) {
+    key <<= YEAGER_RENDER_KEY_DEPTH_BITS;
+    key |= (quantized & depthMax);
+  }
+  return key;
+}
+
+void Yeager::RadixSortRenderPackets(std::vector<RenderPacket>* packets, RenderSortScratch* scratch)
+{
+  const std::size_t size = packets->size();
+  if (size < 2)
+    return;
+
+  /* All the histograms are built in a single read of the keys */
+  std::size_t histograms[8][256] = {};
+  scratch->Entries.resize(size);
+  scratch->Swap.resize(size);
+  for (std::size_t x = 0; x < size; x++) {
+    const uint64_t key = (*packets)[x].Key;
+    scratch->Entries[x] = RenderSortEntry{key, static_cast<Uint>(x)};
+    for (Uint byte = 0; byte < 8; byte++) {
+      histograms[byte][(key >> (byte * 8)) & 0xFF]++;
+    }
+  }
+
+  RenderSortEntry* src = scratch->Entries.data();
+  RenderSortEntry* dst = scratch->Swap.data();
+
+  for (Uint byte = 0; byte < 8; byte++) {
+    std::size_t* histogram = histograms[byte];
+
+    /* Every key have the same value in this byte, the order would not change */
+    if (histogram[(src[0].Key >> (byte * 8)) & 0xFF] == size)
+      continue;
+
+    std::size_t offset = 0;
+    for (Uint x = 0; x < 256; x++) {
+      std::size_t count = histogram[x];
+      histogram[x] = offset;
+      offset += count;
+    }
+
+    for (std::size_t x = 0; x < size; x++) {
+      dst[histogram[(src[x].Key >> (byte * 8)) & 0xFF]++] = src[x];
+    }
+    std::swap(src, dst);
+  }
+
+  scratch->Packets.resize(size);
+  for (std::size_t x = 0; x < size; x++) {
+    scratch->Packets[x] = (*packets)[src[x].Index];
+  }
+  packets->swap(scratch->Packets);
+}
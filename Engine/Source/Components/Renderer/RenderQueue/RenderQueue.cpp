@@ -0,0 +1,112 @@
+#include "RenderQueue.h"
+#include "Components/Renderer/GL/OpenGLRender.h"
+#include "Components/Renderer/Objects/Object.h"
+using namespace Yeager;
+
+static RenderQueuePass::Enum GetObjectPass(Object* object)
+{
+  return object->GetOnScreenProprieties()->m_Transparent ? RenderQueuePass::eTRANSPARENT : RenderQueuePass::eOPAQUE;
+}
+
+void RenderQueue::Clear()
+{
+  mPackets.clear();
+}
+
+void RenderQueue::SetViewer(const Vector3& position, float farPlane)
+{
+  mViewerPosition = position;
+  mFarPlane = farPlane > 0.0f ? farPlane : 1.0f;
+}
+
+RenderPacket RenderQueue::BuildPacket(Object* object, Shader* shader, RenderQueuePass::Enum pass,
+                                      RenderPacketType::Enum type)
+{
+  RenderPacket packet;
+  packet.Source = object;
+  packet.Program = shader;
+  packet.Type = type;
+  packet.Pass = pass;
+
+  const ObjectOnScreenProprieties* proprieties = object->GetOnScreenProprieties();
+  packet.Culling = proprieties->m_CullingEnabled;
+  switch (proprieties->m_PolygonMode) {
+    case RenderingGLPolygonMode::eLINES:
+      packet.PolygonMode = GL_LINE;
+      break;
+    case RenderingGLPolygonMode::ePOINTS:
+      packet.PolygonMode = GL_POINT;
+      break;
+    case RenderingGLPolygonMode::eFILL:
+    default:
+      packet.PolygonMode = GL_FILL;
+  }
+
+  /* The render states goes in the top bits of the material, so objects with the same states are grouped together */
+  const Uint states = (static_cast<Uint>(proprieties->m_PolygonMode) << 1) | (packet.Culling ? 1 : 0);
+  const Uint material = (states << (YEAGER_RENDER_KEY_MATERIAL_BITS - 3)) | (object->GetFirstTextureID() & 0x1FFF);
+
+  const float depth = glm::length(object->GetTransformation().position - mViewerPosition) / mFarPlane;
+  packet.Key = BuildRenderKey(pass, shader->GetId(), material, object->GetFirstVertexArray(), depth);
+  return packet;
+}
+
+void RenderQueue::Push(Object* object, Shader* shader, RenderQueuePass::Enum pass)
+{
+  mPackets.push_back(BuildPacket(object, shader, pass, RenderPacketType::eOBJECT));
+}
+
+void RenderQueue::Push(AnimatedObject* object, Shader* shader, RenderQueuePass::Enum pass)
+{
+  mPackets.push_back(BuildPacket(object, shader, pass, RenderPacketType::eANIMATED_OBJECT));
+}
+
+void RenderQueue::Push(Object* object, Shader* shader)
+{
+  Push(object, shader, GetObjectPass(object));
+}
+
+void RenderQueue::Push(AnimatedObject* object, Shader* shader)
+{
+  Push(object, shader, GetObjectPass(object));
+}
+
+void RenderQueue::Sort()
+{
+  RadixSortRenderPackets(&mPackets, &mScratch);
+}
+
+void RenderQueue::Submit(float delta)
+{
+  /* Someone might have changed the states since the last submission */
+  GLStateCache::Invalidate();
+  bool depthWrites = true;
+
+  for (const auto& packet : mPackets) {
+    IntervalElapsedTimeManager::StartTimeInterval(packet.Source->GetName());
+
+    /* Sorted by pass, once the transparent packets start every packet left is transparent */
+    if (depthWrites && packet.Pass == RenderQueuePass::eTRANSPARENT) {
+      GL_CALL(glDepthMask(GL_FALSE));
+      depthWrites = false;
+    }
+
+    GLStateCache::SetPolygonMode(packet.PolygonMode);
+    GLStateCache::SetCullFace(packet.Culling);
+    packet.Program->UseShader();
+
+    if (packet.Type == RenderPacketType::eANIMATED_OBJECT)
+      static_cast<AnimatedObject*>(packet.Source)->BuildAnimationMatrices(packet.Program);
+
+    packet.Source->DrawWithoutStateChanges(packet.Program, delta);
+
+    IntervalElapsedTimeManager::EndTimeInterval(packet.Source->GetName());
+  }
+
+  if (!depthWrites)
+    GL_CALL(glDepthMask(GL_TRUE));
+  GLStateCache::SetPolygonMode(GL_FILL);
+  GLStateCache::SetCullFace(true);
+  /* The pooled meshes leave the vertex array of their pool bound */
+  SimpleRenderer::UnbindVertexArray();
+}
@@ -0,0 +1,135 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+class Object;
+class AnimatedObject;
+class Shader;
+
+/* Bits of each field of the render key, from the most significant to the least significant */
+#define YEAGER_RENDER_KEY_PASS_BITS 4
+#define YEAGER_RENDER_KEY_SHADER_BITS 12
+#define YEAGER_RENDER_KEY_MATERIAL_BITS 16
+#define YEAGER_RENDER_KEY_MESH_BITS 12
+#define YEAGER_RENDER_KEY_DEPTH_BITS 20
+
+static_assert(YEAGER_RENDER_KEY_PASS_BITS + YEAGER_RENDER_KEY_SHADER_BITS + YEAGER_RENDER_KEY_MATERIAL_BITS +
+                      YEAGER_RENDER_KEY_MESH_BITS + YEAGER_RENDER_KEY_DEPTH_BITS ==
+                  64,
+              "The render key must use exactly 64 bits!");
+
+/** @brief Passes are drawn in the order they are declared, the opaque objects first */
+struct RenderQueuePass {
+  enum Enum { eOPAQUE = 0, eTRANSPARENT = 1 };
+};
+
+struct RenderPacketType {
+  enum Enum { eOBJECT, eANIMATED_OBJECT };
+};
+
+/**
+ * @brief Lightweight draw packet, the key decides the order of the submission, packets that share the pass, shader and
+ * material end up next to each other so the state changes between them can be skipped
+ */
+struct RenderPacket {
+  uint64_t Key = 0;
+  Object* Source = YEAGER_NULLPTR;
+  Shader* Program = YEAGER_NULLPTR;
+  RenderPacketType::Enum Type = RenderPacketType::eOBJECT;
+  RenderQueuePass::Enum Pass = RenderQueuePass::eOPAQUE;
+  /* Render states that are part of the material field of the key */
+  GLenum PolygonMode = GL_FILL;
+  bool Culling = true;
+};
+
+/**
+ * @brief Packs the fields into a 64 bits key, every field is masked to its amount of bits. The depth is expected to be
+ * normalized between 0 and 1, and is quantized so closer objects come first (front to back). Transparent draws are
+ * blended, so their depth is inverted (back to front) and moved right after the pass, above the shader, material and
+ * mesh fields, which then only order the draws at the same depth
+ */
+YEAGER_NODISCARD extern uint64_t BuildRenderKey(Uint pass, Uint shader, Uint material, Uint mesh, float depth);
+
+/* Key of a packet and its position in the queue, what the radix sort moves on each pass */
+struct RenderSortEntry {
+  uint64_t Key = 0;
+  Uint Index = 0;
+};
+
+/** @brief Memory used by the sort, kept between the frames to avoid reallocation */
+struct RenderSortScratch {
+  std::vector<RenderSortEntry> Entries;
+  std::vector<RenderSortEntry> Swap;
+  std::vector<RenderPacket> Packets;
+};
+
+/**
+ * @brief Least significant digit radix sort of the packets by key, 8 bits per pass. Passes where every key has the same
+ * byte are skipped. Only the keys and the positions of the packets move on each pass, the packets themselves are moved
+ * once at the end. Stable
+ */
+extern void RadixSortRenderPackets(std::vector<RenderPacket>* packets, RenderSortScratch* scratch);
+
+/**
+ * @brief Collects the draw packets of the frame, sorts them and submits with the redundant states changes elided
+ */
+class RenderQueue {
+ public:
+  RenderQueue() = default;
+
+  /** @brief Removes the packets from the last frame, the memory is kept */
+  void Clear();
+
+  /** @brief Sets the viewer position and the far plane, used to compute the depth of the packets pushed after */
+  void SetViewer(const Vector3& position, float farPlane);
+
+  void Push(Object* object, Shader* shader, RenderQueuePass::Enum pass);
+  void Push(AnimatedObject* object, Shader* shader, RenderQueuePass::Enum pass);
+  /** @brief Pushes into the transparent pass the objects marked as transparent, the others into the opaque pass */
+  void Push(Object* object, Shader* shader);
+  void Push(AnimatedObject* object, Shader* shader);
+
+  void Sort();
+
+  /**
+   * @brief Draws every packet in the order of the keys, and restores the default states (fill, culling and no vertex
+   * array) at the end. The transparent pass is drawn without writing the depth, so the blended objects do not hide
+   * each other
+   */
+  void Submit(float delta);
+
+  YEAGER_NODISCARD Uint GetPacketCount() const { return mPackets.size(); }
+  YEAGER_NODISCARD const std::vector<RenderPacket>& GetPackets() const { return mPackets; }
+
+ private:
+  RenderPacket BuildPacket(Object* object, Shader* shader, RenderQueuePass::Enum pass, RenderPacketType::Enum type);
+
+  std::vector<RenderPacket> mPackets;
+  RenderSortScratch mScratch;
+  Vector3 mViewerPosition = YEAGER_ZERO_VECTOR3;
+  float mFarPlane = 1000.0f;
+};
+
+}  // namespace Yeager
@@ -1,4 +1,5 @@
 #include "ShaderHandle.h"
+#include "Components/Renderer/GL/OpenGLRender.h"
 using namespace Yeager;
 
 Shader::Shader(Cchar fragmentPath, Cchar vertexPath, String name)
@@ -112,46 +113,112 @@ void Shader::LinkShaders(Uint vertexShader, Uint fragmentShader)
     Yeager::Log(ERROR, "Cannot link shaders: {}, ID: {}, Error: {}", mShaderName.c_str(), mShaderN, linkInfo);
   } else {
     Yeager::Log(INFO, "Success in linking shaders: {}, ID: {}", mShaderName.c_str(), mShaderN);
+    ReflectUniforms();
   }
 
   glDeleteShader(vertexShader);
   glDeleteShader(fragmentShader);
 }
 
+void Shader::ReflectUniforms()
+{
+  UniformReflectionFunctions functions;
+  functions.GetProgramiv = [](GLuint program, GLenum name, GLint* value) { glGetProgramiv(program, name, value); };
+  functions.GetActiveUniform = [](GLuint program, GLuint index, GLsizei bufferSize, GLsizei* length, GLint* size,
+                                  GLenum* type, GLchar* name) {
+    glGetActiveUniform(program, index, bufferSize, length, size, type, name);
+  };
+  functions.GetUniformLocation = [](GLuint program, const GLchar* name) { return glGetUniformLocation(program, name); };
+  ReflectUniformTable(&mUniformTable, mShaderID, functions);
+
+  Yeager::LogDebug(INFO, "Shader {} reflected {} uniform locations", mShaderName, mUniformTable.GetSize());
+}
+
+GLint Shader::GetUniformLocation(const UniformHandle& handle) const
+{
+  if (!mUniformTable.IsBuilt())
+    return glGetUniformLocation(mShaderID, handle.Name.c_str());
+
+  GLint location = mUniformTable.Find(handle.Hash, handle.Name);
+  if (location == UniformTable::sCollidedLocation)
+    return glGetUniformLocation(mShaderID, handle.Name.c_str());
+  return location;
+}
+
+GLint Shader::GetUniformLocation(const String& name) const
+{
+  if (!mUniformTable.IsBuilt())
+    return glGetUniformLocation(mShaderID, name.c_str());
+
+  GLint location = mUniformTable.Find(HashUniformName(name), name);
+  if (location == UniformTable::sCollidedLocation)
+    return glGetUniformLocation(mShaderID, name.c_str());
+  return location;
+}
+
 void Shader::SetInt(const String& name, int value)
 {
-  glUniform1i(glGetUniformLocation(mShaderID, name.c_str()), value);
+  glUniform1i(GetUniformLocation(name), value);
 }
 void Shader::SetBool(const String& name, bool value)
 {
-  glUniform1i(glGetUniformLocation(mShaderID, name.c_str()), (int)value);
+  glUniform1i(GetUniformLocation(name), (int)value);
 }
 void Shader::SetFloat(const String& name, float value)
 {
-  glUniform1f(glGetUniformLocation(mShaderID, name.c_str()), value);
+  glUniform1f(GetUniformLocation(name), value);
 }
 void Shader::SetMat4(const String& name, Matrix4 value)
 {
-  glUniformMatrix4fv(glGetUniformLocation(mShaderID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+  glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
 }
 void Shader::SetVec3(const String& name, Vector3 value)
 {
-  glUniform3fv(glGetUniformLocation(mShaderID, name.c_str()), 1, &value[0]);
+  glUniform3fv(GetUniformLocation(name), 1, &value[0]);
 }
 void Shader::SetVec2(const String& name, glm::vec2 value)
 {
-  glUniform2fv(glGetUniformLocation(mShaderID, name.c_str()), 1, &value[0]);
+  glUniform2fv(GetUniformLocation(name), 1, &value[0]);
 }
 void Shader::SetUniform1i(const String& name, int value)
 {
-  glUniform1i(glGetUniformLocation(mShaderID, name.c_str()), value);
+  glUniform1i(GetUniformLocation(name), value);
 }
 void Shader::SetVec4(const String& name, glm::vec4 value)
 {
-  glUniform4fv(glGetUniformLocation(mShaderID, name.c_str()), 1, &value[0]);
+  glUniform4fv(GetUniformLocation(name), 1, &value[0]);
+}
+
+void Shader::SetInt(const UniformHandle& handle, int value)
+{
+  glUniform1i(GetUniformLocation(handle), value);
+}
+void Shader::SetBool(const UniformHandle& handle, bool value)
+{
+  glUniform1i(GetUniformLocation(handle), (int)value);
+}
+void Shader::SetFloat(const UniformHandle& handle, float value)
+{
+  glUniform1f(GetUniformLocation(handle), value);
+}
+void Shader::SetMat4(const UniformHandle& handle, const Matrix4& value)
+{
+  glUniformMatrix4fv(GetUniformLocation(handle), 1, GL_FALSE, glm::value_ptr(value));
+}
+void Shader::SetVec3(const UniformHandle& handle, const Vector3& value)
+{
+  glUniform3fv(GetUniformLocation(handle), 1, &value[0]);
+}
+void Shader::SetVec2(const UniformHandle& handle, const glm::vec2& value)
+{
+  glUniform2fv(GetUniformLocation(handle), 1, &value[0]);
+}
+void Shader::SetVec4(const UniformHandle& handle, const glm::vec4& value)
+{
+  glUniform4fv(GetUniformLocation(handle), 1, &value[0]);
 }
 
 void Shader::UseShader()
 {
-  glUseProgram(mShaderID);
+  GLStateCache::UseProgram(mShaderID);
 }
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "Common/Utils/Common.h"
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
+#include "Components/Renderer/Shader/UniformTable.h"
 
 namespace Yeager {
 class Shader {
@@ -38,6 +39,20 @@ class Shader {
   void SetUniform1i(const String& name, int value);
   void SetVec4(const String& name, glm::vec4 value);
 
+  /* Overloads taking a precomputed handle, used in hot paths so no string is built or hashed every frame */
+  void SetInt(const UniformHandle& handle, int value);
+  void SetBool(const UniformHandle& handle, bool value);
+  void SetFloat(const UniformHandle& handle, float value);
+  void SetMat4(const UniformHandle& handle, const Matrix4& value);
+  void SetVec3(const UniformHandle& handle, const Vector3& value);
+  void SetVec2(const UniformHandle& handle, const glm::vec2& value);
+  void SetVec4(const UniformHandle& handle, const glm::vec4& value);
+
+  /** @brief Returns the location of the uniform from the reflected table, asks the driver if the table cannot answer */
+  YEAGER_NODISCARD GLint GetUniformLocation(const UniformHandle& handle) const;
+  YEAGER_NODISCARD GLint GetUniformLocation(const String& name) const;
+  YEAGER_NODISCARD const UniformTable& GetUniformTable() const { return mUniformTable; }
+
   constexpr inline GLuint GetId() { return mShaderID; }
   constexpr inline bool IsInitialized() { return bInitialize; }
 
@@ -55,9 +70,12 @@ class Shader {
 
   String mVarName;
   String mShaderName;
+  UniformTable mUniformTable;
 
   YEAGER_NODISCARD Uint CreateVertexGL(Cchar vertexPath);
   YEAGER_NODISCARD Uint CreateFragmentGL(Cchar fragmentPath);
   void LinkShaders(Uint vertexShader, Uint fragmentShader);
+  /** @brief Enumerates the active uniforms of the linked program and fills the uniform table */
+  void ReflectUniforms();
 };
 }  // namespace Yeager
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "UniformTable.h"
+using namespace Yeager;
+
+std::vector<UniformHandle> Yeager::MakeUniformArrayHandles(const String& name, Uint count)
+{
+  std::vector<UniformHandle> handles;
+  handles.reserve(count);
+  for (Uint x = 0; x < count; x++) {
+    handles.emplace_back(name + "[" + std::to_string(x) + "]");
+  }
+  return handles;
+}
+
+void UniformTable::Reset(Uint expected)
+{
+  Uint capacity = 16;
+  while (capacity < expected * 2)
+    capacity *= 2;
+
+  mEntries.assign(capacity, Entry());
+  mNames.clear();
+  mNames.reserve(expected);
+  mSize = 0;
+}
+
+void UniformTable::Grow()
+{
+  std::vector<Entry> old = std::move(mEntries);
+  mEntries.assign(old.size() * 2, Entry());
+  const Uint mask = mEntries.size() - 1;
+
+  for (const auto& entry : old) {
+    if (!entry.Used)
+      continue;
+    Uint idx = static_cast<Uint>(entry.Hash & mask);
+    while (mEntries[idx].Used)
+      idx = (idx + 1) & mask;
+    mEntries[idx] = entry;
+  }
+}
+
+bool UniformTable::Insert(const String& name, GLint location)
+{
+  if (mEntries.empty())
+    Reset(8);
+
+  if ((mSize + 1) * 2 > mEntries.size())
+    Grow();
+
+  const uint64_t hash = HashUniformName(name);
+  const Uint mask = mEntries.size() - 1;
+  Uint idx = static_cast<Uint>(hash & mask);
+
+  while (mEntries[idx].Used) {
+    if (mEntries[idx].Hash == hash) {
+      if (mNames[mEntries[idx].Name] == name)
+        return true;  // Same uniform registered twice, nothing to do
+      Yeager::LogDebug(WARNING, "Uniform {} collided with another uniform hash, falling back to the driver lookup",
+                       name);
+      mEntries[idx].Location = sCollidedLocation;
+      return false;
+    }
+    idx = (idx + 1) & mask;
+  }
+
+  mEntries[idx].Hash = hash;
+  mEntries[idx].Location = location;
+  mEntries[idx].Name = static_cast<Uint>(mNames.size());
+  mEntries[idx].Used = true;
+  mNames.push_back(name);
+  mSize++;
+  return true;
+}
+
+GLint UniformTable::Find(uint64_t hash, std::string_view name) const
+{
+  if (mEntries.empty())
+    return sInvalidLocation;
+
+  const Uint mask = mEntries.size() - 1;
+  Uint idx = static_cast<Uint>(hash & mask);
+
+  while (mEntries[idx].Used) {
+    if (mEntries[idx].Hash == hash) {
+#ifdef YEAGER_DEBUG
+      if (mNames[mEntries[idx].Name] != name) {
+        Yeager::LogDebug(WARNING, "Uniform {} matched the hash of uniform {}, falling back to the driver lookup", name,
+                         mNames[mEntries[idx].Name]);
+        return sCollidedLocation;
+      }
+#endif
+      return mEntries[idx].Location;
+    }
+    idx = (idx + 1) & mask;
+  }
+  return sInvalidLocation;
+}
+
+void Yeager::ReflectUniformTable(UniformTable* table, GLuint program, const UniformReflectionFunctions& functions)
+{
+  GLint count = 0;
+  GLint maxLength = 0;
+  functions.GetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+  functions.GetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+  table->Reset(count);
+  std::vector<GLchar> buffer(std::max(maxLength, 1));
+
+  for (GLint x = 0; x < count; x++) {
+    GLsizei length = 0;
+    GLint size = 0;
+    GLenum type = 0;
+    functions.GetActiveUniform(program, x, buffer.size(), &length, &size, &type, buffer.data());
+    String name(buffer.data(), length);
+    GLint location = functions.GetUniformLocation(program, name.c_str());
+
+    /* Uniforms inside blocks have no location, they are set with buffers */
+    if (location < 0)
+      continue;
+
+    table->Insert(name, location);
+
+    /* Arrays are reported as "name[0]", the other elements and the name without the subscript are also valid */
+    if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+      String base = name.substr(0, name.size() - 3);
+      table->Insert(base, location);
+      for (GLint e = 1; e < size; e++) {
+        String element = base + "[" + std::to_string(e) + "]";
+        table->Insert(element, functions.GetUniformLocation(program, element.c_str()));
+      }
+    }
+  }
+}
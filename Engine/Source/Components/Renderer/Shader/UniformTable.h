@@ -0,0 +1,117 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+/**
+ * @brief 64 bits FNV-1a hash, used to key the uniforms names of the shader programs. Wide enough that a name missing
+ * from a program does not realistically match the hash of another uniform of it
+ */
+YEAGER_CONSTEXPR uint64_t HashUniformName(std::string_view name)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/**
+ * @brief Precomputed uniform name, the hash is calculated once when the handle is created, so hot paths can
+ * set uniforms without building and hashing strings every frame. The same handle can be used with any shader,
+ * each shader resolves it against its own reflected table
+ */
+struct UniformHandle {
+  UniformHandle() = default;
+  explicit UniformHandle(const String& name) : Hash(HashUniformName(name)), Name(name) {}
+  explicit UniformHandle(Cchar name) : Hash(HashUniformName(name)), Name(name) {}
+
+  uint64_t Hash = 0;
+  String Name = YEAGER_NULL_LITERAL;
+};
+
+/** @brief Builds the handles for every element of a uniform array, "name[0]", "name[1]" ... "name[count - 1]" */
+extern std::vector<UniformHandle> MakeUniformArrayHandles(const String& name, Uint count);
+
+/**
+ * @brief Flat open addressing table (linear probing) that maps the hash of the uniform name to its location in the
+ * program. Built once after linking, the shader looks up here before asking the driver with glGetUniformLocation
+ */
+class UniformTable {
+ public:
+  /* Location returned when the hash is not on the table, matches what glGetUniformLocation returns for unknown names */
+  static YEAGER_CONSTEXPR GLint sInvalidLocation = -1;
+  /* Location stored when two different names collided into the same hash, the shader must ask the driver */
+  static YEAGER_CONSTEXPR GLint sCollidedLocation = -2;
+
+  /** @brief Clears the table and reserves space for the number of uniforms given, keeping the load factor under 0.5 */
+  void Reset(Uint expected);
+  /** @brief Inserts the name and location, returns false if the name collided with another uniform hash */
+  bool Insert(const String& name, GLint location);
+
+  /**
+   * @brief Returns the location of the hash, sInvalidLocation if not found, sCollidedLocation if ambiguous. Debug
+   * builds also compare the name with the one stored on the hit, and return sCollidedLocation when they differ
+   */
+  YEAGER_NODISCARD GLint Find(uint64_t hash, std::string_view name) const;
+
+  YEAGER_NODISCARD Uint GetSize() const { return mSize; }
+  YEAGER_NODISCARD bool IsBuilt() const { return !mEntries.empty(); }
+
+ private:
+  struct Entry {
+    uint64_t Hash = 0;
+    GLint Location = sInvalidLocation;
+    /* Position of the name in mNames */
+    Uint Name = 0;
+    bool Used = false;
+  };
+
+  void Grow();
+
+  std::vector<Entry> mEntries;
+  /* Names are kept to detect hash collisions while the table is built, and to verify the hits in debug builds */
+  std::vector<String> mNames;
+  Uint mSize = 0;
+};
+
+/**
+ * @brief The OpenGL queries the reflection of a program needs. The shaders point them to the driver, the tests to fake
+ * programs, so the enumeration runs without a context
+ */
+struct UniformReflectionFunctions {
+  void (*GetProgramiv)(GLuint program, GLenum name, GLint* value) = YEAGER_NULLPTR;
+  void (*GetActiveUniform)(GLuint program, GLuint index, GLsizei bufferSize, GLsizei* length, GLint* size,
+                           GLenum* type, GLchar* name) = YEAGER_NULLPTR;
+  GLint (*GetUniformLocation)(GLuint program, const GLchar* name) = YEAGER_NULLPTR;
+};
+
+/**
+ * @brief Enumerates the active uniforms of the linked program into the table. Uniforms without a location (inside
+ * blocks) are skipped, arrays are also inserted by their name without the subscript and by each of their elements
+ */
+extern void ReflectUniformTable(UniformTable* table, GLuint program, const UniformReflectionFunctions& functions);
+
+}  // namespace Yeager
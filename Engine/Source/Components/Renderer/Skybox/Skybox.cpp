@@ -27,7 +27,7 @@ bool Skybox::BuildSkyboxFromImport(String path, bool flip)
       return false;
     }
 
-    m_Texture = std::shared_ptr<MaterialTexture2D>(&m_Model.TexturesLoaded[0]->first);
+    m_Texture = m_Model.TexturesLoaded[0];
     m_Geometry = ObjectGeometryType::eCUSTOM;
     m_Type = SkyboxTextureType::ESampler2D;
     m_SkyboxDataLoaded = true;
@@ -119,9 +119,9 @@ void Skybox::SetupModel()
     mesh.Renderer.GenBuffers();
     mesh.Renderer.BindBuffers();
 
-    mesh.Renderer.BufferData(GL_ARRAY_BUFFER, mesh.Vertices.size() * sizeof(ObjectVertexData), &mesh.Vertices[0],
+    mesh.Renderer.BufferData(GL_ARRAY_BUFFER, mesh.GetVertices().size_bytes(), mesh.GetVertices().data(),
                              GL_STATIC_DRAW);
-    mesh.Renderer.BufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.Indices.size() * sizeof(unsigned int), &mesh.Indices[0],
+    mesh.Renderer.BufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.GetIndices().size_bytes(), mesh.GetIndices().data(),
                              GL_STATIC_DRAW);
 
     mesh.Renderer.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ObjectVertexData), (void*)0);
@@ -173,7 +173,7 @@ void Skybox::Draw(Yeager::Shader* shader, Matrix4 view, Matrix4 projection)
   if (!m_SkyboxShouldRender)
     return;
 
-  glDisable(GL_CULL_FACE);
+  GLStateCache::SetCullFace(false);
 
   if (m_SkyboxDataLoaded && bRender) {
     glDepthFunc(GL_LEQUAL);
@@ -183,7 +183,7 @@ void Skybox::Draw(Yeager::Shader* shader, Matrix4 view, Matrix4 projection)
     m_Renderer.BindVertexArray();
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(m_Type == SkyboxTextureType::ESampler2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP,
-                  m_Model.TexturesLoaded[0]->first.GetTextureID());
+                  m_Model.TexturesLoaded[0]->GetTextureID());
     if (m_Geometry != ObjectGeometryType::eCUSTOM) {
       m_Renderer.Draw(GL_TRIANGLES, 0, m_VerticesIndex);
     } else {
@@ -195,5 +195,5 @@ void Skybox::Draw(Yeager::Shader* shader, Matrix4 view, Matrix4 projection)
     glDepthFunc(GL_LESS);
   }
 
-  glEnable(GL_CULL_FACE);
+  GLStateCache::SetCullFace(true);
 }
\ No newline at end of file
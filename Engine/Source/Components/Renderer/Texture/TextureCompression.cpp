@@ -0,0 +1,533 @@
+#include "TextureCompression.h"
+using namespace Yeager;
+
+std::size_t Yeager::GetTextureLevelSize(Uint width, Uint height, TexturePayloadFormat::Enum format)
+{
+  const std::size_t blocks = std::size_t((width + 3) / 4) * std::size_t((height + 3) / 4);
+  switch (format) {
+    case TexturePayloadFormat::eBC1:
+      return blocks * 8;
+    case TexturePayloadFormat::eBC3:
+      return blocks * 16;
+    case TexturePayloadFormat::eRGBA8:
+    default:
+      return std::size_t(width) * height * 4;
+  }
+}
+
+std::vector<unsigned char> Yeager::ExpandToRGBA8(const unsigned char* pixels, Uint width, Uint height, Uint channels)
+{
+  const std::size_t count = std::size_t(width) * height;
+  std::vector<unsigned char> rgba(count * 4, 255);
+  for (std::size_t x = 0; x < count; x++) {
+    const unsigned char* source = pixels + x * channels;
+    unsigned char* destination = rgba.data() + x * 4;
+    if (channels <= 2) {
+      destination[0] = destination[1] = destination[2] = source[0];
+      if (channels == 2)
+        destination[3] = source[1];
+    } else {
+      destination[0] = source[0];
+      destination[1] = source[1];
+      destination[2] = source[2];
+      if (channels == 4)
+        destination[3] = source[3];
+    }
+  }
+  return rgba;
+}
+
+static const std::array<float, 256>& SRGBToLinearTable()
+{
+  static const std::array<float, 256> table = []() {
+    std::array<float, 256> values;
+    for (Uint x = 0; x < 256; x++) {
+      const float c = static_cast<float>(x) / 255.0f;
+      values[x] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+    return values;
+  }();
+  return table;
+}
+
+static unsigned char LinearToSRGB8(float linear)
+{
+  const float c = std::clamp(linear, 0.0f, 1.0f);
+  const float encoded = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+  return static_cast<unsigned char>(std::lround(encoded * 255.0f));
+}
+
+static unsigned char LinearToUnorm8(float value)
+{
+  return static_cast<unsigned char>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+struct BoxFilterTap {
+  Uint Index = 0;
+  float Weight = 0.0f;
+};
+
+/* Source texels covered by each destination texel and by how much, the weights of a destination texel sum to one */
+static std::vector<std::vector<BoxFilterTap>> BuildBoxFilterTaps(Uint source, Uint destination)
+{
+  std::vector<std::vector<BoxFilterTap>> taps(destination);
+  const double scale = static_cast<double>(source) / destination;
+  for (Uint x = 0; x < destination; x++) {
+    const double begin = x * scale;
+    const double end = (x + 1) * scale;
+    for (Uint s = static_cast<Uint>(begin); s < source && s < end; s++) {
+      const double overlap = std::min(end, s + 1.0) - std::max(begin, static_cast<double>(s));
+      if (overlap > 0.0)
+        taps[x].push_back(BoxFilterTap{s, static_cast<float>(overlap / scale)});
+    }
+  }
+  return taps;
+}
+
+/* Both passes run on linear RGBA floats, so the levels are filtered from the level above without requantizing */
+static std::vector<float> DownsampleBox(const std::vector<float>& source, Uint width, Uint height, Uint nextWidth,
+                                        Uint nextHeight)
+{
+  const auto columns = BuildBoxFilterTaps(width, nextWidth);
+  const auto rows = BuildBoxFilterTaps(height, nextHeight);
+
+  std::vector<float> horizontal(std::size_t(nextWidth) * height * 4, 0.0f);
+  for (Uint y = 0; y < height; y++) {
+    for (Uint x = 0; x < nextWidth; x++) {
+      float* destination = horizontal.data() + (std::size_t(y) * nextWidth + x) * 4;
+      for (const auto& tap : columns[x]) {
+        const float* texel = source.data() + (std::size_t(y) * width + tap.Index) * 4;
+        for (Uint c = 0; c < 4; c++) {
+          destination[c] += texel[c] * tap.Weight;
+        }
+      }
+    }
+  }
+
+  std::vector<float> output(std::size_t(nextWidth) * nextHeight * 4, 0.0f);
+  for (Uint y = 0; y < nextHeight; y++) {
+    for (const auto& tap : rows[y]) {
+      for (Uint x = 0; x < nextWidth; x++) {
+        const float* texel = horizontal.data() + (std::size_t(tap.Index) * nextWidth + x) * 4;
+        float* destination = output.data() + (std::size_t(y) * nextWidth + x) * 4;
+        for (Uint c = 0; c < 4; c++) {
+          destination[c] += texel[c] * tap.Weight;
+        }
+      }
+    }
+  }
+  return output;
+}
+
+std::vector<TextureMipLevel> Yeager::GenerateMipChain(const std::vector<unsigned char>& rgba, Uint width, Uint height,
+                                                      bool srgb)
+{
+  std::vector<TextureMipLevel> levels;
+  if (width == 0 || height == 0 || rgba.size() < std::size_t(width) * height * 4)
+    return levels;
+
+  TextureMipLevel base;
+  base.Width = width;
+  base.Height = height;
+  base.Data.assign(rgba.begin(), rgba.begin() + std::size_t(width) * height * 4);
+  levels.push_back(std::move(base));
+
+  const auto& table = SRGBToLinearTable();
+  std::vector<float> current(std::size_t(width) * height * 4);
+  for (std::size_t x = 0; x < current.size(); x++) {
+    const bool color = (x % 4) != 3;
+    current[x] = srgb && color ? table[rgba[x]] : static_cast<float>(rgba[x]) / 255.0f;
+  }
+
+  Uint levelWidth = width;
+  Uint levelHeight = height;
+  while (levelWidth > 1 || levelHeight > 1) {
+    const Uint nextWidth = std::max(levelWidth / 2, 1u);
+    const Uint nextHeight = std::max(levelHeight / 2, 1u);
+    std::vector<float> next = DownsampleBox(current, levelWidth, levelHeight, nextWidth, nextHeight);
+
+    TextureMipLevel level;
+    level.Width = nextWidth;
+    level.Height = nextHeight;
+    level.Data.resize(next.size());
+    for (std::size_t x = 0; x < next.size(); x++) {
+      const bool color = (x % 4) != 3;
+      level.Data[x] = srgb && color ? LinearToSRGB8(next[x]) : LinearToUnorm8(next[x]);
+    }
+    levels.push_back(std::move(level));
+
+    current = std::move(next);
+    levelWidth = nextWidth;
+    levelHeight = nextHeight;
+  }
+  return levels;
+}
+
+bool Yeager::IsImageOpaque(const TextureMipLevel& level)
+{
+  for (std::size_t x = 3; x < level.Data.size(); x += 4) {
+    if (level.Data[x] != 255)
+      return false;
+  }
+  return true;
+}
+
+static uint16_t PackRGB565(const float color[3])
+{
+  const auto channel = [](float value, float max) {
+    return static_cast<uint16_t>(std::lround(std::clamp(value / 255.0f, 0.0f, 1.0f) * max));
+  };
+  return static_cast<uint16_t>((channel(color[0], 31.0f) << 11) | (channel(color[1], 63.0f) << 5) |
+                               channel(color[2], 31.0f));
+}
+
+static void UnpackRGB565(uint16_t packed, int color[3])
+{
+  const int r = (packed >> 11) & 0x1F;
+  const int g = (packed >> 5) & 0x3F;
+  const int b = packed & 0x1F;
+  color[0] = (r << 3) | (r >> 2);
+  color[1] = (g << 2) | (g >> 4);
+  color[2] = (b << 3) | (b >> 2);
+}
+
+/* The fourth entry of the three colors mode is transparent black */
+static void BuildColorPalette(uint16_t color0, uint16_t color1, bool fourColors, int palette[4][4])
+{
+  UnpackRGB565(color0, palette[0]);
+  UnpackRGB565(color1, palette[1]);
+  palette[0][3] = palette[1][3] = palette[2][3] = 255;
+  for (Uint c = 0; c < 3; c++) {
+    if (fourColors) {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    } else {
+      palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+      palette[3][c] = 0;
+    }
+  }
+  palette[3][3] = fourColors ? 255 : 0;
+}
+
+/* Picks the closest palette entry for every texel, returns the squared error of the block */
+static float ChooseColorIndices(const float colors[16][3], uint16_t color0, uint16_t color1, Uint indices[16])
+{
+  int palette[4][4];
+  BuildColorPalette(color0, color1, true, palette);
+
+  float error = 0.0f;
+  for (Uint x = 0; x < 16; x++) {
+    float best = std::numeric_limits<float>::max();
+    for (Uint p = 0; p < 4; p++) {
+      float distance = 0.0f;
+      for (Uint c = 0; c < 3; c++) {
+        const float delta = colors[x][c] - static_cast<float>(palette[p][c]);
+        distance += delta * delta;
+      }
+      if (distance < best) {
+        best = distance;
+        indices[x] = p;
+      }
+    }
+    error += best;
+  }
+  return error;
+}
+
+/* Least squares endpoints for the given indices, false when every texel uses the same weight */
+static bool FitColorEndpoints(const float colors[16][3], const Uint indices[16], float endpoint0[3], float endpoint1[3])
+{
+  static YEAGER_CONSTEXPR float sWeights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+  float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+  float ax[3] = {0.0f}, bx[3] = {0.0f};
+  for (Uint x = 0; x < 16; x++) {
+    const float a = sWeights[indices[x]];
+    const float b = 1.0f - a;
+    aa += a * a;
+    bb += b * b;
+    ab += a * b;
+    for (Uint c = 0; c < 3; c++) {
+      ax[c] += a * colors[x][c];
+      bx[c] += b * colors[x][c];
+    }
+  }
+
+  const float determinant = aa * bb - ab * ab;
+  if (std::abs(determinant) < 1e-6f)
+    return false;
+  for (Uint c = 0; c < 3; c++) {
+    endpoint0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+    endpoint1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+  }
+  return true;
+}
+
+static void WriteColorBlock(uint16_t color0, uint16_t color1, Uint indices[16], unsigned char output[8])
+{
+  /* The four colors mode needs color0 > color1, swapping the endpoints swaps the index pairs 0-1 and 2-3 */
+  if (color0 < color1) {
+    std::swap(color0, color1);
+    for (Uint x = 0; x < 16; x++) {
+      indices[x] ^= 1u;
+    }
+  } else if (color0 == color1) {
+    std::fill(indices, indices + 16, 0u);
+  }
+
+  uint32_t bits = 0;
+  for (Uint x = 0; x < 16; x++) {
+    bits |= static_cast<uint32_t>(indices[x]) << (x * 2);
+  }
+  output[0] = static_cast<unsigned char>(color0);
+  output[1] = static_cast<unsigned char>(color0 >> 8);
+  output[2] = static_cast<unsigned char>(color1);
+  output[3] = static_cast<unsigned char>(color1 >> 8);
+  for (Uint x = 0; x < 4; x++) {
+    output[4 + x] = static_cast<unsigned char>(bits >> (x * 8));
+  }
+}
+
+static void EncodeColorBlock(const unsigned char rgba[64], unsigned char output[8])
+{
+  float colors[16][3];
+  float mean[3] = {0.0f};
+  for (Uint x = 0; x < 16; x++) {
+    for (Uint c = 0; c < 3; c++) {
+      colors[x][c] = rgba[x * 4 + c];
+      mean[c] += colors[x][c] / 16.0f;
+    }
+  }
+
+  float covariance[3][3] = {{0.0f}};
+  for (Uint x = 0; x < 16; x++) {
+    for (Uint i = 0; i < 3; i++) {
+      for (Uint j = 0; j < 3; j++) {
+        covariance[i][j] += (colors[x][i] - mean[i]) * (colors[x][j] - mean[j]);
+      }
+    }
+  }
+
+  /* Principal axis by power iteration, starting from the channel with the largest variance */
+  float axis[3] = {0.0f};
+  Uint widest = 0;
+  for (Uint c = 1; c < 3; c++) {
+    if (covariance[c][c] > covariance[widest][widest])
+      widest = c;
+  }
+  axis[widest] = 1.0f;
+  for (Uint iteration = 0; iteration < 8; iteration++) {
+    float next[3] = {0.0f};
+    for (Uint i = 0; i < 3; i++) {
+      for (Uint j = 0; j < 3; j++) {
+        next[i] += covariance[i][j] * axis[j];
+      }
+    }
+    const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+    if (length < 1e-6f)
+      break;
+    for (Uint c = 0; c < 3; c++) {
+      axis[c] = next[c] / length;
+    }
+  }
+
+  float minProjection = std::numeric_limits<float>::max();
+  float maxProjection = std::numeric_limits<float>::lowest();
+  for (Uint x = 0; x < 16; x++) {
+    float projection = 0.0f;
+    for (Uint c = 0; c < 3; c++) {
+      projection += (colors[x][c] - mean[c]) * axis[c];
+    }
+    minProjection = std::min(minProjection, projection);
+    maxProjection = std::max(maxProjection, projection);
+  }
+
+  float endpoint0[3], endpoint1[3];
+  for (Uint c = 0; c < 3; c++) {
+    endpoint0[c] = mean[c] + axis[c] * maxProjection;
+    endpoint1[c] = mean[c] + axis[c] * minProjection;
+  }
+
+  uint16_t color0 = PackRGB565(endpoint0);
+  uint16_t color1 = PackRGB565(endpoint1);
+  Uint indices[16];
+  float error = ChooseColorIndices(colors, color0, color1, indices);
+
+  if (error > 0.0f && FitColorEndpoints(colors, indices, endpoint0, endpoint1)) {
+    const uint16_t fitted0 = PackRGB565(endpoint0);
+    const uint16_t fitted1 = PackRGB565(endpoint1);
+    Uint fittedIndices[16];
+    const float fittedError = ChooseColorIndices(colors, fitted0, fitted1, fittedIndices);
+    if (fittedError < error) {
+      color0 = fitted0;
+      color1 = fitted1;
+      std::copy(fittedIndices, fittedIndices + 16, indices);
+    }
+  }
+
+  WriteColorBlock(color0, color1, indices, output);
+}
+
+static void DecodeColorBlock(const unsigned char block[8], bool allowThreeColors, unsigned char rgba[64])
+{
+  const uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+  const uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+  const uint32_t bits = static_cast<uint32_t>(block[4]) | (static_cast<uint32_t>(block[5]) << 8) |
+                        (static_cast<uint32_t>(block[6]) << 16) | (static_cast<uint32_t>(block[7]) << 24);
+
+  int palette[4][4];
+  BuildColorPalette(color0, color1, !allowThreeColors || color0 > color1, palette);
+  for (Uint x = 0; x < 16; x++) {
+    const Uint index = (bits >> (x * 2)) & 0x3u;
+    for (Uint c = 0; c < 4; c++) {
+      rgba[x * 4 + c] = static_cast<unsigned char>(palette[index][c]);
+    }
+  }
+}
+
+/* Eight values mode when alpha0 > alpha1, otherwise six values plus 0 and 255 */
+static void BuildAlphaPalette(int alpha0, int alpha1, int palette[8])
+{
+  palette[0] = alpha0;
+  palette[1] = alpha1;
+  if (alpha0 > alpha1) {
+    for (int x = 1; x < 7; x++) {
+      palette[x + 1] = ((7 - x) * alpha0 + x * alpha1 + 3) / 7;
+    }
+  } else {
+    for (int x = 1; x < 5; x++) {
+      palette[x + 1] = ((5 - x) * alpha0 + x * alpha1 + 2) / 5;
+    }
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+}
+
+static void EncodeAlphaBlock(const unsigned char rgba[64], unsigned char output[8])
+{
+  int alphaMin = 255;
+  int alphaMax = 0;
+  for (Uint x = 0; x < 16; x++) {
+    alphaMin = std::min<int>(alphaMin, rgba[x * 4 + 3]);
+    alphaMax = std::max<int>(alphaMax, rgba[x * 4 + 3]);
+  }
+
+  int palette[8];
+  BuildAlphaPalette(alphaMax, alphaMin, palette);
+
+  uint64_t bits = 0;
+  if (alphaMax != alphaMin) {
+    for (Uint x = 0; x < 16; x++) {
+      const int alpha = rgba[x * 4 + 3];
+      Uint best = 0;
+      for (Uint p = 1; p < 8; p++) {
+        if (std::abs(palette[p] - alpha) < std::abs(palette[best] - alpha))
+          best = p;
+      }
+      bits |= static_cast<uint64_t>(best) << (x * 3);
+    }
+  }
+
+  output[0] = static_cast<unsigned char>(alphaMax);
+  output[1] = static_cast<unsigned char>(alphaMin);
+  for (Uint x = 0; x < 6; x++) {
+    output[2 + x] = static_cast<unsigned char>(bits >> (x * 8));
+  }
+}
+
+void Yeager::EncodeBC1Block(const unsigned char rgba[64], unsigned char output[8])
+{
+  EncodeColorBlock(rgba, output);
+}
+
+void Yeager::EncodeBC3Block(const unsigned char rgba[64], unsigned char output[16])
+{
+  EncodeAlphaBlock(rgba, output);
+  EncodeColorBlock(rgba, output + 8);
+}
+
+void Yeager::DecodeBC1Block(const unsigned char block[8], unsigned char rgba[64])
+{
+  DecodeColorBlock(block, true, rgba);
+}
+
+void Yeager::DecodeBC3Block(const unsigned char block[16], unsigned char rgba[64])
+{
+  /* The color block of BC3 is always in the four colors mode */
+  DecodeColorBlock(block + 8, false, rgba);
+
+  int palette[8];
+  BuildAlphaPalette(block[0], block[1], palette);
+  uint64_t bits = 0;
+  for (Uint x = 0; x < 6; x++) {
+    bits |= static_cast<uint64_t>(block[2 + x]) << (x * 8);
+  }
+  for (Uint x = 0; x < 16; x++) {
+    rgba[x * 4 + 3] = static_cast<unsigned char>(palette[(bits >> (x * 3)) & 0x7u]);
+  }
+}
+
+TextureMipLevel Yeager::CompressTextureLevel(const TextureMipLevel& level, TexturePayloadFormat::Enum format)
+{
+  if (format == TexturePayloadFormat::eRGBA8)
+    return level;
+
+  TextureMipLevel compressed;
+  compressed.Width = level.Width;
+  compressed.Height = level.Height;
+  compressed.Data.resize(GetTextureLevelSize(level.Width, level.Height, format));
+
+  const std::size_t blockSize = format == TexturePayloadFormat::eBC1 ? 8 : 16;
+  const Uint blocksWide = (level.Width + 3) / 4;
+  const Uint blocksHigh = (level.Height + 3) / 4;
+  unsigned char texels[64];
+  for (Uint by = 0; by < blocksHigh; by++) {
+    for (Uint bx = 0; bx < blocksWide; bx++) {
+      for (Uint y = 0; y < 4; y++) {
+        for (Uint x = 0; x < 4; x++) {
+          const Uint sx = std::min(bx * 4 + x, level.Width - 1);
+          const Uint sy = std::min(by * 4 + y, level.Height - 1);
+          std::memcpy(texels + (y * 4 + x) * 4, level.Data.data() + (std::size_t(sy) * level.Width + sx) * 4, 4);
+        }
+      }
+      unsigned char* block = compressed.Data.data() + (std::size_t(by) * blocksWide + bx) * blockSize;
+      if (format == TexturePayloadFormat::eBC1)
+        EncodeBC1Block(texels, block);
+      else
+        EncodeBC3Block(texels, block);
+    }
+  }
+  return compressed;
+}
+
+TextureMipLevel Yeager::DecompressTextureLevel(const TextureMipLevel& level, TexturePayloadFormat::Enum format)
+{
+  if (format == TexturePayloadFormat::eRGBA8)
+    return level;
+
+  TextureMipLevel decompressed;
+  decompressed.Width = level.Width;
+  decompressed.Height = level.Height;
+  decompressed.Data.resize(std::size_t(level.Width) * level.Height * 4);
+
+  const std::size_t blockSize = format == TexturePayloadFormat::eBC1 ? 8 : 16;
+  const Uint blocksWide = (level.Width + 3) / 4;
+  const Uint blocksHigh = (level.Height + 3) / 4;
+  unsigned char texels[64];
+  for (Uint by = 0; by < blocksHigh; by++) {
+    for (Uint bx = 0; bx < blocksWide; bx++) {
+      const unsigned char* block = level.Data.data() + (std::size_t(by) * blocksWide + bx) * blockSize;
+      if (format == TexturePayloadFormat::eBC1)
+        DecodeBC1Block(block, texels);
+      else
+        DecodeBC3Block(block, texels);
+
+      for (Uint y = 0; y < 4 && by * 4 + y < level.Height; y++) {
+        for (Uint x = 0; x < 4 && bx * 4 + x < level.Width; x++) {
+          std::memcpy(decompressed.Data.data() + (std::size_t(by * 4 + y) * level.Width + bx * 4 + x) * 4,
+                      texels + (y * 4 + x) * 4, 4);
+        }
+      }
+    }
+  }
+  return decompressed;
+}
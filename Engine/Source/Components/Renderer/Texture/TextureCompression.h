@@ -0,0 +1,80 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <array>
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+/**
+ * CPU side of the texture cache: mip chains and block compression. Nothing here touches OpenGL, the levels are produced
+ * on any thread and only uploaded later by the material texture
+ */
+
+/* Texel layout of a cached level, BC1 (opaque) and BC3 (with alpha) are the S3TC / DXT1 and DXT5 blocks */
+struct TexturePayloadFormat {
+  enum Enum { eRGBA8, eBC1, eBC3 };
+};
+
+struct TextureMipLevel {
+  Uint Width = 0;
+  Uint Height = 0;
+  std::vector<unsigned char> Data;
+};
+
+/** @brief Size in bytes of a level, block formats round the size up to whole 4x4 blocks */
+YEAGER_NODISCARD extern std::size_t GetTextureLevelSize(Uint width, Uint height, TexturePayloadFormat::Enum format);
+
+/** @brief Converts 1, 2, 3 or 4 channels images to RGBA8, grey is replicated to RGB and missing alpha is opaque */
+YEAGER_NODISCARD extern std::vector<unsigned char> ExpandToRGBA8(const unsigned char* pixels, Uint width, Uint height,
+                                                                 Uint channels);
+
+/**
+ * @brief Builds every level from the RGBA8 image down to 1x1 with a box filter. When srgb is set the color is averaged
+ * in linear space and encoded back, so the smaller levels do not get darker. Alpha is always linear. Odd sizes are
+ * filtered by texel coverage, every source texel contributes to the level below
+ */
+YEAGER_NODISCARD extern std::vector<TextureMipLevel> GenerateMipChain(const std::vector<unsigned char>& rgba, Uint width,
+                                                                      Uint height, bool srgb);
+
+YEAGER_NODISCARD extern bool IsImageOpaque(const TextureMipLevel& level);
+
+/**
+ * @brief Encodes a 4x4 RGBA8 block. The endpoints are taken from the principal axis of the block colors and refined once
+ * with a least squares fit. BC1 always uses the four colors mode, BC3 adds a eight values alpha block
+ */
+extern void EncodeBC1Block(const unsigned char rgba[64], unsigned char output[8]);
+extern void EncodeBC3Block(const unsigned char rgba[64], unsigned char output[16]);
+/** @brief Decodes the way the S3TC specification does, used by the tests and when the GPU has no S3TC support */
+extern void DecodeBC1Block(const unsigned char block[8], unsigned char rgba[64]);
+extern void DecodeBC3Block(const unsigned char block[16], unsigned char rgba[64]);
+
+/** @brief Converts a RGBA8 level to the payload format, the blocks past the border repeat the edge texels */
+YEAGER_NODISCARD extern TextureMipLevel CompressTextureLevel(const TextureMipLevel& level,
+                                                             TexturePayloadFormat::Enum format);
+/** @brief Converts a level in the payload format back to RGBA8 */
+YEAGER_NODISCARD extern TextureMipLevel DecompressTextureLevel(const TextureMipLevel& level,
+                                                               TexturePayloadFormat::Enum format);
+
+}  // namespace Yeager
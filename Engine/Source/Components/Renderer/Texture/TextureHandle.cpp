@@ -5,6 +5,13 @@
 
 using namespace Yeager;
 
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 MaterialBase::MaterialBase(const EntityBuilder& builder, const MaterialType::Enum type,
                            const MaterialSurfaceType::Enum surface)
     : EditorEntity(EntityBuilder(builder.Application, builder.Name, EntityObjectType::TEXTURE, builder.UUID)),
@@ -65,16 +72,49 @@ std::optional<Uint> Yeager::FormatToChannels(GLenum format)
   }
 }
 
-bool MaterialTexture2D::CreateCache(const String& path)
+bool MaterialTexture2D::CreateCache(const String& folder)
+{
+  if (!m_TextureHandle.Generated || m_MaterialType != MaterialType::eTEXTURE2D) {
+    Yeager::LogDebug(ERROR, "Cannot create cache from ungenerated texture! {}", mName);
+    return false;
+  }
+
+  stbi_set_flip_vertically_on_load(m_TextureHandle.Flipped);
+  int width = 0, height = 0, channels = 0;
+  unsigned char* data = stbi_load(m_TextureHandle.Path.c_str(), &width, &height, &channels, 0);
+  if (!data) {
+    Yeager::LogDebug(ERROR, "Cannot read data from texture file {} to create its cache", m_TextureHandle.Path);
+    return false;
+  }
+
+  const TextureCacheSettings settings = GetCacheSettings(m_TextureHandle.Flipped);
+  const std::optional<TextureCacheData> cache =
+      TextureCache::Build(m_TextureHandle.Path, data, width, height, channels, settings);
+  stbi_image_free(data);
+  return cache.has_value() &&
+         TextureCache::Write(TextureCache::BuildCachePath(folder, m_TextureHandle.Path, settings), cache.value());
+}
+
+TextureCacheSettings MaterialTexture2D::GetCacheSettings(bool flip) const
 {
-  TextureCache cache(mApplication);
-  return cache.Create(path, *this);
+  /* Normal maps are directions, filtering them as colors or through BC1 bends them too much */
+  TextureCacheSettings settings;
+  settings.bSRGB = m_TextureType == MaterialTextureType::eDIFFUSE || m_TextureType == MaterialTextureType::eSPECULAR ||
+                   m_TextureType == MaterialTextureType::eUNDEFINED;
+  settings.bCompress = m_TextureType != MaterialTextureType::eNORMAL_MAP;
+  settings.bFlipped = flip;
+  return settings;
 }
 
-bool MaterialTexture2D::LoadCache(const String& path)
+bool MaterialTexture2D::LoadCache(const String& folder, const String& path, bool flip,
+                                  const MateriaTextureParameterGL parameteri)
 {
-  TextureCache cache(mApplication);
-  return cache.Load(path, this);
+  TextureCacheData data;
+  const TextureCacheSettings settings = GetCacheSettings(flip);
+  if (!TextureCache::Load(TextureCache::BuildCachePath(folder, path, settings), path, settings, &data))
+    return false;
+  GenerateFromCacheData(&data, parameteri);
+  return true;
 }
 
 void Yeager::DisplayImageImGui(MaterialTexture2D* texture, Uint resize)
@@ -99,32 +139,166 @@ void MaterialTexture2D::BindTexture()
   GL_CALL(glBindTexture(m_TextureHandle.BindTarget, m_TextureHandle.Texture));
 }
 
-void MaterialTexture2D::GenerateFromCacheData(TextureCacheData* data, const MateriaTextureParameterGL parameteri)
+/* The S3TC formats are an extension on desktop OpenGL, every desktop driver has it but it is still checked once */
+static bool IsS3TCSupported()
 {
-  if (m_TextureHandle.Generated)
-    Yeager::LogDebug(WARNING, "Material texture already generated! Overrided by a texture 2d!");
+  static const bool supported = []() {
+    GLint count = 0;
+    GL_CALL(glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count));
+    std::vector<GLint> formats(std::max(count, 0));
+    if (count > 0)
+      GL_CALL(glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data()));
+    const auto has = [&formats](GLint format) {
+      return std::find(formats.begin(), formats.end(), format) != formats.end();
+    };
+    return has(GL_COMPRESSED_RGB_S3TC_DXT1_EXT) && has(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+  }();
+  return supported;
+}
 
-  stbi_set_flip_vertically_on_load(true);  // TODO: implment flip on header
+/* Compressed levels are sent as they are, or decoded on the CPU when the driver has no S3TC support */
+static void UploadCacheLevel(GLenum bindTarget, GLenum format, const TextureCacheData& data, Uint index)
+{
+  const TextureMipLevel& level = data.Levels[index];
+  const auto payload = static_cast<TexturePayloadFormat::Enum>(data.Header.Payload);
+  if (payload != TexturePayloadFormat::eRGBA8 && IsS3TCSupported()) {
+    const GLenum compressedFormat =
+        payload == TexturePayloadFormat::eBC1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    GL_CALL(glCompressedTexImage2D(bindTarget, index, compressedFormat, level.Width, level.Height, 0,
+                                   static_cast<GLsizei>(level.Data.size()), level.Data.data()));
+  } else if (payload != TexturePayloadFormat::eRGBA8) {
+    const TextureMipLevel texels = DecompressTextureLevel(level, payload);
+    GL_CALL(glTexImage2D(bindTarget, index, format, texels.Width, texels.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         texels.Data.data()));
+  } else {
+    GL_CALL(glTexImage2D(bindTarget, index, format, level.Width, level.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         level.Data.data()));
+  }
+}
 
+void MaterialTexture2D::AssignCacheData(const TextureCacheData& data, const MateriaTextureParameterGL& parameteri)
+{
   m_MaterialType = MaterialType::eTEXTURE2D;
   m_TextureHandle.Parameter = parameteri;
 
   GenerateTextureParameter(parameteri);
-  m_TextureHandle.Height = data->mHeader->Height;
-  m_TextureHandle.Width = data->mHeader->Width;
-  m_TextureHandle.Path = data->mPath;
+  m_TextureHandle.Height = data.Header.Height;
+  m_TextureHandle.Width = data.Header.Width;
+  m_TextureHandle.Path = data.Path;
   m_TextureHandle.Generated = true;
-  m_TextureHandle.Format = data->mHeader->Format;
+  m_TextureHandle.Format = data.Header.Format;
   m_TextureHandle.BindTarget = parameteri.BindTarget;
-  m_TextureHandle.Flipped = true;
+  m_TextureHandle.Flipped = (data.Header.Flags & TextureCacheFlags::eFLIPPED) != 0;
 
-  GL_CALL(glTexImage2D(parameteri.BindTarget, 0, m_TextureHandle.Format, data->mHeader->Width, data->mHeader->Height, 0,
-                       m_TextureHandle.Format, GL_UNSIGNED_BYTE, data->mData));
-  GL_CALL(glGenerateMipmap(parameteri.BindTarget));
+  /* The whole chain comes from the cache, nothing is left for glGenerateMipmap */
+  GL_CALL(glTexParameteri(parameteri.BindTarget, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(data.Levels.size()) - 1));
+}
+
+void MaterialTexture2D::GenerateFromCacheData(TextureCacheData* data, const MateriaTextureParameterGL parameteri)
+{
+  if (m_TextureHandle.Generated)
+    Yeager::LogDebug(WARNING, "Material texture already generated! Overrided by a texture 2d!");
+
+  AssignCacheData(*data, parameteri);
+  for (Uint x = 0; x < data->Levels.size(); x++) {
+    UploadCacheLevel(parameteri.BindTarget, m_TextureHandle.Format, *data, x);
+  }
 
   GL_CALL(glBindTexture(parameteri.BindTarget, 0));
 
-  Yeager::LogDebug(INFO, "Created Material texture2D {} UUID {}", mName, uuids::to_string(mEntityUUID));
+  Yeager::LogDebug(INFO, "Created Material texture2D {} UUID {} from cache", mName, uuids::to_string(mEntityUUID));
+}
+
+void MaterialTexture2D::AttachStreamPlaceholder(GLuint placeholder, const String& path, bool flip)
+{
+  m_TextureHandle.Texture = placeholder;
+  m_TextureHandle.Path = path;
+  m_TextureHandle.Flipped = flip;
+  m_TextureHandle.ImcompletedID = true;
+}
+
+void MaterialTexture2D::BeginStreamedLevels(const TextureCacheData& data, const MateriaTextureParameterGL parameteri)
+{
+  /* The placeholder is shared, it must not be deleted by GenerateTextureParameter */
+  if (m_TextureHandle.ImcompletedID)
+    m_TextureHandle.Generated = false;
+
+  AssignCacheData(data, parameteri);
+  GL_CALL(glTexParameteri(parameteri.BindTarget, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(data.Levels.size()) - 1));
+  GL_CALL(glBindTexture(parameteri.BindTarget, 0));
+}
+
+void MaterialTexture2D::UploadStreamedLevel(const TextureCacheData& data, Uint level)
+{
+  const GLenum target = m_TextureHandle.BindTarget;
+  GL_CALL(glBindTexture(target, m_TextureHandle.Texture));
+  UploadCacheLevel(target, m_TextureHandle.Format, data, level);
+  /* Sampling is limited to the levels already uploaded, the texture stays complete while the rest arrives */
+  GL_CALL(glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(level)));
+  GL_CALL(glBindTexture(target, 0));
+
+  if (level == 0) {
+    m_TextureHandle.ImcompletedID = false;
+    Yeager::LogDebug(INFO, "Streamed Material texture2D {} UUID {}", mName, uuids::to_string(mEntityUUID));
+  }
+}
+
+static GLuint CreatePlaceholderTexture(const unsigned char (&color)[4])
+{
+  GLuint texture = 0;
+  GL_CALL(glGenTextures(1, &texture));
+  GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
+  GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
+  GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+  GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+  GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+  GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, color));
+  GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+  return texture;
+}
+
+MaterialTextureUploaderGL::MaterialTextureUploaderGL()
+{
+  /* Mid grey for colors, and a flat normal for the textures that hold data */
+  mColorPlaceholder = CreatePlaceholderTexture({128, 128, 128, 255});
+  mDataPlaceholder = CreatePlaceholderTexture({128, 128, 255, 255});
+}
+
+MaterialTextureUploaderGL::~MaterialTextureUploaderGL()
+{
+  GL_CALL(glDeleteTextures(1, &mColorPlaceholder));
+  GL_CALL(glDeleteTextures(1, &mDataPlaceholder));
+}
+
+void MaterialTextureUploaderGL::AttachPlaceholder(MaterialTexture2D* target, const TextureStreamRequest& request)
+{
+  target->AttachStreamPlaceholder(request.Settings.bSRGB ? mColorPlaceholder : mDataPlaceholder, request.Path,
+                                  request.Settings.bFlipped);
+}
+
+void MaterialTextureUploaderGL::Begin(MaterialTexture2D* target, const TextureCacheData& data)
+{
+  target->BeginStreamedLevels(data);
+}
+
+void MaterialTextureUploaderGL::UploadLevel(MaterialTexture2D* target, const TextureCacheData& data, Uint level)
+{
+  target->UploadStreamedLevel(data, level);
+}
+
+bool MaterialTextureUploaderGL::SupportsCompressedLevels() const
+{
+  return IsS3TCSupported();
+}
+
+MaterialTexture2D* MaterialTextureFactoryGL::Create()
+{
+  return new MaterialTexture2D();
+}
+
+void MaterialTextureFactoryGL::Delete(MaterialTexture2D* texture)
+{
+  delete texture;
 }
 
 void MaterialTexture2D::GenerateFromData(STBIDataOutput* output, const MateriaTextureParameterGL parameteri)
@@ -23,12 +23,13 @@
 
 #include "Components/Kernel/Caching/TextureCache.h"
 #include "Components/Renderer/Objects/Entity.h"
+#include "Components/Renderer/Texture/TextureRegistry.h"
+#include "Components/Renderer/Texture/TextureStreaming.h"
 #include "Components/Renderer/Shader/ShaderHandle.h"
 
 namespace Yeager {
 
 class ApplicationCore;
-struct TextureCacheHeader;
 
 /* Materials are the process in which, objects gain some color, that can be a defined color by the user, a physical material, or a texture (even multiple textures combined) */
 struct MaterialType {
@@ -189,12 +190,6 @@ struct STBIDataOutput {
   String OriginalPath = YEAGER_NULL_LITERAL;
 };
 
-struct TextureCacheData {
-  TextureCacheHeader* mHeader;
-  unsigned char* mData = YEAGER_NULLPTR;
-  String mPath = YEAGER_NULL_LITERAL;
-};
-
 struct TextureHandleBase {
   GLuint Texture = -1;
   GLenum Format = GL_RGBA;
@@ -247,8 +242,12 @@ class MaterialTexture2D : public MaterialBase {
 
   MaterialTextureDataHandle* GetTextureDataHandle() { return &m_TextureHandle; }
 
-  bool CreateCache(const String& path);
-  bool LoadCache(const String& path);
+  /** @brief Decodes the source image again and writes its cache in the folder, the GPU texture is not read back */
+  bool CreateCache(const String& folder);
+  /** @brief Generates the texture from the cache of the source image in the folder, false when it is missing or outdated */
+  bool LoadCache(const String& folder, const String& path, bool flip = false,
+                 const MateriaTextureParameterGL parameteri = MateriaTextureParameterGL(
+                     GL_TEXTURE_2D, GL_REPEAT, GL_REPEAT, GL_REPEAT, 0, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR));
 
   YEAGER_CONSTEXPR int GetWidth() const { return m_TextureHandle.Width; }
   YEAGER_CONSTEXPR int GetHeight() const { return m_TextureHandle.Height; }
@@ -278,11 +277,20 @@ class MaterialTexture2D : public MaterialBase {
                                     MateriaTextureParameterGL(GL_TEXTURE_2D, GL_REPEAT, GL_REPEAT, GL_REPEAT, 0,
                                                               GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR));
 
+  /* Uploads every cached level, the block compressed ones are decoded on the CPU when the driver has no S3TC support */
   void GenerateFromCacheData(TextureCacheData* data,
                              const MateriaTextureParameterGL parameteri =
                                  MateriaTextureParameterGL(GL_TEXTURE_2D, GL_REPEAT, GL_REPEAT, GL_REPEAT, 0,
                                                            GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR));
 
+  /** @brief Points the texture to a shared placeholder until its streamed levels arrive, makes no OpenGL call */
+  void AttachStreamPlaceholder(GLuint placeholder, const String& path, bool flip);
+  /** @brief Creates the texture object of a streamed texture, the levels are then uploaded from the tail upwards */
+  void BeginStreamedLevels(const TextureCacheData& data,
+                           const MateriaTextureParameterGL parameteri = MateriaTextureParameterGL(
+                               GL_TEXTURE_2D, GL_REPEAT, GL_REPEAT, GL_REPEAT, 0, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR));
+  void UploadStreamedLevel(const TextureCacheData& data, Uint level);
+
   void GenerateFromData(STBIDataOutput* output,
                         const MateriaTextureParameterGL parameteri = MateriaTextureParameterGL(
                             GL_TEXTURE_2D, GL_REPEAT, GL_REPEAT, GL_REPEAT, 0, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR));
@@ -299,10 +307,37 @@ class MaterialTexture2D : public MaterialBase {
 
  protected:
   virtual void GenerateTextureParameter(const MateriaTextureParameterGL& parameter);
+  /* Creates the texture object with the size, format and level count of the cache, no level is uploaded */
+  void AssignCacheData(const TextureCacheData& data, const MateriaTextureParameterGL& parameteri);
+  /* Settings of the cache of this texture type, the same ones for its writing and its loading */
+  TextureCacheSettings GetCacheSettings(bool flip) const;
   MaterialTextureType::Enum m_TextureType = MaterialTextureType::eUNDEFINED;
   MaterialTextureDataHandle m_TextureHandle;
 };
 
+/* Uploader of the texture streamer, the placeholders are created with it and deleted with it */
+class MaterialTextureUploaderGL : public TextureUploader {
+ public:
+  MaterialTextureUploaderGL();
+  ~MaterialTextureUploaderGL();
+
+  void AttachPlaceholder(MaterialTexture2D* target, const TextureStreamRequest& request) override;
+  void Begin(MaterialTexture2D* target, const TextureCacheData& data) override;
+  void UploadLevel(MaterialTexture2D* target, const TextureCacheData& data, Uint level) override;
+  YEAGER_NODISCARD bool SupportsCompressedLevels() const override;
+
+ private:
+  GLuint mColorPlaceholder = 0;
+  GLuint mDataPlaceholder = 0;
+};
+
+/* Factory of the texture registry, the OpenGL texture is deleted with the material texture */
+class MaterialTextureFactoryGL : public TextureFactory {
+ public:
+  YEAGER_NODISCARD MaterialTexture2D* Create() override;
+  void Delete(MaterialTexture2D* texture) override;
+};
+
 extern void DisplayImageImGui(MaterialTexture2D* texture, Uint resize = 1);
 
 }  // namespace Yeager
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "TextureRegistry.h"
+#include "Components/Kernel/Caching/CacheFile.h"
+using namespace Yeager;
+
+/* The same image reached through relative paths, dot segments or the other separator gets the same key */
+static String CanonicalTexturePath(const String& path)
+{
+  std::error_code error;
+  const std::filesystem::path canonical = std::filesystem::weakly_canonical(std::filesystem::path(path), error);
+  if (error)
+    return path;
+  return canonical.generic_string();
+}
+
+static uint64_t KeyOfCanonicalPath(const String& canonical, const TextureCacheSettings& settings)
+{
+  const unsigned char flags = (settings.bSRGB ? 1 : 0) | (settings.bCompress ? 2 : 0) | (settings.bFlipped ? 4 : 0);
+  const uint64_t hash = HashCacheBytes(reinterpret_cast<const unsigned char*>(canonical.data()), canonical.size());
+  return HashCacheBytes(&flags, sizeof(flags), hash);
+}
+
+uint64_t TextureRegistry::ComputeKey(const String& path, const TextureCacheSettings& settings)
+{
+  return KeyOfCanonicalPath(CanonicalTexturePath(path), settings);
+}
+
+TextureRegistry::TextureRegistry(std::unique_ptr<TextureFactory> factory) : mFactory(std::move(factory)) {}
+
+TextureRegistry::~TextureRegistry()
+{
+  CollectReleased();
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (const auto& [key, entry] : mEntries) {
+    if (!entry.Texture.expired())
+      Yeager::Log(ERROR, "Texture registry destroyed while the texture {} is still in use!", entry.CanonicalPath);
+  }
+}
+
+std::shared_ptr<MaterialTexture2D> TextureRegistry::Acquire(const String& path, const TextureCacheSettings& settings,
+                                                            const Initializer& initialize)
+{
+  const String canonical = CanonicalTexturePath(path);
+  const uint64_t key = KeyOfCanonicalPath(canonical, settings);
+
+  /* Declared before the lock, if this ends up as the last reference, its release must find the registry unlocked */
+  std::shared_ptr<MaterialTexture2D> registered;
+  std::lock_guard<std::mutex> lock(mMutex);
+  Entry& entry = mEntries[key];
+  registered = entry.Texture.lock();
+  if (registered) {
+    if (entry.CanonicalPath == canonical)
+      return registered;
+    /* Two paths with the same hash, the second image still loads but it is not shared */
+    Yeager::Log(WARNING, "Texture registry key collision between {} and {}!", entry.CanonicalPath, canonical);
+    std::shared_ptr<MaterialTexture2D> unshared(mFactory->Create(),
+                                                [this, key](MaterialTexture2D* texture) { Release(key, texture); });
+    initialize(unshared);
+    return unshared;
+  }
+
+  std::shared_ptr<MaterialTexture2D> texture(mFactory->Create(),
+                                             [this, key](MaterialTexture2D* texture) { Release(key, texture); });
+  entry.Texture = texture;
+  entry.CanonicalPath = canonical;
+  initialize(texture);
+  return texture;
+}
+
+void TextureRegistry::Release(uint64_t key, MaterialTexture2D* texture)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  /* The key may already belong to a newer texture of the same image, that one is kept */
+  const auto it = mEntries.find(key);
+  if (it != mEntries.end() && it->second.Texture.expired())
+    mEntries.erase(it);
+  mReleased.push_back(texture);
+}
+
+void TextureRegistry::CollectReleased()
+{
+  std::vector<MaterialTexture2D*> released;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    released.swap(mReleased);
+  }
+  /* Outside the lock, the destructors delete the OpenGL textures */
+  for (MaterialTexture2D* texture : released) {
+    mFactory->Delete(texture);
+  }
+}
+
+Uint TextureRegistry::GetTextureCount() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return static_cast<Uint>(mEntries.size());
+}
+
+Uint TextureRegistry::GetReleasedCount() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return static_cast<Uint>(mReleased.size());
+}
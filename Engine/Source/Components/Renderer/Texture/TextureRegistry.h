@@ -0,0 +1,88 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "Components/Kernel/Caching/TextureCache.h"
+
+#include <mutex>
+
+namespace Yeager {
+
+class MaterialTexture2D;
+
+/* Creates and deletes the textures of the registry, the material textures implement it with OpenGL */
+class TextureFactory {
+ public:
+  virtual ~TextureFactory() = default;
+
+  /** @brief Any thread, with the registry locked. Must not call OpenGL, the texture is generated by its initializer */
+  YEAGER_NODISCARD virtual MaterialTexture2D* Create() = 0;
+  /** @brief Main thread, from CollectReleased */
+  virtual void Delete(MaterialTexture2D* texture) = 0;
+};
+
+/**
+ * @brief Engine wide table of the textures loaded from image files, keyed by the hash of the canonical source path and
+ * of the settings the texture is built with. Every model using the same image shares a single MaterialTexture2D, which
+ * lives while one of them holds its shared pointer. The last release can happen on any thread, so it only queues the
+ * texture, and the main thread deletes it together with its OpenGL texture in CollectReleased
+ * @attention The registry must outlive every texture it hands out, the deleters of the textures point to it!
+ */
+class TextureRegistry {
+ public:
+  using Initializer = std::function<void(const std::shared_ptr<MaterialTexture2D>&)>;
+
+  TextureRegistry(std::unique_ptr<TextureFactory> factory);
+  ~TextureRegistry();
+  TextureRegistry(const TextureRegistry&) = delete;
+  TextureRegistry& operator=(const TextureRegistry&) = delete;
+
+  /**
+   * @brief Any thread. Returns the texture registered for the image, or creates it and calls initialize with it before
+   * any other thread can acquire it. The initializer runs with the registry locked, it must not acquire textures itself
+   */
+  std::shared_ptr<MaterialTexture2D> Acquire(const String& path, const TextureCacheSettings& settings,
+                                             const Initializer& initialize);
+  /** @brief Main thread, once per frame. Deletes the textures released since the last call */
+  void CollectReleased();
+
+  YEAGER_NODISCARD static uint64_t ComputeKey(const String& path, const TextureCacheSettings& settings);
+  YEAGER_NODISCARD Uint GetTextureCount() const;
+  YEAGER_NODISCARD Uint GetReleasedCount() const;
+
+ private:
+  void Release(uint64_t key, MaterialTexture2D* texture);
+
+  struct Entry {
+    std::weak_ptr<MaterialTexture2D> Texture;
+    String CanonicalPath = YEAGER_NULL_LITERAL;
+  };
+
+  std::unique_ptr<TextureFactory> mFactory = YEAGER_NULLPTR;
+  mutable std::mutex mMutex;
+  std::unordered_map<uint64_t, Entry> mEntries;
+  std::vector<MaterialTexture2D*> mReleased;
+};
+
+}  // namespace Yeager
@@ -0,0 +1,211 @@
+#include "TextureStreaming.h"
+#include "stb_image.h"
+using namespace Yeager;
+
+void TextureCompletionQueue::Push(StreamedTexture* texture)
+{
+  StreamedTexture* head = mHead.load(std::memory_order_relaxed);
+  do {
+    texture->Next = head;
+  } while (!mHead.compare_exchange_weak(head, texture, std::memory_order_release, std::memory_order_relaxed));
+}
+
+StreamedTexture* TextureCompletionQueue::PopAll()
+{
+  /* The whole list is taken at once, so no node is ever popped while another thread reads it */
+  StreamedTexture* head = mHead.exchange(YEAGER_NULLPTR, std::memory_order_acquire);
+  StreamedTexture* ordered = YEAGER_NULLPTR;
+  while (head != YEAGER_NULLPTR) {
+    StreamedTexture* next = head->Next;
+    head->Next = ordered;
+    ordered = head;
+    head = next;
+  }
+  return ordered;
+}
+
+TextureStreamer::TextureStreamer(std::unique_ptr<TextureUploader> uploader)
+    : mUploader(std::move(uploader)), bCompressedLevels(mUploader->SupportsCompressedLevels())
+{}
+
+TextureStreamer::~TextureStreamer()
+{
+  /* The decode jobs push into the queue of this streamer, every one of them must be done before it goes away */
+  WaitDecodes();
+  for (StreamedTexture* texture = mCompleted.PopAll(); texture != YEAGER_NULLPTR;) {
+    StreamedTexture* next = texture->Next;
+    delete texture;
+    texture = next;
+  }
+}
+
+void TextureStreamer::Request(const TextureStreamRequest& request)
+{
+  std::shared_ptr<MaterialTexture2D> target = request.Target.lock();
+  if (!target)
+    return;
+  mUploader->AttachPlaceholder(target.get(), request);
+
+  StreamedTexture* texture = new StreamedTexture();
+  texture->Request = request;
+  mDecoding.fetch_add(1, std::memory_order_acq_rel);
+
+  const bool compressedLevels = bCompressedLevels;
+  JobSystem::Run(
+      [this, texture, compressedLevels]() {
+        Decode(texture, compressedLevels);
+        mCompleted.Push(texture);
+      },
+      &mDecodes, JobPriority::eBACKGROUND);
+}
+
+void TextureStreamer::Decode(StreamedTexture* texture, bool compressedLevels)
+{
+  const TextureStreamRequest& request = texture->Request;
+  const bool cached = request.CacheFolder != YEAGER_NULL_LITERAL;
+  const String cachePath =
+      cached ? TextureCache::BuildCachePath(request.CacheFolder, request.Path, request.Settings) : String();
+
+  if (cached)
+    texture->bDecoded = TextureCache::Load(cachePath, request.Path, request.Settings, &texture->Data);
+
+  if (!texture->bDecoded) {
+    /* The flip flag of stbi is global, the thread version keeps the decode jobs and the importers apart */
+    stbi_set_flip_vertically_on_load_thread(request.Settings.bFlipped);
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = stbi_load(request.Path.c_str(), &width, &height, &channels, 0);
+    if (pixels == YEAGER_NULLPTR) {
+      Yeager::Log(ERROR, "Cannot decode the streamed texture {}, reason {}", request.Path, stbi_failure_reason());
+      return;
+    }
+
+    std::optional<TextureCacheData> data =
+        TextureCache::Build(request.Path, pixels, width, height, channels, request.Settings);
+    stbi_image_free(pixels);
+    if (!data.has_value())
+      return;
+
+    texture->Data = std::move(data.value());
+    texture->bDecoded = true;
+    if (cached)
+      TextureCache::Write(cachePath, texture->Data);
+  }
+
+  /* Without compressed texture support the blocks are decoded here, instead of on the main thread during the upload */
+  const auto payload = static_cast<TexturePayloadFormat::Enum>(texture->Data.Header.Payload);
+  if (!compressedLevels && payload != TexturePayloadFormat::eRGBA8) {
+    for (auto& level : texture->Data.Levels) {
+      level = DecompressTextureLevel(level, payload);
+    }
+    texture->Data.Header.Payload = TexturePayloadFormat::eRGBA8;
+  }
+}
+
+/* Ordering of the upload heap, std::push_heap keeps the largest element on top so the comparison is reversed */
+static bool IsUploadedAfter(const TextureUploadEntry& first, const TextureUploadEntry& second)
+{
+  if (first.Size != second.Size)
+    return first.Size > second.Size;
+  return first.Order > second.Order;
+}
+
+void TextureStreamer::PushUpload(StreamedTexture* texture)
+{
+  TextureUploadEntry entry;
+  entry.Size = texture->Data.Levels[texture->ResidentLevel - 1].Data.size();
+  entry.Order = mUploadOrder++;
+  entry.Texture = texture;
+  mUploadHeap.push_back(entry);
+  std::push_heap(mUploadHeap.begin(), mUploadHeap.end(), IsUploadedAfter);
+}
+
+void TextureStreamer::DropExpiredUploads()
+{
+  bool dropped = false;
+  for (const auto& texture : mUploading) {
+    if (texture->ResidentLevel > 0 && texture->Request.Target.expired()) {
+      texture->ResidentLevel = 0;
+      dropped = true;
+    }
+  }
+  if (!dropped)
+    return;
+  /* Marked first and removed by the mark, a target that expires in between is dropped on the next update */
+  std::erase_if(mUploadHeap, [](const TextureUploadEntry& entry) { return entry.Texture->ResidentLevel == 0; });
+  std::make_heap(mUploadHeap.begin(), mUploadHeap.end(), IsUploadedAfter);
+}
+
+void TextureStreamer::Update(const TextureStreamBudget& budget)
+{
+  const auto start = std::chrono::steady_clock::now();
+  auto elapsed = [&start]() {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  for (StreamedTexture* texture = mCompleted.PopAll(); texture != YEAGER_NULLPTR;) {
+    StreamedTexture* next = texture->Next;
+    mDecoding.fetch_sub(1, std::memory_order_acq_rel);
+    if (texture->bDecoded && !texture->Data.Levels.empty()) {
+      /* Textures that failed to decode keep their placeholder */
+      texture->ResidentLevel = static_cast<Uint>(texture->Data.Levels.size());
+      mUploading.emplace_back(texture);
+      PushUpload(texture);
+    } else {
+      delete texture;
+    }
+    texture = next;
+  }
+  DropExpiredUploads();
+
+  mLastUpdate = TextureStreamStatistics();
+  while (!mUploadHeap.empty()) {
+    StreamedTexture* texture = mUploadHeap.front().Texture;
+    const Uint level = texture->ResidentLevel - 1;
+    std::vector<unsigned char>& levelData = texture->Data.Levels[level].Data;
+    if (mLastUpdate.LevelsUploaded > 0 &&
+        (mLastUpdate.BytesUploaded + levelData.size() > budget.Bytes || elapsed() >= budget.Milliseconds))
+      break;
+    std::pop_heap(mUploadHeap.begin(), mUploadHeap.end(), IsUploadedAfter);
+    mUploadHeap.pop_back();
+
+    std::shared_ptr<MaterialTexture2D> target = texture->Request.Target.lock();
+    if (!target) {
+      texture->ResidentLevel = 0;
+      continue;
+    }
+
+    if (texture->ResidentLevel == texture->Data.Levels.size())
+      mUploader->Begin(target.get(), texture->Data);
+    mUploader->UploadLevel(target.get(), texture->Data, level);
+    texture->ResidentLevel = level;
+
+    mLastUpdate.LevelsUploaded++;
+    mLastUpdate.BytesUploaded += levelData.size();
+    /* The level lives on the GPU now */
+    std::vector<unsigned char>().swap(levelData);
+    if (level > 0)
+      PushUpload(texture);
+  }
+
+  std::erase_if(mUploading,
+                [](const std::unique_ptr<StreamedTexture>& texture) { return texture->ResidentLevel == 0; });
+
+  mLastUpdate.Decoding = mDecoding.load(std::memory_order_acquire);
+  mLastUpdate.Uploading = static_cast<Uint>(mUploading.size());
+  mLastUpdate.Milliseconds = elapsed();
+}
+
+void TextureStreamer::WaitDecodes()
+{
+  JobSystem::Wait(&mDecodes);
+}
+
+bool TextureStreamer::IsStreaming() const
+{
+  return mDecoding.load(std::memory_order_acquire) > 0 || !mUploading.empty();
+}
+
+TextureStreamStatistics TextureStreamer::GetStatistics() const
+{
+  return mLastUpdate;
+}
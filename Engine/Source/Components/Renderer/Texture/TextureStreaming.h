@@ -0,0 +1,147 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+#include "Components/Kernel/Caching/TextureCache.h"
+#include "Components/Kernel/Process/JobSystem.h"
+
+namespace Yeager {
+
+class MaterialTexture2D;
+
+/* How much the streamer can send to the GPU each frame. The first level of a frame is always uploaded, even when it is
+larger than the budget, so big textures still progress */
+struct TextureStreamBudget {
+  std::size_t Bytes = 8 * 1024 * 1024;
+  float Milliseconds = 2.0f;
+};
+
+struct TextureStreamRequest {
+  std::weak_ptr<MaterialTexture2D> Target;
+  String Path = YEAGER_NULL_LITERAL;
+  /* Folder of the texture caches, the image is decoded and its cache rewritten when it is missing or outdated */
+  String CacheFolder = YEAGER_NULL_LITERAL;
+  TextureCacheSettings Settings;
+};
+
+/* A texture between its decode and its last upload. Levels from ResidentLevel to the tail are already on the GPU */
+struct StreamedTexture {
+  TextureStreamRequest Request;
+  TextureCacheData Data;
+  Uint ResidentLevel = 0;
+  bool bDecoded = false;
+  /* Link used by the completion queue */
+  StreamedTexture* Next = YEAGER_NULLPTR;
+};
+
+/* Next level of a texture waiting for its upload, the upload heap keeps the smallest one on top */
+struct TextureUploadEntry {
+  std::size_t Size = 0;
+  /* Equal sizes are uploaded in the order they were queued */
+  uint64_t Order = 0;
+  StreamedTexture* Texture = YEAGER_NULLPTR;
+};
+
+struct TextureStreamStatistics {
+  Uint Decoding = 0;
+  Uint Uploading = 0;
+  /* Work done by the last update */
+  Uint LevelsUploaded = 0;
+  std::size_t BytesUploaded = 0;
+  float Milliseconds = 0.0f;
+};
+
+/**
+ * @brief Lock free queue with many producers and a single consumer. The decode jobs push the finished textures, and the
+ * main thread takes all of them at once, in the order they were pushed
+ */
+class TextureCompletionQueue {
+ public:
+  void Push(StreamedTexture* texture);
+  YEAGER_NODISCARD StreamedTexture* PopAll();
+  YEAGER_NODISCARD bool IsEmpty() const { return mHead.load(std::memory_order_acquire) == YEAGER_NULLPTR; }
+
+ private:
+  std::atomic<StreamedTexture*> mHead = YEAGER_NULLPTR;
+};
+
+/* Receives the work of the streamer, the material textures implement it with OpenGL */
+class TextureUploader {
+ public:
+  virtual ~TextureUploader() = default;
+
+  /** @brief Runs on the thread that requested the texture, must not call OpenGL. Points the target to a placeholder */
+  virtual void AttachPlaceholder(MaterialTexture2D* target, const TextureStreamRequest& request) = 0;
+  /** @brief Main thread, creates the texture object right before its first level is uploaded */
+  virtual void Begin(MaterialTexture2D* target, const TextureCacheData& data) = 0;
+  /** @brief Main thread, the levels arrive from the 1x1 tail up to the full size one, each one is usable at once */
+  virtual void UploadLevel(MaterialTexture2D* target, const TextureCacheData& data, Uint level) = 0;
+  YEAGER_NODISCARD virtual bool SupportsCompressedLevels() const = 0;
+};
+
+/**
+ * @brief Decodes textures on the job system and uploads them a few levels per frame. The decode reads the texture
+ * cache, or the source image followed by the mip generation and compression, and the finished textures wait in a
+ * completion queue until the main thread drains it. The uploads always pick the smallest level waiting, so every
+ * texture gets its mip tail resident before any texture gets its full size level
+ */
+class TextureStreamer {
+ public:
+  TextureStreamer(std::unique_ptr<TextureUploader> uploader);
+  ~TextureStreamer();
+  TextureStreamer(const TextureStreamer&) = delete;
+  TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+  /** @brief Can be called from any thread, the target shows the placeholder until its levels start to arrive */
+  void Request(const TextureStreamRequest& request);
+  /** @brief Main thread, once per frame. Takes the decoded textures and uploads levels until the budget runs out */
+  void Update(const TextureStreamBudget& budget);
+  /** @brief Blocks until every requested texture is decoded, they still need updates to be uploaded */
+  void WaitDecodes();
+
+  YEAGER_NODISCARD bool IsStreaming() const;
+  YEAGER_NODISCARD TextureStreamStatistics GetStatistics() const;
+
+ private:
+  static void Decode(StreamedTexture* texture, bool compressedLevels);
+  /* Queues the next level of the texture, the one under its resident level */
+  void PushUpload(StreamedTexture* texture);
+  /* Textures whose target is gone stop receiving uploads and are released at the end of the update */
+  void DropExpiredUploads();
+
+  std::unique_ptr<TextureUploader> mUploader = YEAGER_NULLPTR;
+  bool bCompressedLevels = false;
+
+  TextureCompletionQueue mCompleted;
+  JobCounter mDecodes;
+  std::atomic<Uint> mDecoding = 0;
+
+  /* Main thread only. Every texture with levels left to upload has one entry in the heap */
+  std::vector<std::unique_ptr<StreamedTexture>> mUploading;
+  std::vector<TextureUploadEntry> mUploadHeap;
+  uint64_t mUploadOrder = 0;
+  TextureStreamStatistics mLastUpdate;
+};
+
+}  // namespace Yeager
@@ -7,7 +7,7 @@ std::shared_ptr<WpThread> TerrainGenThreadManagement::mThread = YEAGER_NULLPTR;
 std::atomic_bool TerrainGenThreadManagement::bIsExecutingThread = false;
 bool TerrainGenThreadManagement::bTerrainCanBeDraw = false;
 Shader* TerrainGenThreadManagement::mShader = YEAGER_NULLPTR;
-bool TerrainGenThreadManagement::bMustGenerateGL = false;
+std::atomic_bool TerrainGenThreadManagement::bMustGenerateGL = false;
 
 void TerrainGenThreadManagement::CreateThreadFaultFormationTerrain(std::vector<String> TexturesPaths,
                                                                    int TerrainChunkPositionX, int TerrainChunkPositionY,
@@ -48,11 +48,11 @@ void TerrainGenThreadManagement::UpdateThread()
 void TerrainGenThreadManagement::DrawTerrain()
 {
   if (bTerrainCanBeDraw) {
-    glDisable(GL_CULL_FACE);
+    GLStateCache::SetCullFace(false);
     IntervalElapsedTimeManager::StartTimeInterval("Terrain drawing");
     //Yeager::LogDebug(INFO, "Drawing terrain!");
     mTerrain->Draw(mShader);
     IntervalElapsedTimeManager::EndTimeInterval("Terrain drawing");
-    glEnable(GL_CULL_FACE);
+    GLStateCache::SetCullFace(true);
   }
 }
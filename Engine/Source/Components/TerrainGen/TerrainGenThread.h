@@ -48,7 +48,7 @@ class TerrainGenThreadManagement {
   static std::shared_ptr<WpThread> mThread;
 
   static bool bTerrainCanBeDraw;
-  static bool bMustGenerateGL;
+  static std::atomic_bool bMustGenerateGL;
 
   static Shader* mShader;
 
@@ -51,11 +51,8 @@ void TextRenderer::LoadFont(const String& path, Uint size)
 
 void TextRenderer::BuildBuffers()
 {
+  /* Only the vertex array is used, it is pointed at the quads of each text in the upload ring when drawing it */
   m_Renderer.GenBuffers();
-  m_Renderer.BindBuffers();
-  m_Renderer.BufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-  m_Renderer.VertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-  m_Renderer.UnbindBuffers();
 }
 
 std::pair<Uint, Text2D> TextRenderer::AddText(Text2D& text)
@@ -74,29 +71,7 @@ void TextRenderer::RenderText(Yeager::Shader* shader, Transformation3D& transfor
 
   Transformation3D::Apply(&transformation, shader);
 
-  glActiveTexture(GL_TEXTURE0);
-  m_Renderer.BindBuffers();
-
-  String::const_iterator c;
-  for (c = text.begin(); c != text.end(); c++) {
-    Character ch = m_Characters[*c];
-    float xpos = x + ch.Bearing.x * scale;
-    float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-
-    float w = ch.Size.x * scale;
-    float h = ch.Size.y * scale;
-    // update VBO for each character
-    float vertices[6][4] = {
-        {xpos, ypos + h, 0.0f, 0.0f}, {xpos, ypos, 0.0f, 1.0f},     {xpos + w, ypos, 1.0f, 1.0f},
-
-        {xpos, ypos + h, 0.0f, 0.0f}, {xpos + w, ypos, 1.0f, 1.0f}, {xpos + w, ypos + h, 1.0f, 0.0f}};
-    glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-
-    m_Renderer.SubBufferData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-    m_Renderer.Draw(GL_TRIANGLES, 0, 6);
-    x += (ch.Advance >> 6) * scale;
-  }
-  m_Renderer.UnbindBuffers();
+  DrawCharacters(text, x, y, scale);
 }
 
 void TextRenderer::RenderText(Yeager::Shader* shader, const String& text, float x, float y, float scale,
@@ -110,28 +85,48 @@ void TextRenderer::RenderText(Yeager::Shader* shader, const String& text, float
   shader->SetVec3("textColor", color);
   shader->SetMat4("projection", proj);
 
-  glActiveTexture(GL_TEXTURE0);
-  m_Renderer.BindBuffers();
+  DrawCharacters(text, x, y, scale);
+}
+
+void TextRenderer::DrawCharacters(const String& text, float x, float y, float scale)
+{
+  if (text.empty())
+    return;
+
+  /* The quads of the whole text are written to the ring at once, instead of one glBufferSubData per character on a
+  buffer the last character is still being drawn from */
+  UploadRing* ring = m_Application->GetUploadRing();
+  const std::size_t quadSize = sizeof(float) * 6 * 4;
+  const RingAllocation range = ring->Allocate(text.size() * quadSize, ring->GetOffsetAlignment(GL_ARRAY_BUFFER));
 
   String::const_iterator c;
-  for (c = text.begin(); c != text.end(); c++) {
-    Character ch = m_Characters[*c];
+  unsigned char* output = range.Data;
+  for (c = text.begin(); c != text.end(); c++, output += quadSize) {
+    const Character& ch = m_Characters[*c];
     float xpos = x + ch.Bearing.x * scale;
     float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
 
     float w = ch.Size.x * scale;
     float h = ch.Size.y * scale;
-    // update VBO for each character
-    float vertices[6][4] = {
+    const float vertices[6][4] = {
         {xpos, ypos + h, 0.0f, 0.0f}, {xpos, ypos, 0.0f, 1.0f},     {xpos + w, ypos, 1.0f, 1.0f},
 
         {xpos, ypos + h, 0.0f, 0.0f}, {xpos + w, ypos, 1.0f, 1.0f}, {xpos + w, ypos + h, 1.0f, 0.0f}};
-    glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-
-    m_Renderer.SubBufferData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-    m_Renderer.Draw(GL_TRIANGLES, 0, 6);
+    std::memcpy(output, vertices, quadSize);
     x += (ch.Advance >> 6) * scale;
   }
+  ring->Commit(range);
+
+  glActiveTexture(GL_TEXTURE0);
+  m_Renderer.BindVertexArray();
+  GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, range.Buffer));
+  m_Renderer.VertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float),
+                                 reinterpret_cast<const void*>(range.Offset));
+
+  for (std::size_t index = 0; index < text.size(); index++) {
+    glBindTexture(GL_TEXTURE_2D, m_Characters[text[index]].TextureID);
+    m_Renderer.Draw(GL_TRIANGLES, static_cast<GLint>(index * 6), 6);
+  }
   m_Renderer.UnbindBuffers();
 }
 
@@ -67,6 +67,9 @@ class TextRenderer {
   std::pair<Uint, Text2D> AddText(Text2D& text);
 
  private:
+  /** @brief Writes the quads of the text to the upload ring and draws them, the shader must be set */
+  void DrawCharacters(const String& text, float x, float y, float scale);
+
   std::map<char, Character> m_Characters;
   std::map<Uint, Text2D> m_Texts;
   Uint m_TextIndexes = 0;
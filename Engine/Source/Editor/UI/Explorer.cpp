@@ -407,7 +407,7 @@ void EditorExplorer::CreateAnimatedObject()
       BuildInstancedObjectTransformation(pos);
 
       obj->BuildAnimation(m_NewObjectPath);
-      obj->BuildProps(pos, m_Application->ShaderFromVarName("SimpleAnimated"));
+      obj->BuildProps(pos);
 
       DeleteInstancedObjectTransformation(pos);  // cleanup smart pointers
 
@@ -1110,14 +1110,14 @@ void Interface::RenderDebugger()
   const String polygonModePointStr =
       String(ICON_FA_ARROW_POINTER " " + locale.Translate("Debug.Dev.Polygon.Mode.Point.Btn"));
   if (Button(polygonModePointStr.c_str())) {
-    glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+    GLStateCache::SetPolygonMode(GL_POINT);
   }
   SameLine();
 
   const String polygonModeLinesStr =
       String(ICON_FA_ARROW_ROTATE_LEFT " " + locale.Translate("Debug.Dev.Polygon.Mode.Lines.Btn"));
   if (Button(polygonModeLinesStr.c_str())) {
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    GLStateCache::SetPolygonMode(GL_LINE);
   }
 
   SameLine();
@@ -1125,7 +1125,7 @@ void Interface::RenderDebugger()
   const String polygonModeFillStr =
       String(ICON_FA_ARROW_ROTATE_LEFT " " + locale.Translate("Debug.Dev.Polygon.Mode.Lines.Btn"));
   if (Button(polygonModeFillStr.c_str())) {
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    GLStateCache::SetPolygonMode(GL_FILL);
   }
 
   Separator();
@@ -143,14 +143,14 @@ void ToolboxHandle::DrawToolboxObjectType()
         m_FlipEveryTexture = !m_FlipEveryTexture;
         if (m_EntityPtr->GetEntityType() == EntityObjectType::OBJECT) {
           for (const auto& p : obj->GetModelData()->TexturesLoaded) {
-            Yeager::MaterialTexture2D* texture = &p->first;
+            Yeager::MaterialTexture2D* texture = p.get();
             texture->RegenerateTextureFlipped(m_FlipEveryTexture);
           }
 
         } else if (m_EntityPtr->GetEntityType() == EntityObjectType::OBJECT_ANIMATED) {
           Yeager::AnimatedObject* animated = static_cast<Yeager::AnimatedObject*>(obj);
           for (const auto& p : animated->GetModelData()->TexturesLoaded) {
-            Yeager::MaterialTexture2D* texture = &p->first;
+            Yeager::MaterialTexture2D* texture = p.get();
             texture->RegenerateTextureFlipped(m_FlipEveryTexture);
           }
         }
@@ -171,6 +171,7 @@ void ToolboxHandle::DrawToolboxObjectType()
     InputVector3("Scale", &trans->scale);
 
     Checkbox("Culling Enabled", &obj->GetOnScreenProprieties()->m_CullingEnabled);
+    Checkbox("Transparent", &obj->GetOnScreenProprieties()->m_Transparent);
 
     if (Button("PolygonMode: FILL")) {
       obj->GetOnScreenProprieties()->m_PolygonMode = RenderingGLPolygonMode::eFILL;
@@ -192,7 +193,7 @@ void ToolboxHandle::DrawToolboxObjectType()
 
     if (m_EntityPtr->GetEntityType() == EntityObjectType::OBJECT) {
       for (const auto& p : obj->GetModelData()->TexturesLoaded) {
-        Yeager::MaterialTexture2D* texture = &p->first;
+        Yeager::MaterialTexture2D* texture = p.get();
         DisplayTextureInformation(texture);
       }
     }
@@ -283,7 +284,7 @@ void ToolboxHandle::DrawToolboxSkybox()
   const ObjectGeometryType::Enum type = skybox->GetGeometry();
 
   SliderInt("Resize textures", (int*)&m_ResizeTextures, 1, 100);
-  Yeager::MaterialTexture2D* texture = &skybox->GetModelData()->TexturesLoaded[0]->first;
+  Yeager::MaterialTexture2D* texture = skybox->GetModelData()->TexturesLoaded[0].get();
   DisplayTextureInformation(texture);
 }
 
@@ -191,5 +191,7 @@ bool NodeComponent::AddChild(Yeager::EditorEntity* entity)
 bool NodeComponent::LinkToParent(std::shared_ptr<NodeComponent> parent)
 {
   m_Parent = parent;
+  if (m_Entity != YEAGER_NULLPTR)
+    m_Entity->OnNodeParentChanged(parent.get());
   return true;
 }
@@ -100,6 +100,7 @@ ApplicationCore::ApplicationCore(int argc, char* argv[])
       mCommonTextOnScreen(this),
       mCurrentLocale(this, ELanguangeRegion::EN_US, true)
 {
+  JobSystem::Initialize();
   InitializeRandomGenerator();
   ProcessArguments(argc, argv);
   ValidatesExternalEngineFolder();
@@ -257,6 +258,11 @@ void ApplicationCore::BuildApplicationCoreCompoments()
   mSerial->ReadEditorSoundsConfiguration(GetPathFromShared("/Configuration/Theme/Sound/EditorSounds.yml").value());
   CheckGLADIntegrity();
 
+  mTextureStreamer = BaseAllocator::MakeSharedPtr<TextureStreamer>(std::make_unique<MaterialTextureUploaderGL>());
+  mTextureRegistry = BaseAllocator::MakeSharedPtr<TextureRegistry>(std::make_unique<MaterialTextureFactoryGL>());
+  mTransformStorage = BaseAllocator::MakeSharedPtr<TransformStorage>();
+  mGeometryArena = BaseAllocator::MakeSharedPtr<GeometryArena>();
+  mUploadRing = BaseAllocator::MakeSharedPtr<UploadRing>();
   mDefaults = BaseAllocator::MakeSharedPtr<DefaultValues>(this);
   mInterface = BaseAllocator::MakeSharedPtr<Interface>(mWindow.get(), this);
   SetupCamera();
@@ -331,11 +337,22 @@ ApplicationCore::~ApplicationCore()
   mEditorExplorer.reset();
   mAudioEngine.reset();
   mScene.reset();
+  /* After the scene, its import jobs may still request textures. Before the window, the placeholders are GL objects */
+  mTextureStreamer.reset();
+  mTextureRegistry.reset();
+  /* After the scene, the game entities remove their transforms when destroyed */
+  mTransformStorage.reset();
+  /* After the scene, the meshes give their ranges back to the pools when destroyed */
+  mGeometryArena.reset();
+  /* After the scene and before the window, the ring buffer and its fences are GL objects */
+  mUploadRing.reset();
   mDefaults.reset();
   mInterface.reset();
   mInput.reset();
   mWindow.reset();
   mSettings.reset();
+  /* Last, objects destroyed above may still be waiting on their import jobs */
+  JobSystem::Terminate();
 }
 
 void ApplicationCore::UpdateDeltaTime()
@@ -357,6 +374,7 @@ void ApplicationCore::UpdateWorldMatrices()
   }
   mWorldMatrices.mView = GetCamera()->ReturnViewMatrix();
   mWorldMatrices.mViewerPos = GetCamera()->GetPosition();
+  mWorldMatrices.mFrustum = Frustum::FromMatrix(mWorldMatrices.mProjection * mWorldMatrices.mView);
 }
 
 void ApplicationCore::UpdateListenerPosition()
@@ -369,7 +387,8 @@ void ApplicationCore::UpdateListenerPosition()
 
 void ApplicationCore::ShowCommonTextOnScreen()
 {
-  if (mScene->GetThreadAnimatedImporters()->size() + mScene->GetThreadImporters()->size() > 0) {
+  if (mScene->GetThreadAnimatedImporters()->size() + mScene->GetThreadImporters()->size() > 0 ||
+      mTextureStreamer->IsStreaming()) {
     mCommonTextOnScreen.RenderText(ShaderFromVarName("Font2D"), "Loading Assets", 0, 100,
                                    mSettings->GetInterfaceSettingsStruct().GlobalOnScreenTextScale, Vector3(1));
   }
@@ -421,10 +440,13 @@ void ApplicationCore::UpdateTheEngine()
 
     ProcessArgumentsDuringRender();
     mWindow->StartFrame();
+    GLStateCache::Invalidate();
+    mUploadRing->BeginFrame();
     OpenGLClear();
 
     mInterface->InitRenderFrame();
     mScene->CheckThreadsAndTriggerActions();
+    mTextureStreamer->Update(mTextureStreamBudget);
 
     UpdateDeltaTime();
     UpdateWorldMatrices();
@@ -432,18 +454,29 @@ void ApplicationCore::UpdateTheEngine()
     ManifestAllShaders();
     UpdateCamera();
 
-    mAudioEngine->Engine->update();
-
+    /* The step runs in the workers while the scene is drawn, the objects see the poses of the last step */
     mPhysXHandle->StartSimulation(mDeltaTime);
-    mPhysXHandle->EndSimulation();
 
+    mAudioEngine->Engine->update();
+
+    UpdateTransforms();
+    /* The lighting blocks are placed in the upload ring of this frame before the draws reading them */
+    BuildLightSources();
     DrawObjects();
-    BuildAndDrawLightSources();
+    DrawLightSources();
 
     mScene->DrawSkybox(ShaderFromVarName("Skybox"), mWorldMatrices.mView, mWorldMatrices.mProjection);
 
+    /* Fetched before the interface, it creates and edits actors, which the scene does not allow during the step */
+    IntervalElapsedTimeManager::StartTimeInterval("PhysX Fetch Results");
+    mPhysXHandle->EndSimulation();
+    IntervalElapsedTimeManager::EndTimeInterval("PhysX Fetch Results");
+
     mInterface->RenderUI();
+
     mScene->CheckScheduleDeletions();
+    mScene->ReleaseDestroyed(mSceneReleaseBudget);
+    mTextureRegistry->CollectReleased();
     mInput->ProcessInputRender(mWindow.get(), mDeltaTime);
     mRequest->HandleRequests();
 
@@ -451,6 +484,8 @@ void ApplicationCore::UpdateTheEngine()
 
     mInterface->DebugTimeInterval();
     mInterface->TerminateRenderFrame();
+    /* Fences everything uploaded this frame, after the last draw reading it */
+    mUploadRing->EndFrame();
     mWindow->EndFrame();
   }
 
@@ -469,16 +504,24 @@ void ApplicationCore::TerminatePosRender()
 
   mGeneralLight.reset();
   mPhysXHandle.reset();
+  mTextureStreamer.reset();
   mScene->Terminate();
+  mTextureRegistry->CollectReleased();
   mInterface->Terminate();
   mWindow->Terminate();
 }
 
-void ApplicationCore::BuildAndDrawLightSources()
+void ApplicationCore::BuildLightSources()
 {
   for (const auto& light : *GetScene()->GetLightSources()) {
     light->BuildShaderProps(GetCamera()->GetPosition(), GetCamera()->GetDirection(), 32.0f);
-    light->DrawLightSources(mDeltaTime);
+  }
+}
+
+void ApplicationCore::DrawLightSources()
+{
+  for (const auto& light : *GetScene()->GetLightSources()) {
+    light->DrawLightSources(mDeltaTime, &mWorldMatrices.mFrustum);
   }
 }
 
@@ -511,30 +554,104 @@ float ApplicationCore::GetSecondsElapsedSinceStart() const
   return 1;
 }
 
+void ApplicationCore::UpdateAnimations()
+{
+  auto* animated = GetScene()->GetAnimatedObject();
+
+  /* The palettes are placed first, so the staging array does not move while the jobs write into it */
+  mBonePalette.Clear();
+  for (const auto& obj : *animated) {
+    obj->SetPaletteOffset(mBonePalette.Allocate(obj->GetPaletteBoneCount()));
+  }
+
+  /* Animations keep running while culled, so they dont freeze out of the screen. Each object only touches its own
+  animation engine and its own slice of the palette */
+  const float delta = mDeltaTime;
+  JobSystem::ParallelFor(static_cast<Uint>(animated->size()), 0, [this, animated, delta](Uint begin, Uint end) {
+    for (Uint x = begin; x < end; x++) {
+      AnimatedObject* obj = (*animated)[x].get();
+      obj->UpdateAnimation(delta);
+      obj->WritePalette(mBonePalette.GetPalette(obj->GetPaletteOffset(), obj->GetPaletteBoneCount()));
+    }
+  });
+
+  mBonePalette.Upload(mUploadRing.get());
+}
+
+void ApplicationCore::UpdateTransforms()
+{
+  /* The interpolated poses are written before the pass, so the draws below never compose a dirty transform by hand */
+  for (const auto& obj : *GetScene()->GetObjects()) {
+    if (obj->IsLoaded() && obj->GetObjectPhysicsType() == ObjectPhysicsType::eDYNAMIC_BODY)
+      obj->GetPhysXActor()->ProcessTransformation(mDeltaTime);
+  }
+
+  mTransformStorage->Update();
+}
+
 void ApplicationCore::DrawObjects()
 {
+  /* Shaders are searched once per frame instead of once per object */
+  Shader* simple = ShaderFromVarName("Simple");
+  Shader* simpleInstanced = ShaderFromVarName("SimpleInstanced");
+  Shader* simpleAnimated = ShaderFromVarName("SimpleAnimated");
+  Shader* simpleInstancedAnimated = ShaderFromVarName("SimpleInstancedAnimated");
+
+  /* Objects inside the tree start culled, the frustum query marks the visible ones back */
+  const std::shared_ptr<AABBTree> tree = GetScene()->GetCullingTree();
   for (const auto& obj : *GetScene()->GetObjects()) {
-    if (obj->IsInstanced()) {
-      obj->Draw(ShaderFromVarName("SimpleInstanced"), mDeltaTime);
-    } else {
-      obj->Draw(ShaderFromVarName("Simple"), mDeltaTime);
-    }
+    obj->UpdateCullingProxy(tree);
+    obj->SetCulled(obj->HasCullingProxy());
   }
+  for (const auto& obj : *GetScene()->GetAnimatedObject()) {
+    obj->UpdateCullingProxy(tree);
+    obj->SetCulled(obj->HasCullingProxy());
+  }
+  tree->QueryFrustum(mWorldMatrices.mFrustum, [](void* data) { static_cast<Object*>(data)->SetCulled(false); });
 
+  /* The transforms of the visible instanced objects go to the stream range of this frame, counted first so the range
+  is allocated from the ring before any of them is written */
+  Uint instances = 0;
+  for (const auto& obj : *GetScene()->GetObjects()) {
+    if (!obj->IsCulled())
+      instances += obj->GetInstancePropsCount();
+  }
+  for (const auto& obj : *GetScene()->GetAnimatedObject()) {
+    if (!obj->IsCulled())
+      instances += obj->GetInstancePropsCount();
+  }
+  mInstanceStream.BeginFrame(mUploadRing.get(), instances);
+  for (const auto& obj : *GetScene()->GetObjects()) {
+    if (!obj->IsCulled() && obj->IsInstanced())
+      obj->WriteInstances(&mInstanceStream);
+  }
   for (const auto& obj : *GetScene()->GetAnimatedObject()) {
-    Shader* shader = YEAGER_NULLPTR;
+    if (!obj->IsCulled() && obj->IsInstanced())
+      obj->WriteInstances(&mInstanceStream);
+  }
+  mInstanceStream.Bind();
 
-    if (obj->IsInstanced()) {
-      shader = ShaderFromVarName("SimpleInstancedAnimated");
-    } else {
-      shader = ShaderFromVarName("SimpleAnimated");
-    }
+  /* Only the OpenGL 4 renderer draws the batches of the pooled meshes with indirect commands */
+  mGeometryArena->BeginFrame(GetScene()->GetContext()->ProjectSceneRenderer == SceneRenderer::OpenGL4,
+                             mUploadRing.get());
 
-    shader->UseShader();
-    obj->UpdateAnimation(mDeltaTime);
-    obj->BuildAnimationMatrices(shader);
-    obj->Draw(shader);
+  mRenderQueue.Clear();
+  mRenderQueue.SetViewer(mWorldMatrices.mViewerPos, 1000.0f);
+
+  for (const auto& obj : *GetScene()->GetObjects()) {
+    if (!obj->IsCulled())
+      mRenderQueue.Push(obj, obj->IsInstanced() ? simpleInstanced : simple);
   }
+
+  UpdateAnimations();
+
+  for (const auto& obj : *GetScene()->GetAnimatedObject()) {
+    if (!obj->IsCulled())
+      mRenderQueue.Push(obj, obj->IsInstanced() ? simpleInstancedAnimated : simpleAnimated);
+  }
+
+  mRenderQueue.Sort();
+  mRenderQueue.Submit(mDeltaTime);
 }
 
 AudioEngine* ApplicationCore::GetAudioFromEngine()
@@ -643,8 +760,8 @@ void ApplicationCore::OpenGLFunc()
   glEnable(GL_BLEND);
   glEnable(GL_MULTISAMPLE);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glEnable(GL_CULL_FACE);
   glCullFace(GL_BACK);
+  GLStateCache::SetCullFace(true);
 }
 
 void ApplicationCore::OpenGLClear()
@@ -698,6 +815,28 @@ PhysXHandle* ApplicationCore::GetPhysXHandle()
 {
   return mPhysXHandle.get();
 }
+TextureStreamer* ApplicationCore::GetTextureStreamer()
+{
+  return mTextureStreamer.get();
+}
+TextureRegistry* ApplicationCore::GetTextureRegistry()
+{
+  return mTextureRegistry.get();
+}
+TransformStorage* ApplicationCore::GetTransformStorage()
+{
+  return mTransformStorage.get();
+}
+
+GeometryArena* ApplicationCore::GetGeometryArena()
+{
+  return mGeometryArena.get();
+}
+
+UploadRing* ApplicationCore::GetUploadRing()
+{
+  return mUploadRing.get();
+}
 AudioEngineHandle* ApplicationCore::GetAudioEngineHandle()
 {
   return mAudioEngine.get();
@@ -30,7 +30,14 @@
 #include "Components/Kernel/Network/NetworkSocket.h"
 #include "Components/Kernel/Process/WpThread.h"
 #include "Components/Physics/PhysXHandle.h"
+#include "Components/Renderer/AnimationEngine/BonePalette.h"
+#include "Components/Renderer/GL/GeometryArena.h"
+#include "Components/Renderer/GL/UploadRing.h"
+#include "Components/Renderer/Objects/TransformStorage.h"
 #include "Components/Player/PlayableObject.h"
+#include "Components/Renderer/RenderQueue/RenderQueue.h"
+#include "Components/Renderer/Texture/TextureRegistry.h"
+#include "Components/Renderer/Texture/TextureStreaming.h"
 #include "Components/Text/TextRendering.h"
 #include "Debug/GL/DebbugingGL.h"
 #include "Editor/Camera/Camera.h"
@@ -72,6 +79,8 @@ struct WorldCharacterMatrices {
   Matrix4 mProjection = YEAGER_IDENTITY_MATRIX4x4;
   Matrix4 mView = YEAGER_IDENTITY_MATRIX4x4;
   Vector3 mViewerPos = YEAGER_ZERO_VECTOR3;
+  /* Planes of the view volume built from the projection and view, used to cull what is outside the screen */
+  Frustum mFrustum;
 };
 
 /** @brief Handles the yeager engine projects loaded in the machine, represents the name, folder, configuration path */
@@ -158,6 +167,11 @@ class ApplicationCore {
   RequestHandle* GetRequestHandle();
   DefaultValues* GetDefaults();
   PhysXHandle* GetPhysXHandle();
+  TextureStreamer* GetTextureStreamer();
+  TextureRegistry* GetTextureRegistry();
+  TransformStorage* GetTransformStorage();
+  GeometryArena* GetGeometryArena();
+  UploadRing* GetUploadRing();
   AudioEngineHandle* GetAudioEngineHandle();
   physx::PxController* GetController();
   AudioEngine* GetAudioFromEngine();
@@ -222,8 +236,13 @@ class ApplicationCore {
   void UpdateDeltaTime();
   void UpdateWorldMatrices();
   void UpdateListenerPosition();
+  /** @brief Writes the poses of the dynamic bodies and rebuilds the world matrices of the changed transforms */
+  void UpdateTransforms();
   void DrawObjects();
-  void BuildAndDrawLightSources();
+  /** @brief Evaluates every animation in parallel and uploads the packed bone palette used by the draws */
+  void UpdateAnimations();
+  void BuildLightSources();
+  void DrawLightSources();
   void ManifestAllShaders();
   void TerminatePosRender();
   void SetupCamera();
@@ -275,8 +294,18 @@ class ApplicationCore {
   SharedPtr<Settings> mSettings = YEAGER_NULLPTR;
   SharedPtr<AudioEngine> mAudiosFromEngine = YEAGER_NULLPTR;
   SharedPtr<PhysicalLightHandle> mGeneralLight = YEAGER_NULLPTR;
+  SharedPtr<TextureStreamer> mTextureStreamer = YEAGER_NULLPTR;
+  SharedPtr<TextureRegistry> mTextureRegistry = YEAGER_NULLPTR;
+  SharedPtr<TransformStorage> mTransformStorage = YEAGER_NULLPTR;
+  SharedPtr<GeometryArena> mGeometryArena = YEAGER_NULLPTR;
+  SharedPtr<UploadRing> mUploadRing = YEAGER_NULLPTR;
 
   WorldCharacterMatrices mWorldMatrices;
+  RenderQueue mRenderQueue;
+  BonePaletteBuffer mBonePalette;
+  InstanceStream mInstanceStream;
+  TextureStreamBudget mTextureStreamBudget;
+  SceneReleaseBudget mSceneReleaseBudget;
   ApplicationState::Enum mCurrentState = ApplicationState::eAPPLICATION_RUNNING;
   ApplicationMode::Enum mCurrentMode = ApplicationMode::eAPPLICATION_LAUNCHER;
 
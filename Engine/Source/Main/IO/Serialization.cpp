@@ -143,7 +143,7 @@ void YEAGER_FORCE_INLINE Serialization::SerializeBasicObjectType(YAML::Emitter&
   if (obj->GetGeometry() == ObjectGeometryType::eCUSTOM) {
     for (Uint y = 0; y < obj->GetModelData()->TexturesLoaded.size(); y++) {
       out << YAML::BeginMap;
-      MaterialTexture2D* tex = &obj->GetModelData()->TexturesLoaded.at(y)->first;
+      MaterialTexture2D* tex = obj->GetModelData()->TexturesLoaded.at(y).get();
       SerializeObject(out, "Path", tex->GetPath());
       SerializeObject(out, "Type", MaterialTextureType::ToString(tex->GetTextureType()));
       SerializeObject(out, "Name", tex->GetName());
@@ -684,7 +684,7 @@ void Serialization::DeserializeObject(YAML::detail::iterator_value& entity, Yeag
         EntityBuilder(m_Application, name, EntityObjectType::OBJECT_INSTANCED, uuid),
         entity["InstancedCount"].as<int>());
     std::vector<std::shared_ptr<Transformation3D>> positions = DeserializeObjectProperties(entity);
-    obj->BuildProps(positions, m_Application->ShaderFromVarName("SimpleInstanced"));
+    obj->BuildProps(positions);
   } else {
     obj = BaseAllocator::MakeSharedPtr<Yeager::Object>(
         EntityBuilder(m_Application, name, EntityObjectType::OBJECT, uuid));
@@ -717,9 +717,9 @@ void Serialization::DeserializeObject(YAML::detail::iterator_value& entity, Yeag
 
   } else {
     // Generates geometry for object
-    if (!obj->GenerateObjectGeometry(geometry, ObjectPhysXCreationStatic(obj->GetTransformationPtr()->position,
-                                                                         obj->GetTransformationPtr()->rotation,
-                                                                         obj->GetTransformationPtr()->scale))) {
+    if (!obj->GenerateObjectGeometry(geometry, ObjectPhysXCreationStatic(obj->GetTransformation().position,
+                                                                         obj->GetTransformation().rotation,
+                                                                         obj->GetTransformation().scale))) {
       Yeager::Log(ERROR, "Error generating object geometry during deserialization!");
       succceded = false;
     }
@@ -740,7 +740,7 @@ void Serialization::DeserializeAnimatedObject(YAML::detail::iterator_value& enti
         EntityBuilder(m_Application, name, EntityObjectType::OBJECT_INSTANCED_ANIMATED, uuid),
         entity["InstancedCount"].as<int>());
     std::vector<std::shared_ptr<Transformation3D>> positions = DeserializeObjectProperties(entity);
-    obj->BuildProps(positions, m_Application->ShaderFromVarName("SimpleInstanced"));
+    obj->BuildProps(positions);
   } else {
     obj = BaseAllocator::MakeSharedPtr<Yeager::AnimatedObject>(
         EntityBuilder(m_Application, name, EntityObjectType::OBJECT_ANIMATED, uuid));
@@ -757,9 +757,9 @@ void Serialization::DeserializeAnimatedObject(YAML::detail::iterator_value& enti
       return;
     }
   } else {
-    if (!obj->GenerateObjectGeometry(geometry, ObjectPhysXCreationStatic(obj->GetTransformationPtr()->position,
-                                                                         obj->GetTransformationPtr()->rotation,
-                                                                         obj->GetTransformationPtr()->scale))) {
+    if (!obj->GenerateObjectGeometry(geometry, ObjectPhysXCreationStatic(obj->GetTransformation().position,
+                                                                         obj->GetTransformation().rotation,
+                                                                         obj->GetTransformation().scale))) {
       Yeager::Log(ERROR, "Error generating animated object geometry during deserialization!");
       succceded = false;
     }
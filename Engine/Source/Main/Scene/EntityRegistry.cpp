@@ -0,0 +1,327 @@
+#include "EntityRegistry.h"
+#include "Components/Kernel/Caching/CacheFile.h"
+using namespace Yeager;
+
+static const std::vector<EntityHandle> sNoEntities;
+
+void EntityIndex::SplitUUID(const uuid_t& uuid, uint64_t* high, uint64_t* low)
+{
+  const auto bytes = uuid.as_bytes();
+  std::memcpy(high, bytes.data(), sizeof(uint64_t));
+  std::memcpy(low, bytes.data() + sizeof(uint64_t), sizeof(uint64_t));
+}
+
+/* The tables probe from the low bits, every input bit has to reach them */
+static uint64_t MixHashBits(uint64_t hash)
+{
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/* The low bits of FNV only see the first bytes of each word, names that differ further on would share a probe */
+static uint64_t HashName(const String& name)
+{
+  return MixHashBits(HashCacheBytes(reinterpret_cast<const unsigned char*>(name.data()), name.size()));
+}
+
+uint64_t EntityIndex::HashUUIDWords(uint64_t high, uint64_t low)
+{
+  /* Random UUIDs are already uniform, but the ones of old saves or the nil one may not be */
+  return MixHashBits(high ^ (low * 0x9E3779B97F4A7C15ull));
+}
+
+Uint EntityIndex::FindUUIDSlot(uint64_t high, uint64_t low) const
+{
+  if (mUUIDSlots.empty())
+    return EntityHandle::sInvalidIndex;
+  const Uint mask = static_cast<Uint>(mUUIDSlots.size()) - 1;
+  for (Uint slot = static_cast<Uint>(HashUUIDWords(high, low)) & mask;; slot = (slot + 1) & mask) {
+    const UUIDSlot& entry = mUUIDSlots[slot];
+    if (!entry.Entity.IsValid())
+      return EntityHandle::sInvalidIndex;
+    if (entry.High == high && entry.Low == low)
+      return slot;
+  }
+}
+
+void EntityIndex::GrowUUIDTable()
+{
+  std::vector<UUIDSlot> previous(std::max<std::size_t>(mUUIDSlots.size() * 2, 64));
+  previous.swap(mUUIDSlots);
+  const Uint mask = static_cast<Uint>(mUUIDSlots.size()) - 1;
+  for (const UUIDSlot& entry : previous) {
+    if (!entry.Entity.IsValid())
+      continue;
+    Uint slot = static_cast<Uint>(HashUUIDWords(entry.High, entry.Low)) & mask;
+    while (mUUIDSlots[slot].Entity.IsValid()) {
+      slot = (slot + 1) & mask;
+    }
+    mUUIDSlots[slot] = entry;
+  }
+}
+
+void EntityIndex::EraseUUIDSlot(Uint slot)
+{
+  /* Backward shift, the entries after the hole that probed past it move into it, so no tombstones are needed */
+  const Uint mask = static_cast<Uint>(mUUIDSlots.size()) - 1;
+  Uint hole = slot;
+  for (Uint next = (hole + 1) & mask; mUUIDSlots[next].Entity.IsValid(); next = (next + 1) & mask) {
+    const Uint home = static_cast<Uint>(HashUUIDWords(mUUIDSlots[next].High, mUUIDSlots[next].Low)) & mask;
+    /* Stays when its home is cyclically in (hole, next] */
+    if (((next - home) & mask) < ((next - hole) & mask))
+      continue;
+    mUUIDSlots[hole] = mUUIDSlots[next];
+    hole = next;
+  }
+  mUUIDSlots[hole] = UUIDSlot();
+  mUUIDCount--;
+}
+
+EntityNameId EntityIndex::FindName(const String& name) const
+{
+  if (mNameSlots.empty())
+    return sInvalidName;
+  const uint64_t hash = HashName(name);
+  const Uint mask = static_cast<Uint>(mNameSlots.size()) - 1;
+  for (Uint slot = static_cast<Uint>(hash) & mask; mNameSlots[slot] != 0; slot = (slot + 1) & mask) {
+    const EntityNameId id = mNameSlots[slot] - 1;
+    if (mNameHashes[id] == hash && mNames[id] == name)
+      return id;
+  }
+  return sInvalidName;
+}
+
+void EntityIndex::GrowNameTable()
+{
+  mNameSlots.assign(std::max<std::size_t>(mNameSlots.size() * 2, 64), 0);
+  const Uint mask = static_cast<Uint>(mNameSlots.size()) - 1;
+  for (EntityNameId id = 0; id < mNames.size(); id++) {
+    Uint slot = static_cast<Uint>(mNameHashes[id]) & mask;
+    while (mNameSlots[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+    mNameSlots[slot] = id + 1;
+  }
+}
+
+EntityNameId EntityIndex::Intern(const String& name)
+{
+  const EntityNameId found = FindName(name);
+  if (found != sInvalidName)
+    return found;
+
+  const EntityNameId id = static_cast<EntityNameId>(mNames.size());
+  mNames.push_back(name);
+  mNameHashes.push_back(HashName(name));
+  mEntitiesOfName.emplace_back();
+  if (mNames.size() * 2 > mNameSlots.size()) {
+    GrowNameTable();
+    return id;
+  }
+
+  const Uint mask = static_cast<Uint>(mNameSlots.size()) - 1;
+  Uint slot = static_cast<Uint>(mNameHashes[id]) & mask;
+  while (mNameSlots[slot] != 0) {
+    slot = (slot + 1) & mask;
+  }
+  mNameSlots[slot] = id + 1;
+  return id;
+}
+
+void EntityIndex::LinkName(EntityHandle entity, EntityNameId name)
+{
+  mEntitiesOfName[name].push_back(entity);
+  mRecords[entity.Index].Name = name;
+}
+
+void EntityIndex::UnlinkName(EntityHandle entity, EntityNameId name)
+{
+  /* Kept in insertion order, the lists are short since most names are unique */
+  std::vector<EntityHandle>& entities = mEntitiesOfName[name];
+  const auto it = std::find(entities.begin(), entities.end(), entity);
+  if (it != entities.end())
+    entities.erase(it);
+}
+
+EntityHandle EntityIndex::Insert(EntityHandle entity, const uuid_t& uuid, const String& name)
+{
+  uint64_t high = 0, low = 0;
+  SplitUUID(uuid, &high, &low);
+  const Uint existing = FindUUIDSlot(high, low);
+  if (existing != EntityHandle::sInvalidIndex)
+    return mUUIDSlots[existing].Entity;
+
+  if ((mUUIDCount + 1) * 2 > mUUIDSlots.size())
+    GrowUUIDTable();
+  const Uint mask = static_cast<Uint>(mUUIDSlots.size()) - 1;
+  Uint slot = static_cast<Uint>(HashUUIDWords(high, low)) & mask;
+  while (mUUIDSlots[slot].Entity.IsValid()) {
+    slot = (slot + 1) & mask;
+  }
+  mUUIDSlots[slot].High = high;
+  mUUIDSlots[slot].Low = low;
+  mUUIDSlots[slot].Entity = entity;
+  mUUIDCount++;
+
+  if (entity.Index >= mRecords.size())
+    mRecords.resize(entity.Index + 1);
+  Record& record = mRecords[entity.Index];
+  record.High = high;
+  record.Low = low;
+  record.Generation = entity.Generation;
+  record.bIndexed = true;
+  LinkName(entity, Intern(name));
+  return EntityHandle();
+}
+
+bool EntityIndex::Contains(EntityHandle entity) const
+{
+  return entity.Index < mRecords.size() && mRecords[entity.Index].bIndexed &&
+         mRecords[entity.Index].Generation == entity.Generation;
+}
+
+void EntityIndex::Remove(EntityHandle entity)
+{
+  if (!Contains(entity))
+    return;
+  Record& record = mRecords[entity.Index];
+  const Uint slot = FindUUIDSlot(record.High, record.Low);
+  if (slot != EntityHandle::sInvalidIndex && mUUIDSlots[slot].Entity == entity)
+    EraseUUIDSlot(slot);
+  UnlinkName(entity, record.Name);
+  record = Record();
+}
+
+void EntityIndex::Rename(EntityHandle entity, const String& name)
+{
+  if (!Contains(entity))
+    return;
+  const EntityNameId renamed = Intern(name);
+  const EntityNameId previous = mRecords[entity.Index].Name;
+  if (renamed == previous)
+    return;
+  UnlinkName(entity, previous);
+  LinkName(entity, renamed);
+}
+
+EntityHandle EntityIndex::FindByUUID(const uuid_t& uuid) const
+{
+  uint64_t high = 0, low = 0;
+  SplitUUID(uuid, &high, &low);
+  const Uint slot = FindUUIDSlot(high, low);
+  return slot != EntityHandle::sInvalidIndex ? mUUIDSlots[slot].Entity : EntityHandle();
+}
+
+EntityHandle EntityIndex::FindByName(const String& name) const
+{
+  const std::vector<EntityHandle>& entities = GetEntitiesNamed(name);
+  return entities.empty() ? EntityHandle() : entities.front();
+}
+
+const std::vector<EntityHandle>& EntityIndex::GetEntitiesNamed(const String& name) const
+{
+  const EntityNameId id = FindName(name);
+  return id != sInvalidName ? mEntitiesOfName[id] : sNoEntities;
+}
+
+Uint EntityRegistry::NextComponentTypeId()
+{
+  static Uint sNextId = 0;
+  return sNextId++;
+}
+
+EntityHandle EntityRegistry::Create()
+{
+  EntityHandle entity;
+  if (!mFreeIndices.empty()) {
+    entity.Index = mFreeIndices.back();
+    mFreeIndices.pop_back();
+  } else {
+    entity.Index = static_cast<Uint>(mGenerations.size());
+    mGenerations.push_back(0);
+    mComponentCounts.push_back(0);
+  }
+  entity.Generation = mGenerations[entity.Index];
+  mAliveCount++;
+  return entity;
+}
+
+void EntityRegistry::Destroy(EntityHandle entity)
+{
+  if (!IsAlive(entity))
+    return;
+
+  /* Without components the entity is freed here, otherwise removing the last one does it */
+  if (mComponentCounts[entity.Index] == 0) {
+    Free(entity);
+    return;
+  }
+  for (auto& pool : mPools) {
+    if (pool)
+      pool->Remove(entity);
+  }
+}
+
+void EntityRegistry::DestroyDeferred(EntityHandle entity)
+{
+  if (IsAlive(entity))
+    mPendingDestroy.push_back(entity);
+}
+
+Uint EntityRegistry::FlushDestroyed(std::vector<std::shared_ptr<void>>* released)
+{
+  if (mPendingDestroy.empty())
+    return 0;
+
+  mDestroyMarks.resize(mGenerations.size(), 0);
+  Uint destroyed = 0;
+  for (const EntityHandle& entity : mPendingDestroy) {
+    /* Destroyed some other way since it was recorded, the index may already belong to a new entity */
+    if (!IsAlive(entity) || mDestroyMarks[entity.Index] != 0)
+      continue;
+    if (mComponentCounts[entity.Index] == 0) {
+      Destroy(entity);
+    } else {
+      mDestroyMarks[entity.Index] = 1;
+    }
+    destroyed++;
+  }
+
+  for (auto& pool : mPools) {
+    if (pool)
+      pool->RemoveMarked(mDestroyMarks, released);
+  }
+
+  for (const EntityHandle& entity : mPendingDestroy) {
+    mDestroyMarks[entity.Index] = 0;
+  }
+  mPendingDestroy.clear();
+  return destroyed;
+}
+
+bool EntityRegistry::IsAlive(EntityHandle entity) const
+{
+  return entity.Index < mGenerations.size() && mGenerations[entity.Index] == entity.Generation;
+}
+
+void EntityRegistry::OnComponentAdded(EntityHandle entity)
+{
+  mComponentCounts[entity.Index]++;
+}
+
+void EntityRegistry::OnComponentRemoved(EntityHandle entity)
+{
+  if (--mComponentCounts[entity.Index] > 0)
+    return;
+  Free(entity);
+}
+
+void EntityRegistry::Free(EntityHandle entity)
+{
+  mIndex.Remove(entity);
+  mGenerations[entity.Index]++;
+  mFreeIndices.push_back(entity.Index);
+  mAliveCount--;
+}
@@ -0,0 +1,366 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+#include "Common/Utils/Utilities.h"
+
+namespace Yeager {
+
+class EntityRegistry;
+
+/**
+ * @brief Index of the entity plus the generation of its slot. The generation is incremented every time the entity is
+ * destroyed, a handle kept after that no longer matches and every lookup with it fails
+ */
+struct EntityHandle {
+  static YEAGER_CONSTEXPR Uint sInvalidIndex = std::numeric_limits<Uint>::max();
+
+  Uint Index = sInvalidIndex;
+  Uint Generation = 0;
+
+  YEAGER_NODISCARD bool IsValid() const { return Index != sInvalidIndex; }
+  bool operator==(const EntityHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+  bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+/** @brief Id of a interned name, names with the same text share the same id */
+typedef Uint EntityNameId;
+
+/**
+ * @brief Maps the UUID and the name of the scene entities to their handles. The UUIDs are kept as two 64 bits words and
+ * the names are interned, both tables use open addressing with linear probing, so every lookup is constant time and
+ * compares integers. The registry keeps it updated, a entity leaves the index when it is freed
+ */
+class EntityIndex {
+ public:
+  static YEAGER_CONSTEXPR EntityNameId sInvalidName = std::numeric_limits<EntityNameId>::max();
+
+  /**
+   * @brief Indexes the entity by its UUID and name. When the UUID already belongs to another entity nothing is indexed
+   * and that entity is returned, otherwise the returned handle is invalid
+   */
+  EntityHandle Insert(EntityHandle entity, const uuid_t& uuid, const String& name);
+  void Remove(EntityHandle entity);
+  void Rename(EntityHandle entity, const String& name);
+
+  YEAGER_NODISCARD EntityHandle FindByUUID(const uuid_t& uuid) const;
+  /** @brief First entity indexed with the name that is still in the index, names are not unique */
+  YEAGER_NODISCARD EntityHandle FindByName(const String& name) const;
+  /** @brief Every entity indexed with the name, empty when there is none */
+  YEAGER_NODISCARD const std::vector<EntityHandle>& GetEntitiesNamed(const String& name) const;
+  YEAGER_NODISCARD bool Contains(EntityHandle entity) const;
+
+  /** @brief Interned names are never freed, the same text always returns the same id */
+  EntityNameId Intern(const String& name);
+  YEAGER_NODISCARD EntityNameId FindName(const String& name) const;
+  YEAGER_NODISCARD const String& GetName(EntityNameId name) const { return mNames[name]; }
+
+  YEAGER_NODISCARD Uint GetEntityCount() const { return mUUIDCount; }
+
+ private:
+  struct UUIDSlot {
+    uint64_t High = 0;
+    uint64_t Low = 0;
+    /* Invalid when the slot is empty */
+    EntityHandle Entity;
+  };
+
+  struct Record {
+    uint64_t High = 0;
+    uint64_t Low = 0;
+    EntityNameId Name = sInvalidName;
+    Uint Generation = 0;
+    bool bIndexed = false;
+  };
+
+  static uint64_t HashUUIDWords(uint64_t high, uint64_t low);
+  static void SplitUUID(const uuid_t& uuid, uint64_t* high, uint64_t* low);
+  Uint FindUUIDSlot(uint64_t high, uint64_t low) const;
+  void GrowUUIDTable();
+  void EraseUUIDSlot(Uint slot);
+  void GrowNameTable();
+  void LinkName(EntityHandle entity, EntityNameId name);
+  void UnlinkName(EntityHandle entity, EntityNameId name);
+
+  /* Power of two sizes, kept at most half full so the probes stay short */
+  std::vector<UUIDSlot> mUUIDSlots;
+  Uint mUUIDCount = 0;
+  /* Each slot is the id of a name plus one, zero is empty */
+  std::vector<EntityNameId> mNameSlots;
+  std::vector<String> mNames;
+  std::vector<uint64_t> mNameHashes;
+  std::vector<std::vector<EntityHandle>> mEntitiesOfName;
+  /* Indexed by the entity index, what to remove when the entity is freed */
+  std::vector<Record> mRecords;
+};
+
+class ComponentPoolBase {
+ public:
+  virtual ~ComponentPoolBase() = default;
+  virtual bool Remove(EntityHandle entity) = 0;
+  YEAGER_NODISCARD virtual bool Contains(EntityHandle entity) const = 0;
+  /** @brief Removes the components of the entities with a non zero mark (by entity index), see RemoveIf */
+  virtual Uint RemoveMarked(const std::vector<unsigned char>& marks, std::vector<std::shared_ptr<void>>* released) = 0;
+};
+
+/**
+ * @brief Sparse set of components of a single type. The components are packed in a dense array that is iterated
+ * directly, and the sparse array maps the index of a entity to its position in the dense one, so insertion and lookup
+ * are constant time. Removal keeps the dense order, the scene and the explorer list the entities in insertion order.
+ * The components are polymorphic engine objects shared with the rest of the engine, the pool owns them through shared
+ * pointers kept apart from the dense array of raw pointers, so iterating never touches a reference count. Code keeping
+ * a component around should keep its EntityHandle, which stops matching once the component is removed
+ */
+template <typename T>
+class ComponentPool : public ComponentPoolBase {
+ public:
+  using Iterator = typename std::vector<T*>::iterator;
+  using ConstIterator = typename std::vector<T*>::const_iterator;
+
+  ComponentPool(EntityRegistry* registry) : mRegistry(registry) {}
+
+  /** @brief Returns false if the entity is not alive or already has a component of this type */
+  bool Insert(EntityHandle entity, const std::shared_ptr<T>& component);
+  bool Remove(EntityHandle entity) override;
+  /** @brief Removes the component at the position of the dense array, the components after it move back by one */
+  void RemoveAt(Uint position);
+  /**
+   * @brief Removes every component where pred(T*, EntityHandle) returns true in a single pass, the others are compacted
+   * keeping their order. The removed components are moved to released if given, otherwise they are destroyed after the
+   * pool is consistent again. Returns the amount removed
+   */
+  template <typename Pred>
+  Uint RemoveIf(Pred&& pred, std::vector<std::shared_ptr<void>>* released = YEAGER_NULLPTR);
+  Uint RemoveMarked(const std::vector<unsigned char>& marks, std::vector<std::shared_ptr<void>>* released) override;
+
+  YEAGER_NODISCARD bool Contains(EntityHandle entity) const override;
+  YEAGER_NODISCARD T* Get(EntityHandle entity) const;
+  YEAGER_NODISCARD EntityHandle GetEntity(Uint position) const { return mEntities[position]; }
+  YEAGER_NODISCARD const std::vector<EntityHandle>& GetEntities() const { return mEntities; }
+
+  /**
+   * The same names of the std::vector the scene used to return, the callers of the scene accessors stay the same.
+   * Entities and editor entities are inserted with their scene entity, everything else gets a new entity
+   */
+  void push_back(const std::shared_ptr<T>& component);
+  YEAGER_NODISCARD std::size_t size() const { return mComponents.size(); }
+  YEAGER_NODISCARD bool empty() const { return mComponents.empty(); }
+  const std::shared_ptr<T>& at(std::size_t position) const { return mOwners.at(position); }
+  const std::shared_ptr<T>& operator[](std::size_t position) const { return mOwners[position]; }
+  Iterator begin() { return mComponents.begin(); }
+  Iterator end() { return mComponents.end(); }
+  ConstIterator begin() const { return mComponents.begin(); }
+  ConstIterator end() const { return mComponents.end(); }
+
+ private:
+  static YEAGER_CONSTEXPR Uint sNotPresent = std::numeric_limits<Uint>::max();
+
+  EntityRegistry* mRegistry = YEAGER_NULLPTR;
+  /* Indexed by the entity index, position in the dense arrays or sNotPresent */
+  std::vector<Uint> mSparse;
+  std::vector<EntityHandle> mEntities;
+  std::vector<T*> mComponents;
+  /* Same order as the dense array, only touched when components are inserted or removed */
+  std::vector<std::shared_ptr<T>> mOwners;
+};
+
+/**
+ * @brief Hands out the entity handles of the scene and owns one component pool per type. A entity is alive while it has
+ * at least one component, removing the last one frees its index for reuse with the next generation
+ * @attention Not thread safe, the scene is only changed from the main thread
+ */
+class EntityRegistry {
+ public:
+  EntityRegistry() = default;
+
+  /** @brief The entity is freed as soon as its last component is removed, one without components never is */
+  EntityHandle Create();
+  /** @brief Removes every component of the entity, which frees it */
+  void Destroy(EntityHandle entity);
+  YEAGER_NODISCARD bool IsAlive(EntityHandle entity) const;
+
+  /** @brief Records the entity to be destroyed by the next FlushDestroyed, stale handles by then are ignored */
+  void DestroyDeferred(EntityHandle entity);
+  YEAGER_NODISCARD const std::vector<EntityHandle>& GetPendingDestroy() const { return mPendingDestroy; }
+  /**
+   * @brief Destroys every recorded entity with one pass per pool, instead of one removal per component. The components
+   * are moved to released if given, so their teardown can be spread over the next frames. Returns the amount destroyed
+   */
+  Uint FlushDestroyed(std::vector<std::shared_ptr<void>>* released = YEAGER_NULLPTR);
+
+  template <typename T>
+  ComponentPool<T>* GetPool()
+  {
+    const Uint type = ComponentTypeId<T>();
+    if (type >= mPools.size())
+      mPools.resize(type + 1);
+    if (!mPools[type])
+      mPools[type] = std::make_unique<ComponentPool<T>>(this);
+    return static_cast<ComponentPool<T>*>(mPools[type].get());
+  }
+
+  template <typename T>
+  YEAGER_NODISCARD T* Get(EntityHandle entity)
+  {
+    return GetPool<T>()->Get(entity);
+  }
+
+  YEAGER_NODISCARD Uint GetEntityCount() const { return mAliveCount; }
+
+  EntityIndex* GetIndex() { return &mIndex; }
+  const EntityIndex* GetIndex() const { return &mIndex; }
+
+ private:
+  template <typename T>
+  friend class ComponentPool;
+
+  static Uint NextComponentTypeId();
+  template <typename T>
+  static Uint ComponentTypeId()
+  {
+    static const Uint sId = NextComponentTypeId();
+    return sId;
+  }
+
+  void OnComponentAdded(EntityHandle entity);
+  void OnComponentRemoved(EntityHandle entity);
+  void Free(EntityHandle entity);
+
+  std::vector<Uint> mGenerations;
+  std::vector<Uint> mComponentCounts;
+  std::vector<Uint> mFreeIndices;
+  std::vector<EntityHandle> mPendingDestroy;
+  /* Indexed by the entity index, only set during FlushDestroyed */
+  std::vector<unsigned char> mDestroyMarks;
+  std::vector<std::unique_ptr<ComponentPoolBase>> mPools;
+  EntityIndex mIndex;
+  Uint mAliveCount = 0;
+};
+
+template <typename T>
+bool ComponentPool<T>::Insert(EntityHandle entity, const std::shared_ptr<T>& component)
+{
+  if (!mRegistry->IsAlive(entity) || Contains(entity))
+    return false;
+
+  if (entity.Index >= mSparse.size())
+    mSparse.resize(entity.Index + 1, sNotPresent);
+  mSparse[entity.Index] = static_cast<Uint>(mComponents.size());
+  mEntities.push_back(entity);
+  mComponents.push_back(component.get());
+  mOwners.push_back(component);
+  mRegistry->OnComponentAdded(entity);
+  return true;
+}
+
+template <typename T>
+bool ComponentPool<T>::Contains(EntityHandle entity) const
+{
+  return entity.Index < mSparse.size() && mSparse[entity.Index] != sNotPresent &&
+         mEntities[mSparse[entity.Index]] == entity;
+}
+
+template <typename T>
+T* ComponentPool<T>::Get(EntityHandle entity) const
+{
+  return Contains(entity) ? mComponents[mSparse[entity.Index]] : YEAGER_NULLPTR;
+}
+
+template <typename T>
+bool ComponentPool<T>::Remove(EntityHandle entity)
+{
+  if (!Contains(entity))
+    return false;
+  RemoveAt(mSparse[entity.Index]);
+  return true;
+}
+
+template <typename T>
+void ComponentPool<T>::RemoveAt(Uint position)
+{
+  const EntityHandle entity = mEntities[position];
+  /* Released at the end, its destructor finds the pool and the registry already consistent */
+  std::shared_ptr<T> removed = std::move(mOwners[position]);
+
+  mEntities.erase(mEntities.begin() + position);
+  mComponents.erase(mComponents.begin() + position);
+  mOwners.erase(mOwners.begin() + position);
+  for (Uint x = position; x < mEntities.size(); x++) {
+    mSparse[mEntities[x].Index] = x;
+  }
+  mSparse[entity.Index] = sNotPresent;
+  mRegistry->OnComponentRemoved(entity);
+}
+
+template <typename T>
+template <typename Pred>
+Uint ComponentPool<T>::RemoveIf(Pred&& pred, std::vector<std::shared_ptr<void>>* released)
+{
+  std::vector<std::shared_ptr<void>> destroyed;
+  std::vector<std::shared_ptr<void>>* sink = released != YEAGER_NULLPTR ? released : &destroyed;
+
+  Uint kept = 0;
+  const Uint count = static_cast<Uint>(mComponents.size());
+  for (Uint position = 0; position < count; position++) {
+    const EntityHandle entity = mEntities[position];
+    if (pred(mComponents[position], entity)) {
+      sink->push_back(std::move(mOwners[position]));
+      mSparse[entity.Index] = sNotPresent;
+      mRegistry->OnComponentRemoved(entity);
+      continue;
+    }
+    if (kept != position) {
+      mComponents[kept] = mComponents[position];
+      mOwners[kept] = std::move(mOwners[position]);
+      mEntities[kept] = entity;
+      mSparse[entity.Index] = kept;
+    }
+    kept++;
+  }
+  mComponents.resize(kept);
+  mOwners.resize(kept);
+  mEntities.resize(kept);
+  return count - kept;
+}
+
+template <typename T>
+Uint ComponentPool<T>::RemoveMarked(const std::vector<unsigned char>& marks,
+                                    std::vector<std::shared_ptr<void>>* released)
+{
+  return RemoveIf([&marks](T*, EntityHandle entity) { return marks[entity.Index] != 0; }, released);
+}
+
+template <typename T>
+void ComponentPool<T>::push_back(const std::shared_ptr<T>& component)
+{
+  EntityHandle entity;
+  if constexpr (requires(const T& value) { value.GetSceneEntity(); }) {
+    entity = component->GetSceneEntity();
+  }
+  if (!mRegistry->IsAlive(entity))
+    entity = mRegistry->Create();
+
+  if (!Insert(entity, component))
+    Yeager::Log(WARNING, "Component pool already has a component for the entity {}!", entity.Index);
+}
+
+}  // namespace Yeager
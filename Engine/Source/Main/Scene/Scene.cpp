@@ -198,56 +198,78 @@ std::vector<std::pair<String, String>> Scene::VerifySoundsOptionsInAssetFolder()
 void Scene::CheckDuplicatesLightSources()
 {
 
-  auto pos = CheckDuplicatesEntities<PhysicalLightHandle>(&m_LightSources);
+  ComponentPool<PhysicalLightHandle>* lights = GetLightSources();
+  auto pos = CheckDuplicatesEntities<PhysicalLightHandle>(lights);
   if (!pos.has_value())
     return;
   for (const auto& index : pos.value()) {
-    auto light = m_LightSources.at(index).get();
-
-    light->ScheduleDeletionOfPointLights();
-    m_LightSources.erase(m_LightSources.begin() + index);
-    for (auto& indexMinus : pos.value()) {
-      indexMinus--;
-    }
+    lights->at(index)->ScheduleDeletionOfPointLights();
   }
+  RemoveMarkedPositions(lights, pos.value());
+}
+
+void Scene::ScheduleDestroy(EntityHandle entity)
+{
+  m_Registry.DestroyDeferred(entity);
 }
 
 void Scene::CheckScheduleDeletions()
 {
-  for (Uint x = 0; x < m_Objects.size(); x++) {
-    Yeager::Object* obj = m_Objects.at(x).get();
-    if (obj->GetScheduleDeletion()) {
-      obj->GetToolbox()->SetScheduleDeletion(true);
-      m_Objects.erase(m_Objects.begin() + x);
+  if (!m_Registry.GetPendingDestroy().empty()) {
+    ComponentPool<Yeager::ToolboxHandle>* toolboxes = GetToolboxs();
+    ComponentPool<Yeager::Object>* objects = GetObjects();
+    ComponentPool<Yeager::AnimatedObject>* animated = GetAnimatedObject();
+    for (const EntityHandle& entity : m_Registry.GetPendingDestroy()) {
+      if (Yeager::ToolboxHandle* toolbox = toolboxes->Get(entity))
+        CheckToolboxIsSelectedAndDisable(toolbox);
+      /* The actors leave the PhysX scene now, only their memory waits for the release of the object */
+      if (Yeager::Object* object = objects->Get(entity); object && object->GetPhysXActor())
+        object->GetPhysXActor()->RemoveFromScene();
+      if (Yeager::AnimatedObject* object = animated->Get(entity); object && object->GetPhysXActor())
+        object->GetPhysXActor()->RemoveFromScene();
     }
-  }
 
-  for (Uint x = 0; x < m_AnimatedObject.size(); x++) {
-    Yeager::AnimatedObject* obj = m_AnimatedObject.at(x).get();
-    if (obj->GetScheduleDeletion()) {
-      obj->GetToolbox()->SetScheduleDeletion(true);
-      m_AnimatedObject.erase(m_AnimatedObject.begin() + x);
+    /* Every component of the entities leaves its pool here, keeping the order of the others */
+    std::vector<std::shared_ptr<void>> released;
+    m_Registry.FlushDestroyed(&released);
+    for (auto& component : released) {
+      m_PendingRelease.push_back(std::move(component));
     }
   }
 
   CheckToolboxesScheduleDeletions();
-
-  for (Uint x = 0; x < m_LightSources.size(); x++) {
-    Yeager::PhysicalLightHandle* light = m_LightSources.at(x).get();
-    if (light->GetScheduleDeletion()) {
-      m_LightSources.erase(m_LightSources.begin() + x);
-    }
-  }
 }
 
 void Scene::CheckToolboxesScheduleDeletions()
 {
-  for (Uint x = 0; x < m_Toolboxes.size(); x++) {
-    Yeager::ToolboxHandle* obj = m_Toolboxes.at(x).get();
-    if (obj->GetScheduleDeletion()) {
-      CheckToolboxIsSelectedAndDisable(obj);
-      m_Toolboxes.erase(m_Toolboxes.begin() + x);
-    }
+  /* Toolboxes flagged by the destructor of an entity that was never scheduled */
+  GetToolboxs()->RemoveIf([this](Yeager::ToolboxHandle* toolbox, EntityHandle) {
+    if (!toolbox->GetScheduleDeletion())
+      return false;
+    CheckToolboxIsSelectedAndDisable(toolbox);
+    return true;
+  });
+}
+
+void Scene::ReleaseDestroyed(const SceneReleaseBudget& budget)
+{
+  if (m_PendingRelease.empty())
+    return;
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto elapsed = [&start]() {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  Uint count = 0;
+  while (!m_PendingRelease.empty()) {
+    if (count > 0 && (count >= budget.Count || elapsed() >= budget.Milliseconds))
+      break;
+    /* Moved out first, the destructor may schedule other deletions */
+    std::shared_ptr<void> component = std::move(m_PendingRelease.front());
+    m_PendingRelease.pop_front();
+    component.reset();
+    count++;
   }
 }
 
@@ -296,6 +318,11 @@ String Scene::GetTextureCacheFolderPath() const
   return String(m_Context.ProjectFolderPath + YG_PS + "Cache" + YG_PS + "Texture");
 }
 
+String Scene::GetObjectCacheFolderPath() const
+{
+  return String(m_Context.ProjectFolderPath + YG_PS + "Cache" + YG_PS + "Object");
+}
+
 Scene::~Scene()
 {
   if (!m_SceneWasTerminated) {
@@ -306,6 +333,7 @@ Scene::~Scene()
 
 void Scene::Terminate()
 {
+  m_PendingRelease.clear();
   DeleteChildOf(m_RootNodeOfScene);
   m_PlayerCamera.reset();
   m_RootNodeOfScene.reset();
@@ -326,46 +354,42 @@ std::vector<std::pair<ImporterThreadedAnimated*, Yeager::AnimatedObject*>>* Scen
 void Scene::CheckAndAwaitThreadsToFinish()
 {
   Yeager::Log(INFO, "Awaiting threads to finish before closing the program");
-  for (Uint x = 0; x < m_ThreadImporters.size(); x++) {
-    std::pair<ImporterThreaded*, Yeager::Object*>* obj = &m_ThreadImporters.at(x);
-    if (obj->first->IsThreadFinish()) {
-      m_ThreadImporters.erase(m_ThreadImporters.begin() + x);
-    } else {
-      obj->first->GetThreadPtr()->join();
-      m_ThreadImporters.erase(m_ThreadImporters.begin() + x);
-    }
-  }
+  for (auto& obj : m_ThreadImporters)
+    obj.first->WaitThread();
+  m_ThreadImporters.clear();
 
-  for (Uint x = 0; x < m_ThreadAnimatedImporters.size(); x++) {
-    std::pair<ImporterThreadedAnimated*, Yeager::AnimatedObject*>* obj = &m_ThreadAnimatedImporters.at(x);
-    if (obj->first->IsThreadFinish()) {
-      m_ThreadAnimatedImporters.erase(m_ThreadAnimatedImporters.begin() + x);
-    } else {
-      obj->first->GetThreadPtr()->join();
-      m_ThreadAnimatedImporters.erase(m_ThreadAnimatedImporters.begin() + x);
-    }
-  }
+  for (auto& obj : m_ThreadAnimatedImporters)
+    obj.first->WaitThread();
+  m_ThreadAnimatedImporters.clear();
 }
 
 void Scene::CheckThreadsAndTriggerActions()
 {
   try {
-    for (Uint x = 0; x < m_ThreadImporters.size(); x++) {
-      std::pair<ImporterThreaded*, Yeager::Object*>* obj = &m_ThreadImporters.at(x);
-      if (obj->first->IsThreadFinish()) {
-        Yeager::Log(INFO, "Object importer thread {} has finished! Detaching", obj->second->GetName());
-        obj->second->ThreadSetup();
-        m_ThreadImporters.erase(m_ThreadImporters.begin() + x);
-      }
+    /* Collected in one pass, erasing in the loop skipped the importer after each finished one */
+    std::vector<Yeager::Object*> finished;
+    std::erase_if(m_ThreadImporters, [&finished](const std::pair<ImporterThreaded*, Yeager::Object*>& obj) {
+      if (!obj.first->IsThreadFinish())
+        return false;
+      finished.push_back(obj.second);
+      return true;
+    });
+    for (Yeager::Object* obj : finished) {
+      Yeager::Log(INFO, "Object importer thread {} has finished! Detaching", obj->GetName());
+      obj->ThreadSetup();
     }
 
-    for (Uint x = 0; x < m_ThreadAnimatedImporters.size(); x++) {
-      std::pair<ImporterThreadedAnimated*, Yeager::AnimatedObject*>* obj = &m_ThreadAnimatedImporters.at(x);
-      if (obj->first->IsThreadFinish()) {
-        Yeager::Log(INFO, "Object importer thread {} has finished! Detaching", obj->second->GetName());
-        obj->second->ThreadSetup();
-        m_ThreadAnimatedImporters.erase(m_ThreadAnimatedImporters.begin() + x);
-      }
+    std::vector<Yeager::AnimatedObject*> finishedAnimated;
+    std::erase_if(m_ThreadAnimatedImporters,
+                  [&finishedAnimated](const std::pair<ImporterThreadedAnimated*, Yeager::AnimatedObject*>& obj) {
+                    if (!obj.first->IsThreadFinish())
+                      return false;
+                    finishedAnimated.push_back(obj.second);
+                    return true;
+                  });
+    for (Yeager::AnimatedObject* obj : finishedAnimated) {
+      Yeager::Log(INFO, "Object importer thread {} has finished! Detaching", obj->GetName());
+      obj->ThreadSetup();
     }
 
   } catch (std::exception e) {
@@ -402,31 +426,31 @@ void Scene::SetContextRenderer(SceneRenderer renderer)
   m_Context.ProjectSceneRenderer = renderer;
 }
 
-std::vector<std::shared_ptr<Yeager::Audio3DHandle>>* Scene::GetAudios3D()
+ComponentPool<Yeager::Audio3DHandle>* Scene::GetAudios3D()
 {
-  return &m_Audios3D;
+  return m_Registry.GetPool<Yeager::Audio3DHandle>();
 }
-std::vector<std::shared_ptr<Yeager::AudioHandle>>* Scene::GetAudios()
+ComponentPool<Yeager::AudioHandle>* Scene::GetAudios()
 {
-  return &m_Audios;
+  return m_Registry.GetPool<Yeager::AudioHandle>();
 }
 
-std::vector<std::shared_ptr<ToolboxHandle>>* Scene::GetToolboxs()
+ComponentPool<ToolboxHandle>* Scene::GetToolboxs()
 {
-  return &m_Toolboxes;
+  return m_Registry.GetPool<ToolboxHandle>();
 }
 
-std::vector<std::shared_ptr<Yeager::Object>>* Scene::GetObjects()
+ComponentPool<Yeager::Object>* Scene::GetObjects()
 {
-  return &m_Objects;
+  return m_Registry.GetPool<Yeager::Object>();
 }
 
-std::vector<std::shared_ptr<Yeager::AnimatedObject>>* Scene::GetAnimatedObject()
+ComponentPool<Yeager::AnimatedObject>* Scene::GetAnimatedObject()
 {
-  return &m_AnimatedObject;
+  return m_Registry.GetPool<Yeager::AnimatedObject>();
 }
 
-std::vector<std::shared_ptr<Yeager::PhysicalLightHandle>>* Scene::GetLightSources()
+ComponentPool<Yeager::PhysicalLightHandle>* Scene::GetLightSources()
 {
-  return &m_LightSources;
+  return m_Registry.GetPool<Yeager::PhysicalLightHandle>();
 }
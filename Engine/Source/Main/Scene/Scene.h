@@ -20,6 +20,7 @@
 #pragma once
 
 #include <algorithm>
+#include <deque>
 #include "Common/Utils/Common.h"
 #include "Common/Utils/LogEngine.h"
 #include "Common/Utils/Utilities.h"
@@ -31,6 +32,7 @@
 #include "Editor/UI/ToolboxObj.h"
 #include "Editor/Utils/NodeHierarchy.h"
 #include "Main/IO/Serialization.h"
+#include "Main/Scene/EntityRegistry.h"
 
 namespace Yeager {
 
@@ -56,6 +58,13 @@ struct SceneContext {
   TimePointType TimeOfCreation;
 };
 
+/* How many destroyed entities the scene releases each frame. The first one of a frame is always released, so the queue
+always drains */
+struct SceneReleaseBudget {
+  Uint Count = 256;
+  float Milliseconds = 1.0f;
+};
+
 static SceneContext InitializeContext(String name, String author, SceneType type, String folderPath,
                                       SceneRenderer renderer, TimePointType dateOfCreation);
 
@@ -87,14 +96,23 @@ class Scene {
   String GetAssetsPath() { return m_AssetsFolderPath; }
 
   /**
-   *  Scene Objects and Entities (Everything that is stored where is going to be saved) 
+   *  Scene Objects and Entities (Everything that is stored where is going to be saved). Each accessor is the component
+   *  pool of the type in the entity registry, a editor entity and its toolbox share the same entity handle
    */
-  VecSharedPtr<Yeager::Audio3DHandle>* GetAudios3D();
-  VecSharedPtr<Yeager::AudioHandle>* GetAudios();
-  VecSharedPtr<Yeager::Object>* GetObjects();
-  VecSharedPtr<ToolboxHandle>* GetToolboxs();
-  VecSharedPtr<Yeager::AnimatedObject>* GetAnimatedObject();
-  VecSharedPtr<Yeager::PhysicalLightHandle>* GetLightSources();
+  ComponentPool<Yeager::Audio3DHandle>* GetAudios3D();
+  ComponentPool<Yeager::AudioHandle>* GetAudios();
+  ComponentPool<Yeager::Object>* GetObjects();
+  ComponentPool<ToolboxHandle>* GetToolboxs();
+  ComponentPool<Yeager::AnimatedObject>* GetAnimatedObject();
+  ComponentPool<Yeager::PhysicalLightHandle>* GetLightSources();
+
+  EntityRegistry* GetRegistry() { return &m_Registry; }
+  /** @brief Constant time lookups of the scene entities, the handle is invalid when nothing matches */
+  EntityHandle FindEntityByUUID(const uuid_t& uuid) const { return m_Registry.GetIndex()->FindByUUID(uuid); }
+  EntityHandle FindEntityByName(const String& name) const { return m_Registry.GetIndex()->FindByName(name); }
+
+  /* Bounding volume hierarchy with the objects of the scene, used for the frustum culling */
+  std::shared_ptr<AABBTree> GetCullingTree() { return m_CullingTree; }
 
   VecPair<ImporterThreaded*, Yeager::Object*>* GetThreadImporters();
   VecPair<ImporterThreadedAnimated*, Yeager::AnimatedObject*>* GetThreadAnimatedImporters();
@@ -102,49 +120,65 @@ class Scene {
 
   void CheckAndAwaitThreadsToFinish();
 
+  /**
+   * @brief Removes every entity scheduled for deletion since the last call from the scene pools, in one pass per pool.
+   * Their PhysX actors leave the PhysX scene here, so they stop colliding this frame, everything else about the removed
+   * entities is only released by ReleaseDestroyed. Called after the step is fetched
+   */
   void CheckScheduleDeletions();
   void CheckToolboxesScheduleDeletions();
+  /** @brief Records the entity to be removed by the next CheckScheduleDeletions */
+  void ScheduleDestroy(EntityHandle entity);
+  /** @brief Releases the entities removed by CheckScheduleDeletions, oldest first, until the budget is spent */
+  void ReleaseDestroyed(const SceneReleaseBudget& budget);
+  YEAGER_NODISCARD Uint GetPendingReleaseCount() const { return static_cast<Uint>(m_PendingRelease.size()); }
 
-  /* Check for duplicate elements in the vector and returns the positions of the duplicates */
+  /**
+   * Check for duplicate entities in the pool and returns their positions. A entity is a duplicate when its UUID is
+   * indexed for another entity, the one created first is kept
+   */
   template <typename Type>
-  std::optional<std::vector<size_t>> CheckDuplicatesEntities(VecSharedPtr<Type>* vec)
+  std::optional<std::vector<size_t>> CheckDuplicatesEntities(ComponentPool<Type>* vec)
   {
     if (vec->empty() || vec->size() == 1)
       return std::nullopt;
-    /* Check if the template type have a operator== declared */
-    if (!Yeager::CHECK::EqualExists<Type>::value) {
-      Yeager::LogDebug(WARNING, "Check for Duplicates Entities, class type does not have equal operator!");
-      return std::nullopt;
-    }
-    Yeager::LogDebug(INFO, "Check for Duplicates Entities, class type have a equal operator!");
-    std::vector<size_t> QueueToDeletion;
 
-    /* Find duplicates, the right most element of the vector is the choosen one to delete */
-    int index_cmp = 1;
+    const EntityIndex* index = m_Registry.GetIndex();
+    std::vector<size_t> QueueToDeletion;
     for (Uint x = 0; x < vec->size(); x++) {
-      for (Uint y = index_cmp; y < vec->size(); y++) {
-        Type* obj1 = vec->at(x).get();
-        Type* obj2 = vec->at(y).get();
-        if (obj1 == obj2)
-          QueueToDeletion.push_back(y);
-      }
+      const EntityHandle indexed = index->FindByUUID(vec->at(x)->GetEntityUUID());
+      if (indexed.IsValid() && indexed != vec->GetEntity(x))
+        QueueToDeletion.push_back(x);
     }
 
+    if (QueueToDeletion.empty())
+      return std::nullopt;
     return QueueToDeletion;
   }
 
-  /* Attention using this function, it only removes the element for the vector, it does not handle the proper deletion of 
+  /* Attention using this function, it only removes the element for the pool, it does not handle the proper deletion of 
   objects and entities in the engine! */
   template <typename Type>
-  void DeleteDuplicatesEntities(VecSharedPtr<Type>* vec)
+  void DeleteDuplicatesEntities(ComponentPool<Type>* vec)
+  {
+    std::optional<std::vector<size_t>> pos = CheckDuplicatesEntities(vec);
+    if (!pos.has_value())
+      return;
+    RemoveMarkedPositions(vec, pos.value());
+  }
+
+  /* Removes the components at the positions in a single pass, marked by entity index as FlushDestroyed does */
+  template <typename Type>
+  static void RemoveMarkedPositions(ComponentPool<Type>* vec, const std::vector<size_t>& positions)
   {
-    std::vector<size_t> pos = CheckDuplicatesEntities(vec);
-    for (const auto& index : pos) {
-      vec->erase(vec->begin() + index);
-      for (auto& index : pos) {
-        index--;
-      }
+    std::vector<unsigned char> marks;
+    for (const size_t position : positions) {
+      const EntityHandle entity = vec->GetEntity(position);
+      if (entity.Index >= marks.size())
+        marks.resize(entity.Index + 1, 0);
+      marks[entity.Index] = 1;
     }
+    vec->RemoveIf([&marks](Type*, EntityHandle entity) { return entity.Index < marks.size() && marks[entity.Index]; });
   }
 
   void CheckDuplicatesLightSources();
@@ -157,7 +191,7 @@ class Scene {
 
   std::shared_ptr<PlayerCamera> GetPlayerCamera() { return m_PlayerCamera; }
 
-  std::vector<std::shared_ptr<NodeComponent>>* GetNodeHierarchy() { return &m_NodeHierarchy; }
+  ComponentPool<NodeComponent>* GetNodeHierarchy() { return m_Registry.GetPool<NodeComponent>(); }
 
   YEAGER_FORCE_INLINE constexpr bool SceneContainsRootNode() const { return m_SceneContainsRootNode; }
   std::shared_ptr<NodeComponent> GetRootNode() { return m_RootNodeOfScene; }
@@ -171,6 +205,7 @@ class Scene {
   }
 
   String GetTextureCacheFolderPath() const;
+  String GetObjectCacheFolderPath() const;
 
   void BuildSceneFromTemplate(const TemplateHandle& handle);
 
@@ -207,12 +242,10 @@ class Scene {
   VecPair<ImporterThreaded*, Yeager::Object*> m_ThreadImporters;
   VecPair<ImporterThreadedAnimated*, Yeager::AnimatedObject*> m_ThreadAnimatedImporters;
 
-  VecSharedPtr<Yeager::Audio3DHandle> m_Audios3D;
-  VecSharedPtr<Yeager::AudioHandle> m_Audios;
-  VecSharedPtr<Yeager::Object> m_Objects;
-  VecSharedPtr<Yeager::AnimatedObject> m_AnimatedObject;
-  VecSharedPtr<Yeager::ToolboxHandle> m_Toolboxes;
-  VecSharedPtr<Yeager::PhysicalLightHandle> m_LightSources;
-  std::vector<std::shared_ptr<NodeComponent>> m_NodeHierarchy;
+  std::shared_ptr<AABBTree> m_CullingTree = BaseAllocator::MakeSharedPtr<AABBTree>();
+  /* Objects, animated objects, audios, toolboxes, light sources and nodes, one component pool each */
+  EntityRegistry m_Registry;
+  /* Components already out of every pool, their destructors free OpenGL and PhysX memory so they run over frames */
+  std::deque<std::shared_ptr<void>> m_PendingRelease;
 };
 }  // namespace Yeager
@@ -0,0 +1,69 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Common/Math/AABBTree.h"
+
+#include <random>
+using namespace Yeager;
+
+/**
+ * 50k boxes in a cube of 1000 units, culled against the view frustum of a camera at the center, with a narrow and a
+ * wide field of view. The scene tested the frustum against the box of every object, the tree only against the nodes
+ * that are partially inside
+ */
+YEAGER_BENCHMARK(AABBTree)
+{
+  static YEAGER_CONSTEXPR Uint sCount = 50000;
+  std::mt19937 random(4);
+  std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+  std::uniform_real_distribution<float> size(0.5f, 3.0f);
+  std::uniform_real_distribution<float> offset(-0.05f, 0.05f);
+
+  std::vector<AABB> boxes;
+  boxes.reserve(sCount);
+  for (Uint x = 0; x < sCount; x++) {
+    const Vector3 center(position(random), position(random), position(random));
+    boxes.push_back(AABB(center - Vector3(size(random)), center + Vector3(size(random))));
+  }
+
+  AABBTree tree;
+  std::vector<int> proxies(sCount);
+  Benchmark::ReportResult("AABBTree::CreateProxy", sCount, Benchmark::MeasureMilliseconds(1, [&] {
+                            for (Uint x = 0; x < sCount; x++)
+                              proxies[x] = tree.CreateProxy(boxes[x], reinterpret_cast<void*>(std::size_t(x) + 1));
+                          }));
+
+  /* Small moves every frame, most stay inside their fat box and never touch the tree */
+  std::vector<AABB> moved(boxes);
+  Benchmark::ReportResult("AABBTree::MoveProxy, small moves", sCount, Benchmark::MeasureMilliseconds(5, [&] {
+                            Uint reinserted = 0;
+                            for (Uint x = 0; x < sCount; x++) {
+                              const Vector3 move(offset(random), offset(random), offset(random));
+                              moved[x] = AABB(moved[x].Min + move, moved[x].Max + move);
+                              reinserted += tree.MoveProxy(proxies[x], moved[x]);
+                            }
+                            Benchmark::KeepValue(reinserted);
+                          }));
+
+  for (const float fov : {45.0f, 90.0f}) {
+    const Matrix4 projection = glm::perspective(glm::radians(fov), 16.0f / 9.0f, 0.1f, 1000.0f);
+    const Matrix4 view = glm::lookAt(Vector3(0.0f), Vector3(1.0f, 0.2f, 0.5f), Vector3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum = Frustum::FromMatrix(projection * view);
+
+    Uint visible = 0;
+    const double bruteForce = Benchmark::MeasureMilliseconds(20, [&] {
+      visible = 0;
+      for (const AABB& box : moved)
+        visible += frustum.Intersects(box);
+      Benchmark::KeepValue(visible);
+    });
+    Benchmark::ReportResult(fmt::format("fov {}: brute force frustum loop, {} visible", fov, visible), sCount,
+                            bruteForce);
+
+    Uint reported = 0;
+    const double query = Benchmark::MeasureMilliseconds(20, [&] {
+      reported = 0;
+      tree.QueryFrustum(frustum, [&reported](void*) { reported++; });
+      Benchmark::KeepValue(reported);
+    });
+    Benchmark::ReportResult(fmt::format("fov {}: AABBTree::QueryFrustum, {} reported", fov, reported), sCount, query);
+  }
+}
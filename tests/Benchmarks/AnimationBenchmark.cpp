@@ -0,0 +1,185 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Components/Renderer/AnimationEngine/Skeleton.h"
+
+#include <random>
+using namespace Yeager;
+
+/* The node tree and the bone map the animations kept before the skeleton was compiled */
+struct ReferenceNode {
+  Matrix4 Transformation = Matrix4(1.0f);
+  String Name = YEAGER_NULL_LITERAL;
+  std::vector<ReferenceNode> Children;
+};
+
+struct ReferenceBoneInfo {
+  int ID = -1;
+  Matrix4 OffSet = Matrix4(1.0f);
+};
+
+struct BenchmarkSkeleton {
+  ReferenceNode Root;
+  std::map<String, ReferenceBoneInfo> BoneInfoMap;
+  CompiledSkeleton Skeleton;
+  std::vector<Bone> Bones;
+};
+
+static YEAGER_CONSTEXPR Uint sMaxBones = 100;
+
+static Matrix4 RandomTransform(std::mt19937& random)
+{
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  const glm::quat rotation = glm::normalize(glm::quat(value(random), value(random), value(random), value(random)));
+  Matrix4 transform = glm::toMat4(rotation);
+  transform[3] = Vector4(value(random), value(random), value(random), 1.0f);
+  return transform;
+}
+
+static Bone MakeBone(const String& name, int id, std::mt19937& random, Uint keys)
+{
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  std::vector<KeyPosition> positions;
+  std::vector<KeyRotation> rotations;
+  std::vector<KeyScale> scales;
+  for (Uint x = 0; x < keys; x++) {
+    const float time = static_cast<float>(x);
+    positions.push_back(KeyPosition{Vector3(value(random), value(random), value(random)), time});
+    rotations.push_back(KeyRotation{
+        glm::normalize(glm::quat(value(random), value(random), value(random), value(random))), time});
+    scales.push_back(KeyScale{Vector3(1.0f + value(random) * 0.1f), time});
+  }
+  return Bone(name, id, std::move(positions), std::move(rotations), std::move(scales));
+}
+
+/* Same order as Animation::CompileSkeletonNode, parents before their children */
+static void CompileNode(BenchmarkSkeleton& skeleton, const ReferenceNode& node, int parent)
+{
+  const int index = static_cast<int>(skeleton.Skeleton.GetNodeCount());
+  int channel = -1;
+  for (std::size_t x = 0; x < skeleton.Bones.size() && channel < 0; x++) {
+    if (skeleton.Bones[x].GetBoneName() == node.Name)
+      channel = static_cast<int>(x);
+  }
+  const auto info = skeleton.BoneInfoMap.find(node.Name);
+
+  skeleton.Skeleton.ParentIndices.push_back(parent);
+  skeleton.Skeleton.ChannelIndices.push_back(channel);
+  skeleton.Skeleton.BoneIndices.push_back(info != skeleton.BoneInfoMap.end() ? info->second.ID : -1);
+  skeleton.Skeleton.BindTransforms.push_back(node.Transformation);
+  skeleton.Skeleton.BoneOffsets.push_back(info != skeleton.BoneInfoMap.end() ? info->second.OffSet : Matrix4(1.0f));
+  for (const auto& child : node.Children) {
+    CompileNode(skeleton, child, index);
+  }
+}
+
+/**
+ * A tree of the given amount of nodes, each one the child of a random node built before it. Every node but the root and
+ * the last few is skinned, and most of the skinned ones are driven by a channel of the animation
+ */
+static BenchmarkSkeleton MakeSkeleton(std::mt19937& random, Uint nodes, Uint keys)
+{
+  BenchmarkSkeleton skeleton;
+  skeleton.Root.Name = "Node0";
+  skeleton.Root.Transformation = RandomTransform(random);
+
+  std::vector<std::vector<Uint>> path(1);
+  for (Uint x = 1; x < nodes; x++) {
+    const Uint parent = random() % x;
+    ReferenceNode* node = &skeleton.Root;
+    for (const Uint child : path[parent])
+      node = &node->Children[child];
+
+    ReferenceNode child;
+    child.Name = "Node" + std::to_string(x);
+    child.Transformation = RandomTransform(random);
+    node->Children.push_back(child);
+    path.push_back(path[parent]);
+    path.back().push_back(static_cast<Uint>(node->Children.size() - 1));
+
+    if (x + 4 < nodes) {
+      const int id = static_cast<int>(skeleton.BoneInfoMap.size());
+      skeleton.BoneInfoMap[child.Name] = ReferenceBoneInfo{id, RandomTransform(random)};
+      if (x % 8 != 0)
+        skeleton.Bones.push_back(MakeBone(child.Name, id, random, keys));
+    }
+  }
+  CompileNode(skeleton, skeleton.Root, -1);
+  return skeleton;
+}
+
+static Bone* FindBone(std::vector<Bone>& bones, const String& name)
+{
+  auto iter = std::find_if(bones.begin(), bones.end(), [&](Bone& bone) { return bone.GetBoneName() == name; });
+  return iter == bones.end() ? YEAGER_NULLPTR : &(*iter);
+}
+
+/* The recursion of AnimationEngine::CalculateBoneTransform before the compiled skeleton, the bone map copy included */
+static void ReferenceBoneTransform(BenchmarkSkeleton& skeleton, const ReferenceNode* node, Matrix4 parentTrans,
+                                   float time, std::vector<Matrix4>& finalMatrices)
+{
+  String nodeName = node->Name;
+  Matrix4 nodeTransform = node->Transformation;
+  Bone* bone = FindBone(skeleton.Bones, nodeName);
+  if (bone) {
+    bone->Update(time);
+    nodeTransform = bone->GetLocalTransform();
+  }
+
+  Matrix4 globalTransformation = parentTrans * nodeTransform;
+  auto boneInfoMap = skeleton.BoneInfoMap;
+  if (boneInfoMap.find(nodeName) != boneInfoMap.end()) {
+    int index = boneInfoMap[nodeName].ID;
+    Matrix4 offset = boneInfoMap[nodeName].OffSet;
+    finalMatrices[index] = globalTransformation * offset;
+  }
+
+  for (const auto& child : node->Children) {
+    ReferenceBoneTransform(skeleton, &child, globalTransformation, time, finalMatrices);
+  }
+}
+
+/**
+ * 1000 skeletons of 64 nodes evaluated once per frame, as many animated objects would be. The recursion looked the bone
+ * of every node up by name and copied the whole bone map at each node, the compiled skeleton is a single loop over
+ * arrays with a global transforms buffer kept between frames
+ */
+YEAGER_BENCHMARK(AnimationSkeleton)
+{
+  static YEAGER_CONSTEXPR Uint sSkeletons = 1000;
+  static YEAGER_CONSTEXPR Uint sNodes = 64;
+  static YEAGER_CONSTEXPR Uint sKeys = 60;
+  static YEAGER_CONSTEXPR Uint sFrames = 10;
+
+  std::mt19937 random(12);
+  std::vector<BenchmarkSkeleton> skeletons;
+  skeletons.reserve(sSkeletons);
+  for (Uint x = 0; x < sSkeletons; x++) {
+    skeletons.push_back(MakeSkeleton(random, sNodes, sKeys));
+  }
+
+  std::vector<std::vector<Matrix4>> referenceMatrices(sSkeletons, std::vector<Matrix4>(sMaxBones, Matrix4(1.0f)));
+  std::vector<std::vector<Matrix4>> compiledMatrices(sSkeletons, std::vector<Matrix4>(sMaxBones, Matrix4(1.0f)));
+  std::vector<Matrix4> globalTransforms;
+
+  /* The frames advance a third of a key, so the cursors of the bones move as in a playing animation */
+  float time = 0.0f;
+  const double reference = Benchmark::MeasureMilliseconds(sFrames, [&] {
+    time = std::fmod(time + 0.33f, static_cast<float>(sKeys - 1));
+    for (Uint x = 0; x < sSkeletons; x++)
+      ReferenceBoneTransform(skeletons[x], &skeletons[x].Root, Matrix4(1.0f), time, referenceMatrices[x]);
+    Benchmark::KeepValue(referenceMatrices.back()[0]);
+  });
+  Benchmark::ReportResult("recursive node tree, bone map copied per node", sSkeletons, reference);
+
+  time = 0.0f;
+  const double compiled = Benchmark::MeasureMilliseconds(sFrames, [&] {
+    time = std::fmod(time + 0.33f, static_cast<float>(sKeys - 1));
+    for (Uint x = 0; x < sSkeletons; x++)
+      EvaluateSkeleton(skeletons[x].Skeleton, skeletons[x].Bones, time, globalTransforms, compiledMatrices[x]);
+    Benchmark::KeepValue(compiledMatrices.back()[0]);
+  });
+  Benchmark::ReportResult("EvaluateSkeleton, compiled skeleton", sSkeletons, compiled);
+
+  /* Both ran the same frames, the last one must have left the same matrices */
+  if (referenceMatrices != compiledMatrices)
+    Yeager::Log(ERROR, "The compiled skeleton evaluation differs from the recursive one");
+}
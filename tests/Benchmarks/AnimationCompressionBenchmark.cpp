@@ -0,0 +1,80 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Components/Renderer/AnimationEngine/AnimationCompression.h"
+
+#include <random>
+using namespace Yeager;
+
+/* A baked clip, every bone keyed on every tick, with the noise of a motion capture on top of smooth curves */
+static Bone MakeChannel(const String& name, std::mt19937& random, Uint frames)
+{
+  std::uniform_real_distribution<float> value(0.5f, 3.0f);
+  std::uniform_real_distribution<float> noise(-0.0002f, 0.0002f);
+  const float speed = value(random), phase = value(random);
+  const Vector3 axis = glm::normalize(Vector3(1.0f, phase, 0.5f));
+
+  std::vector<KeyPosition> positions;
+  std::vector<KeyRotation> rotations;
+  std::vector<KeyScale> scales;
+  for (Uint x = 0; x < frames; x++) {
+    const float time = static_cast<float>(x);
+    const float seconds = time / 30.0f;
+    positions.push_back(KeyPosition{
+        Vector3(std::sin(seconds * speed) + noise(random), std::cos(seconds * speed * 0.5f), phase), time});
+    const float angle = std::sin(seconds * speed + phase) * 1.5f + noise(random);
+    rotations.push_back(KeyRotation{
+        glm::quat(std::cos(angle * 0.5f), axis.x * std::sin(angle * 0.5f), axis.y * std::sin(angle * 0.5f),
+                  axis.z * std::sin(angle * 0.5f)),
+        time});
+    scales.push_back(KeyScale{Vector3(1.0f), time});
+  }
+  return Bone(name, -1, std::move(positions), std::move(rotations), std::move(scales));
+}
+
+/**
+ * A clip of 60 bones and 601 frames compressed with the default tolerances and decoded back into the keys the bones
+ * sample. The ratio compares the float keys with the reduced and quantized ones, and a 100k keys track that the
+ * interpolation reproduces end to end shows the reduction stays linear in the keys
+ */
+YEAGER_BENCHMARK(AnimationCompression)
+{
+  static YEAGER_CONSTEXPR Uint sBones = 60;
+  static YEAGER_CONSTEXPR Uint sFrames = 601;
+
+  std::mt19937 random(6);
+  std::vector<Bone> channels;
+  for (Uint x = 0; x < sBones; x++) {
+    channels.push_back(MakeChannel("Bone" + std::to_string(x), random, sFrames));
+  }
+  const std::size_t sourceKeys = std::size_t(sBones) * sFrames * 3;
+  const std::size_t sourceBytes =
+      std::size_t(sBones) * sFrames * (sizeof(KeyPosition) + sizeof(KeyRotation) + sizeof(KeyScale));
+
+  CompressedAnimationClip clip;
+  const double compress = Benchmark::MeasureMilliseconds(3, [&] {
+    clip = CompressAnimationClip("Clip", static_cast<float>(sFrames - 1), 30, channels, AnimationCompressionSettings());
+  });
+  Benchmark::ReportResult(fmt::format("CompressAnimationClip, {} into {} keys, {} into {} bytes, {:.1f}x", sourceKeys,
+                                      clip.GetKeyCount(), sourceBytes, clip.GetKeyBytes(),
+                                      static_cast<double>(sourceBytes) / clip.GetKeyBytes()),
+                          sourceKeys, compress);
+
+  std::vector<KeyPosition> positions;
+  std::vector<KeyRotation> rotations;
+  std::vector<KeyScale> scales;
+  const double decompress = Benchmark::MeasureMilliseconds(20, [&] {
+    for (const CompressedBoneTrack& track : clip.Tracks) {
+      DecompressBoneTrack(clip, track, positions, rotations, scales);
+      Benchmark::KeepValue(positions.data());
+    }
+  });
+  Benchmark::ReportResult(fmt::format("DecompressBoneTrack, {:.1f}M keys/s", clip.GetKeyCount() / decompress / 1000.0),
+                          clip.GetKeyCount(), decompress);
+
+  std::vector<KeyPosition> linear;
+  for (Uint x = 0; x < 100000; x++) {
+    linear.push_back(KeyPosition{Vector3(x * 0.001f, 0.0f, 0.0f), static_cast<float>(x)});
+  }
+  std::size_t kept = 0;
+  const double reduce = Benchmark::MeasureMilliseconds(3, [&] { kept = ReducePositionKeys(linear, 0.0005f).size(); });
+  Benchmark::ReportResult(fmt::format("ReducePositionKeys, linear track, {} kept", kept), linear.size(), reduce);
+}
@@ -0,0 +1,60 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Components/Renderer/AnimationEngine/Bone.h"
+
+#include <random>
+using namespace Yeager;
+
+/* The search the bones did before the cursors, from the first key on every sample */
+static int LinearKeyIndex(const std::vector<KeyRotation>& keys, float time)
+{
+  for (int x = 0; x < static_cast<int>(keys.size()) - 1; x++) {
+    if (time < keys[x + 1].TimeStamp)
+      return x;
+  }
+  return static_cast<int>(keys.size()) - 2;
+}
+
+/**
+ * A track of 10k keys sampled 100k times, as a long clip played back at a third of a key per frame, and as random seeks
+ * over the whole track where the cursor falls back to the binary search
+ */
+YEAGER_BENCHMARK(BoneKeySearch)
+{
+  static YEAGER_CONSTEXPR Uint sKeys = 10000;
+  static YEAGER_CONSTEXPR Uint sSamples = 100000;
+
+  std::vector<KeyRotation> keys(sKeys);
+  for (Uint x = 0; x < sKeys; x++) {
+    keys[x] = KeyRotation{glm::quat(1.0f, 0.0f, 0.0f, 0.0f), static_cast<float>(x)};
+  }
+
+  std::vector<float> playback(sSamples);
+  for (Uint x = 0; x < sSamples; x++) {
+    playback[x] = std::fmod(x * 0.33f, static_cast<float>(sKeys));
+  }
+  std::mt19937 random(10);
+  std::uniform_real_distribution<float> seek(0.0f, static_cast<float>(sKeys));
+  std::vector<float> seeks(sSamples);
+  for (float& time : seeks) {
+    time = seek(random);
+  }
+
+  for (const auto& [label, times] : {std::pair<Cchar, const std::vector<float>*>{"playback", &playback},
+                                     std::pair<Cchar, const std::vector<float>*>{"random seeks", &seeks}}) {
+    const double linear = Benchmark::MeasureMilliseconds(3, [&] {
+      int sum = 0;
+      for (const float time : *times)
+        sum += LinearKeyIndex(keys, time);
+      Benchmark::KeepValue(sum);
+    });
+    Benchmark::ReportResult(fmt::format("{}: linear scan from the first key", label), sSamples, linear);
+
+    const double cursor = Benchmark::MeasureMilliseconds(10, [&] {
+      int sum = 0, position = 0;
+      for (const float time : *times)
+        sum += FindKeyIndex(keys, time, position);
+      Benchmark::KeepValue(sum);
+    });
+    Benchmark::ReportResult(fmt::format("{}: FindKeyIndex with a cursor", label), sSamples, cursor);
+  }
+}
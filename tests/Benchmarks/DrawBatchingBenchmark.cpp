@@ -0,0 +1,64 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Components/Renderer/GL/DrawBatching.h"
+
+#include <random>
+using namespace Yeager;
+
+/* 100k allocations and frees of mesh sized ranges in a pool kept about half full */
+YEAGER_BENCHMARK(RangeAllocator)
+{
+  static YEAGER_CONSTEXPR Uint sOperations = 100000;
+  std::mt19937 random(5);
+  std::vector<Uint> sizes(sOperations);
+  for (Uint& size : sizes) {
+    size = 64 + random() % 4096;
+  }
+
+  RangeAllocator ranges;
+  std::vector<Uint> live;
+  auto reset = [&] {
+    ranges = RangeAllocator(1 << 24);
+    live.clear();
+    random.seed(5);
+  };
+  Benchmark::ReportResult("RangeAllocator::Allocate and Free", sOperations,
+                          Benchmark::MeasureMilliseconds(5, reset, [&] {
+                            for (const Uint size : sizes) {
+                              if (ranges.GetUsed() > ranges.GetCapacity() / 2 && !live.empty()) {
+                                const std::size_t position = random() % live.size();
+                                ranges.Free(live[position]);
+                                live[position] = live.back();
+                                live.pop_back();
+                              }
+                              const Uint offset = ranges.Allocate(size);
+                              if (offset != RangeAllocator::sInvalidOffset)
+                                live.push_back(offset);
+                            }
+                          }));
+}
+
+/**
+ * A model of 120 meshes with 6 materials interleaved, drawn 100 times. The draws of the batches before compaction are
+ * the draws (and vertex array binds) each mesh made with its own buffers, the compacted ones are the multi draws
+ */
+YEAGER_BENCHMARK(IndirectBatchBuilder)
+{
+  static YEAGER_CONSTEXPR Uint sMeshes = 120;
+  static YEAGER_CONSTEXPR Uint sModels = 100;
+  char poolStorage = 0;
+  GeometryPool* pool = reinterpret_cast<GeometryPool*>(&poolStorage);
+
+  IndirectBatchBuilder builder;
+  std::size_t batches = 0;
+  const double time = Benchmark::MeasureMilliseconds(10, [&] {
+    builder.Clear();
+    for (Uint model = 0; model < sModels; model++) {
+      for (Uint x = 0; x < sMeshes; x++)
+        builder.Add(x % 6, pool, DrawElementsIndirectCommand{36, 1, (model * sMeshes + x) * 36, int(x * 24), model});
+    }
+    batches = builder.GetBatches().size();
+    builder.Compact();
+  });
+  Benchmark::ReportResult(fmt::format("Add and Compact, {} batches to {}", batches, builder.GetBatches().size()),
+                          std::size_t(sMeshes) * sModels, time);
+}
@@ -0,0 +1,84 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Main/Scene/EntityRegistry.h"
+
+#include <random>
+using namespace Yeager;
+
+struct BenchmarkEntity {
+  uuid_t UUID;
+  String Name;
+};
+
+/**
+ * 10k lookups by UUID and by name, and the duplicated UUID check of a loaded scene with 1% copied entities. The scene
+ * scanned its object list for each, and compared every pair of objects for the duplicates
+ */
+YEAGER_BENCHMARK(EntityIndex)
+{
+  std::mt19937_64 random(11);
+  for (const Uint count : {10000u, 100000u}) {
+    std::vector<BenchmarkEntity> entities(count);
+    EntityIndex index;
+    for (Uint x = 0; x < count; x++) {
+      std::array<uint8_t, 16> bytes;
+      for (uint8_t& byte : bytes)
+        byte = static_cast<uint8_t>(random());
+      entities[x].UUID = uuid_t(bytes);
+      entities[x].Name = fmt::format("Object {}", x);
+    }
+    Benchmark::ReportResult("EntityIndex::Insert", count, Benchmark::MeasureMilliseconds(1, [&] {
+                              for (Uint x = 0; x < count; x++)
+                                index.Insert(EntityHandle{x, 0}, entities[x].UUID, entities[x].Name);
+                            }));
+
+    std::vector<Uint> probes(10000);
+    for (Uint& probe : probes) {
+      probe = random() % count;
+    }
+    Benchmark::ReportResult("10k lookups: scan by UUID", count, Benchmark::MeasureMilliseconds(1, [&] {
+                              for (const Uint probe : probes) {
+                                const auto it = std::find_if(entities.begin(), entities.end(), [&](const auto& entity) {
+                                  return entity.UUID == entities[probe].UUID;
+                                });
+                                Benchmark::KeepValue(it - entities.begin());
+                              }
+                            }));
+    Benchmark::ReportResult("10k lookups: EntityIndex::FindByUUID", count, Benchmark::MeasureMilliseconds(5, [&] {
+                              for (const Uint probe : probes)
+                                Benchmark::KeepValue(index.FindByUUID(entities[probe].UUID));
+                            }));
+    Benchmark::ReportResult("10k lookups: scan by name", count, Benchmark::MeasureMilliseconds(1, [&] {
+                              for (const Uint probe : probes) {
+                                const auto it = std::find_if(entities.begin(), entities.end(), [&](const auto& entity) {
+                                  return entity.Name == entities[probe].Name;
+                                });
+                                Benchmark::KeepValue(it - entities.begin());
+                              }
+                            }));
+    Benchmark::ReportResult("10k lookups: EntityIndex::FindByName", count, Benchmark::MeasureMilliseconds(5, [&] {
+                              for (const Uint probe : probes)
+                                Benchmark::KeepValue(index.FindByName(entities[probe].Name));
+                            }));
+
+    for (Uint x = 0; x < count / 100; x++) {
+      entities.push_back(BenchmarkEntity{entities[random() % count].UUID, "Copy"});
+    }
+    /* The pairs of a 100k scene take minutes */
+    if (count <= 10000) {
+      Benchmark::ReportResult("duplicates: every pair", count, Benchmark::MeasureMilliseconds(1, [&] {
+                                Uint duplicates = 0;
+                                for (std::size_t x = 0; x < entities.size(); x++) {
+                                  for (std::size_t y = x + 1; y < entities.size(); y++)
+                                    duplicates += entities[x].UUID == entities[y].UUID;
+                                }
+                                Benchmark::KeepValue(duplicates);
+                              }));
+    }
+    Benchmark::ReportResult("duplicates: EntityIndex::FindByUUID", count, Benchmark::MeasureMilliseconds(5, [&] {
+                              Uint duplicates = 0;
+                              for (Uint x = 0; x < entities.size(); x++)
+                                duplicates += index.FindByUUID(entities[x].UUID) != EntityHandle{x, 0};
+                              Benchmark::KeepValue(duplicates);
+                            }));
+  }
+}
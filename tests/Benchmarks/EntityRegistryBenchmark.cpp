@@ -0,0 +1,159 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Main/Scene/EntityRegistry.h"
+
+#include <random>
+using namespace Yeager;
+
+/* Stands for a scene object, big enough that the objects of a vector of shared pointers do not share cache lines */
+struct BenchmarkObject {
+  BenchmarkObject(Uint id) : Id(id), Value(float(id)) {}
+
+  Uint Id = 0;
+  float Value = 0.0f;
+  char Payload[200] = {0};
+};
+
+/**
+ * The scene lists were std::vector<std::shared_ptr<T>>, looked up by scanning for the id and erased by index while
+ * iterated. Against the component pool: insertion, one pass over the components, 1000 lookups and the removal of 10%
+ */
+YEAGER_BENCHMARK(EntityRegistry)
+{
+  std::mt19937 random(3);
+  for (const Uint count : {10000u, 100000u, 1000000u}) {
+    std::vector<std::shared_ptr<BenchmarkObject>> objects;
+    objects.reserve(count);
+    for (Uint x = 0; x < count; x++) {
+      objects.push_back(std::make_shared<BenchmarkObject>(x));
+    }
+
+    std::vector<std::shared_ptr<BenchmarkObject>> vector;
+    std::unique_ptr<EntityRegistry> registry;
+    ComponentPool<BenchmarkObject>* pool = YEAGER_NULLPTR;
+    const double vectorInsert = Benchmark::MeasureMilliseconds(
+        3, [&] { vector = {}; }, [&] { vector.insert(vector.end(), objects.begin(), objects.end()); });
+    const double poolInsert = Benchmark::MeasureMilliseconds(
+        3,
+        [&] {
+          registry = std::make_unique<EntityRegistry>();
+          pool = registry->GetPool<BenchmarkObject>();
+        },
+        [&] {
+          for (const auto& object : objects)
+            pool->push_back(object);
+        });
+    Benchmark::ReportResult("insert: vector of shared_ptr", count, vectorInsert);
+    Benchmark::ReportResult("insert: ComponentPool::push_back", count, poolInsert);
+
+    Benchmark::ReportResult("iterate: vector of shared_ptr", count, Benchmark::MeasureMilliseconds(10, [&] {
+                              float sum = 0.0f;
+                              for (const auto& object : vector)
+                                sum += object->Value;
+                              Benchmark::KeepValue(sum);
+                            }));
+    Benchmark::ReportResult("iterate: ComponentPool", count, Benchmark::MeasureMilliseconds(10, [&] {
+                              float sum = 0.0f;
+                              for (const BenchmarkObject* object : *pool)
+                                sum += object->Value;
+                              Benchmark::KeepValue(sum);
+                            }));
+
+    std::vector<Uint> ids(1000);
+    for (Uint& id : ids) {
+      id = random() % count;
+    }
+    Benchmark::ReportResult("1000 lookups: vector scan by id", count, Benchmark::MeasureMilliseconds(1, [&] {
+                              for (const Uint id : ids) {
+                                const auto it = std::find_if(vector.begin(), vector.end(),
+                                                             [id](const auto& object) { return object->Id == id; });
+                                Benchmark::KeepValue(it->get());
+                              }
+                            }));
+    std::vector<EntityHandle> handles;
+    for (const Uint id : ids) {
+      handles.push_back(pool->GetEntity(id));
+    }
+    Benchmark::ReportResult("1000 lookups: ComponentPool::Get", count, Benchmark::MeasureMilliseconds(3, [&] {
+                              for (const EntityHandle& handle : handles)
+                                Benchmark::KeepValue(pool->Get(handle));
+                            }));
+
+    /* The erase by index is quadratic, a million entities would take minutes */
+    std::vector<unsigned char> removed(count, 0);
+    for (Uint x = 0; x < count / 10; x++) {
+      removed[random() % count] = 1;
+    }
+    if (count <= 100000) {
+      Benchmark::ReportResult("remove 10%: vector erase by index", count, Benchmark::MeasureMilliseconds(1, [&] {
+                                for (std::size_t x = 0; x < vector.size();) {
+                                  if (removed[vector[x]->Id] != 0)
+                                    vector.erase(vector.begin() + x);
+                                  else
+                                    x++;
+                                }
+                              }));
+    }
+    Benchmark::ReportResult("remove 10%: ComponentPool::RemoveIf", count, Benchmark::MeasureMilliseconds(1, [&] {
+                              pool->RemoveIf([&removed](BenchmarkObject* object, EntityHandle) {
+                                return removed[object->Id] != 0;
+                              });
+                            }));
+  }
+}
+
+/**
+ * Deleting half of 100k objects, each with a toolbox. The scene erased the flagged objects of both lists one at a time,
+ * the registry records them with DestroyDeferred and removes them in one pass per pool, releasing them afterwards
+ */
+YEAGER_BENCHMARK(EntityRegistryFlush)
+{
+  static YEAGER_CONSTEXPR Uint sCount = 100000;
+  struct BenchmarkTool {
+    Uint Id = 0;
+  };
+
+  std::vector<std::shared_ptr<BenchmarkObject>> objects;
+  std::vector<std::shared_ptr<BenchmarkTool>> tools;
+  auto fillVectors = [&] {
+    objects.clear();
+    tools.clear();
+    for (Uint x = 0; x < sCount; x++) {
+      objects.push_back(std::make_shared<BenchmarkObject>(x));
+      tools.push_back(std::make_shared<BenchmarkTool>(BenchmarkTool{x}));
+    }
+  };
+  auto eraseFlagged = [](auto& list) {
+    for (std::size_t x = 0; x < list.size();) {
+      if (list[x]->Id % 2 == 0)
+        list.erase(list.begin() + x);
+      else
+        x++;
+    }
+  };
+  Benchmark::ReportResult("erase flagged from the vectors", sCount, Benchmark::MeasureMilliseconds(1, fillVectors, [&] {
+                            eraseFlagged(objects);
+                            eraseFlagged(tools);
+                          }));
+
+  std::unique_ptr<EntityRegistry> registry;
+  std::vector<std::shared_ptr<void>> released;
+  auto fillRegistry = [&] {
+    released.clear();
+    registry = std::make_unique<EntityRegistry>();
+    ComponentPool<BenchmarkObject>* pool = registry->GetPool<BenchmarkObject>();
+    ComponentPool<BenchmarkTool>* toolPool = registry->GetPool<BenchmarkTool>();
+    for (Uint x = 0; x < sCount; x++) {
+      const EntityHandle entity = registry->Create();
+      pool->Insert(entity, std::make_shared<BenchmarkObject>(x));
+      toolPool->Insert(entity, std::make_shared<BenchmarkTool>(BenchmarkTool{x}));
+      if (x % 2 == 0)
+        registry->DestroyDeferred(entity);
+    }
+  };
+  const double flushTime = Benchmark::MeasureMilliseconds(5, fillRegistry, [&] {
+    Benchmark::KeepValue(registry->FlushDestroyed(&released));
+  });
+  const double releaseTime = Benchmark::MeasureMilliseconds(1, [&] { released.clear(); });
+  Benchmark::ReportResult("EntityRegistry::FlushDestroyed", sCount, flushTime);
+  Benchmark::ReportResult("release of the flushed components", sCount, releaseTime);
+}
@@ -0,0 +1,45 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Framework/YeagerUploadRing.h"
+#include "Components/Renderer/GL/OpenGLRender.h"
+using namespace Yeager;
+
+/**
+ * 100k instances packed into the ring every frame, in both layouts. BuildProps built a "matrices[i]" name for each
+ * instance and set it as a uniform, only the names are measured here, the driver call per instance is not
+ */
+YEAGER_BENCHMARK(InstanceStream)
+{
+  static YEAGER_CONSTEXPR Uint sCount = 100000;
+  std::vector<Matrix4> transforms(sCount);
+  for (Uint x = 0; x < sCount; x++) {
+    transforms[x] = Matrix4(1.0f);
+    transforms[x][3] = Vector4(float(x), float(x % 100), 0.0f, 1.0f);
+  }
+
+  Benchmark::ReportResult("uniform names per instance", sCount, Benchmark::MeasureMilliseconds(10, [&] {
+                            std::size_t length = 0;
+                            for (Uint x = 0; x < sCount; x++)
+                              length += String("matrices[" + std::to_string(x) + "]").size();
+                            Benchmark::KeepValue(length);
+                          }));
+
+  for (const auto layout : {InstanceTransformLayout::eMATRIX3x4, InstanceTransformLayout::eMATRIX4x4}) {
+    /* Sized for the frames in flight, so no frame spills */
+    const std::size_t capacity = sCount * sizeof(Matrix4) * YEAGER_UPLOAD_RING_FRAMES;
+    UploadRing ring(capacity, std::make_unique<Test::FakeUploadRingBackend>());
+    InstanceStream stream(layout);
+    const double time = Benchmark::MeasureMilliseconds(
+        10,
+        [&] {
+          ring.EndFrame();
+          ring.BeginFrame();
+          stream.BeginFrame(&ring, sCount);
+        },
+        [&] { Benchmark::KeepValue(stream.Push(transforms)); });
+    const Uint bytes = sCount * stream.GetTexelsPerInstance() * 4 * sizeof(float);
+    Benchmark::ReportResult(fmt::format("InstanceStream::Push {}x4, {:.1f} MB",
+                                        stream.GetTexelsPerInstance(), bytes / (1024.0 * 1024.0)),
+                            sCount, time);
+    stream.Destroy();
+  }
+}
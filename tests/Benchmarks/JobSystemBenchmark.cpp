@@ -0,0 +1,56 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Components/Kernel/Process/JobSystem.h"
+using namespace Yeager;
+
+/**
+ * Tasks of a few microseconds, run by a thread each (the old ThreadManagement::NewThread) and by the job system. The
+ * 1M tasks overflow the deques, so part of them run inline, and are only given to the job system, a thread each would
+ * take minutes
+ */
+YEAGER_BENCHMARK(JobSystemTasks)
+{
+  JobSystem::Initialize();
+  auto task = [] {
+    float value = 0.0f;
+    for (Uint x = 0; x < 2000; x++)
+      value += std::sqrt(static_cast<float>(x));
+    Benchmark::KeepValue(value);
+  };
+
+  for (const Uint count : {1000u, 10000u, 1000000u}) {
+    if (count <= 10000) {
+      Benchmark::ReportResult("std::thread per task", count, Benchmark::MeasureMilliseconds(3, [&] {
+                                std::vector<std::thread> threads;
+                                threads.reserve(count);
+                                for (Uint x = 0; x < count; x++)
+                                  threads.emplace_back(task);
+                                for (auto& thread : threads)
+                                  thread.join();
+                              }));
+    }
+    Benchmark::ReportResult("JobSystem::Run", count, Benchmark::MeasureMilliseconds(3, [&] {
+                              JobCounter counter;
+                              for (Uint x = 0; x < count; x++)
+                                JobSystem::Run(task, &counter);
+                              JobSystem::Wait(&counter);
+                            }));
+  }
+  JobSystem::Terminate();
+}
+
+/* A loop over a large array, on the calling thread and split by ParallelFor */
+YEAGER_BENCHMARK(JobSystemParallelFor)
+{
+  JobSystem::Initialize();
+  for (const Uint count : {100000u, 1000000u, 10000000u}) {
+    std::vector<float> values(count);
+    auto work = [&values](Uint begin, Uint end) {
+      for (Uint x = begin; x < end; x++)
+        values[x] = std::sqrt(static_cast<float>(x)) * std::sin(static_cast<float>(x));
+    };
+    Benchmark::ReportResult("serial loop", count, Benchmark::MeasureMilliseconds(5, [&] { work(0, count); }));
+    Benchmark::ReportResult(fmt::format("ParallelFor, {} workers", JobSystem::GetWorkerCount()), count,
+                            Benchmark::MeasureMilliseconds(5, [&] { JobSystem::ParallelFor(count, 0, work); }));
+  }
+  JobSystem::Terminate();
+}
@@ -0,0 +1,72 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Components/Kernel/Caching/MeshCacheFile.h"
+using namespace Yeager;
+
+/* Sums a byte of every page, so the pages of the mapping are read in as the meshes upload would */
+static uint64_t TouchPages(const unsigned char* data, std::size_t size)
+{
+  uint64_t sum = 0;
+  for (std::size_t x = 0; x < size; x += 4096) {
+    sum += data[x];
+  }
+  return sum;
+}
+
+/**
+ * Writes and loads a model of 100 meshes with 5000 vertices of 64 bytes, loaded by mapping the validated file, and by
+ * reading the whole file into memory which is what a cache without the mapping would do. The file was just written so
+ * both read it from the page cache, the cost of parsing the model with assimp is not part of it
+ */
+YEAGER_BENCHMARK(MeshCacheWriteLoad)
+{
+  static YEAGER_CONSTEXPR Uint sMeshes = 100;
+  static YEAGER_CONSTEXPR Uint sVertices = 5000;
+  static YEAGER_CONSTEXPR uint32_t sStride = 64;
+  static YEAGER_CONSTEXPR uint64_t sKey = 42;
+
+  std::vector<unsigned char> vertices(std::size_t(sVertices) * sStride);
+  for (std::size_t x = 0; x < vertices.size(); x++) {
+    vertices[x] = static_cast<unsigned char>(x);
+  }
+  std::vector<GLuint> indices(sVertices * 3);
+  for (std::size_t x = 0; x < indices.size(); x++) {
+    indices[x] = static_cast<GLuint>((x * 7) % sVertices);
+  }
+
+  MeshCacheContents contents;
+  contents.Key = sKey;
+  contents.VertexStride = sStride;
+  contents.Textures.push_back(MeshCacheTextureSource{"Textures/albedo.png", "texture_diffuse"});
+  for (Uint x = 0; x < sMeshes; x++) {
+    MeshCacheMeshSource mesh;
+    mesh.Vertices = vertices.data();
+    mesh.VertexCount = sVertices;
+    mesh.Indices = indices;
+    mesh.TextureRefs.push_back(0);
+    contents.Meshes.push_back(mesh);
+  }
+
+  const std::filesystem::path folder = std::filesystem::temp_directory_path() / "YeagerBenchmarks";
+  const String path = (folder / "MeshCacheWriteLoad.yobj_ch").string();
+
+  const double writeTime = Benchmark::MeasureMilliseconds(5, [&] { WriteMeshCacheFile(path, contents); });
+  const double mapTime = Benchmark::MeasureMilliseconds(10, [&] {
+    MeshCacheFile file;
+    file.Open(path, sKey, MeshCacheKind::eSTATIC, sStride);
+    Benchmark::KeepValue(TouchPages(file.GetMapping()->GetData(), file.GetMapping()->GetSize()));
+  });
+  const double readTime = Benchmark::MeasureMilliseconds(10, [&] {
+    std::ifstream input(path, std::ios::binary);
+    std::vector<unsigned char> data(std::filesystem::file_size(path));
+    input.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    Benchmark::KeepValue(TouchPages(data.data(), data.size()));
+  });
+
+  std::error_code error;
+  std::filesystem::remove_all(folder, error);
+
+  const std::size_t totalVertices = std::size_t(sMeshes) * sVertices;
+  Benchmark::ReportResult("WriteMeshCacheFile", totalVertices, writeTime);
+  Benchmark::ReportResult("MeshCacheFile::Open, mapped", totalVertices, mapTime);
+  Benchmark::ReportResult("Whole file read into memory", totalVertices, readTime);
+}
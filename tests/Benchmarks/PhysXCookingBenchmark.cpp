@@ -0,0 +1,52 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Framework/YeagerPhysX.h"
+#include "Components/Kernel/Caching/PhysXCookingCache.h"
+using namespace Yeager;
+using namespace physx;
+
+/**
+ * Creates the triangle mesh of a 256 * 256 quads grid by cooking it, as every load did before the cache, and from the
+ * cooking cache written by the first cooking. The cache time includes hashing the points and the triangles for the key
+ */
+YEAGER_BENCHMARK(PhysXCookingCache)
+{
+  Test::PhysXTestWorld world;
+  if (!world.IsValid())
+    return;
+
+  const Test::PhysXTestGrid grid(256, 4.0f);
+  const PxTriangleMeshDesc desc = grid.GetDesc();
+  const PxCookingParams params = world.GetCookingParams();
+  const std::filesystem::path folder = std::filesystem::temp_directory_path() / "YeagerBenchmarks";
+  std::filesystem::create_directories(folder);
+
+  const double cookTime = Benchmark::MeasureMilliseconds(5, [&] {
+    PxDefaultMemoryOutputStream cooked;
+    PxCookTriangleMesh(params, desc, cooked);
+    PxDefaultMemoryInputData input(cooked.getData(), cooked.getSize());
+    PxTriangleMesh* mesh = world.GetPhysics().createTriangleMesh(input);
+    Benchmark::KeepValue(mesh);
+    if (mesh != YEAGER_NULLPTR)
+      mesh->release();
+  });
+
+  const uint64_t key = PhysXCookingCache::ComputeKey(desc, params);
+  const String path = PhysXCookingCache::BuildCachePath(folder.string(), key);
+  PxDefaultMemoryOutputStream cooked;
+  PxCookTriangleMesh(params, desc, cooked);
+  PhysXCookingCache::Write(path, key, PhysXCookedKind::eTRIANGLE_MESH, cooked);
+
+  const double cacheTime = Benchmark::MeasureMilliseconds(5, [&] {
+    PxTriangleMesh* mesh =
+        PhysXCookingCache::LoadTriangleMesh(path, PhysXCookingCache::ComputeKey(desc, params), world.GetPhysics());
+    Benchmark::KeepValue(mesh);
+    if (mesh != YEAGER_NULLPTR)
+      mesh->release();
+  });
+
+  std::error_code error;
+  std::filesystem::remove_all(folder, error);
+
+  Benchmark::ReportResult("PxCookTriangleMesh", desc.triangles.count, cookTime);
+  Benchmark::ReportResult("PhysXCookingCache::LoadTriangleMesh", desc.triangles.count, cacheTime);
+}
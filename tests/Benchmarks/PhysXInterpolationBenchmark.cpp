@@ -0,0 +1,53 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Framework/YeagerPhysX.h"
+#include "Components/Kernel/Process/JobSystem.h"
+#include "Components/Physics/PhysXJobDispatcher.h"
+#include "Components/Physics/PhysXSceneStepper.h"
+using namespace Yeager;
+using namespace physx;
+
+/**
+ * Time the drawn poses of the boxes take to read, summed over the frames of 144 Hz stepped at 60 Hz. The global pose of
+ * PhysX is what the objects drew before the fixed step, the interpolated pose is what they draw now
+ */
+YEAGER_BENCHMARK(PhysXInterpolation)
+{
+  static YEAGER_CONSTEXPR Uint sFrames = 240;
+  Test::PhysXTestWorld world;
+  if (!world.IsValid())
+    return;
+  JobSystem::Initialize();
+
+  for (const Uint count : {500u, 2000u}) {
+    PhysXJobDispatcher dispatcher;
+    PxScene* scene = world.CreateScene(dispatcher);
+    const std::vector<PxRigidDynamic*> boxes = world.CreateBoxes(count);
+    PhysXSceneStepper stepper;
+    stepper.SetScene(scene);
+    for (PxRigidDynamic* box : boxes) {
+      stepper.AddActor(box);
+      stepper.RegisterInterpolatedActor(box);
+    }
+
+    double globalTime = 0.0;
+    double interpolatedTime = 0.0;
+    for (Uint x = 0; x < sFrames; x++) {
+      stepper.Start(1.0f / 144.0f);
+      globalTime += Benchmark::MeasureMilliseconds(1, [&] {
+        for (PxRigidDynamic* box : boxes)
+          Benchmark::KeepValue(box->getGlobalPose());
+      });
+      interpolatedTime += Benchmark::MeasureMilliseconds(1, [&] {
+        for (PxRigidDynamic* box : boxes)
+          Benchmark::KeepValue(stepper.GetInterpolatedPose(box));
+      });
+      stepper.End();
+    }
+    stepper.Reset();
+    scene->release();
+
+    Benchmark::ReportResult("PxRigidActor::getGlobalPose", std::size_t(count) * sFrames, globalTime);
+    Benchmark::ReportResult("PhysXSceneStepper::GetInterpolatedPose", std::size_t(count) * sFrames, interpolatedTime);
+  }
+  JobSystem::Terminate();
+}
@@ -0,0 +1,89 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Framework/YeagerPhysX.h"
+#include "Components/Kernel/Process/JobSystem.h"
+#include "Components/Physics/PhysXJobDispatcher.h"
+#include "Components/Physics/PhysXSceneStepper.h"
+using namespace Yeager;
+using namespace physx;
+
+static YEAGER_CONSTEXPR Uint sFrames = 240;
+static YEAGER_CONSTEXPR Uint sBoxes = 2000;
+static YEAGER_CONSTEXPR float sStep = 1.0f / 60.0f;
+
+/* Stands for the draw of the frame, the main thread is busy for the given time */
+static void SpinFor(double milliseconds)
+{
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() < milliseconds) {
+  }
+}
+
+struct SteppingResult {
+  double WaitMilliseconds = 0.0;
+  double FrameMilliseconds = 0.0;
+};
+
+/* Boxes falling into piles for a number of frames, each frame steps once and draws for the given time */
+template <typename FrameFun>
+static SteppingResult RunFrames(Test::PhysXTestWorld& world, PxCpuDispatcher& dispatcher, FrameFun&& frame)
+{
+  PxScene* scene = world.CreateScene(dispatcher);
+  for (PxRigidDynamic* box : world.CreateBoxes(sBoxes)) {
+    scene->addActor(*box);
+  }
+
+  SteppingResult result;
+  const auto start = std::chrono::steady_clock::now();
+  for (Uint x = 0; x < sFrames; x++) {
+    result.WaitMilliseconds += frame(*scene);
+  }
+  result.FrameMilliseconds =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / sFrames;
+  scene->release();
+  return result;
+}
+
+/**
+ * Main thread time spent waiting for the PhysX step, summed over the frames, and the average frame time. Before the
+ * change the step was simulated and fetched right away before the draw, in a PxDefaultCpuDispatcher of half the
+ * threads. Now the PhysXSceneStepper fetches it after the draw, with the tasks in the job system
+ */
+YEAGER_BENCHMARK(PhysXStepping)
+{
+  Test::PhysXTestWorld world;
+  if (!world.IsValid())
+    return;
+  JobSystem::Initialize();
+
+  for (const double drawMilliseconds : {2.0, 8.0}) {
+    const Uint threads = std::max<Uint>(std::thread::hardware_concurrency() / 2, 1);
+    PxDefaultCpuDispatcher* defaultDispatcher = PxDefaultCpuDispatcherCreate(threads);
+    const SteppingResult blocking = RunFrames(world, *defaultDispatcher, [drawMilliseconds](PxScene& scene) {
+      scene.simulate(sStep);
+      const auto start = std::chrono::steady_clock::now();
+      scene.fetchResults(true);
+      const double wait = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      SpinFor(drawMilliseconds);
+      return wait;
+    });
+    defaultDispatcher->release();
+
+    PhysXJobDispatcher jobDispatcher;
+    PhysXSceneStepper stepper;
+    const SteppingResult overlapped = RunFrames(world, jobDispatcher, [&stepper, drawMilliseconds](PxScene& scene) {
+      stepper.SetScene(&scene);
+      stepper.Start(sStep);
+      SpinFor(drawMilliseconds);
+      stepper.End();
+      return double(stepper.GetLastFetchWaitMilliseconds());
+    });
+    stepper.Reset();
+
+    const String draw = fmt::format("{} ms draw", drawMilliseconds);
+    Benchmark::ReportResult(fmt::format("simulate, fetch, draw: wait, {}", draw), sFrames, blocking.WaitMilliseconds);
+    Benchmark::ReportResult(fmt::format("simulate, fetch, draw: frame, {}", draw), sFrames, blocking.FrameMilliseconds);
+    Benchmark::ReportResult(fmt::format("Start, draw, End: wait, {}", draw), sFrames, overlapped.WaitMilliseconds);
+    Benchmark::ReportResult(fmt::format("Start, draw, End: frame, {}", draw), sFrames, overlapped.FrameMilliseconds);
+  }
+  JobSystem::Terminate();
+}
@@ -0,0 +1,34 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Components/Renderer/RenderQueue/RenderQueue.h"
+
+#include <random>
+using namespace Yeager;
+
+/* Sorting the packets of a frame, the radix sort of the queue against the comparison sorts of the standard library */
+YEAGER_BENCHMARK(RenderQueueSort)
+{
+  for (const std::size_t count : {10000, 100000, 1000000}) {
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+    std::vector<RenderPacket> source(count);
+    for (auto& packet : source) {
+      packet.Key = BuildRenderKey(random() % 4 == 0 ? RenderQueuePass::eTRANSPARENT : RenderQueuePass::eOPAQUE,
+                                  random() % 32, random() % 512, random() % 1024, depth(random));
+    }
+
+    auto byKey = [](const RenderPacket& first, const RenderPacket& second) { return first.Key < second.Key; };
+    std::vector<RenderPacket> packets;
+    RenderSortScratch scratch;
+    auto reset = [&] { packets = source; };
+
+    Benchmark::ReportResult("RadixSortRenderPackets", count, Benchmark::MeasureMilliseconds(5, reset, [&] {
+                              RadixSortRenderPackets(&packets, &scratch);
+                            }));
+    Benchmark::ReportResult("std::sort", count, Benchmark::MeasureMilliseconds(5, reset, [&] {
+                              std::sort(packets.begin(), packets.end(), byKey);
+                            }));
+    Benchmark::ReportResult("std::stable_sort", count, Benchmark::MeasureMilliseconds(5, reset, [&] {
+                              std::stable_sort(packets.begin(), packets.end(), byKey);
+                            }));
+  }
+}
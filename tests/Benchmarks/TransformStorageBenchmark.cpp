@@ -0,0 +1,82 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Components/Kernel/Process/JobSystem.h"
+#include "Components/Renderer/Objects/Entity.h"
+#include "Components/Renderer/Objects/TransformStorage.h"
+
+#include <random>
+using namespace Yeager;
+
+/* The matrix Transformation3D::Apply rebuilt for every object in its draw before the storage */
+static Matrix4 ComposePerObject(const Transformation3D& transformation)
+{
+  Matrix4 model = YEAGER_IDENTITY_MATRIX4x4;
+  model = glm::translate(model, transformation.position);
+  model = glm::rotate(model, glm::radians(transformation.rotation.x), Vector3(1.0f, 0.0f, 0.0f));
+  model = glm::rotate(model, glm::radians(transformation.rotation.y), Vector3(0.0f, 1.0f, 0.0f));
+  model = glm::rotate(model, glm::radians(transformation.rotation.z), Vector3(0.0f, 0.0f, 1.0f));
+  return glm::scale(model, transformation.scale);
+}
+
+/**
+ * 100k transforms in chains of 8, with 1% of them moved every frame. Before the storage every object rebuilt its model
+ * matrix in its draw, the chains are composed here the same way by walking the parents, which the draw never did
+ */
+YEAGER_BENCHMARK(TransformStorageUpdate)
+{
+  static YEAGER_CONSTEXPR Uint sCount = 100000;
+  static YEAGER_CONSTEXPR Uint sChain = 8;
+  static YEAGER_CONSTEXPR Uint sDirty = sCount / 100;
+
+  std::mt19937 random(7);
+  std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+  std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+  std::vector<Transformation3D> sources(sCount);
+  for (Transformation3D& source : sources) {
+    source = Transformation3D(Vector3(position(random), position(random), position(random)),
+                              Vector3(angle(random), angle(random), angle(random)), Vector3(1.0f));
+  }
+
+  std::vector<Matrix4> world(sCount);
+  Uint frame = 0;
+  auto moveDirty = [&sources, &frame] {
+    for (Uint x = 0; x < sDirty; x++) {
+      sources[(frame * sDirty + x * 97) % sCount].position.x += 1.0f;
+    }
+    frame++;
+  };
+  const double perObjectTime = Benchmark::MeasureMilliseconds(10, moveDirty, [&] {
+    for (Uint x = 0; x < sCount; x++) {
+      const Matrix4 local = ComposePerObject(sources[x]);
+      world[x] = x % sChain != 0 ? world[x - 1] * local : local;
+    }
+    Benchmark::KeepValue(world.back());
+  });
+  Benchmark::ReportResult("Transformation3D::Apply per object", sCount, perObjectTime);
+
+  for (const Uint threads : {1u, 0u}) {
+    if (threads != 1)
+      JobSystem::Initialize(threads);
+    TransformStorage storage;
+    std::vector<TransformHandle> handles(sCount);
+    for (Uint x = 0; x < sCount; x++) {
+      handles[x] = storage.Create(&sources[x]);
+      if (x % sChain != 0)
+        storage.SetParent(handles[x], handles[x - 1]);
+    }
+    storage.Update();
+
+    auto markDirty = [&] {
+      for (Uint x = 0; x < sDirty; x++) {
+        const Uint index = (frame * sDirty + x * 97) % sCount;
+        sources[index].position.x += 1.0f;
+        storage.MarkDirty(handles[index]);
+      }
+      frame++;
+    };
+    const double time = Benchmark::MeasureMilliseconds(10, markDirty, [&] { storage.Update(); });
+    Benchmark::ReportResult(fmt::format("TransformStorage::Update, {} workers", JobSystem::GetWorkerCount()), sCount,
+                            time);
+    if (threads != 1)
+      JobSystem::Terminate();
+  }
+}
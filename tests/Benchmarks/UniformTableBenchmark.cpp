@@ -0,0 +1,43 @@
+#include "Framework/YeagerBenchmark.h"
+#include "Components/Renderer/Shader/UniformTable.h"
+using namespace Yeager;
+
+/**
+ * Uniform lookups of a lighting shader, by a handle made once against the table, and by the name built on every set
+ * against a map of the names, which is what the shader did before the table
+ */
+YEAGER_BENCHMARK(UniformTableLookup)
+{
+  static YEAGER_CONSTEXPR Uint sUniforms = 64;
+  static YEAGER_CONSTEXPR Uint sLookups = 1000000;
+
+  UniformTable table;
+  std::unordered_map<String, GLint> names;
+  std::vector<UniformHandle> handles;
+  table.Reset(sUniforms);
+  for (Uint x = 0; x < sUniforms; x++) {
+    const String name = "pointLights[" + std::to_string(x) + "].position";
+    table.Insert(name, x);
+    names[name] = x;
+    handles.emplace_back(name);
+  }
+
+  const double tableTime = Benchmark::MeasureMilliseconds(5, [&] {
+    GLint sum = 0;
+    for (Uint x = 0; x < sLookups; x++) {
+      const UniformHandle& handle = handles[x % sUniforms];
+      sum += table.Find(handle.Hash, handle.Name);
+    }
+    Benchmark::KeepValue(sum);
+  });
+  const double nameTime = Benchmark::MeasureMilliseconds(5, [&] {
+    GLint sum = 0;
+    for (Uint x = 0; x < sLookups; x++) {
+      sum += names.find("pointLights[" + std::to_string(x % sUniforms) + "].position")->second;
+    }
+    Benchmark::KeepValue(sum);
+  });
+
+  Benchmark::ReportResult("UniformTable::Find with handles", sLookups, tableTime);
+  Benchmark::ReportResult("unordered_map with built names", sLookups, nameTime);
+}
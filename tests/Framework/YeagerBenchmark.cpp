@@ -0,0 +1,31 @@
+#include "YeagerBenchmark.h"
+using namespace Yeager;
+
+std::vector<Benchmark::BenchmarkCase>& Benchmark::GetBenchmarkCases()
+{
+  static std::vector<BenchmarkCase> sBenchmarkCases;
+  return sBenchmarkCases;
+}
+
+Benchmark::BenchmarkRegistration::BenchmarkRegistration(Cchar name, BenchmarkFunction function)
+{
+  GetBenchmarkCases().push_back(BenchmarkCase{name, function});
+}
+
+void Benchmark::ReportResult(const String& variant, std::size_t count, double milliseconds)
+{
+  std::cout << fmt::format("  {:<48} {:>10} {:>12.3f} ms", variant, count, milliseconds) << std::endl;
+}
+
+/* Runs the benchmarks whose name starts with the first argument, or every benchmark without arguments */
+int main(int argc, char** argv)
+{
+  const String filter = argc > 1 ? argv[1] : YEAGER_EMPTY_LITERAL;
+  for (const auto& benchmark : Benchmark::GetBenchmarkCases()) {
+    if (String(benchmark.Name).rfind(filter, 0) != 0)
+      continue;
+    std::cout << benchmark.Name << std::endl;
+    benchmark.Function();
+  }
+  return 0;
+}
@@ -0,0 +1,83 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+
+namespace Yeager::Benchmark {
+
+using BenchmarkFunction = void (*)();
+
+struct BenchmarkCase {
+  Cchar Name = YEAGER_NULLPTR;
+  BenchmarkFunction Function = YEAGER_NULLPTR;
+};
+
+/** @brief Every benchmark linked in the executable, filled by the YEAGER_BENCHMARK registrations before main runs */
+extern std::vector<BenchmarkCase>& GetBenchmarkCases();
+
+struct BenchmarkRegistration {
+  BenchmarkRegistration(Cchar name, BenchmarkFunction function);
+};
+
+/** @brief Prints a row of the results, the time of a variant of the benchmark over the given amount of elements */
+extern void ReportResult(const String& variant, std::size_t count, double milliseconds);
+
+/** @brief Keeps the compiler from removing the work that computed the value */
+template <typename T>
+void KeepValue(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Runs the function the given amount of times and returns the fastest run in milliseconds, the setup called
+ * before each run is not measured
+ */
+template <typename Setup, typename Function>
+double MeasureMilliseconds(Uint repeats, Setup&& setup, Function&& function)
+{
+  double best = std::numeric_limits<double>::max();
+  for (Uint x = 0; x < repeats; x++) {
+    setup();
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  return best;
+}
+
+template <typename Function>
+double MeasureMilliseconds(Uint repeats, Function&& function)
+{
+  return MeasureMilliseconds(repeats, [] {}, std::forward<Function>(function));
+}
+
+}  // namespace Yeager::Benchmark
+
+/**
+ * @brief Declares a benchmark, YeagerBenchmarks runs every benchmark whose name starts with its first argument. They
+ * are not part of ctest, their results only mean something on a quiet machine with an optimized build
+ */
+#define YEAGER_BENCHMARK(name)                                                                                 \
+  static void name##_Benchmark();                                                                              \
+  static const Yeager::Benchmark::BenchmarkRegistration s##name##_Registration(#name, name##_Benchmark); \
+  static void name##_Benchmark()
@@ -0,0 +1,3 @@
+/* The engine compiles stb_image in TextureHandle.cpp, along with the OpenGL textures, the tested engine gets it here */
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
@@ -0,0 +1,83 @@
+#include "YeagerPhysX.h"
+using namespace Yeager;
+using namespace physx;
+
+Test::PhysXTestWorld::PhysXTestWorld()
+{
+  mFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, mAllocator, mErrorCallback);
+  if (mFoundation == YEAGER_NULLPTR) {
+    Yeager::Log(ERROR, "PhysX cannot create the PxFoundation of the test world!");
+    return;
+  }
+  mPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *mFoundation, PxTolerancesScale());
+  if (mPhysics == YEAGER_NULLPTR) {
+    Yeager::Log(ERROR, "PhysX cannot create the PxPhysics of the test world!");
+    return;
+  }
+  mMaterial = mPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+}
+
+Test::PhysXTestWorld::~PhysXTestWorld()
+{
+  if (mPhysics != YEAGER_NULLPTR)
+    mPhysics->release();
+  if (mFoundation != YEAGER_NULLPTR)
+    mFoundation->release();
+}
+
+PxCookingParams Test::PhysXTestWorld::GetCookingParams() const
+{
+  return PxCookingParams(mPhysics != YEAGER_NULLPTR ? mPhysics->getTolerancesScale() : PxTolerancesScale());
+}
+
+PxScene* Test::PhysXTestWorld::CreateScene(PxCpuDispatcher& dispatcher)
+{
+  PxSceneDesc desc(mPhysics->getTolerancesScale());
+  desc.gravity = PxVec3(0.0f, -9.81f, 0.0f);
+  desc.cpuDispatcher = &dispatcher;
+  desc.filterShader = PxDefaultSimulationFilterShader;
+  desc.flags |= PxSceneFlag::eENABLE_ACTIVE_ACTORS;
+  PxScene* scene = mPhysics->createScene(desc);
+  scene->addActor(*PxCreatePlane(*mPhysics, PxPlane(0.0f, 1.0f, 0.0f, 0.0f), *mMaterial));
+  return scene;
+}
+
+std::vector<PxRigidDynamic*> Test::PhysXTestWorld::CreateBoxes(Uint count)
+{
+  std::vector<PxRigidDynamic*> boxes;
+  for (Uint x = 0; x < count; x++) {
+    /* Tilted a little, so they tumble when they land instead of resting on a face */
+    const PxVec3 position(float(x / 10 % 32) * 3.0f, 2.0f + float(x % 10) * 3.0f, float(x / 320) * 3.0f);
+    const PxTransform pose(position, PxQuat(0.1f + 0.01f * float(x % 7), PxVec3(1.0f, 0.0f, 1.0f).getNormalized()));
+    boxes.push_back(PxCreateDynamic(*mPhysics, pose, PxBoxGeometry(0.5f, 0.5f, 0.5f), *mMaterial, 1.0f));
+  }
+  return boxes;
+}
+
+Test::PhysXTestGrid::PhysXTestGrid(Uint size, float height)
+{
+  for (Uint z = 0; z <= size; z++) {
+    for (Uint x = 0; x <= size; x++) {
+      Points.push_back(PxVec3(float(x), height * std::sin(float(x + z) * 0.3f), float(z)));
+    }
+  }
+  for (Uint z = 0; z < size; z++) {
+    for (Uint x = 0; x < size; x++) {
+      const PxU32 corner = z * (size + 1) + x;
+      Indices.insert(Indices.end(), {corner, corner + size + 1, corner + 1});
+      Indices.insert(Indices.end(), {corner + 1, corner + size + 1, corner + size + 2});
+    }
+  }
+}
+
+PxTriangleMeshDesc Test::PhysXTestGrid::GetDesc() const
+{
+  PxTriangleMeshDesc desc;
+  desc.points.count = static_cast<PxU32>(Points.size());
+  desc.points.stride = sizeof(PxVec3);
+  desc.points.data = Points.data();
+  desc.triangles.count = static_cast<PxU32>(Indices.size() / 3);
+  desc.triangles.stride = 3 * sizeof(PxU32);
+  desc.triangles.data = Indices.data();
+  return desc;
+}
@@ -0,0 +1,65 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+
+#include "Components/Physics/PhysxAllocator.h"
+
+namespace Yeager::Test {
+
+/**
+ * @brief Foundation and physics of PhysX for the tests and benchmarks that need it, with no scene, window or PVD.
+ * PhysX allows one foundation at a time, so only one world may be alive at once
+ */
+class PhysXTestWorld {
+ public:
+  PhysXTestWorld();
+  ~PhysXTestWorld();
+  PhysXTestWorld(const PhysXTestWorld&) = delete;
+  PhysXTestWorld& operator=(const PhysXTestWorld&) = delete;
+
+  YEAGER_NODISCARD bool IsValid() const { return mPhysics != YEAGER_NULLPTR; }
+  YEAGER_NODISCARD physx::PxPhysics& GetPhysics() { return *mPhysics; }
+  YEAGER_NODISCARD physx::PxCookingParams GetCookingParams() const;
+
+  /** @brief Scene set up as the one of PhysXHandle, with its ground plane, the tasks run in the given dispatcher */
+  YEAGER_NODISCARD physx::PxScene* CreateScene(physx::PxCpuDispatcher& dispatcher);
+  /** @brief Unit boxes in columns of ten over the ground, not added to a scene, they fall and pile up in the columns */
+  YEAGER_NODISCARD std::vector<physx::PxRigidDynamic*> CreateBoxes(Uint count);
+
+ private:
+  YgPxAllocatorCallback mAllocator;
+  physx::PxDefaultErrorCallback mErrorCallback;
+  physx::PxFoundation* mFoundation = YEAGER_NULLPTR;
+  physx::PxPhysics* mPhysics = YEAGER_NULLPTR;
+  physx::PxMaterial* mMaterial = YEAGER_NULLPTR;
+};
+
+/** @brief Grid of size * size quads on the XZ plane with a wave in height, two triangles each */
+struct PhysXTestGrid {
+  std::vector<physx::PxVec3> Points;
+  std::vector<physx::PxU32> Indices;
+
+  PhysXTestGrid(Uint size, float height);
+  YEAGER_NODISCARD physx::PxTriangleMeshDesc GetDesc() const;
+};
+
+}  // namespace Yeager::Test
@@ -0,0 +1,82 @@
+#include "YeagerTest.h"
+
+#include <unistd.h>
+using namespace Yeager;
+
+static Uint sFailures = 0;
+
+std::vector<Test::TestCase>& Test::GetTestCases()
+{
+  static std::vector<TestCase> sTestCases;
+  return sTestCases;
+}
+
+Test::TestRegistration::TestRegistration(Cchar suite, Cchar name, TestFunction function)
+{
+  GetTestCases().push_back(TestCase{suite, name, function});
+}
+
+void Test::ReportFailure(Cchar file, int line, const String& message)
+{
+  sFailures++;
+  std::cout << "  " << file << ":" << line << ": expected " << message << std::endl;
+}
+
+/* One folder per run, so suites running in parallel under ctest never share their files */
+static std::filesystem::path GetTestRootFolder()
+{
+  return std::filesystem::temp_directory_path() / ("YeagerTests" + std::to_string(getpid()));
+}
+
+std::filesystem::path Test::MakeTestFolder(const String& name)
+{
+  const std::filesystem::path folder = GetTestRootFolder() / name;
+  std::error_code error;
+  std::filesystem::remove_all(folder, error);
+  std::filesystem::create_directories(folder, error);
+  return folder;
+}
+
+std::vector<unsigned char> Test::ReadTestFile(const std::filesystem::path& path)
+{
+  std::ifstream input(path, std::ios::binary);
+  return std::vector<unsigned char>(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+void Test::WriteTestFile(const std::filesystem::path& path, const std::vector<unsigned char>& data)
+{
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  output.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+/**
+ * Runs the tests of the suite given as the first argument, or every test without arguments. Returns 1 when a test
+ * failed or no test matched the suite, so ctest never passes a suite that did not run
+ */
+int main(int argc, char** argv)
+{
+  const String suite = argc > 1 ? argv[1] : YEAGER_EMPTY_LITERAL;
+  Uint ran = 0;
+  Uint failed = 0;
+
+  for (const auto& test : Test::GetTestCases()) {
+    if (!suite.empty() && suite != test.Suite)
+      continue;
+
+    const Uint failures = sFailures;
+    test.Function();
+    ran++;
+    if (sFailures != failures) {
+      failed++;
+      std::cout << "[FAILED] " << test.Suite << "." << test.Name << std::endl;
+    } else {
+      std::cout << "[    OK] " << test.Suite << "." << test.Name << std::endl;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::remove_all(GetTestRootFolder(), error);
+
+  std::cout << ran - failed << " of " << ran << " tests passed" << std::endl;
+  return (ran == 0 || failed > 0) ? 1 : 0;
+}
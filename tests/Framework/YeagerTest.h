@@ -0,0 +1,94 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+
+namespace Yeager::Test {
+
+using TestFunction = void (*)();
+
+struct TestCase {
+  Cchar Suite = YEAGER_NULLPTR;
+  Cchar Name = YEAGER_NULLPTR;
+  TestFunction Function = YEAGER_NULLPTR;
+};
+
+/** @brief Every test linked in the executable, filled by the YEAGER_TEST registrations before main runs */
+extern std::vector<TestCase>& GetTestCases();
+
+struct TestRegistration {
+  TestRegistration(Cchar suite, Cchar name, TestFunction function);
+};
+
+/** @brief Marks the running test as failed and prints where, the test keeps running so every failure is reported */
+extern void ReportFailure(Cchar file, int line, const String& message);
+
+/** @brief Folder under the system temporary folder for the files written by the running test, empty and created */
+extern std::filesystem::path MakeTestFolder(const String& name);
+
+/** @brief Whole file contents, used by the tests that corrupt the files written by the engine */
+extern std::vector<unsigned char> ReadTestFile(const std::filesystem::path& path);
+extern void WriteTestFile(const std::filesystem::path& path, const std::vector<unsigned char>& data);
+
+/** @brief Overwrites the bytes of the value at the offset of the file contents */
+template <typename T>
+void PatchValue(std::vector<unsigned char>& data, uint64_t offset, const T& value)
+{
+  std::memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+}  // namespace Yeager::Test
+
+/**
+ * @brief Declares a test of the suite, ctest runs each suite as its own test (YeagerTests <suite>), so the suites
+ * are named after the module they cover
+ */
+#define YEAGER_TEST(suite, name)                                                                       \
+  static void suite##_##name##_Test();                                                                 \
+  static const Yeager::Test::TestRegistration s##suite##_##name##_Registration(#suite, #name,          \
+                                                                               suite##_##name##_Test); \
+  static void suite##_##name##_Test()
+
+#define YEAGER_EXPECT(condition)                                         \
+  do {                                                                   \
+    if (!(condition))                                                    \
+      Yeager::Test::ReportFailure(__FILE__, __LINE__, String(#condition)); \
+  } while (0)
+
+/* Both values must be printable by fmt, they are shown when the check fails */
+#define YEAGER_EXPECT_EQ(first, second)                                                                    \
+  do {                                                                                                     \
+    const auto& yeagerFirst = (first);                                                                     \
+    const auto& yeagerSecond = (second);                                                                   \
+    if (!(yeagerFirst == yeagerSecond))                                                                    \
+      Yeager::Test::ReportFailure(__FILE__, __LINE__, fmt::format("{} == {} ({} != {})", #first, #second, \
+                                                                  yeagerFirst, yeagerSecond));           \
+  } while (0)
+
+#define YEAGER_EXPECT_NEAR(first, second, tolerance)                                                          \
+  do {                                                                                                        \
+    const double yeagerFirst = static_cast<double>(first);                                                    \
+    const double yeagerSecond = static_cast<double>(second);                                                  \
+    if (!(std::abs(yeagerFirst - yeagerSecond) <= static_cast<double>(tolerance)))                           \
+      Yeager::Test::ReportFailure(__FILE__, __LINE__, fmt::format("{} ~= {} ({} != {}, tolerance {})", #first, \
+                                                                  #second, yeagerFirst, yeagerSecond,         \
+                                                                  static_cast<double>(tolerance)));           \
+  } while (0)
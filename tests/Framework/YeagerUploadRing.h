@@ -0,0 +1,135 @@
+//    Yeager Engine, free and open source 3D/2D renderer written in OpenGL
+//    In case of questions and bugs, please, refer to the issue tab on github
+//    Repo : https://github.com/schwq/YeagerEngine
+//    Copyright (C) 2023 - Present
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "Common/Utils/Common.h"
+#include "Common/Utils/LogEngine.h"
+
+#include "Components/Renderer/GL/UploadRing.h"
+
+#include <map>
+
+namespace Yeager::Test {
+
+/**
+ * @brief Upload ring backend without OpenGL, the buffer is an array always mapped and every fence is signaled at once,
+ * as if the GPU read each frame the moment it was submitted. The fences can also be held unsignaled until
+ * SignalFences, or until the ring blocks on one of them, and the buffers and fences alive are counted so the tests can
+ * tell a leak or a double deletion
+ */
+class FakeUploadRingBackend : public UploadRingBackend {
+ public:
+  /** @brief Unmapped, the ring writes to its staging array and sends the bytes through Upload */
+  FakeUploadRingBackend(bool mapped = true) : bMapped(mapped) {}
+
+  unsigned char* CreateBuffer(std::size_t size) override
+  {
+    mBuffer.assign(size, 0);
+    bBufferAlive = true;
+    return bMapped ? mBuffer.data() : YEAGER_NULLPTR;
+  }
+  void DestroyBuffer() override
+  {
+    mBuffer.clear();
+    bBufferAlive = false;
+  }
+  YEAGER_NODISCARD GLuint GetBuffer() const override { return 1; }
+  GLuint CreateSpillBuffer(std::size_t size) override
+  {
+    mSpillBuffers[++mLastSpillBuffer].assign(size, 0);
+    return mLastSpillBuffer;
+  }
+  void DeleteSpillBuffer(GLuint buffer) override { bValid &= mSpillBuffers.erase(buffer) == 1; }
+  void Upload(GLuint buffer, std::size_t offset, std::size_t size, const void* data) override
+  {
+    mUploadCount++;
+    if (buffer == GetBuffer()) {
+      bValid &= bBufferAlive && offset + size <= mBuffer.size();
+      if (offset + size <= mBuffer.size())
+        std::memcpy(mBuffer.data() + offset, data, size);
+      return;
+    }
+    const auto spill = mSpillBuffers.find(buffer);
+    bValid &= spill != mSpillBuffers.end() && offset + size <= spill->second.size();
+    if (spill != mSpillBuffers.end() && offset + size <= spill->second.size())
+      std::memcpy(spill->second.data() + offset, data, size);
+  }
+  YEAGER_NODISCARD std::size_t GetOffsetAlignment(GLenum target) override { return 16; }
+
+  GLsync InsertFence() override
+  {
+    mFences[++mLastFence] = bSignalFences;
+    return reinterpret_cast<GLsync>(mLastFence);
+  }
+  /* A wait with a timeout signals the fence, the GPU catches up while the CPU blocks */
+  bool WaitFence(GLsync fence, uint64_t timeout) override
+  {
+    const auto it = mFences.find(reinterpret_cast<uintptr_t>(fence));
+    bValid &= it != mFences.end();
+    if (it == mFences.end())
+      return true;
+    if (!it->second && timeout > 0) {
+      it->second = true;
+      mBlockingWaitCount++;
+    }
+    return it->second;
+  }
+  void DeleteFence(GLsync fence) override { bValid &= mFences.erase(reinterpret_cast<uintptr_t>(fence)) == 1; }
+
+  /** @brief When false, the fences inserted from now on stay unsignaled until SignalFences or a blocking wait */
+  void SetSignalFences(bool signal) { bSignalFences = signal; }
+  void SignalFences()
+  {
+    for (auto& [fence, signaled] : mFences) {
+      signaled = true;
+    }
+  }
+
+  /** @brief What the GPU would read from the ring buffer */
+  YEAGER_NODISCARD const unsigned char* GetBufferData() const { return mBuffer.data(); }
+  /** @brief What the GPU would read from a spill buffer, null once it is deleted */
+  YEAGER_NODISCARD const unsigned char* GetSpillBufferData(GLuint buffer) const
+  {
+    const auto it = mSpillBuffers.find(buffer);
+    return it != mSpillBuffers.end() ? it->second.data() : YEAGER_NULLPTR;
+  }
+  YEAGER_NODISCARD std::size_t GetLiveFenceCount() const { return mFences.size(); }
+  YEAGER_NODISCARD std::size_t GetLiveSpillBufferCount() const { return mSpillBuffers.size(); }
+  YEAGER_NODISCARD bool IsBufferAlive() const { return bBufferAlive; }
+  YEAGER_NODISCARD Uint GetBlockingWaitCount() const { return mBlockingWaitCount; }
+  YEAGER_NODISCARD Uint GetUploadCount() const { return mUploadCount; }
+  /** @brief False once a deleted or unknown fence or buffer was used, or a range was outside of its buffer */
+  YEAGER_NODISCARD bool IsValid() const { return bValid; }
+
+ private:
+  std::vector<unsigned char> mBuffer;
+  std::map<GLuint, std::vector<unsigned char>> mSpillBuffers;
+  /* Fences alive and whether they are signaled */
+  std::map<uintptr_t, bool> mFences;
+  GLuint mLastSpillBuffer = 1;
+  uintptr_t mLastFence = 0;
+  Uint mBlockingWaitCount = 0;
+  Uint mUploadCount = 0;
+  bool bMapped = true;
+  bool bBufferAlive = false;
+  bool bSignalFences = true;
+  bool bValid = true;
+};
+
+}  // namespace Yeager::Test
@@ -0,0 +1,167 @@
+#include "Components/Kernel/Caching/MeshCache.h"
+#include "Components/Loader/Importer.h"
+
+#include <chrono>
+using namespace Yeager;
+
+/**
+ * Imports every model under the folder given (Templates/ by default) with assimp, as static and as animated, writes
+ * them with MeshCache::Write, loads them back with MeshCache::Load and compares the vertices, indices, textures and
+ * bones. Prints the import time against the cache load time, and fails if any model differs or cannot be cached. The
+ * importer runs without an application, so no texture is decoded
+ */
+
+static const std::vector<String> sModelExtensions = {".obj", ".fbx", ".gltf", ".glb", ".dae", ".3ds", ".blend"};
+
+static double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* The cache keeps the path and type of each texture, the loaded ones only record them */
+static MeshCacheTextureLoader MakeTextureLoader(CommonModelData* data)
+{
+  return [data](const String& path, const String& type) {
+    std::shared_ptr<MaterialTexture2D> texture = std::make_shared<MaterialTexture2D>();
+    texture->SetName(type.c_str());
+    texture->GetTextureDataHandle()->Path = path;
+    data->TexturesLoaded.push_back(texture);
+    return texture.get();
+  };
+}
+
+template <typename MeshType>
+static bool SameMeshes(const std::vector<MeshType>& imported, const std::vector<MeshType>& loaded, const String& model)
+{
+  if (imported.size() != loaded.size()) {
+    Yeager::Log(ERROR, "{}: {} meshes imported, {} loaded from the cache", model, imported.size(), loaded.size());
+    return false;
+  }
+
+  bool same = true;
+  for (std::size_t x = 0; x < imported.size(); x++) {
+    const auto vertices = imported[x].GetVertices();
+    const auto cachedVertices = loaded[x].GetVertices();
+    if (vertices.size() != cachedVertices.size() ||
+        std::memcmp(vertices.data(), cachedVertices.data(), vertices.size_bytes()) != 0) {
+      Yeager::Log(ERROR, "{}: vertices of mesh {} differ from the cache", model, x);
+      same = false;
+    }
+
+    const auto indices = imported[x].GetIndices();
+    const auto cachedIndices = loaded[x].GetIndices();
+    if (!std::equal(indices.begin(), indices.end(), cachedIndices.begin(), cachedIndices.end())) {
+      Yeager::Log(ERROR, "{}: indices of mesh {} differ from the cache", model, x);
+      same = false;
+    }
+
+    const auto& textures = imported[x].Textures;
+    const auto& cachedTextures = loaded[x].Textures;
+    bool sameTextures = textures.size() == cachedTextures.size();
+    for (std::size_t y = 0; sameTextures && y < textures.size(); y++) {
+      sameTextures = textures[y]->GetPath() == cachedTextures[y]->GetPath() &&
+                     textures[y]->GetName() == cachedTextures[y]->GetName();
+    }
+    if (!sameTextures) {
+      Yeager::Log(ERROR, "{}: textures of mesh {} differ from the cache", model, x);
+      same = false;
+    }
+  }
+  return same;
+}
+
+static bool SameBones(const AnimatedObjectModelData& imported, const AnimatedObjectModelData& loaded,
+                      const String& model)
+{
+  bool same = imported.m_BoneCounter == loaded.m_BoneCounter &&
+              imported.m_BoneInfoMap.size() == loaded.m_BoneInfoMap.size();
+  for (const auto& [name, info] : imported.m_BoneInfoMap) {
+    const auto it = loaded.m_BoneInfoMap.find(name);
+    same = same && it != loaded.m_BoneInfoMap.end() && it->second.ID == info.ID && it->second.OffSet == info.OffSet;
+  }
+  if (!same)
+    Yeager::Log(ERROR, "{}: bones differ from the cache", model);
+  return same;
+}
+
+/* Imports the model, round trips it through the cache and reports both times, returns false if anything differs */
+template <typename ModelData, typename ImportFun>
+static bool CheckModel(const String& path, const String& cacheFolder, MeshCacheKind::Enum kind, Uint assimpFlags,
+                       ImportFun&& import)
+{
+  auto start = std::chrono::steady_clock::now();
+  ModelData imported = import(path);
+  const double importTime = MillisecondsSince(start);
+  if (!imported.SuccessfulLoaded) {
+    Yeager::Log(ERROR, "{}: cannot be imported", path);
+    return false;
+  }
+
+  const std::optional<uint64_t> key = MeshCache::ComputeKey(path, assimpFlags, kind, YEAGER_NULL_LITERAL);
+  if (!key.has_value())
+    return false;
+  MeshCacheEntry entry;
+  entry.Key = key.value();
+  entry.Path = MeshCache::BuildCachePath(cacheFolder, entry.Key);
+  if (!MeshCache::Write(entry, imported)) {
+    Yeager::Log(ERROR, "{}: cannot be written to the mesh cache", path);
+    return false;
+  }
+
+  ModelData loaded;
+  start = std::chrono::steady_clock::now();
+  const bool cached = MeshCache::Load(entry, &loaded, MakeTextureLoader(&loaded));
+  const double loadTime = MillisecondsSince(start);
+  if (!cached) {
+    Yeager::Log(ERROR, "{}: cannot be loaded from the mesh cache it just wrote", path);
+    return false;
+  }
+
+  bool same = SameMeshes(imported.Meshes, loaded.Meshes, path);
+  if constexpr (std::is_same_v<ModelData, AnimatedObjectModelData>)
+    same = SameBones(imported, loaded, path) && same;
+
+  fmt::print("  {:<60} {:<9} {:>6} meshes   import {:>9.3f} ms   cache {:>9.3f} ms   {}\n", path,
+             kind == MeshCacheKind::eANIMATED ? "animated" : "static", imported.Meshes.size(), importTime, loadTime,
+             same ? "same" : "DIFFERENT");
+  return same;
+}
+
+int main(int argc, char** argv)
+{
+  const std::filesystem::path folder = argc > 1 ? argv[1] : "Templates";
+  const std::filesystem::path cacheFolder = std::filesystem::temp_directory_path() / "YeagerMeshCacheCheck";
+  std::error_code error;
+  std::filesystem::create_directories(cacheFolder, error);
+
+  std::vector<String> models;
+  for (const auto& file : std::filesystem::recursive_directory_iterator(folder, error)) {
+    String extension = file.path().extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (file.is_regular_file() &&
+        std::find(sModelExtensions.begin(), sModelExtensions.end(), extension) != sModelExtensions.end())
+      models.push_back(file.path().string());
+  }
+  std::sort(models.begin(), models.end());
+  if (models.empty()) {
+    fmt::print("No model found under {}\n", folder.string());
+    return 1;
+  }
+
+  JobSystem::Initialize();
+  Uint failed = 0;
+  for (const String& model : models) {
+    Importer importer("MeshCacheCheck");
+    failed += !CheckModel<ObjectModelData>(model, cacheFolder.string(), MeshCacheKind::eSTATIC,
+                                           YEAGER_ASSIMP_DEFAULT_FLAGS,
+                                           [&importer](const String& path) { return importer.Import(path.c_str()); });
+    failed += !CheckModel<AnimatedObjectModelData>(
+        model, cacheFolder.string(), MeshCacheKind::eANIMATED, YEAGER_ASSIMP_DEFAULT_FLAGS_ANIMATED,
+        [&importer](const String& path) { return importer.ImportAnimated(path.c_str()); });
+  }
+  JobSystem::Terminate();
+
+  std::filesystem::remove_all(cacheFolder, error);
+  fmt::print("{} of {} imports round trip through the mesh cache\n", models.size() * 2 - failed, models.size() * 2);
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+#include "Framework/YeagerTest.h"
+#include "Common/Math/AABBTree.h"
+
+#include <random>
+#include <set>
+using namespace Yeager;
+
+/* Random boxes in a cube of 1000 units, the proxies user data is the index of the box plus one */
+struct TestScene {
+  AABBTree Tree;
+  std::vector<AABB> Boxes;
+  std::vector<int> Proxies;
+
+  TestScene(std::size_t count, uint32_t seed)
+  {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+    for (std::size_t x = 0; x < count; x++) {
+      const Vector3 center(position(random), position(random), position(random));
+      const Vector3 extents(size(random));
+      Boxes.push_back(AABB(center - extents, center + extents));
+      Proxies.push_back(Tree.CreateProxy(Boxes.back(), reinterpret_cast<void*>(x + 1)));
+    }
+  }
+
+  YEAGER_NODISCARD bool IsAlive(std::size_t box) const { return Proxies[box] != YEAGER_AABB_TREE_NULL_NODE; }
+};
+
+static std::size_t UserDataToBox(void* userData)
+{
+  return reinterpret_cast<std::size_t>(userData) - 1;
+}
+
+YEAGER_TEST(AABBTree, BoxQueryMatchesBruteForce)
+{
+  TestScene scene(5000, 1);
+  for (std::size_t x = 0; x < scene.Boxes.size(); x += 7) {
+    scene.Tree.DestroyProxy(scene.Proxies[x]);
+    scene.Proxies[x] = YEAGER_AABB_TREE_NULL_NODE;
+  }
+
+  const AABB query(Vector3(-100.0f, -50.0f, -200.0f), Vector3(150.0f, 80.0f, 60.0f));
+  std::set<std::size_t> reported;
+  scene.Tree.Query(query, [&reported](void* userData) { reported.insert(UserDataToBox(userData)); });
+
+  std::set<std::size_t> expected;
+  for (std::size_t x = 0; x < scene.Boxes.size(); x++) {
+    if (scene.IsAlive(x) && scene.Tree.GetFatAABB(scene.Proxies[x]).Overlaps(query))
+      expected.insert(x);
+  }
+  YEAGER_EXPECT(!expected.empty());
+  YEAGER_EXPECT(reported == expected);
+}
+
+YEAGER_TEST(AABBTree, FrustumQueryReportsEveryVisibleProxy)
+{
+  TestScene scene(20000, 2);
+  std::mt19937 random(3);
+  std::uniform_real_distribution<float> offset(-5.0f, 5.0f);
+  for (std::size_t x = 0; x < scene.Boxes.size(); x += 3) {
+    const Vector3 move(offset(random), offset(random), offset(random));
+    scene.Boxes[x] = AABB(scene.Boxes[x].Min + move, scene.Boxes[x].Max + move);
+    scene.Tree.MoveProxy(scene.Proxies[x], scene.Boxes[x]);
+  }
+
+  const Matrix4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+  const Matrix4 view = glm::lookAt(Vector3(0.0f), Vector3(1.0f, 0.2f, 0.5f), Vector3(0.0f, 1.0f, 0.0f));
+  const Frustum frustum = Frustum::FromMatrix(projection * view);
+
+  std::set<std::size_t> reported;
+  scene.Tree.QueryFrustum(frustum, [&reported](void* userData) { reported.insert(UserDataToBox(userData)); });
+
+  std::size_t visible = 0;
+  for (std::size_t x = 0; x < scene.Boxes.size(); x++) {
+    if (frustum.Intersects(scene.Boxes[x])) {
+      visible++;
+      YEAGER_EXPECT(reported.count(x) == 1);
+    }
+  }
+  /* The tree tests the fat boxes, so it may report a few proxies just outside, but never one whose fat box is out */
+  for (const std::size_t box : reported) {
+    YEAGER_EXPECT(frustum.Intersects(scene.Tree.GetFatAABB(scene.Proxies[box])));
+  }
+  YEAGER_EXPECT(visible > 0);
+  YEAGER_EXPECT(visible < scene.Boxes.size());
+}
+
+YEAGER_TEST(AABBTree, SmallMovesStayInsideTheFatBox)
+{
+  AABBTree tree(1.0f);
+  const AABB box(Vector3(0.0f), Vector3(1.0f));
+  const int proxy = tree.CreateProxy(box, YEAGER_NULLPTR);
+  YEAGER_EXPECT(tree.GetFatAABB(proxy).Contains(box));
+
+  const AABB nudged(Vector3(0.5f), Vector3(1.5f));
+  YEAGER_EXPECT(!tree.MoveProxy(proxy, nudged));
+  YEAGER_EXPECT(tree.GetFatAABB(proxy).Contains(nudged));
+
+  const AABB moved(Vector3(10.0f), Vector3(11.0f));
+  YEAGER_EXPECT(tree.MoveProxy(proxy, moved));
+  YEAGER_EXPECT(tree.GetFatAABB(proxy).Contains(moved));
+}
+
+YEAGER_TEST(AABBTree, StaysBalancedForSortedInsertions)
+{
+  AABBTree tree;
+  /* Boxes along a line, inserted in order, the worst case for a tree without rotations */
+  for (Uint x = 0; x < 4096; x++) {
+    const Vector3 min(static_cast<float>(x) * 2.0f, 0.0f, 0.0f);
+    tree.CreateProxy(AABB(min, min + Vector3(1.0f)), YEAGER_NULLPTR);
+  }
+  YEAGER_EXPECT_EQ(tree.GetProxyCount(), 4096u);
+  YEAGER_EXPECT(tree.GetHeight() <= 24);
+}
+
+YEAGER_TEST(AABBTree, ClearRemovesEveryProxy)
+{
+  TestScene scene(100, 4);
+  scene.Tree.Clear();
+  YEAGER_EXPECT_EQ(scene.Tree.GetProxyCount(), 0u);
+  Uint reported = 0;
+  scene.Tree.Query(AABB(Vector3(-1000.0f), Vector3(1000.0f)), [&reported](void*) { reported++; });
+  YEAGER_EXPECT_EQ(reported, 0u);
+}
@@ -0,0 +1,203 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Renderer/AnimationEngine/AnimationCompression.h"
+
+#include <random>
+using namespace Yeager;
+
+/* Clip sampled on every tick at 30 ticks per second, 601 frames, as the exporters bake the animations */
+static YEAGER_CONSTEXPR float sTicksPerSecond = 30.0f;
+static YEAGER_CONSTEXPR Uint sFrames = 601;
+
+/* Smooth curves with a linear stretch and a still stretch, the parts the reduction removes, and fast parts it keeps */
+static Bone MakeChannel(const String& name, uint32_t seed)
+{
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> value(0.5f, 3.0f);
+  const float speed = value(random), phase = value(random), amplitude = value(random);
+
+  std::vector<KeyPosition> positions;
+  std::vector<KeyRotation> rotations;
+  std::vector<KeyScale> scales;
+  for (Uint x = 0; x < sFrames; x++) {
+    const float time = static_cast<float>(x);
+    const float seconds = time / sTicksPerSecond;
+    const float wave = x < 200 ? std::sin(seconds * speed + phase) : x < 400 ? seconds * 0.1f : 0.0f;
+    positions.push_back(KeyPosition{Vector3(wave * amplitude, wave * 0.5f, 2.0f), time});
+    const Vector3 axis = glm::normalize(Vector3(1.0f, phase, 0.5f));
+    const float angle = std::sin(seconds * speed) * 1.5f;
+    rotations.push_back(KeyRotation{
+        glm::quat(std::cos(angle * 0.5f), axis.x * std::sin(angle * 0.5f), axis.y * std::sin(angle * 0.5f),
+                  axis.z * std::sin(angle * 0.5f)),
+        time});
+    scales.push_back(KeyScale{Vector3(1.0f + 0.2f * std::sin(seconds * speed * 0.5f)), time});
+  }
+  return Bone(name, -1, std::move(positions), std::move(rotations), std::move(scales));
+}
+
+/* The value the bones sample at the time, from the key at or before it towards the next one */
+template <typename KeyType, typename MixFun>
+static auto SampleKeys(const std::vector<KeyType>& keys, float time, MixFun&& mix)
+{
+  int cursor = 0;
+  const std::size_t index = FindKeyIndex(keys, time, cursor);
+  if (keys.size() == 1)
+    return mix(keys[0], keys[0], 0.0f);
+  const float gap = keys[index + 1].TimeStamp - keys[index].TimeStamp;
+  const float factor = gap > 0.0f ? std::clamp((time - keys[index].TimeStamp) / gap, 0.0f, 1.0f) : 0.0f;
+  return mix(keys[index], keys[index + 1], factor);
+}
+
+static Vector3 SamplePosition(const std::vector<KeyPosition>& keys, float time)
+{
+  return SampleKeys(keys, time, [](const KeyPosition& first, const KeyPosition& second, float factor) {
+    return glm::mix(first.Position, second.Position, factor);
+  });
+}
+
+static Vector3 SampleScale(const std::vector<KeyScale>& keys, float time)
+{
+  return SampleKeys(keys, time, [](const KeyScale& first, const KeyScale& second, float factor) {
+    return glm::mix(first.Scale, second.Scale, factor);
+  });
+}
+
+static glm::quat SampleRotation(const std::vector<KeyRotation>& keys, float time)
+{
+  return SampleKeys(keys, time, [](const KeyRotation& first, const KeyRotation& second, float factor) {
+    return glm::normalize(glm::slerp(first.Orientation, second.Orientation, factor));
+  });
+}
+
+/* Angle between two rotations, q and -q are the same one. atan2 keeps the precision of the small angles acos loses */
+static float RotationError(const glm::quat& first, const glm::quat& second)
+{
+  const glm::quat delta = glm::conjugate(glm::normalize(first)) * glm::normalize(second);
+  return 2.0f * std::atan2(glm::length(Vector3(delta.x, delta.y, delta.z)), std::abs(delta.w));
+}
+
+YEAGER_TEST(AnimationCompression, ReducedKeysStayWithinTheTolerance)
+{
+  static YEAGER_CONSTEXPR float sTolerance = 0.001f;
+  for (uint32_t seed = 0; seed < 8; seed++) {
+    Bone channel = MakeChannel("Bone", seed);
+    const auto& sourcePositions = channel.GetPositionKeys();
+    const auto& sourceRotations = channel.GetRotationKeys();
+    const auto& sourceScales = channel.GetScaleKeys();
+
+    const std::vector<KeyPosition> positions = ReducePositionKeys(sourcePositions, sTolerance);
+    const std::vector<KeyRotation> rotations = ReduceRotationKeys(sourceRotations, sTolerance);
+    const std::vector<KeyScale> scales = ReduceScaleKeys(sourceScales, sTolerance);
+    YEAGER_EXPECT(positions.size() < sourcePositions.size() / 2);
+    YEAGER_EXPECT(rotations.size() < sourceRotations.size());
+    YEAGER_EXPECT(scales.size() < sourceScales.size() / 2);
+
+    /* The first and last keys are kept, so the clamping outside the track does not change */
+    YEAGER_EXPECT_EQ(positions.front().TimeStamp, sourcePositions.front().TimeStamp);
+    YEAGER_EXPECT_EQ(positions.back().TimeStamp, sourcePositions.back().TimeStamp);
+    YEAGER_EXPECT_EQ(rotations.back().TimeStamp, sourceRotations.back().TimeStamp);
+
+    float positionError = 0.0f, rotationError = 0.0f, scaleError = 0.0f;
+    for (Uint x = 0; x < sFrames; x++) {
+      const float time = sourcePositions[x].TimeStamp;
+      const Vector3 position = SamplePosition(positions, time);
+      positionError = std::max(positionError, glm::length(position - sourcePositions[x].Position));
+      const glm::quat rotation = SampleRotation(rotations, time);
+      rotationError = std::max(rotationError, RotationError(rotation, sourceRotations[x].Orientation));
+      scaleError = std::max(scaleError, glm::length(SampleScale(scales, time) - sourceScales[x].Scale));
+    }
+    YEAGER_EXPECT(positionError <= sTolerance);
+    YEAGER_EXPECT(rotationError <= sTolerance * 1.01f);
+    YEAGER_EXPECT(scaleError <= sTolerance);
+  }
+}
+
+YEAGER_TEST(AnimationCompression, ConstantAndLinearTracksKeepTheirEnds)
+{
+  std::vector<KeyPosition> still, linear;
+  for (Uint x = 0; x < 100; x++) {
+    still.push_back(KeyPosition{Vector3(1.0f, 2.0f, 3.0f), static_cast<float>(x)});
+    linear.push_back(KeyPosition{Vector3(static_cast<float>(x), 0.0f, 0.0f), static_cast<float>(x)});
+  }
+  YEAGER_EXPECT_EQ(ReducePositionKeys(still, 0.001f).size(), std::size_t(1));
+  YEAGER_EXPECT_EQ(ReducePositionKeys(linear, 0.001f).size(), std::size_t(2));
+  YEAGER_EXPECT_EQ(ReducePositionKeys(std::vector<KeyPosition>(), 0.001f).size(), std::size_t(0));
+
+  /* A segment skips a bounded amount of keys, so a long linear track keeps a key every so often and stays linear */
+  std::vector<KeyPosition> longLinear;
+  for (Uint x = 0; x < 100000; x++) {
+    longLinear.push_back(KeyPosition{Vector3(static_cast<float>(x) * 0.001f, 0.0f, 0.0f), static_cast<float>(x)});
+  }
+  const std::vector<KeyPosition> reduced = ReducePositionKeys(longLinear, 0.001f);
+  YEAGER_EXPECT(reduced.size() < longLinear.size() / 100);
+  YEAGER_EXPECT_EQ(reduced.back().TimeStamp, longLinear.back().TimeStamp);
+}
+
+YEAGER_TEST(AnimationCompression, DecompressedClipStaysWithinTheBounds)
+{
+  std::vector<Bone> channels;
+  for (Uint x = 0; x < 20; x++) {
+    channels.push_back(MakeChannel("Bone" + std::to_string(x), 100 + x));
+  }
+  const AnimationCompressionSettings settings;
+  const CompressedAnimationClip clip =
+      CompressAnimationClip("Clip", static_cast<float>(sFrames - 1), sTicksPerSecond, channels, settings);
+  YEAGER_EXPECT_EQ(clip.Tracks.size(), channels.size());
+  /* Every key is on a tick, the times are stored as exact ticks */
+  YEAGER_EXPECT_EQ(clip.TimeStep, 1.0f);
+  YEAGER_EXPECT(clip.GetKeyCount() < std::size_t(sFrames) * 3 * channels.size() / 2);
+
+  float positionError = 0.0f, rotationError = 0.0f, scaleError = 0.0f;
+  float positionBound = 0.0f, scaleBound = 0.0f;
+  bool namesKept = true;
+  for (std::size_t track = 0; track < clip.Tracks.size(); track++) {
+    std::vector<KeyPosition> positions;
+    std::vector<KeyRotation> rotations;
+    std::vector<KeyScale> scales;
+    DecompressBoneTrack(clip, clip.Tracks[track], positions, rotations, scales);
+    namesKept &= clip.Tracks[track].Name == channels[track].GetBoneName();
+
+    /* The quantization adds half a step of the range of the track on each axis */
+    const QuantizedVectorTrack& quantized = clip.Tracks[track].Positions;
+    positionBound = std::max(positionBound, glm::length(quantized.Extent) * 0.5f / 65535.0f);
+    scaleBound = std::max(scaleBound, glm::length(clip.Tracks[track].Scales.Extent) * 0.5f / 65535.0f);
+
+    const Bone& source = channels[track];
+    for (Uint x = 0; x < sFrames; x++) {
+      const float time = source.GetPositionKeys()[x].TimeStamp;
+      positionError = std::max(positionError,
+                               glm::length(SamplePosition(positions, time) - source.GetPositionKeys()[x].Position));
+      rotationError = std::max(rotationError,
+                               RotationError(SampleRotation(rotations, time), source.GetRotationKeys()[x].Orientation));
+      scaleError = std::max(scaleError, glm::length(SampleScale(scales, time) - source.GetScaleKeys()[x].Scale));
+    }
+  }
+  YEAGER_EXPECT(namesKept);
+  YEAGER_EXPECT(positionError <= settings.PositionTolerance + positionBound + 1e-5f);
+  YEAGER_EXPECT(scaleError <= settings.ScaleTolerance + scaleBound + 1e-5f);
+  /* The smallest three packing is within 0.01 degrees */
+  YEAGER_EXPECT(rotationError <= settings.RotationTolerance + glm::radians(0.01f));
+}
+
+YEAGER_TEST(AnimationCompression, TimesOutOfTheFrameGridUseTheWholeRange)
+{
+  std::vector<KeyPosition> positions;
+  for (Uint x = 0; x < 50; x++) {
+    positions.push_back(KeyPosition{Vector3(static_cast<float>(x * x), 0.0f, 0.0f), std::sqrt(static_cast<float>(x))});
+  }
+  std::vector<Bone> channels = {Bone("Bone", -1, positions, {}, {})};
+  const CompressedAnimationClip clip =
+      CompressAnimationClip("Clip", 8.0f, 25, channels, AnimationCompressionSettings());
+  YEAGER_EXPECT_NEAR(clip.TimeStep, std::sqrt(49.0f) / 65535.0f, 1e-7);
+
+  std::vector<KeyPosition> decompressed;
+  std::vector<KeyRotation> rotations;
+  std::vector<KeyScale> scales;
+  DecompressBoneTrack(clip, clip.Tracks[0], decompressed, rotations, scales);
+  YEAGER_EXPECT(rotations.empty() && scales.empty());
+  YEAGER_EXPECT_EQ(decompressed.size(), positions.size());
+  float timeError = 0.0f;
+  for (std::size_t x = 0; x < decompressed.size(); x++) {
+    timeError = std::max(timeError, std::abs(decompressed[x].TimeStamp - positions[x].TimeStamp));
+  }
+  YEAGER_EXPECT(timeError <= clip.TimeStep);
+}
@@ -0,0 +1,165 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Kernel/Process/JobSystem.h"
+#include "Components/Renderer/AnimationEngine/BonePalette.h"
+#include "Components/Renderer/AnimationEngine/Skeleton.h"
+
+#include <random>
+using namespace Yeager;
+
+/* What an animated object keeps to evaluate its pose, the skeleton of its animation and its own bones and buffers */
+struct TestAnimatedInstance {
+  CompiledSkeleton Skeleton;
+  std::vector<Bone> Bones;
+  std::vector<Matrix4> GlobalTransforms;
+  Uint BoneCount = 0;
+  float Time = 0.0f;
+  Uint PaletteOffset = 0;
+};
+
+static Matrix4 RandomTransform(std::mt19937& random)
+{
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  const glm::quat rotation = glm::normalize(glm::quat(value(random), value(random), value(random), value(random)));
+  Matrix4 transform = glm::toMat4(rotation);
+  transform[3] = Vector4(value(random), value(random), value(random), 1.0f);
+  return transform;
+}
+
+/* A tree where every node is the child of a random node before it, skinned to its own slot, most of them animated */
+static TestAnimatedInstance MakeInstance(std::mt19937& random, Uint boneCount)
+{
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  TestAnimatedInstance instance;
+  instance.BoneCount = boneCount;
+  instance.Time = std::uniform_real_distribution<float>(0.0f, 20.0f)(random);
+  for (Uint x = 0; x < boneCount; x++) {
+    int channel = -1;
+    if (x % 5 != 0) {
+      std::vector<KeyPosition> positions;
+      std::vector<KeyRotation> rotations;
+      std::vector<KeyScale> scales;
+      for (Uint key = 0; key < 20; key++) {
+        const float time = static_cast<float>(key);
+        positions.push_back(KeyPosition{Vector3(value(random), value(random), value(random)), time});
+        rotations.push_back(KeyRotation{glm::quat(value(random), value(random), value(random), value(random)), time});
+        scales.push_back(KeyScale{Vector3(1.0f + value(random) * 0.2f), time});
+      }
+      channel = static_cast<int>(instance.Bones.size());
+      instance.Bones.push_back(Bone("Bone" + std::to_string(x), static_cast<int>(x), positions, rotations, scales));
+    }
+
+    instance.Skeleton.ParentIndices.push_back(x == 0 ? -1 : static_cast<int>(random() % x));
+    instance.Skeleton.ChannelIndices.push_back(channel);
+    instance.Skeleton.BoneIndices.push_back(static_cast<int>(x));
+    instance.Skeleton.BindTransforms.push_back(RandomTransform(random));
+    instance.Skeleton.BoneOffsets.push_back(RandomTransform(random));
+  }
+  return instance;
+}
+
+static std::vector<AnimatedVertexData> MakeVertices(std::mt19937& random, Uint count, Uint boneCount)
+{
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  std::vector<AnimatedVertexData> vertices(count);
+  for (AnimatedVertexData& vertex : vertices) {
+    vertex.Position = Vector3(value(random), value(random), value(random));
+    float total = 0.0f;
+    for (Uint x = 0; x < MAX_BONE_INFLUENCE; x++) {
+      vertex.BonesIDs[x] = x == MAX_BONE_INFLUENCE - 1 ? -1 : static_cast<int>(random() % boneCount);
+      vertex.Weights[x] = x == MAX_BONE_INFLUENCE - 1 ? 0.0f : 0.1f + std::abs(value(random));
+      total += vertex.Weights[x];
+    }
+    for (float& weight : vertex.Weights) {
+      weight /= total;
+    }
+  }
+  return vertices;
+}
+
+YEAGER_TEST(BonePalette, ParallelEvaluationMatchesTheSerialOne)
+{
+  static YEAGER_CONSTEXPR Uint sInstances = 200;
+  JobSystem::Initialize(4);
+  std::mt19937 random(11);
+
+  std::vector<TestAnimatedInstance> instances;
+  for (Uint x = 0; x < sInstances; x++) {
+    instances.push_back(MakeInstance(random, 1 + random() % 100));
+  }
+  /* Same instances evaluated one after the other into their own arrays, as each engine did before the palette */
+  std::vector<TestAnimatedInstance> serial = instances;
+
+  BonePaletteBuffer palette;
+  for (Uint frame = 0; frame < 3; frame++) {
+    /* Placed before the jobs run, as UpdateAnimations does, so the staging array does not move under them */
+    palette.Clear();
+    Uint expectedOffset = 0;
+    bool contiguous = true;
+    for (TestAnimatedInstance& instance : instances) {
+      instance.PaletteOffset = palette.Allocate(instance.BoneCount);
+      contiguous &= instance.PaletteOffset == expectedOffset;
+      expectedOffset += instance.BoneCount;
+    }
+    YEAGER_EXPECT(contiguous);
+    YEAGER_EXPECT_EQ(palette.GetStaging().size(), std::size_t(expectedOffset));
+
+    JobSystem::ParallelFor(sInstances, 0, [&instances, &palette, frame](Uint begin, Uint end) {
+      for (Uint x = begin; x < end; x++) {
+        TestAnimatedInstance& instance = instances[x];
+        EvaluateSkeleton(instance.Skeleton, instance.Bones, instance.Time + frame * 0.4f, instance.GlobalTransforms,
+                         palette.GetPalette(instance.PaletteOffset, instance.BoneCount));
+      }
+    });
+
+    bool samePalettes = true, sameSkinning = true;
+    for (Uint x = 0; x < sInstances; x++) {
+      TestAnimatedInstance& instance = serial[x];
+      std::vector<Matrix4> finalMatrices(instance.BoneCount, Matrix4(1.0f));
+      EvaluateSkeleton(instance.Skeleton, instance.Bones, instance.Time + frame * 0.4f, instance.GlobalTransforms,
+                       finalMatrices);
+
+      const std::span<const Matrix4> slice =
+          palette.GetStaging().subspan(instances[x].PaletteOffset, instances[x].BoneCount);
+      samePalettes &= std::equal(slice.begin(), slice.end(), finalMatrices.begin(), finalMatrices.end());
+
+      const std::vector<AnimatedVertexData> vertices = MakeVertices(random, 64, instance.BoneCount);
+      std::vector<Vector3> fromPalette(vertices.size()), fromSerial(vertices.size());
+      SkinVerticesReference(vertices, slice, fromPalette);
+      SkinVerticesReference(vertices, finalMatrices, fromSerial);
+      sameSkinning &= fromPalette == fromSerial;
+    }
+    YEAGER_EXPECT(samePalettes);
+    YEAGER_EXPECT(sameSkinning);
+  }
+  JobSystem::Terminate();
+}
+
+YEAGER_TEST(BonePalette, ReferenceSkinningBlendsTheInfluences)
+{
+  std::vector<Matrix4> palette = {Matrix4(1.0f), Matrix4(1.0f)};
+  palette[1][3] = Vector4(2.0f, 0.0f, 0.0f, 1.0f);
+
+  AnimatedVertexData vertex;
+  vertex.Position = Vector3(1.0f, 2.0f, 3.0f);
+  vertex.BonesIDs[0] = 0;
+  vertex.BonesIDs[1] = 1;
+  vertex.BonesIDs[2] = -1;
+  vertex.BonesIDs[3] = -1;
+  vertex.Weights[0] = 0.5f;
+  vertex.Weights[1] = 0.5f;
+  vertex.Weights[2] = 1.0f;
+  vertex.Weights[3] = 1.0f;
+
+  /* The unused influences are skipped whatever their weight */
+  std::vector<AnimatedVertexData> vertices = {vertex};
+  std::vector<Vector3> output(1);
+  SkinVerticesReference(vertices, palette, output);
+  YEAGER_EXPECT_NEAR(output[0].x, 2.0f, 1e-6);
+  YEAGER_EXPECT_NEAR(output[0].y, 2.0f, 1e-6);
+
+  /* An id past the palette keeps the bind pose, as the shaders do */
+  vertices[0].BonesIDs[1] = 2;
+  SkinVerticesReference(vertices, palette, output);
+  YEAGER_EXPECT_NEAR(output[0].x, 1.0f, 1e-6);
+  YEAGER_EXPECT_NEAR(output[0].z, 3.0f, 1e-6);
+}
@@ -0,0 +1,120 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Renderer/AnimationEngine/Bone.h"
+
+#include <random>
+using namespace Yeager;
+
+/* Keys at irregular times, as clips reduced by the compression have */
+static std::vector<KeyPosition> MakePositionKeys(Uint count, uint32_t seed)
+{
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> gap(0.1f, 2.0f);
+  std::vector<KeyPosition> keys;
+  float time = 0.5f;
+  for (Uint x = 0; x < count; x++) {
+    keys.push_back(KeyPosition{Vector3(static_cast<float>(x)), time});
+    time += gap(random);
+  }
+  return keys;
+}
+
+/* What the bones did before the cursors, the first key whose next key is after the time */
+template <typename KeyType>
+static int LinearKeyIndex(const std::vector<KeyType>& keys, float time)
+{
+  const int count = static_cast<int>(keys.size());
+  for (int x = 0; x < count - 2; x++) {
+    if (time < keys[x + 1].TimeStamp)
+      return x;
+  }
+  return std::max(count - 2, 0);
+}
+
+YEAGER_TEST(Bone, ForwardPlaybackLoopsLikeTheLinearScan)
+{
+  const std::vector<KeyPosition> keys = MakePositionKeys(200, 1);
+  const float duration = keys.back().TimeStamp + 1.0f;
+  int cursor = 0;
+  bool same = true;
+  /* Three loops, the time wraps to the start of the clip as UpdateAnimation does */
+  for (float step = 0.0f; step < duration * 3.0f; step += 0.037f) {
+    const float time = std::fmod(step, duration);
+    same &= FindKeyIndex(keys, time, cursor) == LinearKeyIndex(keys, time);
+  }
+  YEAGER_EXPECT(same);
+}
+
+YEAGER_TEST(Bone, ReversePlaybackMatchesTheLinearScan)
+{
+  const std::vector<KeyPosition> keys = MakePositionKeys(200, 2);
+  int cursor = static_cast<int>(keys.size()) - 2;
+  bool same = true;
+  for (float time = keys.back().TimeStamp + 0.5f; time > -0.5f; time -= 0.041f) {
+    same &= FindKeyIndex(keys, time, cursor) == LinearKeyIndex(keys, time);
+  }
+  YEAGER_EXPECT(same);
+}
+
+YEAGER_TEST(Bone, SeeksAndTimesOutsideTheTrackMatchTheLinearScan)
+{
+  const std::vector<KeyPosition> keys = MakePositionKeys(500, 3);
+  const float first = keys.front().TimeStamp;
+  const float last = keys.back().TimeStamp;
+  std::mt19937 random(4);
+  std::uniform_real_distribution<float> seek(first - 10.0f, last + 10.0f);
+
+  int cursor = 0;
+  bool same = true, cursorInRange = true;
+  for (Uint x = 0; x < 20000; x++) {
+    /* Mostly random seeks, with short runs of playback from where they land */
+    const float time = x % 4 == 0 ? seek(random) : keys[cursor].TimeStamp + 0.01f * (x % 4);
+    same &= FindKeyIndex(keys, time, cursor) == LinearKeyIndex(keys, time);
+    cursorInRange &= cursor >= 0 && cursor <= static_cast<int>(keys.size()) - 2;
+  }
+  YEAGER_EXPECT(same);
+  YEAGER_EXPECT(cursorInRange);
+
+  /* Exactly on the keys, the key itself is returned, the last one returns the one before it */
+  bool onKeys = true;
+  for (std::size_t x = 0; x < keys.size(); x++) {
+    onKeys &= FindKeyIndex(keys, keys[x].TimeStamp, cursor) == std::min(static_cast<int>(x), 498);
+  }
+  YEAGER_EXPECT(onKeys);
+  YEAGER_EXPECT_EQ(FindKeyIndex(keys, -std::numeric_limits<float>::infinity(), cursor), 0);
+  YEAGER_EXPECT_EQ(FindKeyIndex(keys, std::numeric_limits<float>::infinity(), cursor), 498);
+}
+
+YEAGER_TEST(Bone, ShortTracksReturnTheFirstKey)
+{
+  std::vector<KeyPosition> keys;
+  int cursor = 3;
+  YEAGER_EXPECT_EQ(FindKeyIndex(keys, 1.0f, cursor), 0);
+  keys.push_back(KeyPosition{Vector3(1.0f), 0.0f});
+  YEAGER_EXPECT_EQ(FindKeyIndex(keys, 1.0f, cursor), 0);
+  keys.push_back(KeyPosition{Vector3(2.0f), 1.0f});
+  /* A cursor left by a longer track is out of range and not trusted */
+  YEAGER_EXPECT_EQ(FindKeyIndex(keys, 5.0f, cursor), 0);
+  YEAGER_EXPECT_EQ(cursor, 0);
+}
+
+YEAGER_TEST(Bone, UpdateHoldsTheFirstAndLastKeysOutsideTheTrack)
+{
+  std::vector<KeyPosition> positions = {KeyPosition{Vector3(0.0f), 1.0f}, KeyPosition{Vector3(2.0f, 4.0f, 6.0f), 3.0f}};
+  std::vector<KeyRotation> rotations = {KeyRotation{glm::quat(1.0f, 0.0f, 0.0f, 0.0f), 1.0f}};
+  std::vector<KeyScale> scales = {KeyScale{Vector3(2.0f), 0.0f}};
+  Bone bone("Bone", 0, positions, rotations, scales);
+
+  bone.Update(2.0f);
+  Matrix4 transform = bone.GetLocalTransform();
+  YEAGER_EXPECT_NEAR(transform[3].x, 1.0f, 1e-6);
+  YEAGER_EXPECT_NEAR(transform[3].z, 3.0f, 1e-6);
+  YEAGER_EXPECT_NEAR(transform[0].x, 2.0f, 1e-6);
+
+  bone.Update(-5.0f);
+  transform = bone.GetLocalTransform();
+  YEAGER_EXPECT_NEAR(transform[3].y, 0.0f, 1e-6);
+  bone.Update(50.0f);
+  transform = bone.GetLocalTransform();
+  YEAGER_EXPECT_NEAR(transform[3].y, 4.0f, 1e-6);
+  YEAGER_EXPECT_NEAR(transform[3].w, 1.0f, 1e-6);
+}
@@ -0,0 +1,218 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Renderer/GL/DrawBatching.h"
+
+#include <random>
+using namespace Yeager;
+
+/* The builder only compares the pools, any distinct addresses stand for them */
+static char sPoolStorage[2];
+static GeometryPool* const sFirstPool = reinterpret_cast<GeometryPool*>(&sPoolStorage[0]);
+static GeometryPool* const sSecondPool = reinterpret_cast<GeometryPool*>(&sPoolStorage[1]);
+
+static DrawElementsIndirectCommand MakeCommand(Uint firstIndex, Uint count, int baseVertex = 0, Uint instances = 1)
+{
+  return DrawElementsIndirectCommand{count, instances, firstIndex, baseVertex, 0};
+}
+
+YEAGER_TEST(DrawBatching, RangeAllocatorPicksTheBestFitAndMerges)
+{
+  RangeAllocator ranges(100);
+  YEAGER_EXPECT_EQ(ranges.Allocate(10), 0u);
+  YEAGER_EXPECT_EQ(ranges.Allocate(20), 10u);
+  YEAGER_EXPECT_EQ(ranges.Allocate(30), 30u);
+  YEAGER_EXPECT_EQ(ranges.GetUsed(), 60u);
+
+  /* The hole of 20 fits better than the 40 at the end */
+  YEAGER_EXPECT(ranges.Free(10));
+  YEAGER_EXPECT_EQ(ranges.GetFreeRangeCount(), 2u);
+  YEAGER_EXPECT_EQ(ranges.Allocate(15), 10u);
+  YEAGER_EXPECT_EQ(ranges.GetLargestFreeRange(), 40u);
+  YEAGER_EXPECT_EQ(ranges.Allocate(41), RangeAllocator::sInvalidOffset);
+
+  /* Freed between two free ranges, the three become one */
+  YEAGER_EXPECT(ranges.Free(30));
+  YEAGER_EXPECT_EQ(ranges.GetFreeRangeCount(), 1u);
+  YEAGER_EXPECT_EQ(ranges.GetLargestFreeRange(), 75u);
+  YEAGER_EXPECT(ranges.Free(0));
+  YEAGER_EXPECT_EQ(ranges.GetFreeRangeCount(), 2u);
+  YEAGER_EXPECT(ranges.Free(10));
+  YEAGER_EXPECT_EQ(ranges.GetFreeRangeCount(), 1u);
+  YEAGER_EXPECT_EQ(ranges.GetLargestFreeRange(), 100u);
+  YEAGER_EXPECT_EQ(ranges.GetUsed(), 0u);
+  YEAGER_EXPECT_EQ(ranges.GetAllocationCount(), 0u);
+}
+
+YEAGER_TEST(DrawBatching, RangeAllocatorRejectsWhatItDidNotAllocate)
+{
+  RangeAllocator ranges(64);
+  YEAGER_EXPECT_EQ(ranges.Allocate(0), RangeAllocator::sInvalidOffset);
+  const Uint offset = ranges.Allocate(16);
+  YEAGER_EXPECT(!ranges.Free(offset + 1));
+  YEAGER_EXPECT(ranges.Free(offset));
+  YEAGER_EXPECT(!ranges.Free(offset));
+
+  RangeAllocator empty;
+  YEAGER_EXPECT_EQ(empty.Allocate(1), RangeAllocator::sInvalidOffset);
+}
+
+YEAGER_TEST(DrawBatching, RangeAllocatorGrowsIntoTheFreeTail)
+{
+  RangeAllocator ranges(32);
+  YEAGER_EXPECT_EQ(ranges.Allocate(24), 0u);
+  YEAGER_EXPECT_EQ(ranges.Allocate(16), RangeAllocator::sInvalidOffset);
+  ranges.Grow(64);
+  /* The 8 left at the end of the old capacity merge with the new elements */
+  YEAGER_EXPECT_EQ(ranges.GetFreeRangeCount(), 1u);
+  YEAGER_EXPECT_EQ(ranges.Allocate(40), 24u);
+  ranges.Grow(16);
+  YEAGER_EXPECT_EQ(ranges.GetCapacity(), 64u);
+}
+
+/* Random allocations, frees and growths against an owner per element */
+YEAGER_TEST(DrawBatching, RangeAllocatorMatchesAnElementModel)
+{
+  std::mt19937 random(5);
+  RangeAllocator ranges(256);
+  std::vector<int> owners(256, -1);
+  std::vector<std::pair<Uint, Uint>> live;
+  bool noOverlap = true, failsOnlyWhenFull = true, rangesMaximal = true;
+
+  for (int step = 0; step < 20000; step++) {
+    const Uint action = random() % 10;
+    if (action < 6) {
+      const Uint count = 1 + random() % 48;
+      const Uint offset = ranges.Allocate(count);
+      if (offset == RangeAllocator::sInvalidOffset) {
+        /* Only allowed when no run of free elements is long enough */
+        Uint run = 0, longest = 0;
+        for (const int owner : owners) {
+          run = owner < 0 ? run + 1 : 0;
+          longest = std::max(longest, run);
+        }
+        failsOnlyWhenFull &= longest < count;
+        continue;
+      }
+      for (Uint x = offset; x < offset + count; x++) {
+        noOverlap &= x < owners.size() && owners[x] < 0;
+        if (x < owners.size())
+          owners[x] = step;
+      }
+      live.emplace_back(offset, count);
+    } else if (action < 9 && !live.empty()) {
+      const std::size_t position = random() % live.size();
+      const auto [offset, count] = live[position];
+      live[position] = live.back();
+      live.pop_back();
+      ranges.Free(offset);
+      std::fill(owners.begin() + offset, owners.begin() + offset + count, -1);
+    } else if (ranges.GetCapacity() < 4096) {
+      const Uint capacity = ranges.GetCapacity() + 1 + random() % 128;
+      ranges.Grow(capacity);
+      owners.resize(capacity, -1);
+    }
+
+    /* Merged ranges: as many free ranges as runs of free elements */
+    Uint runs = 0;
+    for (std::size_t x = 0; x < owners.size(); x++) {
+      runs += owners[x] < 0 && (x == 0 || owners[x - 1] >= 0);
+    }
+    rangesMaximal &= runs == ranges.GetFreeRangeCount();
+  }
+
+  YEAGER_EXPECT(noOverlap);
+  YEAGER_EXPECT(failsOnlyWhenFull);
+  YEAGER_EXPECT(rangesMaximal);
+  const auto used = std::count_if(owners.begin(), owners.end(), [](int owner) { return owner >= 0; });
+  YEAGER_EXPECT_EQ(ranges.GetUsed(), static_cast<Uint>(used));
+  YEAGER_EXPECT_EQ(ranges.GetAllocationCount(), static_cast<Uint>(live.size()));
+}
+
+YEAGER_TEST(DrawBatching, BuilderDropsEmptyCommandsAndSplitsOnKeyChanges)
+{
+  IndirectBatchBuilder builder;
+  builder.Add(1, sFirstPool, MakeCommand(0, 6));
+  builder.Add(1, sFirstPool, MakeCommand(6, 0));
+  builder.Add(1, sFirstPool, MakeCommand(6, 6, 0, 0));
+  builder.Add(1, sFirstPool, MakeCommand(12, 6));
+  builder.Add(2, sFirstPool, MakeCommand(18, 6));
+  builder.Add(2, sSecondPool, MakeCommand(0, 3));
+
+  YEAGER_EXPECT_EQ(builder.GetCommands().size(), std::size_t(4));
+  YEAGER_EXPECT_EQ(builder.GetBatches().size(), std::size_t(3));
+  YEAGER_EXPECT_EQ(builder.GetBatches()[0].CommandCount, 2u);
+
+  builder.Clear();
+  YEAGER_EXPECT(builder.GetBatches().empty());
+  YEAGER_EXPECT(builder.GetCommands().empty());
+}
+
+/* A model of 120 meshes with 6 materials interleaved, all in one pool, each mesh after the previous in the buffers */
+YEAGER_TEST(DrawBatching, CompactMakesOneBatchPerKeyAndMergesContiguousCommands)
+{
+  IndirectBatchBuilder builder;
+  for (Uint x = 0; x < 120; x++) {
+    builder.Add(x % 6, sFirstPool, MakeCommand(x * 36, 36, static_cast<int>(x * 24)));
+  }
+  YEAGER_EXPECT_EQ(builder.GetBatches().size(), std::size_t(120));
+  builder.Compact();
+
+  YEAGER_EXPECT_EQ(builder.GetBatches().size(), std::size_t(6));
+  Uint commands = 0;
+  for (Uint x = 0; x < 6; x++) {
+    const IndirectDrawBatch& batch = builder.GetBatches()[x];
+    YEAGER_EXPECT_EQ(batch.Key, uint64_t(x));
+    YEAGER_EXPECT_EQ(batch.FirstCommand, commands);
+    /* Each mesh has its own base vertex, nothing merges */
+    YEAGER_EXPECT_EQ(batch.CommandCount, 20u);
+    YEAGER_EXPECT_EQ(builder.GetCommands(batch).front().FirstIndex, x * 36);
+    commands += batch.CommandCount;
+  }
+
+  /* Same base vertex and consecutive indices once grouped, as the submeshes of two materials of a single mesh */
+  builder.Clear();
+  for (Uint x = 0; x < 12; x++) {
+    builder.Add(x % 2, sFirstPool, MakeCommand(x / 2 * 6 + x % 2 * 600, 6));
+  }
+  builder.Compact();
+  YEAGER_EXPECT_EQ(builder.GetBatches().size(), std::size_t(2));
+  YEAGER_EXPECT_EQ(builder.GetCommands().size(), std::size_t(2));
+  YEAGER_EXPECT_EQ(builder.GetCommands()[0].Count, 36u);
+  YEAGER_EXPECT_EQ(builder.GetCommands()[1].FirstIndex, 600u);
+}
+
+/* Random streams, the compaction must draw exactly the same indices of each pool and key */
+YEAGER_TEST(DrawBatching, CompactKeepsEveryIndexDrawn)
+{
+  std::mt19937 random(9);
+  IndirectBatchBuilder builder;
+  bool sameIndices = true, oneBatchPerGroup = true;
+  for (Uint run = 0; run < 200; run++) {
+    builder.Clear();
+    /* Indices drawn per (pool, key), with their base vertex and instances */
+    std::map<std::tuple<GeometryPool*, uint64_t, Uint, int, Uint>, Uint> expected;
+    const Uint count = 1 + random() % 200;
+    for (Uint x = 0; x < count; x++) {
+      GeometryPool* pool = random() % 2 != 0 ? sFirstPool : sSecondPool;
+      const uint64_t key = random() % 4;
+      const DrawElementsIndirectCommand command =
+          MakeCommand(random() % 64 * 6, 6 * (random() % 3), static_cast<int>(random() % 2), 1 + random() % 2);
+      builder.Add(key, pool, command);
+      for (Uint index = command.FirstIndex; index < command.FirstIndex + command.Count; index++)
+        expected[{pool, key, index, command.BaseVertex, command.InstanceCount}]++;
+    }
+    builder.Compact();
+
+    std::map<std::tuple<GeometryPool*, uint64_t, Uint, int, Uint>, Uint> drawn;
+    std::set<std::pair<GeometryPool*, uint64_t>> groups;
+    for (const IndirectDrawBatch& batch : builder.GetBatches()) {
+      oneBatchPerGroup &= groups.emplace(batch.Pool, batch.Key).second;
+      for (const DrawElementsIndirectCommand& command : builder.GetCommands(batch)) {
+        for (Uint index = command.FirstIndex; index < command.FirstIndex + command.Count; index++)
+          drawn[{batch.Pool, batch.Key, index, command.BaseVertex, command.InstanceCount}]++;
+      }
+    }
+    sameIndices &= drawn == expected;
+  }
+  YEAGER_EXPECT(sameIndices);
+  YEAGER_EXPECT(oneBatchPerGroup);
+}
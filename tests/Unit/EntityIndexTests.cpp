@@ -0,0 +1,155 @@
+#include "Framework/YeagerTest.h"
+#include "Main/Scene/EntityRegistry.h"
+
+#include <map>
+#include <random>
+using namespace Yeager;
+
+/* Only the first bytes set, like the ids of the older saves, the hash must still spread them */
+static uuid_t MakeUUID(uint32_t value)
+{
+  std::array<uint8_t, 16> bytes = {};
+  std::memcpy(bytes.data(), &value, sizeof(value));
+  return uuid_t(bytes);
+}
+
+static EntityHandle MakeEntity(Uint index, Uint generation = 0)
+{
+  EntityHandle entity;
+  entity.Index = index;
+  entity.Generation = generation;
+  return entity;
+}
+
+YEAGER_TEST(EntityIndex, FindsTheEntitiesByUUID)
+{
+  EntityIndex index;
+  for (Uint x = 0; x < 1000; x++) {
+    YEAGER_EXPECT(!index.Insert(MakeEntity(x), MakeUUID(x), "Object").IsValid());
+  }
+  YEAGER_EXPECT_EQ(index.GetEntityCount(), 1000u);
+
+  bool allFound = true;
+  for (Uint x = 0; x < 1000; x++) {
+    allFound &= index.FindByUUID(MakeUUID(x)) == MakeEntity(x) && index.Contains(MakeEntity(x));
+  }
+  YEAGER_EXPECT(allFound);
+  YEAGER_EXPECT(!index.FindByUUID(MakeUUID(1000)).IsValid());
+  YEAGER_EXPECT(!index.Contains(MakeEntity(3, 1)));
+}
+
+YEAGER_TEST(EntityIndex, DuplicatedUUIDReturnsTheFirstEntity)
+{
+  EntityIndex index;
+  index.Insert(MakeEntity(0), MakeUUID(7), "Original");
+  YEAGER_EXPECT(index.Insert(MakeEntity(1), MakeUUID(7), "Copy") == MakeEntity(0));
+  YEAGER_EXPECT(!index.Contains(MakeEntity(1)));
+  YEAGER_EXPECT_EQ(index.GetEntityCount(), 1u);
+  YEAGER_EXPECT(!index.FindByName("Copy").IsValid());
+
+  /* Once the first one is gone the copy can take the UUID */
+  index.Remove(MakeEntity(0));
+  YEAGER_EXPECT(!index.Insert(MakeEntity(1), MakeUUID(7), "Copy").IsValid());
+  YEAGER_EXPECT(index.FindByUUID(MakeUUID(7)) == MakeEntity(1));
+}
+
+YEAGER_TEST(EntityIndex, NamesAreSharedAndRenamed)
+{
+  EntityIndex index;
+  index.Insert(MakeEntity(0), MakeUUID(0), "Crate");
+  index.Insert(MakeEntity(1), MakeUUID(1), "Lamp");
+  index.Insert(MakeEntity(2), MakeUUID(2), "Crate");
+
+  YEAGER_EXPECT(index.GetEntitiesNamed("Crate") == std::vector<EntityHandle>({MakeEntity(0), MakeEntity(2)}));
+  YEAGER_EXPECT(index.FindByName("Crate") == MakeEntity(0));
+  YEAGER_EXPECT(index.GetEntitiesNamed("Missing").empty());
+  YEAGER_EXPECT(!index.FindByName("Missing").IsValid());
+
+  index.Rename(MakeEntity(0), "Lamp");
+  YEAGER_EXPECT(index.FindByName("Crate") == MakeEntity(2));
+  YEAGER_EXPECT(index.GetEntitiesNamed("Lamp") == std::vector<EntityHandle>({MakeEntity(1), MakeEntity(0)}));
+  /* Renaming a stale handle does nothing */
+  index.Rename(MakeEntity(2, 4), "Lamp");
+  YEAGER_EXPECT_EQ(index.GetEntitiesNamed("Lamp").size(), std::size_t(2));
+
+  const EntityNameId crate = index.FindName("Crate");
+  YEAGER_EXPECT(crate != EntityIndex::sInvalidName);
+  YEAGER_EXPECT_EQ(index.Intern("Crate"), crate);
+  YEAGER_EXPECT_EQ(index.GetName(crate), String("Crate"));
+  YEAGER_EXPECT_EQ(index.FindName("Missing"), EntityIndex::sInvalidName);
+}
+
+YEAGER_TEST(EntityIndex, StaleHandlesAreNotRemoved)
+{
+  EntityIndex index;
+  index.Insert(MakeEntity(4, 2), MakeUUID(4), "Object");
+  index.Remove(MakeEntity(4, 1));
+  YEAGER_EXPECT(index.Contains(MakeEntity(4, 2)));
+  index.Remove(MakeEntity(4, 2));
+  YEAGER_EXPECT(!index.Contains(MakeEntity(4, 2)));
+  YEAGER_EXPECT(!index.FindByUUID(MakeUUID(4)).IsValid());
+  YEAGER_EXPECT(index.GetEntitiesNamed("Object").empty());
+  YEAGER_EXPECT_EQ(index.GetEntityCount(), 0u);
+}
+
+/* Random inserts and removals against a std::map, the removals leave the probe chains with holes to fill */
+YEAGER_TEST(EntityIndex, MatchesAMapUnderChurn)
+{
+  std::mt19937 random(11);
+  EntityIndex index;
+  std::map<uuid_t, EntityHandle> expected;
+  std::vector<std::pair<EntityHandle, uuid_t>> live;
+  Uint nextIndex = 0;
+  bool duplicatesMatch = true;
+  for (Uint step = 0; step < 100000; step++) {
+    if (live.empty() || random() % 3 != 0) {
+      const EntityHandle entity = MakeEntity(nextIndex++);
+      const uuid_t uuid = MakeUUID(random() % 20000);
+      const EntityHandle duplicate = index.Insert(entity, uuid, fmt::format("Object {}", step % 97));
+      const auto it = expected.find(uuid);
+      if (it != expected.end()) {
+        duplicatesMatch &= duplicate == it->second;
+      } else {
+        duplicatesMatch &= !duplicate.IsValid();
+        expected[uuid] = entity;
+        live.emplace_back(entity, uuid);
+      }
+    } else {
+      const std::size_t position = random() % live.size();
+      const auto [entity, uuid] = live[position];
+      live[position] = live.back();
+      live.pop_back();
+      expected.erase(uuid);
+      index.Remove(entity);
+    }
+  }
+  YEAGER_EXPECT(duplicatesMatch);
+  YEAGER_EXPECT_EQ(index.GetEntityCount(), static_cast<Uint>(expected.size()));
+
+  bool allFound = true;
+  for (const auto& [uuid, entity] : expected) {
+    allFound &= index.FindByUUID(uuid) == entity;
+  }
+  YEAGER_EXPECT(allFound);
+  Uint missing = 0;
+  for (uint32_t x = 0; x < 20000; x++) {
+    missing += !index.FindByUUID(MakeUUID(x)).IsValid();
+  }
+  YEAGER_EXPECT_EQ(missing, static_cast<Uint>(20000 - expected.size()));
+}
+
+YEAGER_TEST(EntityIndex, RegistryRemovesFreedEntities)
+{
+  struct TestObject {
+    Uint Id = 0;
+  };
+  EntityRegistry registry;
+  const EntityHandle entity = registry.Create();
+  registry.GetPool<TestObject>()->Insert(entity, std::make_shared<TestObject>());
+  registry.GetIndex()->Insert(entity, MakeUUID(1), "Object");
+  YEAGER_EXPECT(registry.GetIndex()->FindByUUID(MakeUUID(1)) == entity);
+
+  registry.Destroy(entity);
+  YEAGER_EXPECT(!registry.GetIndex()->FindByUUID(MakeUUID(1)).IsValid());
+  YEAGER_EXPECT(registry.GetIndex()->GetEntitiesNamed("Object").empty());
+}
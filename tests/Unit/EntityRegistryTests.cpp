@@ -0,0 +1,279 @@
+#include "Framework/YeagerTest.h"
+#include "Main/Scene/EntityRegistry.h"
+using namespace Yeager;
+
+/* Stands for the scene objects, which know the entity the scene gave them */
+struct TestObject {
+  TestObject(Uint id) : Id(id) {}
+  EntityHandle GetSceneEntity() const { return Entity; }
+
+  EntityHandle Entity;
+  Uint Id = 0;
+};
+
+/* Stands for the components without a scene entity of their own, like the toolboxes */
+struct TestTool {
+  TestObject* Owner = YEAGER_NULLPTR;
+};
+
+/* Every position of the dense array is found back through the entity stored at it */
+template <typename T>
+static bool SparseMatchesDense(const ComponentPool<T>& pool)
+{
+  for (Uint x = 0; x < pool.size(); x++) {
+    if (pool.Get(pool.GetEntity(x)) != pool.at(x).get())
+      return false;
+  }
+  return true;
+}
+
+template <typename T>
+static std::vector<Uint> CollectIds(const ComponentPool<T>& pool)
+{
+  std::vector<Uint> ids;
+  for (const T* component : pool) {
+    ids.push_back(component->Id);
+  }
+  return ids;
+}
+
+YEAGER_TEST(EntityRegistry, ComponentsAreFoundByTheirEntity)
+{
+  EntityRegistry registry;
+  ComponentPool<TestObject>* objects = registry.GetPool<TestObject>();
+  ComponentPool<TestTool>* tools = registry.GetPool<TestTool>();
+  YEAGER_EXPECT(registry.GetPool<TestObject>() == objects);
+
+  std::vector<EntityHandle> entities;
+  for (Uint x = 0; x < 100; x++) {
+    auto object = std::make_shared<TestObject>(x);
+    object->Entity = registry.Create();
+    YEAGER_EXPECT(objects->Insert(object->Entity, object));
+    if (x % 3 == 0)
+      YEAGER_EXPECT(tools->Insert(object->Entity, std::make_shared<TestTool>(TestTool{object.get()})));
+    entities.push_back(object->Entity);
+  }
+
+  YEAGER_EXPECT_EQ(registry.GetEntityCount(), 100u);
+  YEAGER_EXPECT_EQ(objects->size(), std::size_t(100));
+  YEAGER_EXPECT_EQ(tools->size(), std::size_t(34));
+  for (Uint x = 0; x < 100; x++) {
+    YEAGER_EXPECT_EQ(registry.Get<TestObject>(entities[x])->Id, x);
+    YEAGER_EXPECT_EQ(tools->Contains(entities[x]), x % 3 == 0);
+    if (x % 3 == 0)
+      YEAGER_EXPECT(tools->Get(entities[x])->Owner == objects->Get(entities[x]));
+  }
+  /* Iterated in insertion order */
+  const std::vector<Uint> ids = CollectIds(*objects);
+  YEAGER_EXPECT(std::is_sorted(ids.begin(), ids.end()));
+  YEAGER_EXPECT(SparseMatchesDense(*objects));
+  YEAGER_EXPECT(SparseMatchesDense(*tools));
+}
+
+YEAGER_TEST(EntityRegistry, InsertRejectsDeadEntitiesAndSecondComponents)
+{
+  EntityRegistry registry;
+  ComponentPool<TestObject>* objects = registry.GetPool<TestObject>();
+  const EntityHandle entity = registry.Create();
+  YEAGER_EXPECT(objects->Insert(entity, std::make_shared<TestObject>(1)));
+  YEAGER_EXPECT(!objects->Insert(entity, std::make_shared<TestObject>(2)));
+  YEAGER_EXPECT(!objects->Insert(EntityHandle(), std::make_shared<TestObject>(3)));
+  YEAGER_EXPECT(!objects->Insert(EntityHandle{entity.Index, entity.Generation + 1}, std::make_shared<TestObject>(4)));
+  YEAGER_EXPECT_EQ(objects->size(), std::size_t(1));
+  YEAGER_EXPECT_EQ(objects->Get(entity)->Id, 1u);
+}
+
+YEAGER_TEST(EntityRegistry, EntityLivesWhileItHasComponents)
+{
+  EntityRegistry registry;
+  const EntityHandle entity = registry.Create();
+  YEAGER_EXPECT(registry.IsAlive(entity));
+  registry.GetPool<TestObject>()->Insert(entity, std::make_shared<TestObject>(1));
+  registry.GetPool<TestTool>()->Insert(entity, std::make_shared<TestTool>());
+
+  YEAGER_EXPECT(registry.GetPool<TestTool>()->Remove(entity));
+  YEAGER_EXPECT(registry.IsAlive(entity));
+  YEAGER_EXPECT(!registry.GetPool<TestTool>()->Remove(entity));
+  YEAGER_EXPECT(registry.GetPool<TestObject>()->Remove(entity));
+  YEAGER_EXPECT(!registry.IsAlive(entity));
+  YEAGER_EXPECT_EQ(registry.GetEntityCount(), 0u);
+
+  /* Destroyed without components, it is freed right away */
+  const EntityHandle empty = registry.Create();
+  registry.Destroy(empty);
+  YEAGER_EXPECT(!registry.IsAlive(empty));
+}
+
+YEAGER_TEST(EntityRegistry, StaleHandlesNeverReachTheEntityReusingTheIndex)
+{
+  EntityRegistry registry;
+  ComponentPool<TestObject>* objects = registry.GetPool<TestObject>();
+  const EntityHandle first = registry.Create();
+  objects->Insert(first, std::make_shared<TestObject>(1));
+  registry.Destroy(first);
+  YEAGER_EXPECT(objects->empty());
+
+  const EntityHandle second = registry.Create();
+  objects->Insert(second, std::make_shared<TestObject>(2));
+  YEAGER_EXPECT_EQ(second.Index, first.Index);
+  YEAGER_EXPECT(second != first);
+  YEAGER_EXPECT(!registry.IsAlive(first));
+  YEAGER_EXPECT(objects->Get(first) == YEAGER_NULLPTR);
+  YEAGER_EXPECT(!objects->Remove(first));
+  registry.Destroy(first);
+  YEAGER_EXPECT_EQ(objects->Get(second)->Id, 2u);
+}
+
+YEAGER_TEST(EntityRegistry, RemovalKeepsTheInsertionOrder)
+{
+  EntityRegistry registry;
+  ComponentPool<TestObject>* objects = registry.GetPool<TestObject>();
+  std::vector<EntityHandle> entities;
+  for (Uint x = 0; x < 10; x++) {
+    entities.push_back(registry.Create());
+    objects->Insert(entities.back(), std::make_shared<TestObject>(x));
+  }
+
+  objects->Remove(entities[2]);
+  objects->RemoveAt(0);
+  objects->Remove(entities[9]);
+  YEAGER_EXPECT(CollectIds(*objects) == std::vector<Uint>({1, 3, 4, 5, 6, 7, 8}));
+  YEAGER_EXPECT(SparseMatchesDense(*objects));
+  YEAGER_EXPECT_EQ(registry.GetEntityCount(), 7u);
+}
+
+YEAGER_TEST(EntityRegistry, RemoveIfCompactsInOnePassAndHandsOverTheComponents)
+{
+  EntityRegistry registry;
+  ComponentPool<TestObject>* objects = registry.GetPool<TestObject>();
+  std::vector<EntityHandle> entities;
+  std::weak_ptr<TestObject> watched;
+  for (Uint x = 0; x < 1000; x++) {
+    auto object = std::make_shared<TestObject>(x);
+    if (x == 3)
+      watched = object;
+    entities.push_back(registry.Create());
+    objects->Insert(entities.back(), object);
+  }
+
+  std::vector<std::shared_ptr<void>> released;
+  const Uint removed =
+      objects->RemoveIf([](TestObject* object, EntityHandle) { return object->Id % 3 == 0; }, &released);
+  YEAGER_EXPECT_EQ(removed, 334u);
+  YEAGER_EXPECT_EQ(released.size(), std::size_t(334));
+  YEAGER_EXPECT_EQ(objects->size(), std::size_t(666));
+  YEAGER_EXPECT_EQ(registry.GetEntityCount(), 666u);
+  YEAGER_EXPECT(SparseMatchesDense(*objects));
+
+  const std::vector<Uint> ids = CollectIds(*objects);
+  YEAGER_EXPECT(std::is_sorted(ids.begin(), ids.end()));
+  YEAGER_EXPECT(std::none_of(ids.begin(), ids.end(), [](Uint id) { return id % 3 == 0; }));
+  YEAGER_EXPECT(!registry.IsAlive(entities[3]));
+  YEAGER_EXPECT(registry.IsAlive(entities[4]));
+
+  /* The released components live until the caller lets them go */
+  YEAGER_EXPECT(!watched.expired());
+  released.clear();
+  YEAGER_EXPECT(watched.expired());
+}
+
+YEAGER_TEST(EntityRegistry, PushBackUsesTheSceneEntityWhenAlive)
+{
+  EntityRegistry registry;
+  ComponentPool<TestObject>* objects = registry.GetPool<TestObject>();
+  ComponentPool<TestTool>* tools = registry.GetPool<TestTool>();
+
+  auto object = std::make_shared<TestObject>(1);
+  object->Entity = registry.Create();
+  objects->push_back(object);
+  YEAGER_EXPECT(objects->GetEntity(0) == object->Entity);
+  YEAGER_EXPECT_EQ(registry.GetEntityCount(), 1u);
+
+  /* Without a live scene entity a new one is created */
+  auto orphan = std::make_shared<TestObject>(2);
+  objects->push_back(orphan);
+  YEAGER_EXPECT(objects->GetEntity(1) != orphan->Entity);
+  YEAGER_EXPECT(registry.IsAlive(objects->GetEntity(1)));
+
+  auto tool = std::make_shared<TestTool>();
+  tools->push_back(tool);
+  YEAGER_EXPECT(tools->at(0) == tool);
+  YEAGER_EXPECT_EQ(registry.GetEntityCount(), 3u);
+}
+
+YEAGER_TEST(EntityRegistry, FlushDestroyedRemovesHalfOfTheEntitiesInOnePass)
+{
+  static YEAGER_CONSTEXPR Uint sCount = 100000;
+  EntityRegistry registry;
+  ComponentPool<TestObject>* objects = registry.GetPool<TestObject>();
+  ComponentPool<TestTool>* tools = registry.GetPool<TestTool>();
+  std::vector<EntityHandle> entities;
+  for (Uint x = 0; x < sCount; x++) {
+    auto object = std::make_shared<TestObject>(x);
+    object->Entity = registry.Create();
+    objects->push_back(object);
+    tools->Insert(object->Entity, std::make_shared<TestTool>(TestTool{object.get()}));
+    entities.push_back(object->Entity);
+  }
+
+  /* Every other entity, recorded twice, as the selection and the editor can both ask for the same deletion */
+  for (Uint x = 0; x < sCount; x += 2) {
+    registry.DestroyDeferred(entities[x]);
+    registry.DestroyDeferred(entities[x]);
+  }
+  YEAGER_EXPECT_EQ(objects->size(), std::size_t(sCount));
+
+  std::vector<std::shared_ptr<void>> released;
+  YEAGER_EXPECT_EQ(registry.FlushDestroyed(&released), sCount / 2);
+  YEAGER_EXPECT_EQ(released.size(), std::size_t(sCount));
+  YEAGER_EXPECT(registry.GetPendingDestroy().empty());
+  YEAGER_EXPECT_EQ(registry.GetEntityCount(), sCount / 2);
+  YEAGER_EXPECT_EQ(objects->size(), std::size_t(sCount / 2));
+  YEAGER_EXPECT_EQ(tools->size(), std::size_t(sCount / 2));
+  YEAGER_EXPECT(SparseMatchesDense(*objects));
+  YEAGER_EXPECT(SparseMatchesDense(*tools));
+
+  bool survivorsMatch = true;
+  for (Uint x = 0; x < objects->size(); x++) {
+    const TestObject* object = objects->at(x).get();
+    survivorsMatch &= object->Id == x * 2 + 1 && tools->Get(object->Entity)->Owner == object;
+  }
+  YEAGER_EXPECT(survivorsMatch);
+  bool aliveMatch = true;
+  for (Uint x = 0; x < sCount; x++) {
+    aliveMatch &= registry.IsAlive(entities[x]) == (x % 2 != 0);
+  }
+  YEAGER_EXPECT(aliveMatch);
+  YEAGER_EXPECT_EQ(registry.FlushDestroyed(), 0u);
+}
+
+YEAGER_TEST(EntityRegistry, FlushDestroyedIgnoresHandlesGoneStale)
+{
+  EntityRegistry registry;
+  ComponentPool<TestObject>* objects = registry.GetPool<TestObject>();
+  std::vector<EntityHandle> entities;
+  for (Uint x = 0; x < 4; x++) {
+    entities.push_back(registry.Create());
+    objects->Insert(entities.back(), std::make_shared<TestObject>(x));
+  }
+  for (const EntityHandle& entity : entities) {
+    registry.DestroyDeferred(entity);
+  }
+
+  /* Destroyed before the flush, and its index given to a new entity that must survive it */
+  registry.Destroy(entities[1]);
+  const EntityHandle reused = registry.Create();
+  objects->Insert(reused, std::make_shared<TestObject>(10));
+  YEAGER_EXPECT_EQ(reused.Index, entities[1].Index);
+  /* Lost its last component before the flush */
+  objects->Remove(entities[2]);
+
+  YEAGER_EXPECT_EQ(registry.FlushDestroyed(), 2u);
+  YEAGER_EXPECT(registry.IsAlive(reused));
+  YEAGER_EXPECT_EQ(objects->size(), std::size_t(1));
+  YEAGER_EXPECT_EQ(objects->Get(reused)->Id, 10u);
+
+  /* A dead handle is never recorded */
+  registry.DestroyDeferred(entities[0]);
+  YEAGER_EXPECT(registry.GetPendingDestroy().empty());
+}
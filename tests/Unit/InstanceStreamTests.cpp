@@ -0,0 +1,105 @@
+#include "Framework/YeagerTest.h"
+#include "Framework/YeagerUploadRing.h"
+#include "Components/Renderer/GL/OpenGLRender.h"
+
+#include <random>
+using namespace Yeager;
+
+static std::vector<Matrix4> MakeAffineTransforms(Uint count, Uint seed)
+{
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+  std::vector<Matrix4> transforms(count);
+  for (Matrix4& transform : transforms) {
+    transform = glm::translate(Matrix4(1.0f), Vector3(value(random), value(random), value(random)));
+    transform = glm::rotate(transform, glm::radians(value(random)), glm::normalize(Vector3(1.0f, 2.0f, 3.0f)));
+    transform = glm::scale(transform, Vector3(0.5f, 2.0f, 1.5f));
+  }
+  return transforms;
+}
+
+YEAGER_TEST(InstanceStream, PackRoundTripsBothLayouts)
+{
+  for (const Matrix4& transform : MakeAffineTransforms(100, 1)) {
+    float packed[16];
+    InstanceStream::PackTransform(transform, InstanceTransformLayout::eMATRIX4x4, packed);
+    YEAGER_EXPECT(InstanceStream::UnpackTransform(packed, InstanceTransformLayout::eMATRIX4x4) == transform);
+    InstanceStream::PackTransform(transform, InstanceTransformLayout::eMATRIX3x4, packed);
+    YEAGER_EXPECT(InstanceStream::UnpackTransform(packed, InstanceTransformLayout::eMATRIX3x4) == transform);
+  }
+
+  /* The full layout keeps a non affine last row */
+  Matrix4 projection = glm::perspective(glm::radians(60.0f), 1.5f, 0.1f, 100.0f);
+  float packed[16];
+  InstanceStream::PackTransform(projection, InstanceTransformLayout::eMATRIX4x4, packed);
+  YEAGER_EXPECT(InstanceStream::UnpackTransform(packed, InstanceTransformLayout::eMATRIX4x4) == projection);
+}
+
+YEAGER_TEST(InstanceStream, CompactLayoutWritesThreeRows)
+{
+  const Matrix4 transform = glm::translate(Matrix4(1.0f), Vector3(4.0f, 5.0f, 6.0f));
+  float packed[16];
+  std::fill(std::begin(packed), std::end(packed), -1.0f);
+  InstanceStream::PackTransform(transform, InstanceTransformLayout::eMATRIX3x4, packed);
+
+  /* Rows, so the shader reads the translation as the last component of each texel */
+  YEAGER_EXPECT_EQ(packed[0], 1.0f);
+  YEAGER_EXPECT_EQ(packed[3], 4.0f);
+  YEAGER_EXPECT_EQ(packed[7], 5.0f);
+  YEAGER_EXPECT_EQ(packed[11], 6.0f);
+  YEAGER_EXPECT(std::all_of(packed + 12, packed + 16, [](float value) { return value == -1.0f; }));
+  YEAGER_EXPECT_EQ(InstanceStream::GetTexelsPerInstance(InstanceTransformLayout::eMATRIX3x4), 3u);
+  YEAGER_EXPECT_EQ(InstanceStream::GetTexelsPerInstance(InstanceTransformLayout::eMATRIX4x4), 4u);
+}
+
+YEAGER_TEST(InstanceStream, PushesPackIntoTheRingAtConsecutiveOffsets)
+{
+  for (const auto layout : {InstanceTransformLayout::eMATRIX3x4, InstanceTransformLayout::eMATRIX4x4}) {
+    auto backend = std::make_unique<Test::FakeUploadRingBackend>();
+    const Test::FakeUploadRingBackend* gpu = backend.get();
+    UploadRing ring(1 << 16, std::move(backend));
+    ring.BeginFrame();
+
+    InstanceStream stream(layout);
+    stream.BeginFrame(&ring, 100);
+    YEAGER_EXPECT_EQ(stream.GetCapacity(), 100u);
+    const std::vector<Matrix4> first = MakeAffineTransforms(10, 2);
+    const std::vector<Matrix4> second = MakeAffineTransforms(30, 3);
+    YEAGER_EXPECT_EQ(stream.Push(first), 0u);
+    YEAGER_EXPECT_EQ(stream.Push(second), 10u);
+    YEAGER_EXPECT_EQ(stream.GetUsed(), 40u);
+
+    /* The first range of a new ring starts at the beginning of the buffer */
+    const float* data = reinterpret_cast<const float*>(gpu->GetBufferData());
+    const Uint floats = stream.GetTexelsPerInstance() * 4;
+    bool allMatch = true;
+    for (Uint x = 0; x < 40; x++) {
+      const Matrix4& expected = x < 10 ? first[x] : second[x - 10];
+      allMatch &= InstanceStream::UnpackTransform(data + x * floats, layout) == expected;
+    }
+    YEAGER_EXPECT(allMatch);
+    ring.EndFrame();
+  }
+}
+
+YEAGER_TEST(InstanceStream, PushesBeyondTheReserveAreSkipped)
+{
+  UploadRing ring(1 << 16, std::make_unique<Test::FakeUploadRingBackend>());
+  ring.BeginFrame();
+  InstanceStream stream;
+  stream.BeginFrame(&ring, 8);
+  const std::vector<Matrix4> transforms = MakeAffineTransforms(5, 4);
+
+  YEAGER_EXPECT_EQ(stream.Push(transforms), 0u);
+  YEAGER_EXPECT_EQ(stream.Push(std::span(transforms).first(4)), InstanceStream::sInvalidOffset);
+  YEAGER_EXPECT_EQ(stream.Push(std::span(transforms).first(3)), 5u);
+  YEAGER_EXPECT_EQ(stream.GetUsed(), 8u);
+  ring.EndFrame();
+
+  /* Nothing reserved, nothing pushed */
+  ring.BeginFrame();
+  stream.BeginFrame(&ring, 0);
+  YEAGER_EXPECT_EQ(stream.GetCapacity(), 0u);
+  YEAGER_EXPECT_EQ(stream.Push(std::span(transforms).first(1)), InstanceStream::sInvalidOffset);
+  ring.EndFrame();
+}
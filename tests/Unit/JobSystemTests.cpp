@@ -0,0 +1,163 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Kernel/Process/JobSystem.h"
+using namespace Yeager;
+
+/* Starts the pool for a test and stops it at the end, every test gets a pool of its own */
+struct JobSystemScope {
+  JobSystemScope(Uint threads) { JobSystem::Initialize(threads); }
+  ~JobSystemScope() { JobSystem::Terminate(); }
+};
+
+YEAGER_TEST(JobSystem, RunsEveryJobBeforeTheCounterIsDone)
+{
+  JobSystemScope scope(4);
+  static YEAGER_CONSTEXPR Uint sJobs = 100000;
+  std::atomic<uint64_t> sum = 0;
+  JobCounter counter;
+  for (Uint x = 0; x < sJobs; x++) {
+    JobSystem::Run([&sum, x] { sum.fetch_add(x, std::memory_order_relaxed); }, &counter);
+  }
+  JobSystem::Wait(&counter);
+  YEAGER_EXPECT(counter.IsDone());
+  YEAGER_EXPECT_EQ(sum.load(), uint64_t(sJobs) * (sJobs - 1) / 2);
+}
+
+YEAGER_TEST(JobSystem, ParentCounterWaitsForEveryChild)
+{
+  JobSystemScope scope(4);
+  for (Uint round = 0; round < 20; round++) {
+    std::atomic<Uint> leaves = 0;
+    JobCounter counter;
+    for (Uint parent = 0; parent < 32; parent++) {
+      JobSystem::Run(
+          [&leaves] {
+            for (Uint child = 0; child < 16; child++) {
+              JobSystem::RunChild([&leaves] {
+                JobSystem::RunChild([&leaves] { leaves++; });
+                leaves++;
+              });
+            }
+          },
+          &counter);
+    }
+    JobSystem::Wait(&counter);
+    YEAGER_EXPECT_EQ(leaves.load(), 32u * 16u * 2u);
+  }
+}
+
+YEAGER_TEST(JobSystem, ParallelForVisitsEveryIndexOnce)
+{
+  JobSystemScope scope(4);
+  for (const Uint count : {0u, 1u, 7u, 1000u, 1000003u}) {
+    for (const Uint grain : {0u, 1u, 64u, 5000u}) {
+      if (grain == 1 && count > 1000)
+        continue;
+      std::vector<std::atomic<Uint>> visits(count);
+      JobSystem::ParallelFor(count, grain, [&visits](Uint begin, Uint end) {
+        for (Uint x = begin; x < end; x++)
+          visits[x]++;
+      });
+      Uint wrong = 0;
+      for (const auto& visit : visits) {
+        wrong += visit.load() != 1 ? 1 : 0;
+      }
+      YEAGER_EXPECT_EQ(wrong, 0u);
+    }
+  }
+}
+
+YEAGER_TEST(JobSystem, RunsInlineWithoutThePool)
+{
+  YEAGER_EXPECT(!JobSystem::IsInitialized());
+  const std::thread::id caller = std::this_thread::get_id();
+  bool ranInline = false;
+  JobCounter counter;
+  JobSystem::Run([&] { ranInline = std::this_thread::get_id() == caller; }, &counter);
+  YEAGER_EXPECT(ranInline);
+  YEAGER_EXPECT(counter.IsDone());
+
+  Uint visited = 0;
+  JobSystem::ParallelFor(100, 10, [&visited](Uint begin, Uint end) { visited += end - begin; });
+  YEAGER_EXPECT_EQ(visited, 100u);
+}
+
+YEAGER_TEST(JobSystem, AcceptsJobsFromThreadsOutsideThePool)
+{
+  JobSystemScope scope(4);
+  std::atomic<Uint> done = 0;
+  std::thread producer([&done] {
+    JobCounter counter;
+    for (Uint x = 0; x < 10000; x++) {
+      JobSystem::Run([&done] { done++; }, &counter);
+    }
+    JobSystem::Wait(&counter);
+  });
+  producer.join();
+  YEAGER_EXPECT_EQ(done.load(), 10000u);
+}
+
+YEAGER_TEST(JobSystem, HighPriorityJobsOvertakeQueuedFrameJobs)
+{
+  JobSystemScope scope(4);
+  static YEAGER_CONSTEXPR int sFrameJobs = 2000;
+  std::atomic<int> framesDone = 0;
+  int framesBeforeHigh = -1;
+  JobCounter frames;
+  JobCounter high;
+
+  std::thread producer([&] {
+    for (int x = 0; x < sFrameJobs; x++) {
+      JobSystem::Run(
+          [&framesDone] {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            framesDone++;
+          },
+          &frames);
+    }
+  });
+  producer.join();
+  JobSystem::Run([&] { framesBeforeHigh = framesDone.load(); }, &high, JobPriority::eHIGH);
+  JobSystem::Wait(&high);
+  JobSystem::Wait(&frames);
+
+  /* Only the frame jobs already running when it was submitted, and a few picked right after, go before it */
+  YEAGER_EXPECT(framesBeforeHigh >= 0);
+  YEAGER_EXPECT(framesBeforeHigh < sFrameJobs / 2);
+}
+
+YEAGER_TEST(JobSystem, WaitingThreadsNeverRunBackgroundJobs)
+{
+  JobSystemScope scope(4);
+  const std::thread::id caller = std::this_thread::get_id();
+  std::atomic<Uint> backgroundOnCaller = 0;
+  std::atomic<Uint> backgroundDone = 0;
+  JobCounter background;
+  for (Uint x = 0; x < 8; x++) {
+    JobSystem::Run(
+        [&] {
+          if (std::this_thread::get_id() == caller)
+            backgroundOnCaller++;
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          /* A background job may still wait on frame jobs of its own */
+          std::vector<Uint> values(10000);
+          JobSystem::ParallelFor(10000, 100, [&values](Uint begin, Uint end) {
+            for (Uint y = begin; y < end; y++)
+              values[y] = y;
+          });
+          backgroundDone++;
+        },
+        &background, JobPriority::eBACKGROUND);
+  }
+
+  for (Uint frame = 0; frame < 20; frame++) {
+    std::vector<float> values(100000);
+    JobSystem::ParallelFor(static_cast<Uint>(values.size()), 0, [&values](Uint begin, Uint end) {
+      for (Uint x = begin; x < end; x++)
+        values[x] = std::sqrt(static_cast<float>(x));
+    });
+  }
+
+  JobSystem::Wait(&background);
+  YEAGER_EXPECT_EQ(backgroundDone.load(), 8u);
+  YEAGER_EXPECT_EQ(backgroundOnCaller.load(), 0u);
+}
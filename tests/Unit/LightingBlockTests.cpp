@@ -0,0 +1,186 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Lighting/LightTypes.h"
+#include "Components/Lighting/LightingBlock.h"
+
+#include <cstring>
+using namespace Yeager;
+
+/* Reads the block as the shader does, from the byte offsets of std140 and not from the struct members */
+static const std::byte* BlockBytes(const Std140LightingBlock& block)
+{
+  return reinterpret_cast<const std::byte*>(&block);
+}
+
+static float ReadFloat(const std::byte* bytes, std::size_t offset)
+{
+  float value = 0.0f;
+  std::memcpy(&value, bytes + offset, sizeof(value));
+  return value;
+}
+
+static int32_t ReadInt(const std::byte* bytes, std::size_t offset)
+{
+  int32_t value = 0;
+  std::memcpy(&value, bytes + offset, sizeof(value));
+  return value;
+}
+
+static bool ReadsVec3(const std::byte* bytes, std::size_t offset, const Vector3& expected)
+{
+  return ReadFloat(bytes, offset) == expected.x && ReadFloat(bytes, offset + 4) == expected.y &&
+         ReadFloat(bytes, offset + 8) == expected.z;
+}
+
+/* Every byte of the block is set first, so a read at a wrong offset does not find the expected value by chance */
+static Std140LightingBlock MakePoisonedBlock()
+{
+  Std140LightingBlock block;
+  std::memset(&block, 0xAB, sizeof(block));
+  return block;
+}
+
+static PointLight MakePointLight(float seed)
+{
+  PointLight light;
+  light.Position = Vector3(seed, seed + 1.0f, seed + 2.0f);
+  light.Constant = seed + 3.0f;
+  light.Linear = seed + 4.0f;
+  light.Quadratic = seed + 5.0f;
+  light.Ambient = Vector3(seed + 6.0f, seed + 7.0f, seed + 8.0f);
+  light.Diffuse = Vector3(seed + 9.0f, seed + 10.0f, seed + 11.0f);
+  light.Specular = Vector3(seed + 12.0f, seed + 13.0f, seed + 14.0f);
+  light.Active = true;
+  return light;
+}
+
+YEAGER_TEST(LightingBlock, PointLightsAreAtTheirStd140Offsets)
+{
+  Std140LightingBlock block = MakePoisonedBlock();
+  for (Uint x = 0; x < YEAGER_LIGHTING_BLOCK_POINT_LIGHTS; x++) {
+    PointLight light = MakePointLight(x * 100.0f);
+    light.Active = x % 2 == 0;
+    block.PointLights[x] = Std140PointLight();
+    PackStd140PointLight(light, &block.PointLights[x]);
+  }
+
+  /* The array starts after the spot and directional lights, each element is rounded up to 80 bytes */
+  const std::byte* bytes = BlockBytes(block);
+  bool allMatch = true;
+  for (Uint x = 0; x < YEAGER_LIGHTING_BLOCK_POINT_LIGHTS; x++) {
+    const float seed = x * 100.0f;
+    const std::size_t base = 176 + x * 80;
+    allMatch &= ReadsVec3(bytes, base + 0, Vector3(seed, seed + 1.0f, seed + 2.0f));
+    /* The scalar packed in the fourth component of the position */
+    allMatch &= ReadFloat(bytes, base + 12) == seed + 3.0f;
+    allMatch &= ReadFloat(bytes, base + 16) == seed + 4.0f;
+    allMatch &= ReadFloat(bytes, base + 20) == seed + 5.0f;
+    allMatch &= ReadFloat(bytes, base + 24) == 0.0f && ReadFloat(bytes, base + 28) == 0.0f;
+    allMatch &= ReadsVec3(bytes, base + 32, Vector3(seed + 6.0f, seed + 7.0f, seed + 8.0f));
+    allMatch &= ReadFloat(bytes, base + 44) == 0.0f;
+    allMatch &= ReadsVec3(bytes, base + 48, Vector3(seed + 9.0f, seed + 10.0f, seed + 11.0f));
+    allMatch &= ReadFloat(bytes, base + 60) == 0.0f;
+    allMatch &= ReadsVec3(bytes, base + 64, Vector3(seed + 12.0f, seed + 13.0f, seed + 14.0f));
+    /* A bool of std140 takes 4 bytes, right after the last vec3 */
+    allMatch &= ReadInt(bytes, base + 76) == (x % 2 == 0 ? 1 : 0);
+  }
+  YEAGER_EXPECT(allMatch);
+}
+
+YEAGER_TEST(LightingBlock, DirectionalLightIsAtItsStd140Offsets)
+{
+  DirectionalLight light;
+  light.Direction = Vector3(1.0f, 2.0f, 3.0f);
+  light.Ambient = Vector3(4.0f, 5.0f, 6.0f);
+  light.Diffuse = Vector3(7.0f, 8.0f, 9.0f);
+  light.Specular = Vector3(10.0f, 11.0f, 12.0f);
+  light.Color = Vector3(13.0f, 14.0f, 15.0f);
+
+  Std140LightingBlock block = MakePoisonedBlock();
+  block.DirectionalLight = Std140DirectionalLight();
+  PackStd140DirectionalLight(light, &block.DirectionalLight);
+
+  /* Nothing is packed after the vec3s, every one of them takes a full 16 bytes slot */
+  const std::byte* bytes = BlockBytes(block);
+  const std::size_t base = 96;
+  YEAGER_EXPECT(ReadsVec3(bytes, base + 0, light.Direction));
+  YEAGER_EXPECT(ReadsVec3(bytes, base + 16, light.Ambient));
+  YEAGER_EXPECT(ReadsVec3(bytes, base + 32, light.Diffuse));
+  YEAGER_EXPECT(ReadsVec3(bytes, base + 48, light.Specular));
+  YEAGER_EXPECT(ReadsVec3(bytes, base + 64, light.Color));
+  for (std::size_t padding = base + 12; padding < base + 80; padding += 16) {
+    YEAGER_EXPECT_EQ(ReadFloat(bytes, padding), 0.0f);
+  }
+}
+
+YEAGER_TEST(LightingBlock, SpotLightIsAtItsStd140Offsets)
+{
+  SpotLight light;
+  light.CutOff = 0.9f;
+  light.OuterCutOff = 0.8f;
+  light.Constant = 2.0f;
+  light.Linear = 0.5f;
+  light.Quadratic = 0.25f;
+  light.Ambient = Vector3(1.0f, 2.0f, 3.0f);
+  light.Diffuse = Vector3(4.0f, 5.0f, 6.0f);
+  light.Specular = Vector3(7.0f, 8.0f, 9.0f);
+  light.Active = true;
+  /* The position and direction given follow the camera, the ones stored in the light are ignored */
+  light.Position = Vector3(-1.0f);
+  light.Direction = Vector3(-1.0f);
+
+  Std140LightingBlock block = MakePoisonedBlock();
+  block.SpotLight = Std140SpotLight();
+  PackStd140SpotLight(light, Vector3(10.0f, 11.0f, 12.0f), Vector3(0.0f, 0.0f, -1.0f), &block.SpotLight);
+
+  const std::byte* bytes = BlockBytes(block);
+  YEAGER_EXPECT(ReadsVec3(bytes, 0, Vector3(10.0f, 11.0f, 12.0f)));
+  YEAGER_EXPECT_EQ(ReadFloat(bytes, 12), 0.0f);
+  YEAGER_EXPECT(ReadsVec3(bytes, 16, Vector3(0.0f, 0.0f, -1.0f)));
+  /* The cut off fills the fourth component of the direction, the other scalars follow in the next slot */
+  YEAGER_EXPECT_EQ(ReadFloat(bytes, 28), 0.9f);
+  YEAGER_EXPECT_EQ(ReadFloat(bytes, 32), 0.8f);
+  YEAGER_EXPECT_EQ(ReadFloat(bytes, 36), 2.0f);
+  YEAGER_EXPECT_EQ(ReadFloat(bytes, 40), 0.5f);
+  YEAGER_EXPECT_EQ(ReadFloat(bytes, 44), 0.25f);
+  YEAGER_EXPECT(ReadsVec3(bytes, 48, light.Ambient));
+  YEAGER_EXPECT_EQ(ReadFloat(bytes, 60), 0.0f);
+  YEAGER_EXPECT(ReadsVec3(bytes, 64, light.Diffuse));
+  YEAGER_EXPECT_EQ(ReadFloat(bytes, 76), 0.0f);
+  YEAGER_EXPECT(ReadsVec3(bytes, 80, light.Specular));
+  YEAGER_EXPECT_EQ(ReadInt(bytes, 92), 1);
+
+  light.Active = false;
+  PackStd140SpotLight(light, Vector3(0.0f), Vector3(0.0f), &block.SpotLight);
+  YEAGER_EXPECT_EQ(ReadInt(bytes, 92), 0);
+}
+
+YEAGER_TEST(LightingBlock, BlockHasTheSizeTheShadersDeclare)
+{
+  YEAGER_EXPECT_EQ(sizeof(Std140LightingBlock), std::size_t(992));
+  YEAGER_EXPECT_EQ(sizeof(Std140PointLight), std::size_t(80));
+
+  /* The viewer is the last member, after the whole point lights array */
+  LightingBlock lighting;
+  lighting.SetViewerPosition(Vector3(3.0f, 4.0f, 5.0f));
+  const std::byte* bytes = BlockBytes(lighting.GetData());
+  YEAGER_EXPECT(ReadsVec3(bytes, 176 + YEAGER_LIGHTING_BLOCK_POINT_LIGHTS * 80, Vector3(3.0f, 4.0f, 5.0f)));
+  YEAGER_EXPECT(ReadsVec3(bytes, 992 - 16, Vector3(3.0f, 4.0f, 5.0f)));
+}
+
+YEAGER_TEST(LightingBlock, DisablingPointLightsKeepsTheirValues)
+{
+  LightingBlock lighting;
+  Std140PointLight light;
+  PackStd140PointLight(MakePointLight(1.0f), &light);
+  lighting.SetPointLight(3, light);
+  /* Out of the array, ignored */
+  lighting.SetPointLight(YEAGER_LIGHTING_BLOCK_POINT_LIGHTS, light);
+  YEAGER_EXPECT(lighting.IsDirty());
+  YEAGER_EXPECT_EQ(lighting.GetData().PointLights[3].Active, 1);
+
+  lighting.DisablePointLightsFrom(4);
+  YEAGER_EXPECT_EQ(lighting.GetData().PointLights[3].Active, 1);
+  lighting.DisablePointLightsFrom(3);
+  YEAGER_EXPECT_EQ(lighting.GetData().PointLights[3].Active, 0);
+  YEAGER_EXPECT_EQ(lighting.GetData().PointLights[3].Constant, 4.0f);
+}
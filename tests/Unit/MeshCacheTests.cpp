@@ -0,0 +1,248 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Kernel/Caching/MeshCacheFile.h"
+using namespace Yeager;
+
+static YEAGER_CONSTEXPR uint64_t sTestKey = 0x1234abcd5678ef00ull;
+static YEAGER_CONSTEXPR uint32_t sTestStride = 20;
+
+/* Two meshes of made up 20 bytes vertices sharing a texture, and two bones, the sources point into these vectors */
+struct TestModel {
+  std::vector<unsigned char> Vertices[2];
+  std::vector<GLuint> Indices[2];
+  MeshCacheContents Contents;
+
+  TestModel()
+  {
+    Contents.Key = sTestKey;
+    Contents.Kind = MeshCacheKind::eANIMATED;
+    Contents.VertexStride = sTestStride;
+    Contents.BoneCounter = 2;
+    Contents.Textures = {{"Textures/albedo.png", "texture_diffuse"}, {"Textures/normal.png", "texture_normal"}};
+
+    for (Uint x = 0; x < 2; x++) {
+      const uint32_t vertexCount = 3 + x * 5;
+      Vertices[x].resize(vertexCount * sTestStride);
+      for (std::size_t y = 0; y < Vertices[x].size(); y++) {
+        Vertices[x][y] = static_cast<unsigned char>(y * 7 + x);
+      }
+      for (GLuint y = 0; y < vertexCount * 2; y++) {
+        Indices[x].push_back((y * 5 + x) % vertexCount);
+      }
+
+      MeshCacheMeshSource mesh;
+      mesh.Vertices = Vertices[x].data();
+      mesh.VertexCount = vertexCount;
+      mesh.Indices = Indices[x];
+      mesh.TextureRefs = x == 0 ? std::vector<uint32_t>{0, 1} : std::vector<uint32_t>{1};
+      mesh.Bounds = AABB(Vector3(-1.0f - x), Vector3(2.0f + x));
+      Contents.Meshes.push_back(mesh);
+    }
+
+    for (int x = 0; x < 2; x++) {
+      MeshCacheBoneSource bone;
+      bone.Name = "Bone" + std::to_string(x);
+      bone.ID = x;
+      for (Uint y = 0; y < 16; y++) {
+        bone.OffSet[y] = static_cast<float>(x * 16 + y);
+      }
+      Contents.Bones.push_back(bone);
+    }
+  }
+};
+
+/* Writes the test model, changes the file with the given function and tells if it still opens */
+template <typename PatchFun>
+static bool OpensAfterPatch(const String& name, PatchFun&& patch)
+{
+  const String path = (Test::MakeTestFolder(name) / "model.yobj_ch").string();
+  TestModel model;
+  if (!WriteMeshCacheFile(path, model.Contents))
+    return true;
+
+  std::vector<unsigned char> data = Test::ReadTestFile(path);
+  patch(data);
+  Test::WriteTestFile(path, data);
+
+  MeshCacheFile file;
+  return file.Open(path, sTestKey, MeshCacheKind::eANIMATED, sTestStride);
+}
+
+YEAGER_TEST(MeshCache, RoundTripKeepsEveryTable)
+{
+  const String path = (Test::MakeTestFolder("MeshCacheRoundTrip") / "model.yobj_ch").string();
+  TestModel model;
+  YEAGER_EXPECT(WriteMeshCacheFile(path, model.Contents));
+
+  MeshCacheFile file;
+  YEAGER_EXPECT(file.Open(path, sTestKey, MeshCacheKind::eANIMATED, sTestStride));
+  if (!file.GetMapping())
+    return;
+
+  const MeshCacheHeader& header = file.GetHeader();
+  YEAGER_EXPECT_EQ(header.MeshCount, 2u);
+  YEAGER_EXPECT_EQ(header.TextureCount, 2u);
+  YEAGER_EXPECT_EQ(header.TextureRefCount, 3u);
+  YEAGER_EXPECT_EQ(header.BoneCount, 2u);
+  YEAGER_EXPECT_EQ(header.BoneCounter, 2);
+  YEAGER_EXPECT_EQ(header.FileSize, uint64_t(std::filesystem::file_size(path)));
+
+  for (uint32_t x = 0; x < 2; x++) {
+    const MeshCacheMeshEntry& mesh = file.GetMesh(x);
+    const MeshCacheMeshSource& source = model.Contents.Meshes[x];
+    YEAGER_EXPECT_EQ(mesh.VertexCount, source.VertexCount);
+    YEAGER_EXPECT_EQ(mesh.IndexCount, uint32_t(source.Indices.size()));
+    YEAGER_EXPECT_EQ(mesh.VertexOffset % YEAGER_MESH_CACHE_ALIGNMENT, 0u);
+    YEAGER_EXPECT_EQ(mesh.IndexOffset % YEAGER_MESH_CACHE_ALIGNMENT, 0u);
+    YEAGER_EXPECT(std::memcmp(file.GetVertices(mesh), model.Vertices[x].data(), model.Vertices[x].size()) == 0);
+    YEAGER_EXPECT(std::equal(source.Indices.begin(), source.Indices.end(), file.GetIndices(mesh)));
+    YEAGER_EXPECT_EQ(mesh.TextureRefCount, uint32_t(source.TextureRefs.size()));
+    for (uint32_t y = 0; y < mesh.TextureRefCount; y++) {
+      YEAGER_EXPECT_EQ(file.GetTextureRef(mesh, y), source.TextureRefs[y]);
+    }
+    for (Uint y = 0; y < 3; y++) {
+      YEAGER_EXPECT_EQ(mesh.BoundsMin[y], source.Bounds.Min[y]);
+      YEAGER_EXPECT_EQ(mesh.BoundsMax[y], source.Bounds.Max[y]);
+    }
+  }
+
+  for (uint32_t x = 0; x < 2; x++) {
+    YEAGER_EXPECT_EQ(file.GetTexturePath(x), model.Contents.Textures[x].Path);
+    YEAGER_EXPECT_EQ(file.GetTextureType(x), model.Contents.Textures[x].Type);
+    YEAGER_EXPECT_EQ(file.GetBoneName(x), model.Contents.Bones[x].Name);
+    YEAGER_EXPECT_EQ(file.GetBone(x).ID, model.Contents.Bones[x].ID);
+    YEAGER_EXPECT(std::memcmp(file.GetBone(x).OffSet, model.Contents.Bones[x].OffSet, sizeof(float) * 16) == 0);
+  }
+}
+
+YEAGER_TEST(MeshCache, MeshesKeepTheMappingAfterTheFileIsGone)
+{
+  const String path = (Test::MakeTestFolder("MeshCacheMapping") / "model.yobj_ch").string();
+  TestModel model;
+  YEAGER_EXPECT(WriteMeshCacheFile(path, model.Contents));
+
+  std::shared_ptr<MappedFile> mapping;
+  const GLuint* indices = YEAGER_NULLPTR;
+  {
+    MeshCacheFile file;
+    YEAGER_EXPECT(file.Open(path, sTestKey, MeshCacheKind::eANIMATED, sTestStride));
+    if (!file.GetMapping())
+      return;
+    mapping = file.GetMapping();
+    indices = file.GetIndices(file.GetMesh(1));
+  }
+  YEAGER_EXPECT(mapping->IsOpen());
+  YEAGER_EXPECT(std::equal(model.Indices[1].begin(), model.Indices[1].end(), indices));
+}
+
+YEAGER_TEST(MeshCache, RejectsAnotherKeyKindOrStride)
+{
+  const String path = (Test::MakeTestFolder("MeshCacheMismatch") / "model.yobj_ch").string();
+  TestModel model;
+  YEAGER_EXPECT(WriteMeshCacheFile(path, model.Contents));
+
+  MeshCacheFile file;
+  YEAGER_EXPECT(!file.Open(path, sTestKey + 1, MeshCacheKind::eANIMATED, sTestStride));
+  YEAGER_EXPECT(!file.Open(path, sTestKey, MeshCacheKind::eSTATIC, sTestStride));
+  YEAGER_EXPECT(!file.Open(path, sTestKey, MeshCacheKind::eANIMATED, sTestStride + 4));
+  YEAGER_EXPECT(!file.GetMapping());
+  YEAGER_EXPECT(file.Open(path, sTestKey, MeshCacheKind::eANIMATED, sTestStride));
+}
+
+YEAGER_TEST(MeshCache, RejectsMissingFile)
+{
+  MeshCacheFile file;
+  const std::filesystem::path path = Test::MakeTestFolder("MeshCacheMissing") / "missing.yobj_ch";
+  YEAGER_EXPECT(!file.Open(path.string(), sTestKey, MeshCacheKind::eANIMATED, sTestStride));
+}
+
+YEAGER_TEST(MeshCache, RejectsAnotherVersionOrMagic)
+{
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheVersion", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(MeshCacheHeader, Version), uint32_t(YEAGER_MESH_CACHE_VERSION + 1));
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheMagic", [](std::vector<unsigned char>& data) { data[0] = 'X'; }));
+  YEAGER_EXPECT(OpensAfterPatch("MeshCacheUntouched", [](std::vector<unsigned char>&) {}));
+}
+
+YEAGER_TEST(MeshCache, RejectsTruncatedFile)
+{
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheTruncated", [](std::vector<unsigned char>& data) {
+    data.resize(data.size() - YEAGER_MESH_CACHE_ALIGNMENT);
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheHeaderOnly", [](std::vector<unsigned char>& data) {
+    data.resize(sizeof(MeshCacheHeader) / 2);
+  }));
+  /* Truncated, with a header that agrees with the new size, the blobs of the last mesh fall outside of the file */
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheTruncatedHeader", [](std::vector<unsigned char>& data) {
+    data.resize(data.size() - YEAGER_MESH_CACHE_ALIGNMENT);
+    Test::PatchValue(data, offsetof(MeshCacheHeader, FileSize), uint64_t(data.size()));
+  }));
+}
+
+YEAGER_TEST(MeshCache, RejectsCorruptedTables)
+{
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheMeshCount", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(MeshCacheHeader, MeshCount), uint32_t(1u << 30));
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheStrings", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(MeshCacheHeader, StringsOffset), uint64_t(data.size() + 1));
+  }));
+
+  auto firstMesh = [](const std::vector<unsigned char>& data) {
+    MeshCacheHeader header;
+    std::memcpy(&header, data.data(), sizeof(MeshCacheHeader));
+    return header.MeshTableOffset;
+  };
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheVertexOffset", [&firstMesh](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, firstMesh(data) + offsetof(MeshCacheMeshEntry, VertexOffset), uint64_t(data.size()));
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheUnalignedIndices", [&firstMesh](std::vector<unsigned char>& data) {
+    const uint64_t at = firstMesh(data) + offsetof(MeshCacheMeshEntry, IndexOffset);
+    uint64_t offset = 0;
+    std::memcpy(&offset, data.data() + at, sizeof(uint64_t));
+    Test::PatchValue(data, at, offset + 4);
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheTextureRef", [](std::vector<unsigned char>& data) {
+    MeshCacheHeader header;
+    std::memcpy(&header, data.data(), sizeof(MeshCacheHeader));
+    Test::PatchValue(data, header.TextureRefOffset, uint32_t(header.TextureCount));
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheBoneName", [](std::vector<unsigned char>& data) {
+    MeshCacheHeader header;
+    std::memcpy(&header, data.data(), sizeof(MeshCacheHeader));
+    Test::PatchValue(data, header.BoneTableOffset + offsetof(MeshCacheBoneEntry, NameLength), uint32_t(1u << 20));
+  }));
+}
+
+YEAGER_TEST(MeshCache, RejectsIndicesOutsideOfTheMesh)
+{
+  auto meshEntry = [](const std::vector<unsigned char>& data, uint32_t index) {
+    MeshCacheHeader header;
+    std::memcpy(&header, data.data(), sizeof(MeshCacheHeader));
+    MeshCacheMeshEntry mesh;
+    std::memcpy(&mesh, data.data() + header.MeshTableOffset + index * sizeof(MeshCacheMeshEntry), sizeof(mesh));
+    return mesh;
+  };
+
+  /* The last vertex of the mesh is still valid, one past it is not, even if the next mesh has that many vertices */
+  YEAGER_EXPECT(OpensAfterPatch("MeshCacheLastIndex", [&meshEntry](std::vector<unsigned char>& data) {
+    const MeshCacheMeshEntry mesh = meshEntry(data, 0);
+    Test::PatchValue(data, mesh.IndexOffset + (mesh.IndexCount - 1) * sizeof(GLuint), GLuint(mesh.VertexCount - 1));
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheIndexPastTheVertices", [&meshEntry](std::vector<unsigned char>& data) {
+    const MeshCacheMeshEntry mesh = meshEntry(data, 0);
+    Test::PatchValue(data, mesh.IndexOffset + (mesh.IndexCount - 1) * sizeof(GLuint), GLuint(mesh.VertexCount));
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("MeshCacheHugeIndex", [&meshEntry](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, meshEntry(data, 1).IndexOffset, GLuint(0xFFFFFFFFu));
+  }));
+}
+
+YEAGER_TEST(MeshCache, WriteRejectsTextureOutsideOfTheModel)
+{
+  const String path = (Test::MakeTestFolder("MeshCacheBadRef") / "model.yobj_ch").string();
+  TestModel model;
+  model.Contents.Meshes[1].TextureRefs.push_back(2);
+  YEAGER_EXPECT(!WriteMeshCacheFile(path, model.Contents));
+  YEAGER_EXPECT(!std::filesystem::exists(path));
+}
@@ -0,0 +1,198 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Loader/MeshOptimizer.h"
+
+#include <array>
+#include <random>
+#include <tuple>
+using namespace Yeager;
+
+struct TestVertex {
+  Vector3 Position = YEAGER_ZERO_VECTOR3;
+  Vector2 TextureCoords = YEAGER_ZERO_VECTOR2;
+};
+
+/* Grid of size * size quads on the XY plane, two triangles each, in a random order */
+struct TestGrid {
+  std::vector<TestVertex> Vertices;
+  std::vector<GLuint> Indices;
+
+  TestGrid(Uint size, uint32_t seed)
+  {
+    for (Uint y = 0; y <= size; y++) {
+      for (Uint x = 0; x <= size; x++) {
+        TestVertex vertex;
+        vertex.Position = Vector3(float(x), float(y), 0.0f);
+        vertex.TextureCoords = Vector2(float(x) / size, float(y) / size);
+        Vertices.push_back(vertex);
+      }
+    }
+
+    std::vector<std::array<GLuint, 3>> triangles;
+    for (Uint y = 0; y < size; y++) {
+      for (Uint x = 0; x < size; x++) {
+        const GLuint corner = y * (size + 1) + x;
+        triangles.push_back({corner, corner + 1, corner + size + 1});
+        triangles.push_back({corner + 1, corner + size + 2, corner + size + 1});
+      }
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(seed));
+    for (const auto& triangle : triangles) {
+      Indices.insert(Indices.end(), triangle.begin(), triangle.end());
+    }
+  }
+};
+
+using TestTriangle = std::array<Vector3, 3>;
+
+/* The triangles by the positions of their corners, rotated to start at the smallest corner so the winding is kept */
+static std::vector<TestTriangle> CollectTriangles(const std::vector<TestVertex>& vertices,
+                                                  const std::vector<GLuint>& indices)
+{
+  auto less = [](const Vector3& first, const Vector3& second) {
+    return std::tie(first.x, first.y, first.z) < std::tie(second.x, second.y, second.z);
+  };
+
+  std::vector<TestTriangle> triangles;
+  for (std::size_t x = 0; x + 2 < indices.size(); x += 3) {
+    TestTriangle triangle = {vertices[indices[x]].Position, vertices[indices[x + 1]].Position,
+                             vertices[indices[x + 2]].Position};
+    const auto smallest = std::min_element(triangle.begin(), triangle.end(), less);
+    std::rotate(triangle.begin(), smallest, triangle.end());
+    triangles.push_back(triangle);
+  }
+  std::sort(triangles.begin(), triangles.end(), [&less](const TestTriangle& first, const TestTriangle& second) {
+    return std::lexicographical_compare(first.begin(), first.end(), second.begin(), second.end(), less);
+  });
+  return triangles;
+}
+
+static bool IndicesAreValid(const std::vector<GLuint>& indices, std::size_t vertexCount)
+{
+  return indices.size() % 3 == 0 &&
+         std::all_of(indices.begin(), indices.end(), [vertexCount](GLuint index) { return index < vertexCount; });
+}
+
+YEAGER_TEST(MeshOptimizer, AnalyzeCountsEveryMissOfALoneTriangle)
+{
+  const VertexCacheStatistics stats = AnalyzeVertexCache({0, 1, 2, 0, 1, 2}, 3);
+  YEAGER_EXPECT_EQ(stats.VerticesTransformed, 3u);
+  YEAGER_EXPECT_NEAR(stats.ACMR, 1.5f, 1e-6f);
+  YEAGER_EXPECT_NEAR(stats.ATVR, 1.0f, 1e-6f);
+}
+
+YEAGER_TEST(MeshOptimizer, VertexCacheOrderKeepsTheTrianglesAndLowersTheACMR)
+{
+  TestGrid grid(32, 1);
+  const std::vector<TestTriangle> before = CollectTriangles(grid.Vertices, grid.Indices);
+  const VertexCacheStatistics statsBefore = AnalyzeVertexCache(grid.Indices, grid.Vertices.size());
+
+  OptimizeVertexCache(grid.Indices, grid.Vertices.size());
+  const VertexCacheStatistics statsAfter = AnalyzeVertexCache(grid.Indices, grid.Vertices.size());
+
+  YEAGER_EXPECT(IndicesAreValid(grid.Indices, grid.Vertices.size()));
+  YEAGER_EXPECT(CollectTriangles(grid.Vertices, grid.Indices) == before);
+  YEAGER_EXPECT(statsAfter.ACMR < statsBefore.ACMR);
+  /* A shuffled grid misses nearly every vertex, a cache ordered one gets close to the 0.5 of an infinite cache */
+  YEAGER_EXPECT(statsAfter.ACMR < 0.8f);
+}
+
+YEAGER_TEST(MeshOptimizer, OverdrawOrderKeepsTheTrianglesWithinTheThreshold)
+{
+  TestGrid grid(32, 2);
+  /* Bent into a half cylinder so the clusters face different ways */
+  for (TestVertex& vertex : grid.Vertices) {
+    const float angle = vertex.Position.x / 32.0f * 3.14159265f;
+    vertex.Position = Vector3(std::cos(angle) * 10.0f, vertex.Position.y, std::sin(angle) * 10.0f);
+  }
+  const std::vector<TestTriangle> before = CollectTriangles(grid.Vertices, grid.Indices);
+
+  OptimizeVertexCache(grid.Indices, grid.Vertices.size());
+  const float cacheOrderedACMR = AnalyzeVertexCache(grid.Indices, grid.Vertices.size()).ACMR;
+  OptimizeOverdraw(grid.Indices, reinterpret_cast<const unsigned char*>(grid.Vertices.data()), grid.Vertices.size(),
+                   sizeof(TestVertex), 1.05f);
+
+  YEAGER_EXPECT(IndicesAreValid(grid.Indices, grid.Vertices.size()));
+  YEAGER_EXPECT(CollectTriangles(grid.Vertices, grid.Indices) == before);
+  YEAGER_EXPECT(AnalyzeVertexCache(grid.Indices, grid.Vertices.size()).ACMR <= cacheOrderedACMR * 1.05f + 1e-4f);
+}
+
+YEAGER_TEST(MeshOptimizer, FetchRemapOrdersVerticesByFirstUseAndDropsUnusedOnes)
+{
+  std::vector<GLuint> indices = {4, 2, 0, 0, 2, 5};
+  std::vector<GLuint> remap;
+  const std::size_t used = BuildVertexFetchRemap(indices, 6, remap);
+
+  YEAGER_EXPECT_EQ(used, 4u);
+  YEAGER_EXPECT(indices == std::vector<GLuint>({0, 1, 2, 2, 1, 3}));
+  YEAGER_EXPECT_EQ(remap[4], 0u);
+  YEAGER_EXPECT_EQ(remap[5], 3u);
+  YEAGER_EXPECT_EQ(remap[1], UINT32_MAX);
+  YEAGER_EXPECT_EQ(remap[3], UINT32_MAX);
+}
+
+YEAGER_TEST(MeshOptimizer, WeldMergesEqualVerticesOnly)
+{
+  /* Every quad of the grid written with its own four vertices, the welding must bring it back to the shared grid */
+  TestGrid grid(8, 3);
+  std::vector<TestVertex> split;
+  std::vector<GLuint> indices;
+  for (GLuint index : grid.Indices) {
+    indices.push_back(static_cast<GLuint>(split.size()));
+    split.push_back(grid.Vertices[index]);
+  }
+  const std::vector<TestTriangle> before = CollectTriangles(split, indices);
+
+  WeldVertices(split, indices);
+  YEAGER_EXPECT_EQ(split.size(), grid.Vertices.size());
+  YEAGER_EXPECT(IndicesAreValid(indices, split.size()));
+  YEAGER_EXPECT(CollectTriangles(split, indices) == before);
+
+  /* Same position, another texture coordinate, both are kept */
+  std::vector<TestVertex> seam(2);
+  seam[1].TextureCoords = Vector2(1.0f, 0.0f);
+  std::vector<GLuint> seamIndices = {0, 1, 0};
+  WeldVertices(seam, seamIndices);
+  YEAGER_EXPECT_EQ(seam.size(), 2u);
+}
+
+YEAGER_TEST(MeshOptimizer, OptimizeMeshKeepsTheTrianglesAndReportsTheGain)
+{
+  TestGrid grid(48, 4);
+  std::vector<TestVertex> vertices;
+  std::vector<GLuint> indices;
+  for (GLuint index : grid.Indices) {
+    indices.push_back(static_cast<GLuint>(vertices.size()));
+    vertices.push_back(grid.Vertices[index]);
+  }
+  const std::vector<TestTriangle> before = CollectTriangles(vertices, indices);
+
+  const MeshOptimizationStatistics stats = OptimizeMesh(vertices, indices);
+  YEAGER_EXPECT_EQ(stats.VerticesBefore, uint32_t(grid.Indices.size()));
+  YEAGER_EXPECT_EQ(stats.VerticesAfter, uint32_t(grid.Vertices.size()));
+  YEAGER_EXPECT_EQ(stats.VerticesAfter, uint32_t(vertices.size()));
+  YEAGER_EXPECT(stats.CacheAfter.ACMR < stats.CacheBefore.ACMR);
+  YEAGER_EXPECT(stats.CacheAfter.VerticesTransformed < stats.CacheBefore.VerticesTransformed);
+  YEAGER_EXPECT(IndicesAreValid(indices, vertices.size()));
+  YEAGER_EXPECT(CollectTriangles(vertices, indices) == before);
+
+  /* After the fetch ordering every vertex is first used after the ones before it */
+  GLuint next = 0;
+  for (GLuint index : indices) {
+    YEAGER_EXPECT(index <= next);
+    if (index == next)
+      next++;
+  }
+}
+
+YEAGER_TEST(MeshOptimizer, LeavesIndexBuffersThatAreNotTriangleListsAlone)
+{
+  TestGrid grid(2, 5);
+  std::vector<GLuint> indices = {0, 1, 2, 3};
+  const std::vector<TestVertex> vertices = grid.Vertices;
+  std::vector<TestVertex> optimized = vertices;
+
+  const MeshOptimizationStatistics stats = OptimizeMesh(optimized, indices);
+  YEAGER_EXPECT(indices == std::vector<GLuint>({0, 1, 2, 3}));
+  YEAGER_EXPECT_EQ(optimized.size(), vertices.size());
+  YEAGER_EXPECT_EQ(stats.VerticesAfter, stats.VerticesBefore);
+}
@@ -0,0 +1,100 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Kernel/Caching/PhysXCookingCacheFile.h"
+using namespace Yeager;
+
+static YEAGER_CONSTEXPR uint64_t sTestKey = 0x0badc0ffee0ddf00ull;
+/* Any value works, the file format does not read the PhysX version, it only compares it */
+static YEAGER_CONSTEXPR uint32_t sTestPhysicsVersion = 0x05030000;
+
+/* Made up cooked data, the file never looks inside the stream PhysX writes */
+static std::vector<unsigned char> MakeCookedData(std::size_t size)
+{
+  std::vector<unsigned char> data(size);
+  for (std::size_t x = 0; x < size; x++) {
+    data[x] = static_cast<unsigned char>(x * 13 + 5);
+  }
+  return data;
+}
+
+static String WriteTestCache(const String& name, const std::vector<unsigned char>& cooked)
+{
+  const String path = (Test::MakeTestFolder(name) / "mesh.ypx_ch").string();
+  YEAGER_EXPECT(WritePhysXCookingCacheFile(path, sTestKey, PhysXCookedKind::eTRIANGLE_MESH, sTestPhysicsVersion,
+                                           cooked.data(), cooked.size()));
+  return path;
+}
+
+/* Writes the test cache, changes the file with the given function and tells if it still opens */
+template <typename PatchFun>
+static bool OpensAfterPatch(const String& name, PatchFun&& patch)
+{
+  const String path = WriteTestCache(name, MakeCookedData(300));
+  std::vector<unsigned char> data = Test::ReadTestFile(path);
+  patch(data);
+  Test::WriteTestFile(path, data);
+
+  PhysXCookingCacheFile file;
+  return file.Open(path, sTestKey, PhysXCookedKind::eTRIANGLE_MESH, sTestPhysicsVersion);
+}
+
+YEAGER_TEST(PhysXCookingCache, RoundTripKeepsTheCookedData)
+{
+  const std::vector<unsigned char> cooked = MakeCookedData(1000);
+  const String path = WriteTestCache("PhysXCookingCacheRoundTrip", cooked);
+
+  PhysXCookingCacheFile file;
+  YEAGER_EXPECT(file.Open(path, sTestKey, PhysXCookedKind::eTRIANGLE_MESH, sTestPhysicsVersion));
+  YEAGER_EXPECT_EQ(file.GetDataSize(), cooked.size());
+  if (file.GetDataSize() != cooked.size())
+    return;
+  YEAGER_EXPECT(std::memcmp(file.GetData(), cooked.data(), cooked.size()) == 0);
+  YEAGER_EXPECT_EQ(std::filesystem::file_size(path), sizeof(PhysXCookingCacheHeader) + cooked.size());
+}
+
+YEAGER_TEST(PhysXCookingCache, RejectsAnotherKeyKindOrPhysicsVersion)
+{
+  const String path = WriteTestCache("PhysXCookingCacheMismatch", MakeCookedData(64));
+
+  PhysXCookingCacheFile file;
+  YEAGER_EXPECT(!file.Open(path, sTestKey + 1, PhysXCookedKind::eTRIANGLE_MESH, sTestPhysicsVersion));
+  YEAGER_EXPECT(!file.Open(path, sTestKey, PhysXCookedKind::eCONVEX_MESH, sTestPhysicsVersion));
+  YEAGER_EXPECT(!file.Open(path, sTestKey, PhysXCookedKind::eTRIANGLE_MESH, sTestPhysicsVersion + 1));
+  YEAGER_EXPECT(file.Open(path, sTestKey, PhysXCookedKind::eTRIANGLE_MESH, sTestPhysicsVersion));
+}
+
+YEAGER_TEST(PhysXCookingCache, RejectsAnotherFormat)
+{
+  YEAGER_EXPECT(!OpensAfterPatch("PhysXCookingCacheMagic", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(PhysXCookingCacheHeader, MagicConst), 'X');
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("PhysXCookingCacheVersion", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(PhysXCookingCacheHeader, Version), uint32_t(YEAGER_PHYSX_CACHE_VERSION + 1));
+  }));
+}
+
+YEAGER_TEST(PhysXCookingCache, RejectsTruncatedOrInconsistentFiles)
+{
+  YEAGER_EXPECT(!OpensAfterPatch("PhysXCookingCacheTruncated",
+                                 [](std::vector<unsigned char>& data) { data.resize(data.size() - 1); }));
+  YEAGER_EXPECT(!OpensAfterPatch("PhysXCookingCacheHeaderOnly", [](std::vector<unsigned char>& data) {
+    data.resize(sizeof(PhysXCookingCacheHeader) / 2);
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("PhysXCookingCacheDataSize", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(PhysXCookingCacheHeader, DataSize), uint64_t(299));
+  }));
+  YEAGER_EXPECT(!OpensAfterPatch("PhysXCookingCacheEmpty", [](std::vector<unsigned char>& data) {
+    data.resize(sizeof(PhysXCookingCacheHeader));
+    Test::PatchValue(data, offsetof(PhysXCookingCacheHeader, DataSize), uint64_t(0));
+    Test::PatchValue(data, offsetof(PhysXCookingCacheHeader, FileSize), uint64_t(data.size()));
+  }));
+  /* Unchanged the file still opens, so the rejections above come from the patches */
+  YEAGER_EXPECT(OpensAfterPatch("PhysXCookingCacheUnchanged", [](std::vector<unsigned char>&) {}));
+}
+
+YEAGER_TEST(PhysXCookingCache, MissingFileDoesNotOpen)
+{
+  const std::filesystem::path folder = Test::MakeTestFolder("PhysXCookingCacheMissing");
+  PhysXCookingCacheFile file;
+  YEAGER_EXPECT(!file.Open((folder / "missing.ypx_ch").string(), sTestKey, PhysXCookedKind::eTRIANGLE_MESH,
+                           sTestPhysicsVersion));
+}
@@ -0,0 +1,107 @@
+#include "Framework/YeagerPhysX.h"
+#include "Framework/YeagerTest.h"
+#include "Components/Kernel/Caching/PhysXCookingCache.h"
+using namespace Yeager;
+using namespace physx;
+
+static bool BoundsAreEqual(const PxBounds3& first, const PxBounds3& second)
+{
+  return first.minimum == second.minimum && first.maximum == second.maximum;
+}
+
+YEAGER_TEST(PhysXCooking, CachedTriangleMeshMatchesTheCookedOne)
+{
+  Test::PhysXTestWorld world;
+  YEAGER_EXPECT(world.IsValid());
+  if (!world.IsValid())
+    return;
+
+  const Test::PhysXTestGrid grid(16, 2.0f);
+  const PxTriangleMeshDesc desc = grid.GetDesc();
+  const PxCookingParams params = world.GetCookingParams();
+  const uint64_t key = PhysXCookingCache::ComputeKey(desc, params);
+  const String path = PhysXCookingCache::BuildCachePath(Test::MakeTestFolder("PhysXCookingTriangleMesh").string(), key);
+
+  PxDefaultMemoryOutputStream cooked;
+  YEAGER_EXPECT(PxCookTriangleMesh(params, desc, cooked));
+  YEAGER_EXPECT(PhysXCookingCache::Write(path, key, PhysXCookedKind::eTRIANGLE_MESH, cooked));
+
+  PxDefaultMemoryInputData input(cooked.getData(), cooked.getSize());
+  PxTriangleMesh* expected = world.GetPhysics().createTriangleMesh(input);
+  PxTriangleMesh* loaded = PhysXCookingCache::LoadTriangleMesh(path, key, world.GetPhysics());
+  YEAGER_EXPECT(expected != YEAGER_NULLPTR && loaded != YEAGER_NULLPTR);
+  if (expected != YEAGER_NULLPTR && loaded != YEAGER_NULLPTR) {
+    YEAGER_EXPECT_EQ(loaded->getNbTriangles(), 16u * 16u * 2u);
+    YEAGER_EXPECT_EQ(loaded->getNbTriangles(), expected->getNbTriangles());
+    YEAGER_EXPECT_EQ(loaded->getNbVertices(), expected->getNbVertices());
+    YEAGER_EXPECT(BoundsAreEqual(loaded->getLocalBounds(), expected->getLocalBounds()));
+  }
+  if (expected != YEAGER_NULLPTR)
+    expected->release();
+  if (loaded != YEAGER_NULLPTR)
+    loaded->release();
+
+  /* Another key or kind never reads the cooked data of this one */
+  YEAGER_EXPECT(PhysXCookingCache::LoadTriangleMesh(path, key + 1, world.GetPhysics()) == YEAGER_NULLPTR);
+  YEAGER_EXPECT(PhysXCookingCache::LoadConvexMesh(path, key, world.GetPhysics()) == YEAGER_NULLPTR);
+}
+
+YEAGER_TEST(PhysXCooking, CachedConvexMeshMatchesTheCookedOne)
+{
+  Test::PhysXTestWorld world;
+  YEAGER_EXPECT(world.IsValid());
+  if (!world.IsValid())
+    return;
+
+  const Test::PhysXTestGrid grid(4, 1.0f);
+  PxConvexMeshDesc desc;
+  desc.points.count = static_cast<PxU32>(grid.Points.size());
+  desc.points.stride = sizeof(PxVec3);
+  desc.points.data = grid.Points.data();
+  desc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
+  const PxCookingParams params = world.GetCookingParams();
+  const uint64_t key = PhysXCookingCache::ComputeKey(desc, params);
+  const String path = PhysXCookingCache::BuildCachePath(Test::MakeTestFolder("PhysXCookingConvexMesh").string(), key);
+
+  PxDefaultMemoryOutputStream cooked;
+  YEAGER_EXPECT(PxCookConvexMesh(params, desc, cooked));
+  YEAGER_EXPECT(PhysXCookingCache::Write(path, key, PhysXCookedKind::eCONVEX_MESH, cooked));
+
+  PxDefaultMemoryInputData input(cooked.getData(), cooked.getSize());
+  PxConvexMesh* expected = world.GetPhysics().createConvexMesh(input);
+  PxConvexMesh* loaded = PhysXCookingCache::LoadConvexMesh(path, key, world.GetPhysics());
+  YEAGER_EXPECT(expected != YEAGER_NULLPTR && loaded != YEAGER_NULLPTR);
+  if (expected != YEAGER_NULLPTR && loaded != YEAGER_NULLPTR) {
+    YEAGER_EXPECT_EQ(loaded->getNbVertices(), expected->getNbVertices());
+    YEAGER_EXPECT_EQ(loaded->getNbPolygons(), expected->getNbPolygons());
+    YEAGER_EXPECT(BoundsAreEqual(loaded->getLocalBounds(), expected->getLocalBounds()));
+  }
+  if (expected != YEAGER_NULLPTR)
+    expected->release();
+  if (loaded != YEAGER_NULLPTR)
+    loaded->release();
+}
+
+YEAGER_TEST(PhysXCooking, KeyFollowsTheGeometryAndTheParams)
+{
+  Test::PhysXTestGrid grid(8, 1.0f);
+  const PxCookingParams params{PxTolerancesScale()};
+  const uint64_t key = PhysXCookingCache::ComputeKey(grid.GetDesc(), params);
+
+  /* The same points read with a stride over another attribute hash as the packed ones */
+  std::vector<PxVec4> strided;
+  for (const PxVec3& point : grid.Points) {
+    strided.push_back(PxVec4(point, 99.0f));
+  }
+  PxTriangleMeshDesc stridedDesc = grid.GetDesc();
+  stridedDesc.points.stride = sizeof(PxVec4);
+  stridedDesc.points.data = strided.data();
+  YEAGER_EXPECT_EQ(PhysXCookingCache::ComputeKey(stridedDesc, params), key);
+
+  PxCookingParams welded = params;
+  welded.meshWeldTolerance = 0.5f;
+  YEAGER_EXPECT(PhysXCookingCache::ComputeKey(grid.GetDesc(), welded) != key);
+
+  grid.Points[5].y += 0.001f;
+  YEAGER_EXPECT(PhysXCookingCache::ComputeKey(grid.GetDesc(), params) != key);
+}
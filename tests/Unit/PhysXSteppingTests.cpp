@@ -0,0 +1,166 @@
+#include "Framework/YeagerPhysX.h"
+#include "Framework/YeagerTest.h"
+#include "Components/Kernel/Process/JobSystem.h"
+#include "Components/Physics/PhysXJobDispatcher.h"
+#include "Components/Physics/PhysXSceneStepper.h"
+using namespace Yeager;
+using namespace physx;
+
+/* Starts the job system for the PhysX tasks of a test and stops it at the end */
+struct PhysXSteppingScope {
+  PhysXSteppingScope() { JobSystem::Initialize(4); }
+  ~PhysXSteppingScope() { JobSystem::Terminate(); }
+};
+
+/**
+ * Drops the boxes for the given frame times, repeated until the seconds passed, and returns the poses of every box
+ * after each step fetched at the end of a frame, by the count of steps done
+ */
+static std::map<uint64_t, std::vector<PxTransform>> RecordPoses(Test::PhysXTestWorld& world,
+                                                                const std::vector<float>& frameTimes, float seconds)
+{
+  PhysXJobDispatcher dispatcher;
+  PxScene* scene = world.CreateScene(dispatcher);
+  const std::vector<PxRigidDynamic*> boxes = world.CreateBoxes(60);
+  PhysXSceneStepper stepper;
+  stepper.SetScene(scene);
+  for (PxRigidDynamic* box : boxes) {
+    stepper.AddActor(box);
+  }
+
+  std::map<uint64_t, std::vector<PxTransform>> poses;
+  float time = 0.0f;
+  for (std::size_t x = 0; time < seconds; x++) {
+    const float frameTime = frameTimes[x % frameTimes.size()];
+    time += frameTime;
+    stepper.Start(frameTime);
+    stepper.End();
+    std::vector<PxTransform>& step = poses[stepper.GetCompletedSteps()];
+    step.clear();
+    for (PxRigidDynamic* box : boxes) {
+      step.push_back(box->getGlobalPose());
+    }
+  }
+
+  stepper.Reset();
+  scene->release();
+  return poses;
+}
+
+static bool PosesAreEqual(const std::vector<PxTransform>& first, const std::vector<PxTransform>& second)
+{
+  if (first.size() != second.size())
+    return false;
+  for (std::size_t x = 0; x < first.size(); x++) {
+    if (!(first[x].p == second[x].p) || !(first[x].q == second[x].q))
+      return false;
+  }
+  return true;
+}
+
+YEAGER_TEST(PhysXStepping, PosesDoNotDependOnTheFrameTimes)
+{
+  PhysXSteppingScope scope;
+  Test::PhysXTestWorld world;
+  YEAGER_EXPECT(world.IsValid());
+  if (!world.IsValid())
+    return;
+
+  /* Steady 60 Hz frames, faster frames that step every few frames, and uneven frames that take two or three steps */
+  const auto steady = RecordPoses(world, {1.0f / 60.0f}, 3.0f);
+  const auto fast = RecordPoses(world, {1.0f / 144.0f}, 3.0f);
+  const auto uneven = RecordPoses(world, {1.0f / 30.0f, 1.0f / 100.0f, 1.0f / 20.0f, 1.0f / 75.0f}, 3.0f);
+
+  for (const auto* other : {&fast, &uneven}) {
+    Uint compared = 0;
+    uint64_t lastCompared = 0;
+    for (const auto& [step, poses] : steady) {
+      const auto it = other->find(step);
+      if (it == other->end())
+        continue;
+      YEAGER_EXPECT(PosesAreEqual(poses, it->second));
+      compared++;
+      lastCompared = step;
+    }
+    /* The boxes have landed and piled up by the last steps compared */
+    YEAGER_EXPECT(compared >= 40);
+    YEAGER_EXPECT(lastCompared >= 170);
+  }
+}
+
+YEAGER_TEST(PhysXStepping, StepsAtTheFixedRateAndDropsTheTimeOverTheLimit)
+{
+  PhysXSteppingScope scope;
+  Test::PhysXTestWorld world;
+  YEAGER_EXPECT(world.IsValid());
+  if (!world.IsValid())
+    return;
+
+  PhysXJobDispatcher dispatcher;
+  PxScene* scene = world.CreateScene(dispatcher);
+  PhysXSceneStepper stepper;
+  stepper.SetScene(scene);
+  stepper.SetSettings(PhysXStepSettings{50.0f, 3});
+
+  /* A second of 100 Hz frames is 50 steps, the last one or two may be lost to the rounding of the frame times */
+  for (Uint x = 0; x < 100; x++) {
+    stepper.Start(0.01f);
+    YEAGER_EXPECT(stepper.GetInterpolationAlpha() >= 0.0f && stepper.GetInterpolationAlpha() < 1.0f);
+    stepper.End();
+  }
+  YEAGER_EXPECT(stepper.GetCompletedSteps() >= 49 && stepper.GetCompletedSteps() <= 50);
+
+  /* A frame of a second takes the max steps only, the rest of the second is dropped */
+  const uint64_t before = stepper.GetCompletedSteps();
+  stepper.Start(1.0f);
+  stepper.End();
+  YEAGER_EXPECT_EQ(stepper.GetCompletedSteps() - before, uint64_t(3));
+  YEAGER_EXPECT(stepper.GetInterpolationAlpha() < 1.0f);
+
+  stepper.Reset();
+  scene->release();
+}
+
+YEAGER_TEST(PhysXStepping, InterpolatedPoseStaysBetweenTheLastTwoSteps)
+{
+  PhysXSteppingScope scope;
+  Test::PhysXTestWorld world;
+  YEAGER_EXPECT(world.IsValid());
+  if (!world.IsValid())
+    return;
+
+  PhysXJobDispatcher dispatcher;
+  PxScene* scene = world.CreateScene(dispatcher);
+  PhysXSceneStepper stepper;
+  stepper.SetScene(scene);
+  /* High enough to fall for the whole test, its height goes down at every step */
+  PxRigidDynamic* box = world.CreateBoxes(1).front();
+  box->setGlobalPose(PxTransform(PxVec3(0.0f, 500.0f, 0.0f)));
+  stepper.AddActor(box);
+  stepper.RegisterInterpolatedActor(box);
+
+  /* Frames shorter than a step, so every step is fetched at the end of a frame and its height is seen */
+  std::vector<float> heights = {box->getGlobalPose().p.y};
+  for (Uint x = 0; x < 200; x++) {
+    stepper.Start(x % 3 == 0 ? 1.0f / 90.0f : 1.0f / 144.0f);
+    /* The drawn pose is between the last two steps started before this one, at the alpha of the render time */
+    const uint64_t started = stepper.GetCompletedSteps() + (stepper.IsSimulating() ? 1 : 0);
+    const float drawn = stepper.GetInterpolatedPose(box).p.y;
+    if (started >= 2) {
+      const float older = heights[started - 2];
+      const float newer = heights[started - 1];
+      YEAGER_EXPECT(drawn <= older + 1e-4f && drawn >= newer - 1e-4f);
+      YEAGER_EXPECT_NEAR(drawn, older + (newer - older) * stepper.GetInterpolationAlpha(), 1e-3f);
+    } else {
+      YEAGER_EXPECT_NEAR(drawn, heights[0], 1e-4f);
+    }
+    stepper.End();
+    if (heights.size() == stepper.GetCompletedSteps())
+      heights.push_back(box->getGlobalPose().p.y);
+  }
+  YEAGER_EXPECT(heights.size() > 100);
+  YEAGER_EXPECT(heights.back() < heights.front());
+
+  stepper.Reset();
+  scene->release();
+}
@@ -0,0 +1,237 @@
+#include "Framework/YeagerTest.h"
+#include "Common/Math/Quantization.h"
+
+#include <random>
+using namespace Yeager;
+
+static YEAGER_CONSTEXPR float sPi = 3.14159265358979f;
+
+/* Uniform directions on the sphere, plus the axes and the diagonals where the octahedron folds */
+static std::vector<Vector3> MakeTestDirections(std::size_t count, uint32_t seed)
+{
+  std::vector<Vector3> directions = {Vector3(1, 0, 0), Vector3(-1, 0, 0), Vector3(0, 1, 0), Vector3(0, -1, 0),
+                                     Vector3(0, 0, 1), Vector3(0, 0, -1), glm::normalize(Vector3(1, 1, -1)),
+                                     glm::normalize(Vector3(-1, 1, 1)), glm::normalize(Vector3(1, -1, 0))};
+  std::mt19937 random(seed);
+  std::normal_distribution<float> axis(0.0f, 1.0f);
+  while (directions.size() < count) {
+    const Vector3 direction(axis(random), axis(random), axis(random));
+    if (glm::length(direction) > 1e-3f)
+      directions.push_back(glm::normalize(direction));
+  }
+  return directions;
+}
+
+/* From the chord between the unit vectors, acos of their dot product loses the small angles to the float rounding */
+static float AngleInDegrees(const Vector3& first, const Vector3& second)
+{
+  return 2.0f * std::asin(std::min(glm::length(first - second) * 0.5f, 1.0f)) * 180.0f / sPi;
+}
+
+YEAGER_TEST(Quantization, HalfKeepsExactValues)
+{
+  const float values[] = {0.0f, 1.0f, -2.0f, 0.5f, 0.099975586f, 65504.0f, -65504.0f, 6.1035156e-5f, 5.9604645e-8f};
+  for (float value : values) {
+    YEAGER_EXPECT_EQ(HalfToFloat(FloatToHalf(value)), value);
+  }
+  YEAGER_EXPECT_EQ(FloatToHalf(1.0f), uint16_t(0x3c00));
+  YEAGER_EXPECT_EQ(FloatToHalf(-0.0f), uint16_t(0x8000));
+}
+
+YEAGER_TEST(Quantization, HalfRoundTripsEveryHalf)
+{
+  Uint mismatches = 0;
+  for (uint32_t bits = 0; bits <= 0xffff; bits++) {
+    const uint16_t half = static_cast<uint16_t>(bits);
+    const float value = HalfToFloat(half);
+    if (std::isnan(value)) {
+      YEAGER_EXPECT(std::isnan(HalfToFloat(FloatToHalf(value))));
+    } else if (FloatToHalf(value) != half) {
+      mismatches++;
+    }
+  }
+  YEAGER_EXPECT_EQ(mismatches, 0u);
+}
+
+YEAGER_TEST(Quantization, HalfRoundsToNearestEvenAndOverflowsToInfinity)
+{
+  /* Halfway between 1 and the next half, and between the next one and the one after it, both go to the even one */
+  YEAGER_EXPECT_EQ(FloatToHalf(1.0f + std::ldexp(1.0f, -11)), uint16_t(0x3c00));
+  YEAGER_EXPECT_EQ(FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)), uint16_t(0x3c02));
+  YEAGER_EXPECT(std::isinf(HalfToFloat(FloatToHalf(1e6f))));
+  YEAGER_EXPECT(HalfToFloat(FloatToHalf(-1e6f)) < 0.0f);
+  YEAGER_EXPECT(std::isnan(HalfToFloat(FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+
+  std::mt19937 random(1);
+  std::uniform_real_distribution<float> exponent(-14.0f, 15.9f);
+  for (Uint x = 0; x < 10000; x++) {
+    const float value = std::exp2(exponent(random)) * (x % 2 == 0 ? 1.0f : -1.0f);
+    /* Normal halves have 11 bits of precision, rounding to nearest is off by half of the last one at most */
+    YEAGER_EXPECT(std::abs(HalfToFloat(FloatToHalf(value)) - value) <= std::abs(value) * std::ldexp(1.0f, -11));
+  }
+}
+
+YEAGER_TEST(Quantization, NormalizedIntegersStayWithinHalfAStep)
+{
+  for (int x = -1000; x <= 1000; x++) {
+    const float value = x / 1000.0f;
+    YEAGER_EXPECT(std::abs(DequantizeSnorm16(QuantizeSnorm16(value)) - value) <= 0.5f / 32767.0f + 1e-7f);
+    const float positive = (x + 1000) / 2000.0f;
+    YEAGER_EXPECT(std::abs(DequantizeUnorm8(QuantizeUnorm8(positive)) - positive) <= 0.5f / 255.0f + 1e-7f);
+    YEAGER_EXPECT(std::abs(DequantizeUnorm16(QuantizeUnorm16(positive)) - positive) <= 0.5f / 65535.0f + 1e-7f);
+  }
+
+  YEAGER_EXPECT_EQ(QuantizeSnorm16(2.0f), int16_t(32767));
+  YEAGER_EXPECT_EQ(QuantizeSnorm16(-2.0f), int16_t(-32767));
+  YEAGER_EXPECT_EQ(DequantizeSnorm16(-32768), -1.0f);
+  YEAGER_EXPECT_EQ(QuantizeUnorm8(-1.0f), uint8_t(0));
+  YEAGER_EXPECT_EQ(QuantizeUnorm8(3.0f), uint8_t(255));
+  YEAGER_EXPECT_EQ(QuantizeUnorm16(3.0f), uint16_t(65535));
+}
+
+YEAGER_TEST(Quantization, OctahedralRoundTripsDirections)
+{
+  float worstFloat = 0.0f;
+  float worstSnorm = 0.0f;
+  for (const Vector3& direction : MakeTestDirections(20000, 2)) {
+    const Vector2 encoded = OctahedralEncode(direction);
+    YEAGER_EXPECT(std::abs(encoded.x) <= 1.0f && std::abs(encoded.y) <= 1.0f);
+    worstFloat = std::max(worstFloat, AngleInDegrees(OctahedralDecode(encoded), direction));
+
+    int16_t snorm[2];
+    OctahedralEncodeSnorm16(direction, snorm);
+    worstSnorm = std::max(worstSnorm, AngleInDegrees(OctahedralDecodeSnorm16(snorm), direction));
+  }
+  YEAGER_EXPECT(worstFloat < 0.001f);
+  YEAGER_EXPECT(worstSnorm < 0.01f);
+}
+
+YEAGER_TEST(Quantization, OctahedralSnormPicksTheClosestNeighbour)
+{
+  for (const Vector3& direction : MakeTestDirections(2000, 3)) {
+    int16_t best[2];
+    OctahedralEncodeSnorm16(direction, best);
+    const float bestDot = glm::dot(OctahedralDecodeSnorm16(best), direction);
+
+    /* Plain rounding of each axis is one of the candidates, it is never closer than the one kept */
+    const Vector2 encoded = OctahedralEncode(direction);
+    const int16_t rounded[2] = {QuantizeSnorm16(encoded.x), QuantizeSnorm16(encoded.y)};
+    YEAGER_EXPECT(bestDot >= glm::dot(OctahedralDecodeSnorm16(rounded), direction) - 1e-7f);
+  }
+
+  int16_t zero[2] = {1, 1};
+  OctahedralEncodeSnorm16(Vector3(0.0f), zero);
+  YEAGER_EXPECT_EQ(zero[0], int16_t(0));
+  YEAGER_EXPECT_EQ(zero[1], int16_t(0));
+}
+
+YEAGER_TEST(Quantization, WeightsSumTo255AndKeepUnusedInfluences)
+{
+  std::mt19937 random(4);
+  std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+  for (Uint x = 0; x < 1000; x++) {
+    float weights[4] = {weight(random), weight(random), x % 3 == 0 ? 0.0f : weight(random), 0.0f};
+    uint8_t quantized[4];
+    QuantizeWeightsUnorm8(weights, 4, quantized);
+    YEAGER_EXPECT_EQ(quantized[0] + quantized[1] + quantized[2] + quantized[3], 255);
+    YEAGER_EXPECT_EQ(quantized[3], uint8_t(0));
+    if (weights[2] == 0.0f)
+      YEAGER_EXPECT_EQ(quantized[2], uint8_t(0));
+
+    const float sum = weights[0] + weights[1] + weights[2];
+    for (Uint y = 0; y < 3; y++) {
+      /* The largest weight also takes the rounding error of the others, up to a step each */
+      YEAGER_EXPECT(std::abs(DequantizeUnorm8(quantized[y]) - weights[y] / sum) <= 2.0f / 255.0f);
+    }
+  }
+
+  const float none[4] = {0.0f, -1.0f, 0.0f, 0.0f};
+  uint8_t quantized[4] = {1, 1, 1, 1};
+  QuantizeWeightsUnorm8(none, 4, quantized);
+  YEAGER_EXPECT(quantized[0] == 0 && quantized[1] == 0 && quantized[2] == 0 && quantized[3] == 0);
+}
+
+YEAGER_TEST(Quantization, PositionsStayWithinTheMaxError)
+{
+  const AABB bounds(Vector3(-12.0f, 3.0f, 100.0f), Vector3(40.0f, 3.5f, 2000.0f));
+  const PositionQuantization quantization = PositionQuantization::FromBounds(bounds);
+  const Vector3 maxError = quantization.GetMaxError();
+
+  std::mt19937 random(5);
+  std::uniform_real_distribution<float> t(0.0f, 1.0f);
+  for (Uint x = 0; x < 10000; x++) {
+    const Vector3 position = bounds.Min + (bounds.Max - bounds.Min) * Vector3(t(random), t(random), t(random));
+    int16_t encoded[4];
+    quantization.Encode(position, encoded);
+    YEAGER_EXPECT_EQ(encoded[3], int16_t(0));
+    const Vector3 decoded = quantization.Decode(encoded);
+    for (int axis = 0; axis < 3; axis++) {
+      /* Plus the float rounding of the decode at the magnitude of the coordinates */
+      YEAGER_EXPECT(std::abs(decoded[axis] - position[axis]) <= maxError[axis] + std::abs(position[axis]) * 1e-6f);
+    }
+  }
+
+  int16_t corner[4];
+  quantization.Encode(bounds.Max, corner);
+  YEAGER_EXPECT(corner[0] == 32767 && corner[1] == 32767 && corner[2] == 32767);
+}
+
+YEAGER_TEST(Quantization, FlatAxesKeepAScaleOfOne)
+{
+  const AABB flat(Vector3(-1.0f, 5.0f, -1.0f), Vector3(1.0f, 5.0f, 1.0f));
+  const PositionQuantization quantization = PositionQuantization::FromBounds(flat);
+  YEAGER_EXPECT_EQ(quantization.Scale.y, 1.0f);
+
+  int16_t encoded[4];
+  quantization.Encode(Vector3(0.5f, 5.0f, -0.25f), encoded);
+  const Vector3 decoded = quantization.Decode(encoded);
+  YEAGER_EXPECT_NEAR(decoded.y, 5.0f, 1e-6f);
+  YEAGER_EXPECT_NEAR(decoded.x, 0.5f, quantization.GetMaxError().x + 1e-6f);
+}
+
+/* Angle of the rotation from one unit quaternion to the other, from their chord so the small angles are kept */
+static float RotationAngleInDegrees(const glm::quat& first, const glm::quat& second)
+{
+  const glm::quat closest = glm::dot(first, second) < 0.0f ? -second : second;
+  const float chord = glm::length(first - closest);
+  return 4.0f * std::asin(std::min(chord * 0.5f, 1.0f)) * 180.0f / sPi;
+}
+
+YEAGER_TEST(Quantization, Quat48RoundTripsRotations)
+{
+  std::mt19937 random(6);
+  std::normal_distribution<float> component(0.0f, 1.0f);
+  std::vector<glm::quat> rotations = {glm::quat(1, 0, 0, 0), glm::quat(0, 1, 0, 0), glm::quat(0, 0, 0, -1),
+                                      glm::normalize(glm::quat(1, 1, 0, 0)), glm::normalize(glm::quat(1, 1, 1, 1))};
+  while (rotations.size() < 20000) {
+    const glm::quat rotation(component(random), component(random), component(random), component(random));
+    if (glm::length(rotation) > 1e-3f)
+      rotations.push_back(glm::normalize(rotation));
+  }
+
+  float worst = 0.0f;
+  for (const glm::quat& rotation : rotations) {
+    const glm::quat unpacked = UnpackQuat48(PackQuat48(rotation));
+    YEAGER_EXPECT_NEAR(glm::length(unpacked), 1.0f, 1e-5f);
+    worst = std::max(worst, RotationAngleInDegrees(rotation, unpacked));
+  }
+  YEAGER_EXPECT(worst < 0.01f);
+}
+
+YEAGER_TEST(Quantization, Quat48PacksBothSignsAlike)
+{
+  std::mt19937 random(7);
+  std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+  for (Uint x = 0; x < 1000; x++) {
+    const glm::quat rotation =
+        glm::normalize(glm::quat(component(random), component(random), component(random), component(random)));
+    const PackedQuat48 positive = PackQuat48(rotation);
+    const PackedQuat48 negative = PackQuat48(-rotation);
+    YEAGER_EXPECT(std::memcmp(positive.Data, negative.Data, sizeof(positive.Data)) == 0);
+  }
+
+  /* Not unit quaternions are normalized first, a zero one is taken as the identity */
+  YEAGER_EXPECT(RotationAngleInDegrees(UnpackQuat48(PackQuat48(glm::quat(3, 0, 4, 0))), glm::quat(0.6f, 0, 0.8f, 0)) <
+                0.01f);
+  YEAGER_EXPECT(RotationAngleInDegrees(UnpackQuat48(PackQuat48(glm::quat(0, 0, 0, 0))), glm::quat(1, 0, 0, 0)) < 0.01f);
+}
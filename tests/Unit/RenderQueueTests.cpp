@@ -0,0 +1,101 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Renderer/RenderQueue/RenderQueue.h"
+
+#include <random>
+using namespace Yeager;
+
+static std::vector<RenderPacket> MakeRandomPackets(std::size_t count, uint64_t seed, uint64_t keyMask)
+{
+  std::mt19937_64 random(seed);
+  std::vector<RenderPacket> packets(count);
+  for (std::size_t x = 0; x < count; x++) {
+    packets[x].Key = random() & keyMask;
+    /* The position in the input, to check the order of equal keys */
+    packets[x].Culling = (x % 2) == 0;
+    packets[x].PolygonMode = static_cast<GLenum>(x);
+  }
+  return packets;
+}
+
+static void ExpectSortedLikeStableSort(std::vector<RenderPacket> packets)
+{
+  std::vector<RenderPacket> expected = packets;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const RenderPacket& first, const RenderPacket& second) { return first.Key < second.Key; });
+
+  RenderSortScratch scratch;
+  RadixSortRenderPackets(&packets, &scratch);
+  YEAGER_EXPECT_EQ(packets.size(), expected.size());
+  for (std::size_t x = 0; x < packets.size(); x++) {
+    YEAGER_EXPECT_EQ(packets[x].Key, expected[x].Key);
+    YEAGER_EXPECT_EQ(packets[x].PolygonMode, expected[x].PolygonMode);
+  }
+}
+
+YEAGER_TEST(RenderQueue, OpaqueKeysOrderByPassShaderMaterialMeshThenDepth)
+{
+  const uint64_t base = BuildRenderKey(RenderQueuePass::eOPAQUE, 2, 5, 7, 0.5f);
+  YEAGER_EXPECT(base < BuildRenderKey(RenderQueuePass::eTRANSPARENT, 0, 0, 0, 0.0f));
+  YEAGER_EXPECT(base < BuildRenderKey(RenderQueuePass::eOPAQUE, 3, 0, 0, 0.0f));
+  YEAGER_EXPECT(base < BuildRenderKey(RenderQueuePass::eOPAQUE, 2, 6, 0, 0.0f));
+  YEAGER_EXPECT(base < BuildRenderKey(RenderQueuePass::eOPAQUE, 2, 5, 8, 0.0f));
+  /* Front to back inside the same state */
+  YEAGER_EXPECT(BuildRenderKey(RenderQueuePass::eOPAQUE, 2, 5, 7, 0.1f) < base);
+  YEAGER_EXPECT(base < BuildRenderKey(RenderQueuePass::eOPAQUE, 2, 5, 7, 0.9f));
+}
+
+YEAGER_TEST(RenderQueue, TransparentKeysOrderBackToFrontAcrossShaders)
+{
+  const uint64_t far = BuildRenderKey(RenderQueuePass::eTRANSPARENT, 9, 9, 9, 0.9f);
+  const uint64_t near = BuildRenderKey(RenderQueuePass::eTRANSPARENT, 1, 1, 1, 0.1f);
+  YEAGER_EXPECT(far < near);
+  /* Only the draws at the same depth are grouped by their states */
+  YEAGER_EXPECT(BuildRenderKey(RenderQueuePass::eTRANSPARENT, 1, 0, 0, 0.5f) <
+                BuildRenderKey(RenderQueuePass::eTRANSPARENT, 2, 0, 0, 0.5f));
+  YEAGER_EXPECT(BuildRenderKey(RenderQueuePass::eOPAQUE, 4095, 65535, 4095, 1.0f) <
+                BuildRenderKey(RenderQueuePass::eTRANSPARENT, 0, 0, 0, 1.0f));
+}
+
+YEAGER_TEST(RenderQueue, KeyFieldsAreMaskedAndDepthClamped)
+{
+  YEAGER_EXPECT_EQ(BuildRenderKey(RenderQueuePass::eOPAQUE, 1u << YEAGER_RENDER_KEY_SHADER_BITS, 0, 0, 0.0f),
+                   BuildRenderKey(RenderQueuePass::eOPAQUE, 0, 0, 0, 0.0f));
+  YEAGER_EXPECT_EQ(BuildRenderKey(RenderQueuePass::eOPAQUE, 0, 0, 0, -4.0f),
+                   BuildRenderKey(RenderQueuePass::eOPAQUE, 0, 0, 0, 0.0f));
+  YEAGER_EXPECT_EQ(BuildRenderKey(RenderQueuePass::eTRANSPARENT, 0, 0, 0, 4.0f),
+                   BuildRenderKey(RenderQueuePass::eTRANSPARENT, 0, 0, 0, 1.0f));
+}
+
+YEAGER_TEST(RenderQueue, RadixSortMatchesStableSort)
+{
+  ExpectSortedLikeStableSort({});
+  ExpectSortedLikeStableSort(MakeRandomPackets(1, 1, ~0ull));
+  ExpectSortedLikeStableSort(MakeRandomPackets(5000, 2, ~0ull));
+  /* Few distinct keys, so most packets are equal and the order between them is checked */
+  ExpectSortedLikeStableSort(MakeRandomPackets(5000, 3, 0x0F000000000000F0ull));
+  /* Every key equal, every pass is skipped */
+  ExpectSortedLikeStableSort(MakeRandomPackets(100, 4, 0));
+}
+
+YEAGER_TEST(RenderQueue, RadixSortOfBuiltKeysDrawsOpaqueThenTransparent)
+{
+  std::vector<RenderPacket> packets;
+  std::mt19937 random(5);
+  std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+  for (Uint x = 0; x < 1000; x++) {
+    RenderPacket packet;
+    packet.Key = BuildRenderKey(x % 3 == 0 ? RenderQueuePass::eTRANSPARENT : RenderQueuePass::eOPAQUE, random() % 8,
+                                random() % 64, random() % 32, depth(random));
+    packets.push_back(packet);
+  }
+
+  RenderSortScratch scratch;
+  RadixSortRenderPackets(&packets, &scratch);
+  const uint64_t transparentPass = uint64_t(RenderQueuePass::eTRANSPARENT) << (64 - YEAGER_RENDER_KEY_PASS_BITS);
+  for (std::size_t x = 1; x < packets.size(); x++) {
+    YEAGER_EXPECT(packets[x - 1].Key <= packets[x].Key);
+    const bool previousTransparent = packets[x - 1].Key >= transparentPass;
+    const bool currentTransparent = packets[x].Key >= transparentPass;
+    YEAGER_EXPECT(!previousTransparent || currentTransparent);
+  }
+}
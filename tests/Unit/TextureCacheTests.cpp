@@ -0,0 +1,256 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Kernel/Caching/TextureCache.h"
+
+#include <set>
+using namespace Yeager;
+
+static YEAGER_CONSTEXPR Uint sTestWidth = 37;
+static YEAGER_CONSTEXPR Uint sTestHeight = 20;
+
+/* The cache never decodes the source, it only reads its size, time and contents, any bytes stand in for the image */
+static String WriteTestSource(const std::filesystem::path& folder, unsigned char seed = 0)
+{
+  std::vector<unsigned char> source(1000);
+  for (std::size_t x = 0; x < source.size(); x++) {
+    source[x] = static_cast<unsigned char>(x * 13 + seed);
+  }
+  const std::filesystem::path path = folder / "albedo.png";
+  Test::WriteTestFile(path, source);
+  return path.string();
+}
+
+/* Gradient with a transparent corner, so the compressed chain is BC3 */
+static std::vector<unsigned char> MakeTestPixels()
+{
+  std::vector<unsigned char> pixels(std::size_t(sTestWidth) * sTestHeight * 4);
+  for (Uint y = 0; y < sTestHeight; y++) {
+    for (Uint x = 0; x < sTestWidth; x++) {
+      unsigned char* pixel = &pixels[(std::size_t(y) * sTestWidth + x) * 4];
+      pixel[0] = static_cast<unsigned char>(x * 6);
+      pixel[1] = static_cast<unsigned char>(y * 12);
+      pixel[2] = static_cast<unsigned char>((x + y) * 4);
+      pixel[3] = x < 4 && y < 4 ? 0 : 255;
+    }
+  }
+  return pixels;
+}
+
+/* Builds and writes the cache of a new source in its own folder, the cache path is returned through cachePath */
+static bool WriteTestCache(const String& name, const TextureCacheSettings& settings, String* sourcePath,
+                           String* cachePath)
+{
+  const std::filesystem::path folder = Test::MakeTestFolder(name);
+  *sourcePath = WriteTestSource(folder);
+  *cachePath = TextureCache::BuildCachePath(folder.string(), *sourcePath, settings);
+  const std::vector<unsigned char> pixels = MakeTestPixels();
+  const std::optional<TextureCacheData> data =
+      TextureCache::Build(*sourcePath, pixels.data(), sTestWidth, sTestHeight, 4, settings);
+  return data.has_value() && TextureCache::Write(*cachePath, data.value());
+}
+
+/* Writes the test cache, changes the file with the given function and tells if it still loads */
+template <typename PatchFun>
+static bool LoadsAfterPatch(const String& name, PatchFun&& patch)
+{
+  const TextureCacheSettings settings;
+  String sourcePath, cachePath;
+  if (!WriteTestCache(name, settings, &sourcePath, &cachePath))
+    return true;
+
+  std::vector<unsigned char> data = Test::ReadTestFile(cachePath);
+  patch(data);
+  Test::WriteTestFile(cachePath, data);
+
+  TextureCacheData loaded;
+  return TextureCache::Load(cachePath, sourcePath, settings, &loaded);
+}
+
+static uint64_t LevelEntryOffset(uint32_t level)
+{
+  return sizeof(TextureCacheHeader) + level * sizeof(TextureCacheLevel);
+}
+
+YEAGER_TEST(TextureCache, RoundTripKeepsEveryLevel)
+{
+  for (const bool compress : {true, false}) {
+    TextureCacheSettings settings;
+    settings.bCompress = compress;
+    const std::filesystem::path folder = Test::MakeTestFolder(compress ? "TextureCacheBC3" : "TextureCacheRGBA8");
+    const String sourcePath = WriteTestSource(folder);
+    const String cachePath = TextureCache::BuildCachePath(folder.string(), sourcePath, settings);
+    const std::vector<unsigned char> pixels = MakeTestPixels();
+    const std::optional<TextureCacheData> built =
+        TextureCache::Build(sourcePath, pixels.data(), sTestWidth, sTestHeight, 4, settings);
+    YEAGER_EXPECT(built.has_value());
+    if (!built.has_value())
+      return;
+    YEAGER_EXPECT(TextureCache::Write(cachePath, built.value()));
+
+    TextureCacheData loaded;
+    YEAGER_EXPECT(TextureCache::Load(cachePath, sourcePath, settings, &loaded));
+    const TextureCacheHeader& header = loaded.Header;
+    YEAGER_EXPECT_EQ(header.Width, sTestWidth);
+    YEAGER_EXPECT_EQ(header.Height, sTestHeight);
+    YEAGER_EXPECT_EQ(header.Format, uint32_t(GL_RGBA));
+    YEAGER_EXPECT_EQ(header.Payload, uint32_t(compress ? TexturePayloadFormat::eBC3 : TexturePayloadFormat::eRGBA8));
+    YEAGER_EXPECT_EQ(header.Flags, TextureCache::GetCacheFlags(settings));
+    YEAGER_EXPECT_EQ(header.FileSize, uint64_t(std::filesystem::file_size(cachePath)));
+    YEAGER_EXPECT_EQ(loaded.Path, sourcePath);
+
+    /* 37x20 down to 1x1 is six levels */
+    YEAGER_EXPECT_EQ(header.LevelCount, 6u);
+    YEAGER_EXPECT_EQ(loaded.Levels.size(), built->Levels.size());
+    if (loaded.Levels.size() != built->Levels.size())
+      return;
+    const std::vector<unsigned char> file = Test::ReadTestFile(cachePath);
+    for (uint32_t x = 0; x < header.LevelCount; x++) {
+      YEAGER_EXPECT_EQ(loaded.Levels[x].Width, built->Levels[x].Width);
+      YEAGER_EXPECT_EQ(loaded.Levels[x].Height, built->Levels[x].Height);
+      YEAGER_EXPECT(loaded.Levels[x].Data == built->Levels[x].Data);
+      TextureCacheLevel level;
+      std::memcpy(&level, file.data() + LevelEntryOffset(x), sizeof(TextureCacheLevel));
+      YEAGER_EXPECT_EQ(level.Offset % YEAGER_TEXTURE_CACHE_ALIGNMENT, 0u);
+    }
+  }
+}
+
+YEAGER_TEST(TextureCache, RejectsMissingFile)
+{
+  const std::filesystem::path folder = Test::MakeTestFolder("TextureCacheMissing");
+  const String sourcePath = WriteTestSource(folder);
+  TextureCacheData loaded;
+  const String cachePath = (folder / "missing.ytex_ch").string();
+  YEAGER_EXPECT(!TextureCache::Load(cachePath, sourcePath, TextureCacheSettings(), &loaded));
+}
+
+YEAGER_TEST(TextureCache, RejectsTruncatedOrCorruptedFiles)
+{
+  YEAGER_EXPECT(LoadsAfterPatch("TextureCacheUntouched", [](std::vector<unsigned char>&) {}));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheMagic", [](std::vector<unsigned char>& data) { data[0] = 'X'; }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheVersion", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(TextureCacheHeader, Version), uint32_t(YEAGER_TEXTURE_CACHE_VERSION + 1));
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheTruncated", [](std::vector<unsigned char>& data) {
+    data.resize(data.size() - YEAGER_TEXTURE_CACHE_ALIGNMENT);
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheHeaderOnly", [](std::vector<unsigned char>& data) {
+    data.resize(sizeof(TextureCacheHeader) / 2);
+  }));
+  /* Truncated, with a header that agrees with the new size, the last level falls outside of the file */
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheTruncatedHeader", [](std::vector<unsigned char>& data) {
+    data.resize(data.size() - YEAGER_TEXTURE_CACHE_ALIGNMENT);
+    Test::PatchValue(data, offsetof(TextureCacheHeader, FileSize), uint64_t(data.size()));
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCachePayload", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(TextureCacheHeader, Payload), uint32_t(TexturePayloadFormat::eBC3 + 1));
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheWidth", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(TextureCacheHeader, Width), uint32_t(0));
+  }));
+}
+
+YEAGER_TEST(TextureCache, RejectsCorruptedLevelTables)
+{
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheLevelCount", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(TextureCacheHeader, LevelCount), uint32_t(1u << 30));
+  }));
+  /* A level count the table still fits in, the entries after the real ones are the first texels */
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheExtraLevel", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(TextureCacheHeader, LevelCount), uint32_t(7));
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheMissingLevel", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, offsetof(TextureCacheHeader, LevelCount), uint32_t(5));
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheLevelWidth", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, LevelEntryOffset(2) + offsetof(TextureCacheLevel, Width), uint32_t(10));
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheLevelSize", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, LevelEntryOffset(1) + offsetof(TextureCacheLevel, Size), uint64_t(16));
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheLevelPastTheEnd", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, LevelEntryOffset(5) + offsetof(TextureCacheLevel, Offset), uint64_t(data.size() - 8));
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheLevelInTable", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, LevelEntryOffset(0) + offsetof(TextureCacheLevel, Offset), uint64_t(0));
+  }));
+  YEAGER_EXPECT(!LoadsAfterPatch("TextureCacheHugeOffset", [](std::vector<unsigned char>& data) {
+    Test::PatchValue(data, LevelEntryOffset(3) + offsetof(TextureCacheLevel, Offset), uint64_t(~0ull - 4));
+  }));
+}
+
+YEAGER_TEST(TextureCache, ChangedSourceInvalidatesTheCache)
+{
+  const TextureCacheSettings settings;
+  TextureCacheData loaded;
+
+  /* Another size is enough, the contents are not hashed */
+  String sourcePath, cachePath;
+  YEAGER_EXPECT(WriteTestCache("TextureCacheSourceSize", settings, &sourcePath, &cachePath));
+  std::vector<unsigned char> source = Test::ReadTestFile(sourcePath);
+  source.push_back(0);
+  Test::WriteTestFile(sourcePath, source);
+  YEAGER_EXPECT(!TextureCache::Load(cachePath, sourcePath, settings, &loaded));
+
+  /* Same size and other contents, written later, so the time differs and the hash tells them apart */
+  YEAGER_EXPECT(WriteTestCache("TextureCacheSourceContents", settings, &sourcePath, &cachePath));
+  const auto written = std::filesystem::last_write_time(sourcePath);
+  WriteTestSource(std::filesystem::path(sourcePath).parent_path(), 1);
+  std::filesystem::last_write_time(sourcePath, written + std::chrono::hours(1));
+  YEAGER_EXPECT_EQ(Test::ReadTestFile(sourcePath).size(), source.size() - 1);
+  YEAGER_EXPECT(!TextureCache::Load(cachePath, sourcePath, settings, &loaded));
+
+  YEAGER_EXPECT(WriteTestCache("TextureCacheSourceGone", settings, &sourcePath, &cachePath));
+  std::filesystem::remove(sourcePath);
+  YEAGER_EXPECT(!TextureCache::Load(cachePath, sourcePath, settings, &loaded));
+}
+
+YEAGER_TEST(TextureCache, TouchedSourceKeepsTheCache)
+{
+  const TextureCacheSettings settings;
+  String sourcePath, cachePath;
+  YEAGER_EXPECT(WriteTestCache("TextureCacheTouched", settings, &sourcePath, &cachePath));
+
+  /* Checked out again or copied, the time changed but the contents did not */
+  const auto written = std::filesystem::last_write_time(sourcePath);
+  Test::WriteTestFile(sourcePath, Test::ReadTestFile(sourcePath));
+  std::filesystem::last_write_time(sourcePath, written + std::chrono::hours(2));
+
+  TextureCacheData loaded;
+  YEAGER_EXPECT(TextureCache::Load(cachePath, sourcePath, settings, &loaded));
+  YEAGER_EXPECT_EQ(loaded.Header.LevelCount, 6u);
+}
+
+YEAGER_TEST(TextureCache, OtherSettingsUseAnotherFile)
+{
+  std::vector<TextureCacheSettings> combinations;
+  for (Uint x = 0; x < 8; x++) {
+    TextureCacheSettings settings;
+    settings.bSRGB = (x & 1) != 0;
+    settings.bCompress = (x & 2) != 0;
+    settings.bFlipped = (x & 4) != 0;
+    combinations.push_back(settings);
+  }
+
+  /* Every combination has its own name and flags */
+  std::set<String> paths;
+  std::set<uint32_t> flags;
+  for (const TextureCacheSettings& settings : combinations) {
+    paths.insert(TextureCache::BuildCachePath("Cache", "Textures/albedo.png", settings));
+    flags.insert(TextureCache::GetCacheFlags(settings));
+  }
+  YEAGER_EXPECT_EQ(paths.size(), combinations.size());
+  YEAGER_EXPECT_EQ(flags.size(), combinations.size());
+
+  /* A file read through another path, as one written by an older version under the name of the path only */
+  TextureCacheSettings settings;
+  String sourcePath, cachePath;
+  YEAGER_EXPECT(WriteTestCache("TextureCacheSettings", settings, &sourcePath, &cachePath));
+  TextureCacheData loaded;
+  bool mismatchRejected = true;
+  for (const TextureCacheSettings& other : combinations) {
+    const bool same = other.bSRGB == settings.bSRGB && other.bCompress == settings.bCompress &&
+                      other.bFlipped == settings.bFlipped;
+    mismatchRejected &= TextureCache::Load(cachePath, sourcePath, other, &loaded) == same;
+  }
+  YEAGER_EXPECT(mismatchRejected);
+}
@@ -0,0 +1,218 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Renderer/Texture/TextureCompression.h"
+
+#include <random>
+using namespace Yeager;
+
+/* Smooth color gradients with a wave, the kind of content the block compression is meant for */
+static TextureMipLevel MakeTestImage(Uint width, Uint height, bool alpha)
+{
+  TextureMipLevel level;
+  level.Width = width;
+  level.Height = height;
+  level.Data.resize(std::size_t(width) * height * 4);
+  for (Uint y = 0; y < height; y++) {
+    for (Uint x = 0; x < width; x++) {
+      unsigned char* texel = level.Data.data() + (std::size_t(y) * width + x) * 4;
+      texel[0] = static_cast<unsigned char>(x * 255 / std::max(width - 1, 1u));
+      texel[1] = static_cast<unsigned char>(y * 255 / std::max(height - 1, 1u));
+      texel[2] = static_cast<unsigned char>(128.0f + 100.0f * std::sin(float(x + y) * 0.05f));
+      texel[3] = alpha ? static_cast<unsigned char>(255 - (x + y) * 255 / (width + height)) : 255;
+    }
+  }
+  return level;
+}
+
+/* Peak signal to noise ratio of the channels in [first, last] */
+static double ComputePSNR(const TextureMipLevel& first, const TextureMipLevel& second, Uint firstChannel,
+                          Uint lastChannel)
+{
+  double error = 0.0;
+  std::size_t count = 0;
+  for (std::size_t x = 0; x < first.Data.size(); x++) {
+    const Uint channel = x % 4;
+    if (channel < firstChannel || channel > lastChannel)
+      continue;
+    const double difference = double(first.Data[x]) - double(second.Data[x]);
+    error += difference * difference;
+    count++;
+  }
+  const double mse = error / std::max<std::size_t>(count, 1);
+  return mse <= 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+static void FillBlock(unsigned char rgba[64], unsigned char r, unsigned char g, unsigned char b, unsigned char a)
+{
+  for (Uint x = 0; x < 16; x++) {
+    rgba[x * 4 + 0] = r;
+    rgba[x * 4 + 1] = g;
+    rgba[x * 4 + 2] = b;
+    rgba[x * 4 + 3] = a;
+  }
+}
+
+YEAGER_TEST(TextureCompression, LevelSizesRoundUpToWholeBlocks)
+{
+  YEAGER_EXPECT_EQ(GetTextureLevelSize(5, 3, TexturePayloadFormat::eRGBA8), std::size_t(60));
+  YEAGER_EXPECT_EQ(GetTextureLevelSize(5, 3, TexturePayloadFormat::eBC1), std::size_t(16));
+  YEAGER_EXPECT_EQ(GetTextureLevelSize(5, 3, TexturePayloadFormat::eBC3), std::size_t(32));
+  YEAGER_EXPECT_EQ(GetTextureLevelSize(1, 1, TexturePayloadFormat::eBC1), std::size_t(8));
+  YEAGER_EXPECT_EQ(GetTextureLevelSize(256, 256, TexturePayloadFormat::eBC3), std::size_t(65536));
+}
+
+YEAGER_TEST(TextureCompression, ExpandsEveryChannelCount)
+{
+  const unsigned char grey[] = {10, 20};
+  YEAGER_EXPECT(ExpandToRGBA8(grey, 2, 1, 1) == std::vector<unsigned char>({10, 10, 10, 255, 20, 20, 20, 255}));
+  const unsigned char greyAlpha[] = {10, 99};
+  YEAGER_EXPECT(ExpandToRGBA8(greyAlpha, 1, 1, 2) == std::vector<unsigned char>({10, 10, 10, 99}));
+  const unsigned char rgb[] = {1, 2, 3};
+  YEAGER_EXPECT(ExpandToRGBA8(rgb, 1, 1, 3) == std::vector<unsigned char>({1, 2, 3, 255}));
+  const unsigned char rgba[] = {1, 2, 3, 4};
+  YEAGER_EXPECT(ExpandToRGBA8(rgba, 1, 1, 4) == std::vector<unsigned char>({1, 2, 3, 4}));
+}
+
+YEAGER_TEST(TextureCompression, SolidBlocksOfExactColorsDecodeExactly)
+{
+  /* Colors that the 565 endpoints store without loss */
+  const unsigned char colors[][3] = {{0, 0, 0},   {255, 255, 255}, {255, 0, 0},
+                                     {0, 255, 0}, {0, 0, 255},     {132, 130, 132}};
+  for (const auto& color : colors) {
+    unsigned char rgba[64];
+    unsigned char block[16];
+    unsigned char decoded[64];
+    FillBlock(rgba, color[0], color[1], color[2], 255);
+
+    EncodeBC1Block(rgba, block);
+    DecodeBC1Block(block, decoded);
+    YEAGER_EXPECT(std::memcmp(rgba, decoded, sizeof(rgba)) == 0);
+
+    FillBlock(rgba, color[0], color[1], color[2], 77);
+    EncodeBC3Block(rgba, block);
+    DecodeBC3Block(block, decoded);
+    YEAGER_EXPECT(std::memcmp(rgba, decoded, sizeof(rgba)) == 0);
+  }
+}
+
+YEAGER_TEST(TextureCompression, BC1UsesTheFourColorsMode)
+{
+  std::mt19937 random(1);
+  std::uniform_int_distribution<int> channel(0, 255);
+  for (Uint x = 0; x < 500; x++) {
+    unsigned char rgba[64];
+    for (Uint y = 0; y < 64; y++) {
+      rgba[y] = y % 4 == 3 ? 255 : static_cast<unsigned char>(channel(random));
+    }
+    unsigned char block[8];
+    EncodeBC1Block(rgba, block);
+    const uint16_t color0 = uint16_t(block[0] | (block[1] << 8));
+    const uint16_t color1 = uint16_t(block[2] | (block[3] << 8));
+    /* Single color blocks may store equal endpoints, with every index on the first one */
+    const uint32_t indices = uint32_t(block[4]) | (uint32_t(block[5]) << 8) | (uint32_t(block[6]) << 16) |
+                             (uint32_t(block[7]) << 24);
+    YEAGER_EXPECT(color0 > color1 || (color0 == color1 && indices == 0));
+
+    /* And so the alpha decodes opaque */
+    unsigned char decoded[64];
+    DecodeBC1Block(block, decoded);
+    for (Uint y = 0; y < 16; y++) {
+      YEAGER_EXPECT_EQ(decoded[y * 4 + 3], 255);
+    }
+  }
+}
+
+YEAGER_TEST(TextureCompression, GradientBlocksStayCloseToTheSource)
+{
+  unsigned char rgba[64];
+  for (Uint x = 0; x < 16; x++) {
+    rgba[x * 4 + 0] = static_cast<unsigned char>(40 + x * 10);
+    rgba[x * 4 + 1] = static_cast<unsigned char>(200 - x * 8);
+    rgba[x * 4 + 2] = static_cast<unsigned char>(90 + x * 3);
+    rgba[x * 4 + 3] = static_cast<unsigned char>(x * 17);
+  }
+
+  unsigned char block[16];
+  unsigned char decoded[64];
+  EncodeBC3Block(rgba, block);
+  DecodeBC3Block(block, decoded);
+  int worstColor = 0;
+  int worstAlpha = 0;
+  for (Uint x = 0; x < 64; x++) {
+    const int error = std::abs(int(rgba[x]) - int(decoded[x]));
+    if (x % 4 == 3)
+      worstAlpha = std::max(worstAlpha, error);
+    else
+      worstColor = std::max(worstColor, error);
+  }
+  /* The palette splits the 150 wide red range in thirds, a texel is half of a third away at most plus the rounding */
+  YEAGER_EXPECT(worstColor <= 28);
+  /* Eight alpha values over 0-255 are 36 apart, the closest one is half of that away at most */
+  YEAGER_EXPECT(worstAlpha <= 19);
+}
+
+YEAGER_TEST(TextureCompression, LevelsRoundTripWithinTheExpectedQuality)
+{
+  /* Sizes that are not multiples of the block size, the border blocks repeat the edge texels */
+  const TextureMipLevel opaque = MakeTestImage(67, 35, false);
+  const TextureMipLevel bc1 = CompressTextureLevel(opaque, TexturePayloadFormat::eBC1);
+  YEAGER_EXPECT_EQ(bc1.Data.size(), GetTextureLevelSize(67, 35, TexturePayloadFormat::eBC1));
+  const TextureMipLevel bc1Decoded = DecompressTextureLevel(bc1, TexturePayloadFormat::eBC1);
+  YEAGER_EXPECT_EQ(bc1Decoded.Width, 67u);
+  YEAGER_EXPECT_EQ(bc1Decoded.Height, 35u);
+  YEAGER_EXPECT(ComputePSNR(opaque, bc1Decoded, 0, 2) > 35.0);
+  YEAGER_EXPECT(IsImageOpaque(bc1Decoded));
+
+  const TextureMipLevel translucent = MakeTestImage(67, 35, true);
+  const TextureMipLevel bc3 = CompressTextureLevel(translucent, TexturePayloadFormat::eBC3);
+  YEAGER_EXPECT_EQ(bc3.Data.size(), GetTextureLevelSize(67, 35, TexturePayloadFormat::eBC3));
+  const TextureMipLevel bc3Decoded = DecompressTextureLevel(bc3, TexturePayloadFormat::eBC3);
+  YEAGER_EXPECT(ComputePSNR(translucent, bc3Decoded, 0, 2) > 35.0);
+  YEAGER_EXPECT(ComputePSNR(translucent, bc3Decoded, 3, 3) > 40.0);
+  YEAGER_EXPECT(!IsImageOpaque(bc3Decoded));
+
+  const TextureMipLevel rgba = CompressTextureLevel(translucent, TexturePayloadFormat::eRGBA8);
+  YEAGER_EXPECT(rgba.Data == translucent.Data);
+}
+
+YEAGER_TEST(TextureCompression, MipChainGoesDownToOneTexel)
+{
+  const TextureMipLevel image = MakeTestImage(37, 10, true);
+  const std::vector<TextureMipLevel> levels = GenerateMipChain(image.Data, image.Width, image.Height, false);
+  YEAGER_EXPECT_EQ(levels.size(), std::size_t(6));
+  if (levels.size() != 6)
+    return;
+
+  const Uint widths[] = {37, 18, 9, 4, 2, 1};
+  const Uint heights[] = {10, 5, 2, 1, 1, 1};
+  for (std::size_t x = 0; x < levels.size(); x++) {
+    YEAGER_EXPECT_EQ(levels[x].Width, widths[x]);
+    YEAGER_EXPECT_EQ(levels[x].Height, heights[x]);
+    YEAGER_EXPECT_EQ(levels[x].Data.size(), std::size_t(widths[x]) * heights[x] * 4);
+  }
+  YEAGER_EXPECT(levels[0].Data == image.Data);
+
+  /* Every texel contributes to the level below, so the last one is the average of the image */
+  for (Uint channel = 0; channel < 4; channel++) {
+    double sum = 0.0;
+    for (std::size_t x = channel; x < image.Data.size(); x += 4) {
+      sum += image.Data[x];
+    }
+    YEAGER_EXPECT_NEAR(levels.back().Data[channel], sum / (image.Width * image.Height), 1.5);
+  }
+}
+
+YEAGER_TEST(TextureCompression, SRGBMipsAverageInLinearSpace)
+{
+  /* Black and white texels, half of the light is a grey of 188 in sRGB, not 128, the alpha stays linear */
+  const std::vector<unsigned char> checker = {0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0};
+  const std::vector<TextureMipLevel> srgb = GenerateMipChain(checker, 2, 2, true);
+  const std::vector<TextureMipLevel> linear = GenerateMipChain(checker, 2, 2, false);
+  YEAGER_EXPECT_EQ(srgb.size(), std::size_t(2));
+  YEAGER_EXPECT_EQ(linear.size(), std::size_t(2));
+  if (srgb.size() != 2 || linear.size() != 2)
+    return;
+
+  YEAGER_EXPECT_NEAR(srgb[1].Data[0], 188, 1);
+  YEAGER_EXPECT_NEAR(srgb[1].Data[3], 128, 1);
+  YEAGER_EXPECT_NEAR(linear[1].Data[0], 128, 1);
+}
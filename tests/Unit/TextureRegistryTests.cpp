@@ -0,0 +1,185 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Renderer/Texture/TextureRegistry.h"
+
+#include <random>
+#include <set>
+#include <thread>
+using namespace Yeager;
+
+/* Stands in for the material textures, the registry only hands the pointers out and never uses them */
+struct TestTexture {
+  Uint Initializations = 0;
+};
+
+/* Tracks every texture alive, a texture created twice at the same address or deleted twice fails the counts */
+class FakeTextureFactory : public TextureFactory {
+ public:
+  YEAGER_NODISCARD MaterialTexture2D* Create() override
+  {
+    TestTexture* texture = new TestTexture();
+    std::lock_guard<std::mutex> lock(mMutex);
+    bValid &= mAlive.insert(texture).second;
+    mCreated++;
+    return reinterpret_cast<MaterialTexture2D*>(texture);
+  }
+
+  void Delete(MaterialTexture2D* texture) override
+  {
+    TestTexture* test = reinterpret_cast<TestTexture*>(texture);
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      bValid &= mAlive.erase(test) == 1;
+      bValid &= test->Initializations == 1;
+      mDeleted++;
+    }
+    delete test;
+  }
+
+  YEAGER_NODISCARD bool IsValid() const
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return bValid;
+  }
+  YEAGER_NODISCARD Uint GetCreated() const
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCreated;
+  }
+  YEAGER_NODISCARD Uint GetDeleted() const
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mDeleted;
+  }
+  YEAGER_NODISCARD std::size_t GetAlive() const
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mAlive.size();
+  }
+
+ private:
+  mutable std::mutex mMutex;
+  std::set<TestTexture*> mAlive;
+  Uint mCreated = 0;
+  Uint mDeleted = 0;
+  bool bValid = true;
+};
+
+/* The initializer runs with the registry locked, before any other thread can see the texture */
+static void InitializeTestTexture(const std::shared_ptr<MaterialTexture2D>& texture)
+{
+  reinterpret_cast<TestTexture*>(texture.get())->Initializations++;
+}
+
+/* The same image written the ways the models of the importers refer to it */
+static std::vector<String> MakeAliases(const std::filesystem::path& folder, Uint image)
+{
+  const String name = "albedo" + std::to_string(image) + ".png";
+  return {(folder / name).string(), (folder / "." / name).string(), (folder / "Models" / ".." / name).string(),
+          (folder / "Models" / "." / ".." / name).generic_string()};
+}
+
+YEAGER_TEST(TextureRegistry, AliasesShareOneTexture)
+{
+  /* Owned by the registry, the test only reads its counts */
+  FakeTextureFactory* factory = new FakeTextureFactory();
+  TextureRegistry registry((std::unique_ptr<TextureFactory>(factory)));
+  const std::filesystem::path folder = Test::MakeTestFolder("TextureRegistryAliases");
+  const std::vector<String> aliases = MakeAliases(folder, 0);
+
+  std::vector<std::shared_ptr<MaterialTexture2D>> held;
+  for (const String& alias : aliases) {
+    held.push_back(registry.Acquire(alias, TextureCacheSettings(), InitializeTestTexture));
+  }
+  bool shared = true;
+  for (const auto& texture : held) {
+    shared &= texture == held.front();
+  }
+  YEAGER_EXPECT(shared);
+  YEAGER_EXPECT_EQ(factory->GetCreated(), 1u);
+  YEAGER_EXPECT_EQ(registry.GetTextureCount(), 1u);
+
+  /* Other settings build another texture from the same image */
+  TextureCacheSettings data;
+  data.bSRGB = false;
+  held.push_back(registry.Acquire(aliases[1], data, InitializeTestTexture));
+  YEAGER_EXPECT(held.back() != held.front());
+  YEAGER_EXPECT_EQ(registry.GetTextureCount(), 2u);
+
+  /* Released textures wait for the main thread, and the image loads again afterwards */
+  held.clear();
+  YEAGER_EXPECT_EQ(registry.GetTextureCount(), 0u);
+  YEAGER_EXPECT_EQ(registry.GetReleasedCount(), 2u);
+  YEAGER_EXPECT_EQ(factory->GetDeleted(), 0u);
+  registry.CollectReleased();
+  YEAGER_EXPECT_EQ(factory->GetDeleted(), 2u);
+  YEAGER_EXPECT_EQ(registry.GetReleasedCount(), 0u);
+
+  std::shared_ptr<MaterialTexture2D> again =
+      registry.Acquire(aliases[2], TextureCacheSettings(), InitializeTestTexture);
+  YEAGER_EXPECT_EQ(factory->GetCreated(), 3u);
+  again.reset();
+  registry.CollectReleased();
+  YEAGER_EXPECT(factory->IsValid());
+  YEAGER_EXPECT_EQ(factory->GetAlive(), std::size_t(0));
+}
+
+YEAGER_TEST(TextureRegistry, ConcurrentAcquireAndRelease)
+{
+  static YEAGER_CONSTEXPR Uint sThreads = 8;
+  static YEAGER_CONSTEXPR Uint sIterations = 20000;
+  static YEAGER_CONSTEXPR Uint sImages = 16;
+
+  const std::filesystem::path folder = Test::MakeTestFolder("TextureRegistryConcurrent");
+  std::vector<std::vector<String>> aliases;
+  for (Uint image = 0; image < sImages; image++) {
+    aliases.push_back(MakeAliases(folder, image));
+  }
+
+  FakeTextureFactory* factory = new FakeTextureFactory();
+  auto registry = std::make_unique<TextureRegistry>(std::unique_ptr<TextureFactory>(factory));
+
+  std::atomic<Uint> running = sThreads;
+  std::atomic<bool> sharedByAliases = true;
+  std::vector<std::thread> workers;
+  for (Uint thread = 0; thread < sThreads; thread++) {
+    workers.emplace_back([&, thread] {
+      std::mt19937 random(thread);
+      /* A few textures held across iterations, as the models keep them, the rest are released at once */
+      std::vector<std::shared_ptr<MaterialTexture2D>> held(4);
+      for (Uint x = 0; x < sIterations; x++) {
+        const std::vector<String>& image = aliases[random() % sImages];
+        std::shared_ptr<MaterialTexture2D> first =
+            registry->Acquire(image[random() % image.size()], TextureCacheSettings(), InitializeTestTexture);
+        std::shared_ptr<MaterialTexture2D> second =
+            registry->Acquire(image[random() % image.size()], TextureCacheSettings(), InitializeTestTexture);
+        if (first != second)
+          sharedByAliases.store(false, std::memory_order_relaxed);
+        held[random() % held.size()] = random() % 2 == 0 ? std::move(first) : YEAGER_NULLPTR;
+      }
+      held.clear();
+      running.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  /* The main thread collects while the workers acquire and release, as it does once per frame */
+  Uint collections = 0;
+  while (running.load(std::memory_order_acquire) > 0) {
+    registry->CollectReleased();
+    collections++;
+    std::this_thread::yield();
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  registry->CollectReleased();
+
+  YEAGER_EXPECT(sharedByAliases.load());
+  YEAGER_EXPECT(collections > 0);
+  YEAGER_EXPECT_EQ(registry->GetTextureCount(), 0u);
+  YEAGER_EXPECT_EQ(registry->GetReleasedCount(), 0u);
+  YEAGER_EXPECT(factory->IsValid());
+  YEAGER_EXPECT(factory->GetCreated() > sImages);
+  YEAGER_EXPECT_EQ(factory->GetDeleted(), factory->GetCreated());
+  YEAGER_EXPECT_EQ(factory->GetAlive(), std::size_t(0));
+  registry.reset();
+}
@@ -0,0 +1,351 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Renderer/Texture/TextureStreaming.h"
+
+#include <map>
+#include <thread>
+using namespace Yeager;
+
+struct TextureStreamingScope {
+  TextureStreamingScope() { JobSystem::Initialize(4); }
+  ~TextureStreamingScope() { JobSystem::Terminate(); }
+};
+
+/* Everything the fake uploader received, in order */
+struct TestUpload {
+  MaterialTexture2D* Target = YEAGER_NULLPTR;
+  Uint Level = 0;
+  std::size_t Size = 0;
+  uint32_t Payload = 0;
+};
+
+struct TestUploadLog {
+  std::vector<MaterialTexture2D*> Placeholders;
+  std::vector<MaterialTexture2D*> Begins;
+  std::vector<TestUpload> Uploads;
+};
+
+/* Records the work of the streamer instead of creating OpenGL textures */
+class FakeTextureUploader : public TextureUploader {
+ public:
+  FakeTextureUploader(TestUploadLog* log, bool compressedLevels) : mLog(log), bCompressedLevels(compressedLevels) {}
+
+  void AttachPlaceholder(MaterialTexture2D* target, const TextureStreamRequest& request) override
+  {
+    mLog->Placeholders.push_back(target);
+  }
+  void Begin(MaterialTexture2D* target, const TextureCacheData& data) override { mLog->Begins.push_back(target); }
+  void UploadLevel(MaterialTexture2D* target, const TextureCacheData& data, Uint level) override
+  {
+    mLog->Uploads.push_back(TestUpload{target, level, data.Levels[level].Data.size(), data.Header.Payload});
+  }
+  YEAGER_NODISCARD bool SupportsCompressedLevels() const override { return bCompressedLevels; }
+
+ private:
+  TestUploadLog* mLog = YEAGER_NULLPTR;
+  bool bCompressedLevels = true;
+};
+
+/* The streamer only locks the targets and hands them to the uploader, an object standing in for them is enough */
+static std::shared_ptr<MaterialTexture2D> MakeTestTarget()
+{
+  const std::shared_ptr<int> owner = std::make_shared<int>(0);
+  return std::shared_ptr<MaterialTexture2D>(owner, reinterpret_cast<MaterialTexture2D*>(owner.get()));
+}
+
+/* A source with its texture cache already written, the streamer reads the cache and never decodes the image */
+static TextureStreamRequest MakeCachedRequest(const std::filesystem::path& folder, const String& name, Uint width,
+                                              Uint height, const TextureCacheSettings& settings,
+                                              const std::shared_ptr<MaterialTexture2D>& target)
+{
+  TextureStreamRequest request;
+  request.Target = target;
+  request.Path = (folder / name).string();
+  request.CacheFolder = folder.string();
+  request.Settings = settings;
+  Test::WriteTestFile(request.Path, std::vector<unsigned char>(100 + name.size(), 7));
+
+  std::vector<unsigned char> pixels(std::size_t(width) * height * 4);
+  for (std::size_t x = 0; x < pixels.size(); x++) {
+    pixels[x] = static_cast<unsigned char>(x * 31);
+  }
+  const std::optional<TextureCacheData> data =
+      TextureCache::Build(request.Path, pixels.data(), width, height, 4, settings);
+  if (data.has_value())
+    TextureCache::Write(TextureCache::BuildCachePath(request.CacheFolder, request.Path, settings), data.value());
+  return request;
+}
+
+static TextureCacheSettings UncompressedSettings()
+{
+  TextureCacheSettings settings;
+  settings.bCompress = false;
+  return settings;
+}
+
+/* Updates until every texture is uploaded, the statistics of each update are returned */
+static std::vector<TextureStreamStatistics> StreamAll(TextureStreamer& streamer, const TextureStreamBudget& budget)
+{
+  std::vector<TextureStreamStatistics> updates;
+  streamer.WaitDecodes();
+  while (streamer.IsStreaming() && updates.size() < 1000) {
+    streamer.Update(budget);
+    updates.push_back(streamer.GetStatistics());
+  }
+  return updates;
+}
+
+static TextureStreamBudget UnlimitedBudget()
+{
+  TextureStreamBudget budget;
+  budget.Bytes = std::numeric_limits<std::size_t>::max();
+  budget.Milliseconds = std::numeric_limits<float>::max();
+  return budget;
+}
+
+YEAGER_TEST(TextureStreaming, CompletionQueueKeepsThePushOrder)
+{
+  TextureCompletionQueue queue;
+  YEAGER_EXPECT(queue.IsEmpty());
+  YEAGER_EXPECT(queue.PopAll() == YEAGER_NULLPTR);
+
+  std::vector<StreamedTexture> textures(3);
+  for (StreamedTexture& texture : textures) {
+    queue.Push(&texture);
+  }
+  YEAGER_EXPECT(!queue.IsEmpty());
+  StreamedTexture* popped = queue.PopAll();
+  YEAGER_EXPECT(queue.IsEmpty());
+  for (StreamedTexture& texture : textures) {
+    YEAGER_EXPECT(popped == &texture);
+    if (popped == YEAGER_NULLPTR)
+      return;
+    popped = popped->Next;
+  }
+  YEAGER_EXPECT(popped == YEAGER_NULLPTR);
+
+  /* Many producers, each one sees its own pushes come out in order and none is lost */
+  static YEAGER_CONSTEXPR Uint sThreads = 4;
+  static YEAGER_CONSTEXPR Uint sPushes = 5000;
+  std::vector<StreamedTexture> pushed(sThreads * sPushes);
+  for (Uint x = 0; x < pushed.size(); x++) {
+    pushed[x].ResidentLevel = x;
+  }
+  std::vector<std::thread> producers;
+  for (Uint thread = 0; thread < sThreads; thread++) {
+    producers.emplace_back([&queue, &pushed, thread] {
+      for (Uint x = 0; x < sPushes; x++) {
+        queue.Push(&pushed[thread * sPushes + x]);
+      }
+    });
+  }
+
+  std::vector<int> lastOfThread(sThreads, -1);
+  Uint received = 0;
+  bool ordered = true;
+  auto drain = [&] {
+    for (StreamedTexture* texture = queue.PopAll(); texture != YEAGER_NULLPTR; texture = texture->Next) {
+      const Uint thread = texture->ResidentLevel / sPushes;
+      const int index = static_cast<int>(texture->ResidentLevel % sPushes);
+      ordered &= index > lastOfThread[thread];
+      lastOfThread[thread] = index;
+      received++;
+    }
+  };
+  /* Drained while the producers still push, as the main thread does while the decode jobs finish */
+  while (received < pushed.size()) {
+    drain();
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  YEAGER_EXPECT(ordered);
+  YEAGER_EXPECT_EQ(received, Uint(pushed.size()));
+}
+
+YEAGER_TEST(TextureStreaming, MipTailsAreUploadedFirst)
+{
+  TextureStreamingScope scope;
+  const std::filesystem::path folder = Test::MakeTestFolder("TextureStreamingTails");
+  TestUploadLog log;
+  TextureStreamer streamer(std::make_unique<FakeTextureUploader>(&log, true));
+
+  const std::vector<std::pair<Uint, Uint>> sizes = {{64, 64}, {16, 16}, {37, 20}, {128, 8}};
+  std::vector<std::shared_ptr<MaterialTexture2D>> targets;
+  std::map<MaterialTexture2D*, Uint> levelCounts;
+  for (Uint x = 0; x < sizes.size(); x++) {
+    targets.push_back(MakeTestTarget());
+    streamer.Request(MakeCachedRequest(folder, "texture" + std::to_string(x) + ".png", sizes[x].first,
+                                       sizes[x].second, UncompressedSettings(), targets.back()));
+    levelCounts[targets.back().get()] =
+        1 + static_cast<Uint>(std::log2(std::max(sizes[x].first, sizes[x].second)));
+  }
+  YEAGER_EXPECT_EQ(log.Placeholders.size(), sizes.size());
+
+  const std::vector<TextureStreamStatistics> updates = StreamAll(streamer, UnlimitedBudget());
+  YEAGER_EXPECT_EQ(updates.size(), std::size_t(1));
+  YEAGER_EXPECT(!streamer.IsStreaming());
+  YEAGER_EXPECT_EQ(log.Begins.size(), sizes.size());
+
+  /* The smallest level waiting goes first, so every 1x1 level is resident before any full size level */
+  bool growing = true, fromTheTail = true, begunFirst = true;
+  std::map<MaterialTexture2D*, Uint> nextLevel;
+  for (std::size_t x = 0; x < log.Uploads.size(); x++) {
+    const TestUpload& upload = log.Uploads[x];
+    growing &= x == 0 || log.Uploads[x - 1].Size <= upload.Size;
+    if (nextLevel.find(upload.Target) == nextLevel.end()) {
+      nextLevel[upload.Target] = levelCounts[upload.Target] - 1;
+      begunFirst &= std::find(log.Begins.begin(), log.Begins.end(), upload.Target) != log.Begins.end();
+    }
+    fromTheTail &= upload.Level == nextLevel[upload.Target];
+    nextLevel[upload.Target]--;
+  }
+  YEAGER_EXPECT(growing);
+  YEAGER_EXPECT(fromTheTail);
+  YEAGER_EXPECT(begunFirst);
+
+  std::size_t levels = 0;
+  for (const auto& [target, count] : levelCounts) {
+    levels += count;
+  }
+  YEAGER_EXPECT_EQ(log.Uploads.size(), levels);
+  for (Uint x = 0; x < sizes.size(); x++) {
+    YEAGER_EXPECT(log.Uploads[x].Level == levelCounts[log.Uploads[x].Target] - 1);
+  }
+}
+
+YEAGER_TEST(TextureStreaming, UploadsStayWithinTheByteBudget)
+{
+  TextureStreamingScope scope;
+  const std::filesystem::path folder = Test::MakeTestFolder("TextureStreamingBudget");
+  TestUploadLog log;
+  TextureStreamer streamer(std::make_unique<FakeTextureUploader>(&log, true));
+
+  std::vector<std::shared_ptr<MaterialTexture2D>> targets;
+  for (Uint x = 0; x < 6; x++) {
+    targets.push_back(MakeTestTarget());
+    streamer.Request(
+        MakeCachedRequest(folder, "texture" + std::to_string(x) + ".png", 32, 32, UncompressedSettings(), targets[x]));
+  }
+
+  /* The 32x32 levels are 4096 bytes, larger than the whole budget, they still go up one per update */
+  TextureStreamBudget budget;
+  budget.Bytes = 3000;
+  budget.Milliseconds = std::numeric_limits<float>::max();
+  const std::vector<TextureStreamStatistics> updates = StreamAll(streamer, budget);
+  YEAGER_EXPECT(!streamer.IsStreaming());
+
+  bool withinBudget = true;
+  Uint levels = 0, oversized = 0;
+  for (const TextureStreamStatistics& update : updates) {
+    withinBudget &= update.LevelsUploaded > 0;
+    withinBudget &= update.BytesUploaded <= budget.Bytes || update.LevelsUploaded == 1;
+    oversized += update.BytesUploaded > budget.Bytes ? 1 : 0;
+    levels += update.LevelsUploaded;
+  }
+  YEAGER_EXPECT(withinBudget);
+  YEAGER_EXPECT_EQ(oversized, 6u);
+  YEAGER_EXPECT_EQ(levels, 6u * 6u);
+  YEAGER_EXPECT_EQ(std::size_t(levels), log.Uploads.size());
+}
+
+YEAGER_TEST(TextureStreaming, ExpiredTargetsStopReceivingUploads)
+{
+  TextureStreamingScope scope;
+  const std::filesystem::path folder = Test::MakeTestFolder("TextureStreamingExpired");
+  TestUploadLog log;
+  TextureStreamer streamer(std::make_unique<FakeTextureUploader>(&log, true));
+
+  std::shared_ptr<MaterialTexture2D> kept = MakeTestTarget();
+  std::shared_ptr<MaterialTexture2D> released = MakeTestTarget();
+  MaterialTexture2D* releasedTarget = released.get();
+  streamer.Request(MakeCachedRequest(folder, "kept.png", 64, 64, UncompressedSettings(), kept));
+  streamer.Request(MakeCachedRequest(folder, "released.png", 64, 64, UncompressedSettings(), released));
+  streamer.WaitDecodes();
+
+  /* Only the small levels fit, both textures are part way up */
+  TextureStreamBudget budget;
+  budget.Bytes = 1024;
+  budget.Milliseconds = std::numeric_limits<float>::max();
+  streamer.Update(budget);
+  const std::size_t uploadsBefore = log.Uploads.size();
+  YEAGER_EXPECT(std::count_if(log.Uploads.begin(), log.Uploads.end(),
+                              [releasedTarget](const TestUpload& upload) { return upload.Target == releasedTarget; }) >
+                0);
+
+  released.reset();
+  const std::vector<TextureStreamStatistics> updates = StreamAll(streamer, budget);
+  YEAGER_EXPECT(!streamer.IsStreaming());
+  YEAGER_EXPECT(!updates.empty() && updates.front().Uploading == 1);
+  bool releasedSkipped = true;
+  for (std::size_t x = uploadsBefore; x < log.Uploads.size(); x++) {
+    releasedSkipped &= log.Uploads[x].Target != releasedTarget;
+  }
+  YEAGER_EXPECT(releasedSkipped);
+  YEAGER_EXPECT(!log.Uploads.empty() && log.Uploads.back().Target == kept.get() && log.Uploads.back().Level == 0);
+
+  /* A target released before its decode finished never begins */
+  std::shared_ptr<MaterialTexture2D> early = MakeTestTarget();
+  const std::size_t beginsBefore = log.Begins.size();
+  streamer.Request(MakeCachedRequest(folder, "early.png", 16, 16, UncompressedSettings(), early));
+  early.reset();
+  StreamAll(streamer, budget);
+  YEAGER_EXPECT_EQ(log.Begins.size(), beginsBefore);
+  YEAGER_EXPECT(!streamer.IsStreaming());
+}
+
+YEAGER_TEST(TextureStreaming, FailedDecodesKeepTheirPlaceholder)
+{
+  TextureStreamingScope scope;
+  const std::filesystem::path folder = Test::MakeTestFolder("TextureStreamingFailed");
+  TestUploadLog log;
+  TextureStreamer streamer(std::make_unique<FakeTextureUploader>(&log, true));
+
+  /* Neither the cache nor the image exist, and the second file is not an image */
+  std::shared_ptr<MaterialTexture2D> missing = MakeTestTarget();
+  TextureStreamRequest request;
+  request.Target = missing;
+  request.Path = (folder / "missing.png").string();
+  request.CacheFolder = folder.string();
+  streamer.Request(request);
+
+  std::shared_ptr<MaterialTexture2D> invalid = MakeTestTarget();
+  request.Target = invalid;
+  request.Path = (folder / "invalid.png").string();
+  Test::WriteTestFile(request.Path, std::vector<unsigned char>(64, 1));
+  streamer.Request(request);
+
+  std::shared_ptr<MaterialTexture2D> valid = MakeTestTarget();
+  streamer.Request(MakeCachedRequest(folder, "valid.png", 8, 8, UncompressedSettings(), valid));
+
+  StreamAll(streamer, UnlimitedBudget());
+  YEAGER_EXPECT(!streamer.IsStreaming());
+  YEAGER_EXPECT_EQ(log.Placeholders.size(), std::size_t(3));
+  YEAGER_EXPECT_EQ(log.Begins.size(), std::size_t(1));
+  YEAGER_EXPECT(!log.Begins.empty() && log.Begins.front() == valid.get());
+  bool onlyValid = true;
+  for (const TestUpload& upload : log.Uploads) {
+    onlyValid &= upload.Target == valid.get();
+  }
+  YEAGER_EXPECT(onlyValid);
+  YEAGER_EXPECT_EQ(log.Uploads.size(), std::size_t(4));
+}
+
+YEAGER_TEST(TextureStreaming, BlocksAreDecodedWithoutCompressedSupport)
+{
+  TextureStreamingScope scope;
+  const std::filesystem::path folder = Test::MakeTestFolder("TextureStreamingBlocks");
+  TestUploadLog log;
+  TextureStreamer streamer(std::make_unique<FakeTextureUploader>(&log, false));
+
+  std::shared_ptr<MaterialTexture2D> target = MakeTestTarget();
+  streamer.Request(MakeCachedRequest(folder, "blocks.png", 32, 32, TextureCacheSettings(), target));
+  StreamAll(streamer, UnlimitedBudget());
+
+  bool uncompressed = true;
+  for (const TestUpload& upload : log.Uploads) {
+    uncompressed &= upload.Payload == uint32_t(TexturePayloadFormat::eRGBA8);
+  }
+  YEAGER_EXPECT(uncompressed);
+  YEAGER_EXPECT_EQ(log.Uploads.size(), std::size_t(6));
+  YEAGER_EXPECT(!log.Uploads.empty() && log.Uploads.back().Size == std::size_t(32) * 32 * 4);
+}
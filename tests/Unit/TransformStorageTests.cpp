@@ -0,0 +1,251 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Kernel/Process/JobSystem.h"
+#include "Components/Renderer/Objects/Entity.h"
+#include "Components/Renderer/Objects/TransformStorage.h"
+
+#include <random>
+using namespace Yeager;
+
+/* The matrix of Transformation3D::Apply, built with the glm calls it makes */
+static Matrix4 ComposeWithGlm(const Vector3& position, const Vector3& rotation, const Vector3& scale)
+{
+  Matrix4 model = YEAGER_IDENTITY_MATRIX4x4;
+  model = glm::translate(model, position);
+  model = glm::rotate(model, glm::radians(rotation.x), Vector3(1.0f, 0.0f, 0.0f));
+  model = glm::rotate(model, glm::radians(rotation.y), Vector3(0.0f, 1.0f, 0.0f));
+  model = glm::rotate(model, glm::radians(rotation.z), Vector3(0.0f, 0.0f, 1.0f));
+  return glm::scale(model, scale);
+}
+
+/* Relative to the size of the values, the translations of deep chains grow large */
+static bool MatricesAreNear(const Matrix4& first, const Matrix4& second, float tolerance = 1e-4f)
+{
+  for (int column = 0; column < 4; column++) {
+    for (int row = 0; row < 4; row++) {
+      const float expected = second[column][row];
+      if (std::abs(first[column][row] - expected) > tolerance * std::max(1.0f, std::abs(expected)))
+        return false;
+    }
+  }
+  return true;
+}
+
+/* Local values of the transforms kept by the test, to compute the expected world matrices by walking the parents */
+struct TestHierarchy {
+  TransformStorage Storage;
+  std::vector<TransformHandle> Handles;
+  std::vector<int> Parents;
+  std::vector<Vector3> Positions;
+  std::vector<Vector3> Rotations;
+  std::vector<Vector3> Scales;
+  std::mt19937 Random;
+
+  TestHierarchy(uint32_t seed) : Random(seed) {}
+
+  Uint Add(int parent)
+  {
+    std::uniform_real_distribution<float> value(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 1.5f);
+    Positions.push_back(Vector3(value(Random), value(Random), value(Random)));
+    Rotations.push_back(Vector3(angle(Random), angle(Random), angle(Random)));
+    Scales.push_back(Vector3(scale(Random), scale(Random), scale(Random)));
+    Parents.push_back(parent);
+    Handles.push_back(Storage.Create());
+    Storage.SetLocal(Handles.back(), Positions.back(), Rotations.back(), Scales.back());
+    if (parent >= 0)
+      Storage.SetParent(Handles.back(), Handles[parent]);
+    return static_cast<Uint>(Handles.size() - 1);
+  }
+
+  Matrix4 Expected(Uint index) const
+  {
+    const Matrix4 local = ComposeWithGlm(Positions[index], Rotations[index], Scales[index]);
+    return Parents[index] >= 0 ? Expected(Parents[index]) * local : local;
+  }
+
+  bool MatchesExpected() const
+  {
+    for (Uint x = 0; x < Handles.size(); x++) {
+      if (!MatricesAreNear(Storage.GetWorldMatrix(Handles[x]), Expected(x)))
+        return false;
+    }
+    return true;
+  }
+};
+
+YEAGER_TEST(TransformStorage, ComposeLocalMatchesTheGlmTransformation)
+{
+  std::mt19937 random(1);
+  std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> angle(-360.0f, 360.0f);
+  for (Uint x = 0; x < 1000; x++) {
+    const Vector3 position(value(random), value(random), value(random));
+    const Vector3 rotation(angle(random), angle(random), angle(random));
+    const Vector3 scale(value(random) * 0.1f, value(random) * 0.1f, value(random) * 0.1f);
+    YEAGER_EXPECT(MatricesAreNear(TransformStorage::ComposeLocal(position, rotation, scale),
+                                  ComposeWithGlm(position, rotation, scale)));
+  }
+}
+
+YEAGER_TEST(TransformStorage, ChildrenCreatedBeforeTheirParentsAreComposedInOrder)
+{
+  /* A chain where every transform is created before its parent, the order of the slots must be rebuilt by depth */
+  TestHierarchy hierarchy(2);
+  std::vector<Uint> chain;
+  for (Uint x = 0; x < 6; x++) {
+    chain.push_back(hierarchy.Add(-1));
+  }
+  for (Uint x = 0; x + 1 < chain.size(); x++) {
+    hierarchy.Parents[chain[x]] = static_cast<int>(chain[x + 1]);
+    YEAGER_EXPECT(hierarchy.Storage.SetParent(hierarchy.Handles[chain[x]], hierarchy.Handles[chain[x + 1]]));
+  }
+
+  hierarchy.Storage.Update();
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetLevelCount(), 6u);
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetLastUpdatedCount(), 6u);
+  YEAGER_EXPECT(hierarchy.MatchesExpected());
+  YEAGER_EXPECT(hierarchy.Storage.GetParent(hierarchy.Handles[chain[0]]) == hierarchy.Handles[chain[1]]);
+  YEAGER_EXPECT(hierarchy.Storage.GetParent(hierarchy.Handles[chain[5]]) == TransformStorage::sInvalidHandle);
+}
+
+YEAGER_TEST(TransformStorage, OnlyTheDirtySubtreesAreUpdated)
+{
+  /* Two roots with three children each, and a grandchild under the first child of each root */
+  TestHierarchy hierarchy(3);
+  const Uint first = hierarchy.Add(-1);
+  const Uint second = hierarchy.Add(-1);
+  std::vector<Uint> children;
+  for (const Uint root : {first, second}) {
+    for (Uint x = 0; x < 3; x++) {
+      children.push_back(hierarchy.Add(static_cast<int>(root)));
+    }
+  }
+  const Uint grandchild = hierarchy.Add(static_cast<int>(children[0]));
+  hierarchy.Add(static_cast<int>(children[3]));
+  hierarchy.Storage.Update();
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetLastUpdatedCount(), 10u);
+
+  /* Nothing dirty, nothing updated, and the flags of the last update are cleared */
+  hierarchy.Storage.Update();
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetLastUpdatedCount(), 0u);
+  YEAGER_EXPECT(!hierarchy.Storage.WasUpdated(hierarchy.Handles[first]));
+
+  /* The first root moves its three children and the grandchild below them, the second subtree is left alone */
+  hierarchy.Positions[first] = Vector3(10.0f, 0.0f, 0.0f);
+  hierarchy.Storage.SetLocal(hierarchy.Handles[first], hierarchy.Positions[first], hierarchy.Rotations[first],
+                             hierarchy.Scales[first]);
+  /* Composed on the spot before the update */
+  YEAGER_EXPECT(MatricesAreNear(hierarchy.Storage.GetWorldMatrix(hierarchy.Handles[first]), hierarchy.Expected(first)));
+  hierarchy.Storage.Update();
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetLastUpdatedCount(), 5u);
+  YEAGER_EXPECT(hierarchy.Storage.WasUpdated(hierarchy.Handles[grandchild]));
+  YEAGER_EXPECT(!hierarchy.Storage.WasUpdated(hierarchy.Handles[second]));
+  YEAGER_EXPECT(!hierarchy.Storage.WasUpdated(hierarchy.Handles[children[3]]));
+  YEAGER_EXPECT(hierarchy.MatchesExpected());
+
+  /* A leaf only updates itself */
+  hierarchy.Storage.MarkDirty(hierarchy.Handles[grandchild]);
+  hierarchy.Storage.Update();
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetLastUpdatedCount(), 1u);
+}
+
+YEAGER_TEST(TransformStorage, SourcesAreCopiedWhenMarkedDirty)
+{
+  TransformStorage storage;
+  Transformation3D source(Vector3(1.0f, 2.0f, 3.0f), Vector3(0.0f, 90.0f, 0.0f), Vector3(2.0f));
+  const TransformHandle handle = storage.Create(&source);
+  storage.Update();
+  YEAGER_EXPECT(MatricesAreNear(storage.GetWorldMatrix(handle),
+                                ComposeWithGlm(source.position, source.rotation, source.scale)));
+
+  /* Written without marking it dirty, the last world matrix stays until it is */
+  source.position = Vector3(-5.0f, 0.0f, 0.0f);
+  storage.Update();
+  YEAGER_EXPECT(storage.GetWorldMatrix(handle)[3] == Vector4(1.0f, 2.0f, 3.0f, 1.0f));
+  storage.MarkDirty(handle);
+  storage.Update();
+  YEAGER_EXPECT(storage.GetWorldMatrix(handle)[3] == Vector4(-5.0f, 0.0f, 0.0f, 1.0f));
+}
+
+YEAGER_TEST(TransformStorage, DestroyedParentsLeaveTheirChildrenAsRoots)
+{
+  TestHierarchy hierarchy(4);
+  const Uint root = hierarchy.Add(-1);
+  const Uint parent = hierarchy.Add(static_cast<int>(root));
+  const Uint child = hierarchy.Add(static_cast<int>(parent));
+  const Uint grandchild = hierarchy.Add(static_cast<int>(child));
+  hierarchy.Storage.Update();
+
+  const TransformHandle destroyed = hierarchy.Handles[parent];
+  hierarchy.Storage.Destroy(destroyed);
+  hierarchy.Parents[child] = -1;
+  YEAGER_EXPECT(!hierarchy.Storage.IsValid(destroyed));
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetTransformCount(), 3u);
+
+  hierarchy.Storage.Update();
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetLevelCount(), 2u);
+  YEAGER_EXPECT(hierarchy.Storage.GetParent(hierarchy.Handles[child]) == TransformStorage::sInvalidHandle);
+  YEAGER_EXPECT(hierarchy.Storage.GetParent(hierarchy.Handles[grandchild]) == hierarchy.Handles[child]);
+  for (const Uint x : {root, child, grandchild}) {
+    YEAGER_EXPECT(MatricesAreNear(hierarchy.Storage.GetWorldMatrix(hierarchy.Handles[x]), hierarchy.Expected(x)));
+  }
+
+  /* The index is reused with another generation, the old handle never reaches the new transform */
+  const TransformHandle reused = hierarchy.Storage.Create();
+  YEAGER_EXPECT_EQ(reused.Index, destroyed.Index);
+  YEAGER_EXPECT(reused.Generation != destroyed.Generation);
+  YEAGER_EXPECT(!hierarchy.Storage.IsValid(destroyed));
+  YEAGER_EXPECT(!hierarchy.Storage.SetParent(destroyed, hierarchy.Handles[root]));
+  YEAGER_EXPECT(hierarchy.Storage.GetWorldMatrix(destroyed) == YEAGER_IDENTITY_MATRIX4x4);
+}
+
+YEAGER_TEST(TransformStorage, RejectsParentingToItsOwnSubtree)
+{
+  TestHierarchy hierarchy(5);
+  const Uint root = hierarchy.Add(-1);
+  const Uint child = hierarchy.Add(static_cast<int>(root));
+  const Uint grandchild = hierarchy.Add(static_cast<int>(child));
+
+  YEAGER_EXPECT(!hierarchy.Storage.SetParent(hierarchy.Handles[root], hierarchy.Handles[grandchild]));
+  YEAGER_EXPECT(!hierarchy.Storage.SetParent(hierarchy.Handles[root], hierarchy.Handles[root]));
+  YEAGER_EXPECT(hierarchy.Storage.GetParent(hierarchy.Handles[root]) == TransformStorage::sInvalidHandle);
+
+  /* Moving a subtree under another root keeps its own children */
+  const Uint other = hierarchy.Add(-1);
+  YEAGER_EXPECT(hierarchy.Storage.SetParent(hierarchy.Handles[child], hierarchy.Handles[other]));
+  hierarchy.Parents[child] = static_cast<int>(other);
+  hierarchy.Storage.Update();
+  YEAGER_EXPECT(hierarchy.MatchesExpected());
+}
+
+YEAGER_TEST(TransformStorage, ParallelLevelsMatchTheSerialUpdate)
+{
+  /* Levels above YEAGER_TRANSFORM_PARALLEL_MIN_COUNT are split across the workers */
+  JobSystem::Initialize(4);
+  TestHierarchy hierarchy(6);
+  for (Uint x = 0; x < 64; x++) {
+    hierarchy.Add(-1);
+  }
+  std::uniform_int_distribution<int> pick(0, 63);
+  for (Uint x = 0; x < YEAGER_TRANSFORM_PARALLEL_MIN_COUNT * 2; x++) {
+    const Uint child = hierarchy.Add(pick(hierarchy.Random));
+    hierarchy.Add(static_cast<int>(child));
+  }
+  hierarchy.Storage.Update();
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetLevelCount(), 3u);
+  YEAGER_EXPECT(hierarchy.MatchesExpected());
+
+  /* A root changes and only its subtree is rebuilt, in the jobs of every level */
+  hierarchy.Positions[7] += Vector3(1.0f);
+  hierarchy.Storage.SetLocal(hierarchy.Handles[7], hierarchy.Positions[7], hierarchy.Rotations[7],
+                             hierarchy.Scales[7]);
+  hierarchy.Storage.Update();
+  Uint subtree = 1;
+  for (Uint x = 64; x < hierarchy.Handles.size(); x += 2) {
+    subtree += hierarchy.Parents[x] == 7 ? 2 : 0;
+  }
+  YEAGER_EXPECT_EQ(hierarchy.Storage.GetLastUpdatedCount(), subtree);
+  YEAGER_EXPECT(hierarchy.MatchesExpected());
+  JobSystem::Terminate();
+}
@@ -0,0 +1,196 @@
+#include "Framework/YeagerTest.h"
+#include "Components/Renderer/Shader/UniformTable.h"
+
+#include <cstring>
+#include <map>
+using namespace Yeager;
+
+static_assert(HashUniformName("") == 14695981039346656037ull, "The hash of nothing must be the FNV-1a offset basis");
+static_assert(HashUniformName("a") == 0xaf63dc4c8601ec8cull, "The hash must match the reference 64 bits FNV-1a");
+
+YEAGER_TEST(UniformTable, EmptyTableFindsNothing)
+{
+  UniformTable table;
+  const UniformHandle handle("model");
+  YEAGER_EXPECT(!table.IsBuilt());
+  YEAGER_EXPECT_EQ(table.Find(handle.Hash, handle.Name), UniformTable::sInvalidLocation);
+}
+
+YEAGER_TEST(UniformTable, FindsEveryInsertedLocationAfterGrowing)
+{
+  UniformTable table;
+  table.Reset(4);
+  for (GLint x = 0; x < 500; x++) {
+    YEAGER_EXPECT(table.Insert("uniform" + std::to_string(x), x));
+  }
+  YEAGER_EXPECT_EQ(table.GetSize(), 500u);
+
+  for (GLint x = 0; x < 500; x++) {
+    const UniformHandle handle("uniform" + std::to_string(x));
+    YEAGER_EXPECT_EQ(table.Find(handle.Hash, handle.Name), x);
+  }
+
+  const UniformHandle missing("missing");
+  YEAGER_EXPECT_EQ(table.Find(missing.Hash, missing.Name), UniformTable::sInvalidLocation);
+}
+
+YEAGER_TEST(UniformTable, InsertingTheSameNameTwiceKeepsTheFirstLocation)
+{
+  UniformTable table;
+  table.Reset(2);
+  YEAGER_EXPECT(table.Insert("view", 3));
+  YEAGER_EXPECT(table.Insert("view", 7));
+  YEAGER_EXPECT_EQ(table.GetSize(), 1u);
+  const UniformHandle handle("view");
+  YEAGER_EXPECT_EQ(table.Find(handle.Hash, handle.Name), 3);
+}
+
+#ifdef YEAGER_DEBUG
+YEAGER_TEST(UniformTable, HitWithAnotherNameIsReportedAsCollided)
+{
+  UniformTable table;
+  table.Reset(2);
+  table.Insert("projection", 1);
+  /* A name missing from the program, looked up with the hash of one that is there, as a 64 bits collision would */
+  YEAGER_EXPECT_EQ(table.Find(HashUniformName("projection"), "other"), UniformTable::sCollidedLocation);
+}
+#endif
+
+YEAGER_TEST(UniformTable, ArrayHandlesNameEveryElement)
+{
+  const std::vector<UniformHandle> handles = MakeUniformArrayHandles("bones", 3);
+  YEAGER_EXPECT_EQ(handles.size(), 3u);
+  YEAGER_EXPECT_EQ(handles[0].Name, String("bones[0]"));
+  YEAGER_EXPECT_EQ(handles[2].Name, String("bones[2]"));
+  YEAGER_EXPECT_EQ(handles[2].Hash, HashUniformName("bones[2]"));
+}
+
+/* Active uniforms of a fake linked program, as the driver reports them, and the locations it resolves */
+struct FakeProgram {
+  struct ActiveUniform {
+    String Name;
+    GLint Size = 1;
+  };
+
+  GLuint Id = 7;
+  std::vector<ActiveUniform> Uniforms;
+  std::map<String, GLint> Locations;
+  Uint LocationQueries = 0;
+};
+
+static FakeProgram* sFakeProgram = YEAGER_NULLPTR;
+
+static UniformReflectionFunctions MakeFakeFunctions()
+{
+  UniformReflectionFunctions functions;
+  functions.GetProgramiv = [](GLuint program, GLenum name, GLint* value) {
+    if (program != sFakeProgram->Id)
+      return;
+    if (name == GL_ACTIVE_UNIFORMS) {
+      *value = static_cast<GLint>(sFakeProgram->Uniforms.size());
+    } else if (name == GL_ACTIVE_UNIFORM_MAX_LENGTH) {
+      *value = 0;
+      for (const auto& uniform : sFakeProgram->Uniforms)
+        *value = std::max(*value, static_cast<GLint>(uniform.Name.size() + 1));
+    }
+  };
+  functions.GetActiveUniform = [](GLuint program, GLuint index, GLsizei bufferSize, GLsizei* length, GLint* size,
+                                  GLenum* type, GLchar* name) {
+    const auto& uniform = sFakeProgram->Uniforms.at(index);
+    *length = std::min(static_cast<GLsizei>(uniform.Name.size()), bufferSize - 1);
+    std::memcpy(name, uniform.Name.c_str(), *length + 1);
+    *size = uniform.Size;
+    *type = GL_FLOAT;
+  };
+  functions.GetUniformLocation = [](GLuint program, const GLchar* name) {
+    sFakeProgram->LocationQueries++;
+    const auto it = sFakeProgram->Locations.find(name);
+    return program == sFakeProgram->Id && it != sFakeProgram->Locations.end() ? it->second : GLint(-1);
+  };
+  return functions;
+}
+
+static GLint FindLocation(const UniformTable& table, const String& name)
+{
+  return table.Find(HashUniformName(name), name);
+}
+
+YEAGER_TEST(UniformTable, ReflectionInsertsEveryActiveUniform)
+{
+  FakeProgram program;
+  program.Uniforms = {{"model"}, {"view"}, {"material.diffuse"}};
+  program.Locations = {{"model", 0}, {"view", 4}, {"material.diffuse", 9}};
+  sFakeProgram = &program;
+
+  UniformTable table;
+  ReflectUniformTable(&table, program.Id, MakeFakeFunctions());
+  YEAGER_EXPECT_EQ(table.GetSize(), 3u);
+  YEAGER_EXPECT_EQ(FindLocation(table, "model"), 0);
+  YEAGER_EXPECT_EQ(FindLocation(table, "view"), 4);
+  YEAGER_EXPECT_EQ(FindLocation(table, "material.diffuse"), 9);
+  YEAGER_EXPECT_EQ(FindLocation(table, "projection"), UniformTable::sInvalidLocation);
+  sFakeProgram = YEAGER_NULLPTR;
+}
+
+YEAGER_TEST(UniformTable, ReflectionSkipsUniformsWithoutLocation)
+{
+  /* Members of uniform blocks are active but have no location */
+  FakeProgram program;
+  program.Uniforms = {{"Lights.count"}, {"Lights.color[0]", 4}, {"model"}};
+  program.Locations = {{"model", 2}};
+  sFakeProgram = &program;
+
+  UniformTable table;
+  ReflectUniformTable(&table, program.Id, MakeFakeFunctions());
+  YEAGER_EXPECT_EQ(table.GetSize(), 1u);
+  YEAGER_EXPECT_EQ(FindLocation(table, "model"), 2);
+  YEAGER_EXPECT_EQ(FindLocation(table, "Lights.count"), UniformTable::sInvalidLocation);
+  YEAGER_EXPECT_EQ(FindLocation(table, "Lights.color"), UniformTable::sInvalidLocation);
+  /* The array of the block is not expanded, only its first element was asked for */
+  YEAGER_EXPECT_EQ(program.LocationQueries, 3u);
+  sFakeProgram = YEAGER_NULLPTR;
+}
+
+YEAGER_TEST(UniformTable, ReflectionExpandsArrays)
+{
+  FakeProgram program;
+  program.Uniforms = {{"bones[0]", 4}, {"lights[0].color", 1}, {"a[0]", 2}};
+  /* The third bone was optimized out by the compiler, the driver has no location for it */
+  program.Locations = {{"bones[0]", 10}, {"bones[1]", 11}, {"bones[3]", 13},
+                       {"lights[0].color", 20}, {"a[0]", 30}, {"a[1]", 31}};
+  sFakeProgram = &program;
+
+  UniformTable table;
+  ReflectUniformTable(&table, program.Id, MakeFakeFunctions());
+  YEAGER_EXPECT_EQ(FindLocation(table, "bones"), 10);
+  YEAGER_EXPECT_EQ(FindLocation(table, "bones[0]"), 10);
+  YEAGER_EXPECT_EQ(FindLocation(table, "bones[1]"), 11);
+  YEAGER_EXPECT_EQ(FindLocation(table, "bones[2]"), UniformTable::sInvalidLocation);
+  YEAGER_EXPECT_EQ(FindLocation(table, "bones[3]"), 13);
+  YEAGER_EXPECT_EQ(FindLocation(table, "bones[4]"), UniformTable::sInvalidLocation);
+  YEAGER_EXPECT_EQ(FindLocation(table, "a"), 30);
+  YEAGER_EXPECT_EQ(FindLocation(table, "a[1]"), 31);
+
+  /* A member of a struct array ends with its member name, there is no subscript to strip */
+  YEAGER_EXPECT_EQ(FindLocation(table, "lights[0].color"), 20);
+  YEAGER_EXPECT_EQ(FindLocation(table, "lights"), UniformTable::sInvalidLocation);
+  YEAGER_EXPECT_EQ(FindLocation(table, "lights[0]"), UniformTable::sInvalidLocation);
+  sFakeProgram = YEAGER_NULLPTR;
+}
+
+#ifdef YEAGER_DEBUG
+YEAGER_TEST(UniformTable, ReflectedHitsAreVerifiedByName)
+{
+  FakeProgram program;
+  program.Uniforms = {{"bones[0]", 2}};
+  program.Locations = {{"bones[0]", 10}, {"bones[1]", 11}};
+  sFakeProgram = &program;
+
+  UniformTable table;
+  ReflectUniformTable(&table, program.Id, MakeFakeFunctions());
+  YEAGER_EXPECT_EQ(table.Find(HashUniformName("bones[1]"), "bones[1]"), 11);
+  YEAGER_EXPECT_EQ(table.Find(HashUniformName("bones[1]"), "bones[2]"), UniformTable::sCollidedLocation);
+  YEAGER_EXPECT_EQ(table.Find(HashUniformName("bones"), "bone"), UniformTable::sCollidedLocation);
+  sFakeProgram = YEAGER_NULLPTR;
+}
+#endif
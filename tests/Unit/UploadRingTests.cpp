@@ -0,0 +1,234 @@
+#include "Framework/YeagerTest.h"
+#include "Framework/YeagerUploadRing.h"
+
+#include <random>
+using namespace Yeager;
+
+/* Ring of 1024 bytes with its fake backend, the backend stays owned by the ring and is read through the pointer */
+struct TestRing {
+  Test::FakeUploadRingBackend* Backend = YEAGER_NULLPTR;
+  UploadRing Ring;
+
+  TestRing(std::size_t capacity = 1024, bool mapped = true)
+      : Backend(new Test::FakeUploadRingBackend(mapped)),
+        Ring(capacity, std::unique_ptr<UploadRingBackend>(Backend))
+  {}
+};
+
+YEAGER_TEST(UploadRing, AllocationsAreAlignedAndApart)
+{
+  TestRing test(4096);
+  std::mt19937 random(25);
+  bool aligned = true, inside = true, apart = true, mapped = true;
+  for (Uint frame = 0; frame < 50; frame++) {
+    test.Ring.BeginFrame();
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    for (Uint x = 0; x < 8; x++) {
+      const std::size_t alignment = std::size_t(1) << (random() % 9);
+      const std::size_t size = 1 + random() % 200;
+      const RingAllocation allocation = test.Ring.Allocate(size, alignment);
+      aligned &= allocation.Offset % alignment == 0;
+      inside &= allocation.Offset + allocation.Size <= test.Ring.GetCapacity() && allocation.Size == size;
+      mapped &= !allocation.bSpilled && allocation.Data == test.Backend->GetBufferData() + allocation.Offset;
+      for (const auto& [offset, end] : ranges) {
+        apart &= allocation.Offset >= end || allocation.Offset + size <= offset;
+      }
+      ranges.emplace_back(allocation.Offset, allocation.Offset + size);
+    }
+    test.Ring.EndFrame();
+  }
+  YEAGER_EXPECT(aligned);
+  YEAGER_EXPECT(inside);
+  YEAGER_EXPECT(apart);
+  YEAGER_EXPECT(mapped);
+  YEAGER_EXPECT_EQ(test.Ring.GetStallCount(), 0u);
+  YEAGER_EXPECT_EQ(test.Ring.GetSpillCount(), 0u);
+
+  /* Nothing to allocate, nothing reserved */
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT(!test.Ring.Allocate(0, 16).IsValid());
+  YEAGER_EXPECT_EQ(test.Ring.GetUsed(), std::size_t(0));
+  test.Ring.EndFrame();
+}
+
+YEAGER_TEST(UploadRing, WrapsToTheStartInsteadOfStraddlingTheEnd)
+{
+  TestRing test;
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT_EQ(test.Ring.Allocate(600, 16).Offset, std::size_t(0));
+  test.Ring.EndFrame();
+
+  /* The last 424 bytes are too few, the allocation starts over at 0 once the first frame is released */
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT_EQ(test.Ring.GetFramesInFlight(), std::size_t(0));
+  const RingAllocation wrapped = test.Ring.Allocate(600, 16);
+  YEAGER_EXPECT_EQ(wrapped.Offset, std::size_t(0));
+  YEAGER_EXPECT(!wrapped.bSpilled);
+  /* The skipped end of the lap counts as used until the frame is released, with it the ring is full */
+  YEAGER_EXPECT_EQ(test.Ring.GetUsed(), std::size_t(1024));
+  test.Ring.EndFrame();
+
+  /* An allocation ending right on the end of the buffer does not wrap */
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT_EQ(test.Ring.Allocate(424, 8).Offset, std::size_t(600));
+  YEAGER_EXPECT_EQ(test.Ring.Allocate(100, 8).Offset, std::size_t(0));
+  test.Ring.EndFrame();
+  YEAGER_EXPECT_EQ(test.Ring.GetStallCount(), 0u);
+  YEAGER_EXPECT_EQ(test.Ring.GetSpillCount(), 0u);
+}
+
+YEAGER_TEST(UploadRing, WaitsForTheOldestFrameWhenFull)
+{
+  TestRing test;
+  test.Backend->SetSignalFences(false);
+
+  for (Uint frame = 0; frame < 2; frame++) {
+    test.Ring.BeginFrame();
+    YEAGER_EXPECT_EQ(test.Ring.Allocate(512, 16).Offset, std::size_t(512) * frame);
+    test.Ring.EndFrame();
+  }
+  /* The GPU did not get to them, starting a frame does not block */
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT_EQ(test.Ring.GetFramesInFlight(), std::size_t(2));
+  YEAGER_EXPECT_EQ(test.Ring.GetStallCount(), 0u);
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveFenceCount(), std::size_t(2));
+
+  /* Only the oldest frame is waited for, its room is enough */
+  const RingAllocation allocation = test.Ring.Allocate(256, 16);
+  YEAGER_EXPECT_EQ(allocation.Offset, std::size_t(0));
+  YEAGER_EXPECT(!allocation.bSpilled);
+  YEAGER_EXPECT_EQ(test.Ring.GetStallCount(), 1u);
+  YEAGER_EXPECT_EQ(test.Backend->GetBlockingWaitCount(), 1u);
+  YEAGER_EXPECT_EQ(test.Ring.GetFramesInFlight(), std::size_t(1));
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveFenceCount(), std::size_t(1));
+  test.Ring.EndFrame();
+
+  /* Signaled frames are released at the start of the next frame, without a stall */
+  test.Backend->SignalFences();
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT_EQ(test.Ring.GetFramesInFlight(), std::size_t(0));
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveFenceCount(), std::size_t(0));
+  YEAGER_EXPECT_EQ(test.Ring.GetStallCount(), 1u);
+  test.Ring.EndFrame();
+  YEAGER_EXPECT(test.Backend->IsValid());
+}
+
+YEAGER_TEST(UploadRing, SpillsWhenTheFrameHoldsTheRestOfTheRing)
+{
+  TestRing test;
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT(!test.Ring.Allocate(800, 16).bSpilled);
+
+  /* Nothing in flight to wait for, the current frame cannot wait for itself */
+  const std::vector<unsigned char> bytes(400, 0x5a);
+  const RingAllocation spilled = test.Ring.Upload(bytes.data(), bytes.size(), 16);
+  YEAGER_EXPECT(spilled.bSpilled);
+  YEAGER_EXPECT(spilled.Buffer != test.Backend->GetBuffer());
+  YEAGER_EXPECT_EQ(spilled.Offset, std::size_t(0));
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveSpillBufferCount(), std::size_t(1));
+  const unsigned char* uploaded = test.Backend->GetSpillBufferData(spilled.Buffer);
+  YEAGER_EXPECT(uploaded != YEAGER_NULLPTR && std::equal(bytes.begin(), bytes.end(), uploaded));
+
+  /* Larger than the whole ring */
+  YEAGER_EXPECT(test.Ring.Allocate(5000, 16).bSpilled);
+  YEAGER_EXPECT_EQ(test.Ring.GetSpillCount(), 2u);
+  YEAGER_EXPECT_EQ(test.Ring.GetStallCount(), 0u);
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveSpillBufferCount(), std::size_t(2));
+
+  /* The spill buffers are dropped with the frame */
+  test.Ring.EndFrame();
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveSpillBufferCount(), std::size_t(0));
+  YEAGER_EXPECT(test.Backend->IsValid());
+}
+
+YEAGER_TEST(UploadRing, GrowsAtTheNextFrameAfterASpill)
+{
+  TestRing test;
+  test.Backend->SetSignalFences(false);
+  auto allocateFrame = [&test] {
+    for (Uint x = 0; x < 3; x++) {
+      test.Ring.Allocate(500, 1);
+    }
+  };
+
+  test.Ring.BeginFrame();
+  allocateFrame();
+  YEAGER_EXPECT_EQ(test.Ring.GetSpillCount(), 1u);
+  /* The frame keeps the ring it started with */
+  YEAGER_EXPECT_EQ(test.Ring.GetCapacity(), std::size_t(1024));
+  test.Ring.EndFrame();
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveFenceCount(), std::size_t(1));
+
+  /* Sized for the frames in flight, the fences of the old buffer go with it */
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT(test.Ring.GetCapacity() >= std::size_t(1500) * YEAGER_UPLOAD_RING_FRAMES);
+  YEAGER_EXPECT_EQ(test.Ring.GetCapacity() % 256, std::size_t(0));
+  YEAGER_EXPECT_EQ(test.Ring.GetFramesInFlight(), std::size_t(0));
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveFenceCount(), std::size_t(0));
+  YEAGER_EXPECT_EQ(test.Ring.GetUsed(), std::size_t(0));
+
+  /* The same frames fit from now on, even with the GPU frames behind */
+  for (Uint frame = 0; frame < YEAGER_UPLOAD_RING_FRAMES; frame++) {
+    if (frame > 0)
+      test.Ring.BeginFrame();
+    allocateFrame();
+    test.Ring.EndFrame();
+  }
+  YEAGER_EXPECT_EQ(test.Ring.GetSpillCount(), 1u);
+  YEAGER_EXPECT_EQ(test.Ring.GetStallCount(), 0u);
+  YEAGER_EXPECT(test.Backend->IsValid());
+}
+
+YEAGER_TEST(UploadRing, UnmappedRingUploadsTheCommittedBytes)
+{
+  TestRing test(1024, false);
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT(!test.Ring.IsMapped());
+  const std::vector<unsigned char> bytes = {1, 2, 3, 4, 5, 6, 7, 8};
+  const RingAllocation allocation = test.Ring.Allocate(64, 16);
+  std::memcpy(allocation.Data, bytes.data(), bytes.size());
+  YEAGER_EXPECT(allocation.Data != test.Backend->GetBufferData() + allocation.Offset);
+
+  /* Only the committed prefix goes up */
+  test.Ring.Commit(allocation, bytes.size());
+  YEAGER_EXPECT_EQ(test.Backend->GetUploadCount(), 1u);
+  YEAGER_EXPECT(std::equal(bytes.begin(), bytes.end(), test.Backend->GetBufferData() + allocation.Offset));
+  test.Ring.EndFrame();
+  YEAGER_EXPECT(test.Backend->IsValid());
+}
+
+YEAGER_TEST(UploadRing, DestroyReleasesTheFencesAndSpills)
+{
+  TestRing test;
+  test.Backend->SetSignalFences(false);
+  for (Uint frame = 0; frame < 2; frame++) {
+    test.Ring.BeginFrame();
+    test.Ring.Allocate(300, 16);
+    test.Ring.EndFrame();
+  }
+  /* A frame left open with a spill, as when the window closes in the middle of one */
+  test.Ring.BeginFrame();
+  test.Ring.Allocate(5000, 16);
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveFenceCount(), std::size_t(2));
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveSpillBufferCount(), std::size_t(1));
+
+  test.Ring.Destroy();
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveFenceCount(), std::size_t(0));
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveSpillBufferCount(), std::size_t(0));
+  YEAGER_EXPECT(!test.Backend->IsBufferAlive());
+  YEAGER_EXPECT_EQ(test.Ring.GetCapacity(), std::size_t(0));
+  YEAGER_EXPECT_EQ(test.Ring.GetFramesInFlight(), std::size_t(0));
+
+  /* Destroying twice, or the destructor afterwards, releases nothing again */
+  test.Ring.Destroy();
+  YEAGER_EXPECT(test.Backend->IsValid());
+
+  /* The ring is created again on the next frame */
+  test.Ring.BeginFrame();
+  YEAGER_EXPECT(test.Backend->IsBufferAlive());
+  YEAGER_EXPECT_EQ(test.Ring.Allocate(64, 16).Offset, std::size_t(0));
+  test.Ring.EndFrame();
+  test.Ring.Destroy();
+  YEAGER_EXPECT_EQ(test.Backend->GetLiveFenceCount(), std::size_t(0));
+  YEAGER_EXPECT(test.Backend->IsValid());
+}